@@ -64,6 +64,7 @@ static const char * const solver_code_names[NUM_SOLVER_CODES] = {
   "none",
   "rfw",
   "simplex",
+  "sparse-idl",
 };
 
 static const int32_t solver_code[NUM_SOLVER_CODES] = {
@@ -73,6 +74,7 @@ static const int32_t solver_code[NUM_SOLVER_CODES] = {
   CTX_CONFIG_NONE,
   CTX_CONFIG_ARITH_RFW,
   CTX_CONFIG_ARITH_SIMPLEX,
+  CTX_CONFIG_ARITH_SPARSE_IDL,
 };
 
 
@@ -87,9 +89,11 @@ typedef enum ctx_config_key {
   CTX_CONFIG_KEY_ARRAY_SOLVER,
   CTX_CONFIG_KEY_BV_SOLVER,
   CTX_CONFIG_KEY_ARITH_SOLVER,
+  CTX_CONFIG_KEY_PORTFOLIO,
+  CTX_CONFIG_KEY_SAT_BACKEND,
 } ctx_config_key_t;
 
-#define NUM_CONFIG_KEYS (CTX_CONFIG_KEY_ARITH_SOLVER+1)
+#define NUM_CONFIG_KEYS (CTX_CONFIG_KEY_SAT_BACKEND+1)
 
 
 static const char *const config_key_names[NUM_CONFIG_KEYS] = {
@@ -98,6 +102,8 @@ static const char *const config_key_names[NUM_CONFIG_KEYS] = {
   "array-solver",
   "bv-solver",
   "mode",
+  "portfolio",
+  "sat-backend",
   "solver-type",
   "uf-solver",
 };
@@ -108,6 +114,8 @@ static const int32_t config_key[NUM_CONFIG_KEYS] = {
   CTX_CONFIG_KEY_ARRAY_SOLVER,
   CTX_CONFIG_KEY_BV_SOLVER,
   CTX_CONFIG_KEY_MODE,
+  CTX_CONFIG_KEY_PORTFOLIO,
+  CTX_CONFIG_KEY_SAT_BACKEND,
   CTX_CONFIG_KEY_SOLVER_TYPE,
   CTX_CONFIG_KEY_UF_SOLVER,
 };
@@ -237,6 +245,8 @@ static const ctx_config_t default_config = {
   CTX_CONFIG_DEFAULT,     // bv
   CTX_CONFIG_DEFAULT,     // arith
   ARITH_LIRA,             // fragment
+  1,                      // no portfolio
+  false,                  // no sat backend
 };
 
 
@@ -319,6 +329,27 @@ static int32_t set_solver_code(const char *value, solver_code_t *dest) {
 }
 
 
+/*
+ * Convert value to a portfolio size
+ * - the value must be a positive integer no more than MAX_PORTFOLIO_SIZE
+ */
+static int32_t set_portfolio_size(const char *value, uint32_t *dest) {
+  uint32_t n;
+  int32_t r;
+
+  r = -2;
+  if (parse_as_uint(value, &n) == valid_integer) {
+    r = -3;
+    if (0 < n && n <= MAX_PORTFOLIO_SIZE) {
+      *dest = n;
+      r = 0;
+    }
+  }
+
+  return r;
+}
+
+
 /*
  * Set an individual field in config
  * - key = field name
@@ -387,6 +418,16 @@ int32_t config_set_field(ctx_config_t *config, const char *key, const char *valu
     }
     break;
 
+  case CTX_CONFIG_KEY_PORTFOLIO:
+    r = set_portfolio_size(value, &config->portfolio_size);
+    break;
+
+  case CTX_CONFIG_KEY_SAT_BACKEND:
+    if (parse_as_boolean(value, &config->sat_backend) != valid_boolean) {
+      r = -2;
+    }
+    break;
+
   default:
     assert(k == -1);
     r = -1;
@@ -498,6 +539,16 @@ static int32_t arch_add_rfw(int32_t a) {
   return a;
 }
 
+// add the sparse difference-logic solver
+static int32_t arch_add_sidl(int32_t a) {
+  if (a == CTX_ARCH_NOSOLVERS) {
+    a = CTX_ARCH_ISDL;
+  } else {
+    a = -1;
+  }
+  return a;
+}
+
 
 // add solver identified by code c to a
 static int32_t arch_add_arith(int32_t a, solver_code_t c) {
@@ -518,6 +569,10 @@ static int32_t arch_add_arith(int32_t a, solver_code_t c) {
   case CTX_CONFIG_ARITH_RFW:
     a = arch_add_rfw(a);
     break;
+
+  case CTX_CONFIG_ARITH_SPARSE_IDL:
+    a = arch_add_sidl(a);
+    break;
   }
   return a;
 }
@@ -525,10 +580,14 @@ static int32_t arch_add_arith(int32_t a, solver_code_t c) {
 
 /*
  * Check whether the architecture code a is compatible with mode
- * - current restriction: IFW, RFW, and MCSAT don't support PUSH/POP or MULTIPLE CHECKS
+ * - current restriction: IFW and RFW don't support PUSH/POP or MULTIPLE CHECKS
+ * - MCSAT doesn't support INTERACTIVE mode (no clean interrupt)
  */
 static bool arch_supports_mode(context_arch_t a, context_mode_t mode) {
-  return (a != CTX_ARCH_MCSAT && a != CTX_ARCH_IFW && a != CTX_ARCH_RFW) || mode == CTX_MODE_ONECHECK;
+  if (a == CTX_ARCH_MCSAT) {
+    return mode != CTX_MODE_INTERACTIVE;
+  }
+  return (a != CTX_ARCH_IFW && a != CTX_ARCH_RFW) || mode == CTX_MODE_ONECHECK;
 }
 
 
@@ -582,12 +641,24 @@ int32_t decode_config(const ctx_config_t *config, smt_logic_t *logic, context_ar
       }
     }
 
+    /*
+     * Special case: QF_IDL + arith_config == SPARSE_IDL (any mode)
+     */
+    if (config->arith_config == CTX_CONFIG_ARITH_SPARSE_IDL && logic_code == QF_IDL) {
+      *logic = QF_IDL;
+      *arch = CTX_ARCH_ISDL;
+      *mode = config->mode;
+      *iflag = false;
+      *qflag = false;
+      goto done;
+    }
+
     a = logic2arch[logic_code];
     if (a < 0) {
       // not supported
       r = -2;
-    } else if (a == CTX_ARCH_MCSAT && config->mode != CTX_MODE_ONECHECK) {
-      // MCSAT doesn't support push/pop/multichecks
+    } else if (a == CTX_ARCH_MCSAT && config->mode == CTX_MODE_INTERACTIVE) {
+      // MCSAT doesn't support interactive mode
       r = -3;
     } else {
       // good configuration
@@ -602,12 +673,12 @@ int32_t decode_config(const ctx_config_t *config, smt_logic_t *logic, context_ar
     /*
      * MCSAT solver/no logic specified
      */
-    if (config->mode != CTX_MODE_ONECHECK) {
-      r = -3; // Can't currently have MCSAT with push/pop or multiple checks
+    if (config->mode == CTX_MODE_INTERACTIVE) {
+      r = -3; // Can't currently have MCSAT with clean interrupts
     } else {
       *logic = SMT_UNKNOWN;
       *arch = CTX_ARCH_MCSAT;
-      *mode = CTX_MODE_ONECHECK;
+      *mode = config->mode;
       *iflag = false;
       *qflag = false;
       goto done;
@@ -657,8 +728,8 @@ int32_t decode_config(const ctx_config_t *config, smt_logic_t *logic, context_ar
  * CHECK WHETHER A LOGIC IS SUPPORTED BY THE MCSAT SOLVER
  */
 /*
- * mcsat doesn't support arrays/quantifiers/bitvectors
+ * mcsat doesn't support arrays/quantifiers
  */
 bool logic_is_supported_by_mcsat(smt_logic_t code) {
-  return !(logic_has_arrays(code) || logic_has_bv(code) || logic_has_quantifiers(code));
+  return !(logic_has_arrays(code) || logic_has_quantifiers(code));
 }
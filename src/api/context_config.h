@@ -39,6 +39,9 @@
  * - array_solver: whether to use the array/function solver or not
  * - arith_solver: which arithmetic solver to use
  * - arith_fragment: which fragment of arithmetic to support
+ * - portfolio: number of parallel workers used by check_context
+ * - sat_backend: whether to solve purely propositional problems with
+ *   the stand-alone sat solver
  */
 
 #ifndef __CONTEXT_CONFIG_H
@@ -87,9 +90,10 @@ typedef enum solver_code {
   CTX_CONFIG_ARITH_SIMPLEX,   // simplex solver
   CTX_CONFIG_ARITH_IFW,       // integer Floyd-Warshall solver
   CTX_CONFIG_ARITH_RFW,       // real Floyd-Warshall solver
+  CTX_CONFIG_ARITH_SPARSE_IDL, // sparse difference-logic solver (integer)
 } solver_code_t;
 
-#define NUM_SOLVER_CODES (CTX_CONFIG_ARITH_RFW+1)
+#define NUM_SOLVER_CODES (CTX_CONFIG_ARITH_SPARSE_IDL+1)
 
 
 
@@ -105,9 +109,17 @@ struct ctx_config_s {
   solver_code_t         bv_config;
   solver_code_t         arith_config;
   arith_fragment_t      arith_fragment;
+  uint32_t              portfolio_size;
+  bool                  sat_backend;
 };
 
 
+/*
+ * Bound on the portfolio size
+ */
+#define MAX_PORTFOLIO_SIZE 256
+
+
 
 /*
  * Initialize config with the default configuration:
@@ -143,7 +155,7 @@ extern int32_t config_set_logic(ctx_config_t *config, const char *logic);
  *
  * This can't be used to set config->logic: key must be one of "mode",
  * "arith-fragment", "uf-solver", "array-solver", "bv-solver",
- * "arith-solver".
+ * "arith-solver", "portfolio", "sat-backend".
  *
  * Return code:
  *   -1 if the key is not recognized
@@ -66,6 +66,7 @@
  * - VAR_RANDOM_FACTOR = 0.02
  * - CLAUSE_DECAY_FACTOR = 0.999
  * - clause caching is disabled
+ * - DEFAULT_KEEP_LBD = 2 and DEFAULT_TIER2_LBD = 6 are also defined there
  */
 #define DEFAULT_VAR_DECAY      VAR_DECAY_FACTOR
 #define DEFAULT_RANDOMNESS     VAR_RANDOM_FACTOR
@@ -122,6 +123,21 @@
  */
 
 
+/*
+ * Default parameters for the bitvector solver: eager bit-blasting,
+ * no simulation
+ */
+#define DEFAULT_BV_LAZY_BLASTING      false
+#define DEFAULT_BV_SIMULATION         0
+
+
+/*
+ * Default for parallel search: no cube-and-conquer, no clause sharing
+ */
+#define DEFAULT_CUBE_DEPTH            0
+#define DEFAULT_SHARE_LBD             0
+
+
 /*
  * All default parameters
  */
@@ -143,6 +159,8 @@ static const param_t default_settings = {
   DEFAULT_CLAUSE_DECAY,
   DEFAULT_CACHE_TCLAUSES,
   DEFAULT_TCLAUSE_SIZE,
+  DEFAULT_KEEP_LBD,
+  DEFAULT_TIER2_LBD,
 
   DEFAULT_USE_DYN_ACK,
   DEFAULT_USE_BOOL_DYN_ACK,
@@ -164,6 +182,12 @@ static const param_t default_settings = {
 
   DEFAULT_MAX_UPDATE_CONFLICTS,
   DEFAULT_MAX_EXTENSIONALITY,
+
+  DEFAULT_BV_LAZY_BLASTING,
+  DEFAULT_BV_SIMULATION,
+
+  DEFAULT_CUBE_DEPTH,
+  DEFAULT_SHARE_LBD,
 };
 
 
@@ -199,6 +223,8 @@ typedef enum param_key {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_KEEP_LBD,
+  PARAM_TIER2_LBD,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -220,9 +246,15 @@ typedef enum param_key {
   // array solver
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver
+  PARAM_BV_LAZY_BLASTING,
+  PARAM_BV_SIMULATION,
+  // parallel search
+  PARAM_CUBE_DEPTH,
+  PARAM_SHARE_LBD,
 } param_key_t;
 
-#define NUM_PARAM_KEYS (PARAM_MAX_EXTENSIONALITY+1)
+#define NUM_PARAM_KEYS (PARAM_SHARE_LBD+1)
 
 // parameter names in lexicographic ordering
 static const char *const param_key_names[NUM_PARAM_KEYS] = {
@@ -230,10 +262,13 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "aux-eq-ratio",
   "bland-threshold",
   "branching",
+  "bv-lazy-blasting",
+  "bv-simulation",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
   "clause-decay",
+  "cube-depth",
   "d-factor",
   "d-threshold",
   "dyn-ack",
@@ -243,6 +278,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "fast-restarts",
   "icheck",
   "icheck-period",
+  "keep-lbd",
   "max-ack",
   "max-bool-ack",
   "max-extensionality",
@@ -255,9 +291,11 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "r-threshold",
   "random-seed",
   "randomness",
+  "share-lbd",
   "simplex-adjust",
   "simplex-prop",
   "tclause-size",
+  "tier2-lbd",
   "var-decay",
 };
 
@@ -267,10 +305,13 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
   PARAM_BRANCHING,
+  PARAM_BV_LAZY_BLASTING,
+  PARAM_BV_SIMULATION,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
   PARAM_CLAUSE_DECAY,
+  PARAM_CUBE_DEPTH,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
   PARAM_DYN_ACK,
@@ -280,6 +321,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_FAST_RESTART,
   PARAM_SIMPLEX_ICHECK,
   PARAM_ICHECK_PERIOD,
+  PARAM_KEEP_LBD,
   PARAM_MAX_ACK,
   PARAM_MAX_BOOL_ACK,
   PARAM_MAX_EXTENSIONALITY,
@@ -292,9 +334,11 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_R_THRESHOLD,
   PARAM_RANDOM_SEED,
   PARAM_RANDOMNESS,
+  PARAM_SHARE_LBD,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
   PARAM_TCLAUSE_SIZE,
+  PARAM_TIER2_LBD,
   PARAM_VAR_DECAY,
 };
 
@@ -574,6 +618,20 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_KEEP_LBD:
+    r = set_int32_param(value, &z, 0, MAX_CLAUSE_LBD);
+    if (r == 0) {
+      parameters->keep_lbd = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_TIER2_LBD:
+    r = set_int32_param(value, &z, 0, MAX_CLAUSE_LBD);
+    if (r == 0) {
+      parameters->tier2_lbd = (uint32_t) z;
+    }
+    break;
+
   case PARAM_DYN_ACK:
     r = set_bool_param(value, &parameters->use_dyn_ack);
     break;
@@ -684,6 +742,31 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_BV_LAZY_BLASTING:
+    r = set_bool_param(value, &parameters->bv_lazy_blasting);
+    break;
+
+  case PARAM_BV_SIMULATION:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->bv_simulation = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_CUBE_DEPTH:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->cube_depth = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_SHARE_LBD:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->share_lbd = (uint32_t) z;
+    }
+    break;
+
   default:
     assert(k == -1);
     r = -1;
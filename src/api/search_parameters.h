@@ -95,6 +95,11 @@ struct param_s {
    *   in a conflict resolution
    * - parameter tclause_size controls the lemma size: only theory lemmas
    *   of size <= tclause_size are turned into learned clauses
+   *
+   * SMT Core deletion of learned clauses (based on the LBD):
+   * - learned clauses of lbd <= keep_lbd are never deleted
+   * - learned clauses of lbd <= tier2_lbd are kept as long as they
+   *   are used in conflict resolution between two reductions
    */
   double   var_decay;       // decay factor for variable activity
   float    randomness;      // probability of a random pick in select_unassigned_literal
@@ -103,6 +108,8 @@ struct param_s {
   float    clause_decay;    // decay factor for learned-clause activity
   bool     cache_tclauses;
   uint32_t tclause_size;
+  uint32_t keep_lbd;
+  uint32_t tier2_lbd;
 
   /*
    * EGRAPH PARAMETERS
@@ -170,8 +177,33 @@ struct param_s {
   uint32_t max_update_conflicts;
   uint32_t max_extensionality;
 
+  /*
+   * BITVECTOR SOLVER PARAMETERS
+   * - bv_lazy_blasting: if true, the circuits for multiplication,
+   *   division, and remainder are built on demand in final_check
+   * - bv_simulation: number of rounds of random simulation of the
+   *   bit-blasted circuits before search (0 means no simulation)
+   */
+  bool     bv_lazy_blasting;
+  uint32_t bv_simulation;
+
+  /*
+   * PARALLEL SEARCH
+   * - cube_depth: number of splitting variables for cube-and-conquer.
+   *   If positive and the context has more than one worker, the
+   *   search is split into 2^cube_depth cubes solved by the workers
+   *   (0 means portfolio search). Larger values are reduced to
+   *   MAX_CUBE_DEPTH.
+   * - share_lbd: if positive, portfolio workers exchange their short
+   *   learned clauses whose LBD is no more than share_lbd
+   *   (0 means no sharing).
+   */
+  uint32_t cube_depth;
+  uint32_t share_lbd;
 };
 
+#define MAX_CUBE_DEPTH 12
+
 
 
 /************************
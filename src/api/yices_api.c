@@ -92,6 +92,7 @@
 #include "terms/term_utils.h"
 #include "terms/types.h"
 
+#include "utils/cputime.h"
 #include "utils/dl_lists.h"
 #include "utils/int_array_sort.h"
 #include "utils/refcount_strings.h"
@@ -122,8 +123,8 @@ static pprod_table_t pprods;
 static term_table_t terms;
 static term_manager_t manager;
 
-// error report
-static error_report_t error;
+// error report: one per thread in the thread-safe build
+static YICES_THREAD_LOCAL error_report_t error;
 
 // parser, lexer, term stack: all are allocated on demand
 static parser_t *parser;
@@ -151,10 +152,60 @@ static bvconstant_t bv0;
  * Global table. Initially all pointers are NULL
  */
 yices_globals_t __yices_globals = {
-  NULL, NULL, NULL, NULL, NULL, NULL,
+  NULL, NULL, NULL, NULL, NULL,
 };
 
 
+/*
+ * Thread safety: the API functions are wrappers that call the
+ * corresponding _o_yices_xxx function with the locks it needs held.
+ * - types_lock protects the type table and the type names
+ * - terms_lock protects everything else: term table, term manager,
+ *   term names, parser, contexts, and models.
+ * Functions that use terms also read or create types so they take
+ * both locks, always in the order terms_lock then types_lock.
+ * Functions that use only types (MT_PROTECT_TYPES) take types_lock.
+ * Functions that touch only memory owned by the caller (vectors,
+ * configurations, parameter records, error reports) take no lock.
+ *
+ * In the default build, get_yices_lock and release_yices_lock
+ * do nothing.
+ */
+static inline void get_api_locks(void) {
+  get_yices_lock(&__yices_globals.terms_lock);
+  get_yices_lock(&__yices_globals.types_lock);
+}
+
+static inline void release_api_locks(void) {
+  release_yices_lock(&__yices_globals.types_lock);
+  release_yices_lock(&__yices_globals.terms_lock);
+}
+
+#define MT_PROTECT(TYPE, EXPR)                     \
+  TYPE _result;                                    \
+  get_api_locks();                                 \
+  _result = (EXPR);                                \
+  release_api_locks();                             \
+  return _result
+
+#define MT_PROTECT_VOID(EXPR)                      \
+  get_api_locks();                                 \
+  (EXPR);                                          \
+  release_api_locks()
+
+#define MT_PROTECT_TYPES(TYPE, EXPR)               \
+  TYPE _result;                                    \
+  get_yices_lock(&__yices_globals.types_lock);     \
+  _result = (EXPR);                                \
+  release_yices_lock(&__yices_globals.types_lock); \
+  return _result
+
+#define MT_PROTECT_TYPES_VOID(EXPR)                \
+  get_yices_lock(&__yices_globals.types_lock);     \
+  (EXPR);                                          \
+  release_yices_lock(&__yices_globals.types_lock)
+
+
 
 /*
  * Registry tables for root terms and types (for garbage collection).
@@ -172,6 +223,13 @@ static sparse_array_t the_root_terms;
 static sparse_array_t the_root_types;
 
 
+/*
+ * Garbage-collector statistics (the young_terms/young_types
+ * fields are computed on demand)
+ */
+static yices_gc_stats_t gc_stats;
+
+
 
 /************************************
  *  DYNAMICALLY ALLOCATED OBJECTS   *
@@ -253,7 +311,9 @@ static dl_list_t model_list;
 
 /*
  * Context configuration and parameter descriptors
- * are stored in one list.
+ * are stored in one list. The API functions on these
+ * descriptors don't take the API locks, so the list
+ * has its own lock.
  */
 typedef struct {
   dl_list_t header;
@@ -266,6 +326,7 @@ typedef struct {
 } param_structure_elem_t;
 
 static dl_list_t generic_list;
+static yices_lock_t generic_list_lock;
 
 
 
@@ -659,7 +720,9 @@ static inline ctx_config_t *alloc_config_structure(void) {
   ctx_config_elem_t *new_elem;
 
   new_elem = (ctx_config_elem_t *) safe_malloc(sizeof(ctx_config_elem_t));
+  get_yices_lock(&generic_list_lock);
   list_insert_next(&generic_list, &new_elem->header);
+  release_yices_lock(&generic_list_lock);
   return &new_elem->config;
 }
 
@@ -667,7 +730,9 @@ static inline param_t *alloc_param_structure(void) {
   param_structure_elem_t *new_elem;
 
   new_elem = (param_structure_elem_t *) safe_malloc(sizeof(param_structure_elem_t));
+  get_yices_lock(&generic_list_lock);
   list_insert_next(&generic_list, &new_elem->header);
+  release_yices_lock(&generic_list_lock);
   return &new_elem->param;
 }
 
@@ -678,7 +743,9 @@ static inline void free_config_structure(ctx_config_t *c) {
   dl_list_t *elem;
 
   elem = header_of_config_structure(c);
+  get_yices_lock(&generic_list_lock);
   list_remove(elem);
+  release_yices_lock(&generic_list_lock);
   safe_free(elem);
 }
 
@@ -686,7 +753,9 @@ static inline void free_param_structure(param_t *p) {
   dl_list_t *elem;
 
   elem = header_of_param_structure(p);
+  get_yices_lock(&generic_list_lock);
   list_remove(elem);
+  release_yices_lock(&generic_list_lock);
   safe_free(elem);
 }
 
@@ -834,7 +903,6 @@ static void init_globals(yices_globals_t *glob) {
   glob->terms = &terms;
   glob->manager = &manager;
   glob->tstack = NULL;
-  glob->error = &error;
   glob->fvars = NULL;
 }
 
@@ -847,7 +915,6 @@ static void clear_globals(yices_globals_t *glob) {
   glob->terms = NULL;
   glob->manager = NULL;
   glob->tstack = NULL;
-  glob->error = NULL;
   glob->fvars = NULL;
 }
 
@@ -858,6 +925,10 @@ static void clear_globals(yices_globals_t *glob) {
 EXPORTED void yices_init(void) {
   error.code = NO_ERROR;
 
+  create_yices_lock(&__yices_globals.terms_lock);
+  create_yices_lock(&__yices_globals.types_lock);
+  create_yices_lock(&generic_list_lock);
+
   init_yices_pp_tables();
   init_bvconstants();
   init_rationals();
@@ -893,6 +964,7 @@ EXPORTED void yices_init(void) {
   // registries for garbage collection
   root_terms = NULL;
   root_types = NULL;
+  memset(&gc_stats, 0, sizeof(gc_stats));
 
   // prepare the global table
   init_globals(&__yices_globals);
@@ -940,6 +1012,10 @@ EXPORTED void yices_exit(void) {
 
   cleanup_rationals();
   cleanup_bvconstants();
+
+  destroy_yices_lock(&generic_list_lock);
+  destroy_yices_lock(&__yices_globals.types_lock);
+  destroy_yices_lock(&__yices_globals.terms_lock);
 }
 
 
@@ -2405,37 +2481,61 @@ static bool check_child_idx(term_table_t *terms, term_t t, int32_t i) {
  *  TYPE CONSTRUCTORS  *
  **********************/
 
-EXPORTED type_t yices_bool_type(void) {
+static type_t _o_yices_bool_type(void) {
   return bool_type(&types);
 }
 
-EXPORTED type_t yices_int_type(void) {
+EXPORTED type_t yices_bool_type(void) {
+  MT_PROTECT_TYPES(type_t, _o_yices_bool_type());
+}
+
+static type_t _o_yices_int_type(void) {
   return int_type(&types);
 }
 
-EXPORTED type_t yices_real_type(void) {
+EXPORTED type_t yices_int_type(void) {
+  MT_PROTECT_TYPES(type_t, _o_yices_int_type());
+}
+
+static type_t _o_yices_real_type(void) {
   return real_type(&types);
 }
 
-EXPORTED type_t yices_bv_type(uint32_t size) {
+EXPORTED type_t yices_real_type(void) {
+  MT_PROTECT_TYPES(type_t, _o_yices_real_type());
+}
+
+static type_t _o_yices_bv_type(uint32_t size) {
   if (! check_positive(size) || ! check_maxbvsize(size)) {
     return NULL_TYPE;
   }
   return bv_type(&types, size);
 }
 
-EXPORTED type_t yices_new_uninterpreted_type(void) {
+EXPORTED type_t yices_bv_type(uint32_t size) {
+  MT_PROTECT_TYPES(type_t, _o_yices_bv_type(size));
+}
+
+static type_t _o_yices_new_uninterpreted_type(void) {
   return new_uninterpreted_type(&types);
 }
 
-EXPORTED type_t yices_new_scalar_type(uint32_t card) {
+EXPORTED type_t yices_new_uninterpreted_type(void) {
+  MT_PROTECT_TYPES(type_t, _o_yices_new_uninterpreted_type());
+}
+
+static type_t _o_yices_new_scalar_type(uint32_t card) {
   if (! check_positive(card)) {
     return NULL_TYPE;
   }
   return new_scalar_type(&types, card);
 }
 
-EXPORTED type_t yices_tuple_type(uint32_t n, const type_t elem[]) {
+EXPORTED type_t yices_new_scalar_type(uint32_t card) {
+  MT_PROTECT_TYPES(type_t, _o_yices_new_scalar_type(card));
+}
+
+static type_t _o_yices_tuple_type(uint32_t n, const type_t elem[]) {
   if (! check_positive(n) ||
       ! check_arity(n) ||
       ! check_good_types(&types, n, elem)) {
@@ -2444,7 +2544,11 @@ EXPORTED type_t yices_tuple_type(uint32_t n, const type_t elem[]) {
   return tuple_type(&types, n, elem);
 }
 
-EXPORTED type_t yices_function_type(uint32_t n, const type_t dom[], type_t range) {
+EXPORTED type_t yices_tuple_type(uint32_t n, const type_t elem[]) {
+  MT_PROTECT_TYPES(type_t, _o_yices_tuple_type(n, elem));
+}
+
+static type_t _o_yices_function_type(uint32_t n, const type_t dom[], type_t range) {
   if (! check_positive(n) ||
       ! check_arity(n) ||
       ! check_good_type(&types, range) ||
@@ -2454,18 +2558,26 @@ EXPORTED type_t yices_function_type(uint32_t n, const type_t dom[], type_t range
   return function_type(&types, range, n, dom);
 }
 
+EXPORTED type_t yices_function_type(uint32_t n, const type_t dom[], type_t range) {
+  MT_PROTECT_TYPES(type_t, _o_yices_function_type(n, dom, range));
+}
+
 
 /*
  * Variants/short cuts for tuple and function types
  */
-EXPORTED type_t yices_tuple_type1(type_t tau1) {
+static type_t _o_yices_tuple_type1(type_t tau1) {
   if (! check_good_type(&types, tau1)) {
     return NULL_TYPE;
   }
   return tuple_type(&types, 1, &tau1);
 }
 
-EXPORTED type_t yices_tuple_type2(type_t tau1, type_t tau2) {
+EXPORTED type_t yices_tuple_type1(type_t tau1) {
+  MT_PROTECT_TYPES(type_t, _o_yices_tuple_type1(tau1));
+}
+
+static type_t _o_yices_tuple_type2(type_t tau1, type_t tau2) {
   type_t aux[2];
 
   aux[0] = tau1;
@@ -2477,7 +2589,11 @@ EXPORTED type_t yices_tuple_type2(type_t tau1, type_t tau2) {
   return tuple_type(&types, 2, aux);
 }
 
-EXPORTED type_t yices_tuple_type3(type_t tau1, type_t tau2, type_t tau3) {
+EXPORTED type_t yices_tuple_type2(type_t tau1, type_t tau2) {
+  MT_PROTECT_TYPES(type_t, _o_yices_tuple_type2(tau1, tau2));
+}
+
+static type_t _o_yices_tuple_type3(type_t tau1, type_t tau2, type_t tau3) {
   type_t aux[3];
 
   aux[0] = tau1;
@@ -2490,8 +2606,12 @@ EXPORTED type_t yices_tuple_type3(type_t tau1, type_t tau2, type_t tau3) {
   return tuple_type(&types, 3, aux);
 }
 
+EXPORTED type_t yices_tuple_type3(type_t tau1, type_t tau2, type_t tau3) {
+  MT_PROTECT_TYPES(type_t, _o_yices_tuple_type3(tau1, tau2, tau3));
+}
+
 
-EXPORTED type_t yices_function_type1(type_t tau1, type_t range) {
+static type_t _o_yices_function_type1(type_t tau1, type_t range) {
   if (! check_good_type(&types, tau1) ||
       ! check_good_type(&types, range)) {
     return NULL_TYPE;
@@ -2499,7 +2619,11 @@ EXPORTED type_t yices_function_type1(type_t tau1, type_t range) {
   return function_type(&types, range, 1, &tau1);
 }
 
-EXPORTED type_t yices_function_type2(type_t tau1, type_t tau2, type_t range) {
+EXPORTED type_t yices_function_type1(type_t tau1, type_t range) {
+  MT_PROTECT_TYPES(type_t, _o_yices_function_type1(tau1, range));
+}
+
+static type_t _o_yices_function_type2(type_t tau1, type_t tau2, type_t range) {
   type_t aux[2];
 
   aux[0] = tau1;
@@ -2512,7 +2636,11 @@ EXPORTED type_t yices_function_type2(type_t tau1, type_t tau2, type_t range) {
   return function_type(&types, range, 2, aux);
 }
 
-EXPORTED type_t yices_function_type3(type_t tau1, type_t tau2, type_t tau3, type_t range) {
+EXPORTED type_t yices_function_type2(type_t tau1, type_t tau2, type_t range) {
+  MT_PROTECT_TYPES(type_t, _o_yices_function_type2(tau1, tau2, range));
+}
+
+static type_t _o_yices_function_type3(type_t tau1, type_t tau2, type_t tau3, type_t range) {
   type_t aux[3];
 
   aux[0] = tau1;
@@ -2526,6 +2654,10 @@ EXPORTED type_t yices_function_type3(type_t tau1, type_t tau2, type_t tau3, type
   return function_type(&types, range, 3, aux);
 }
 
+EXPORTED type_t yices_function_type3(type_t tau1, type_t tau2, type_t tau3, type_t range) {
+  MT_PROTECT_TYPES(type_t, _o_yices_function_type3(tau1, tau2, tau3, range));
+}
+
 
 
 /*
@@ -2649,15 +2781,23 @@ void yices_delete_type_macro(int32_t id) {
  * When constructing a term to singleton type tau, we always
  * return the representative for tau (except for variables).
  */
-EXPORTED term_t yices_true(void) {
+static term_t _o_yices_true(void) {
   return true_term;
 }
 
-EXPORTED term_t yices_false(void) {
+EXPORTED term_t yices_true(void) {
+  MT_PROTECT(term_t, _o_yices_true());
+}
+
+static term_t _o_yices_false(void) {
   return false_term;
 }
 
-EXPORTED term_t yices_constant(type_t tau, int32_t index) {
+EXPORTED term_t yices_false(void) {
+  MT_PROTECT(term_t, _o_yices_false());
+}
+
+static term_t _o_yices_constant(type_t tau, int32_t index) {
   if (! check_good_constant(&types, tau, index)) {
     return NULL_TERM;
   }
@@ -2665,7 +2805,11 @@ EXPORTED term_t yices_constant(type_t tau, int32_t index) {
   return mk_constant(&manager, tau, index);
 }
 
-EXPORTED term_t yices_new_uninterpreted_term(type_t tau) {
+EXPORTED term_t yices_constant(type_t tau, int32_t index) {
+  MT_PROTECT(term_t, _o_yices_constant(tau, index));
+}
+
+static term_t _o_yices_new_uninterpreted_term(type_t tau) {
   if (! check_good_type(&types, tau)) {
     return NULL_TERM;
   }
@@ -2673,7 +2817,11 @@ EXPORTED term_t yices_new_uninterpreted_term(type_t tau) {
   return mk_uterm(&manager, tau);
 }
 
-EXPORTED term_t yices_new_variable(type_t tau) {
+EXPORTED term_t yices_new_uninterpreted_term(type_t tau) {
+  MT_PROTECT(term_t, _o_yices_new_uninterpreted_term(tau));
+}
+
+static term_t _o_yices_new_variable(type_t tau) {
   if (! check_good_type(&types, tau)) {
     return NULL_TERM;
   }
@@ -2681,12 +2829,16 @@ EXPORTED term_t yices_new_variable(type_t tau) {
   return mk_variable(&manager, tau);
 }
 
+EXPORTED term_t yices_new_variable(type_t tau) {
+  MT_PROTECT(term_t, _o_yices_new_variable(tau));
+}
+
 
 /*
  * Apply fun to arg[0 ...n-1]
  * - we apply beta-reduction eagerly here
  */
-EXPORTED term_t yices_application(term_t fun, uint32_t n, const term_t arg[]) {
+static term_t _o_yices_application(term_t fun, uint32_t n, const term_t arg[]) {
   term_t t;
 
   if (! check_good_application(&manager, fun, n, arg)) {
@@ -2713,14 +2865,22 @@ EXPORTED term_t yices_application(term_t fun, uint32_t n, const term_t arg[]) {
   return t;
 }
 
+EXPORTED term_t yices_application(term_t fun, uint32_t n, const term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_application(fun, n, arg));
+}
+
 /*
  * Variants for small n
  */
-EXPORTED term_t yices_application1(term_t fun, term_t arg1) {
+static term_t _o_yices_application1(term_t fun, term_t arg1) {
   return yices_application(fun, 1, &arg1);
 }
 
-EXPORTED term_t yices_application2(term_t fun, term_t arg1, term_t arg2) {
+EXPORTED term_t yices_application1(term_t fun, term_t arg1) {
+  MT_PROTECT(term_t, _o_yices_application1(fun, arg1));
+}
+
+static term_t _o_yices_application2(term_t fun, term_t arg1, term_t arg2) {
   term_t aux[2];
 
   aux[0] = arg1;
@@ -2728,7 +2888,11 @@ EXPORTED term_t yices_application2(term_t fun, term_t arg1, term_t arg2) {
   return yices_application(fun, 2, aux);
 }
 
-EXPORTED term_t yices_application3(term_t fun, term_t arg1, term_t arg2, term_t arg3) {
+EXPORTED term_t yices_application2(term_t fun, term_t arg1, term_t arg2) {
+  MT_PROTECT(term_t, _o_yices_application2(fun, arg1, arg2));
+}
+
+static term_t _o_yices_application3(term_t fun, term_t arg1, term_t arg2, term_t arg3) {
   term_t aux[3];
 
   aux[0] = arg1;
@@ -2737,9 +2901,13 @@ EXPORTED term_t yices_application3(term_t fun, term_t arg1, term_t arg2, term_t
   return yices_application(fun, 3, aux);
 }
 
+EXPORTED term_t yices_application3(term_t fun, term_t arg1, term_t arg2, term_t arg3) {
+  MT_PROTECT(term_t, _o_yices_application3(fun, arg1, arg2, arg3));
+}
+
 
 
-EXPORTED term_t yices_ite(term_t cond, term_t then_term, term_t else_term) {
+static term_t _o_yices_ite(term_t cond, term_t then_term, term_t else_term) {
   term_table_t *tbl;
   type_t tau;
 
@@ -2768,8 +2936,12 @@ EXPORTED term_t yices_ite(term_t cond, term_t then_term, term_t else_term) {
   return mk_ite(&manager, cond, then_term, else_term, tau);
 }
 
+EXPORTED term_t yices_ite(term_t cond, term_t then_term, term_t else_term) {
+  MT_PROTECT(term_t, _o_yices_ite(cond, then_term, else_term));
+}
+
 
-EXPORTED term_t yices_eq(term_t left, term_t right) {
+static term_t _o_yices_eq(term_t left, term_t right) {
   if (! check_good_eq(&manager, left, right)) {
     return NULL_TERM;
   }
@@ -2777,7 +2949,11 @@ EXPORTED term_t yices_eq(term_t left, term_t right) {
   return mk_eq(&manager, left, right);
 }
 
-EXPORTED term_t yices_neq(term_t left, term_t right) {
+EXPORTED term_t yices_eq(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_eq(left, right));
+}
+
+static term_t _o_yices_neq(term_t left, term_t right) {
   if (! check_good_eq(&manager, left, right)) {
     return NULL_TERM;
   }
@@ -2785,11 +2961,15 @@ EXPORTED term_t yices_neq(term_t left, term_t right) {
   return mk_neq(&manager, left, right);
 }
 
+EXPORTED term_t yices_neq(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_neq(left, right));
+}
+
 
 /*
  * BOOLEAN NEGATION
  */
-EXPORTED term_t yices_not(term_t arg) {
+static term_t _o_yices_not(term_t arg) {
   if (! check_good_term(&manager, arg) ||
       ! check_boolean_term(&manager, arg)) {
     return NULL_TERM;
@@ -2798,11 +2978,15 @@ EXPORTED term_t yices_not(term_t arg) {
   return opposite_term(arg);
 }
 
+EXPORTED term_t yices_not(term_t arg) {
+  MT_PROTECT(term_t, _o_yices_not(arg));
+}
+
 
 /*
  * OR, AND, and XOR may modify arg
  */
-EXPORTED term_t yices_or(uint32_t n, term_t arg[]) {
+static term_t _o_yices_or(uint32_t n, term_t arg[]) {
   if (! check_arity(n) ||
       ! check_good_terms(&manager, n, arg) ||
       ! check_boolean_args(&manager, n, arg)) {
@@ -2821,7 +3005,11 @@ EXPORTED term_t yices_or(uint32_t n, term_t arg[]) {
   }
 }
 
-EXPORTED term_t yices_and(uint32_t n, term_t arg[]) {
+EXPORTED term_t yices_or(uint32_t n, term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_or(n, arg));
+}
+
+static term_t _o_yices_and(uint32_t n, term_t arg[]) {
   if (! check_arity(n) ||
       ! check_good_terms(&manager, n, arg) ||
       ! check_boolean_args(&manager, n, arg)) {
@@ -2840,7 +3028,11 @@ EXPORTED term_t yices_and(uint32_t n, term_t arg[]) {
   }
 }
 
-EXPORTED term_t yices_xor(uint32_t n, term_t arg[]) {
+EXPORTED term_t yices_and(uint32_t n, term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_and(n, arg));
+}
+
+static term_t _o_yices_xor(uint32_t n, term_t arg[]) {
   if (! check_arity(n) ||
       ! check_good_terms(&manager, n, arg) ||
       ! check_boolean_args(&manager, n, arg)) {
@@ -2859,10 +3051,14 @@ EXPORTED term_t yices_xor(uint32_t n, term_t arg[]) {
   }
 }
 
+EXPORTED term_t yices_xor(uint32_t n, term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_xor(n, arg));
+}
+
 
 
 // Variant: 3 arguments
-EXPORTED term_t yices_or3(term_t t1, term_t t2, term_t t3) {
+static term_t _o_yices_or3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -2872,7 +3068,11 @@ EXPORTED term_t yices_or3(term_t t1, term_t t2, term_t t3) {
   return yices_or(3, aux);
 }
 
-EXPORTED term_t yices_and3(term_t t1, term_t t2, term_t t3) {
+EXPORTED term_t yices_or3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_or3(t1, t2, t3));
+}
+
+static term_t _o_yices_and3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -2882,7 +3082,11 @@ EXPORTED term_t yices_and3(term_t t1, term_t t2, term_t t3) {
   return yices_and(3, aux);
 }
 
-EXPORTED term_t yices_xor3(term_t t1, term_t t2, term_t t3) {
+EXPORTED term_t yices_and3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_and3(t1, t2, t3));
+}
+
+static term_t _o_yices_xor3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -2892,12 +3096,16 @@ EXPORTED term_t yices_xor3(term_t t1, term_t t2, term_t t3) {
   return yices_xor(3, aux);
 }
 
+EXPORTED term_t yices_xor3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_xor3(t1, t2, t3));
+}
+
 
 
 /*
  * BINARY VERSIONS OF OR/AND/XOR
  */
-EXPORTED term_t yices_or2(term_t left, term_t right) {
+static term_t _o_yices_or2(term_t left, term_t right) {
   if (! check_good_term(&manager, left) ||
       ! check_good_term(&manager, right) ||
       ! check_boolean_term(&manager, left) ||
@@ -2908,7 +3116,11 @@ EXPORTED term_t yices_or2(term_t left, term_t right) {
   return mk_binary_or(&manager, left, right);
 }
 
-EXPORTED term_t yices_and2(term_t left, term_t right) {
+EXPORTED term_t yices_or2(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_or2(left, right));
+}
+
+static term_t _o_yices_and2(term_t left, term_t right) {
   if (! check_good_term(&manager, left) ||
       ! check_good_term(&manager, right) ||
       ! check_boolean_term(&manager, left) ||
@@ -2919,7 +3131,11 @@ EXPORTED term_t yices_and2(term_t left, term_t right) {
   return mk_binary_and(&manager, left, right);
 }
 
-EXPORTED term_t yices_xor2(term_t left, term_t right) {
+EXPORTED term_t yices_and2(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_and2(left, right));
+}
+
+static term_t _o_yices_xor2(term_t left, term_t right) {
   if (! check_good_term(&manager, left) ||
       ! check_good_term(&manager, right) ||
       ! check_boolean_term(&manager, left) ||
@@ -2930,8 +3146,12 @@ EXPORTED term_t yices_xor2(term_t left, term_t right) {
   return mk_binary_xor(&manager, left, right);
 }
 
+EXPORTED term_t yices_xor2(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_xor2(left, right));
+}
+
 
-EXPORTED term_t yices_iff(term_t left, term_t right) {
+static term_t _o_yices_iff(term_t left, term_t right) {
   if (! check_good_term(&manager, left) ||
       ! check_good_term(&manager, right) ||
       ! check_boolean_term(&manager, left) ||
@@ -2942,7 +3162,11 @@ EXPORTED term_t yices_iff(term_t left, term_t right) {
   return mk_iff(&manager, left, right);
 }
 
-EXPORTED term_t yices_implies(term_t left, term_t right) {
+EXPORTED term_t yices_iff(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_iff(left, right));
+}
+
+static term_t _o_yices_implies(term_t left, term_t right) {
   if (! check_good_term(&manager, left) ||
       ! check_good_term(&manager, right) ||
       ! check_boolean_term(&manager, left) ||
@@ -2953,8 +3177,12 @@ EXPORTED term_t yices_implies(term_t left, term_t right) {
   return mk_implies(&manager, left, right);
 }
 
+EXPORTED term_t yices_implies(term_t left, term_t right) {
+  MT_PROTECT(term_t, _o_yices_implies(left, right));
+}
+
 
-EXPORTED term_t yices_tuple(uint32_t n, const term_t arg[]) {
+static term_t _o_yices_tuple(uint32_t n, const term_t arg[]) {
   if (! check_positive(n) ||
       ! check_arity(n) ||
       ! check_good_terms(&manager, n, arg)) {
@@ -2964,8 +3192,12 @@ EXPORTED term_t yices_tuple(uint32_t n, const term_t arg[]) {
   return mk_tuple(&manager, n, arg);
 }
 
+EXPORTED term_t yices_tuple(uint32_t n, const term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_tuple(n, arg));
+}
+
 // variants for n=2 or n=3
-EXPORTED term_t yices_pair(term_t arg1, term_t arg2) {
+static term_t _o_yices_pair(term_t arg1, term_t arg2) {
   term_t aux[2];
 
   aux[0] = arg1;
@@ -2976,7 +3208,11 @@ EXPORTED term_t yices_pair(term_t arg1, term_t arg2) {
   return mk_tuple(&manager, 2, aux);
 }
 
-EXPORTED term_t yices_triple(term_t arg1, term_t arg2, term_t arg3) {
+EXPORTED term_t yices_pair(term_t arg1, term_t arg2) {
+  MT_PROTECT(term_t, _o_yices_pair(arg1, arg2));
+}
+
+static term_t _o_yices_triple(term_t arg1, term_t arg2, term_t arg3) {
   term_t aux[3];
 
   aux[0] = arg1;
@@ -2988,9 +3224,13 @@ EXPORTED term_t yices_triple(term_t arg1, term_t arg2, term_t arg3) {
   return mk_tuple(&manager, 3, aux);
 }
 
+EXPORTED term_t yices_triple(term_t arg1, term_t arg2, term_t arg3) {
+  MT_PROTECT(term_t, _o_yices_triple(arg1, arg2, arg3));
+}
+
 
 
-EXPORTED term_t yices_select(uint32_t index, term_t tuple) {
+static term_t _o_yices_select(uint32_t index, term_t tuple) {
   if (! check_good_select(&manager, index, tuple)) {
     return NULL_TERM;
   }
@@ -2999,7 +3239,11 @@ EXPORTED term_t yices_select(uint32_t index, term_t tuple) {
   return mk_select(&manager, index-1, tuple);
 }
 
-EXPORTED term_t yices_update(term_t fun, uint32_t n, const term_t arg[], term_t new_v) {
+EXPORTED term_t yices_select(uint32_t index, term_t tuple) {
+  MT_PROTECT(term_t, _o_yices_select(index, tuple));
+}
+
+static term_t _o_yices_update(term_t fun, uint32_t n, const term_t arg[], term_t new_v) {
   if (! check_good_update(&manager, fun, n, arg, new_v)) {
     return NULL_TERM;
   }
@@ -3007,12 +3251,20 @@ EXPORTED term_t yices_update(term_t fun, uint32_t n, const term_t arg[], term_t
   return mk_update(&manager, fun, n, arg, new_v);
 }
 
+EXPORTED term_t yices_update(term_t fun, uint32_t n, const term_t arg[], term_t new_v) {
+  MT_PROTECT(term_t, _o_yices_update(fun, n, arg, new_v));
+}
+
 // Variants for n=1, 2, or 3
-EXPORTED term_t yices_update1(term_t fun, term_t arg1, term_t new_v) {
+static term_t _o_yices_update1(term_t fun, term_t arg1, term_t new_v) {
   return yices_update(fun, 1, &arg1, new_v);
 }
 
-EXPORTED term_t yices_update2(term_t fun, term_t arg1, term_t arg2, term_t new_v) {
+EXPORTED term_t yices_update1(term_t fun, term_t arg1, term_t new_v) {
+  MT_PROTECT(term_t, _o_yices_update1(fun, arg1, new_v));
+}
+
+static term_t _o_yices_update2(term_t fun, term_t arg1, term_t arg2, term_t new_v) {
   term_t aux[2];
 
   aux[0] = arg1;
@@ -3020,7 +3272,11 @@ EXPORTED term_t yices_update2(term_t fun, term_t arg1, term_t arg2, term_t new_v
   return yices_update(fun, 2, aux, new_v);
 }
 
-EXPORTED term_t yices_update3(term_t fun, term_t arg1, term_t arg2, term_t arg3, term_t new_v) {
+EXPORTED term_t yices_update2(term_t fun, term_t arg1, term_t arg2, term_t new_v) {
+  MT_PROTECT(term_t, _o_yices_update2(fun, arg1, arg2, new_v));
+}
+
+static term_t _o_yices_update3(term_t fun, term_t arg1, term_t arg2, term_t arg3, term_t new_v) {
   term_t aux[3];
 
   aux[0] = arg1;
@@ -3029,9 +3285,13 @@ EXPORTED term_t yices_update3(term_t fun, term_t arg1, term_t arg2, term_t arg3,
   return yices_update(fun, 3, aux, new_v);
 }
 
+EXPORTED term_t yices_update3(term_t fun, term_t arg1, term_t arg2, term_t arg3, term_t new_v) {
+  MT_PROTECT(term_t, _o_yices_update3(fun, arg1, arg2, arg3, new_v));
+}
+
 
 
-EXPORTED term_t yices_distinct(uint32_t n, term_t arg[]) {
+static term_t _o_yices_distinct(uint32_t n, term_t arg[]) {
   if (! check_positive(n) ||
       ! check_arity(n) ||
       ! check_good_distinct_term(&manager, n, arg)) {
@@ -3041,7 +3301,11 @@ EXPORTED term_t yices_distinct(uint32_t n, term_t arg[]) {
   return mk_distinct(&manager, n, arg);
 }
 
-EXPORTED term_t yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
+EXPORTED term_t yices_distinct(uint32_t n, term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_distinct(n, arg));
+}
+
+static term_t _o_yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
   if (! check_good_tuple_update(&manager, index, tuple, new_v)) {
     return NULL_TERM;
   }
@@ -3050,7 +3314,11 @@ EXPORTED term_t yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
   return mk_tuple_update(&manager, tuple, index-1, new_v);
 }
 
-EXPORTED term_t yices_forall(uint32_t n, term_t var[], term_t body) {
+EXPORTED term_t yices_tuple_update(term_t tuple, uint32_t index, term_t new_v) {
+  MT_PROTECT(term_t, _o_yices_tuple_update(tuple, index, new_v));
+}
+
+static term_t _o_yices_forall(uint32_t n, term_t var[], term_t body) {
   if (n > 1) {
     int_array_sort(var, n);
   }
@@ -3062,7 +3330,11 @@ EXPORTED term_t yices_forall(uint32_t n, term_t var[], term_t body) {
   return mk_forall(&manager, n, var, body);
 }
 
-EXPORTED term_t yices_exists(uint32_t n, term_t var[], term_t body) {
+EXPORTED term_t yices_forall(uint32_t n, term_t var[], term_t body) {
+  MT_PROTECT(term_t, _o_yices_forall(n, var, body));
+}
+
+static term_t _o_yices_exists(uint32_t n, term_t var[], term_t body) {
   if (n > 1) {
     int_array_sort(var, n);
   }
@@ -3074,7 +3346,11 @@ EXPORTED term_t yices_exists(uint32_t n, term_t var[], term_t body) {
   return mk_exists(&manager, n, var, body);
 }
 
-EXPORTED term_t yices_lambda(uint32_t n, const term_t var[], term_t body) {
+EXPORTED term_t yices_exists(uint32_t n, term_t var[], term_t body) {
+  MT_PROTECT(term_t, _o_yices_exists(n, var, body));
+}
+
+static term_t _o_yices_lambda(uint32_t n, const term_t var[], term_t body) {
   if (! check_good_lambda_term(&manager, n, var, body)) {
     return NULL_TERM;
   }
@@ -3082,6 +3358,10 @@ EXPORTED term_t yices_lambda(uint32_t n, const term_t var[], term_t body) {
   return mk_lambda(&manager, n, var, body);
 }
 
+EXPORTED term_t yices_lambda(uint32_t n, const term_t var[], term_t body) {
+  MT_PROTECT(term_t, _o_yices_lambda(n, var, body));
+}
+
 
 
 
@@ -3092,25 +3372,37 @@ EXPORTED term_t yices_lambda(uint32_t n, const term_t var[], term_t body) {
 /*
  * Integer constants
  */
-EXPORTED term_t yices_zero(void) {
+static term_t _o_yices_zero(void) {
   return zero_term;
 }
 
-EXPORTED term_t yices_int32(int32_t val) {
+EXPORTED term_t yices_zero(void) {
+  MT_PROTECT(term_t, _o_yices_zero());
+}
+
+static term_t _o_yices_int32(int32_t val) {
   q_set32(&r0, val);
   return  mk_arith_constant(&manager, &r0);
 }
 
-EXPORTED term_t yices_int64(int64_t val) {
+EXPORTED term_t yices_int32(int32_t val) {
+  MT_PROTECT(term_t, _o_yices_int32(val));
+}
+
+static term_t _o_yices_int64(int64_t val) {
   q_set64(&r0, val);
   return mk_arith_constant(&manager, &r0);
 }
 
+EXPORTED term_t yices_int64(int64_t val) {
+  MT_PROTECT(term_t, _o_yices_int64(val));
+}
+
 
 /*
  * Rational constants
  */
-EXPORTED term_t yices_rational32(int32_t num, uint32_t den) {
+static term_t _o_yices_rational32(int32_t num, uint32_t den) {
   if (den == 0) {
     error.code = DIVISION_BY_ZERO;
     return NULL_TERM;
@@ -3120,7 +3412,11 @@ EXPORTED term_t yices_rational32(int32_t num, uint32_t den) {
   return mk_arith_constant(&manager, &r0);
 }
 
-EXPORTED term_t yices_rational64(int64_t num, uint64_t den) {
+EXPORTED term_t yices_rational32(int32_t num, uint32_t den) {
+  MT_PROTECT(term_t, _o_yices_rational32(num, den));
+}
+
+static term_t _o_yices_rational64(int64_t num, uint64_t den) {
   if (den == 0) {
     error.code = DIVISION_BY_ZERO;
     return NULL_TERM;
@@ -3130,11 +3426,15 @@ EXPORTED term_t yices_rational64(int64_t num, uint64_t den) {
   return mk_arith_constant(&manager, &r0);
 }
 
+EXPORTED term_t yices_rational64(int64_t num, uint64_t den) {
+  MT_PROTECT(term_t, _o_yices_rational64(num, den));
+}
+
 
 /*
  * Constant from GMP integers or rationals
  */
-EXPORTED term_t yices_mpz(const mpz_t z) {
+static term_t _o_yices_mpz(const mpz_t z) {
   term_t t;
 
   q_set_mpz(&r0, z);
@@ -3144,7 +3444,11 @@ EXPORTED term_t yices_mpz(const mpz_t z) {
   return t;
 }
 
-EXPORTED term_t yices_mpq(const mpq_t q) {
+EXPORTED term_t yices_mpz(const mpz_t z) {
+  MT_PROTECT(term_t, _o_yices_mpz(z));
+}
+
+static term_t _o_yices_mpq(const mpq_t q) {
   term_t t;
 
   q_set_mpq(&r0, q);
@@ -3154,6 +3458,10 @@ EXPORTED term_t yices_mpq(const mpq_t q) {
   return t;
 }
 
+EXPORTED term_t yices_mpq(const mpq_t q) {
+  MT_PROTECT(term_t, _o_yices_mpq(q));
+}
+
 
 /*
  * Convert a string to a rational or integer term.
@@ -3169,7 +3477,7 @@ EXPORTED term_t yices_mpq(const mpq_t q) {
  *    code = INVALID_RATIONAL_FORMAT
  * or code = DIVISION_BY_ZERO
  */
-EXPORTED term_t yices_parse_rational(const char *s) {
+static term_t _o_yices_parse_rational(const char *s) {
   int32_t code;
   term_t t;
 
@@ -3191,6 +3499,10 @@ EXPORTED term_t yices_parse_rational(const char *s) {
   return t;
 }
 
+EXPORTED term_t yices_parse_rational(const char *s) {
+  MT_PROTECT(term_t, _o_yices_parse_rational(s));
+}
+
 
 /*
  * Convert a string in floating point format to a rational
@@ -3205,7 +3517,7 @@ EXPORTED term_t yices_parse_rational(const char *s) {
  * Error report:
  * code = INVALID_FLOAT_FORMAT
  */
-EXPORTED term_t yices_parse_float(const char *s) {
+static term_t _o_yices_parse_float(const char *s) {
   term_t t;
 
   if (q_set_from_float_string(&r0, s) < 0) {
@@ -3220,7 +3532,11 @@ EXPORTED term_t yices_parse_float(const char *s) {
   return t;
 }
 
-
+EXPORTED term_t yices_parse_float(const char *s) {
+  MT_PROTECT(term_t, _o_yices_parse_float(s));
+}
+
+
 
 /***************************
  *  ARITHMETIC OPERATIONS  *
@@ -3229,7 +3545,7 @@ EXPORTED term_t yices_parse_float(const char *s) {
 /*
  * Add t1 and t2
  */
-EXPORTED term_t yices_add(term_t t1, term_t t2) {
+static term_t _o_yices_add(term_t t1, term_t t2) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3246,11 +3562,15 @@ EXPORTED term_t yices_add(term_t t1, term_t t2) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_add(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_add(t1, t2));
+}
+
 
 /*
  * Subtract t2 from t1
  */
-EXPORTED term_t yices_sub(term_t t1, term_t t2) {
+static term_t _o_yices_sub(term_t t1, term_t t2) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3267,11 +3587,15 @@ EXPORTED term_t yices_sub(term_t t1, term_t t2) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_sub(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_sub(t1, t2));
+}
+
 
 /*
  * Negate t1
  */
-EXPORTED term_t yices_neg(term_t t1) {
+static term_t _o_yices_neg(term_t t1) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3288,11 +3612,15 @@ EXPORTED term_t yices_neg(term_t t1) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_neg(term_t t1) {
+  MT_PROTECT(term_t, _o_yices_neg(t1));
+}
+
 
 /*
  * Multiply t1 and t2
  */
-EXPORTED term_t yices_mul(term_t t1, term_t t2) {
+static term_t _o_yices_mul(term_t t1, term_t t2) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3310,11 +3638,15 @@ EXPORTED term_t yices_mul(term_t t1, term_t t2) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_mul(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_mul(t1, t2));
+}
+
 
 /*
  * Compute the square of t1
  */
-EXPORTED term_t yices_square(term_t t1) {
+static term_t _o_yices_square(term_t t1) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3333,11 +3665,15 @@ EXPORTED term_t yices_square(term_t t1) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_square(term_t t1) {
+  MT_PROTECT(term_t, _o_yices_square(t1));
+}
+
 
 /*
  * Compute t1 ^ d
  */
-EXPORTED term_t yices_power(term_t t1, uint32_t d) {
+static term_t _o_yices_power(term_t t1, uint32_t d) {
   rba_buffer_t *b;
   term_table_t *tbl;
 
@@ -3355,11 +3691,15 @@ EXPORTED term_t yices_power(term_t t1, uint32_t d) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_power(term_t t1, uint32_t d) {
+  MT_PROTECT(term_t, _o_yices_power(t1, d));
+}
+
 
 /*
  * Sum of n terms t[0] ... t[n-1]
  */
-EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
+static term_t _o_yices_sum(uint32_t n, const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3379,11 +3719,15 @@ EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_sum(n, t));
+}
+
 
 /*
  * Product of n terms t[0] ... t[n-1]
  */
-EXPORTED term_t yices_product(uint32_t n, const term_t t[]) {
+static term_t _o_yices_product(uint32_t n, const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3417,13 +3761,17 @@ EXPORTED term_t yices_product(uint32_t n, const term_t t[]) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_product(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_product(n, t));
+}
+
 
 
 
 /*
  * DIVISION
  */
-EXPORTED term_t yices_division(term_t t1, term_t t2) {
+static term_t _o_yices_division(term_t t1, term_t t2) {
   if (! check_good_term(&manager, t1) ||
       ! check_good_term(&manager, t2) ||
       ! check_arith_term(&manager, t1) ||
@@ -3434,13 +3782,17 @@ EXPORTED term_t yices_division(term_t t1, term_t t2) {
   return mk_arith_rdiv(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_division(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_division(t1, t2));
+}
+
 
 
 /***************************
  *  DIV/MOD AND RELATIVES  *
  **************************/
 
-EXPORTED term_t yices_idiv(term_t t1, term_t t2) {
+static term_t _o_yices_idiv(term_t t1, term_t t2) {
   if (! check_good_term(&manager, t1) ||
       ! check_good_term(&manager, t2) ||
       ! check_arith_term(&manager, t1) ||
@@ -3451,7 +3803,11 @@ EXPORTED term_t yices_idiv(term_t t1, term_t t2) {
   return mk_arith_idiv(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_imod(term_t t1, term_t t2) {
+EXPORTED term_t yices_idiv(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_idiv(t1, t2));
+}
+
+static term_t _o_yices_imod(term_t t1, term_t t2) {
   if (! check_good_term(&manager, t1) ||
       ! check_good_term(&manager, t2) ||
       ! check_arith_term(&manager, t1) ||
@@ -3462,10 +3818,14 @@ EXPORTED term_t yices_imod(term_t t1, term_t t2) {
   return mk_arith_mod(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_imod(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_imod(t1, t2));
+}
+
 /*
  * Divisibility test: check whether t1 divides t2
  */
-EXPORTED term_t yices_divides_atom(term_t t1, term_t t2) {
+static term_t _o_yices_divides_atom(term_t t1, term_t t2) {
   if (! check_good_term(&manager, t1) ||
       ! check_good_term(&manager, t2) ||
       ! check_arith_constant(&manager, t1) ||
@@ -3476,10 +3836,14 @@ EXPORTED term_t yices_divides_atom(term_t t1, term_t t2) {
   return mk_arith_divides(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_divides_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_divides_atom(t1, t2));
+}
+
 /*
  * Integer test
  */
-EXPORTED term_t yices_is_int_atom(term_t t) {
+static term_t _o_yices_is_int_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3488,11 +3852,15 @@ EXPORTED term_t yices_is_int_atom(term_t t) {
   return mk_arith_is_int(&manager, t);
 }
 
+EXPORTED term_t yices_is_int_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_is_int_atom(t));
+}
+
 
 /*
  * ABS/FLOOR/CEIL
  */
-EXPORTED term_t yices_abs(term_t t) {
+static term_t _o_yices_abs(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3501,7 +3869,11 @@ EXPORTED term_t yices_abs(term_t t) {
   return mk_arith_abs(&manager, t);
 }
 
-EXPORTED term_t yices_floor(term_t t) {
+EXPORTED term_t yices_abs(term_t t) {
+  MT_PROTECT(term_t, _o_yices_abs(t));
+}
+
+static term_t _o_yices_floor(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3510,7 +3882,11 @@ EXPORTED term_t yices_floor(term_t t) {
   return mk_arith_floor(&manager, t);
 }
 
-EXPORTED term_t yices_ceil(term_t t) {
+EXPORTED term_t yices_floor(term_t t) {
+  MT_PROTECT(term_t, _o_yices_floor(t));
+}
+
+static term_t _o_yices_ceil(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3519,6 +3895,10 @@ EXPORTED term_t yices_ceil(term_t t) {
   return mk_arith_ceil(&manager, t);
 }
 
+EXPORTED term_t yices_ceil(term_t t) {
+  MT_PROTECT(term_t, _o_yices_ceil(t));
+}
+
 
 
 
@@ -3530,7 +3910,7 @@ EXPORTED term_t yices_ceil(term_t t) {
 /*
  * integer coefficients
  */
-EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
+static term_t _o_yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3551,7 +3931,11 @@ EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]
   return mk_arith_term(&manager, b);
 }
 
-EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
+EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_int32(n, a, t));
+}
+
+static term_t _o_yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3572,6 +3956,10 @@ EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_int64(n, a, t));
+}
+
 
 /*
  * Polynomial with rational coefficients
@@ -3582,7 +3970,7 @@ EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]
  * if den[i] is 0
  *   code = DIVISION_BY_ZERO
  */
-EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
+static term_t _o_yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3604,7 +3992,11 @@ EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uin
   return mk_arith_term(&manager, b);
 }
 
-EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
+EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_rational32(n, num, den, t));
+}
+
+static term_t _o_yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3626,11 +4018,15 @@ EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uin
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_rational64(n, num, den, t));
+}
+
 
 /*
  * GMP integers and rationals
  */
-EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
+static term_t _o_yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3653,8 +4049,12 @@ EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_mpz(n, z, t));
+}
 
-EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
+
+static term_t _o_yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -3677,6 +4077,10 @@ EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
   return mk_arith_term(&manager, b);
 }
 
+EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_poly_mpq(n, q, t));
+}
+
 
 
 
@@ -3686,53 +4090,77 @@ EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
  *  ARITHMETIC ATOMS  *
  *********************/
 
-EXPORTED term_t yices_arith_eq_atom(term_t t1, term_t t2) {
+static term_t _o_yices_arith_eq_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_eq(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_arith_neq_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_arith_eq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_eq_atom(t1, t2));
+}
+
+static term_t _o_yices_arith_neq_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_neq(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_arith_geq_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_arith_neq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_neq_atom(t1, t2));
+}
+
+static term_t _o_yices_arith_geq_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_geq(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_arith_lt_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_arith_geq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_geq_atom(t1, t2));
+}
+
+static term_t _o_yices_arith_lt_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_lt(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_arith_gt_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_arith_lt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_lt_atom(t1, t2));
+}
+
+static term_t _o_yices_arith_gt_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_gt(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_arith_leq_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_arith_gt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_gt_atom(t1, t2));
+}
+
+static term_t _o_yices_arith_leq_atom(term_t t1, term_t t2) {
   if (! check_both_arith_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_arith_leq(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_arith_leq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_arith_leq_atom(t1, t2));
+}
+
 
 /*
  * Comparison with zero
  */
-EXPORTED term_t yices_arith_eq0_atom(term_t t) {
+static term_t _o_yices_arith_eq0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3740,7 +4168,11 @@ EXPORTED term_t yices_arith_eq0_atom(term_t t) {
   return mk_arith_term_eq0(&manager, t);
 }
 
-EXPORTED term_t yices_arith_neq0_atom(term_t t) {
+EXPORTED term_t yices_arith_eq0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_eq0_atom(t));
+}
+
+static term_t _o_yices_arith_neq0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3748,7 +4180,11 @@ EXPORTED term_t yices_arith_neq0_atom(term_t t) {
   return mk_arith_term_neq0(&manager, t);
 }
 
-EXPORTED term_t yices_arith_geq0_atom(term_t t) {
+EXPORTED term_t yices_arith_neq0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_neq0_atom(t));
+}
+
+static term_t _o_yices_arith_geq0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3756,7 +4192,11 @@ EXPORTED term_t yices_arith_geq0_atom(term_t t) {
   return mk_arith_term_geq0(&manager, t);
 }
 
-EXPORTED term_t yices_arith_leq0_atom(term_t t) {
+EXPORTED term_t yices_arith_geq0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_geq0_atom(t));
+}
+
+static term_t _o_yices_arith_leq0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3764,7 +4204,11 @@ EXPORTED term_t yices_arith_leq0_atom(term_t t) {
   return mk_arith_term_leq0(&manager, t);
 }
 
-EXPORTED term_t yices_arith_gt0_atom(term_t t) {
+EXPORTED term_t yices_arith_leq0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_leq0_atom(t));
+}
+
+static term_t _o_yices_arith_gt0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3772,7 +4216,11 @@ EXPORTED term_t yices_arith_gt0_atom(term_t t) {
   return mk_arith_term_gt0(&manager, t);
 }
 
-EXPORTED term_t yices_arith_lt0_atom(term_t t) {
+EXPORTED term_t yices_arith_gt0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_gt0_atom(t));
+}
+
+static term_t _o_yices_arith_lt0_atom(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_arith_term(&manager, t)) {
     return NULL_TERM;
@@ -3780,13 +4228,17 @@ EXPORTED term_t yices_arith_lt0_atom(term_t t) {
   return mk_arith_term_lt0(&manager, t);
 }
 
+EXPORTED term_t yices_arith_lt0_atom(term_t t) {
+  MT_PROTECT(term_t, _o_yices_arith_lt0_atom(t));
+}
+
 
 
 /**************************
  *  BITVECTOR CONSTANTS   *
  *************************/
 
-EXPORTED term_t yices_bvconst_uint32(uint32_t n, uint32_t x) {
+static term_t _o_yices_bvconst_uint32(uint32_t n, uint32_t x) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3797,7 +4249,11 @@ EXPORTED term_t yices_bvconst_uint32(uint32_t n, uint32_t x) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_uint64(uint32_t n, uint64_t x) {
+EXPORTED term_t yices_bvconst_uint32(uint32_t n, uint32_t x) {
+  MT_PROTECT(term_t, _o_yices_bvconst_uint32(n, x));
+}
+
+static term_t _o_yices_bvconst_uint64(uint32_t n, uint64_t x) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3808,7 +4264,11 @@ EXPORTED term_t yices_bvconst_uint64(uint32_t n, uint64_t x) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_int32(uint32_t n, int32_t x) {
+EXPORTED term_t yices_bvconst_uint64(uint32_t n, uint64_t x) {
+  MT_PROTECT(term_t, _o_yices_bvconst_uint64(n, x));
+}
+
+static term_t _o_yices_bvconst_int32(uint32_t n, int32_t x) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3819,7 +4279,11 @@ EXPORTED term_t yices_bvconst_int32(uint32_t n, int32_t x) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_int64(uint32_t n, int64_t x) {
+EXPORTED term_t yices_bvconst_int32(uint32_t n, int32_t x) {
+  MT_PROTECT(term_t, _o_yices_bvconst_int32(n, x));
+}
+
+static term_t _o_yices_bvconst_int64(uint32_t n, int64_t x) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3830,7 +4294,11 @@ EXPORTED term_t yices_bvconst_int64(uint32_t n, int64_t x) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_mpz(uint32_t n, const mpz_t x) {
+EXPORTED term_t yices_bvconst_int64(uint32_t n, int64_t x) {
+  MT_PROTECT(term_t, _o_yices_bvconst_int64(n, x));
+}
+
+static term_t _o_yices_bvconst_mpz(uint32_t n, const mpz_t x) {
   mpz_t aux;
 
   if (!check_positive(n) || !check_maxbvsize(n)) {
@@ -3856,13 +4324,17 @@ EXPORTED term_t yices_bvconst_mpz(uint32_t n, const mpz_t x) {
   return mk_bv_constant(&manager, &bv0);
 }
 
+EXPORTED term_t yices_bvconst_mpz(uint32_t n, const mpz_t x) {
+  MT_PROTECT(term_t, _o_yices_bvconst_mpz(n, x));
+}
+
 
 /*
  * bvconst_zero: set all bits to 0
  * bvconst_one: set low-order bit to 1, all the others to 0
  * bvconst_minus_one: set all bits to 1
  */
-EXPORTED term_t yices_bvconst_zero(uint32_t n) {
+static term_t _o_yices_bvconst_zero(uint32_t n) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3872,7 +4344,11 @@ EXPORTED term_t yices_bvconst_zero(uint32_t n) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_one(uint32_t n) {
+EXPORTED term_t yices_bvconst_zero(uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_bvconst_zero(n));
+}
+
+static term_t _o_yices_bvconst_one(uint32_t n) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3883,7 +4359,11 @@ EXPORTED term_t yices_bvconst_one(uint32_t n) {
   return mk_bv_constant(&manager, &bv0);
 }
 
-EXPORTED term_t yices_bvconst_minus_one(uint32_t n) {
+EXPORTED term_t yices_bvconst_one(uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_bvconst_one(n));
+}
+
+static term_t _o_yices_bvconst_minus_one(uint32_t n) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3893,13 +4373,17 @@ EXPORTED term_t yices_bvconst_minus_one(uint32_t n) {
   return mk_bv_constant(&manager, &bv0);
 }
 
+EXPORTED term_t yices_bvconst_minus_one(uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_bvconst_minus_one(n));
+}
+
 
 /*
  * Convert an integer array to a bit constant
  * - a[i] =  0 --> bit i = 0
  * - a[i] != 0 --> bit i = 1
  */
-EXPORTED term_t yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
+static term_t _o_yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
   if (!check_positive(n) || !check_maxbvsize(n)) {
     return NULL_TERM;
   }
@@ -3910,6 +4394,10 @@ EXPORTED term_t yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
   return mk_bv_constant(&manager, &bv0);
 }
 
+EXPORTED term_t yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
+  MT_PROTECT(term_t, _o_yices_bvconst_from_array(n, a));
+}
+
 
 
 /*
@@ -3918,7 +4406,7 @@ EXPORTED term_t yices_bvconst_from_array(uint32_t n, const int32_t a[]) {
  * - the string is read in big-endian format: the first character
  *   is the high-order bit.
  */
-EXPORTED term_t yices_parse_bvbin(const char *s) {
+static term_t _o_yices_parse_bvbin(const char *s) {
   size_t len;
   uint32_t n;
   int32_t code;
@@ -3946,6 +4434,10 @@ EXPORTED term_t yices_parse_bvbin(const char *s) {
   return mk_bv_constant(&manager, &bv0);
 }
 
+EXPORTED term_t yices_parse_bvbin(const char *s) {
+  MT_PROTECT(term_t, _o_yices_parse_bvbin(s));
+}
+
 
 /*
  * Parse a string of hexadecimal digits and convert it to a bit constant
@@ -3954,7 +4446,7 @@ EXPORTED term_t yices_parse_bvbin(const char *s) {
  * - the string is read in big-endian format (the first character defines
  *   the four high-order bits).
  */
-EXPORTED term_t yices_parse_bvhex(const char *s) {
+static term_t _o_yices_parse_bvhex(const char *s) {
   size_t len;
   uint32_t n;
   int32_t code;
@@ -3982,6 +4474,10 @@ EXPORTED term_t yices_parse_bvhex(const char *s) {
   return mk_bv_constant(&manager, &bv0);
 }
 
+EXPORTED term_t yices_parse_bvhex(const char *s) {
+  MT_PROTECT(term_t, _o_yices_parse_bvhex(s));
+}
+
 
 
 
@@ -4021,7 +4517,7 @@ static term_t mk_bvadd(term_t t1, term_t t2) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvadd(term_t t1, term_t t2) {
+static term_t _o_yices_bvadd(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
@@ -4033,6 +4529,10 @@ EXPORTED term_t yices_bvadd(term_t t1, term_t t2) {
   }
 }
 
+EXPORTED term_t yices_bvadd(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvadd(t1, t2));
+}
+
 
 static term_t mk_bvsub64(term_t t1, term_t t2) {
   bvarith64_buffer_t *b;
@@ -4058,7 +4558,7 @@ static term_t mk_bvsub(term_t t1, term_t t2) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvsub(term_t t1, term_t t2) {
+static term_t _o_yices_bvsub(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
@@ -4070,6 +4570,10 @@ EXPORTED term_t yices_bvsub(term_t t1, term_t t2) {
   }
 }
 
+EXPORTED term_t yices_bvsub(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsub(t1, t2));
+}
+
 
 static term_t mk_bvneg64(term_t t1) {
   bvarith64_buffer_t *b;
@@ -4095,7 +4599,7 @@ static term_t mk_bvneg(term_t t1) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvneg(term_t t1) {
+static term_t _o_yices_bvneg(term_t t1) {
   if (! check_good_term(&manager, t1) ||
       ! check_bitvector_term(&manager, t1)) {
     return NULL_TERM;
@@ -4108,6 +4612,10 @@ EXPORTED term_t yices_bvneg(term_t t1) {
   }
 }
 
+EXPORTED term_t yices_bvneg(term_t t1) {
+  MT_PROTECT(term_t, _o_yices_bvneg(t1));
+}
+
 
 static term_t mk_bvmul64(term_t t1, term_t t2) {
   bvarith64_buffer_t *b;
@@ -4133,7 +4641,7 @@ static term_t mk_bvmul(term_t t1, term_t t2) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvmul(term_t t1, term_t t2) {
+static term_t _o_yices_bvmul(term_t t1, term_t t2) {
   /*
    * check_product_degree may overestimate the degree of the product
    * (since the product of the coefficients of the leading terms in t1
@@ -4152,6 +4660,10 @@ EXPORTED term_t yices_bvmul(term_t t1, term_t t2) {
   }
 }
 
+EXPORTED term_t yices_bvmul(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvmul(t1, t2));
+}
+
 
 static term_t mk_bvsquare64(term_t t1) {
   bvarith64_buffer_t *b;
@@ -4177,7 +4689,7 @@ static term_t mk_bvsquare(term_t t1) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvsquare(term_t t1) {
+static term_t _o_yices_bvsquare(term_t t1) {
   /*
    * check_square_degree may overestimate the degree of the product
    * but we ignore this issue for now. (cf. yices_bvmul)
@@ -4195,6 +4707,10 @@ EXPORTED term_t yices_bvsquare(term_t t1) {
   }
 }
 
+EXPORTED term_t yices_bvsquare(term_t t1) {
+  MT_PROTECT(term_t, _o_yices_bvsquare(t1));
+}
+
 
 static term_t mk_bvpower64(term_t t1, uint32_t d) {
   bvarith64_buffer_t *b;
@@ -4226,7 +4742,7 @@ static term_t mk_bvpower(term_t t1, uint32_t d) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvpower(term_t t1, uint32_t d) {
+static term_t _o_yices_bvpower(term_t t1, uint32_t d) {
   /*
    * check_power_degree may overestimate the degree of (t1^d)
    * but we ignore this for now (cf. yices_bvmul).
@@ -4244,6 +4760,10 @@ EXPORTED term_t yices_bvpower(term_t t1, uint32_t d) {
   }
 }
 
+EXPORTED term_t yices_bvpower(term_t t1, uint32_t d) {
+  MT_PROTECT(term_t, _o_yices_bvpower(t1, d));
+}
+
 
 /************************************
  *  N-ARY BIT-VECTOR SUMS/PRODUCTS  *
@@ -4279,7 +4799,7 @@ static term_t mk_bvsum(uint32_t n, const term_t t[]) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvsum(uint32_t n, const term_t t[]) {
+static term_t _o_yices_bvsum(uint32_t n, const term_t t[]) {
   if (! check_positive(n) ||
       ! check_good_terms(&manager, n, t) ||
       ! check_bitvector_args(&manager, n, t) ||
@@ -4294,6 +4814,10 @@ EXPORTED term_t yices_bvsum(uint32_t n, const term_t t[]) {
   }
 }
 
+EXPORTED term_t yices_bvsum(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvsum(n, t));
+}
+
 
 static term_t mk_bvproduct64(uint32_t n, const term_t t[]) {
   bvarith64_buffer_t *b;
@@ -4325,7 +4849,7 @@ static term_t mk_bvproduct(uint32_t n, const term_t t[]) {
   return mk_bvarith_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvproduct(uint32_t n, const term_t t[]) {
+static term_t _o_yices_bvproduct(uint32_t n, const term_t t[]) {
   uint32_t i;
 
   if (! check_positive(n) ||
@@ -4360,13 +4884,17 @@ EXPORTED term_t yices_bvproduct(uint32_t n, const term_t t[]) {
 
 }
 
+EXPORTED term_t yices_bvproduct(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvproduct(n, t));
+}
+
 
 
 /***********************************
  *  BITWISE BIT-VECTOR OPERATIONS  *
  **********************************/
 
-EXPORTED term_t yices_bvnot(term_t t1) {
+static term_t _o_yices_bvnot(term_t t1) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4383,9 +4911,13 @@ EXPORTED term_t yices_bvnot(term_t t1) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvnot(term_t t1) {
+  MT_PROTECT(term_t, _o_yices_bvnot(t1));
+}
 
 
-EXPORTED term_t yices_bvnand(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvnand(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4402,7 +4934,11 @@ EXPORTED term_t yices_bvnand(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvnor(term_t t1, term_t t2) {
+EXPORTED term_t yices_bvnand(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvnand(t1, t2));
+}
+
+static term_t _o_yices_bvnor(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4419,7 +4955,11 @@ EXPORTED term_t yices_bvnor(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvxnor(term_t t1, term_t t2) {
+EXPORTED term_t yices_bvnor(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvnor(t1, t2));
+}
+
+static term_t _o_yices_bvxnor(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4436,12 +4976,16 @@ EXPORTED term_t yices_bvxnor(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvxnor(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvxnor(t1, t2));
+}
+
 
 /************************************
  *  ASSOCIATIVE BITWISE OPERATIONS  *
  ***********************************/
 
-EXPORTED term_t yices_bvand(uint32_t n, const term_t t[]) {
+static term_t _o_yices_bvand(uint32_t n, const term_t t[]) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -4463,7 +5007,11 @@ EXPORTED term_t yices_bvand(uint32_t n, const term_t t[]) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvor(uint32_t n, const term_t t[]) {
+EXPORTED term_t yices_bvand(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvand(n, t));
+}
+
+static term_t _o_yices_bvor(uint32_t n, const term_t t[]) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -4485,7 +5033,11 @@ EXPORTED term_t yices_bvor(uint32_t n, const term_t t[]) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvxor(uint32_t n, const term_t t[]) {
+EXPORTED term_t yices_bvor(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvor(n, t));
+}
+
+static term_t _o_yices_bvxor(uint32_t n, const term_t t[]) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint32_t i;
@@ -4507,8 +5059,12 @@ EXPORTED term_t yices_bvxor(uint32_t n, const term_t t[]) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvxor(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvxor(n, t));
+}
 
-EXPORTED term_t yices_bvand2(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvand2(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4524,7 +5080,11 @@ EXPORTED term_t yices_bvand2(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvor2(term_t t1, term_t t2) {
+EXPORTED term_t yices_bvand2(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvand2(t1, t2));
+}
+
+static term_t _o_yices_bvor2(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4540,7 +5100,11 @@ EXPORTED term_t yices_bvor2(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_bvxor2(term_t t1, term_t t2) {
+EXPORTED term_t yices_bvor2(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvor2(t1, t2));
+}
+
+static term_t _o_yices_bvxor2(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4556,8 +5120,12 @@ EXPORTED term_t yices_bvxor2(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvxor2(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvxor2(t1, t2));
+}
 
-EXPORTED term_t yices_bvand3(term_t t1, term_t t2, term_t t3) {
+
+static term_t _o_yices_bvand3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -4567,7 +5135,11 @@ EXPORTED term_t yices_bvand3(term_t t1, term_t t2, term_t t3) {
   return yices_bvand(3, aux);
 }
 
-EXPORTED term_t yices_bvor3(term_t t1, term_t t2, term_t t3) {
+EXPORTED term_t yices_bvand3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_bvand3(t1, t2, t3));
+}
+
+static term_t _o_yices_bvor3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -4577,7 +5149,11 @@ EXPORTED term_t yices_bvor3(term_t t1, term_t t2, term_t t3) {
   return yices_bvor(3, aux);
 }
 
-EXPORTED term_t yices_bvxor3(term_t t1, term_t t2, term_t t3) {
+EXPORTED term_t yices_bvor3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_bvor3(t1, t2, t3));
+}
+
+static term_t _o_yices_bvxor3(term_t t1, term_t t2, term_t t3) {
   term_t aux[3];
 
   aux[0] = t1;
@@ -4587,6 +5163,10 @@ EXPORTED term_t yices_bvxor3(term_t t1, term_t t2, term_t t3) {
   return yices_bvor(3, aux);
 }
 
+EXPORTED term_t yices_bvxor3(term_t t1, term_t t2, term_t t3) {
+  MT_PROTECT(term_t, _o_yices_bvxor3(t1, t2, t3));
+}
+
 
 
 
@@ -4619,7 +5199,7 @@ EXPORTED term_t yices_bvxor3(term_t t1, term_t t2, term_t t3) {
  *   code = INVALID_BITSHIFT
  *   badval = n
  */
-EXPORTED term_t yices_shift_left0(term_t t, uint32_t n) {
+static term_t _o_yices_shift_left0(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4638,7 +5218,11 @@ EXPORTED term_t yices_shift_left0(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_shift_left1(term_t t, uint32_t n) {
+EXPORTED term_t yices_shift_left0(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_shift_left0(t, n));
+}
+
+static term_t _o_yices_shift_left1(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4657,7 +5241,11 @@ EXPORTED term_t yices_shift_left1(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_shift_right0(term_t t, uint32_t n) {
+EXPORTED term_t yices_shift_left1(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_shift_left1(t, n));
+}
+
+static term_t _o_yices_shift_right0(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4676,7 +5264,11 @@ EXPORTED term_t yices_shift_right0(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_shift_right1(term_t t, uint32_t n) {
+EXPORTED term_t yices_shift_right0(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_shift_right0(t, n));
+}
+
+static term_t _o_yices_shift_right1(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4695,7 +5287,11 @@ EXPORTED term_t yices_shift_right1(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_ashift_right(term_t t, uint32_t n) {
+EXPORTED term_t yices_shift_right1(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_shift_right1(t, n));
+}
+
+static term_t _o_yices_ashift_right(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4714,7 +5310,11 @@ EXPORTED term_t yices_ashift_right(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_rotate_left(term_t t, uint32_t n) {
+EXPORTED term_t yices_ashift_right(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_ashift_right(t, n));
+}
+
+static term_t _o_yices_rotate_left(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4735,7 +5335,11 @@ EXPORTED term_t yices_rotate_left(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_rotate_right(term_t t, uint32_t n) {
+EXPORTED term_t yices_rotate_left(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_rotate_left(t, n));
+}
+
+static term_t _o_yices_rotate_right(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4756,6 +5360,10 @@ EXPORTED term_t yices_rotate_right(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_rotate_right(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_rotate_right(t, n));
+}
+
 
 
 /****************************************
@@ -4780,7 +5388,7 @@ EXPORTED term_t yices_rotate_right(term_t t, uint32_t n) {
  * if 0 <= i <= j <= m-1 does not hold
  *   code = INVALID_BVEXTRACT
  */
-EXPORTED term_t yices_bvextract(term_t t, uint32_t i, uint32_t j) {
+static term_t _o_yices_bvextract(term_t t, uint32_t i, uint32_t j) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint32_t n;
@@ -4805,6 +5413,10 @@ EXPORTED term_t yices_bvextract(term_t t, uint32_t i, uint32_t j) {
   }
 }
 
+EXPORTED term_t yices_bvextract(term_t t, uint32_t i, uint32_t j) {
+  MT_PROTECT(term_t, _o_yices_bvextract(t, i, j));
+}
+
 
 /*
  * Concatenation
@@ -4823,7 +5435,7 @@ EXPORTED term_t yices_bvextract(term_t t, uint32_t i, uint32_t j) {
  *   code = MAX_BVSIZE_EXCEEDED
  *   badval = n1 + n2 (n1 = size of t1, n2 = size of t2)
  */
-EXPORTED term_t yices_bvconcat2(term_t t1, term_t t2) {
+static term_t _o_yices_bvconcat2(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -4844,11 +5456,15 @@ EXPORTED term_t yices_bvconcat2(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvconcat2(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvconcat2(t1, t2));
+}
+
 
 /*
  * Generic form
  */
-EXPORTED term_t yices_bvconcat(uint32_t n, const term_t t[]) {
+static term_t _o_yices_bvconcat(uint32_t n, const term_t t[]) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint64_t bvsize;
@@ -4881,6 +5497,10 @@ EXPORTED term_t yices_bvconcat(uint32_t n, const term_t t[]) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvconcat(uint32_t n, const term_t t[]) {
+  MT_PROTECT(term_t, _o_yices_bvconcat(n, t));
+}
+
 
 /*
  * Repeated concatenation:
@@ -4903,7 +5523,7 @@ EXPORTED term_t yices_bvconcat(uint32_t n, const term_t t[]) {
  *   code = MAX_BVSIZE_EXCEEDED
  *   badval = n * bitsize of t
  */
-EXPORTED term_t yices_bvrepeat(term_t t, uint32_t n) {
+static term_t _o_yices_bvrepeat(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint64_t m;
@@ -4930,6 +5550,10 @@ EXPORTED term_t yices_bvrepeat(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_bvrepeat(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_bvrepeat(t, n));
+}
+
 
 /*
  * Sign extension
@@ -4949,7 +5573,7 @@ EXPORTED term_t yices_bvrepeat(term_t t, uint32_t n) {
  *   code = MAX_BVSIZE_EXCEEDED
  *   badval = n + bitsize of t
  */
-EXPORTED term_t yices_sign_extend(term_t t, uint32_t n) {
+static term_t _o_yices_sign_extend(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint64_t m;
@@ -4976,6 +5600,10 @@ EXPORTED term_t yices_sign_extend(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_sign_extend(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_sign_extend(t, n));
+}
+
 
 /*
  * Zero extension
@@ -4995,7 +5623,7 @@ EXPORTED term_t yices_sign_extend(term_t t, uint32_t n) {
  *   code = MAX_BVSIZE_EXCEEDED
  *   badval = n + bitsize of t
  */
-EXPORTED term_t yices_zero_extend(term_t t, uint32_t n) {
+static term_t _o_yices_zero_extend(term_t t, uint32_t n) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
   uint64_t m;
@@ -5021,6 +5649,10 @@ EXPORTED term_t yices_zero_extend(term_t t, uint32_t n) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_zero_extend(term_t t, uint32_t n) {
+  MT_PROTECT(term_t, _o_yices_zero_extend(t, n));
+}
+
 
 
 /*
@@ -5040,7 +5672,7 @@ EXPORTED term_t yices_zero_extend(term_t t, uint32_t n) {
  *   code = BITVECTOR_REQUIRED
  *   term1 = t
  */
-EXPORTED term_t yices_redand(term_t t) {
+static term_t _o_yices_redand(term_t t) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -5057,7 +5689,11 @@ EXPORTED term_t yices_redand(term_t t) {
   return mk_bvlogic_term(&manager, b);
 }
 
-EXPORTED term_t yices_redor(term_t t) {
+EXPORTED term_t yices_redand(term_t t) {
+  MT_PROTECT(term_t, _o_yices_redand(t));
+}
+
+static term_t _o_yices_redor(term_t t) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -5074,6 +5710,10 @@ EXPORTED term_t yices_redor(term_t t) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_redor(term_t t) {
+  MT_PROTECT(term_t, _o_yices_redor(t));
+}
+
 
 /*
  * Bitwise equality comparison: if t1 and t2 are bitvectors of size n,
@@ -5096,7 +5736,7 @@ EXPORTED term_t yices_redor(term_t t) {
  *   term2 = t2
  *   type2 = type of t2
  */
-EXPORTED term_t yices_redcomp(term_t t1, term_t t2) {
+static term_t _o_yices_redcomp(term_t t1, term_t t2) {
   bvlogic_buffer_t *b;
   term_table_t *tbl;
 
@@ -5112,6 +5752,10 @@ EXPORTED term_t yices_redcomp(term_t t1, term_t t2) {
   return mk_bvlogic_term(&manager, b);
 }
 
+EXPORTED term_t yices_redcomp(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_redcomp(t1, t2));
+}
+
 
 
 
@@ -5120,7 +5764,7 @@ EXPORTED term_t yices_redcomp(term_t t1, term_t t2) {
  *****************************/
 
 
-EXPORTED term_t yices_bvshl(term_t t1, term_t t2) {
+static term_t _o_yices_bvshl(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
@@ -5128,8 +5772,12 @@ EXPORTED term_t yices_bvshl(term_t t1, term_t t2) {
   return mk_bvshl(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvshl(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvshl(t1, t2));
+}
 
-EXPORTED term_t yices_bvlshr(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvlshr(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
@@ -5137,8 +5785,12 @@ EXPORTED term_t yices_bvlshr(term_t t1, term_t t2) {
   return mk_bvlshr(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvlshr(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvlshr(t1, t2));
+}
 
-EXPORTED term_t yices_bvashr(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvashr(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
@@ -5146,6 +5798,10 @@ EXPORTED term_t yices_bvashr(term_t t1, term_t t2) {
   return mk_bvashr(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvashr(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvashr(t1, t2));
+}
+
 
 
 
@@ -5154,45 +5810,65 @@ EXPORTED term_t yices_bvashr(term_t t1, term_t t2) {
  *  BITVECTOR DIVISION OPERATORS  *
  *********************************/
 
-EXPORTED term_t yices_bvdiv(term_t t1, term_t t2) {
+static term_t _o_yices_bvdiv(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvdiv(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvdiv(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvdiv(t1, t2));
+}
 
-EXPORTED term_t yices_bvrem(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvrem(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvrem(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvrem(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvrem(t1, t2));
+}
 
-EXPORTED term_t yices_bvsdiv(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvsdiv(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsdiv(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvsdiv(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsdiv(t1, t2));
+}
 
-EXPORTED term_t yices_bvsrem(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvsrem(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsrem(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvsrem(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsrem(t1, t2));
+}
 
-EXPORTED term_t yices_bvsmod(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvsmod(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsmod(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvsmod(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsmod(t1, t2));
+}
+
 
 
 /*
@@ -5216,7 +5892,7 @@ EXPORTED term_t yices_bvsmod(term_t t1, term_t t2) {
  *    type1 = bool
  *    index = i
  */
-EXPORTED term_t yices_bvarray(uint32_t n, const term_t arg[]) {
+static term_t _o_yices_bvarray(uint32_t n, const term_t arg[]) {
   if (! check_positive(n) ||
       ! check_maxbvsize(n) ||
       ! check_good_terms(&manager, n, arg) ||
@@ -5226,6 +5902,10 @@ EXPORTED term_t yices_bvarray(uint32_t n, const term_t arg[]) {
   return mk_bvarray(&manager, n, arg);
 }
 
+EXPORTED term_t yices_bvarray(uint32_t n, const term_t arg[]) {
+  MT_PROTECT(term_t, _o_yices_bvarray(n, arg));
+}
+
 
 
 /*
@@ -5242,7 +5922,7 @@ EXPORTED term_t yices_bvarray(uint32_t n, const term_t arg[]) {
  * if i >= v's bitsize
  *    code = INVALID_BVEXTRACT
  */
-EXPORTED term_t yices_bitextract(term_t t, uint32_t i) {
+static term_t _o_yices_bitextract(term_t t, uint32_t i) {
   if (! check_good_term(&manager, t) ||
       ! check_bitvector_term(&manager, t) ||
       ! check_bitextract(i, term_bitsize(&terms, t))) {
@@ -5251,6 +5931,10 @@ EXPORTED term_t yices_bitextract(term_t t, uint32_t i) {
   return mk_bitextract(&manager, t, i);
 }
 
+EXPORTED term_t yices_bitextract(term_t t, uint32_t i) {
+  MT_PROTECT(term_t, _o_yices_bitextract(t, i));
+}
+
 
 
 
@@ -5258,84 +5942,124 @@ EXPORTED term_t yices_bitextract(term_t t, uint32_t i) {
  *  BITVECTOR ATOMS  *
  ********************/
 
-EXPORTED term_t yices_bveq_atom(term_t t1, term_t t2) {
+static term_t _o_yices_bveq_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bveq(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bveq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bveq_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvneq_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvneq_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvneq(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvneq_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvneq_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvge_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvge_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvge(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvge_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvge_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvgt_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvgt_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvgt(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvgt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvgt_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvle_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvle_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvle(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvle_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvle_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvlt_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvlt_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvlt(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvlt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvlt_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvsge_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvsge_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsge(&manager, t1, t2);
 }
 
-EXPORTED term_t yices_bvsgt_atom(term_t t1, term_t t2) {
+EXPORTED term_t yices_bvsge_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsge_atom(t1, t2));
+}
+
+static term_t _o_yices_bvsgt_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsgt(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvsgt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsgt_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvsle_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvsle_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvsle(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvsle_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvsle_atom(t1, t2));
+}
 
-EXPORTED term_t yices_bvslt_atom(term_t t1, term_t t2) {
+
+static term_t _o_yices_bvslt_atom(term_t t1, term_t t2) {
   if (! check_compatible_bv_terms(&manager, t1, t2)) {
     return NULL_TERM;
   }
   return mk_bvslt(&manager, t1, t2);
 }
 
+EXPORTED term_t yices_bvslt_atom(term_t t1, term_t t2) {
+  MT_PROTECT(term_t, _o_yices_bvslt_atom(t1, t2));
+}
+
 
 
 /*********************
@@ -5347,7 +6071,7 @@ EXPORTED term_t yices_bvslt_atom(term_t t1, term_t t2) {
  * - f = output file to use
  * - width, height, offset = print area
  */
-EXPORTED int32_t yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+static int32_t _o_yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   int32_t code;
@@ -5381,7 +6105,11 @@ EXPORTED int32_t yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t hei
   return code;
 }
 
-EXPORTED int32_t yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+EXPORTED int32_t yices_pp_type(FILE *f, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_pp_type(f, tau, width, height, offset));
+}
+
+static int32_t _o_yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
   FILE *tmp_fp;
   int32_t retval;
 
@@ -5398,6 +6126,10 @@ EXPORTED int32_t yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t h
   return retval;
 }
 
+EXPORTED int32_t yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_pp_type_fd(fd, tau, width, height, offset));
+}
+
 
 
 /*
@@ -5405,7 +6137,7 @@ EXPORTED int32_t yices_pp_type_fd(int fd, type_t tau, uint32_t width, uint32_t h
  * - f = output file to use
  * - width, height, offset = print area
  */
-EXPORTED int32_t yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+static int32_t _o_yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   int32_t code;
@@ -5439,7 +6171,11 @@ EXPORTED int32_t yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t heigh
   return code;
 }
 
-EXPORTED int32_t yices_pp_term_fd(int fd, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+EXPORTED int32_t yices_pp_term(FILE *f, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(int32_t, _o_yices_pp_term(f, t, width, height, offset));
+}
+
+static int32_t _o_yices_pp_term_fd(int fd, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
   FILE *tmp_fp;
   int32_t retval;
 
@@ -5457,12 +6193,16 @@ EXPORTED int32_t yices_pp_term_fd(int fd, term_t t, uint32_t width, uint32_t hei
   return retval;
 }
 
+EXPORTED int32_t yices_pp_term_fd(int fd, term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(int32_t, _o_yices_pp_term_fd(fd, t, width, height, offset));
+}
+
 /*
  * Pretty print terms a[0 ... n-1]
  * - f = output file to use
  * - width, height, offset = print area
  */
-EXPORTED int32_t yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
+static int32_t _o_yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
   yices_pp_t printer;
   pp_area_t area;
   int32_t code;
@@ -5504,7 +6244,11 @@ EXPORTED int32_t yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint
   return code;
 }
 
-EXPORTED int32_t yices_pp_term_array_fd(int fd, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
+EXPORTED int32_t yices_pp_term_array(FILE *f, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
+  MT_PROTECT(int32_t, _o_yices_pp_term_array(f, n, a, width, height, offset, horiz));
+}
+
+static int32_t _o_yices_pp_term_array_fd(int fd, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
   FILE *tmp_fp;
   int32_t retval;
 
@@ -5522,12 +6266,16 @@ EXPORTED int32_t yices_pp_term_array_fd(int fd, uint32_t n, const term_t a[], ui
   return retval;
 }
 
+EXPORTED int32_t yices_pp_term_array_fd(int fd, uint32_t n, const term_t a[], uint32_t width, uint32_t height, uint32_t offset, int32_t horiz) {
+  MT_PROTECT(int32_t, _o_yices_pp_term_array_fd(fd, n, a, width, height, offset, horiz));
+}
+
 
 
 /*
  * Conversion to strings
  */
-EXPORTED char *yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+static char *_o_yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   char *str;
@@ -5556,7 +6304,11 @@ EXPORTED char *yices_type_to_string(type_t tau, uint32_t width, uint32_t height,
   return str;
 }
 
-EXPORTED char *yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+EXPORTED char *yices_type_to_string(type_t tau, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT_TYPES(char *, _o_yices_type_to_string(tau, width, height, offset));
+}
+
+static char *_o_yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   char *str;
@@ -5585,6 +6337,10 @@ EXPORTED char *yices_term_to_string(term_t t, uint32_t width, uint32_t height, u
   return str;
 }
 
+EXPORTED char *yices_term_to_string(term_t t, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(char *, _o_yices_term_to_string(t, width, height, offset));
+}
+
 
 EXPORTED void yices_free_string(char *s) {
   safe_free(s);
@@ -5607,42 +6363,78 @@ EXPORTED void yices_free_string(char *s) {
  *   code = INVALID_TYPE
  *   type1 = tau
  */
-EXPORTED int32_t yices_type_is_bool(type_t tau) {
+static int32_t _o_yices_type_is_bool(type_t tau) {
   return check_good_type(&types, tau) && is_boolean_type(tau);
 }
 
-EXPORTED int32_t yices_type_is_int(type_t tau) {
+EXPORTED int32_t yices_type_is_bool(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_bool(tau));
+}
+
+static int32_t _o_yices_type_is_int(type_t tau) {
   return check_good_type(&types, tau) && is_integer_type(tau);
 }
 
-EXPORTED int32_t yices_type_is_real(type_t tau) {
+EXPORTED int32_t yices_type_is_int(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_int(tau));
+}
+
+static int32_t _o_yices_type_is_real(type_t tau) {
   return check_good_type(&types, tau) && is_real_type(tau);
 }
 
-EXPORTED int32_t yices_type_is_arithmetic(type_t tau) {
+EXPORTED int32_t yices_type_is_real(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_real(tau));
+}
+
+static int32_t _o_yices_type_is_arithmetic(type_t tau) {
   return check_good_type(&types, tau) && is_arithmetic_type(tau);
 }
 
-EXPORTED int32_t yices_type_is_bitvector(type_t tau) {
+EXPORTED int32_t yices_type_is_arithmetic(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_arithmetic(tau));
+}
+
+static int32_t _o_yices_type_is_bitvector(type_t tau) {
   return check_good_type(&types, tau) && is_bv_type(&types, tau);
 }
 
-EXPORTED int32_t yices_type_is_tuple(type_t tau) {
+EXPORTED int32_t yices_type_is_bitvector(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_bitvector(tau));
+}
+
+static int32_t _o_yices_type_is_tuple(type_t tau) {
   return check_good_type(&types, tau) && is_tuple_type(&types, tau);
 }
 
-EXPORTED int32_t yices_type_is_function(type_t tau) {
+EXPORTED int32_t yices_type_is_tuple(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_tuple(tau));
+}
+
+static int32_t _o_yices_type_is_function(type_t tau) {
   return check_good_type(&types, tau) && is_function_type(&types, tau);
 }
 
-EXPORTED int32_t yices_type_is_scalar(type_t tau) {
+EXPORTED int32_t yices_type_is_function(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_function(tau));
+}
+
+static int32_t _o_yices_type_is_scalar(type_t tau) {
   return check_good_type(&types, tau) && is_scalar_type(&types, tau);
 }
 
-EXPORTED int32_t yices_type_is_uninterpreted(type_t tau) {
+EXPORTED int32_t yices_type_is_scalar(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_scalar(tau));
+}
+
+static int32_t _o_yices_type_is_uninterpreted(type_t tau) {
   return check_good_type(&types, tau) && is_uninterpreted_type(&types, tau);
 }
 
+EXPORTED int32_t yices_type_is_uninterpreted(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_is_uninterpreted(tau));
+}
+
 
 /*
  * Check whether tau is a subtype of sigma
@@ -5653,10 +6445,14 @@ EXPORTED int32_t yices_type_is_uninterpreted(type_t tau) {
  *   code = INVALID_TYPE
  *   type1 = tau or sigma
  */
-EXPORTED int32_t yices_test_subtype(type_t tau, type_t sigma) {
+static int32_t _o_yices_test_subtype(type_t tau, type_t sigma) {
   return check_good_type(&types, tau) && check_good_type(&types, sigma) && is_subtype(&types, tau, sigma);
 }
 
+EXPORTED int32_t yices_test_subtype(type_t tau, type_t sigma) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_test_subtype(tau, sigma));
+}
+
 /*
  * Number of bits for type tau
  * - return 0 if there's an error
@@ -5669,7 +6465,7 @@ EXPORTED int32_t yices_test_subtype(type_t tau, type_t sigma) {
  *    code = BVTYPE_REQUIRED
  *    type1 = tau
  */
-EXPORTED uint32_t yices_bvtype_size(type_t tau) {
+static uint32_t _o_yices_bvtype_size(type_t tau) {
   if (! check_good_type(&types, tau) ||
       ! check_bvtype(&types, tau)) {
     return 0;
@@ -5677,12 +6473,16 @@ EXPORTED uint32_t yices_bvtype_size(type_t tau) {
   return bv_type_size(&types, tau);
 }
 
+EXPORTED uint32_t yices_bvtype_size(type_t tau) {
+  MT_PROTECT_TYPES(uint32_t, _o_yices_bvtype_size(tau));
+}
+
 
 /*
  * Cardinality of a scalar type
  * - return 0 if there's an error
  */
-EXPORTED uint32_t yices_scalar_type_card(type_t tau) {
+static uint32_t _o_yices_scalar_type_card(type_t tau) {
   if (! check_good_type(&types, tau) ||
       ! check_scalar_type(&types, tau)) {
     return 0;
@@ -5690,6 +6490,10 @@ EXPORTED uint32_t yices_scalar_type_card(type_t tau) {
   return scalar_type_cardinal(&types, tau);
 }
 
+EXPORTED uint32_t yices_scalar_type_card(type_t tau) {
+  MT_PROTECT_TYPES(uint32_t, _o_yices_scalar_type_card(tau));
+}
+
 
 /*
  * Number of children of type tau
@@ -5704,7 +6508,7 @@ EXPORTED uint32_t yices_scalar_type_card(type_t tau) {
  *   code = INVALID_TYPE
  *   type1 = tau
  */
-EXPORTED int32_t yices_type_num_children(type_t tau) {
+static int32_t _o_yices_type_num_children(type_t tau) {
   int32_t n;
 
   if (! check_good_type(&types, tau)) {
@@ -5723,12 +6527,16 @@ EXPORTED int32_t yices_type_num_children(type_t tau) {
   return n;
 }
 
+EXPORTED int32_t yices_type_num_children(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_num_children(tau));
+}
+
 
 /*
  * Get the i-th child of type tau
  * - return NULL_TYPE if there's an error
  */
-EXPORTED type_t yices_type_child(type_t tau, int32_t i) {
+static type_t _o_yices_type_child(type_t tau, int32_t i) {
   tuple_type_t *tup;
   function_type_t *fun;
 
@@ -5757,13 +6565,17 @@ EXPORTED type_t yices_type_child(type_t tau, int32_t i) {
   return NULL_TYPE;
 }
 
+EXPORTED type_t yices_type_child(type_t tau, int32_t i) {
+  MT_PROTECT_TYPES(type_t, _o_yices_type_child(tau, i));
+}
+
 
 
 /*
  * Collect all the children in vector *v
  * - returns -1 for error, 0 if all fine.
  */
-EXPORTED int32_t yices_type_children(type_t tau, type_vector_t *v) {
+static int32_t _o_yices_type_children(type_t tau, type_vector_t *v) {
   tuple_type_t *tup;
   function_type_t *fun;
   uint32_t i, n;
@@ -5791,6 +6603,10 @@ EXPORTED int32_t yices_type_children(type_t tau, type_vector_t *v) {
   return 0;
 }
 
+EXPORTED int32_t yices_type_children(type_t tau, type_vector_t *v) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_type_children(tau, v));
+}
+
 
 
 
@@ -5806,13 +6622,17 @@ EXPORTED int32_t yices_type_children(type_t tau, type_vector_t *v) {
  *   term1 = t
  *   index = -1
  */
-EXPORTED type_t yices_type_of_term(term_t t) {
+static type_t _o_yices_type_of_term(term_t t) {
   if (! check_good_term(&manager, t)) {
     return NULL_TYPE;
   }
   return term_type(&terms, t);
 }
 
+EXPORTED type_t yices_type_of_term(term_t t) {
+  MT_PROTECT(type_t, _o_yices_type_of_term(t));
+}
+
 
 /*
  * Check the type of a term t:
@@ -5822,62 +6642,102 @@ EXPORTED type_t yices_type_of_term(term_t t) {
  * If t is not a valid term, the check functions return false
  * and set the error report as above.
  */
-EXPORTED int32_t yices_term_is_bool(term_t t) {
+static int32_t _o_yices_term_is_bool(term_t t) {
   return check_good_term(&manager, t) && is_boolean_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_int(term_t t) {
-  return check_good_term(&manager, t) && is_integer_term(&terms, t);
+EXPORTED int32_t yices_term_is_bool(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_bool(t));
 }
 
-EXPORTED int32_t yices_term_is_real(term_t t) {
+static int32_t _o_yices_term_is_int(term_t t) {
+  return check_good_term(&manager, t) && is_integer_term(&terms, t);
+}
+
+EXPORTED int32_t yices_term_is_int(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_int(t));
+}
+
+static int32_t _o_yices_term_is_real(term_t t) {
   return check_good_term(&manager, t) && is_real_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_arithmetic(term_t t) {
+EXPORTED int32_t yices_term_is_real(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_real(t));
+}
+
+static int32_t _o_yices_term_is_arithmetic(term_t t) {
   return check_good_term(&manager, t) && is_arithmetic_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_bitvector(term_t t) {
+EXPORTED int32_t yices_term_is_arithmetic(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_arithmetic(t));
+}
+
+static int32_t _o_yices_term_is_bitvector(term_t t) {
   return check_good_term(&manager, t) && is_bitvector_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_tuple(term_t t) {
+EXPORTED int32_t yices_term_is_bitvector(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_bitvector(t));
+}
+
+static int32_t _o_yices_term_is_tuple(term_t t) {
   return check_good_term(&manager, t) && is_tuple_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_function(term_t t) {
+EXPORTED int32_t yices_term_is_tuple(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_tuple(t));
+}
+
+static int32_t _o_yices_term_is_function(term_t t) {
   return check_good_term(&manager, t) && is_function_term(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_scalar(term_t t) {
+EXPORTED int32_t yices_term_is_function(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_function(t));
+}
+
+static int32_t _o_yices_term_is_scalar(term_t t) {
   term_table_t *tbl;
 
   tbl = &terms;
   return check_good_term(&manager, t) && (is_scalar_term(tbl, t) || is_utype_term(tbl, t));
 }
 
+EXPORTED int32_t yices_term_is_scalar(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_scalar(t));
+}
+
 
 /*
  * Size of bitvector term t.
  * return 0 if t is not a bitvector
  */
-EXPORTED uint32_t yices_term_bitsize(term_t t) {
+static uint32_t _o_yices_term_bitsize(term_t t) {
   if (! check_bitvector_term(&manager, t)) {
     return 0;
   }
   return term_bitsize(&terms, t);
 }
 
+EXPORTED uint32_t yices_term_bitsize(term_t t) {
+  MT_PROTECT(uint32_t, _o_yices_term_bitsize(t));
+}
+
 
 /*
  * Check whether t is ground
  * - return false if t is not valid and set the error report
  */
-EXPORTED int32_t yices_term_is_ground(term_t t) {
+static int32_t _o_yices_term_is_ground(term_t t) {
   return check_good_term(&manager, t) && term_is_ground(get_fvars(), t);
 }
 
+EXPORTED int32_t yices_term_is_ground(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_ground(t));
+}
+
 
 /*
  * Get the free variables of t
@@ -5895,36 +6755,60 @@ harray_t *yices_free_vars_of_term(term_t t) {
  * Check structure of term t
  * - return false if t is not valid
  */
-EXPORTED int32_t yices_term_is_atomic(term_t t) {
+static int32_t _o_yices_term_is_atomic(term_t t) {
   return check_good_term(&manager, t) && term_is_atomic(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_composite(term_t t) {
+EXPORTED int32_t yices_term_is_atomic(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_atomic(t));
+}
+
+static int32_t _o_yices_term_is_composite(term_t t) {
   return check_good_term(&manager, t) && term_is_composite(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_projection(term_t t) {
+EXPORTED int32_t yices_term_is_composite(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_composite(t));
+}
+
+static int32_t _o_yices_term_is_projection(term_t t) {
   return check_good_term(&manager, t) && term_is_projection(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_sum(term_t t) {
+EXPORTED int32_t yices_term_is_projection(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_projection(t));
+}
+
+static int32_t _o_yices_term_is_sum(term_t t) {
   return check_good_term(&manager, t) && term_is_sum(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_bvsum(term_t t) {
+EXPORTED int32_t yices_term_is_sum(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_sum(t));
+}
+
+static int32_t _o_yices_term_is_bvsum(term_t t) {
   return check_good_term(&manager, t) && term_is_bvsum(&terms, t);
 }
 
-EXPORTED int32_t yices_term_is_product(term_t t) {
+EXPORTED int32_t yices_term_is_bvsum(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_bvsum(t));
+}
+
+static int32_t _o_yices_term_is_product(term_t t) {
   return check_good_term(&manager, t) && term_is_product(&terms, t);
 }
 
+EXPORTED int32_t yices_term_is_product(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_is_product(t));
+}
+
 
 /*
  * Constructor for term t:
  * - the return code is defined in yices_types.h
  */
-EXPORTED term_constructor_t yices_term_constructor(term_t t) {
+static term_constructor_t _o_yices_term_constructor(term_t t) {
   if (! check_good_term(&manager, t)) {
     return YICES_CONSTRUCTOR_ERROR;
   } else {
@@ -5932,6 +6816,10 @@ EXPORTED term_constructor_t yices_term_constructor(term_t t) {
   }
 }
 
+EXPORTED term_constructor_t yices_term_constructor(term_t t) {
+  MT_PROTECT(term_constructor_t, _o_yices_term_constructor(t));
+}
+
 
 /*
  * Number of children of term t
@@ -5943,18 +6831,22 @@ EXPORTED term_constructor_t yices_term_constructor(term_t t) {
  *
  * - returns -1 if t is not a valid term
  */
-EXPORTED int32_t yices_term_num_children(term_t t) {
+static int32_t _o_yices_term_num_children(term_t t) {
   if (! check_good_term(&manager, t)) {
     return -1;
   }
   return term_num_children(&terms, t);
 }
 
+EXPORTED int32_t yices_term_num_children(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_term_num_children(t));
+}
+
 
 /*
  * Get i-th child of a composite term
  */
-EXPORTED term_t yices_term_child(term_t t, int32_t i) {
+static term_t _o_yices_term_child(term_t t, int32_t i) {
   if (! check_good_term(&manager, t) ||
       ! check_composite(&terms, t) ||
       ! check_child_idx(&terms, t, i)) {
@@ -5963,11 +6855,15 @@ EXPORTED term_t yices_term_child(term_t t, int32_t i) {
   return term_child(&terms, t, i);
 }
 
+EXPORTED term_t yices_term_child(term_t t, int32_t i) {
+  MT_PROTECT(term_t, _o_yices_term_child(t, i));
+}
+
 
 /*
  * Get the argument and index of a projection
  */
-EXPORTED int32_t yices_proj_index(term_t t) {
+static int32_t _o_yices_proj_index(term_t t) {
   int32_t idx;
 
   if (! check_good_term(&manager, t) ||
@@ -5984,7 +6880,11 @@ EXPORTED int32_t yices_proj_index(term_t t) {
   return idx;
 }
 
-EXPORTED term_t yices_proj_arg(term_t t) {
+EXPORTED int32_t yices_proj_index(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_proj_index(t));
+}
+
+static term_t _o_yices_proj_arg(term_t t) {
   if (! check_good_term(&manager, t) ||
       ! check_projection(&terms, t)) {
     return NULL_TERM;
@@ -5992,11 +6892,15 @@ EXPORTED term_t yices_proj_arg(term_t t) {
   return proj_term_arg(&terms, t);
 }
 
+EXPORTED term_t yices_proj_arg(term_t t) {
+  MT_PROTECT(term_t, _o_yices_proj_arg(t));
+}
+
 
 /*
  * Value of a constant term
  */
-EXPORTED int32_t yices_bool_const_value(term_t t, int32_t *val) {
+static int32_t _o_yices_bool_const_value(term_t t, int32_t *val) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_BOOL_CONSTANT)) {
     return -1;
@@ -6005,7 +6909,11 @@ EXPORTED int32_t yices_bool_const_value(term_t t, int32_t *val) {
   return 0;
 }
 
-EXPORTED int32_t yices_bv_const_value(term_t t, int32_t val[]) {
+EXPORTED int32_t yices_bool_const_value(term_t t, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_bool_const_value(t, val));
+}
+
+static int32_t _o_yices_bv_const_value(term_t t, int32_t val[]) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_BV_CONSTANT)) {
     return -1;
@@ -6014,7 +6922,11 @@ EXPORTED int32_t yices_bv_const_value(term_t t, int32_t val[]) {
   return 0;
 }
 
-EXPORTED int32_t yices_scalar_const_value(term_t t, int32_t *val) {
+EXPORTED int32_t yices_bv_const_value(term_t t, int32_t val[]) {
+  MT_PROTECT(int32_t, _o_yices_bv_const_value(t, val));
+}
+
+static int32_t _o_yices_scalar_const_value(term_t t, int32_t *val) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_SCALAR_CONSTANT)) {
     return -1;
@@ -6023,7 +6935,11 @@ EXPORTED int32_t yices_scalar_const_value(term_t t, int32_t *val) {
   return 0;
 }
 
-EXPORTED int32_t yices_rational_const_value(term_t t, mpq_t q) {
+EXPORTED int32_t yices_scalar_const_value(term_t t, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_scalar_const_value(t, val));
+}
+
+static int32_t _o_yices_rational_const_value(term_t t, mpq_t q) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_ARITH_CONSTANT)) {
     return -1;
@@ -6032,6 +6948,10 @@ EXPORTED int32_t yices_rational_const_value(term_t t, mpq_t q) {
   return 0;
 }
 
+EXPORTED int32_t yices_rational_const_value(term_t t, mpq_t q) {
+  MT_PROTECT(int32_t, _o_yices_rational_const_value(t, q));
+}
+
 
 /*
  * Components of a sum t
@@ -6040,7 +6960,7 @@ EXPORTED int32_t yices_rational_const_value(term_t t, mpq_t q) {
  * - for a bitvector sum, each component is a pair (bvconstant, term)
  * - the number of bits in the bvconstant is the same as in t
  */
-EXPORTED int32_t yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
+static int32_t _o_yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_ARITH_SUM) ||
       ! check_child_idx(&terms, t, i)) {
@@ -6050,7 +6970,11 @@ EXPORTED int32_t yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *t
   return 0;
 }
 
-EXPORTED int32_t yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *term) {
+EXPORTED int32_t yices_sum_component(term_t t, int32_t i, mpq_t coeff, term_t *term) {
+  MT_PROTECT(int32_t, _o_yices_sum_component(t, i, coeff, term));
+}
+
+static int32_t _o_yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *term) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_BV_SUM) ||
       ! check_child_idx(&terms, t, i)) {
@@ -6060,6 +6984,10 @@ EXPORTED int32_t yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_
   return 0;
 }
 
+EXPORTED int32_t yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_t *term) {
+  MT_PROTECT(int32_t, _o_yices_bvsum_component(t, i, val, term));
+}
+
 
 /*
  * Component of power product t
@@ -6067,7 +6995,7 @@ EXPORTED int32_t yices_bvsum_component(term_t t, int32_t i, int32_t val[], term_
  * - the component is of the form (term, exponent)
  *   (where exponent is a positive integer)
  */
-EXPORTED int32_t yices_product_component(term_t t, int32_t i, term_t *term, uint32_t *exp) {
+static int32_t _o_yices_product_component(term_t t, int32_t i, term_t *term, uint32_t *exp) {
   if (! check_good_term(&manager, t) ||
       ! check_constructor(&terms, t, YICES_POWER_PRODUCT) ||
       ! check_child_idx(&terms, t, i)) {
@@ -6077,6 +7005,10 @@ EXPORTED int32_t yices_product_component(term_t t, int32_t i, term_t *term, uint
   return 0;
 }
 
+EXPORTED int32_t yices_product_component(term_t t, int32_t i, term_t *term, uint32_t *exp) {
+  MT_PROTECT(int32_t, _o_yices_product_component(t, i, term, exp));
+}
+
 
 /***********************************
  *  EXTENSIONS: TERM CONSTRUCTORS  *
@@ -6490,7 +7422,7 @@ bool yices_arith_buffer_is_int(rba_buffer_t *b) {
  * - TYPE_MISMATCH if map[i]'s type is not a subtype of var[i]'s type
  * - DEGREE_OVERFLOW if the substitution causes an overflow
  */
-EXPORTED term_t yices_subst_term(uint32_t n, const term_t var[], const term_t map[], term_t t) {
+static term_t _o_yices_subst_term(uint32_t n, const term_t var[], const term_t map[], term_t t) {
   term_subst_t subst;
   term_t u;
 
@@ -6518,11 +7450,15 @@ EXPORTED term_t yices_subst_term(uint32_t n, const term_t var[], const term_t ma
   return u;
 }
 
+EXPORTED term_t yices_subst_term(uint32_t n, const term_t var[], const term_t map[], term_t t) {
+  MT_PROTECT(term_t, _o_yices_subst_term(n, var, map, t));
+}
+
 
 /*
  * Variant: apply the substitution to m terms t[0 .. m-1]
  */
-EXPORTED int32_t yices_subst_term_array(uint32_t n, const term_t var[], const term_t map[], uint32_t m, term_t t[]) {
+static int32_t _o_yices_subst_term_array(uint32_t n, const term_t var[], const term_t map[], uint32_t m, term_t t[]) {
   term_subst_t subst;
   term_t u;
   uint32_t i;
@@ -6556,6 +7492,10 @@ EXPORTED int32_t yices_subst_term_array(uint32_t n, const term_t var[], const te
   return -1;
 }
 
+EXPORTED int32_t yices_subst_term_array(uint32_t n, const term_t var[], const term_t map[], uint32_t m, term_t t[]) {
+  MT_PROTECT(int32_t, _o_yices_subst_term_array(n, var, map, m, t));
+}
+
 
 
 /**************
@@ -6566,25 +7506,33 @@ EXPORTED int32_t yices_subst_term_array(uint32_t n, const term_t var[], const te
  * Parse s as a type expression in the Yices language.
  * Return NULL_TYPE if there's an error.
  */
-EXPORTED type_t yices_parse_type(const char *s) {
+static type_t _o_yices_parse_type(const char *s) {
   parser_t *p;
 
   p = get_parser(s);
   return parse_yices_type(p, NULL);
 }
 
+EXPORTED type_t yices_parse_type(const char *s) {
+  MT_PROTECT(type_t, _o_yices_parse_type(s));
+}
+
 
 /*
  * Parse s as a term in the Yices language.
  * Return NULL_TERM if there's an error.
  */
-EXPORTED term_t yices_parse_term(const char *s) {
+static term_t _o_yices_parse_term(const char *s) {
   parser_t *p;
 
   p = get_parser(s);
   return parse_yices_term(p, NULL);
 }
 
+EXPORTED term_t yices_parse_term(const char *s) {
+  MT_PROTECT(term_t, _o_yices_parse_term(s));
+}
+
 
 
 
@@ -6601,7 +7549,7 @@ EXPORTED term_t yices_parse_term(const char *s) {
  * return -1 if tau is invalid and set error report
  * return 0 otherwise.
  */
-EXPORTED int32_t yices_set_type_name(type_t tau, const char *name) {
+static int32_t _o_yices_set_type_name(type_t tau, const char *name) {
   char *clone;
 
   if (! check_good_type(&types, tau)) {
@@ -6615,6 +7563,10 @@ EXPORTED int32_t yices_set_type_name(type_t tau, const char *name) {
   return 0;
 }
 
+EXPORTED int32_t yices_set_type_name(type_t tau, const char *name) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_set_type_name(tau, name));
+}
+
 
 /*
  * Create mapping (name -> t) in the term table.
@@ -6624,7 +7576,7 @@ EXPORTED int32_t yices_set_type_name(type_t tau, const char *name) {
  * return -1 if  is invalid and set error report
  * return 0 otherwise.
  */
-EXPORTED int32_t yices_set_term_name(term_t t, const char *name) {
+static int32_t _o_yices_set_term_name(term_t t, const char *name) {
   char *clone;
 
   if (! check_good_term(&manager, t)) {
@@ -6638,70 +7590,98 @@ EXPORTED int32_t yices_set_term_name(term_t t, const char *name) {
   return 0;
 }
 
+EXPORTED int32_t yices_set_term_name(term_t t, const char *name) {
+  MT_PROTECT(int32_t, _o_yices_set_term_name(t, name));
+}
+
 
 /*
  * Get name of type tau
  * - return NULL if tau has no name (or if tau is not a valid type)
  */
-EXPORTED const char *yices_get_type_name(type_t tau) {
+static const char *_o_yices_get_type_name(type_t tau) {
   if (! check_good_type(&types, tau)) {
     return NULL;
   }
   return type_name(&types, tau);
 }
 
+EXPORTED const char *yices_get_type_name(type_t tau) {
+  MT_PROTECT_TYPES(const char *, _o_yices_get_type_name(tau));
+}
+
 
 /*
  * Get name of term t
  * - return NULL is t has no name (or if t is not a valid term)
  */
-EXPORTED const char *yices_get_term_name(term_t t) {
+static const char *_o_yices_get_term_name(term_t t) {
   if (! check_good_term(&manager, t)) {
     return NULL;
   }
   return term_name(&terms, t);
 }
 
+EXPORTED const char *yices_get_term_name(term_t t) {
+  MT_PROTECT(const char *, _o_yices_get_term_name(t));
+}
+
 
 
 /*
  * Remove name from the type table.
  */
-EXPORTED void yices_remove_type_name(const char *name) {
+static void _o_yices_remove_type_name(const char *name) {
   remove_type_name(&types, name);
 }
 
+EXPORTED void yices_remove_type_name(const char *name) {
+  MT_PROTECT_TYPES_VOID(_o_yices_remove_type_name(name));
+}
+
 
 /*
  * Remove name from the term table.
  */
-EXPORTED void yices_remove_term_name(const char *name) {
+static void _o_yices_remove_term_name(const char *name) {
   remove_term_name(&terms, name);
 }
 
+EXPORTED void yices_remove_term_name(const char *name) {
+  MT_PROTECT_VOID(_o_yices_remove_term_name(name));
+}
+
 
 /*
  * Get type of the given name or return NULL_TYPE (-1)
  */
-EXPORTED type_t yices_get_type_by_name(const char *name) {
+static type_t _o_yices_get_type_by_name(const char *name) {
   return get_type_by_name(&types, name);
 }
 
+EXPORTED type_t yices_get_type_by_name(const char *name) {
+  MT_PROTECT_TYPES(type_t, _o_yices_get_type_by_name(name));
+}
+
 
 /*
  * Get term of the given name or return NULL_TERM
  */
-EXPORTED term_t yices_get_term_by_name(const char *name) {
+static term_t _o_yices_get_term_by_name(const char *name) {
   return get_term_by_name(&terms, name);
 }
 
+EXPORTED term_t yices_get_term_by_name(const char *name) {
+  MT_PROTECT(term_t, _o_yices_get_term_by_name(name));
+}
+
 
 /*
  * Remove the name of type tau (if any)
  * Return -1 if tau is not a valid type and set the error code.
  * Return 0 otherwise.
  */
-EXPORTED int32_t yices_clear_type_name(type_t tau) {
+static int32_t _o_yices_clear_type_name(type_t tau) {
   if (! check_good_type(&types, tau)) {
     return -1;
   }
@@ -6710,6 +7690,10 @@ EXPORTED int32_t yices_clear_type_name(type_t tau) {
   return 0;
 }
 
+EXPORTED int32_t yices_clear_type_name(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_clear_type_name(tau));
+}
+
 
 /*
  * Remove the name of term t (if any)
@@ -6717,7 +7701,7 @@ EXPORTED int32_t yices_clear_type_name(type_t tau) {
  * Return -1 if t is not a valid term (and set the error code)
  * Return 0 otherwise.
  */
-EXPORTED int32_t yices_clear_term_name(term_t t) {
+static int32_t _o_yices_clear_term_name(term_t t) {
   if (! check_good_term(&manager, t)) {
     return -1;
   }
@@ -6726,6 +7710,10 @@ EXPORTED int32_t yices_clear_term_name(term_t t) {
   return 0;
 }
 
+EXPORTED int32_t yices_clear_term_name(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_clear_term_name(t));
+}
+
 
 
 
@@ -6857,7 +7845,7 @@ static const int32_t ctx_option_key[NUM_CTX_OPTIONS] = {
 /*
  * Enable a specific option
  */
-EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option) {
+static int32_t _o_yices_context_enable_option(context_t *ctx, const char *option) {
   int32_t k, r;
 
   r = 0; // default return code: no error
@@ -6910,11 +7898,15 @@ EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option)
   return r;
 }
 
+EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option) {
+  MT_PROTECT(int32_t, _o_yices_context_enable_option(ctx, option));
+}
+
 
 /*
  * Disable a specific option
  */
-EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option) {
+static int32_t _o_yices_context_disable_option(context_t *ctx, const char *option) {
   int32_t k, r;
 
   r = 0; // default return code: no error
@@ -6967,6 +7959,10 @@ EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option
   return r;
 }
 
+EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option) {
+  MT_PROTECT(int32_t, _o_yices_context_disable_option(ctx, option));
+}
+
 
 
 /*************************************
@@ -7118,7 +8114,8 @@ context_t *yices_create_context(smt_logic_t logic, context_arch_t arch, context_
  * - if config is NULL, the default is used.
  * - otherwise, if the configuration is not supported, the function returns NULL.
  */
-EXPORTED context_t *yices_new_context(const ctx_config_t *config) {
+static context_t *_o_yices_new_context(const ctx_config_t *config) {
+  context_t *ctx;
   smt_logic_t logic;
   context_arch_t arch;
   context_mode_t mode;
@@ -7143,18 +8140,32 @@ EXPORTED context_t *yices_new_context(const ctx_config_t *config) {
     }
   }
 
-  return yices_create_context(logic, arch, mode, iflag, qflag);
+  ctx = yices_create_context(logic, arch, mode, iflag, qflag);
+  if (config != NULL) {
+    context_set_portfolio_size(ctx, config->portfolio_size);
+    context_set_sat_backend(ctx, config->sat_backend);
+  }
+
+  return ctx;
+}
+
+EXPORTED context_t *yices_new_context(const ctx_config_t *config) {
+  MT_PROTECT(context_t *, _o_yices_new_context(config));
 }
 
 
 /*
  * Delete ctx
  */
-EXPORTED void yices_free_context(context_t *ctx) {
+static void _o_yices_free_context(context_t *ctx) {
   delete_context(ctx);
   free_context(ctx);
 }
 
+EXPORTED void yices_free_context(context_t *ctx) {
+  MT_PROTECT_VOID(_o_yices_free_context(ctx));
+}
+
 
 
 
@@ -7162,18 +8173,39 @@ EXPORTED void yices_free_context(context_t *ctx) {
  * Get status: return the context's status flag
  * - return one of the codes defined in yices_types.h
  */
-EXPORTED smt_status_t yices_context_status(context_t *ctx) {
+static smt_status_t _o_yices_context_status(context_t *ctx) {
   return context_status(ctx);
 }
 
+EXPORTED smt_status_t yices_context_status(context_t *ctx) {
+  MT_PROTECT(smt_status_t, _o_yices_context_status(ctx));
+}
+
 
 /*
  * Reset: remove all assertions and restore ctx's status to IDLE
  */
-EXPORTED void yices_reset_context(context_t *ctx) {
+static void _o_yices_reset_context(context_t *ctx) {
   reset_context(ctx);
 }
 
+EXPORTED void yices_reset_context(context_t *ctx) {
+  MT_PROTECT_VOID(_o_yices_reset_context(ctx));
+}
+
+
+/*
+ * If ctx's status is UNSAT because of assumptions (i.e., after
+ * check_context_with_assumptions), reset it to IDLE so that ctx
+ * can be used for more assertions and checks.
+ */
+static void clear_unsat_assumptions(context_t *ctx) {
+  if (context_unsat_with_assumptions(ctx) && context_supports_multichecks(ctx)) {
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+  }
+}
+
 
 /*
  * Push: mark a backtrack point
@@ -7186,12 +8218,14 @@ EXPORTED void yices_reset_context(context_t *ctx) {
  * - if the context status is UNSAT or SEARCHING or INTERRUPTED
  *   code = CTX_INVALID_OPERATION
  */
-EXPORTED int32_t yices_push(context_t *ctx) {
+static int32_t _o_yices_push(context_t *ctx) {
   if (! context_supports_pushpop(ctx)) {
     error.code = CTX_OPERATION_NOT_SUPPORTED;
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7217,6 +8251,10 @@ EXPORTED int32_t yices_push(context_t *ctx) {
   return 0;
 }
 
+EXPORTED int32_t yices_push(context_t *ctx) {
+  MT_PROTECT(int32_t, _o_yices_push(ctx));
+}
+
 
 
 /*
@@ -7231,12 +8269,14 @@ EXPORTED int32_t yices_push(context_t *ctx) {
  *   or if the context's status is SEARCHING or INTERRUPTED
  *   code = CTX_INVALID_OPERATION
  */
-EXPORTED int32_t yices_pop(context_t *ctx) {
+static int32_t _o_yices_pop(context_t *ctx) {
   if (! context_supports_pushpop(ctx)) {
     error.code = CTX_OPERATION_NOT_SUPPORTED;
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   if (context_base_level(ctx) == 0) {
     error.code = CTX_INVALID_OPERATION;
     return -1;
@@ -7270,6 +8310,10 @@ EXPORTED int32_t yices_pop(context_t *ctx) {
   return 0;
 }
 
+EXPORTED int32_t yices_pop(context_t *ctx) {
+  MT_PROTECT(int32_t, _o_yices_pop(ctx));
+}
+
 
 
 /*
@@ -7346,7 +8390,7 @@ void yices_internalization_error(int32_t code) {
  * Other error codes are defined in yices_types.h to report that t is
  * outside the logic supported by ctx.
  */
-EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
+static int32_t _o_yices_assert_formula(context_t *ctx, term_t t) {
   int32_t code;
 
   if (! check_good_term(&manager, t) ||
@@ -7354,6 +8398,8 @@ EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7391,12 +8437,16 @@ EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
   return 0;
 }
 
+EXPORTED int32_t yices_assert_formula(context_t *ctx, term_t t) {
+  MT_PROTECT(int32_t, _o_yices_assert_formula(ctx, t));
+}
+
 
 
 /*
  * Same thing for an array of n formulas t[0 ... n-1]
  */
-EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t t[]) {
+static int32_t _o_yices_assert_formulas(context_t *ctx, uint32_t n, const term_t t[]) {
   int32_t code;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -7404,6 +8454,8 @@ EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t
     return -1;
   }
 
+  clear_unsat_assumptions(ctx);
+
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7443,6 +8495,10 @@ EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t
   return 0;
 }
 
+EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t t[]) {
+  MT_PROTECT(int32_t, _o_yices_assert_formulas(ctx, n, t));
+}
+
 
 
 /*
@@ -7460,7 +8516,7 @@ EXPORTED int32_t yices_assert_formulas(context_t *ctx, uint32_t n, const term_t
  * if ctx is not configured to support multiple checks
  *    code = CTX_OPERATION_NOT_SUPPORTED
  */
-EXPORTED int32_t yices_assert_blocking_clause(context_t *ctx) {
+static int32_t _o_yices_assert_blocking_clause(context_t *ctx) {
   switch (context_status(ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -7486,6 +8542,10 @@ EXPORTED int32_t yices_assert_blocking_clause(context_t *ctx) {
   }
 }
 
+EXPORTED int32_t yices_assert_blocking_clause(context_t *ctx) {
+  MT_PROTECT(int32_t, _o_yices_assert_blocking_clause(ctx));
+}
+
 
 
 /*
@@ -7580,6 +8640,7 @@ void yices_set_default_params(param_t *params, smt_logic_t logic, context_arch_t
 
   case CTX_ARCH_IFW:
   case CTX_ARCH_RFW:
+  case CTX_ARCH_ISDL:
     params->cache_tclauses = true;
     params->tclause_size = 20;
     params->fast_restart = true;
@@ -7650,10 +8711,12 @@ EXPORTED void yices_default_params_for_context(context_t *ctx, param_t *params)
  * 3) Otherwise, the function does nothing and returns 'STATUS_ERROR',
  *    it also sets the yices error report (code = CTX_INVALID_OPERATION).
  */
-EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params) {
+static smt_status_t _o_yices_check_context(context_t *ctx, const param_t *params) {
   param_t default_params;
   smt_status_t stat;
 
+  clear_unsat_assumptions(ctx);
+
   stat = context_status(ctx);
   switch (stat) {
   case STATUS_UNKNOWN:
@@ -7688,40 +8751,170 @@ EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params)
   return stat;
 }
 
-
 /*
- * Interrupt the search:
- * - this can be called from a signal handler to stop the search,
- *   after a call to yices_check_context to interrupt the solver.
- *
- * If ctx's status is SEARCHING, then the current search is
- * interrupted and ctx's status flag is updated to
- * INTERRUPTED. Otherwise, the function does nothing.
+ * Prepare for check with assumptions t[0 ... n-1]:
+ * - check the terms and ctx's status, then convert the assumptions
+ *   to literals in ctx.
+ * - return STATUS_IDLE if the search can proceed, or the result
+ *   status otherwise (UNSAT if ctx is already unsat or STATUS_ERROR).
  */
-EXPORTED void yices_stop_search(context_t *ctx) {
-  if (context_status(ctx) == STATUS_SEARCHING) {
-    context_stop_search(ctx);
+static smt_status_t _o_yices_set_assumptions(context_t *ctx, uint32_t n, const term_t t[]) {
+  smt_status_t stat;
+  int32_t code;
+
+  if (ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return STATUS_ERROR;
   }
-}
 
+  if (! check_good_terms(&manager, n, t) ||
+      ! check_boolean_args(&manager, n, t)) {
+    return STATUS_ERROR;
+  }
 
-/************
- *  MODELS  *
- ***********/
+  clear_unsat_assumptions(ctx);
 
-/*
- * Build a model from ctx
- * - keep_subst indicates whether the model should include
- *   the eliminated variables:
- *   keep_subst = 0 means don't keep substitutions,
- *   keep_subst != 0 means keep them
+  stat = context_status(ctx);
+  switch (stat) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    if (! context_supports_multichecks(ctx)) {
+      error.code = CTX_OPERATION_NOT_SUPPORTED;
+      return STATUS_ERROR;
+    }
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+    // fall-through intended
+  case STATUS_IDLE:
+    code = context_set_assumptions(ctx, n, t);
+    if (code < 0) {
+      convert_internalization_error(code);
+      return STATUS_ERROR;
+    }
+    stat = STATUS_IDLE;
+    break;
+
+  case STATUS_UNSAT:
+    // nothing to do
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    stat = STATUS_ERROR;
+    break;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    stat = STATUS_ERROR;
+    break;
+  }
+
+  return stat;
+}
+
+
+/*
+ * Check with assumptions: as for yices_check_context, the search
+ * itself is done without holding the API locks.
+ */
+EXPORTED smt_status_t yices_check_context_with_assumptions(context_t *ctx, const param_t *params,
+                                                           uint32_t n, const term_t t[]) {
+  param_t default_params;
+  smt_status_t stat;
+
+  get_api_locks();
+  stat = _o_yices_set_assumptions(ctx, n, t);
+  release_api_locks();
+
+  if (stat == STATUS_IDLE) {
+    if (params == NULL) {
+      yices_default_params_for_context(ctx, &default_params);
+      params = &default_params;
+    }
+    stat = check_context_with_assumptions(ctx, params);
+    if (stat == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx)) {
+      context_cleanup(ctx);
+    }
+  }
+
+  return stat;
+}
+
+
+/*
+ * Unsat core after check with assumptions
+ */
+static int32_t _o_yices_get_unsat_core(context_t *ctx, term_vector_t *v) {
+  if (ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return -1;
+  }
+
+  if (context_status(ctx) != STATUS_UNSAT) {
+    error.code = CTX_INVALID_OPERATION;
+    return -1;
+  }
+
+  context_build_unsat_core(ctx, (ivector_t *) v);
+
+  return 0;
+}
+
+EXPORTED int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v) {
+  MT_PROTECT(int32_t, _o_yices_get_unsat_core(ctx, v));
+}
+
+
+/*
+ * The DPLL(T) search uses only data owned by ctx (plus the rational
+ * and bitvector-constant stores, which have their own locks) so we
+ * don't hold the API locks. This lets several threads check
+ * different contexts in parallel. MCSAT creates terms during the
+ * search so it needs the locks.
+ */
+EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params) {
+  if (ctx->mcsat != NULL) {
+    MT_PROTECT(smt_status_t, _o_yices_check_context(ctx, params));
+  }
+  return _o_yices_check_context(ctx, params);
+}
+
+
+/*
+ * Interrupt the search:
+ * - this can be called from a signal handler to stop the search,
+ *   after a call to yices_check_context to interrupt the solver.
+ *
+ * If ctx's status is SEARCHING, then the current search is
+ * interrupted and ctx's status flag is updated to
+ * INTERRUPTED. Otherwise, the function does nothing.
+ */
+EXPORTED void yices_stop_search(context_t *ctx) {
+  if (context_status(ctx) == STATUS_SEARCHING) {
+    context_stop_search(ctx);
+  }
+}
+
+
+/************
+ *  MODELS  *
+ ***********/
+
+/*
+ * Build a model from ctx
+ * - keep_subst indicates whether the model should include
+ *   the eliminated variables:
+ *   keep_subst = 0 means don't keep substitutions,
+ *   keep_subst != 0 means keep them
  * - ctx status must be SAT or UNKNOWN
  *
  * The function returns NULL if the status isn't SAT or UNKNOWN and
  * sets an error report.
  *
  */
-EXPORTED model_t *yices_get_model(context_t *ctx, int32_t keep_subst) {
+static model_t *_o_yices_get_model(context_t *ctx, int32_t keep_subst) {
   model_t *mdl;
 
   assert(ctx != NULL);
@@ -7743,6 +8936,10 @@ EXPORTED model_t *yices_get_model(context_t *ctx, int32_t keep_subst) {
   return mdl;
 }
 
+EXPORTED model_t *yices_get_model(context_t *ctx, int32_t keep_subst) {
+  MT_PROTECT(model_t *, _o_yices_get_model(ctx, keep_subst));
+}
+
 
 /*
  * Return an empty model
@@ -7760,21 +8957,29 @@ model_t *yices_new_model(bool keep_subst) {
 /*
  * Delete mdl
  */
-EXPORTED void yices_free_model(model_t *mdl) {
+static void _o_yices_free_model(model_t *mdl) {
   delete_model(mdl);
   free_model(mdl);
 }
 
+EXPORTED void yices_free_model(model_t *mdl) {
+  MT_PROTECT_VOID(_o_yices_free_model(mdl));
+}
+
 
 /*
  * Print model mdl on FILE f
  * - f must be open/writable
  */
-EXPORTED void yices_print_model(FILE *f, model_t *mdl) {
+static void _o_yices_print_model(FILE *f, model_t *mdl) {
   model_print_full(f, mdl);
 }
 
-EXPORTED int32_t yices_print_model_fd(int fd, model_t *mdl) {
+EXPORTED void yices_print_model(FILE *f, model_t *mdl) {
+  MT_PROTECT_VOID(_o_yices_print_model(f, mdl));
+}
+
+static int32_t _o_yices_print_model_fd(int fd, model_t *mdl) {
   FILE *tmp_fp;
 
   tmp_fp = fd_2_tmp_fp(fd);
@@ -7790,12 +8995,16 @@ EXPORTED int32_t yices_print_model_fd(int fd, model_t *mdl) {
   return 0;
 }
 
+EXPORTED int32_t yices_print_model_fd(int fd, model_t *mdl) {
+  MT_PROTECT(int32_t, _o_yices_print_model_fd(fd, mdl));
+}
+
 /*
  * Pretty print mdl
  * - f = output file to use
  * - width, height, offset = print area
  */
-EXPORTED int32_t yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+static int32_t _o_yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   int32_t code;
@@ -7825,7 +9034,11 @@ EXPORTED int32_t yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t
   return code;
 }
 
-EXPORTED int32_t yices_pp_model_fd(int fd, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+EXPORTED int32_t yices_pp_model(FILE *f, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(int32_t, _o_yices_pp_model(f, mdl, width, height, offset));
+}
+
+static int32_t _o_yices_pp_model_fd(int fd, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
   FILE *tmp_fp;
   int32_t retval;
 
@@ -7843,10 +9056,14 @@ EXPORTED int32_t yices_pp_model_fd(int fd, model_t *mdl, uint32_t width, uint32_
   return retval;
 }
 
+EXPORTED int32_t yices_pp_model_fd(int fd, model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(int32_t, _o_yices_pp_model_fd(fd, mdl, width, height, offset));
+}
+
 /*
  * Convert mdl to a string
  */
-EXPORTED char *yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+static char *_o_yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
   yices_pp_t printer;
   pp_area_t area;
   char *str;
@@ -7871,6 +9088,10 @@ EXPORTED char *yices_model_to_string(model_t *mdl, uint32_t width, uint32_t heig
   return str;
 }
 
+EXPORTED char *yices_model_to_string(model_t *mdl, uint32_t width, uint32_t height, uint32_t offset) {
+  MT_PROTECT(char *, _o_yices_model_to_string(mdl, width, height, offset));
+}
+
 
 /*
  * BUILD A MODEL FROM A MAP OF UNINTERPRETED TO CONSTANT TERMS
@@ -7898,7 +9119,7 @@ EXPORTED char *yices_model_to_string(model_t *mdl, uint32_t width, uint32_t heig
  * - code = MDL_FTYPE_NOT_ALLOWED if one of var[i] has a function type
  * - code = MDL_CONSTRUCTION_FAILED: something else went wrong
  */
-EXPORTED model_t *yices_model_from_map(uint32_t n, const term_t var[], const term_t map[]) {
+static model_t *_o_yices_model_from_map(uint32_t n, const term_t var[], const term_t map[]) {
   model_t *mdl;
 
   if (! check_good_model_map(&manager, n, var, map)) {
@@ -7910,6 +9131,10 @@ EXPORTED model_t *yices_model_from_map(uint32_t n, const term_t var[], const ter
   return mdl;
 }
 
+EXPORTED model_t *yices_model_from_map(uint32_t n, const term_t var[], const term_t map[]) {
+  MT_PROTECT(model_t *, _o_yices_model_from_map(n, var, map));
+}
+
 
 
 
@@ -7954,7 +9179,7 @@ static inline error_code_t yices_eval_error(int32_t v) {
  *   type1 = bool (expected type)
  * + the other evaluation error codes above.
  */
-EXPORTED int32_t yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
+static int32_t _o_yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
   value_table_t *vtbl;
   value_t v;
 
@@ -7980,6 +9205,10 @@ EXPORTED int32_t yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_bool_value(model_t *mdl, term_t t, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_get_bool_value(mdl, t, val));
+}
+
 
 /*
  * Value of arithmetic term t: it can be returned as an integer, a
@@ -8063,7 +9292,7 @@ static bool arithval_is_rational(const arithval_struct_t *r) {
 }
 
 // return the value as a 32bit integer
-EXPORTED int32_t yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
+static int32_t _o_yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8079,8 +9308,12 @@ EXPORTED int32_t yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_int32_value(model_t *mdl, term_t t, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_get_int32_value(mdl, t, val));
+}
+
 // return the value as a 64bit integer
-EXPORTED int32_t yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
+static int32_t _o_yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8096,8 +9329,12 @@ EXPORTED int32_t yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_int64_value(model_t *mdl, term_t t, int64_t *val) {
+  MT_PROTECT(int32_t, _o_yices_get_int64_value(mdl, t, val));
+}
+
 // return the value as a pair num/den (both 32bit integers)
-EXPORTED int32_t yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint32_t *den) {
+static int32_t _o_yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint32_t *den) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8113,8 +9350,12 @@ EXPORTED int32_t yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num
   return 0;
 }
 
+EXPORTED int32_t yices_get_rational32_value(model_t *mdl, term_t t, int32_t *num, uint32_t *den) {
+  MT_PROTECT(int32_t, _o_yices_get_rational32_value(mdl, t, num, den));
+}
+
 // pair num/den (64bit integers)
-EXPORTED int32_t yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint64_t *den) {
+static int32_t _o_yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint64_t *den) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8130,8 +9371,12 @@ EXPORTED int32_t yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num
   return 0;
 }
 
+EXPORTED int32_t yices_get_rational64_value(model_t *mdl, term_t t, int64_t *num, uint64_t *den) {
+  MT_PROTECT(int32_t, _o_yices_get_rational64_value(mdl, t, num, den));
+}
+
 // convert to a floating point number
-EXPORTED int32_t yices_get_double_value(model_t *mdl, term_t t, double *val) {
+static int32_t _o_yices_get_double_value(model_t *mdl, term_t t, double *val) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8150,9 +9395,13 @@ EXPORTED int32_t yices_get_double_value(model_t *mdl, term_t t, double *val) {
   return -1;
 }
 
+EXPORTED int32_t yices_get_double_value(model_t *mdl, term_t t, double *val) {
+  MT_PROTECT(int32_t, _o_yices_get_double_value(mdl, t, val));
+}
+
 
 // convert to a GMP integer
-EXPORTED int32_t yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
+static int32_t _o_yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8170,8 +9419,12 @@ EXPORTED int32_t yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_mpz_value(model_t *mdl, term_t t, mpz_t val) {
+  MT_PROTECT(int32_t, _o_yices_get_mpz_value(mdl, t, val));
+}
+
 // convert to a GMP rational
-EXPORTED int32_t yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
+static int32_t _o_yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
   arithval_struct_t aux;
 
   yices_get_arith_value(mdl, t, &aux);
@@ -8184,11 +9437,15 @@ EXPORTED int32_t yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_mpq_value(model_t *mdl, term_t t, mpq_t val) {
+  MT_PROTECT(int32_t, _o_yices_get_mpq_value(mdl, t, val));
+}
+
 
 /*
  * Algebraic number
  */
-EXPORTED int32_t yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic_number_t *a) {
+static int32_t _o_yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic_number_t *a) {
 #if HAVE_MCSAT
   arithval_struct_t aux;
 
@@ -8213,6 +9470,10 @@ EXPORTED int32_t yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_alg
 #endif
 }
 
+EXPORTED int32_t yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_algebraic_number_t *a) {
+  MT_PROTECT(int32_t, _o_yices_get_algebraic_number_value(mdl, t, a));
+}
+
 /*
  * Value of bitvector term t in mdl
  * - the value is returned in array val
@@ -8227,7 +9488,7 @@ EXPORTED int32_t yices_get_algebraic_number_value(model_t *mdl, term_t t, lp_alg
  *   code = BITVECTOR_REQUIRED
  *   term1 = t
  */
-EXPORTED int32_t yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
+static int32_t _o_yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
   value_table_t *vtbl;
   value_bv_t *bv;
   value_t v;
@@ -8255,6 +9516,10 @@ EXPORTED int32_t yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
+  MT_PROTECT(int32_t, _o_yices_get_bv_value(mdl, t, val));
+}
+
 
 
 /*
@@ -8271,7 +9536,7 @@ EXPORTED int32_t yices_get_bv_value(model_t *mdl, term_t t, int32_t val[]) {
  *   code = SCALAR_TERM_REQUIRED
  *   term1 = t
  */
-EXPORTED int32_t yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
+static int32_t _o_yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
   value_table_t *vtbl;
   value_unint_t *uv;
   value_t v;
@@ -8299,6 +9564,10 @@ EXPORTED int32_t yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
   return 0;
 }
 
+EXPORTED int32_t yices_get_scalar_value(model_t *mdl, term_t t, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_get_scalar_value(mdl, t, val));
+}
+
 
 /*
  * FULL MODEL: NODES AND VALUE DESCRIPTORS
@@ -8339,7 +9608,7 @@ EXPORTED void yices_delete_yval_vector(yval_vector_t *v) {
  * If the evaluation fails for other reasons:
  *   code = EVAL_FAILED
  */
-EXPORTED int32_t yices_get_value(model_t *mdl, term_t t, yval_t *val) {
+static int32_t _o_yices_get_value(model_t *mdl, term_t t, yval_t *val) {
   value_table_t *vtbl;
   value_t v;
 
@@ -8354,16 +9623,203 @@ EXPORTED int32_t yices_get_value(model_t *mdl, term_t t, yval_t *val) {
   }
 
   vtbl = model_get_vtbl(mdl);
-  get_yval(vtbl, v, val);
+  get_yval(vtbl, v, val);
+
+  return 0;
+}
+
+EXPORTED int32_t yices_get_value(model_t *mdl, term_t t, yval_t *val) {
+  MT_PROTECT(int32_t, _o_yices_get_value(mdl, t, val));
+}
+
+
+/*
+ * Auxiliary function: evaluate a[0 ... n-1] in mdl
+ * - return an array of n values allocated with safe_malloc
+ * - return NULL and set the error report if the evaluation fails
+ *   (the terms must be checked by the caller)
+ */
+static value_t *eval_term_array(model_t *mdl, uint32_t n, const term_t a[]) {
+  value_t *b;
+  int32_t eval_code;
+
+  b = (value_t *) safe_malloc(n * sizeof(value_t));
+  eval_code = evaluate_term_array(mdl, n, a, b);
+  if (eval_code < 0) {
+    safe_free(b);
+    error.code = yices_eval_error(eval_code);
+    return NULL;
+  }
+
+  return b;
+}
+
+
+/*
+ * Values of a[0 ... n-1] as node descriptors
+ */
+static int32_t _o_yices_get_value_array(model_t *mdl, uint32_t n, const term_t a[], yval_t val[]) {
+  value_table_t *vtbl;
+  value_t *b;
+  uint32_t i;
+
+  if (! check_good_terms(&manager, n, a)) {
+    return -1;
+  }
+
+  b = eval_term_array(mdl, n, a);
+  if (b == NULL) {
+    return -1;
+  }
+
+  vtbl = model_get_vtbl(mdl);
+  for (i=0; i<n; i++) {
+    get_yval(vtbl, b[i], val + i);
+  }
+  safe_free(b);
+
+  return 0;
+}
+
+EXPORTED int32_t yices_get_value_array(model_t *mdl, uint32_t n, const term_t a[], yval_t val[]) {
+  MT_PROTECT(int32_t, _o_yices_get_value_array(mdl, n, a, val));
+}
+
+
+/*
+ * BULK EXPORT
+ */
+
+/*
+ * Values of Boolean terms a[0 ... n-1] as a bitmap:
+ * - bit i of the bitmap is bit (i % 8) of byte bitmap[i/8]
+ */
+static int32_t _o_yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], uint8_t bitmap[]) {
+  value_table_t *vtbl;
+  value_t *b;
+  uint32_t i;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_boolean_args(&manager, n, a)) {
+    return -1;
+  }
+
+  b = eval_term_array(mdl, n, a);
+  if (b == NULL) {
+    return -1;
+  }
+
+  vtbl = model_get_vtbl(mdl);
+  for (i=0; i<n; i += 8) {
+    bitmap[i >> 3] = 0;
+  }
+  for (i=0; i<n; i++) {
+    assert(object_is_boolean(vtbl, b[i]));
+    if (boolobj_value(vtbl, b[i])) {
+      bitmap[i >> 3] |= (uint8_t) (1 << (i & 7));
+    }
+  }
+  safe_free(b);
+
+  return 0;
+}
+
+EXPORTED int32_t yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], uint8_t bitmap[]) {
+  MT_PROTECT(int32_t, _o_yices_get_bool_value_array(mdl, n, a, bitmap));
+}
+
+
+/*
+ * Values of arithmetic terms a[0 ... n-1] as pairs num[i]/den[i]
+ * - if a value doesn't fit (or is not rational), num[i] and den[i]
+ *   are set to 0
+ * - return the number of such values
+ */
+static int32_t _o_yices_get_rational64_value_array(model_t *mdl, uint32_t n, const term_t a[], int64_t num[], uint64_t den[]) {
+  value_table_t *vtbl;
+  value_t *b;
+  uint32_t i;
+  int32_t count;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_arithmetic_args(&manager, n, a)) {
+    return -1;
+  }
+
+  b = eval_term_array(mdl, n, a);
+  if (b == NULL) {
+    return -1;
+  }
+
+  vtbl = model_get_vtbl(mdl);
+  count = 0;
+  for (i=0; i<n; i++) {
+    if (! object_is_rational(vtbl, b[i]) ||
+        ! q_get_int64(vtbl_rational(vtbl, b[i]), num + i, den + i)) {
+      num[i] = 0;
+      den[i] = 0;
+      count ++;
+    }
+  }
+  safe_free(b);
+
+  return count;
+}
+
+EXPORTED int32_t yices_get_rational64_value_array(model_t *mdl, uint32_t n, const term_t a[], int64_t num[], uint64_t den[]) {
+  MT_PROTECT(int32_t, _o_yices_get_rational64_value_array(mdl, n, a, num, den));
+}
+
+
+/*
+ * Values of bitvector terms a[0 ... n-1] as packed 32bit words
+ * - all terms must have the same type (bitvectors of k bits)
+ * - the value of a[i] is stored in words[i * w ... i * w + w - 1]
+ *   where w = ceil(k/32), least significant word first.
+ */
+static int32_t _o_yices_get_bv_value_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t words[]) {
+  value_table_t *vtbl;
+  value_bv_t *bv;
+  value_t *b;
+  uint32_t i, w;
+
+  if (n == 0) {
+    return 0;
+  }
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_bitvector_args(&manager, n, a) ||
+      ! check_same_type(&manager, n, a)) {
+    return -1;
+  }
+
+  b = eval_term_array(mdl, n, a);
+  if (b == NULL) {
+    return -1;
+  }
+
+  vtbl = model_get_vtbl(mdl);
+  w = (term_bitsize(&terms, a[0]) + 31) >> 5;
+  for (i=0; i<n; i++) {
+    assert(object_is_bitvector(vtbl, b[i]));
+    bv = vtbl_bitvector(vtbl, b[i]);
+    assert(bv->width == w);
+    memcpy(words + i * w, bv->data, w * sizeof(uint32_t));
+  }
+  safe_free(b);
 
   return 0;
 }
 
+EXPORTED int32_t yices_get_bv_value_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t words[]) {
+  MT_PROTECT(int32_t, _o_yices_get_bv_value_array(mdl, n, a, words));
+}
+
 
 /*
  * Queries on the value of a rational node
  */
-EXPORTED int32_t yices_val_is_int32(model_t *mdl, const yval_t *v) {
+static int32_t _o_yices_val_is_int32(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   rational_t *q;
   value_t id;
@@ -8382,7 +9838,11 @@ EXPORTED int32_t yices_val_is_int32(model_t *mdl, const yval_t *v) {
   return code;
 }
 
-EXPORTED int32_t yices_val_is_int64(model_t *mdl, const yval_t *v) {
+EXPORTED int32_t yices_val_is_int32(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_is_int32(mdl, v));
+}
+
+static int32_t _o_yices_val_is_int64(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   rational_t *q;
   value_t id;
@@ -8401,7 +9861,11 @@ EXPORTED int32_t yices_val_is_int64(model_t *mdl, const yval_t *v) {
   return code;
 }
 
-EXPORTED int32_t yices_val_is_rational32(model_t *mdl, const yval_t *v) {
+EXPORTED int32_t yices_val_is_int64(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_is_int64(mdl, v));
+}
+
+static int32_t _o_yices_val_is_rational32(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   rational_t *q;
   value_t id;
@@ -8420,7 +9884,11 @@ EXPORTED int32_t yices_val_is_rational32(model_t *mdl, const yval_t *v) {
   return code;
 }
 
-EXPORTED int32_t yices_val_is_rational64(model_t *mdl, const yval_t *v) {
+EXPORTED int32_t yices_val_is_rational32(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_is_rational32(mdl, v));
+}
+
+static int32_t _o_yices_val_is_rational64(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   rational_t *q;
   value_t id;
@@ -8439,7 +9907,11 @@ EXPORTED int32_t yices_val_is_rational64(model_t *mdl, const yval_t *v) {
   return code;
 }
 
-EXPORTED int32_t yices_val_is_integer(model_t *mdl, const yval_t *v) {
+EXPORTED int32_t yices_val_is_rational64(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_is_rational64(mdl, v));
+}
+
+static int32_t _o_yices_val_is_integer(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   rational_t *q;
   value_t id;
@@ -8458,10 +9930,14 @@ EXPORTED int32_t yices_val_is_integer(model_t *mdl, const yval_t *v) {
   return code;
 }
 
+EXPORTED int32_t yices_val_is_integer(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_is_integer(mdl, v));
+}
+
 /*
  * Number of bits in a bitvector constant
  */
-EXPORTED uint32_t yices_val_bitsize(model_t *mdl, const yval_t *v) {
+static uint32_t _o_yices_val_bitsize(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   value_bv_t *bv;
   value_t id;
@@ -8480,11 +9956,15 @@ EXPORTED uint32_t yices_val_bitsize(model_t *mdl, const yval_t *v) {
   return n;
 }
 
+EXPORTED uint32_t yices_val_bitsize(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(uint32_t, _o_yices_val_bitsize(mdl, v));
+}
+
 
 /*
  * Number of components in a tuple
  */
-EXPORTED uint32_t yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
+static uint32_t _o_yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   value_tuple_t *tuple;
   value_t id;
@@ -8503,11 +9983,15 @@ EXPORTED uint32_t yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
   return n;
 }
 
+EXPORTED uint32_t yices_val_tuple_arity(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(uint32_t, _o_yices_val_tuple_arity(mdl, v));
+}
+
 
 /*
  * Arity of a mapping object
  */
-EXPORTED uint32_t yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
+static uint32_t _o_yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   value_map_t *map;
   value_t id;
@@ -8526,10 +10010,14 @@ EXPORTED uint32_t yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
   return n;
 }
 
+EXPORTED uint32_t yices_val_mapping_arity(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(uint32_t, _o_yices_val_mapping_arity(mdl, v));
+}
+
 /*
  * Arity of a function node
  */
-EXPORTED uint32_t yices_val_function_arity(model_t *mdl, const yval_t *v) {
+static uint32_t _o_yices_val_function_arity(model_t *mdl, const yval_t *v) {
   value_table_t *vtbl;
   value_t id;
   uint32_t n;
@@ -8550,10 +10038,14 @@ EXPORTED uint32_t yices_val_function_arity(model_t *mdl, const yval_t *v) {
   return n;
 }
 
+EXPORTED uint32_t yices_val_function_arity(model_t *mdl, const yval_t *v) {
+  MT_PROTECT(uint32_t, _o_yices_val_function_arity(mdl, v));
+}
+
 /*
  * Extract value of a leaf node
  */
-EXPORTED int32_t yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val) {
+static int32_t _o_yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val) {
   value_table_t *vtbl;
   value_t id;
 
@@ -8570,6 +10062,10 @@ EXPORTED int32_t yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val)
   return -1;
 }
 
+EXPORTED int32_t yices_val_get_bool(model_t *mdl, const yval_t *v, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_bool(mdl, v, val));
+}
+
 
 /*
  * Auxiliary function: return the rational value of v
@@ -8591,7 +10087,7 @@ static rational_t *yices_val_get_rational(model_t *mdl, const yval_t *v) {
   return NULL;
 }
 
-EXPORTED int32_t yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
+static int32_t _o_yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8607,7 +10103,11 @@ EXPORTED int32_t yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val
   return 0;
 }
 
-EXPORTED int32_t yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
+EXPORTED int32_t yices_val_get_int32(model_t *mdl, const yval_t *v, int32_t *val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_int32(mdl, v, val));
+}
+
+static int32_t _o_yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8623,7 +10123,11 @@ EXPORTED int32_t yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val
   return 0;
 }
 
-EXPORTED int32_t yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num, uint32_t *den) {
+EXPORTED int32_t yices_val_get_int64(model_t *mdl, const yval_t *v, int64_t *val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_int64(mdl, v, val));
+}
+
+static int32_t _o_yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num, uint32_t *den) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8639,7 +10143,11 @@ EXPORTED int32_t yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t
   return 0;
 }
 
-EXPORTED int32_t yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num, uint64_t *den) {
+EXPORTED int32_t yices_val_get_rational32(model_t *mdl, const yval_t *v, int32_t *num, uint32_t *den) {
+  MT_PROTECT(int32_t, _o_yices_val_get_rational32(mdl, v, num, den));
+}
+
+static int32_t _o_yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num, uint64_t *den) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8655,7 +10163,11 @@ EXPORTED int32_t yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t
   return 0;
 }
 
-EXPORTED int32_t yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
+EXPORTED int32_t yices_val_get_rational64(model_t *mdl, const yval_t *v, int64_t *num, uint64_t *den) {
+  MT_PROTECT(int32_t, _o_yices_val_get_rational64(mdl, v, num, den));
+}
+
+static int32_t _o_yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8671,7 +10183,11 @@ EXPORTED int32_t yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
   return 0;
 }
 
-EXPORTED int32_t yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
+EXPORTED int32_t yices_val_get_mpz(model_t *mdl, const yval_t *v, mpz_t val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_mpz(mdl, v, val));
+}
+
+static int32_t _o_yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
   rational_t *q;
 
   q = yices_val_get_rational(mdl, v);
@@ -8683,9 +10199,13 @@ EXPORTED int32_t yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
   return 0;
 }
 
+EXPORTED int32_t yices_val_get_mpq(model_t *mdl, const yval_t *v, mpq_t val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_mpq(mdl, v, val));
+}
+
 
 // Conversion to double
-EXPORTED int32_t yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
+static int32_t _o_yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
   value_table_t *vtbl;
   value_t id;
 
@@ -8712,10 +10232,14 @@ EXPORTED int32_t yices_val_get_double(model_t *mdl, const yval_t *v, double *val
   return -1;
 }
 
+EXPORTED int32_t yices_val_get_double(model_t *mdl, const yval_t *v, double *val) {
+  MT_PROTECT(int32_t, _o_yices_val_get_double(mdl, v, val));
+}
+
 /*
  * Value of a bitvector node
  */
-EXPORTED int32_t yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
+static int32_t _o_yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
   value_table_t *vtbl;
   value_bv_t *bv;
   value_t id;
@@ -8734,10 +10258,14 @@ EXPORTED int32_t yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[])
   return -1;
 }
 
+EXPORTED int32_t yices_val_get_bv(model_t *mdl, const yval_t *v, int32_t val[]) {
+  MT_PROTECT(int32_t, _o_yices_val_get_bv(mdl, v, val));
+}
+
 /*
  * Algebraic number
  */
-EXPORTED int32_t yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_algebraic_number_t *a) {
+static int32_t _o_yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_algebraic_number_t *a) {
 #if HAVE_MCSAT
   value_table_t *vtbl;
   value_t id;
@@ -8761,12 +10289,16 @@ EXPORTED int32_t yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, l
 #endif
 }
 
+EXPORTED int32_t yices_val_get_algebraic_number(model_t *mdl, const yval_t *v, lp_algebraic_number_t *a) {
+  MT_PROTECT(int32_t, _o_yices_val_get_algebraic_number(mdl, v, a));
+}
+
 
 
 /*
  * Value of a scalar/uninterpreted constant
  */
-EXPORTED int32_t yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, type_t *tau) {
+static int32_t _o_yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, type_t *tau) {
   value_table_t *vtbl;
   value_unint_t *u;
   value_t id;
@@ -8786,11 +10318,15 @@ EXPORTED int32_t yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *va
   return -1;
 }
 
+EXPORTED int32_t yices_val_get_scalar(model_t *mdl, const yval_t *v, int32_t *val, type_t *tau) {
+  MT_PROTECT(int32_t, _o_yices_val_get_scalar(mdl, v, val, tau));
+}
+
 
 /*
  * Expand a tuple node
  */
-EXPORTED int32_t yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t child[]) {
+static int32_t _o_yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t child[]) {
   value_table_t *vtbl;
   value_t id;
 
@@ -8807,11 +10343,15 @@ EXPORTED int32_t yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t ch
   return -1;
 }
 
+EXPORTED int32_t yices_val_expand_tuple(model_t *mdl, const yval_t *v, yval_t child[]) {
+  MT_PROTECT(int32_t, _o_yices_val_expand_tuple(mdl, v, child));
+}
+
 
 /*
  * Expand a mapping node
  */
-EXPORTED int32_t yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[], yval_t *val) {
+static int32_t _o_yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[], yval_t *val) {
   value_table_t *vtbl;
   value_t id;
 
@@ -8828,11 +10368,15 @@ EXPORTED int32_t yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t
   return -1;
 }
 
+EXPORTED int32_t yices_val_expand_mapping(model_t *mdl, const yval_t *v, yval_t tup[], yval_t *val) {
+  MT_PROTECT(int32_t, _o_yices_val_expand_mapping(mdl, v, tup, val));
+}
+
 
 /*
  * Expand a function node
  */
-EXPORTED int32_t yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def, yval_vector_t *v) {
+static int32_t _o_yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def, yval_vector_t *v) {
   value_table_t *vtbl;
   value_t id;
 
@@ -8855,6 +10399,10 @@ EXPORTED int32_t yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t
   return -1;
 }
 
+EXPORTED int32_t yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t *def, yval_vector_t *v) {
+  MT_PROTECT(int32_t, _o_yices_val_expand_function(mdl, f, def, v));
+}
+
 
 /*
  * VALUES AS CONSTANT TERMS
@@ -8863,7 +10411,7 @@ EXPORTED int32_t yices_val_expand_function(model_t *mdl, const yval_t *f, yval_t
 /*
  * Value of term t converted to a constant term val.
  */
-EXPORTED term_t yices_get_value_as_term(model_t *mdl, term_t t) {
+static term_t _o_yices_get_value_as_term(model_t *mdl, term_t t) {
   value_table_t *vtbl;
   value_t v;
   term_t a;
@@ -8888,6 +10436,10 @@ EXPORTED term_t yices_get_value_as_term(model_t *mdl, term_t t) {
   return a;
 }
 
+EXPORTED term_t yices_get_value_as_term(model_t *mdl, term_t t) {
+  MT_PROTECT(term_t, _o_yices_get_value_as_term(mdl, t));
+}
+
 
 
 /*
@@ -8904,7 +10456,7 @@ EXPORTED term_t yices_get_value_as_term(model_t *mdl, term_t t) {
  * Error codes:
  * - same as get_bool_val
  */
-EXPORTED int32_t yices_formula_true_in_model(model_t *mdl, term_t f) {
+static int32_t _o_yices_formula_true_in_model(model_t *mdl, term_t f) {
   int32_t code;
 
   if (! check_good_term(&manager, f) ||
@@ -8924,6 +10476,10 @@ EXPORTED int32_t yices_formula_true_in_model(model_t *mdl, term_t f) {
   }
 }
 
+EXPORTED int32_t yices_formula_true_in_model(model_t *mdl, term_t f) {
+  MT_PROTECT(int32_t, _o_yices_formula_true_in_model(mdl, f));
+}
+
 
 /*
  * Check whether formulas f[0 ... n-1] are all true in mdl
@@ -8934,7 +10490,7 @@ EXPORTED int32_t yices_formula_true_in_model(model_t *mdl, term_t f) {
  * Error code:
  * - same as yices_get_bool_val
  */
-EXPORTED int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]) {
+static int32_t _o_yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]) {
   int32_t code;
 
   if (! check_good_terms(&manager, n, f) ||
@@ -8954,6 +10510,10 @@ EXPORTED int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const te
   }
 }
 
+EXPORTED int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const term_t f[]) {
+  MT_PROTECT(int32_t, _o_yices_formulas_true_in_model(mdl, n, f));
+}
+
 
 
 
@@ -8964,7 +10524,7 @@ EXPORTED int32_t yices_formulas_true_in_model(model_t *mdl, uint32_t n, const te
 /*
  * Values of terms a[0 ... n-1] all converted to terms
  */
-EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]) {
+static int32_t _o_yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]) {
   int32_t eval_code;
   uint32_t count;
 
@@ -8987,6 +10547,10 @@ EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a
   return 0;
 }
 
+EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]) {
+  MT_PROTECT(int32_t, _o_yices_term_array_value(mdl, n, a, b));
+}
+
 
 
 
@@ -9015,7 +10579,7 @@ EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a
  * - EVAL_NO_IMPLICANT    if t is false in  mdl
  * - EVAL_FAILED          if the function fails for some other reason
  */
-EXPORTED int32_t yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v) {
+static int32_t _o_yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v) {
   int32_t code;
 
   if (! check_good_term(&manager, t) ||
@@ -9033,11 +10597,15 @@ EXPORTED int32_t yices_implicant_for_formula(model_t *mdl, term_t t, term_vector
   return 0;
 }
 
+EXPORTED int32_t yices_implicant_for_formula(model_t *mdl, term_t t, term_vector_t *v) {
+  MT_PROTECT(int32_t, _o_yices_implicant_for_formula(mdl, t, v));
+}
+
 
 /*
  * Same thing for an array of formulas a[0 ... n-1]
  */
-EXPORTED int32_t yices_implicant_for_formulas(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
+static int32_t _o_yices_implicant_for_formulas(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
   int32_t code;
 
   if (! check_good_terms(&manager, n, a) ||
@@ -9055,6 +10623,10 @@ EXPORTED int32_t yices_implicant_for_formulas(model_t *mdl, uint32_t n, const te
   return 0;
 }
 
+EXPORTED int32_t yices_implicant_for_formulas(model_t *mdl, uint32_t n, const term_t a[], term_vector_t *v) {
+  MT_PROTECT(int32_t, _o_yices_implicant_for_formulas(mdl, n, a, v));
+}
+
 
 
 /*
@@ -9107,7 +10679,7 @@ static inline error_code_t yices_gen_error(int32_t v) {
  * - v: term_vector to return the result
  *
  */
-EXPORTED int32_t yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const term_t elim[],
+static int32_t _o_yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const term_t elim[],
 					yices_gen_mode_t mode, term_vector_t *v) {
   int32_t code;
 
@@ -9140,11 +10712,16 @@ EXPORTED int32_t yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims,
   return 0;
 }
 
+EXPORTED int32_t yices_generalize_model(model_t *mdl, term_t t, uint32_t nelims, const term_t elim[],
+					yices_gen_mode_t mode, term_vector_t *v) {
+  MT_PROTECT(int32_t, _o_yices_generalize_model(mdl, t, nelims, elim, mode, v));
+}
+
 
 /*
  * Same thing for a conjunction of formulas a[0 ... n-1]
  */
-EXPORTED term_t yices_generalize_model_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t nelims, const term_t elim[],
+static term_t _o_yices_generalize_model_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t nelims, const term_t elim[],
 					     yices_gen_mode_t mode, term_vector_t *v) {
   int32_t code;
 
@@ -9177,6 +10754,11 @@ EXPORTED term_t yices_generalize_model_array(model_t *mdl, uint32_t n, const ter
   return 0;
 }
 
+EXPORTED term_t yices_generalize_model_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t nelims, const term_t elim[],
+					     yices_gen_mode_t mode, term_vector_t *v) {
+  MT_PROTECT(term_t, _o_yices_generalize_model_array(mdl, n, a, nelims, elim, mode, v));
+}
+
 
 
 
@@ -9208,7 +10790,7 @@ static sparse_array_t *get_root_types(void) {
 /*
  * Increment/decrement the reference counters
  */
-EXPORTED int32_t yices_incref_term(term_t t) {
+static int32_t _o_yices_incref_term(term_t t) {
   sparse_array_t *roots;
 
   if (!check_good_term(&manager, t)) {
@@ -9223,7 +10805,11 @@ EXPORTED int32_t yices_incref_term(term_t t) {
   return 0;
 }
 
-EXPORTED int32_t yices_incref_type(type_t tau) {
+EXPORTED int32_t yices_incref_term(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_incref_term(t));
+}
+
+static int32_t _o_yices_incref_type(type_t tau) {
   sparse_array_t *roots;
 
   if (!check_good_type(&types, tau)) {
@@ -9236,7 +10822,11 @@ EXPORTED int32_t yices_incref_type(type_t tau) {
   return 0;
 }
 
-EXPORTED int32_t yices_decref_term(term_t t) {
+EXPORTED int32_t yices_incref_type(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_incref_type(tau));
+}
+
+static int32_t _o_yices_decref_term(term_t t) {
   if (!check_good_term(&manager, t)) {
     return -1;
   }
@@ -9253,7 +10843,11 @@ EXPORTED int32_t yices_decref_term(term_t t) {
   return 0;
 }
 
-EXPORTED int32_t yices_decref_type(type_t tau) {
+EXPORTED int32_t yices_decref_term(term_t t) {
+  MT_PROTECT(int32_t, _o_yices_decref_term(t));
+}
+
+static int32_t _o_yices_decref_type(type_t tau) {
   if (! check_good_type(&types, tau)) {
     return -1;
   }
@@ -9270,23 +10864,35 @@ EXPORTED int32_t yices_decref_type(type_t tau) {
   return 0;
 }
 
+EXPORTED int32_t yices_decref_type(type_t tau) {
+  MT_PROTECT_TYPES(int32_t, _o_yices_decref_type(tau));
+}
+
 
 /*
  * Number of live terms and types
  */
-EXPORTED uint32_t yices_num_terms(void) {
+static uint32_t _o_yices_num_terms(void) {
   return terms.live_terms;
 }
 
-EXPORTED uint32_t yices_num_types(void) {
+EXPORTED uint32_t yices_num_terms(void) {
+  MT_PROTECT(uint32_t, _o_yices_num_terms());
+}
+
+static uint32_t _o_yices_num_types(void) {
   return types.live_types;
 }
 
+EXPORTED uint32_t yices_num_types(void) {
+  MT_PROTECT_TYPES(uint32_t, _o_yices_num_types());
+}
+
 
 /*
  * Number of terms/types with a positive reference count
  */
-EXPORTED uint32_t yices_num_posref_terms(void) {
+static uint32_t _o_yices_num_posref_terms(void) {
   uint32_t n;
 
   n = 0;
@@ -9296,7 +10902,11 @@ EXPORTED uint32_t yices_num_posref_terms(void) {
   return n;
 }
 
-EXPORTED uint32_t yices_num_posref_types(void) {
+EXPORTED uint32_t yices_num_posref_terms(void) {
+  MT_PROTECT(uint32_t, _o_yices_num_posref_terms());
+}
+
+static uint32_t _o_yices_num_posref_types(void) {
   uint32_t n;
 
   n = 0;
@@ -9306,6 +10916,10 @@ EXPORTED uint32_t yices_num_posref_types(void) {
   return n;
 }
 
+EXPORTED uint32_t yices_num_posref_types(void) {
+  MT_PROTECT_TYPES(uint32_t, _o_yices_num_posref_types());
+}
+
 
 
 /*
@@ -9378,19 +10992,13 @@ static void mark_type_array(type_table_t *tbl, const type_t *a, uint32_t n) {
 
 
 /*
- * Call the garbage collector
+ * Mark all the roots:
  * - t = optional array of terms
  * - nt = size of t
  * - tau = optional array of types
  * - ntau = size of tau
- * - keep_named specifies whether the named terms and types should
- *   all be preserved
  */
-EXPORTED void yices_garbage_collect(const term_t t[], uint32_t nt,
-				    const type_t tau[], uint32_t ntau,
-				    int32_t keep_named) {
-  bool keep;
-
+static void gc_mark_roots(const term_t t[], uint32_t nt, const type_t tau[], uint32_t ntau) {
   /*
    * Default roots: all terms and types in all live models and context
    */
@@ -9412,17 +11020,192 @@ EXPORTED void yices_garbage_collect(const term_t t[], uint32_t nt,
   if (root_types != NULL) {
     sparse_array_iterate(root_types, &types, type_marker);
   }
+}
 
-  /*
-   * Call the garbage collector
-   */
-  keep = (keep_named != 0);
-  term_table_gc(&terms, keep);
 
-  /*
-   * Cleanup the fvars structure if it exists
-   */
+/*
+ * After a collection: cleanup the fvars structure if it exists
+ * and update the statistics
+ * - nterms/ntypes = number of live terms and types before the collection
+ */
+static void gc_cleanup(uint32_t nterms, uint32_t ntypes) {
   if (fvars != NULL) {
     cleanup_fvar_collector(fvars);
   }
+
+  assert(terms.live_terms <= nterms && types.live_types <= ntypes);
+  gc_stats.terms_collected += nterms - terms.live_terms;
+  gc_stats.types_collected += ntypes - types.live_types;
+}
+
+
+/*
+ * Update the pause-time statistics
+ * - start = CPU time when the collector was called
+ */
+static void gc_record_pause(double start) {
+  double pause;
+
+  pause = get_cpu_time() - start;
+  gc_stats.total_time += pause;
+  gc_stats.last_pause = pause;
+  if (pause > gc_stats.max_pause) {
+    gc_stats.max_pause = pause;
+  }
+}
+
+
+/*
+ * Mark the roots then run the collector and update the statistics
+ * - young: if true, do a young collection, otherwise do a full collection
+ */
+static void garbage_collect(const term_t t[], uint32_t nt,
+                            const type_t tau[], uint32_t ntau,
+                            bool keep_named, bool young) {
+  uint32_t nterms, ntypes;
+  double start;
+
+  start = get_cpu_time();
+  nterms = terms.live_terms;
+  ntypes = types.live_types;
+
+  if (young) {
+    // this must be done before the roots are marked
+    term_table_start_young_gc(&terms);
+  }
+  gc_mark_roots(t, nt, tau, ntau);
+  if (young) {
+    term_table_young_gc(&terms, keep_named);
+    gc_stats.young_collections ++;
+  } else {
+    term_table_gc(&terms, keep_named);
+    gc_stats.full_collections ++;
+  }
+
+  gc_cleanup(nterms, ntypes);
+  gc_record_pause(start);
+}
+
+
+/*
+ * Incremental collection: one step
+ * - the roots are marked when the collection starts and again
+ *   when it ends. The terms in t and types in tau are marked on
+ *   every step.
+ * - return true if the collection is complete
+ */
+static bool garbage_collect_step(const term_t t[], uint32_t nt,
+                                 const type_t tau[], uint32_t ntau,
+                                 bool keep_named, uint32_t budget) {
+  uint32_t nterms, ntypes;
+  double start;
+  bool done;
+
+  start = get_cpu_time();
+
+  if (! term_table_incremental_gc_in_progress(&terms)) {
+    term_table_start_incremental_gc(&terms);
+    gc_mark_roots(t, nt, tau, ntau);
+  } else {
+    if (t != NULL) mark_term_array(&terms, t, nt);
+    if (tau != NULL) mark_type_array(&types, tau, ntau);
+  }
+
+  gc_stats.incremental_steps ++;
+  done = term_table_incremental_gc_step(&terms, budget);
+  if (done) {
+    nterms = terms.live_terms;
+    ntypes = types.live_types;
+    gc_mark_roots(t, nt, tau, ntau);
+    term_table_finish_incremental_gc(&terms, keep_named);
+    gc_stats.incremental_collections ++;
+    gc_cleanup(nterms, ntypes);
+  }
+
+  gc_record_pause(start);
+
+  return done;
+}
+
+
+/*
+ * Call the garbage collector
+ * - t = optional array of terms
+ * - nt = size of t
+ * - tau = optional array of types
+ * - ntau = size of tau
+ * - keep_named specifies whether the named terms and types should
+ *   all be preserved
+ */
+static void _o_yices_garbage_collect(const term_t t[], uint32_t nt,
+				    const type_t tau[], uint32_t ntau,
+				    int32_t keep_named) {
+  garbage_collect(t, nt, tau, ntau, keep_named != 0, false);
+}
+
+EXPORTED void yices_garbage_collect(const term_t t[], uint32_t nt,
+				    const type_t tau[], uint32_t ntau,
+				    int32_t keep_named) {
+  MT_PROTECT_VOID(_o_yices_garbage_collect(t, nt, tau, ntau, keep_named));
+}
+
+
+/*
+ * Young collection: same roots as yices_garbage_collect but
+ * only the terms and types created since the last collection
+ * can be deleted.
+ */
+static void _o_yices_garbage_collect_young(const term_t t[], uint32_t nt,
+                                           const type_t tau[], uint32_t ntau,
+                                           int32_t keep_named) {
+  garbage_collect(t, nt, tau, ntau, keep_named != 0, true);
+}
+
+EXPORTED void yices_garbage_collect_young(const term_t t[], uint32_t nt,
+                                          const type_t tau[], uint32_t ntau,
+                                          int32_t keep_named) {
+  MT_PROTECT_VOID(_o_yices_garbage_collect_young(t, nt, tau, ntau, keep_named));
+}
+
+
+/*
+ * Incremental collection: do at most about budget units of work
+ * - return 1 if the collection is complete, 0 otherwise
+ */
+static int32_t _o_yices_garbage_collect_incremental(const term_t t[], uint32_t nt,
+                                                    const type_t tau[], uint32_t ntau,
+                                                    int32_t keep_named, uint32_t budget) {
+  return garbage_collect_step(t, nt, tau, ntau, keep_named != 0, budget);
+}
+
+EXPORTED int32_t yices_garbage_collect_incremental(const term_t t[], uint32_t nt,
+                                                   const type_t tau[], uint32_t ntau,
+                                                   int32_t keep_named, uint32_t budget) {
+  MT_PROTECT(int32_t, _o_yices_garbage_collect_incremental(t, nt, tau, ntau, keep_named, budget));
+}
+
+
+/*
+ * Garbage-collector statistics
+ */
+static void _o_yices_get_gc_stats(yices_gc_stats_t *stats) {
+  *stats = gc_stats;
+  stats->young_terms = term_table_num_young(&terms);
+  stats->young_types = type_table_num_young(&types);
+}
+
+EXPORTED void yices_get_gc_stats(yices_gc_stats_t *stats) {
+  MT_PROTECT_VOID(_o_yices_get_gc_stats(stats));
+}
+
+
+/*
+ * Memory report for the term table
+ */
+static void _o_yices_print_term_memory(FILE *f) {
+  print_term_table_memory(f, &terms);
+}
+
+EXPORTED void yices_print_term_memory(FILE *f) {
+  MT_PROTECT_VOID(_o_yices_print_term_memory(f));
 }
@@ -26,6 +26,15 @@
  * data structures, they can use the following table of pointers.
  *
  * The table is initialized after a call to yices_init();
+ *
+ * In the thread-safe build, the global tables are protected by two
+ * locks: types_lock for the type table and terms_lock for all the
+ * rest. API functions that use terms acquire terms_lock then
+ * types_lock. Functions that use only types acquire types_lock.
+ * yices_check_context (for DPLL(T) contexts), yices_stop_search,
+ * and functions that touch only the caller's data don't take any
+ * lock. The error report is thread-local and can be obtained with
+ * yices_error_report().
  */
 
 #ifndef __YICES_GLOBALS_H
@@ -34,14 +43,16 @@
 #include "parser_utils/term_stack2.h"
 #include "terms/free_var_collector.h"
 #include "terms/term_manager.h"
+#include "utils/yices_locks.h"
 
 typedef struct yices_globals_s {
   type_table_t *types;     // type table
   term_table_t *terms;     // term table
   term_manager_t *manager; // full term manager (includes terms)
   tstack_t *tstack;        // term stack (or NULL)
-  error_report_t *error;   // data structure for error reporting
   fvar_collector_t *fvars; // to collect free variables of terms
+  yices_lock_t terms_lock; // lock for terms (thread-safe build)
+  yices_lock_t types_lock; // lock for types (thread-safe build)
 } yices_globals_t;
 
 extern yices_globals_t __yices_globals;
@@ -28,6 +28,7 @@
 #include "solvers/bv/bvsolver.h"
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
+#include "solvers/sparse_dl/sparse_idl.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
 #include "terms/poly_buffer_terms.h"
@@ -4627,6 +4628,7 @@ static const uint32_t arch2theories[NUM_ARCH] = {
   ARITH_MASK,                  //  CTX_ARCH_SPLX
   IDL_MASK,                    //  CTX_ARCH_IFW
   RDL_MASK,                    //  CTX_ARCH_RFW
+  IDL_MASK,                    //  CTX_ARCH_ISDL
   BV_MASK,                     //  CTX_ARCH_BV
   UF_MASK|FUN_MASK,            //  CTX_ARCH_EGFUN
   UF_MASK|ARITH_MASK,          //  CTX_ARCH_EGSPLX
@@ -4657,6 +4659,7 @@ static const uint32_t arch2theories[NUM_ARCH] = {
 #define BVSLVR 0x10
 #define FSLVR  0x20
 #define MCSAT  0x40
+#define ISDL   0x80
 
 static const uint8_t arch_components[NUM_ARCH] = {
   0,                        //  CTX_ARCH_NOSOLVERS
@@ -4665,6 +4668,7 @@ static const uint8_t arch_components[NUM_ARCH] = {
   SPLX,                     //  CTX_ARCH_SPLX
   IFW,                      //  CTX_ARCH_IFW
   RFW,                      //  CTX_ARCH_RFW
+  ISDL,                     //  CTX_ARCH_ISDL
   BVSLVR,                   //  CTX_ARCH_BV
   EGRPH|FSLVR,              //  CTX_ARCH_EGFUN
   EGRPH|SPLX,               //  CTX_ARCH_EGSPLX
@@ -4726,6 +4730,12 @@ bool context_has_rdl_solver(context_t *ctx) {
   return ctx->arith_solver != NULL && (solvers & RFW);
 }
 
+bool context_has_sidl_solver(context_t *ctx) {
+  uint8_t solvers;
+  solvers = arch_components[ctx->arch];
+  return ctx->arith_solver != NULL && (solvers & ISDL);
+}
+
 bool context_has_simplex_solver(context_t *ctx) {
   uint8_t solvers;
   solvers = arch_components[ctx->arch];
@@ -4918,6 +4928,33 @@ static void create_rdl_solver(context_t *ctx, bool automatic) {
 }
 
 
+/*
+ * Create and initialize the sparse idl solver and attach it to the core
+ * - same conventions as create_idl_solver
+ */
+static void create_sidl_solver(context_t *ctx, bool automatic) {
+  sidl_solver_t *solver;
+  smt_mode_t cmode;
+
+  assert(ctx->egraph == NULL && ctx->arith_solver == NULL && ctx->bv_solver == NULL &&
+         ctx->fun_solver == NULL && ctx->core != NULL);
+
+  cmode = core_mode[ctx->mode];
+  solver = (sidl_solver_t *) safe_malloc(sizeof(sidl_solver_t));
+  init_sidl_solver(solver, ctx->core, &ctx->gate_manager);
+  if (automatic) {
+    smt_core_reset_thsolver(ctx->core, solver, sidl_ctrl_interface(solver),
+			    sidl_smt_interface(solver));
+  } else {
+    init_smt_core(ctx->core, CTX_DEFAULT_CORE_SIZE, solver, sidl_ctrl_interface(solver),
+		  sidl_smt_interface(solver), cmode);
+  }
+  sidl_solver_init_jmpbuf(solver, &ctx->env);
+  ctx->arith_solver = solver;
+  ctx->arith = *sidl_arith_interface(solver);
+}
+
+
 /*
  * Create an initialize the simplex solver and attach it to the core
  * or to the egraph if the egraph exists.
@@ -5157,6 +5194,8 @@ static void init_solvers(context_t *ctx) {
     create_idl_solver(ctx, false);
   } else if (solvers & RFW) {
     create_rdl_solver(ctx, false);
+  } else if (solvers & ISDL) {
+    create_sidl_solver(ctx, false);
   }
 
   // Bitvector solver
@@ -5204,6 +5243,14 @@ static void init_solvers(context_t *ctx) {
    */
   if (ctx->arch == CTX_ARCH_NOSOLVERS || ctx->arch == CTX_ARCH_BV) {
     smt_core_set_bool_only(core);
+    /*
+     * In one-check mode, no clause is added after the search starts
+     * so the core can eliminate variables that are not attached to atoms
+     * (unless lazy bit-blasting is enabled, cf. set_search_parameters).
+     */
+    if (ctx->mode == CTX_MODE_ONECHECK) {
+      smt_core_enable_var_elim(core);
+    }
   }
 }
 
@@ -5223,6 +5270,8 @@ static void delete_arith_solver(context_t *ctx) {
     delete_idl_solver(ctx->arith_solver);
   } else if (solvers & RFW) {
     delete_rdl_solver(ctx->arith_solver);
+  } else if (solvers & ISDL) {
+    delete_sidl_solver(ctx->arith_solver);
   } else if (solvers & SPLX) {
     delete_simplex_solver(ctx->arith_solver);
   }
@@ -5319,6 +5368,8 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_ivector(&ctx->aux_eqs, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->aux_atoms, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->aux_vector, CTX_DEFAULT_VECTOR_SIZE);
+  init_ivector(&ctx->assumptions, 0);
+  init_ivector(&ctx->assumption_lits, 0);
   init_int_queue(&ctx->queue, 0);
   init_istack(&ctx->istack);
   init_sharing_map(&ctx->sharing, &ctx->intern);
@@ -5346,6 +5397,16 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   // mcsat options default
   init_mcsat_options(&ctx->mcsat_options);
 
+  // no portfolio by default
+  ctx->portfolio_size = 1;
+  ctx->num_workers = 0;
+  ctx->workers = NULL;
+  ctx->portfolio_interrupted = false;
+
+  // no sat backend by default
+  ctx->use_sat_backend = false;
+  ctx->sat_backend = NULL;
+
   /*
    * Allocate and initialize the solvers and core
    * NOTE: no theory solver yet if arch is AUTO_IDL or AUTO_RDL
@@ -5360,6 +5421,9 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
  * Delete ctx
  */
 void delete_context(context_t *ctx) {
+  safe_free(ctx->workers);
+  ctx->workers = NULL;
+
   if (ctx->core != NULL) {
     if (ctx->arch != CTX_ARCH_AUTO_IDL && ctx->arch != CTX_ARCH_AUTO_RDL) {
       delete_smt_core(ctx->core);
@@ -5408,6 +5472,8 @@ void delete_context(context_t *ctx) {
   delete_ivector(&ctx->aux_eqs);
   delete_ivector(&ctx->aux_atoms);
   delete_ivector(&ctx->aux_vector);
+  delete_ivector(&ctx->assumptions);
+  delete_ivector(&ctx->assumption_lits);
   delete_int_queue(&ctx->queue);
   delete_istack(&ctx->istack);
   delete_sharing_map(&ctx->sharing);
@@ -5459,6 +5525,8 @@ void reset_context(context_t *ctx) {
   ivector_reset(&ctx->aux_eqs);
   ivector_reset(&ctx->aux_atoms);
   ivector_reset(&ctx->aux_vector);
+  ivector_reset(&ctx->assumptions);
+  ivector_reset(&ctx->assumption_lits);
   int_queue_reset(&ctx->queue);
   reset_istack(&ctx->istack);
   reset_sharing_map(&ctx->sharing);
@@ -5860,6 +5928,72 @@ int32_t context_internalize(context_t *ctx, term_t t) {
 }
 
 
+/*
+ * Store assumptions a[0 ... n-1] for check_context_with_assumptions
+ * - each a[i] must be a boolean term
+ * - each a[i] is converted to a literal, but not asserted
+ * - return CTX_NO_ERROR or a negative error code if one of the
+ *   terms can't be internalized
+ */
+int32_t context_set_assumptions(context_t *ctx, uint32_t n, const term_t *a) {
+  uint32_t i;
+  int32_t l;
+
+  ivector_reset(&ctx->assumptions);
+  ivector_reset(&ctx->assumption_lits);
+  for (i=0; i<n; i++) {
+    l = context_internalize(ctx, a[i]);
+    if (l < 0) {
+      ivector_reset(&ctx->assumptions);
+      ivector_reset(&ctx->assumption_lits);
+      return l;
+    }
+    ivector_push(&ctx->assumptions, a[i]);
+    ivector_push(&ctx->assumption_lits, l);
+  }
+
+  return CTX_NO_ERROR;
+}
+
+
+/*
+ * Build an unsat core after check_context_with_assumptions returned UNSAT
+ * - the core literals are computed by the smt_core then mapped back
+ *   to the assumption terms
+ * - the result is stored in v (in the same order as the assumptions)
+ */
+void context_build_unsat_core(context_t *ctx, ivector_t *v) {
+  ivector_t core;
+  int_hset_t lits, seen;
+  uint32_t i, n;
+  term_t t;
+
+  assert(ctx->mcsat == NULL && smt_status(ctx->core) == STATUS_UNSAT);
+
+  ivector_reset(v);
+
+  init_ivector(&core, 10);
+  build_unsat_core(ctx->core, &core);
+  if (core.size > 0) {
+    init_int_hset(&lits, 0);
+    init_int_hset(&seen, 0);
+    for (i=0; i<core.size; i++) {
+      int_hset_add(&lits, core.data[i]);
+    }
+    n = ctx->assumptions.size;
+    for (i=0; i<n; i++) {
+      t = ctx->assumptions.data[i];
+      if (int_hset_member(&lits, ctx->assumption_lits.data[i]) && int_hset_add(&seen, t)) {
+        ivector_push(v, t);
+      }
+    }
+    delete_int_hset(&seen);
+    delete_int_hset(&lits);
+  }
+  delete_ivector(&core);
+}
+
+
 /*
  * PROVISIONAL: FOR TESTING/DEBUGGING
  */
@@ -6016,6 +6150,12 @@ void context_stop_search(context_t *ctx) {
   if (context_has_simplex_solver(ctx)) {
     simplex_stop_search(ctx->arith_solver);
   }
+  if (ctx->num_workers > 0) {
+    stop_portfolio_workers(ctx);
+  }
+  if (ctx->sat_backend != NULL) {
+    sat_backend_stop(ctx->sat_backend);
+  }
 }
 
 
@@ -6039,7 +6179,11 @@ void context_cleanup(context_t *ctx) {
  */
 void context_clear(context_t *ctx) {
   assert(context_supports_multichecks(ctx));
-  smt_clear(ctx->core);
+  if (ctx->mcsat != NULL) {
+    mcsat_clear(ctx->mcsat);
+  } else {
+    smt_clear(ctx->core);
+  }
 }
 
 
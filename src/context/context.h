@@ -103,6 +103,7 @@ extern void disable_splx_eqprop(context_t *ctx);
  */
 extern bool context_has_idl_solver(context_t *ctx);
 extern bool context_has_rdl_solver(context_t *ctx);
+extern bool context_has_sidl_solver(context_t *ctx);
 extern bool context_has_simplex_solver(context_t *ctx);
 
 
@@ -142,6 +143,17 @@ extern int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f);
 extern int32_t context_internalize(context_t *ctx, term_t t);
 
 
+/*
+ * Store assumptions a[0 ... n-1] for the next call to
+ * check_context_with_assumptions.
+ * - each a[i] must be a boolean term
+ * - the terms are converted to literals but they are not asserted
+ * - return CTX_NO_ERROR or a negative code if one of a[i] can't be
+ *   internalized (then no assumptions are stored)
+ */
+extern int32_t context_set_assumptions(context_t *ctx, uint32_t n, const term_t *a);
+
+
 /*
  * Add the blocking clause to ctx
  * - ctx->status must be either SAT or UNKNOWN
@@ -169,6 +181,62 @@ extern int32_t assert_blocking_clause(context_t *ctx);
 extern smt_status_t check_context(context_t *ctx, const param_t *parameters);
 
 
+/*
+ * Check whether the context is consistent with the assumptions
+ * stored by context_set_assumptions.
+ * - the assumptions are decided first during the search
+ * - if the result is UNSAT because of the assumptions, the status is
+ *   UNSAT but the assertions and learned clauses are kept: the state is
+ *   restored by context_clear (cf. context_unsat_with_assumptions).
+ * - this is not supported by MCSAT
+ */
+extern smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *parameters);
+
+
+/*
+ * Build an unsat core: the context's status must be UNSAT
+ * - the core is a subset of the assumptions (as terms) that's
+ *   inconsistent with the assertions
+ * - it's empty if the assertions are unsat by themselves
+ * - the core is returned in v
+ */
+extern void context_build_unsat_core(context_t *ctx, ivector_t *v);
+
+
+/*
+ * Portfolio mode: if n > 1, check_context runs n searches in parallel,
+ * each in a separate worker process that uses a variant of the search
+ * parameters. The first worker that returns SAT or UNSAT wins, the
+ * others are killed, and the winning search is replayed in ctx so
+ * that models can be built as usual.
+ * - n = 0 is treated as n = 1 (i.e., no portfolio)
+ * - portfolio mode is ignored for MCSAT contexts and on platforms
+ *   that don't support fork (i.e., on Windows)
+ */
+extern void context_set_portfolio_size(context_t *ctx, uint32_t n);
+
+/*
+ * Kill all portfolio workers (used by context_stop_search)
+ * - this is safe to call from a signal handler
+ */
+extern void stop_portfolio_workers(context_t *ctx);
+
+
+/*
+ * SAT backend: if flag is true, check_context hands purely propositional
+ * problems to the stand-alone sat solver (new_sat_solver). This applies
+ * when the core has no theory solver that requires propagation or final
+ * checks (i.e., bitvector problems after bit-blasting) and the check has
+ * no assumptions. The clauses of the core are copied into the sat solver,
+ * and if it finds a model, the core search is replayed using that model
+ * as preferred polarities so that models can be built as usual.
+ * - portfolio mode is ignored when the sat backend is used
+ */
+static inline void context_set_sat_backend(context_t *ctx, bool flag) {
+  ctx->use_sat_backend = flag;
+}
+
+
 /*
  * Build a model: the context's status must be STATUS_SAT or STATUS_UNKNOWN
  * - model must be initialized (and empty)
@@ -272,16 +340,29 @@ extern int32_t context_process_formulas(context_t *ctx, uint32_t n, term_t *f);
  *  STATUS_SAT
  *  STATUS_UNSAT
  *  STATUS_INTERRUPTED
+ *
+ * In portfolio mode, the status is STATUS_SEARCHING while workers are active.
  */
 static inline smt_status_t context_status(context_t *ctx) {
   if (ctx->arch == CTX_ARCH_MCSAT) {
     return mcsat_status(ctx->mcsat);
+  } else if (ctx->num_workers > 0) {
+    return STATUS_SEARCHING;
   } else {
     return smt_status(ctx->core);
   }
 }
 
 
+/*
+ * Check whether ctx's status is UNSAT because of assumptions
+ * (i.e., the assertions alone may still be satisfiable)
+ */
+static inline bool context_unsat_with_assumptions(context_t *ctx) {
+  return ctx->arch != CTX_ARCH_MCSAT && smt_unsat_with_assumptions(ctx->core);
+}
+
+
 /*
  * Read the base_level (= number of calls to push)
  */
@@ -29,11 +29,27 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#ifndef MINGW
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#ifdef LINUX
+#include <sys/prctl.h>
+#endif
+
 #include "context/context.h"
 #include "context/internalization_codes.h"
 #include "model/models.h"
+#include "solvers/bv/bvsolver.h"
+#include "solvers/cdcl/clause_exchange.h"
+#include "solvers/cdcl/gate_simulator.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
+#include "utils/memalloc.h"
 
 
 
@@ -132,6 +148,17 @@ static void search(smt_core_t *core, uint32_t conflict_bound, uint32_t *reduce_t
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first
+    if (core->has_assumptions) {
+      l = get_next_assumption(core);
+      if (l != null_literal) {
+        decide_literal(core, l);
+        smt_process(core);
+        continue;
+      }
+      if (smt_status(core) != STATUS_SEARCHING) break;
+    }
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
@@ -177,6 +204,17 @@ static void luby_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *red
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first
+    if (core->has_assumptions) {
+      l = get_next_assumption(core);
+      if (l != null_literal) {
+        decide_literal(core, l);
+        smt_bounded_process(core, max_conflicts);
+        continue;
+      }
+      if (smt_status(core) != STATUS_SEARCHING) break;
+    }
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
@@ -227,6 +265,17 @@ static void special_search(smt_core_t *core, uint32_t conflict_bound, uint32_t *
       trace_reduce(core, core->stats.learned_clauses_deleted - deletions);
     }
 
+    // assumptions are decided first
+    if (core->has_assumptions) {
+      l = get_next_assumption(core);
+      if (l != null_literal) {
+        decide_literal(core, l);
+        smt_process(core);
+        continue;
+      }
+      if (smt_status(core) != STATUS_SEARCHING) break;
+    }
+
     // decision
     l = select_unassigned_literal(core);
     if (l == null_literal) {
@@ -302,20 +351,68 @@ static literal_t theory_or_pos_branch(smt_core_t *core, literal_t l) {
  */
 
 /*
- * Full solver:
- * - params: heuristic parameters.
- *   If params is NULL, the default settings are used.
+ * Random simulation of the circuits built by the gate manager and
+ * the bit-blaster (before search)
+ * - this is done only if all clauses are in the core (bool_only is
+ *   true), and if the search was not solved by start_search
+ * - the best simulation pattern sets the core's preferred polarities
+ */
+static void simulate_circuits(context_t *ctx, const param_t *params) {
+  smt_core_t *core;
+  gate_simulator_t sim;
+  gate_table_t *tbl;
+  uint32_t nfalse;
+
+  core = ctx->core;
+  if (! core->bool_only || smt_status(core) != STATUS_SEARCHING) return;
+
+  init_gate_simulator(&sim, core, params->random_seed);
+  gate_simulator_add_table(&sim, &ctx->gate_manager.htbl);
+  if (context_has_bv_solver(ctx)) {
+    tbl = bv_solver_gate_table(ctx->bv_solver);
+    if (tbl != NULL) {
+      gate_simulator_add_table(&sim, tbl);
+    }
+  }
+
+  nfalse = gate_simulator_run(&sim, params->bv_simulation);
+  gate_simulator_set_phases(&sim);
+
+  trace_printf(core->trace, 1, "(simulation: %"PRIu32" gates, %"PRIu32" patterns, %"PRIu32" false clauses)\n",
+               sim.gates.size, sim.npatterns, nfalse);
+
+  delete_gate_simulator(&sim);
+}
+
+
+/*
+ * Initial bound on the number of learned clauses (before reduce)
+ */
+static uint32_t initial_reduce_threshold(smt_core_t *core, const param_t *params) {
+  uint32_t reduce_threshold;
+
+  reduce_threshold = (uint32_t) (num_prob_clauses(core) * params->r_fraction);
+  if (reduce_threshold < params->r_threshold) {
+    reduce_threshold = params->r_threshold;
+  }
+  return reduce_threshold;
+}
+
+
+/*
+ * Search loop: bounded search + restarts until the problem is solved
+ * - the search must be started (by start_search)
+ * - reduce_threshold = initial bound on the number of learned clauses
+ * - if cx is not NULL, clauses are exchanged with the other
+ *   portfolio workers after each restart
  */
-static void solve(smt_core_t *core, const param_t *params) {
+static void search_loop(smt_core_t *core, const param_t *params, uint32_t reduce_threshold, clause_exchange_t *cx) {
   bool luby;
   uint32_t c_threshold, d_threshold; // Picosat-style
   uint32_t u, v, period;             // for Luby-style
-  uint32_t reduce_threshold;
-
-  assert(smt_status(core) == STATUS_IDLE);
 
   c_threshold = params->c_threshold;
-  d_threshold = c_threshold; // required by trace_start in slow_restart mode
+  d_threshold = c_threshold;
   luby = false;
   u = 1;
   v = 1;
@@ -328,15 +425,6 @@ static void solve(smt_core_t *core, const param_t *params) {
     luby = params->c_factor == 0.0; 
   }
 
-  reduce_threshold = (uint32_t) (num_prob_clauses(core) * params->r_fraction);
-  if (reduce_threshold < params->r_threshold) {
-    reduce_threshold = params->r_threshold;
-  }
-
-  // initialize then do a propagation + simplification step.
-  start_search(core);
-  trace_start(core);
-
   if (smt_status(core) == STATUS_SEARCHING) {
     // loop
     for (;;) {
@@ -370,6 +458,10 @@ static void solve(smt_core_t *core, const param_t *params) {
       smt_restart(core);
       //      smt_partial_restart_var(core);
 
+      if (cx != NULL) {
+        clause_exchange_sync(cx, core);
+      }
+
       if (luby) {
 	// Luby-style restart
 	if ((u & -u) == v) {
@@ -407,114 +499,1299 @@ static void solve(smt_core_t *core, const param_t *params) {
 }
 
 
+/*
+ * Full solver:
+ * - params: heuristic parameters.
+ *   If params is NULL, the default settings are used.
+ * - a[0 ... n-1] = assumptions (n may be zero)
+ */
+static void solve(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a) {
+  smt_core_t *core;
+  uint32_t reduce_threshold;
+
+  core = ctx->core;
+  assert(smt_status(core) == STATUS_IDLE);
+
+  reduce_threshold = initial_reduce_threshold(core, params);
+
+  // initialize then do a propagation + simplification step.
+  start_search(core, n, a);
+  trace_start(core);
+
+  if (params->bv_simulation > 0) {
+    simulate_circuits(ctx, params);
+  }
+
+  search_loop(core, params, reduce_threshold, NULL);
+}
+
+
 
 
 
 /*
- * Initialize search parameters then call solve
- * - if ctx->status is not IDLE, return the status.
+ * Set the search parameters of all solvers in ctx
+ * - every option is set in both directions so that nothing is left
+ *   over from a previous call with different parameters
  */
-smt_status_t check_context(context_t *ctx, const param_t *params) {
-  smt_status_t stat;
+static void set_search_parameters(context_t *ctx, const param_t *params) {
   smt_core_t *core;
   egraph_t *egraph;
   simplex_solver_t *simplex;
   fun_solver_t *fsolver;
+  bv_solver_t *bvsolver;
   uint32_t quota;
 
-  if (ctx->mcsat != NULL) {
-    mcsat_solve(ctx->mcsat, params);
-    return mcsat_status(ctx->mcsat);
-  }
-
   core = ctx->core;
   egraph = ctx->egraph;
 
-  stat = smt_status(core);
-  if (stat == STATUS_IDLE) {
-    /*
-     * Clean state: search can proceed
-     */
-    if (params == NULL) {
-      params = get_default_params();
+  /*
+   * Set core parameters
+   */
+  set_randomness(core, params->randomness);
+  set_random_seed(core, params->random_seed);
+  set_var_decay_factor(core, params->var_decay);
+  set_clause_decay_factor(core, params->clause_decay);
+  set_keep_lbd(core, params->keep_lbd);
+  set_tier2_lbd(core, params->tier2_lbd);
+  if (params->cache_tclauses) {
+    enable_theory_cache(core, params->tclause_size);
+  } else {
+    disable_theory_cache(core);
+  }
+
+  /*
+   * Set egraph parameters
+   */
+  if (egraph != NULL) {
+    if (params->use_optimistic_fcheck) {
+      egraph_enable_optimistic_final_check(egraph);
+    } else {
+      egraph_disable_optimistic_final_check(egraph);
+    }
+    if (params->use_dyn_ack) {
+      egraph_enable_dyn_ackermann(egraph, params->max_ackermann);
+      egraph_set_ackermann_threshold(egraph, params->dyn_ack_threshold);
+    } else {
+      egraph_disable_dyn_ackermann(egraph);
     }
+    if (params->use_bool_dyn_ack) {
+      egraph_enable_dyn_boolackermann(egraph, params->max_boolackermann);
+      egraph_set_boolack_threshold(egraph, params->dyn_bool_ack_threshold);
+    } else {
+      egraph_disable_dyn_boolackermann(egraph);
+    }
+    quota = egraph_num_terms(egraph) * params->aux_eq_ratio;
+    if (quota < params->aux_eq_quota) {
+      quota = params->aux_eq_quota;
+    }
+    egraph_set_aux_eq_quota(egraph, quota);
+    egraph_set_max_interface_eqs(egraph, params->max_interface_eqs);
+  }
 
-    /*
-     * Set core parameters
-     */
-    set_randomness(core, params->randomness);
-    set_random_seed(core, params->random_seed);
-    set_var_decay_factor(core, params->var_decay);
-    set_clause_decay_factor(core, params->clause_decay);
-    if (params->cache_tclauses) {
-      enable_theory_cache(core, params->tclause_size);
+  /*
+   * Set simplex parameters
+   */
+  if (context_has_simplex_solver(ctx)) {
+    simplex = ctx->arith_solver;
+    if (params->use_simplex_prop) {
+      simplex_enable_propagation(simplex);
     } else {
-      disable_theory_cache(core);
+      simplex_disable_propagation(simplex);
     }
+    simplex_set_prop_threshold(simplex, params->max_prop_row_size);
+    if (params->adjust_simplex_model) {
+      simplex_enable_adjust_model(simplex);
+    } else {
+      simplex_disable_adjust_model(simplex);
+    }
+    simplex_set_bland_threshold(simplex, params->bland_threshold);
+    // periodic icheck can also be enabled as a context option
+    if (params->integer_check || splx_periodic_icheck_enabled(ctx)) {
+      simplex_enable_periodic_icheck(simplex);
+    } else {
+      simplex_disable_periodic_icheck(simplex);
+    }
+    simplex_set_integer_check_period(simplex, params->integer_check_period);
+  }
 
-    /*
-     * Set egraph parameters
-     */
-    if (egraph != NULL) {
-      if (params->use_optimistic_fcheck) {
-	egraph_enable_optimistic_final_check(egraph);
-      } else {
-	egraph_disable_optimistic_final_check(egraph);
-      }
-      if (params->use_dyn_ack) {
-        egraph_enable_dyn_ackermann(egraph, params->max_ackermann);
-        egraph_set_ackermann_threshold(egraph, params->dyn_ack_threshold);
-      } else {
-        egraph_disable_dyn_ackermann(egraph);
-      }
-      if (params->use_bool_dyn_ack) {
-        egraph_enable_dyn_boolackermann(egraph, params->max_boolackermann);
-        egraph_set_boolack_threshold(egraph, params->dyn_bool_ack_threshold);
-      } else {
-        egraph_disable_dyn_boolackermann(egraph);
-      }
-      quota = egraph_num_terms(egraph) * params->aux_eq_ratio;
-      if (quota < params->aux_eq_quota) {
-        quota = params->aux_eq_quota;
+
+  /*
+   * Set array solver parameters
+   */
+  if (context_has_fun_solver(ctx)) {
+    fsolver = ctx->fun_solver;
+    fun_solver_set_max_update_conflicts(fsolver, params->max_update_conflicts);
+    fun_solver_set_max_extensionality(fsolver, params->max_extensionality);
+  }
+
+  /*
+   * Set bitvector solver parameters
+   */
+  if (context_has_bv_solver(ctx)) {
+    bvsolver = ctx->bv_solver;
+    bv_solver_set_lazy_blasting(bvsolver, params->bv_lazy_blasting);
+    if (params->bv_lazy_blasting) {
+      /*
+       * Deferred circuits are built in final_check, over the bits of
+       * their operands and result, so these bits must not be eliminated.
+       */
+      smt_core_disable_var_elim(core);
+    } else if (core->bool_only && ctx->mode == CTX_MODE_ONECHECK) {
+      // same condition as in init_solvers (context.c)
+      smt_core_enable_var_elim(core);
+    }
+  }
+}
+
+
+
+/*
+ * PORTFOLIO
+ */
+
+/*
+ * Set the portfolio size
+ */
+void context_set_portfolio_size(context_t *ctx, uint32_t n) {
+  ctx->portfolio_size = (n == 0) ? 1 : n;
+}
+
+
+/*
+ * The portfolio and cube-and-conquer modes fork worker processes.
+ * This is not available on Windows, and it's disabled in the thread-safe
+ * build: if another thread holds a Yices lock when fork is called, the
+ * lock is never released in the child. In both cases, these modes fall
+ * back to the sequential search.
+ */
+#if !defined(MINGW) && !defined(THREAD_SAFE)
+#define FORK_WORKERS 1
+#endif
+
+
+#ifdef FORK_WORKERS
+
+/*
+ * Parameters for portfolio worker i:
+ * - worker 0 uses the parameters given by the caller
+ * - the other workers use a different random seed and they
+ *   cycle through the restart strategies, branching heuristics,
+ *   and simplex options.
+ */
+static const branch_t worker_branching[3] = {
+  BRANCHING_DEFAULT, BRANCHING_NEGATIVE, BRANCHING_POSITIVE,
+};
+
+static void make_worker_params(param_t *p, const param_t *params, uint32_t i) {
+  *p = *params;
+  if (i == 0) return;
+
+  p->random_seed = params->random_seed + i * 0x9e3779b9u;
+
+  switch (i & 3) {
+  case 0: // same restarts but more randomness
+    p->randomness = params->randomness + 0.01 * (i >> 2);
+    if (p->randomness > 0.1) p->randomness = 0.1;
+    break;
+  case 1: // Luby restarts
+    p->fast_restart = true;
+    p->c_factor = 0.0;
+    break;
+  case 2: // Minisat-style restarts
+    p->fast_restart = false;
+    p->c_threshold = 100;
+    p->c_factor = 1.5;
+    break;
+  case 3: // Picosat-style restarts
+    p->fast_restart = true;
+    p->c_threshold = 100;
+    p->d_threshold = 100;
+    p->c_factor = 1.1;
+    p->d_factor = 1.1;
+    break;
+  }
+
+  p->branching = worker_branching[(i >> 1) % 3];
+
+  if (i & 1) {
+    p->use_simplex_prop = !params->use_simplex_prop;
+    p->integer_check = !params->integer_check;
+  }
+}
+
+
+/*
+ * Each worker writes a single report to the pipe when it's done
+ * (this is smaller than PIPE_BUF so the write is atomic).
+ */
+typedef struct worker_report_s {
+  uint32_t worker;
+  smt_status_t status;
+} worker_report_t;
+
+
+/*
+ * Kill all workers: this may be called from a signal handler
+ * so we just send SIGKILL. The workers are reaped by portfolio_check.
+ */
+void stop_portfolio_workers(context_t *ctx) {
+  uint32_t i, n;
+
+  n = ctx->num_workers;
+  for (i=0; i<n; i++) {
+    kill((pid_t) ctx->workers[i], SIGKILL);
+  }
+  ctx->portfolio_interrupted = true;
+}
+
+
+/*
+ * Install the model copied in cx by a worker
+ * - the core must be searching, after start_search
+ * - the model's values are copied into the preferred values then the
+ *   assignment is installed directly (cf. smt_install_preferred_assignment)
+ * - if that fails (because the theory solvers create atoms that the worker
+ *   didn't have or make different choices), the core is left searching and
+ *   the caller must complete the search
+ */
+static void install_worker_model(smt_core_t *core, clause_exchange_t *cx) {
+  if (clause_exchange_load_model(cx, core)) {
+    smt_process(core);
+    if (smt_status(core) == STATUS_SEARCHING) {
+      smt_install_preferred_assignment(core);
+    }
+  }
+}
+
+
+/*
+ * Worker i: run the search with parameters p then report the
+ * result to the parent. This never returns.
+ *
+ * If the result is SAT, the worker copies its model in cx. If it's
+ * UNSAT because of the assumptions, it copies the unsat core in cx.
+ * Only the first worker that does so reports its result (the
+ * others exit silently), so that cx is ready when the parent reads
+ * the report.
+ */
+static void run_worker(context_t *ctx, const param_t *p, uint32_t i, int fd,
+                       clause_exchange_t *cx, uint32_t n, const literal_t *a) {
+  worker_report_t report;
+  ivector_t v;
+
+#ifdef LINUX
+  // don't outlive the parent if it's killed
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+
+  set_search_parameters(ctx, p);
+  solve(ctx, p, n, a);
+
+  report.worker = i;
+  report.status = smt_status(ctx->core);
+  if (report.status == STATUS_SAT && !clause_exchange_save_model(cx, ctx->core)) {
+    _exit(0);
+  }
+  if (report.status == STATUS_UNSAT && smt_unsat_with_assumptions(ctx->core)) {
+    init_ivector(&v, 10);
+    build_unsat_core(ctx->core, &v);
+    if (! clause_exchange_save_core(cx, &v)) {
+      _exit(0);
+    }
+  }
+  if (write(fd, &report, sizeof(report)) != sizeof(report)) {
+    _exit(1);
+  }
+  _exit(0);
+}
+
+
+/*
+ * Launch n = ctx->portfolio_size workers with parameters derived from params.
+ * Wait for the first definitive answer (SAT or UNSAT) then kill the
+ * other workers and transfer the result to ctx:
+ * - if a worker found a model, its assignment is installed in ctx
+ *   (cf. install_worker_model). The search in ctx continues only if
+ *   the theory solvers don't accept that assignment.
+ * - if a worker proved UNSAT, the empty clause is added to ctx, or the
+ *   clause (not a1 or ... or not ak) if the unsat core is {a1, ..., ak}.
+ *   The search in ctx then returns UNSAT immediately (and it computes
+ *   the unsat core if there are assumptions).
+ *
+ * If no worker returns SAT or UNSAT, or if the workers can't be started,
+ * we fall back to the sequential search with params.
+ *
+ * All workers use the same assumptions a[0 ... na-1].
+ */
+static smt_status_t portfolio_check(context_t *ctx, const param_t *params, uint32_t na, const literal_t *a) {
+  smt_core_t *core;
+  clause_exchange_t cx;
+  param_t *variants;
+  worker_report_t report;
+  ivector_t clause;
+  uint32_t i, n, reduce_threshold;
+  int32_t winner;
+  smt_status_t result;
+  ssize_t k;
+  pid_t pid;
+  int fd[2];
+  int status;
+
+  core = ctx->core;
+  n = ctx->portfolio_size;
+  assert(n > 1 && ctx->num_workers == 0);
+
+  // the workers pass their model or unsat core through cx (no clause sharing)
+  if (! init_clause_exchange(&cx, 0, core->nvars, 1)) {
+    set_search_parameters(ctx, params);
+    solve(ctx, params, na, a);
+    return smt_status(core);
+  }
+
+  variants = (param_t *) safe_malloc(n * sizeof(param_t));
+  for (i=0; i<n; i++) {
+    make_worker_params(variants + i, params, i);
+  }
+
+  result = STATUS_UNKNOWN;
+  winner = 0;
+  ctx->portfolio_interrupted = false;
+
+  if (pipe(fd) == 0) {
+    ctx->workers = (int32_t *) safe_realloc(ctx->workers, n * sizeof(int32_t));
+
+    // don't duplicate buffered output in the workers
+    fflush(stdout);
+    fflush(stderr);
+
+    for (i=0; i<n; i++) {
+      pid = fork();
+      if (pid < 0) break;
+      if (pid == 0) {
+        close(fd[0]);
+        run_worker(ctx, variants + i, i, fd[1], &cx, na, a);
       }
-      egraph_set_aux_eq_quota(egraph, quota);
-      egraph_set_max_interface_eqs(egraph, params->max_interface_eqs);
+      ctx->workers[i] = (int32_t) pid;
+      ctx->num_workers = i+1;
     }
+    close(fd[1]);
 
     /*
-     * Set simplex parameters
+     * Collect reports until we get SAT or UNSAT. We get EOF
+     * when all workers are done or killed.
      */
-    if (context_has_simplex_solver(ctx)) {
-      simplex = ctx->arith_solver;
-      if (params->use_simplex_prop) {
-        simplex_enable_propagation(simplex);
-        simplex_set_prop_threshold(simplex, params->max_prop_row_size);
-      }
-      if (params->adjust_simplex_model) {
-        simplex_enable_adjust_model(simplex);
-      }
-      simplex_set_bland_threshold(simplex, params->bland_threshold);
-      if (params->integer_check) {
-        simplex_enable_periodic_icheck(simplex);
-        simplex_set_integer_check_period(simplex, params->integer_check_period);
+    for (;;) {
+      k = read(fd[0], &report, sizeof(report));
+      if (k == sizeof(report)) {
+        if (report.status == STATUS_SAT || report.status == STATUS_UNSAT) {
+          result = report.status;
+          winner = report.worker;
+          break;
+        }
+      } else if (k < 0 && errno == EINTR) {
+        continue;
+      } else {
+        break;
       }
     }
+    close(fd[0]);
 
+    // kill and reap all workers
+    n = ctx->num_workers;
+    for (i=0; i<n; i++) {
+      kill((pid_t) ctx->workers[i], SIGKILL);
+    }
+    ctx->num_workers = 0;
+    for (i=0; i<n; i++) {
+      while (waitpid((pid_t) ctx->workers[i], &status, 0) < 0 && errno == EINTR) {}
+    }
+  }
 
+  if (ctx->portfolio_interrupted) {
+    /*
+     * Interrupted by context_stop_search: put the core in the
+     * same state as an interrupted search.
+     */
+    start_search(core, na, a);
+    stop_search(core);
+  } else if (result == STATUS_UNKNOWN) {
+    set_search_parameters(ctx, params);
+    solve(ctx, params, na, a);
+  } else {
     /*
-     * Set array solver parameters
+     * Use the winner's parameters without random decisions, so that the
+     * theory solvers make the same choices as the winner.
      */
-    if (context_has_fun_solver(ctx)) {
-      fsolver = ctx->fun_solver;
-      fun_solver_set_max_update_conflicts(fsolver, params->max_update_conflicts);
-      fun_solver_set_max_extensionality(fsolver, params->max_extensionality);
+    params = variants + winner;
+    variants[winner].randomness = 0.0;
+    set_search_parameters(ctx, params);
+    reduce_threshold = initial_reduce_threshold(core, params);
+    start_search(core, na, a);
+    trace_start(core);
+    if (result == STATUS_SAT) {
+      install_worker_model(core, &cx);
+    } else {
+      // if there's no core, the worker's result doesn't depend on the assumptions
+      init_ivector(&clause, 10);
+      if (clause_exchange_load_core(&cx, na, a, &clause)) {
+        add_clause(core, clause.size, clause.data);
+      } else {
+        add_empty_clause(core);
+      }
+      delete_ivector(&clause);
     }
+    search_loop(core, params, reduce_threshold, NULL);
+  }
 
-    solve(core, params);
-    stat = smt_status(core);
+  delete_clause_exchange(&cx);
+  safe_free(variants);
+
+  return smt_status(core);
+}
+
+
+/*
+ * Worker i with clause sharing: continue the search started in the
+ * parent with parameters p, exchanging clauses through cx.
+ * The first worker that finds a model copies it in cx.
+ * This never returns.
+ *
+ * The core parameters can't be changed once the search is started,
+ * except for the random seed. So the workers differ by their seed,
+ * restart strategy, and branching heuristic.
+ */
+static void run_sharing_worker(smt_core_t *core, const param_t *p, uint32_t i, int fd,
+                               clause_exchange_t *cx, uint32_t reduce_threshold) {
+  worker_report_t report;
+
+#ifdef LINUX
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+
+  set_random_seed(core, p->random_seed);
+  clause_exchange_attach(cx, core, i);
+  search_loop(core, p, reduce_threshold, cx);
+
+  report.worker = i;
+  report.status = smt_status(core);
+  if (report.status == STATUS_SAT && !clause_exchange_save_model(cx, core)) {
+    // another worker has a model and will report it
+    _exit(0);
   }
+  if (write(fd, &report, sizeof(report)) != sizeof(report)) {
+    _exit(1);
+  }
+  _exit(0);
+}
 
-  return stat;
+
+/*
+ * Portfolio with clause sharing: the search is started in ctx, then
+ * ctx->portfolio_size workers continue it with different parameters
+ * and exchange their short learned clauses at each restart.
+ * - if a worker proves UNSAT, the empty clause is added to ctx (the
+ *   shared clauses are implied by the clauses of ctx)
+ * - if a worker finds a model, its assignment is installed in ctx
+ *   (cf. install_worker_model). All the clauses of ctx are true in
+ *   that model so this completes the search.
+ * - otherwise, the search continues sequentially in ctx
+ *
+ * This is used only if all clauses are in the core (bool_only is true)
+ * and there are no assumptions.
+ */
+static smt_status_t sharing_portfolio_check(context_t *ctx, const param_t *params) {
+  smt_core_t *core;
+  clause_exchange_t cx;
+  param_t *variants;
+  worker_report_t report;
+  uint32_t i, n, reduce_threshold;
+  smt_status_t result;
+  ssize_t k;
+  pid_t pid;
+  int fd[2];
+  int status;
+
+  core = ctx->core;
+  n = ctx->portfolio_size;
+  assert(n > 1 && ctx->num_workers == 0 && core->bool_only);
+
+  set_search_parameters(ctx, params);
+  reduce_threshold = initial_reduce_threshold(core, params);
+
+  start_search(core, 0, NULL);
+  trace_start(core);
+  if (params->bv_simulation > 0) {
+    simulate_circuits(ctx, params);
+  }
+  smt_process(core);
+
+  if (smt_status(core) != STATUS_SEARCHING) {
+    trace_done(core);
+    return smt_status(core);
+  }
+
+  if (! init_clause_exchange(&cx, n, core->nvars, params->share_lbd)) {
+    search_loop(core, params, reduce_threshold, NULL);
+    return smt_status(core);
+  }
+
+  variants = (param_t *) safe_malloc(n * sizeof(param_t));
+  for (i=0; i<n; i++) {
+    make_worker_params(variants + i, params, i);
+  }
+
+  trace_printf(core->trace, 1, "(clause sharing: %"PRIu32" workers, lbd <= %"PRIu32")\n", n, params->share_lbd);
+
+  result = STATUS_UNKNOWN;
+  ctx->portfolio_interrupted = false;
+
+  if (pipe(fd) == 0) {
+    ctx->workers = (int32_t *) safe_realloc(ctx->workers, n * sizeof(int32_t));
+    fflush(stdout);
+    fflush(stderr);
+
+    for (i=0; i<n; i++) {
+      pid = fork();
+      if (pid < 0) break;
+      if (pid == 0) {
+        close(fd[0]);
+        run_sharing_worker(core, variants + i, i, fd[1], &cx, reduce_threshold);
+      }
+      ctx->workers[i] = (int32_t) pid;
+      ctx->num_workers = i+1;
+    }
+    close(fd[1]);
+
+    for (;;) {
+      k = read(fd[0], &report, sizeof(report));
+      if (k == sizeof(report)) {
+        if (report.status == STATUS_SAT || report.status == STATUS_UNSAT) {
+          result = report.status;
+          break;
+        }
+      } else if (k < 0 && errno == EINTR) {
+        continue;
+      } else {
+        break;
+      }
+    }
+    close(fd[0]);
+
+    // kill and reap all workers
+    n = ctx->num_workers;
+    for (i=0; i<n; i++) {
+      kill((pid_t) ctx->workers[i], SIGKILL);
+    }
+    ctx->num_workers = 0;
+    for (i=0; i<n; i++) {
+      while (waitpid((pid_t) ctx->workers[i], &status, 0) < 0 && errno == EINTR) {}
+    }
+  }
+
+  if (ctx->portfolio_interrupted) {
+    stop_search(core);
+    trace_done(core);
+  } else if (result == STATUS_UNSAT) {
+    add_empty_clause(core);
+    smt_process(core);
+    assert(smt_status(core) == STATUS_UNSAT);
+    trace_done(core);
+  } else {
+    if (result == STATUS_SAT) {
+      install_worker_model(core, &cx);
+    }
+    search_loop(core, params, reduce_threshold, NULL);
+  }
+
+  delete_clause_exchange(&cx);
+  safe_free(variants);
+
+  return smt_status(core);
+}
+
+#else
+
+/*
+ * No worker processes: portfolio mode is ignored
+ */
+void stop_portfolio_workers(context_t *ctx) {
+}
+
+static smt_status_t portfolio_check(context_t *ctx, const param_t *params, uint32_t na, const literal_t *a) {
+  set_search_parameters(ctx, params);
+  solve(ctx, params, na, a);
+  return smt_status(ctx->core);
+}
+
+static smt_status_t sharing_portfolio_check(context_t *ctx, const param_t *params) {
+  set_search_parameters(ctx, params);
+  solve(ctx, params, 0, NULL);
+  return smt_status(ctx->core);
+}
+
+#endif
+
+
+
+/*
+ * CUBE AND CONQUER
+ */
+
+#ifdef FORK_WORKERS
+
+/*
+ * Number of candidate variables examined by the lookahead
+ */
+#define CUBE_CANDIDATES 64
+
+/*
+ * Collect the candidate splitting variables: at most CUBE_CANDIDATES
+ * unassigned variables that occur in the most problem clauses (binary
+ * clauses included).
+ * - the variables are stored in v, by decreasing number of occurrences
+ */
+static void collect_cube_candidates(smt_core_t *core, ivector_t *v) {
+  clause_t **cv;
+  literal_t *bin, *cl;
+  uint32_t *occ;
+  int32_t l, nlits;
+  uint32_t i, j, k, n, x, nvars;
+
+  nvars = core->nvars;
+  occ = (uint32_t *) safe_malloc(nvars * sizeof(uint32_t));
+  for (x=0; x<nvars; x++) {
+    occ[x] = 0;
+  }
+
+  // a binary clause {l1, l2} is stored in bin[l1] and bin[l2]
+  nlits = core->nlits;
+  for (l=0; l<nlits; l++) {
+    bin = core->bin[l];
+    if (bin != NULL) {
+      for (k=0; bin[k] >= 0; k++) {
+        occ[var_of(l)] ++;
+      }
+    }
+  }
+
+  cv = core->problem_clauses;
+  n = get_cv_size(cv);
+  for (i=0; i<n; i++) {
+    cl = cv[i]->cl;
+    for (k=0; cl[k] >= 0; k++) {
+      occ[var_of(cl[k])] ++;
+    }
+  }
+
+  ivector_reset(v);
+  for (x=0; x<nvars; x++) {
+    if (occ[x] == 0 || !bvar_is_unassigned(core, x)) continue;
+
+    if (v->size < CUBE_CANDIDATES) {
+      ivector_push(v, x);
+    } else if (occ[x] > occ[v->data[CUBE_CANDIDATES - 1]]) {
+      v->data[CUBE_CANDIDATES - 1] = x;
+    } else {
+      continue;
+    }
+
+    // insertion sort
+    j = v->size - 1;
+    while (j > 0 && occ[v->data[j-1]] < occ[x]) {
+      v->data[j] = v->data[j-1];
+      j --;
+    }
+    v->data[j] = x;
+  }
+
+  safe_free(occ);
+}
+
+
+/*
+ * Lookahead on literal l: decide l then propagate
+ * - return the number of literals assigned (including l), or -1 if
+ *   this causes a conflict or if the search is interrupted
+ * - after a conflict, the core has learned a clause and backtracked
+ * - in all cases, the core is back to the base level on exit
+ */
+static int32_t probe_literal(smt_core_t *core, literal_t l) {
+  uint32_t top;
+  int32_t n;
+
+  assert(core->decision_level == core->base_level && literal_is_unassigned(core, l));
+
+  top = core->stack.top;
+  decide_literal(core, l);
+  smt_process(core);
+  if (smt_status(core) != STATUS_SEARCHING || core->decision_level == core->base_level) {
+    return -1;
+  }
+  n = core->stack.top - top;
+  smt_restart(core);
+
+  return n;
+}
+
+
+/*
+ * Lookahead: select at most d splitting variables and store them in split
+ * - each candidate x is probed in both polarities. Its score is
+ *   (1 + n_pos) * (1 + n_neg) where n_pos and n_neg are the number of
+ *   literals implied by x and (not x). The variables of highest score
+ *   are selected.
+ * - a candidate that causes a conflict is skipped: the core learns
+ *   a clause that fixes it (failed literal).
+ * - the core must be at the base level with status SEARCHING
+ * - return the number of variables selected. This may be less than d
+ *   and the core status may be UNSAT or INTERRUPTED on exit.
+ */
+static uint32_t select_cube_vars(smt_core_t *core, uint32_t d, bvar_t *split) {
+  ivector_t cand;
+  uint64_t score[MAX_CUBE_DEPTH];
+  uint64_t s;
+  int32_t np, nn;
+  uint32_t i, j, k;
+  bvar_t x;
+
+  assert(d <= MAX_CUBE_DEPTH);
+
+  init_ivector(&cand, CUBE_CANDIDATES);
+  collect_cube_candidates(core, &cand);
+
+  k = 0;
+  for (i=0; i<cand.size && smt_status(core) == STATUS_SEARCHING; i++) {
+    x = cand.data[i];
+    if (! bvar_is_unassigned(core, x)) continue;
+
+    np = probe_literal(core, pos_lit(x));
+    if (np < 0) continue;
+    nn = probe_literal(core, neg_lit(x));
+    if (nn < 0) continue;
+
+    s = ((uint64_t) np + 1) * ((uint64_t) nn + 1);
+    if (k < d) {
+      k ++;
+    } else if (s <= score[d-1]) {
+      continue;
+    }
+
+    j = k - 1;
+    while (j > 0 && score[j-1] < s) {
+      split[j] = split[j-1];
+      score[j] = score[j-1];
+      j --;
+    }
+    split[j] = x;
+    score[j] = s;
+  }
+
+  delete_ivector(&cand);
+
+  // remove the variables fixed by failed literals found later
+  j = 0;
+  for (i=0; i<k; i++) {
+    if (bvar_is_unassigned(core, split[i])) {
+      split[j] = split[i];
+      j ++;
+    }
+  }
+
+  return j;
+}
+
+
+/*
+ * Store cube c in v: the i-th literal is split[i] if bit i of c is 1
+ * or its negation otherwise.
+ */
+static void make_cube(ivector_t *v, const bvar_t *split, uint32_t d, uint32_t c) {
+  uint32_t i;
+
+  ivector_reset(v);
+  for (i=0; i<d; i++) {
+    ivector_push(v, mk_lit(split[i], ((c >> i) & 1) ^ 1));
+  }
+}
+
+
+/*
+ * Report sent by a cube worker when it stops:
+ * - status = SAT: cube is satisfiable
+ * - status = UNSAT: the worker refuted 'refuted' cubes and
+ *   the queue is empty. If the clauses are unsat (independent of
+ *   the cube) then refuted is the total number of cubes.
+ * - any other status: the worker gave up on cube
+ */
+typedef struct cube_report_s {
+  smt_status_t status;
+  uint32_t cube;
+  uint32_t refuted;
+} cube_report_t;
+
+
+/*
+ * Cube worker: read cube indices from the jobs pipe and solve them with
+ * the cube as assumptions, until a cube is satisfiable or the queue
+ * is empty. Report to the parent then exit.
+ *
+ * If a cube is satisfiable, the worker copies its model in cx before
+ * reporting. If another worker has done that already, it exits without
+ * reporting.
+ */
+static void run_cube_worker(context_t *ctx, const param_t *p, int jobs, int fd,
+                            clause_exchange_t *cx, uint32_t d, const bvar_t *split) {
+  cube_report_t report;
+  ivector_t cube;
+  smt_core_t *core;
+  uint32_t c;
+  ssize_t k;
+
+#ifdef LINUX
+  prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+
+  core = ctx->core;
+  init_ivector(&cube, d);
+
+  report.status = STATUS_UNSAT;
+  report.cube = 0;
+  report.refuted = 0;
+
+  for (;;) {
+    k = read(jobs, &c, sizeof(c));
+    if (k < 0 && errno == EINTR) continue;
+    if (k != sizeof(c)) break;
+
+    make_cube(&cube, split, d, c);
+    solve(ctx, p, d, cube.data);
+
+    report.status = smt_status(core);
+    report.cube = c;
+    if (report.status != STATUS_UNSAT) break;
+    if (! smt_unsat_with_assumptions(core)) {
+      report.refuted = ((uint32_t) 1) << d;
+      break;
+    }
+    report.refuted ++;
+    smt_clear(core);
+  }
+
+  if (report.status == STATUS_SAT && !clause_exchange_save_model(cx, core)) {
+    _exit(0);
+  }
+  if (write(fd, &report, sizeof(report)) != sizeof(report)) {
+    _exit(1);
+  }
+  _exit(0);
+}
+
+
+/*
+ * Cube-and-conquer:
+ * - start the search and run the lookahead in ctx to get d splitting
+ *   variables (d <= params->cube_depth)
+ * - put the cube indices 0 ... 2^d-1 in a job queue (pipe) and launch
+ *   at most ctx->portfolio_size workers that take cubes from the queue
+ * - if a worker finds a satisfiable cube, the other workers are killed
+ *   and the worker's assignment is installed in ctx (cf. install_worker_model).
+ *   It satisfies all the clauses of ctx, so no search is needed.
+ * - if all the cubes are refuted, the empty clause is added to ctx
+ *
+ * If the lookahead finds no splitting variable, or some cubes can't be
+ * solved (the workers die or return UNKNOWN), we fall back to the
+ * sequential search. Cube-and-conquer does not support assumptions.
+ */
+static smt_status_t cube_check(context_t *ctx, const param_t *params) {
+  smt_core_t *core;
+  clause_exchange_t cx;
+  cube_report_t report;
+  bvar_t split[MAX_CUBE_DEPTH];
+  uint32_t i, d, n, c, ncubes, refuted, reduce_threshold;
+  int32_t sat_cube;
+  ssize_t k;
+  pid_t pid;
+  int fd[2], jobs[2];
+  int status;
+
+  core = ctx->core;
+  assert(ctx->portfolio_size > 1 && ctx->num_workers == 0);
+
+  set_search_parameters(ctx, params);
+
+  d = params->cube_depth;
+  if (d > MAX_CUBE_DEPTH) d = MAX_CUBE_DEPTH;
+
+  // lookahead
+  start_search(core, 0, NULL);
+  trace_start(core);
+  smt_process(core);
+  if (smt_status(core) == STATUS_SEARCHING) {
+    d = select_cube_vars(core, d, split);
+  }
+  if (smt_status(core) != STATUS_SEARCHING) {
+    trace_done(core);
+    return smt_status(core);
+  }
+  end_search_unknown(core);
+  smt_clear(core);
+
+  // the sat worker passes its model through cx (no clause sharing)
+  if (d == 0 || !init_clause_exchange(&cx, 0, core->nvars, 1)) {
+    solve(ctx, params, 0, NULL);
+    return smt_status(core);
+  }
+
+  ncubes = ((uint32_t) 1) << d;
+  n = ctx->portfolio_size;
+  if (n > ncubes) n = ncubes;
+
+  trace_printf(core->trace, 1, "(cube-and-conquer: %"PRIu32" split variables, %"PRIu32" workers)\n", d, n);
+
+  sat_cube = -1;
+  refuted = 0;
+  ctx->portfolio_interrupted = false;
+
+  if (pipe(jobs) == 0) {
+    if (pipe(fd) == 0) {
+      // at most 2^12 cubes: the queue fits in the pipe buffer
+      for (c=0; c<ncubes; c++) {
+        if (write(jobs[1], &c, sizeof(c)) != sizeof(c)) break;
+      }
+      close(jobs[1]);
+
+      ctx->workers = (int32_t *) safe_realloc(ctx->workers, n * sizeof(int32_t));
+      fflush(stdout);
+      fflush(stderr);
+
+      if (c == ncubes) {
+        for (i=0; i<n; i++) {
+          pid = fork();
+          if (pid < 0) break;
+          if (pid == 0) {
+            close(fd[0]);
+            run_cube_worker(ctx, params, jobs[0], fd[1], &cx, d, split);
+          }
+          ctx->workers[i] = (int32_t) pid;
+          ctx->num_workers = i+1;
+        }
+      }
+      close(fd[1]);
+
+      /*
+       * Collect the reports until a cube is sat or all cubes
+       * are refuted. We get EOF when all workers are done.
+       */
+      for (;;) {
+        k = read(fd[0], &report, sizeof(report));
+        if (k == sizeof(report)) {
+          if (report.status == STATUS_SAT) {
+            sat_cube = report.cube;
+            break;
+          }
+          if (report.status == STATUS_UNSAT) {
+            refuted += report.refuted;
+            if (refuted >= ncubes) break;
+          }
+        } else if (k < 0 && errno == EINTR) {
+          continue;
+        } else {
+          break;
+        }
+      }
+      close(fd[0]);
+
+      // kill and reap all workers
+      n = ctx->num_workers;
+      for (i=0; i<n; i++) {
+        kill((pid_t) ctx->workers[i], SIGKILL);
+      }
+      ctx->num_workers = 0;
+      for (i=0; i<n; i++) {
+        while (waitpid((pid_t) ctx->workers[i], &status, 0) < 0 && errno == EINTR) {}
+      }
+    } else {
+      close(jobs[1]);
+    }
+    close(jobs[0]);
+  }
+
+  if (ctx->portfolio_interrupted) {
+    start_search(core, 0, NULL);
+    stop_search(core);
+  } else if (sat_cube >= 0) {
+    reduce_threshold = initial_reduce_threshold(core, params);
+    start_search(core, 0, NULL);
+    trace_start(core);
+    install_worker_model(core, &cx);
+    search_loop(core, params, reduce_threshold, NULL);
+  } else if (refuted >= ncubes) {
+    start_search(core, 0, NULL);
+    add_empty_clause(core);
+    smt_process(core);
+    assert(smt_status(core) == STATUS_UNSAT);
+  } else {
+    solve(ctx, params, 0, NULL);
+  }
+
+  delete_clause_exchange(&cx);
+
+  return smt_status(core);
+}
+
+#else
+
+/*
+ * No worker processes: sequential search
+ */
+static smt_status_t cube_check(context_t *ctx, const param_t *params) {
+  set_search_parameters(ctx, params);
+  solve(ctx, params, 0, NULL);
+  return smt_status(ctx->core);
+}
+
+#endif
+
+
+
+/*
+ * SAT BACKEND
+ */
+
+/*
+ * Check whether the sat backend can be used for a search with n assumptions:
+ * - the core must not need a theory solver (bool_only is set for bitvector
+ *   problems after bit-blasting and for purely Boolean problems)
+ * - the backend doesn't support assumptions
+ */
+static bool sat_backend_applies(context_t *ctx, uint32_t n) {
+  return ctx->use_sat_backend && n == 0 && ctx->core->bool_only;
+}
+
+
+/*
+ * Copy all the problem clauses of core into b
+ * - the core must be at its base level: all the literals on the
+ *   propagation stack are then unit clauses
+ * - learned clauses are not copied
+ */
+static void copy_clauses_to_sat_backend(smt_core_t *core, sat_backend_t *b, ivector_t *buffer) {
+  prop_stack_t *stack;
+  clause_t **cv;
+  literal_t *bin, *cl;
+  literal_t l1, l2, aux[2];
+  int32_t nlits;
+  uint32_t i, j, n;
+
+  assert(core->decision_level == core->base_level);
+
+  if (core->inconsistent) {
+    sat_backend_add_clause(b, 0, aux);
+  }
+
+  stack = &core->stack;
+  n = stack->top;
+  for (i=0; i<n; i++) {
+    aux[0] = stack->lit[i];
+    sat_backend_add_clause(b, 1, aux);
+  }
+
+  nlits = core->nlits;
+  for (l1=0; l1<nlits; l1++) {
+    bin = core->bin[l1];
+    if (bin != NULL) {
+      for (;;) {
+        l2 = *bin ++;
+        if (l2 < 0) break;
+        if (l1 <= l2) {
+          aux[0] = l1;
+          aux[1] = l2;
+          sat_backend_add_clause(b, 2, aux);
+        }
+      }
+    }
+  }
+
+  cv = core->problem_clauses;
+  n = get_cv_size(cv);
+  for (i=0; i<n; i++) {
+    ivector_reset(buffer);
+    cl = cv[i]->cl;
+    for (j=0; cl[j] >= 0; j++) {
+      ivector_push(buffer, cl[j]);
+    }
+    sat_backend_add_clause(b, buffer->size, buffer->data);
+  }
+}
+
+
+/*
+ * Run the backend on the clauses of ctx->core
+ * - the core status must be SEARCHING, at the base level
+ * - if the backend finds a model, the core's preferred polarities
+ *   are set to that model (for all variables that are not assigned)
+ * - return the backend's status
+ */
+static smt_status_t run_sat_backend(context_t *ctx, const param_t *params) {
+  smt_core_t *core;
+  sat_backend_t *b;
+  ivector_t buffer;
+  smt_status_t stat;
+  bvar_t x;
+  uint32_t n;
+
+  core = ctx->core;
+  n = core->nvars;
+
+  b = new_sat_backend(n, true);
+  sat_backend_set_random_seed(b, params->random_seed);
+  init_ivector(&buffer, 10);
+  copy_clauses_to_sat_backend(core, b, &buffer);
+  delete_ivector(&buffer);
+
+  trace_printf(core->trace, 1, "(sat backend: %"PRIu32" vars, %"PRIu32" binary clauses, %"PRIu32" clauses)\n",
+               n, num_binary_clauses(core), num_prob_clauses(core));
+
+  ctx->sat_backend = b;
+  if (smt_status(core) == STATUS_SEARCHING) {
+    stat = sat_backend_solve(b);
+  } else {
+    // interrupted before we could start
+    stat = STATUS_INTERRUPTED;
+  }
+  ctx->sat_backend = NULL;
+
+  if (stat == STATUS_SAT) {
+    for (x=0; x<n; x++) {
+      if (bvar_is_unassigned(core, x)) {
+        set_bvar_preferred_value(core, x, sat_backend_var_is_true(b, x));
+      }
+    }
+  }
+
+  free_sat_backend(b);
+
+  return stat;
+}
+
+
+/*
+ * Solver using the sat backend:
+ * - start the search and propagate at the base level as in solve
+ *   (this forces bit-blasting)
+ * - if the problem is not solved by then, call the backend
+ * - if the backend returns UNSAT, add the empty clause to the core
+ * - if it returns SAT, the backend's model is installed in the core
+ *   (cf. smt_install_preferred_assignment). All the clauses of the core
+ *   are true in that model so this completes the assignment without
+ *   conflicts. The model is then built from the core's assignment
+ *   through the usual remap tables. The search loop is a fallback in
+ *   case the installation fails.
+ */
+static void solve_with_sat_backend(context_t *ctx, const param_t *params) {
+  smt_core_t *core;
+  uint32_t reduce_threshold;
+
+  core = ctx->core;
+  assert(smt_status(core) == STATUS_IDLE);
+
+  reduce_threshold = (uint32_t) (num_prob_clauses(core) * params->r_fraction);
+  if (reduce_threshold < params->r_threshold) {
+    reduce_threshold = params->r_threshold;
+  }
+
+  start_search(core, 0, NULL);
+  trace_start(core);
+  smt_process(core);
+
+  if (smt_status(core) == STATUS_SEARCHING) {
+    switch (run_sat_backend(ctx, params)) {
+    case STATUS_UNSAT:
+      add_empty_clause(core);
+      smt_process(core);
+      assert(smt_status(core) == STATUS_UNSAT);
+      break;
+
+    case STATUS_SAT:
+      smt_install_preferred_assignment(core);
+      while (smt_status(core) == STATUS_SEARCHING) {
+        search(core, params->c_threshold, &reduce_threshold, params->r_factor);
+        if (smt_status(core) != STATUS_SEARCHING) break;
+        smt_restart(core);
+        trace_restart(core);
+      }
+      break;
+
+    default:
+      // interrupted: the core status is INTERRUPTED too
+      assert(smt_status(core) == STATUS_INTERRUPTED);
+      break;
+    }
+  }
+
+  trace_done(core);
+}
+
+
+
+/*
+ * Initialize search parameters then call solve
+ * - a[0 ... n-1] = assumptions
+ * - if ctx->status is not IDLE, return the status.
+ */
+static smt_status_t check_context_aux(context_t *ctx, const param_t *params, uint32_t n, const literal_t *a) {
+  smt_status_t stat;
+  smt_core_t *core;
+
+  core = ctx->core;
+
+  stat = smt_status(core);
+  if (stat == STATUS_IDLE) {
+    /*
+     * Clean state: search can proceed
+     */
+    if (params == NULL) {
+      params = get_default_params();
+    }
+
+    if (sat_backend_applies(ctx, n)) {
+      set_search_parameters(ctx, params);
+      solve_with_sat_backend(ctx, params);
+      stat = smt_status(core);
+    } else if (ctx->portfolio_size > 1 && params->cube_depth > 0 && n == 0) {
+      stat = cube_check(ctx, params);
+    } else if (ctx->portfolio_size > 1 && params->share_lbd > 0 && n == 0 && core->bool_only) {
+      stat = sharing_portfolio_check(ctx, params);
+    } else if (ctx->portfolio_size > 1) {
+      stat = portfolio_check(ctx, params, n, a);
+    } else {
+      set_search_parameters(ctx, params);
+      solve(ctx, params, n, a);
+      stat = smt_status(core);
+    }
+  }
+
+  return stat;
+}
+
+
+smt_status_t check_context(context_t *ctx, const param_t *params) {
+  if (ctx->mcsat != NULL) {
+    mcsat_solve(ctx->mcsat, params);
+    return mcsat_status(ctx->mcsat);
+  }
+
+  return check_context_aux(ctx, params, 0, NULL);
+}
+
+
+/*
+ * Check with the assumptions stored in ctx (cf. context_set_assumptions)
+ */
+smt_status_t check_context_with_assumptions(context_t *ctx, const param_t *params) {
+  assert(ctx->mcsat == NULL);
+  return check_context_aux(ctx, params, ctx->assumption_lits.size, ctx->assumption_lits.data);
 }
 
 
@@ -546,7 +1823,7 @@ smt_status_t precheck_context(context_t *ctx) {
 
   stat = smt_status(core);
   if (stat == STATUS_IDLE) {
-    start_search(core);
+    start_search(core, 0, NULL);
     smt_process(core);
     stat = smt_status(core);
 
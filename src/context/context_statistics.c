@@ -61,6 +61,11 @@ static void show_stats(FILE *f, dpll_stats_t *stat) {
   fprintf(f, " deleted pb. clauses     : %"PRIu64"\n", stat->prob_clauses_deleted);
   fprintf(f, " deleted learned clauses : %"PRIu64"\n", stat->learned_clauses_deleted);
   fprintf(f, " deleted binary clauses  : %"PRIu64"\n", stat->bin_clauses_deleted);
+  fprintf(f, " inprocessing rounds     : %"PRIu32"\n", stat->inprocess_calls);
+  fprintf(f, " subsumed clauses        : %"PRIu64"\n", stat->subsumed_clauses);
+  fprintf(f, " strengthened clauses    : %"PRIu64"\n", stat->strengthened_clauses);
+  fprintf(f, " eliminated variables    : %"PRIu32"\n", stat->eliminated_vars);
+  fprintf(f, " vivified clauses        : %"PRIu64"\n", stat->vivified_clauses);
 }
 
 /*
@@ -179,6 +184,8 @@ void yices_print_presearch_stats(FILE *f, context_t *ctx) {
     fprintf(f, "arithmetic solver       : Simplex\n");
   } else if (context_has_idl_solver(ctx)) {
     fprintf(f, "arithmetic solver       : IDL Floyd-Warshall\n");
+  } else if (context_has_sidl_solver(ctx)) {
+    fprintf(f, "arithmetic solver       : IDL sparse\n");
   } else if (context_has_rdl_solver(ctx)) {
     fprintf(f, "arithmetic solver       : RDL Floyd-Warshall\n");
   }
@@ -35,6 +35,7 @@
 #include "context/shared_terms.h"
 #include "io/tracer.h"
 #include "solvers/cdcl/gates_manager.h"
+#include "solvers/cdcl/sat_backend.h"
 #include "solvers/cdcl/smt_core.h"
 #include "solvers/egraph/egraph.h"
 #include "terms/conditionals.h"
@@ -174,6 +175,7 @@ typedef enum {
   CTX_ARCH_SPLX,         // simplex
   CTX_ARCH_IFW,          // integer floyd-warshall
   CTX_ARCH_RFW,          // real floyd-warshall
+  CTX_ARCH_ISDL,         // integer sparse difference logic
   CTX_ARCH_BV,           // bitvector solver
   CTX_ARCH_EGFUN,        // egraph+array/function theory
   CTX_ARCH_EGSPLX,       // egraph+simplex
@@ -709,6 +711,24 @@ struct context_s {
 
   // options for the mcsat solver
   mcsat_options_t mcsat_options;
+
+  // portfolio mode: number of worker processes used by check_context
+  // (1 means no portfolio) + process ids of the workers during a check
+  uint32_t portfolio_size;
+  volatile uint32_t num_workers;
+  int32_t *workers;
+  volatile bool portfolio_interrupted;
+
+  // assumptions for check_context_with_assumptions:
+  // boolean terms + the corresponding literals
+  ivector_t assumptions;
+  ivector_t assumption_lits;
+
+  // sat backend: if use_sat_backend is true, purely propositional
+  // problems are solved by a stand-alone sat solver. sat_backend is
+  // non-NULL while that solver is running.
+  bool use_sat_backend;
+  sat_backend_t * volatile sat_backend;
 };
 
 
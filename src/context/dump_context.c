@@ -21,6 +21,8 @@
  * Moved the code here to clean-up yices_reval.c
  */
 
+#include <inttypes.h>
+
 #include "context/context.h"
 #include "context/context_printer.h"
 #include "context/dump_context.h"
@@ -33,6 +35,7 @@
 #include "solvers/floyd_warshall/idl_fw_printer.h"
 #include "solvers/floyd_warshall/rdl_fw_printer.h"
 #include "solvers/simplex/simplex_printer.h"
+#include "solvers/sparse_dl/sparse_idl.h"
 
 #ifndef NDEBUG
 #include "api/yices_globals.h"
@@ -62,6 +65,13 @@ static void dump_idl_solver(FILE *f, idl_solver_t *idl) {
   print_idl_axioms(f, idl);
 }
 
+static void dump_sidl_solver(FILE *f, sidl_solver_t *sidl) {
+  fprintf(f, "\n--- Sparse IDL solver ---\n");
+  fprintf(f, "  %"PRIu32" variables, %"PRIu32" vertices, %"PRIu32" atoms, %"PRIu32" edges\n",
+          sidl_num_vars(sidl), sidl_num_vertices(sidl), sidl_num_atoms(sidl), sidl_num_edges(sidl));
+  fprintf(f, "\n");
+}
+
 static void dump_rdl_solver(FILE *f, rdl_solver_t *rdl) {
   fprintf(f, "\n--- RDL Variables ---\n");
   print_rdl_var_table(f, rdl);
@@ -142,6 +152,8 @@ void dump_context(FILE *f, context_t *context) {
       dump_idl_solver(f, context->arith_solver);
     } else if (context_has_rdl_solver(context)) {
       dump_rdl_solver(f, context->arith_solver);
+    } else if (context_has_sidl_solver(context)) {
+      dump_sidl_solver(f, context->arith_solver);
     } else {
       assert(context_has_simplex_solver(context));
       dump_simplex_solver(f, context->arith_solver);
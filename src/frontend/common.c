@@ -153,11 +153,14 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "aux-eq-ratio",
   "bland-threshold",
   "branching",
+  "bv-lazy-blasting",
+  "bv-simulation",
   "bvarith-elim",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
   "clause-decay",
+  "cube-depth",
   "d-factor",
   "d-threshold",
   "dyn-ack",
@@ -175,6 +178,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "icheck",
   "icheck-period",
   "keep-ite",
+  "keep-lbd",
   "learn-eq",
   "max-ack",
   "max-bool-ack",
@@ -190,9 +194,11 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "r-threshold",
   "random-seed",
   "randomness",
+  "share-lbd",
   "simplex-adjust",
   "simplex-prop",
   "tclause-size",
+  "tier2-lbd",
   "var-decay",
   "var-elim",
 };
@@ -204,11 +210,14 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
   PARAM_BRANCHING,
+  PARAM_BV_LAZY_BLASTING,
+  PARAM_BV_SIMULATION,
   PARAM_BVARITH_ELIM,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
   PARAM_CLAUSE_DECAY,
+  PARAM_CUBE_DEPTH,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
   PARAM_DYN_ACK,
@@ -226,6 +235,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_ICHECK,
   PARAM_ICHECK_PERIOD,
   PARAM_KEEP_ITE,
+  PARAM_KEEP_LBD,
   PARAM_LEARN_EQ,
   PARAM_MAX_ACK,
   PARAM_MAX_BOOL_ACK,
@@ -241,9 +251,11 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_R_THRESHOLD,
   PARAM_RANDOM_SEED,
   PARAM_RANDOMNESS,
+  PARAM_SHARE_LBD,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
   PARAM_TCLAUSE_SIZE,
+  PARAM_TIER2_LBD,
   PARAM_VAR_DECAY,
   PARAM_VAR_ELIM,
 };
@@ -104,6 +104,8 @@ typedef enum yices_param {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_KEEP_LBD,
+  PARAM_TIER2_LBD,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -126,6 +128,12 @@ typedef enum yices_param {
   // array solver parameters
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // bitvector solver parameters
+  PARAM_BV_LAZY_BLASTING,
+  PARAM_BV_SIMULATION,
+  // parallel search
+  PARAM_CUBE_DEPTH,
+  PARAM_SHARE_LBD,
   // EF solver
   PARAM_EF_FLATTEN_IFF,
   PARAM_EF_FLATTEN_ITE,
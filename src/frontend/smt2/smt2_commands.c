@@ -46,6 +46,7 @@
 #include "frontend/smt2/smt2_lexer.h"
 #include "frontend/smt2/smt2_model_printer.h"
 #include "frontend/smt2/smt2_printer.h"
+#include "io/term_printer.h"
 #include "model/model_eval.h"
 #include "model/projection.h"
 #include "utils/refcount_strings.h"
@@ -62,6 +63,7 @@
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
+#include "solvers/sparse_dl/sparse_idl.h"
 #include "utils/cputime.h"
 #include "utils/memsize.h"
 
@@ -111,6 +113,13 @@ static void dump_idl_solver(FILE *f, idl_solver_t *idl) {
   fprintf(f, "\n");
 }
 
+static void dump_sidl_solver(FILE *f, sidl_solver_t *sidl) {
+  fprintf(f, "\n--- Sparse IDL solver ---\n");
+  fprintf(f, "  %"PRIu32" variables, %"PRIu32" vertices, %"PRIu32" atoms, %"PRIu32" edges\n",
+          sidl_num_vars(sidl), sidl_num_vertices(sidl), sidl_num_atoms(sidl), sidl_num_edges(sidl));
+  fprintf(f, "\n");
+}
+
 static void dump_rdl_solver(FILE *f, rdl_solver_t *rdl) {
   fprintf(f, "\n--- RDL Variables ---\n");
   print_rdl_var_table(f, rdl);
@@ -176,6 +185,8 @@ static void dump_context(FILE *f, context_t *ctx) {
       dump_idl_solver(f, ctx->arith_solver);
     } else if (context_has_rdl_solver(ctx)) {
       dump_rdl_solver(f, ctx->arith_solver);
+    } else if (context_has_sidl_solver(ctx)) {
+      dump_sidl_solver(f, ctx->arith_solver);
     } else {
       assert(context_has_simplex_solver(ctx));
       dump_simplex_solver(f, ctx->arith_solver);
@@ -1354,6 +1365,7 @@ static const char * const opcode_string[NUM_SMT2_OPCODES] = {
   "get-assignment",       // SMT2_GET_ASSIGNMENT
   "get-proof",            // SMT2_GET_PROOF
   "get-unsat-core",       // SMT2_GET_UNSAT_CORE
+  "get-unsat-assumptions", // SMT2_GET_UNSAT_ASSUMPTIONS
   "get-value",            // SMT2_GET_VALUE
   "get-option",           // SMT2_GET_OPTION
   "get-info",             // SMT2_GET_INFO
@@ -1364,6 +1376,7 @@ static const char * const opcode_string[NUM_SMT2_OPCODES] = {
   "pop",                  // SMT2_POP
   "assert",               // SMT2_ASSERT,
   "check-sat",            // SMT2_CHECK_SAT,
+  "check-sat-assuming",   // SMT2_CHECK_SAT_ASSUMING
   "declare-sort",         // SMT2_DECLARE_SORT
   "define-sort",          // SMT2_DEFINE_SORT
   "declare-fun",          // SMT2_DECLARE_FUN
@@ -1634,6 +1647,13 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   print_out(" :bvsolver-atoms %"PRIu32"\n", bv_solver_num_atoms(solver));
   print_out(" :bvsolver-equiv-lemmas %"PRIu32"\n", bv_solver_equiv_lemmas(solver));
   print_out(" :bvsolver-interface-lemmas %"PRIu32"\n", bv_solver_interface_lemmas(solver));
+  if (bv_solver_lazy_vars(solver) > 0) {
+    print_out(" :bvsolver-lazy-ops %"PRIu32"\n", bv_solver_lazy_vars(solver));
+    print_out(" :bvsolver-lazy-expansions %"PRIu32"\n", bv_solver_lazy_expansions(solver));
+  }
+  if (bv_solver_narrowed_ops(solver) > 0) {
+    print_out(" :bvsolver-narrowed-ops %"PRIu32"\n", bv_solver_narrowed_ops(solver));
+  }
 }
 
 static void show_idl_fw_stats(idl_solver_t *solver) {
@@ -1641,6 +1661,14 @@ static void show_idl_fw_stats(idl_solver_t *solver) {
   print_out(" :idl-solver-atoms %"PRIu32"\n", idl_num_atoms(solver));
 }
 
+static void show_sidl_stats(sidl_solver_t *solver) {
+  print_out(" :idl-solver-vars %"PRIu32"\n", sidl_num_vars(solver));
+  print_out(" :idl-solver-atoms %"PRIu32"\n", sidl_num_atoms(solver));
+  print_out(" :idl-solver-edges %"PRIu32"\n", sidl_num_edges(solver));
+  print_out(" :idl-solver-conflicts %"PRIu32"\n", sidl_num_conflicts(solver));
+  print_out(" :idl-solver-propagations %"PRIu32"\n", sidl_num_propagations(solver));
+}
+
 static void show_rdl_fw_stats(rdl_solver_t *solver) {
   print_out(" :rdl-solver-vars %"PRIu32"\n", rdl_num_vars(solver));
   print_out(" :rdl-solver-atoms %"PRIu32"\n", rdl_num_atoms(solver));
@@ -1666,6 +1694,8 @@ static void show_ctx_stats(context_t *ctx) {
       show_simplex_stats(ctx->arith_solver);
     } else if (context_has_idl_solver(ctx)) {
       show_idl_fw_stats(ctx->arith_solver);
+    } else if (context_has_sidl_solver(ctx)) {
+      show_sidl_stats(ctx->arith_solver);
     } else {
       assert(context_has_rdl_solver(ctx));
       show_rdl_fw_stats(ctx->arith_solver);
@@ -2338,8 +2368,12 @@ static void init_smt2_context(smt2_globals_t *g) {
   }
 
   if (arch == CTX_ARCH_MCSAT) {
-    // MCSAT requires ONE_CHECK for now
-    mode = CTX_MODE_ONECHECK;
+    // MCSAT supports push/pop but not clean interrupts
+    if (g->benchmark_mode) {
+      mode = CTX_MODE_ONECHECK;
+    } else if (mode == CTX_MODE_INTERACTIVE) {
+      mode = CTX_MODE_PUSHPOP;
+    }
     iflag = false;
     qflag = false;
   }
@@ -2353,6 +2387,12 @@ static void init_smt2_context(smt2_globals_t *g) {
   // Set the mcsat options
   g->ctx->mcsat_options = g->mcsat_options;
 
+  // Portfolio mode
+  context_set_portfolio_size(g->ctx, g->portfolio_size);
+
+  // Sat backend
+  context_set_sat_backend(g->ctx, g->sat_backend);
+
   /*
    * TODO: override the default context options based on
    * ctx_parameters.  I don't want to do it now (2015/07/22). If we
@@ -2393,16 +2433,39 @@ static void timeout_handler(void *data) {
   }
 }
 
+/*
+ * Call check_context or check_context_with_assumptions
+ * - the assumptions are in g->ctx_assumptions
+ */
+static smt_status_t check_context_or_assumptions(smt2_globals_t *g, const param_t *params) {
+  int32_t code;
+
+  if (g->ctx_assumptions.size == 0) {
+    return check_context(g->ctx, params);
+  }
+
+  code = context_set_assumptions(g->ctx, g->ctx_assumptions.size, g->ctx_assumptions.data);
+  if (code < 0) {
+    yices_internalization_error(code);
+    return STATUS_ERROR;
+  }
+
+  return check_context_with_assumptions(g->ctx, params);
+}
+
+
 /*
  * Call check_context with the given search parameters.
  * - if g->timeout is positive, set a timeout first
+ * - if g->ctx_assumptions is not empty, the check is done under
+ *   these assumptions
  */
 static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t *params) {
   smt_status_t stat;
 
   if (g->timeout == 0) {
     // no timeout
-    return check_context(g->ctx, params);
+    return check_context_or_assumptions(g, params);
   }
 
   /*
@@ -2415,7 +2478,7 @@ static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t
   }
   g->interrupted = false;
   start_timeout(g->timeout, timeout_handler, g);
-  stat = check_context(g->ctx, params);
+  stat = check_context_or_assumptions(g, params);
   clear_timeout();
 
   /*
@@ -2438,6 +2501,69 @@ static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t
 
 
 
+/*
+ * ASSUMPTIONS
+ */
+
+/*
+ * Collect the assumptions for the next call to check-sat
+ * - the named assertions come first (there are none unless
+ *   :produce-unsat-cores is true)
+ * - then the terms a[0 ... n-1] of (check-sat-assuming ...)
+ * - a[0 ... n-1] is also copied into g->sat_assumptions for
+ *   (get-unsat-assumptions)
+ */
+static void collect_assumptions(smt2_globals_t *g, uint32_t n, const term_t *a) {
+  named_term_stack_t *s;
+  uint32_t i;
+
+  ivector_reset(&g->ctx_assumptions);
+  ivector_reset(&g->sat_assumptions);
+
+  s = &g->named_asserts;
+  for (i=0; i<s->top; i++) {
+    ivector_push(&g->ctx_assumptions, s->data[i].term);
+  }
+  for (i=0; i<n; i++) {
+    ivector_push(&g->ctx_assumptions, a[i]);
+    ivector_push(&g->sat_assumptions, a[i]);
+  }
+}
+
+
+/*
+ * Check whether the context can deal with the assumptions
+ * - the MCSAT solver does not support them
+ * - print an error and return false if that's the case
+ */
+static bool assumptions_supported(smt2_globals_t *g) {
+  assert(g->ctx != NULL);
+
+  if (g->ctx_assumptions.size > 0 && g->ctx->arch == CTX_ARCH_MCSAT) {
+    print_error("assumptions and unsat cores are not supported by the mcsat solver");
+    return false;
+  }
+  return true;
+}
+
+
+/*
+ * Check whether t is the named assertion just recorded by smt2_add_name
+ * - this consumes g->pending_named_assert
+ */
+static bool pending_named_assertion(smt2_globals_t *g, term_t t) {
+  named_term_stack_t *s;
+  bool result;
+
+  s = &g->named_asserts;
+  result = g->pending_named_assert && s->top > 0 && s->data[s->top - 1].term == t;
+  g->pending_named_assert = false;
+
+  return result;
+}
+
+
+
 /*
  * DELAYED ASSERTION/CHECK_SAT
  */
@@ -2661,7 +2787,7 @@ static void check_delayed_assertions(smt2_globals_t *g) {
 
   if (g->trivially_unsat) {
     print_out("unsat\n");
-  } else if (g->assertions.size == 0) {
+  } else if (g->assertions.size == 0 && g->ctx_assumptions.size == 0) {
     print_out("sat\n");
   } else {
     /*
@@ -2669,11 +2795,15 @@ static void check_delayed_assertions(smt2_globals_t *g) {
      * marked as QF_UFIDL do not require the Egraph (should be QF_IDL)
      */
     if (g->benchmark_mode && g->logic_code == QF_UFIDL &&
-	!has_uf(g->assertions.data, g->assertions.size)) {
+	!has_uf(g->assertions.data, g->assertions.size) &&
+	!has_uf(g->ctx_assumptions.data, g->ctx_assumptions.size)) {
       trace_printf(g->tracer, 2, "(Warning: switching logic to QF_IDL)\n");
       g->logic_code = QF_IDL;
     }
     init_smt2_context(g);
+    if (! assumptions_supported(g)) {
+      return;
+    }
 #if 1
     code = yices_assert_formulas(g->ctx, g->assertions.size, g->assertions.data);
     if (code < 0) {
@@ -2774,6 +2904,46 @@ static void show_delayed_assertions(smt2_globals_t *g) {
  * CONTEXT OPERATIONS: INCREMENTAL MODE
  */
 
+/*
+ * If the context is UNSAT because of assumptions, restore it to IDLE.
+ * This must be done before any operation that modifies the context.
+ */
+static void ctx_clear_unsat_assumptions(smt2_globals_t *g) {
+  if (context_unsat_with_assumptions(g->ctx)) {
+    assert(g->model == NULL);
+    context_clear(g->ctx);
+    assert(context_status(g->ctx) == STATUS_IDLE);
+  }
+}
+
+
+/*
+ * Record a named assertion: it's not asserted in g->ctx but it's
+ * used as an assumption in the next (check-sat). We just reset the
+ * context status to IDLE so that the next check-sat is not skipped.
+ */
+static void add_named_assertion(smt2_globals_t *g) {
+  assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
+
+  ctx_clear_unsat_assumptions(g);
+  switch (context_status(g->ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    if (g->model != NULL) {
+      yices_free_model(g->model);
+      g->model = NULL;
+    }
+    context_clear(g->ctx);
+    assert(context_status(g->ctx) == STATUS_IDLE);
+    break;
+
+  default:
+    break;
+  }
+
+  report_success();
+}
+
 /*
  * Assert t in g->ctx
  * - t is known to be a Boolean term here
@@ -2783,6 +2953,7 @@ static void add_assertion(smt2_globals_t *g, term_t t) {
 
   assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
 
+  ctx_clear_unsat_assumptions(g);
   switch (context_status(g->ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -2825,13 +2996,27 @@ static void add_assertion(smt2_globals_t *g, term_t t) {
 
 /*
  * Check satisfiability
+ * - the assumptions must be stored in g->ctx_assumptions
  */
 static void ctx_check_sat(smt2_globals_t *g) {
   smt_status_t stat;
 
   assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
 
+  ctx_clear_unsat_assumptions(g);
   stat = context_status(g->ctx);
+
+  if (g->sat_assumptions.size > 0 && (stat == STATUS_SAT || stat == STATUS_UNKNOWN)) {
+    // new assumptions: we can't reuse the previous result
+    if (g->model != NULL) {
+      yices_free_model(g->model);
+      g->model = NULL;
+    }
+    context_clear(g->ctx);
+    stat = context_status(g->ctx);
+    assert(stat == STATUS_IDLE);
+  }
+
   switch (stat) {
   case STATUS_UNKNOWN:
   case STATUS_UNSAT:
@@ -2845,9 +3030,15 @@ static void ctx_check_sat(smt2_globals_t *g) {
     if (g->random_seed != 0) {
       g->parameters.random_seed = g->random_seed;
     }
-    //    stat = check_context(g->ctx, &g->parameters);
-    stat = check_context_with_timeout(g, &g->parameters);
-    show_status(stat);
+    if (assumptions_supported(g)) {
+      //    stat = check_context(g->ctx, &g->parameters);
+      stat = check_context_with_timeout(g, &g->parameters);
+      if (stat == STATUS_ERROR) {
+	print_yices_error(true);
+      } else {
+	show_status(stat);
+      }
+    }
     break;
 
   case STATUS_SEARCHING:
@@ -2866,6 +3057,7 @@ static void ctx_check_sat(smt2_globals_t *g) {
 static void ctx_push(smt2_globals_t *g) {
   assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
 
+  ctx_clear_unsat_assumptions(g);
   switch (context_status(g->ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -2901,6 +3093,7 @@ static void ctx_push(smt2_globals_t *g) {
 static void ctx_pop(smt2_globals_t *g) {
   assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
 
+  ctx_clear_unsat_assumptions(g);
   switch (context_status(g->ctx)) {
   case STATUS_UNKNOWN:
   case STATUS_SAT:
@@ -3339,6 +3532,8 @@ static void init_smt2_globals(smt2_globals_t *g) {
   g->logic_name = NULL;
   g->mcsat = false;
   init_mcsat_options(&g->mcsat_options);
+  g->portfolio_size = 1;
+  g->sat_backend = false;
   g->efmode = false;
   init_ef_client(&g->ef_client);
   g->out = stdout;
@@ -3372,6 +3567,10 @@ static void init_smt2_globals(smt2_globals_t *g) {
 
   init_named_term_stack(&g->named_bools);
   init_named_term_stack(&g->named_asserts);
+  g->pending_named_assert = false;
+
+  init_ivector(&g->sat_assumptions, 0);
+  init_ivector(&g->ctx_assumptions, 0);
 
   init_etk_queue(&g->token_queue);
   init_ivector(&g->token_slices, 0);
@@ -3428,6 +3627,9 @@ static void delete_smt2_globals(smt2_globals_t *g) {
   delete_named_term_stack(&g->named_bools);
   delete_named_term_stack(&g->named_asserts);
 
+  delete_ivector(&g->sat_assumptions);
+  delete_ivector(&g->ctx_assumptions);
+
   delete_etk_queue(&g->token_queue);
   delete_ivector(&g->token_slices);
   delete_ivector(&g->val_vector);
@@ -3588,12 +3790,135 @@ void smt2_get_proof(void) {
 }
 
 
+/*
+ * Compute the unsat core after (check-sat)
+ * - print an error and return false if the context is not unsat
+ * - otherwise store the core in v and return true
+ * - the core is a subset of g->ctx_assumptions. It's empty if the
+ *   assertions are unsat on their own.
+ */
+static bool get_unsat_core_terms(smt2_globals_t *g, ivector_t *v) {
+  ivector_reset(v);
+
+  if (g->ctx == NULL) {
+    // benchmark mode: no context
+    assert(g->benchmark_mode);
+
+    if (!g->frozen) {
+      print_error("can't build an unsat core. Call (check-sat) first");
+      return false;
+    }
+    if (!g->trivially_unsat) {
+      print_error("can't build an unsat core. The context is satisfiable");
+      return false;
+    }
+    return true;
+  }
+
+  switch (context_status(g->ctx)) {
+  case STATUS_UNSAT:
+    if (context_unsat_with_assumptions(g->ctx)) {
+      context_build_unsat_core(g->ctx, v);
+    }
+    return true;
+
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    print_error("can't build an unsat core. The context is not unsatisfiable");
+    return false;
+
+  case STATUS_IDLE:
+    print_error("can't build an unsat core. Call (check-sat) first");
+    return false;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+  default:
+    bad_status_bug(g->err);
+    return false;
+  }
+}
+
+
 /*
  * Get the unsat core: subset of :named assertions that form an unsat core
+ * - we print the names of all named assertions that are in the core
  */
 void smt2_get_unsat_core(void) {
+  smt2_globals_t *g;
+  yices_pp_t printer;
+  int_hset_t core;
+  named_term_stack_t *s;
+  ivector_t *v;
+  uint32_t i;
+
+  g = &__smt2_globals;
+  if (check_logic()) {
+    if (! g->produce_unsat_cores) {
+      print_error("get-unsat-core requires option :produce-unsat-cores to be true");
+      return;
+    }
+
+    v = &g->val_vector;
+    if (get_unsat_core_terms(g, v)) {
+      init_int_hset(&core, 0);
+      for (i=0; i<v->size; i++) {
+	int_hset_add(&core, v->data[i]);
+      }
+
+      init_pretty_printer(&printer, g);
+      pp_open_block(&printer, PP_OPEN_PAR);
+      s = &g->named_asserts;
+      for (i=0; i<s->top; i++) {
+	if (int_hset_member(&core, s->data[i].term)) {
+	  pp_string(&printer, s->data[i].name);
+	}
+      }
+      pp_close_block(&printer, true);
+      delete_yices_pp(&printer, true);
+
+      delete_int_hset(&core);
+      ivector_reset(v);
+    }
+  }
+}
+
+
+/*
+ * Get the unsat assumptions: subset of the assumptions of the
+ * last (check-sat-assuming ...) that's in the unsat core
+ */
+void smt2_get_unsat_assumptions(void) {
+  smt2_globals_t *g;
+  yices_pp_t printer;
+  int_hset_t core;
+  ivector_t *v;
+  uint32_t i;
+  term_t t;
+
+  g = &__smt2_globals;
   if (check_logic()) {
-    print_error("get-unsat-core is not supported");
+    v = &g->val_vector;
+    if (get_unsat_core_terms(g, v)) {
+      init_int_hset(&core, 0);
+      for (i=0; i<v->size; i++) {
+	int_hset_add(&core, v->data[i]);
+      }
+
+      init_pretty_printer(&printer, g);
+      pp_open_block(&printer, PP_OPEN_PAR);
+      for (i=0; i<g->sat_assumptions.size; i++) {
+	t = g->sat_assumptions.data[i];
+	if (int_hset_member(&core, t)) {
+	  pp_term(&printer, __yices_globals.terms, t);
+	}
+      }
+      pp_close_block(&printer, true);
+      delete_yices_pp(&printer, true);
+
+      delete_int_hset(&core);
+      ivector_reset(v);
+    }
   }
 }
 
@@ -3777,6 +4102,14 @@ static bool yices_get_option(const smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.tclause_size);
     break;
 
+  case PARAM_KEEP_LBD:
+    print_uint32_value(g->parameters.keep_lbd);
+    break;
+
+  case PARAM_TIER2_LBD:
+    print_uint32_value(g->parameters.tier2_lbd);
+    break;
+
   case PARAM_DYN_ACK:
     print_boolean_value(g->parameters.use_dyn_ack);
     break;
@@ -3853,6 +4186,22 @@ static bool yices_get_option(const smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.max_extensionality);
     break;
 
+  case PARAM_BV_LAZY_BLASTING:
+    print_boolean_value(g->parameters.bv_lazy_blasting);
+    break;
+
+  case PARAM_BV_SIMULATION:
+    print_uint32_value(g->parameters.bv_simulation);
+    break;
+
+  case PARAM_CUBE_DEPTH:
+    print_uint32_value(g->parameters.cube_depth);
+    break;
+
+  case PARAM_SHARE_LBD:
+    print_uint32_value(g->parameters.share_lbd);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     print_boolean_value(g->ef_client.ef_parameters.flatten_iff);
     break;
@@ -3910,6 +4259,10 @@ void smt2_get_option(const char *name) {
     print_boolean_value(g->produce_assignments);
     break;
 
+  case SMT2_KW_PRODUCE_UNSAT_CORES:
+    print_boolean_value(g->produce_unsat_cores);
+    break;
+
   case SMT2_KW_REGULAR_OUTPUT:
     s = g->out_name;
     if (s == NULL) {
@@ -3943,7 +4296,6 @@ void smt2_get_option(const char *name) {
   case SMT2_KW_EXPAND_DEFINITIONS:
   case SMT2_KW_INTERACTIVE_MODE:
   case SMT2_KW_PRODUCE_PROOFS:
-  case SMT2_KW_PRODUCE_UNSAT_CORES:
   default:
     // may be a Yices option
     if (is_yices_option(name, &yices_option)) {
@@ -4280,6 +4632,18 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_KEEP_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.keep_lbd = n;
+    }
+    break;
+
+  case PARAM_TIER2_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.tier2_lbd = n;
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->parameters.use_dyn_ack = tt;
@@ -4410,6 +4774,30 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_BV_LAZY_BLASTING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.bv_lazy_blasting = tt;
+    }
+    break;
+
+  case PARAM_BV_SIMULATION:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.bv_simulation = n;
+    }
+    break;
+
+  case PARAM_CUBE_DEPTH:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.cube_depth = n;
+    }
+    break;
+
+  case PARAM_SHARE_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.share_lbd = n;
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->ef_client.ef_parameters.flatten_iff = tt;
@@ -4515,6 +4903,13 @@ void smt2_set_option(const char *name, aval_t value) {
     }
     break;
 
+  case SMT2_KW_PRODUCE_UNSAT_CORES:
+    // optional: if true, get-unsat-core can be used
+    if (option_can_be_set(name)) {
+      set_boolean_option(g, name, value, &g->produce_unsat_cores);
+    }
+    break;
+
   case SMT2_KW_REGULAR_OUTPUT:
     // required
     set_output_file(g, name, value);
@@ -4545,7 +4940,6 @@ void smt2_set_option(const char *name, aval_t value) {
   case SMT2_KW_EXPAND_DEFINITIONS:
   case SMT2_KW_INTERACTIVE_MODE:
   case SMT2_KW_PRODUCE_PROOFS:
-  case SMT2_KW_PRODUCE_UNSAT_CORES:
     unsupported_option();
     flush_out();
     break;
@@ -4646,13 +5040,8 @@ void smt2_set_logic(const char *name) {
     return;
   }
 
-  // for logics that require mcsat: check that we're in benchamrk mode
   arch = arch_for_logic(code);
-  if (arch == CTX_ARCH_MCSAT && !__smt2_globals.benchmark_mode) {
-    print_error("the mcsat solver can't be used in incremental mode");
-    return;
-  }
-  
+
   // check to see if we are in efmode 
   __smt2_globals.efmode = logic_has_quantifiers(code);
   if (__smt2_globals.efmode) {
@@ -4804,10 +5193,13 @@ void smt2_pop(uint32_t n) {
 
 /*
  * Assert one formula t
- * - if t is a :named assertion then it should be recorded for unsat-core
+ * - if t is a :named assertion and :produce-unsat-cores is true, then t
+ *   is already recorded in g->named_asserts. It's not asserted but
+ *   used as an assumption by (check-sat).
  */
 void smt2_assert(term_t t) {
   smt2_globals_t *g;
+  bool named;
 
   g = &__smt2_globals;
 
@@ -4817,15 +5209,20 @@ void smt2_assert(term_t t) {
 
   if (check_logic()) {
     if (yices_term_is_bool(t)) {
+      named = pending_named_assertion(g, t);
       if (g->benchmark_mode) {
 	if (g->efmode && g->ef_client.efdone) {
 	  print_error("more assertions are not allowed after solving");
 	} else if (g->frozen) {
 	  print_error("assertions are not allowed after (check-sat) in non-incremental mode");
 	} else {
-	  add_delayed_assertion(g, t);
+	  if (! named) {
+	    add_delayed_assertion(g, t);
+	  }
 	  report_success();
 	}
+      } else if (named) {
+	add_named_assertion(g);
       } else {
 	add_assertion(g, t);
       }
@@ -4872,6 +5269,7 @@ void smt2_check_sat(void) {
   tprint_calls("check-sat", __smt2_globals.stats.num_check_sat);
 
   if (check_logic()) {
+    collect_assumptions(&__smt2_globals, 0, NULL);
     if (__smt2_globals.benchmark_mode) {
       if (__smt2_globals.efmode) {
 	efsolve_cmd(&__smt2_globals);	
@@ -4888,6 +5286,43 @@ void smt2_check_sat(void) {
 }
 
 
+/*
+ * Check satisfiability under assumptions a[0 ... n-1]
+ */
+void smt2_check_sat_assuming(uint32_t n, term_t *a) {
+  smt2_globals_t *g;
+  uint32_t i;
+
+  g = &__smt2_globals;
+
+  g->stats.num_check_sat ++;
+  g->stats.num_commands ++;
+  tprint_calls("check-sat-assuming", g->stats.num_check_sat);
+
+  if (check_logic()) {
+    for (i=0; i<n; i++) {
+      if (! yices_term_is_bool(a[i])) {
+	print_error("type error in check-sat-assuming: Boolean term required");
+	return;
+      }
+    }
+
+    collect_assumptions(g, n, a);
+    if (g->benchmark_mode) {
+      if (g->efmode) {
+	print_error("check-sat-assuming is not supported by the exists/forall solver");
+      } else if (g->frozen) {
+	print_error("multiple calls to (check-sat) are not allowed in non-incremental mode");
+      } else {
+	check_delayed_assertions(g);
+      }
+    } else {
+      ctx_check_sat(g);
+    }
+  }
+}
+
+
 /*
  * Declare a new sort:
  * - name = sort name
@@ -5131,6 +5566,10 @@ void smt2_reset(void) {
 
       reset_named_term_stack(&g->named_bools);
       reset_named_term_stack(&g->named_asserts);
+      g->pending_named_assert = false;
+
+      ivector_reset(&g->sat_assumptions);
+      ivector_reset(&g->ctx_assumptions);
 
       reset_etk_queue(&g->token_queue);
       ivector_reset(&g->token_slices);
@@ -5174,6 +5613,7 @@ void smt2_add_name(int32_t op, term_t t, const char *name) {
     // named assertions (for unsat cores)
     if (op == SMT2_ASSERT && __smt2_globals.produce_unsat_cores) {
       push_named_term(&__smt2_globals.named_asserts, t, clone);
+      __smt2_globals.pending_named_assert = true;
     }
   }
 }
@@ -5196,3 +5636,17 @@ void smt2_add_pattern(int32_t op, term_t t, term_t *p, uint32_t n) {
 void smt2_enable_mcsat(void) {
   __smt2_globals.mcsat = true;
 }
+
+/*
+ * Set the number of portfolio workers
+ */
+void smt2_set_portfolio_size(uint32_t n) {
+  __smt2_globals.portfolio_size = n;
+}
+
+/*
+ * Enable the sat backend
+ */
+void smt2_enable_sat_backend(void) {
+  __smt2_globals.sat_backend = true;
+}
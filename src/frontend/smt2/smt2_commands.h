@@ -135,6 +135,7 @@ enum smt2_opcodes {
   SMT2_GET_ASSIGNMENT,                  // [get-assignment]
   SMT2_GET_PROOF,                       // [get-proof]
   SMT2_GET_UNSAT_CORE,                  // [get-unsat-core]
+  SMT2_GET_UNSAT_ASSUMPTIONS,           // [get-unsat-assumptions]
   SMT2_GET_VALUE,                       // [get-value <term> ... <term> ]
   SMT2_GET_OPTION,                      // [get-option <keyword> ]
   SMT2_GET_INFO,                        // [get-info <keyword> ]
@@ -145,6 +146,7 @@ enum smt2_opcodes {
   SMT2_POP,                             // [pop <numeral> ]
   SMT2_ASSERT,                          // [assert <term> ]
   SMT2_CHECK_SAT,                       // [check-sat ]
+  SMT2_CHECK_SAT_ASSUMING,              // [check-sat-assuming <term> ... <term> ]
   SMT2_DECLARE_SORT,                    // [declare-sort <symbol> <numeral> ]
   SMT2_DEFINE_SORT,                     // [define-sort <symbol> <type-binding> ... <type-binding> <sort> ]
   SMT2_DECLARE_FUN,                     // [declare-fun <symbol> <sort> ... <sort> ]
@@ -189,8 +191,9 @@ enum smt2_opcodes {
  * SMT2 has expressions like (! <term> :named xxx)
  * - if <term> is Boolean, then we must keep track of the pair <term> <name>
  *   to implement the command (get-assignments).
- * - when we support unsat cores, we'll have to also keep track of named
- *   named assertions (i.e. (assert (! <term> :named yyy)))
+ * - if :produce-unsat-cores is true, we also keep track of named
+ *   assertions (i.e. (assert (! <term> :named yyy))). These are not
+ *   asserted in the context but used as assumptions in (check-sat).
  *
  * We keep track of named assertions and named booleans in two stacks
  * of pairs (name, term). These pairs must be removed after (pop ...).
@@ -356,6 +359,12 @@ typedef struct smt2_globals_s {
   bool mcsat;                      // set to true to use the mcsat solver
   mcsat_options_t mcsat_options;   // options for the mcsat solver
 
+  // number of parallel workers for check-sat (1 means no portfolio)
+  uint32_t portfolio_size;
+
+  // use the stand-alone sat solver for bit-blasted problems
+  bool sat_backend;
+
   // exists/forall solver
   bool efmode;                     // true to use the exists_forall solver
   ef_client_t ef_client;
@@ -376,7 +385,7 @@ typedef struct smt2_globals_s {
   bool expand_definitions;    // default = false (not supported)
   bool interactive_mode;      // default = false (not supported)
   bool produce_proofs;        // default = false (not supported)
-  bool produce_unsat_cores;   // default = false (not supported)
+  bool produce_unsat_cores;   // default = false
   bool produce_models;        // default = false
   bool produce_assignments;   // default = false
   uint32_t random_seed;       // default = 0
@@ -406,6 +415,12 @@ typedef struct smt2_globals_s {
   // stacks for named booleans and named assertions
   named_term_stack_t named_bools;
   named_term_stack_t named_asserts;
+  bool pending_named_assert;  // set by smt2_add_name, consumed by the next smt2_assert
+
+  // assumptions from the last (check-sat-assuming ...) + assumptions
+  // given to the context in the last call to check-sat
+  ivector_t sat_assumptions;
+  ivector_t ctx_assumptions;
 
   // token queue + vectors for the get-value command
   etk_queue_t token_queue;
@@ -451,6 +466,19 @@ extern void init_smt2(bool benchmark, uint32_t timeout, bool print_success);
  */
 extern void smt2_enable_mcsat(void);
 
+/*
+ * Set the number of parallel workers used by check-sat
+ * - n must be positive (n = 1 means no portfolio)
+ * - this must be called before the context is created
+ */
+extern void smt2_set_portfolio_size(uint32_t n);
+
+/*
+ * Use the stand-alone sat solver for bit-blasted problems
+ * - this must be called before the context is created
+ */
+extern void smt2_enable_sat_backend(void);
+
 /*
  * Force verbosity level to k
  * - this has the same effect as (set-option :verbosity k)
@@ -538,6 +566,13 @@ extern void smt2_get_proof(void);
 extern void smt2_get_unsat_core(void);
 
 
+/*
+ * Get the unsat assumptions: subset of the assumptions given in the
+ * last call to (check-sat-assuming ...) that is unsat
+ */
+extern void smt2_get_unsat_assumptions(void);
+
+
 /*
  * Get the values of terms in the model
  * - the terms are listed in array a
@@ -616,6 +651,14 @@ extern void smt2_assert(term_t t);
 extern void smt2_check_sat(void);
 
 
+/*
+ * Check satisfiability of the current set of assertions
+ * under assumptions a[0 ... n-1]
+ * - each a[i] must be a Boolean term
+ */
+extern void smt2_check_sat_assuming(uint32_t n, term_t *a);
+
+
 /*
  * Declare a new sort:
  * - name = sort name
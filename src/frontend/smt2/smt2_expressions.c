@@ -72,6 +72,7 @@ void push_smt2_token(etk_queue_t *queue, smt2_token_t tk, const char *str, uint3
   case SMT2_TK_FORALL:
   case SMT2_TK_ASSERT:
   case SMT2_TK_CHECK_SAT:
+  case SMT2_TK_CHECK_SAT_ASSUMING:
   case SMT2_TK_DECLARE_SORT:
   case SMT2_TK_DECLARE_CONST:
   case SMT2_TK_DECLARE_FUN:
@@ -85,6 +86,7 @@ void push_smt2_token(etk_queue_t *queue, smt2_token_t tk, const char *str, uint3
   case SMT2_TK_GET_OPTION:
   case SMT2_TK_GET_PROOF:
   case SMT2_TK_GET_UNSAT_CORE:
+  case SMT2_TK_GET_UNSAT_ASSUMPTIONS:
   case SMT2_TK_GET_VALUE:
   case SMT2_TK_POP:
   case SMT2_TK_PUSH:
@@ -150,6 +152,7 @@ static void pp_smt2_token(yices_pp_t *printer, etoken_t *token) {
   case SMT2_TK_FORALL:
   case SMT2_TK_ASSERT:
   case SMT2_TK_CHECK_SAT:
+  case SMT2_TK_CHECK_SAT_ASSUMING:
   case SMT2_TK_DECLARE_SORT:
   case SMT2_TK_DECLARE_CONST:
   case SMT2_TK_DECLARE_FUN:
@@ -163,6 +166,7 @@ static void pp_smt2_token(yices_pp_t *printer, etoken_t *token) {
   case SMT2_TK_GET_OPTION:
   case SMT2_TK_GET_PROOF:
   case SMT2_TK_GET_UNSAT_CORE:
+  case SMT2_TK_GET_UNSAT_ASSUMPTIONS:
   case SMT2_TK_GET_VALUE:
   case SMT2_TK_POP:
   case SMT2_TK_PUSH:
@@ -23,6 +23,7 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <string.h>
 
 // perfect hash functions generated by gperf
 #include "frontend/smt2/smt2_hash_tokens.h"
@@ -30,6 +31,7 @@
 #include "frontend/smt2/smt2_hash_symbols.h"
 
 #include "frontend/smt2/smt2_lexer.h"
+#include "frontend/smt2/smt2_pipeline.h"
 
 
 /*
@@ -59,6 +61,7 @@ static const char * const smt2_token_string[NUM_SMT2_TOKENS] = {
   "forall",                // SMT2_TK_FORALL
   "assert",                // SMT2_TK_ASSERT
   "check-sat",             // SMT2_TK_CHECK_SAT
+  "check-sat-assuming",    // SMT2_TK_CHECK_SAT_ASSUMING
   "declare-sort",          // SMT2_TK_DECLARE_SORT
   "declare-const",         // SMT2_TK_DECLARE_CONST
   "declare-fun",           // SMT2_TK_DECLARE_FUN
@@ -72,6 +75,7 @@ static const char * const smt2_token_string[NUM_SMT2_TOKENS] = {
   "get-option",            // SMT2_TK_GET_OPTION
   "get-proof",             // SMT2_TK_GET_PROOF
   "get-unsat-core",        // SMT2_TK_GET_UNSAT_CORE
+  "get-unsat-assumptions", // SMT2_TK_GET_UNSAT_ASSUMPTIONS
   "get-value",             // SMT2_TK_GET_VALUE
   "pop",                   // SMT2_TK_POP
   "push",                  // SMT2_TK_PUSH
@@ -435,6 +439,11 @@ int32_t init_smt2_file_lexer(lexer_t *lex, const char *filename) {
   return init_file_lexer(lex, filename);
 }
 
+int32_t init_smt2_file_lexer_mode(lexer_t *lex, const char *filename, reader_mode_t mode) {
+  smt2_activate_default();
+  return init_file_lexer_mode(lex, filename, mode);
+}
+
 void init_smt2_stream_lexer(lexer_t *lex, FILE *f, const char *name) {
   smt2_activate_default();
   init_stream_lexer(lex, f, name);
@@ -588,6 +597,141 @@ static smt2_token_t smt2_read_string_var(lexer_t *lex) {
 
 
 
+/*
+ * Characters that may appear in keywords and simple symbols:
+ * - digits + letters + ~ ! @ $ % ^ & * _ - + = < > . ? /
+ *
+ * NOTE: again, we don't really follow the standard (we can
+ * accept non-ASCII characters, depending on the locale and
+ * how isalnum(c) decides).
+ */
+static inline bool issimple(int c) {
+  if (isalnum(c)) {
+    return true;
+  }
+
+  switch (c) {
+  case '~':
+  case '!':
+  case '@':
+  case '$':
+  case '%':
+  case '^':
+  case '&':
+  case '*':
+  case '_':
+  case '-':
+  case '+':
+  case '=':
+  case '<':
+  case '>':
+  case '.':
+  case '?':
+  case '/':
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Other character classes (as inline functions so that they
+ * can be passed to smt2_scan_chars)
+ */
+static inline bool isdecimal(int c) {
+  return isdigit(c);
+}
+
+static inline bool ishexa(int c) {
+  return isxdigit(c);
+}
+
+static inline bool isbinary(int c) {
+  return c == '0' || c == '1';
+}
+
+
+/*
+ * Maximal number of characters copied from the reader's block in one step
+ */
+#define MAX_SCAN_CHUNK 65536
+
+/*
+ * Add the current character and the sequence of characters in the
+ * class defined by in_class that follows it to the buffer.
+ * - the current character is added unconditionally (it's the 'b' or
+ *   'x' prefix for binary and hexadecimal literals); it must not be '\n'
+ * - return the first character that's not in the class (i.e., the new
+ *   current character)
+ *
+ * For file readers, the characters are copied from the reader's
+ * block in bulk. For other readers, this is the same as appending
+ * one character at a time.
+ */
+static inline int smt2_scan_chars(lexer_t *lex, bool (*in_class)(int)) {
+  reader_t *rd;
+  string_buffer_t *buffer;
+  const char *p;
+  size_t i, n;
+  int c;
+
+  rd = &lex->reader;
+  buffer = lex->buffer;
+  c = reader_current_char(rd);
+
+  assert(c != '\n');
+
+  do {
+    string_buffer_append_char(buffer, c);
+    p = reader_lookahead(rd);
+    n = reader_lookahead_size(rd);
+    if (n > MAX_SCAN_CHUNK) n = MAX_SCAN_CHUNK;
+    i = 0;
+    while (i < n && in_class((unsigned char) p[i])) {
+      i ++;
+    }
+    if (i > 0) {
+      string_buffer_append_chars(buffer, p, i);
+      reader_skip(rd, i);
+    }
+    c = reader_next_char(rd);
+  } while (in_class(c));
+
+  return c;
+}
+
+
+/*
+ * Skip a comment
+ * - the current character must be ';'
+ * - skip all characters until the end of the line or EOF
+ * - return the new current character ('\n' or EOF)
+ */
+static int smt2_skip_comment(reader_t *rd) {
+  const char *p, *q;
+  size_t n;
+  int c;
+
+  assert(reader_current_char(rd) == ';');
+
+  do {
+    p = reader_lookahead(rd);
+    n = reader_lookahead_size(rd);
+    if (n > 0) {
+      q = memchr(p, '\n', n);
+      if (q != NULL) n = q - p;
+      if (n > 0) reader_skip(rd, n);
+    }
+    c = reader_next_char(rd);
+  } while (c != '\n' && c != EOF);
+
+  return c;
+}
+
+
+
 /*
  * Read a binary literal
  * - the buffer must contain '#'
@@ -602,22 +746,15 @@ static smt2_token_t smt2_read_string_var(lexer_t *lex) {
  *   SMT2_TK_INVALID_BINARY if the sequence is empty
  */
 static smt2_token_t smt2_read_binary(lexer_t *lex) {
-  reader_t *rd;
   string_buffer_t *buffer;
-  int c;
   smt2_token_t tk;
 
-  rd = &lex->reader;
   buffer = lex->buffer;
-  c = reader_current_char(rd);
 
   assert(string_buffer_length(buffer) == 1 &&
-         buffer->data[0] == '#' && c == 'b');
+         buffer->data[0] == '#' && reader_current_char(&lex->reader) == 'b');
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (c == '0' || c == '1');
+  smt2_scan_chars(lex, isbinary);
   string_buffer_close(buffer);
 
   tk = SMT2_TK_BINARY;
@@ -643,22 +780,15 @@ static smt2_token_t smt2_read_binary(lexer_t *lex) {
  *   SMT2_TK_INVALID_HEXADECIMAL if the sequence is empty
  */
 static smt2_token_t smt2_read_hexa(lexer_t *lex) {
-  reader_t *rd;
   string_buffer_t *buffer;
-  int c;
   smt2_token_t tk;
 
-  rd = &lex->reader;
   buffer = lex->buffer;
-  c = reader_current_char(rd);
 
   assert(string_buffer_length(buffer) == 1 &&
-         buffer->data[0] == '#' && c == 'x');
+         buffer->data[0] == '#' && reader_current_char(&lex->reader) == 'x');
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (isxdigit(c));
+  smt2_scan_chars(lex, ishexa);
   string_buffer_close(buffer);
 
   tk = SMT2_TK_HEXADECIMAL;
@@ -695,10 +825,7 @@ static smt2_token_t smt2_read_number(lexer_t *lex) {
   assert(string_buffer_length(buffer) == 0 && isdigit(c) && c != '0');
 
   // first sequence of digits
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (isdigit(c));
+  c = smt2_scan_chars(lex, isdecimal);
 
   tk = SMT2_TK_NUMERAL;
   if (c == '.') {
@@ -763,10 +890,7 @@ static smt2_token_t smt2_read_number0(lexer_t *lex) {
      * put all the digits that follow '0' in the buffer
      * to give a nicer error message
      */
-    do {
-      string_buffer_append_char(buffer, c);
-      c = reader_next_char(rd);
-    } while (isdigit(c));
+    c = smt2_scan_chars(lex, isdecimal);
 
     tk = SMT2_TK_INVALID_NUMERAL;
   }
@@ -777,45 +901,6 @@ static smt2_token_t smt2_read_number0(lexer_t *lex) {
 }
 
 
-/*
- * Characters that may appear in keywords and simple symbols:
- * - digits + letters + ~ ! @ $ % ^ & * _ - + = < > . ? /
- *
- * NOTE: again, we don't really follow the standard (we can
- * accept non-ASCII characters, depending on the locale and
- * how isalnum(c) decides).
- */
-static bool issimple(int c) {
-  if (isalnum(c)) {
-    return true;
-  }
-
-  switch (c) {
-  case '~':
-  case '!':
-  case '@':
-  case '$':
-  case '%':
-  case '^':
-  case '&':
-  case '*':
-  case '_':
-  case '-':
-  case '+':
-  case '=':
-  case '<':
-  case '>':
-  case '.':
-  case '?':
-  case '/':
-    return true;
-
-  default:
-    return false;
-  }
-}
-
-
 /*
  * Read a keyword:
  * - the buffer must be empty
@@ -837,10 +922,11 @@ static smt2_token_t smt2_read_keyword(lexer_t *lex) {
 
   assert(string_buffer_length(buffer) == 0 && c == ':');
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (issimple(c));
+  string_buffer_append_char(buffer, c);
+  c = reader_next_char(rd);
+  if (issimple(c)) {
+    c = smt2_scan_chars(lex, issimple);
+  }
   string_buffer_close(buffer);
 
   tk = SMT2_TK_KEYWORD;
@@ -863,22 +949,15 @@ static smt2_token_t smt2_read_keyword(lexer_t *lex) {
  * token id. Otherwise, return SMT2_TK_SYMBOL.
  */
 static smt2_token_t smt2_read_symbol(lexer_t *lex) {
-  reader_t *rd;
   string_buffer_t *buffer;
   const keyword_t *kw;
-  int c;
   smt2_token_t tk;
 
-  rd = &lex->reader;
   buffer = lex->buffer;
-  c = reader_current_char(rd);
 
-  assert(string_buffer_length(buffer) == 0 && issimple(c));
+  assert(string_buffer_length(buffer) == 0 && issimple(reader_current_char(&lex->reader)));
 
-  do {
-    string_buffer_append_char(buffer, c);
-    c = reader_next_char(rd);
-  } while (issimple(c));
+  smt2_scan_chars(lex, issimple);
   string_buffer_close(buffer);
 
   tk = SMT2_TK_SYMBOL;
@@ -960,6 +1039,10 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
   int c;
   smt2_token_t tk;
 
+  if (lex->pipe != NULL) {
+    return next_piped_smt2_token(lex);
+  }
+
   rd = &lex->reader;
   c = reader_current_char(rd);
   buffer = lex->buffer;
@@ -970,9 +1053,7 @@ smt2_token_t next_smt2_token(lexer_t *lex) {
     while (isspace(c)) c = reader_next_char(rd);
     if (c != ';') break;
     // comments: read everything until the end of the line or EOF
-    do {
-      c = reader_next_char(rd);
-    } while (c != '\n' && c != EOF);
+    c = smt2_skip_comment(rd);
   }
 
   // record start of token
@@ -70,6 +70,7 @@ enum smt2_token {
   // Commands
   SMT2_TK_ASSERT,
   SMT2_TK_CHECK_SAT,
+  SMT2_TK_CHECK_SAT_ASSUMING,
   SMT2_TK_DECLARE_SORT,
   SMT2_TK_DECLARE_CONST,
   SMT2_TK_DECLARE_FUN,
@@ -83,6 +84,7 @@ enum smt2_token {
   SMT2_TK_GET_OPTION,
   SMT2_TK_GET_PROOF,
   SMT2_TK_GET_UNSAT_CORE,
+  SMT2_TK_GET_UNSAT_ASSUMPTIONS,
   SMT2_TK_GET_VALUE,
   SMT2_TK_POP,
   SMT2_TK_PUSH,
@@ -290,6 +292,11 @@ typedef enum smt2_symbol smt2_symbol_t;
  */
 extern int32_t init_smt2_file_lexer(lexer_t *lex, const char *filename);
 
+/*
+ * Variant: select the reader's input mode (for testing)
+ */
+extern int32_t init_smt2_file_lexer_mode(lexer_t *lex, const char *filename, reader_mode_t mode);
+
 extern void init_smt2_stream_lexer(lexer_t *lex, FILE *f, const char *name);
 
 static inline void init_smt2_stdin_lexer(lexer_t *lex) {
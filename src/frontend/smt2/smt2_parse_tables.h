@@ -30,7 +30,7 @@
  */
 typedef enum state_s {
   c0, c1, c3, c4, c5, c6, c6a, c8, c9, c9a, c9b,
-  c10, c10a, c10b, c11, c11a, c11b, c11d, c11f, c12, c12b, c13, c14, c15,
+  c10, c10a, c10b, c11, c11a, c11b, c11d, c11f, c12, c12b, c13, c14, c15, c16, c16a,
   a0, a1, v0,
   s0, s1, s2, s3, s4, s5, s6, s7, s8, s10,
   t0, t1, t2, t2a, t2b, t2d, t2e,
@@ -51,9 +51,11 @@ typedef enum actions {
   next_goto_c1,
   empty_command_return,
   check_sat_next_goto_r0,
+  check_sat_assuming_next_goto_c16,
   get_assertions_next_goto_r0,
   get_proof_next_goto_r0,
   get_unsat_core_next_goto_r0,
+  get_unsat_assumptions_next_goto_r0,
   get_assignment_next_goto_r0,
   exit_next_goto_r0,
   push_next_goto_c3,
@@ -99,6 +101,8 @@ typedef enum actions {
   next_push_c12b_goto_t0,
   next_goto_r0,
   push_c12b_goto_t0,
+  next_goto_c16a,
+  push_c16a_goto_t0,
   string_next_goto_r0,
   symbol_next_push_r0_goto_s0,
   symbol_next_push_r0_push_t0_goto_s0,
@@ -213,8 +217,8 @@ typedef enum actions {
  */
 
 // Table sizes
-#define NSTATES 75
-#define BSIZE 276
+#define NSTATES 77
+#define BSIZE 280
 
 // Default values for each state
 static const uint8_t default_value[NSTATES] = {
@@ -242,6 +246,8 @@ static const uint8_t default_value[NSTATES] = {
   error,
   error_symbol_expected,
   error_symbol_expected,
+  error_lp_expected,
+  push_c16a_goto_t0,
   error,
   push_a1_goto_v0,
   error,
@@ -298,13 +304,13 @@ static const uint8_t default_value[NSTATES] = {
 // Base values for each state
 static const uint8_t base[NSTATES] = {
      0,   0,   0,   0,   3,   3,   0,   0,   6,   4,
-    50,  10,   5,   5,  47,   7,  16,  53,  19,  57,
-    59,  56,  56,  58,  68,  68,  78,  98, 108,  71,
-    67,  98,  85,  94, 101, 123, 104, 125, 139, 109,
-   118, 135, 118, 145, 127, 135, 152, 148, 162, 143,
-   163, 164, 162, 166, 171, 176, 160, 179, 177, 188,
-   175, 193, 171, 189, 196, 206, 199, 202, 200, 211,
-   207, 205, 223, 212, 216,
+    52,  10,   5,   5,  49,   7,  16,  55,  19,  59,
+    61,  58,  58,  60,  70,  70,  72,  72,  82, 102,
+   105,  95,  71, 105,  68, 113,  81, 106, 111, 129,
+   145, 115, 119, 122, 122, 124, 142, 143, 161, 143,
+   155, 142, 170, 171, 168, 178, 178, 184, 167, 177,
+   180, 193, 180, 200, 172, 190, 185, 200, 201, 207,
+   201, 216, 216, 207, 217, 210, 225,
 };
 
 // Check table
@@ -313,30 +319,30 @@ static const uint8_t check[BSIZE] = {
      3,   4,   4,   5,   8,   8,  16,  16,  11,  11,
     18,   1,   1,   1,   1,   1,   1,   1,   1,   1,
      1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
-     1,   1,   1,   1,   1,   4,   4,   4,   8,   8,
-     8,  10,  11,  11,  11,  14,  14,  19,  10,  10,
-    20,  17,  17,  21,  22,  22,  23,  23,  24,  25,
-    30,  24,  24,  24,  24,  24,  24,  24,  26,  29,
-    29,  26,  26,  26,  26,  26,  26,  26,  26,  14,
-    14,  14,  10,  10,  10,  17,  17,  17,  27,  31,
-    32,  31,  33,  33,  34,  36,  27,  27,  28,  39,
-    24,  24,  24,  29,  29,  29,  28,  28,  40,  42,
-    26,  26,  26,  28,  35,  37,  35,  44,  37,  37,
-    37,  37,  37,  37,  37,  45,  33,  33,  33,  38,
-    27,  27,  27,  41,  41,  43,  43,  38,  38,  47,
-    28,  28,  28,  49,  38,  38,  38,  38,  38,  38,
-    46,  46,  48,  48,  50,  51,  53,  37,  37,  37,
-    52,  52,  54,  50,  51,  56,  55,  41,  41,  41,
-    58,  38,  38,  38,  55,  55,  62,  57,  57,  59,
-    60,  59,  60,  61,  46,  46,  46,  63,  63,  64,
-    66,  61,  61,  68,  52,  52,  52,  65,  71,  65,
-    67,  67,  69,  73,  69,  70,  70,  74,  55,  55,
-    55,  57,  57,  57,  72,  75,  72,  75,  75,  75,
-    75,  63,  63,  63,  75,  61,  61,  61,  75,  75,
-    75,  75,  75,  75,  67,  67,  67,  75,  75,  70,
-    70,  70,  75,  75,  75,  75,  75,  75,  75,  75,
-    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
-    75,  75,  75,  75,  75,  75,
+     1,   1,   1,   1,   1,   1,   1,   4,   4,   4,
+     8,   8,   8,  10,  11,  11,  11,  14,  14,  19,
+    10,  10,  20,  17,  17,  21,  22,  22,  23,  23,
+    24,  25,  26,  27,  32,  26,  26,  26,  26,  26,
+    26,  26,  28,  34,  36,  28,  28,  28,  28,  28,
+    28,  28,  28,  14,  14,  14,  10,  10,  10,  17,
+    17,  17,  29,  31,  31,  30,  33,  37,  33,  37,
+    29,  29,  38,  30,  30,  41,  26,  26,  26,  42,
+    30,  35,  35,  44,  45,  45,  28,  28,  28,  39,
+    43,  43,  39,  39,  39,  39,  39,  39,  39,  31,
+    31,  31,  46,  47,  49,  40,  29,  29,  29,  30,
+    30,  30,  51,  40,  40,  50,  50,  35,  35,  35,
+    40,  40,  40,  40,  40,  40,  43,  43,  43,  48,
+    48,  52,  53,  39,  39,  39,  54,  54,  55,  56,
+    52,  53,  58,  60,  57,  59,  59,  64,  66,  40,
+    40,  40,  57,  57,  61,  62,  61,  62,  65,  65,
+    63,  67,  68,  67,  70,  48,  48,  48,  63,  63,
+    73,  75,  54,  54,  54,  69,  69,  71,  74,  71,
+    74,  59,  59,  59,  72,  72,  76,  77,  57,  57,
+    57,  77,  77,  77,  65,  65,  65,  77,  77,  77,
+    77,  77,  77,  77,  63,  63,  63,  77,  77,  77,
+    77,  69,  69,  69,  77,  77,  77,  77,  77,  77,
+    72,  72,  72,  77,  77,  77,  77,  77,  77,  77,
+    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
 };
 
 // Value table
@@ -364,6 +370,7 @@ static const uint8_t value[BSIZE] = {
   eval_next_goto_c11b,
   assert_next_push_r0_goto_t0,
   check_sat_next_goto_r0,
+  check_sat_assuming_next_goto_c16,
   declare_sort_next_goto_c8,
   declare_const_next_goto_c14,
   declare_fun_next_goto_c10,
@@ -377,6 +384,7 @@ static const uint8_t value[BSIZE] = {
   get_option_next_goto_c4,
   get_proof_next_goto_r0,
   get_unsat_core_next_goto_r0,
+  get_unsat_assumptions_next_goto_r0,
   get_value_next_goto_c12,
   pop_next_goto_c3,
   push_next_goto_c3,
@@ -409,6 +417,8 @@ static const uint8_t value[BSIZE] = {
   symbol_next_push_r0_goto_s0,
   symbol_next_push_r0_push_t0_goto_s0,
   symbol_next_push_r0_push_t0_goto_s0,
+  next_goto_c16a,
+  next_goto_r0,
   next_goto_a1,
   next_return,
   numeral_next_goto_s4,
@@ -420,8 +430,8 @@ static const uint8_t value[BSIZE] = {
   symbol_next_return,
   symbol_next_return,
   next_goto_a1,
-  symbol_next_goto_s3,
-  symbol_next_goto_s3,
+  next_goto_s6,
+  numeral_next_goto_s8,
   numeral_next_return,
   decimal_next_return,
   hexadecimal_next_return,
@@ -440,35 +450,35 @@ static const uint8_t value[BSIZE] = {
   symbol_next_push_c11f_goto_s0,
   symbol_next_push_c11f_goto_s0,
   next_goto_s1,
+  symbol_next_goto_s3,
+  symbol_next_goto_s3,
+  next_goto_s5,
   next_return,
-  next_goto_s6,
+  next_push_s10_goto_s0,
   numeral_next_goto_s4,
-  symbol_next_goto_s7,
-  symbol_next_goto_s7,
   numeral_next_goto_s8,
-  next_return,
   sort_symbol_next_return,
   sort_symbol_next_return,
-  next_goto_s5,
+  next_return,
+  symbol_next_push_s10_goto_s0,
+  symbol_next_push_s10_goto_s0,
   next_goto_t2a,
   symbol_next_return,
   symbol_next_return,
   symbol_next_return,
-  symbol_next_goto_s3,
-  symbol_next_goto_s3,
-  symbol_next_goto_s3,
-  symbol_next_push_s10_goto_s0,
-  symbol_next_push_s10_goto_s0,
   next_goto_t2b,
+  next_goto_s2,
+  symbol_next_goto_s7,
+  symbol_next_goto_s7,
   next_goto_t2e,
+  next_goto_t2b,
+  next_push_r0_goto_t0,
   symbol_next_return,
   symbol_next_return,
   symbol_next_return,
-  next_goto_s2,
-  next_push_s10_goto_s0,
   next_goto_t1,
-  numeral_next_goto_s8,
-  next_goto_t3a,
+  symbol_next_push_t2d_goto_t0,
+  symbol_next_push_t2d_goto_t0,
   numeral_next_return,
   decimal_next_return,
   hexadecimal_next_return,
@@ -476,99 +486,98 @@ static const uint8_t value[BSIZE] = {
   string_next_return,
   term_symbol_next_return,
   term_symbol_next_return,
+  symbol_next_goto_s3,
+  symbol_next_goto_s3,
+  symbol_next_goto_s3,
+  next_goto_t3a,
   next_goto_t3b,
-  symbol_next_goto_s7,
-  symbol_next_goto_s7,
-  symbol_next_goto_s7,
+  next_goto_t3e,
   next_goto_t6,
   sort_symbol_next_return,
   sort_symbol_next_return,
   sort_symbol_next_return,
-  symbol_next_push_t2d_goto_t0,
-  symbol_next_push_t2d_goto_t0,
-  next_goto_t2b,
-  next_push_r0_goto_t0,
-  symbol_next_push_t8a_goto_t0,
-  symbol_next_push_t8a_goto_t0,
-  next_goto_t3e,
   symbol_next_push_s10_goto_s0,
   symbol_next_push_s10_goto_s0,
   symbol_next_push_s10_goto_s0,
   check_keyword_then_branch,
+  symbol_next_push_t8a_goto_t0,
+  symbol_next_push_t8a_goto_t0,
+  next_goto_t3b,
+  next_push_r0_goto_t0,
+  symbol_next_goto_s7,
+  symbol_next_goto_s7,
+  symbol_next_goto_s7,
   next_goto_t7,
   next_push_t4a_goto_t0,
   next_goto_t5,
   next_goto_t2,
   exists_next_goto_t3,
   forall_next_goto_t3,
+  symbol_next_push_t2d_goto_t0,
+  symbol_next_push_t2d_goto_t0,
+  symbol_next_push_t2d_goto_t0,
   symbol_next_push_t3d_goto_s0,
   symbol_next_push_t3d_goto_s0,
-  next_goto_t3b,
-  next_push_r0_goto_t0,
   next_return,
   next_return,
-  next_push_t4g_goto_t0,
   term_symbol_next_return,
   term_symbol_next_return,
   term_symbol_next_return,
   symbol_next_goto_t4c,
   symbol_next_goto_t4c,
+  next_push_t4g_goto_t0,
   next_goto_t4c,
   check_keyword_then_branch,
   check_keyword_then_branch,
   next_goto_t5b,
-  next_goto_t5a,
-  symbol_next_push_t2d_goto_t0,
-  symbol_next_push_t2d_goto_t0,
-  symbol_next_push_t2d_goto_t0,
   numeral_next_goto_t5d,
+  next_goto_t5a,
+  symbol_next_goto_t5c,
+  symbol_next_goto_t5c,
+  next_goto_t6c,
+  numeral_next_goto_t6e,
   symbol_next_push_t8a_goto_t0,
   symbol_next_push_t8a_goto_t0,
   symbol_next_push_t8a_goto_t0,
   asymbol_next_push_r0_goto_s0,
   asymbol_next_push_r0_goto_s0,
-  next_goto_t6c,
-  symbol_next_goto_t5c,
-  symbol_next_goto_t5c,
   next_push_r0_goto_s0,
   next_goto_t6h,
   numeral_next_goto_t5d,
   next_goto_t6a,
+  symbol_next_goto_t6d,
+  symbol_next_goto_t6d,
   next_goto_t6b,
+  next_push_t6g_goto_s0,
+  next_push_t8a_goto_t0,
+  numeral_next_goto_t6e,
+  numeral_next_goto_t6j,
   symbol_next_push_t3d_goto_s0,
   symbol_next_push_t3d_goto_s0,
   symbol_next_push_t3d_goto_s0,
-  symbol_next_goto_t6d,
-  symbol_next_goto_t6d,
-  numeral_next_goto_t6e,
-  next_push_t8a_goto_t0,
   symbol_next_push_t6g_goto_s0,
   symbol_next_push_t6g_goto_s0,
-  numeral_next_goto_t6j,
+  numeral_next_goto_t7b,
+  next_return,
   symbol_next_goto_t4c,
   symbol_next_goto_t4c,
   symbol_next_goto_t4c,
-  next_push_t6g_goto_s0,
-  numeral_next_goto_t7b,
-  numeral_next_goto_t6e,
   symbol_next_goto_t6i,
   symbol_next_goto_t6i,
   next_push_t8a_goto_t0,
   next_return,
   numeral_next_goto_t6j,
+  numeral_next_goto_t7b,
+  symbol_next_goto_t5c,
+  symbol_next_goto_t5c,
+  symbol_next_goto_t5c,
   symbol_next_goto_t7a,
   symbol_next_goto_t7a,
   next_return,
+  error,
   asymbol_next_push_r0_goto_s0,
   asymbol_next_push_r0_goto_s0,
   asymbol_next_push_r0_goto_s0,
-  symbol_next_goto_t5c,
-  symbol_next_goto_t5c,
-  symbol_next_goto_t5c,
-  next_return,
-  error,
-  numeral_next_goto_t7b,
-  error,
   error,
   error,
   error,
@@ -576,6 +585,12 @@ static const uint8_t value[BSIZE] = {
   symbol_next_goto_t6d,
   symbol_next_goto_t6d,
   error,
+  error,
+  error,
+  error,
+  error,
+  error,
+  error,
   symbol_next_push_t6g_goto_s0,
   symbol_next_push_t6g_goto_s0,
   symbol_next_push_t6g_goto_s0,
@@ -583,23 +598,18 @@ static const uint8_t value[BSIZE] = {
   error,
   error,
   error,
-  error,
-  error,
   symbol_next_goto_t6i,
   symbol_next_goto_t6i,
   symbol_next_goto_t6i,
   error,
   error,
-  symbol_next_goto_t7a,
-  symbol_next_goto_t7a,
-  symbol_next_goto_t7a,
-  error,
-  error,
-  error,
   error,
   error,
   error,
   error,
+  symbol_next_goto_t7a,
+  symbol_next_goto_t7a,
+  symbol_next_goto_t7a,
   error,
   error,
   error,
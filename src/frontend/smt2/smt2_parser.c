@@ -133,6 +133,11 @@ static int32_t smt2_parse(parser_t *parser, state_t start) {
       state = r0;
       goto loop;
 
+    case check_sat_assuming_next_goto_c16:
+      tstack_push_op(tstack, SMT2_CHECK_SAT_ASSUMING, &loc);
+      state = c16;
+      goto loop;
+
     case get_assertions_next_goto_r0:
       tstack_push_op(tstack, SMT2_GET_ASSERTIONS, &loc);
       state = r0;
@@ -148,6 +153,11 @@ static int32_t smt2_parse(parser_t *parser, state_t start) {
       state = r0;
       goto loop;
 
+    case get_unsat_assumptions_next_goto_r0:
+      tstack_push_op(tstack, SMT2_GET_UNSAT_ASSUMPTIONS, &loc);
+      state = r0;
+      goto loop;
+
     case get_assignment_next_goto_r0:
       tstack_push_op(tstack, SMT2_GET_ASSIGNMENT, &loc);
       state = r0;
@@ -408,6 +418,16 @@ static int32_t smt2_parse(parser_t *parser, state_t start) {
       state = t0;
       goto skip_token;
 
+    case next_goto_c16a:
+      state = c16a;
+      goto loop;
+
+    case push_c16a_goto_t0:
+      // one more assumption in (check-sat-assuming ...)
+      parser_push_state(stack, c16a);
+      state = t0;
+      goto skip_token;
+
     case numeral_next_return:
       tstack_push_rational(tstack, tkval(lex), &loc);
       state = parser_pop_state(stack);
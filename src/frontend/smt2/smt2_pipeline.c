@@ -0,0 +1,495 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PIPELINED LEXER FOR SMT2 FILES
+ */
+
+#include "frontend/smt2/smt2_pipeline.h"
+
+#if defined(THREAD_SAFE) && !defined(MINGW)
+
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+
+#include "utils/memalloc.h"
+
+
+/*
+ * Token record:
+ * - token = token code
+ * - tk_pos, tk_line, tk_column = start of the token
+ * - rd_pos, rd_line, rd_column = reader's position after the token
+ * - value = index of the token value in the chunk's char array
+ * - len = length of the value (the value is terminated by '\0')
+ */
+typedef struct tk_record_s {
+  uint64_t tk_pos;
+  uint64_t rd_pos;
+  uint32_t tk_line;
+  uint32_t tk_column;
+  uint32_t rd_line;
+  uint32_t rd_column;
+  uint32_t value;
+  uint32_t len;
+  smt2_token_t token;
+} tk_record_t;
+
+
+/*
+ * Chunk: array of token records + array of characters for
+ * the token values.
+ * - a chunk is full when it contains TK_CHUNK_SIZE tokens
+ *   or more than TK_CHUNK_CHARS characters
+ * - the producer stops if the queue contains MAX_QUEUED_CHUNKS chunks
+ */
+#define TK_CHUNK_SIZE 4096
+#define TK_CHUNK_CHARS 65536
+#define MAX_QUEUED_CHUNKS 16
+
+typedef struct tk_chunk_s tk_chunk_t;
+
+struct tk_chunk_s {
+  tk_chunk_t *next;
+  uint32_t ntokens;
+  uint32_t nchars;
+  uint32_t char_size;
+  char *chars;
+  tk_record_t tk[TK_CHUNK_SIZE];
+};
+
+
+/*
+ * Pipeline:
+ * - lexer = lexer used by the producer thread
+ * - lock + cond: to synchronize producer and consumer
+ * - first/last: queue of full chunks
+ * - free_chunks: list of recycled chunks
+ * - queued = number of chunks in the queue
+ * - waiting: true if the consumer is waiting for a chunk
+ * - stop: set by the consumer to stop the producer
+ * - current = chunk being read by the consumer (or NULL)
+ * - index = index of the next token in current
+ */
+struct token_pipe_s {
+  lexer_t lexer;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  tk_chunk_t *first;
+  tk_chunk_t *last;
+  tk_chunk_t *free_chunks;
+  uint32_t queued;
+  bool waiting;
+  bool stop;
+  tk_chunk_t *current;
+  uint32_t index;
+};
+
+
+
+/*
+ * CHUNKS
+ */
+static tk_chunk_t *new_chunk(void) {
+  tk_chunk_t *c;
+
+  c = (tk_chunk_t *) safe_malloc(sizeof(tk_chunk_t));
+  c->next = NULL;
+  c->ntokens = 0;
+  c->nchars = 0;
+  c->char_size = TK_CHUNK_CHARS;
+  c->chars = (char *) safe_malloc(TK_CHUNK_CHARS);
+
+  return c;
+}
+
+static void delete_chunk_list(tk_chunk_t *c) {
+  tk_chunk_t *next;
+
+  while (c != NULL) {
+    next = c->next;
+    safe_free(c->chars);
+    safe_free(c);
+    c = next;
+  }
+}
+
+static inline bool chunk_is_full(tk_chunk_t *c) {
+  return c->ntokens == TK_CHUNK_SIZE || c->nchars >= TK_CHUNK_CHARS;
+}
+
+/*
+ * Make room for n more characters in c
+ */
+static void chunk_extend_chars(tk_chunk_t *c, uint32_t n) {
+  uint32_t size;
+
+  if (n > UINT32_MAX - c->nchars) {
+    out_of_memory();
+  }
+  n += c->nchars;
+  size = c->char_size;
+  if (size < n) {
+    size += size >> 1;
+    if (size < n) size = n;
+    c->chars = (char *) safe_realloc(c->chars, size);
+    c->char_size = size;
+  }
+}
+
+/*
+ * Store the current token of lex into c
+ * - tk = token code
+ * - c must not be full
+ */
+static void chunk_add_token(tk_chunk_t *c, lexer_t *lex, smt2_token_t tk) {
+  tk_record_t *r;
+  uint32_t n;
+
+  assert(c->ntokens < TK_CHUNK_SIZE);
+
+  n = string_buffer_length(lex->buffer);
+  chunk_extend_chars(c, n+1);
+
+  r = c->tk + c->ntokens;
+  r->tk_pos = lex->tk_pos;
+  r->rd_pos = lex->reader.pos;
+  r->tk_line = lex->tk_line;
+  r->tk_column = lex->tk_column;
+  r->rd_line = lex->reader.line;
+  r->rd_column = lex->reader.column;
+  r->value = c->nchars;
+  r->len = n;
+  r->token = tk;
+
+  memcpy(c->chars + c->nchars, lex->buffer->data, n);
+  c->chars[c->nchars + n] = '\0';
+  c->nchars += n+1;
+  c->ntokens ++;
+}
+
+
+
+/*
+ * PRODUCER SIDE
+ */
+
+/*
+ * Get an empty chunk
+ * - wait if the queue is full
+ * - return NULL if the consumer asked to stop
+ */
+static tk_chunk_t *get_empty_chunk(token_pipe_t *pipe) {
+  tk_chunk_t *c;
+  bool stop;
+
+  pthread_mutex_lock(&pipe->lock);
+  while (pipe->queued >= MAX_QUEUED_CHUNKS && !pipe->stop) {
+    pthread_cond_wait(&pipe->cond, &pipe->lock);
+  }
+  stop = pipe->stop;
+  c = pipe->free_chunks;
+  if (!stop && c != NULL) {
+    pipe->free_chunks = c->next;
+  }
+  pthread_mutex_unlock(&pipe->lock);
+
+  if (stop) {
+    return NULL;
+  }
+  if (c == NULL) {
+    c = new_chunk();
+  }
+  if (c != NULL) {
+    c->next = NULL;
+    c->ntokens = 0;
+    c->nchars = 0;
+  }
+
+  return c;
+}
+
+/*
+ * Add c to the queue
+ * - if sync is true, wait until the consumer has read all the tokens
+ *   and is waiting for more.
+ * - return false if the consumer asked to stop
+ */
+static bool publish_chunk(token_pipe_t *pipe, tk_chunk_t *c, bool sync) {
+  bool ok;
+
+  pthread_mutex_lock(&pipe->lock);
+  if (pipe->last == NULL) {
+    pipe->first = c;
+  } else {
+    pipe->last->next = c;
+  }
+  pipe->last = c;
+  pipe->queued ++;
+  pthread_cond_broadcast(&pipe->cond);
+
+  if (sync) {
+    while (!pipe->stop && !(pipe->queued == 0 && pipe->waiting)) {
+      pthread_cond_wait(&pipe->cond, &pipe->lock);
+    }
+  }
+  ok = !pipe->stop;
+  pthread_mutex_unlock(&pipe->lock);
+
+  return ok;
+}
+
+
+/*
+ * Lexing thread: read tokens until the end of the input
+ * - depth = number of open parentheses
+ * - in_set_info: true if we're in a top-level set-info command
+ */
+static void *smt2_lexing_thread(void *arg) {
+  token_pipe_t *pipe;
+  lexer_t *lex;
+  tk_chunk_t *chunk;
+  smt2_token_t tk, prev;
+  uint32_t depth;
+  bool in_set_info, sync;
+  sigset_t mask;
+
+  // signals must be handled by the main thread
+  sigfillset(&mask);
+  pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+  pipe = arg;
+  lex = &pipe->lexer;
+  depth = 0;
+  in_set_info = false;
+  prev = SMT2_TK_EOS;
+
+  chunk = get_empty_chunk(pipe);
+  while (chunk != NULL) {
+    tk = next_smt2_token(lex);
+    chunk_add_token(chunk, lex, tk);
+
+    sync = false;
+    switch (tk) {
+    case SMT2_TK_LP:
+      depth ++;
+      break;
+
+    case SMT2_TK_RP:
+      if (depth > 0) {
+        depth --;
+        if (depth == 0 && in_set_info) {
+          // end of set-info: it may change the lexer's behavior
+          in_set_info = false;
+          sync = true;
+        }
+      }
+      break;
+
+    case SMT2_TK_SET_INFO:
+      if (depth == 1 && prev == SMT2_TK_LP) {
+        in_set_info = true;
+      }
+      break;
+
+    default:
+      break;
+    }
+    prev = tk;
+
+    if (tk == SMT2_TK_EOS || sync || chunk_is_full(chunk)) {
+      if (!publish_chunk(pipe, chunk, sync) || tk == SMT2_TK_EOS) break;
+      chunk = get_empty_chunk(pipe);
+    }
+  }
+
+  return NULL;
+}
+
+
+
+/*
+ * CONSUMER SIDE
+ */
+
+/*
+ * Get the next chunk from the queue
+ * - the current chunk is recycled
+ */
+static tk_chunk_t *next_chunk(token_pipe_t *pipe) {
+  tk_chunk_t *c;
+
+  pthread_mutex_lock(&pipe->lock);
+  c = pipe->current;
+  if (c != NULL) {
+    c->next = pipe->free_chunks;
+    pipe->free_chunks = c;
+    pipe->current = NULL;
+  }
+
+  if (pipe->queued == 0) {
+    pipe->waiting = true;
+    pthread_cond_broadcast(&pipe->cond);
+    do {
+      pthread_cond_wait(&pipe->cond, &pipe->lock);
+    } while (pipe->queued == 0);
+    pipe->waiting = false;
+  }
+
+  c = pipe->first;
+  pipe->first = c->next;
+  if (pipe->first == NULL) {
+    pipe->last = NULL;
+  }
+  pipe->queued --;
+  pthread_cond_broadcast(&pipe->cond);
+  pthread_mutex_unlock(&pipe->lock);
+
+  c->next = NULL;
+
+  return c;
+}
+
+
+smt2_token_t next_piped_smt2_token(lexer_t *lex) {
+  token_pipe_t *pipe;
+  tk_chunk_t *c;
+  tk_record_t *r;
+  string_buffer_t *buffer;
+
+  pipe = lex->pipe;
+  assert(pipe != NULL);
+
+  c = pipe->current;
+  if (c == NULL || pipe->index == c->ntokens) {
+    c = next_chunk(pipe);
+    pipe->current = c;
+    pipe->index = 0;
+  }
+
+  assert(pipe->index < c->ntokens);
+  r = c->tk + pipe->index;
+  if (r->token != SMT2_TK_EOS) {
+    // the EOS token is returned forever
+    pipe->index ++;
+  }
+
+  buffer = lex->buffer;
+  string_buffer_reset(buffer);
+  string_buffer_append_chars(buffer, c->chars + r->value, r->len);
+  string_buffer_close(buffer);
+
+  lex->token = r->token;
+  lex->tk_pos = r->tk_pos;
+  lex->tk_line = r->tk_line;
+  lex->tk_column = r->tk_column;
+  lex->reader.pos = r->rd_pos;
+  lex->reader.line = r->rd_line;
+  lex->reader.column = r->rd_column;
+
+  return r->token;
+}
+
+
+
+/*
+ * INITIALIZATION AND DELETION
+ */
+int32_t init_smt2_pipelined_lexer(lexer_t *lex, const char *filename) {
+  token_pipe_t *pipe;
+
+  pipe = (token_pipe_t *) safe_malloc(sizeof(token_pipe_t));
+  if (init_smt2_file_lexer(&pipe->lexer, filename) < 0) {
+    safe_free(pipe);
+    return -1;
+  }
+
+  pthread_mutex_init(&pipe->lock, NULL);
+  pthread_cond_init(&pipe->cond, NULL);
+  pipe->first = NULL;
+  pipe->last = NULL;
+  pipe->free_chunks = NULL;
+  pipe->queued = 0;
+  pipe->waiting = false;
+  pipe->stop = false;
+  pipe->current = NULL;
+  pipe->index = 0;
+
+  // the main lexer never reads anything
+  init_smt2_string_lexer(lex, "", filename);
+  lex->pipe = pipe;
+
+  if (pthread_create(&pipe->thread, NULL, smt2_lexing_thread, pipe) != 0) {
+    lex->pipe = NULL;
+    close_lexer(lex);
+    close_lexer(&pipe->lexer);
+    pthread_cond_destroy(&pipe->cond);
+    pthread_mutex_destroy(&pipe->lock);
+    safe_free(pipe);
+    return -2;
+  }
+
+  return 0;
+}
+
+
+void close_smt2_pipelined_lexer(lexer_t *lex) {
+  token_pipe_t *pipe;
+
+  pipe = lex->pipe;
+  if (pipe != NULL) {
+    pthread_mutex_lock(&pipe->lock);
+    pipe->stop = true;
+    pthread_cond_broadcast(&pipe->cond);
+    pthread_mutex_unlock(&pipe->lock);
+    pthread_join(pipe->thread, NULL);
+
+    delete_chunk_list(pipe->first);
+    delete_chunk_list(pipe->free_chunks);
+    delete_chunk_list(pipe->current);
+    close_lexer(&pipe->lexer);
+    pthread_cond_destroy(&pipe->cond);
+    pthread_mutex_destroy(&pipe->lock);
+    safe_free(pipe);
+    lex->pipe = NULL;
+  }
+  close_lexer(lex);
+}
+
+
+#else
+
+/*
+ * No pthreads: pipelining is not supported
+ */
+int32_t init_smt2_pipelined_lexer(lexer_t *lex, const char *filename) {
+  return -2;
+}
+
+void close_smt2_pipelined_lexer(lexer_t *lex) {
+  close_lexer(lex);
+}
+
+smt2_token_t next_piped_smt2_token(lexer_t *lex) {
+  assert(false);
+  return SMT2_TK_EOS;
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PIPELINED LEXER FOR SMT2 FILES
+ *
+ * In pipelined mode, the input file is read and converted to tokens by
+ * a separate thread. The tokens are stored in chunks (compact arrays of
+ * token records + token values) that are passed to the main thread via
+ * a bounded queue. The main thread parses the tokens, builds terms, and
+ * executes commands while the next commands are being lexed.
+ *
+ * The main thread uses a lexer attached to the pipeline: next_smt2_token
+ * gets the tokens from the pipeline instead of reading the input.
+ * Token positions and the reader's line/column are copied from the
+ * producer so that error messages are the same as in the sequential mode.
+ *
+ * The lexer depends on one global flag that can be changed by a
+ * command: (set-info :smt-lib-version 2.5) switches the syntax of
+ * string literals. To make sure this is handled correctly, the producer
+ * stops after every top-level set-info command and waits for the
+ * main thread to have executed it before lexing the rest of the input.
+ *
+ * Pipelining requires pthreads. It's available only if Yices is built
+ * with thread-safety enabled, and not on Windows.
+ */
+
+#ifndef __SMT2_PIPELINE_H
+#define __SMT2_PIPELINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "frontend/smt2/smt2_lexer.h"
+
+
+/*
+ * Check whether pipelining is supported
+ */
+#if defined(THREAD_SAFE) && !defined(MINGW)
+static inline bool smt2_pipeline_supported(void) {
+  return true;
+}
+#else
+static inline bool smt2_pipeline_supported(void) {
+  return false;
+}
+#endif
+
+
+/*
+ * Initialize lex as a pipelined lexer for the given file
+ * - this opens the file and starts the lexing thread
+ * - return -1 if the file can't be opened, -2 if pipelining is not
+ *   supported or the thread can't be created, 0 otherwise
+ * - if the result is negative, lex is not initialized
+ */
+extern int32_t init_smt2_pipelined_lexer(lexer_t *lex, const char *filename);
+
+/*
+ * Close a pipelined lexer:
+ * - stop the lexing thread and delete the pipeline
+ * - close lex
+ */
+extern void close_smt2_pipelined_lexer(lexer_t *lex);
+
+/*
+ * Get the next token from the pipeline: this is called by
+ * next_smt2_token if lex->pipe is non-NULL.
+ * - this sets lex->token, the token position, the token value
+ *   in lex->buffer, and the reader's position.
+ */
+extern smt2_token_t next_piped_smt2_token(lexer_t *lex);
+
+
+#endif /* __SMT2_PIPELINE_H */
@@ -826,6 +826,21 @@ static void eval_smt2_get_unsat_core(tstack_t *stack, stack_elem_t *f, uint32_t
 }
 
 
+/*
+ * [get-unsat-assumptions]
+ */
+static void check_smt2_get_unsat_assumptions(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  check_op(stack, SMT2_GET_UNSAT_ASSUMPTIONS);
+  check_size(stack, n == 0);
+}
+
+static void eval_smt2_get_unsat_assumptions(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  smt2_get_unsat_assumptions();
+  tstack_pop_frame(stack);
+  no_result(stack);
+}
+
+
 /*
  * [get-value <term> .... <term>]
  */
@@ -1026,6 +1041,28 @@ static void eval_smt2_check_sat(tstack_t *stack, stack_elem_t *f, uint32_t n) {
 }
 
 
+/*
+ * [check-sat-assuming <term> ... <term>]
+ */
+static void check_smt2_check_sat_assuming(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  check_op(stack, SMT2_CHECK_SAT_ASSUMING);
+}
+
+static void eval_smt2_check_sat_assuming(tstack_t *stack, stack_elem_t *f, uint32_t n) {
+  term_t *a;
+  uint32_t i;
+
+  a = get_aux_buffer(stack, n);
+  for (i=0; i<n; i++) {
+    a[i] = get_term(stack, f + i);
+  }
+  smt2_check_sat_assuming(n, a);
+
+  tstack_pop_frame(stack);
+  no_result(stack);
+}
+
+
 /*
  * [declare-sort <symbol> <numeral>]
  */
@@ -2316,6 +2353,7 @@ void init_smt2_tstack(tstack_t *stack) {
   tstack_add_op(stack, SMT2_GET_ASSIGNMENT, false, eval_smt2_get_assignment, check_smt2_get_assignment);
   tstack_add_op(stack, SMT2_GET_PROOF, false, eval_smt2_get_proof, check_smt2_get_proof);
   tstack_add_op(stack, SMT2_GET_UNSAT_CORE, false, eval_smt2_get_unsat_core, check_smt2_get_unsat_core);
+  tstack_add_op(stack, SMT2_GET_UNSAT_ASSUMPTIONS, false, eval_smt2_get_unsat_assumptions, check_smt2_get_unsat_assumptions);
   tstack_add_op(stack, SMT2_GET_VALUE, false, eval_smt2_get_value, check_smt2_get_value);
   tstack_add_op(stack, SMT2_GET_OPTION, false, eval_smt2_get_option, check_smt2_get_option);
   tstack_add_op(stack, SMT2_GET_INFO, false, eval_smt2_get_info, check_smt2_get_info);
@@ -2326,6 +2364,7 @@ void init_smt2_tstack(tstack_t *stack) {
   tstack_add_op(stack, SMT2_POP, false, eval_smt2_pop, check_smt2_pop);
   tstack_add_op(stack, SMT2_ASSERT, false, eval_smt2_assert, check_smt2_assert);
   tstack_add_op(stack, SMT2_CHECK_SAT, false, eval_smt2_check_sat, check_smt2_check_sat);
+  tstack_add_op(stack, SMT2_CHECK_SAT_ASSUMING, false, eval_smt2_check_sat_assuming, check_smt2_check_sat_assuming);
   tstack_add_op(stack, SMT2_DECLARE_SORT, false, eval_smt2_declare_sort, check_smt2_declare_sort);
   tstack_add_op(stack, SMT2_DEFINE_SORT, false, eval_smt2_define_sort, check_smt2_define_sort);
   tstack_add_op(stack, SMT2_DECLARE_FUN, false, eval_smt2_declare_fun, check_smt2_declare_fun);
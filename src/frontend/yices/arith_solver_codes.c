@@ -36,6 +36,7 @@ static const char * const arith_solver_names[NUM_ARITH_SOLVER_NAMES] = {
   "auto",
   "floyd-warshall",
   "simplex",
+  "sparse-idl",
 };
 
 
@@ -47,6 +48,7 @@ static const arith_code_t arith_code[NUM_ARITH_SOLVER_NAMES] = {
   ARITH_AUTO,
   ARITH_FLOYD_WARSHALL,
   ARITH_SIMPLEX,
+  ARITH_SPARSE_IDL,
 };
 
 
@@ -31,6 +31,7 @@ typedef enum {
   ARITH_SIMPLEX,
   ARITH_FLOYD_WARSHALL,
   ARITH_AUTO,
+  ARITH_SPARSE_IDL,
   ARITH_UNKNOWN, // error codes
 } arith_code_t;
 
@@ -41,7 +42,7 @@ typedef enum {
 
 /*
  * Convert a name to an arith_code:
- * - the valid names are "simplex", "floyd-warshall", or "auto"
+ * - the valid names are "simplex", "floyd-warshall", "sparse-idl", or "auto"
  * - all lower case
  */
 extern arith_code_t arith_solver_code(const char *arith_name);
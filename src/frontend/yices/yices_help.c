@@ -1576,11 +1576,73 @@ static const help_record_t help_data[] = {
     "The atom (is-int x) is true iff x is an integer.\n",
     NULL },
 
-  // END MARKER: index 158
+  // keep-lbd: index 158
+  { HPARAM,
+    "(set-param keep-lbd [integer])",
+    "Bound on the LBD of learned clauses that are never deleted",
+    "   [integer] must be non-negative\n"
+    "\n"
+    "The LBD of a learned clause is the number of distinct decision levels\n"
+    "among its literals. Learned clauses whose LBD is no more than 'keep-lbd'\n"
+    "are never deleted when the learned-clause database is reduced.\n",
+    NULL },
+
+  // tier2-lbd: index 159
+  { HPARAM,
+    "(set-param tier2-lbd [integer])",
+    "Bound on the LBD of learned clauses kept if recently used",
+    "   [integer] must be non-negative\n"
+    "\n"
+    "Learned clauses whose LBD is no more than 'tier2-lbd' are kept when\n"
+    "the learned-clause database is reduced, provided they were involved in\n"
+    "a conflict since the previous reduction. Other learned clauses are\n"
+    "ranked by LBD and activity and the worse half is deleted.\n",
+    NULL },
+
+  // bv-lazy-blasting: index 160
+  { HPARAM,
+    "(set-param bv-lazy-blasting [boolean])",
+    "Enable/disable lazy bit-blasting of multiplication and division",
+    "If this parameter is true, the bitvector solver does not bit-blast\n"
+    "multiplication, division, and remainder operators before search.\n"
+    "Their circuits are built during search, only when the current\n"
+    "assignment is inconsistent with the operator.\n",
+    NULL },
+
+  // bv-simulation: index 161
+  { HPARAM,
+    "(set-param bv-simulation [integer])",
+    "Number of rounds of random simulation before search",
+    "If this parameter is positive, the bit-blasted circuits are simulated\n"
+    "on random inputs before search (256 input vectors per round).\n"
+    "The best input vector is used to set the preferred polarity of the\n"
+    "boolean variables. Zero disables simulation.\n",
+    NULL },
+
+  // cube-depth: index 162
+  { HPARAM,
+    "(set-param cube-depth [integer])",
+    "Number of splitting variables for cube-and-conquer",
+    "If this parameter is positive and Yices runs with several workers,\n"
+    "a lookahead selects [integer] splitting variables (at most 12) and\n"
+    "the workers solve all assignments to these variables independently.\n"
+    "Zero means that the workers run in portfolio mode.\n",
+    NULL },
+
+  // share-lbd: index 163
+  { HPARAM,
+    "(set-param share-lbd [integer])",
+    "Clause sharing between portfolio workers",
+    "If this parameter is positive and Yices runs with several workers in\n"
+    "portfolio mode, the workers exchange the short learned clauses whose\n"
+    "LBD is at most [integer]. Zero disables clause sharing.\n",
+    NULL },
+
+  // END MARKER: index 164
   { HMISC, NULL, NULL, NULL, NULL },
 };
 
-#define END_HELP_DATA 158
+#define END_HELP_DATA 164
 
 
 
@@ -1947,6 +2009,7 @@ static const help_index_t help_index[] = {
   { "bv-extract", NULL, 80, help_basic },
   { "bv-ge", NULL, 93, help_basic },
   { "bv-gt", NULL, 94, help_basic },
+  { "bv-lazy-blasting", NULL, 160, help_basic },
   { "bv-le", NULL, 95, help_basic },
   { "bv-lt", NULL, 96, help_basic },
   { "bv-lshr", NULL, 78, help_basic },
@@ -1972,6 +2035,7 @@ static const help_index_t help_index[] = {
   { "bv-shift-right1", NULL, 73, help_basic },
   { "bv-shl", NULL, 77, help_basic },
   { "bv-sign-extend", NULL, 83, help_basic },
+  { "bv-simulation", NULL, 161, help_basic },
   { "bv-sle", NULL, 99, help_basic },
   { "bv-slt", NULL, 100, help_basic },
   { "bv-smod", NULL, 89, help_basic },
@@ -1988,6 +2052,7 @@ static const help_index_t help_index[] = {
   { "check", NULL, 5, help_basic },
   { "clause-decay", NULL, 118, help_basic },
   { "commands", "Command Summary", HCOMMAND, help_for_category },
+  { "cube-depth", NULL, 162, help_basic },
   { "d-factor", NULL, 110, help_basic },
   { "d-threshold", NULL, 109, help_basic },
   { "define", "Declare or define a term", 2, help_variant },
@@ -2025,6 +2090,7 @@ static const help_index_t help_index[] = {
   { "is-int", NULL, 157, help_basic },
   { "ite", NULL, 30, help_basic },
   { "keep-ite", NULL, 105, help_basic },
+  { "keep-lbd", NULL, 158, help_basic },
   { "learn-eq", NULL, 104, help_basic },
   { "max-ack", NULL, 123, help_basic },
   { "max-bool-ack", NULL, 124, help_basic },
@@ -2053,6 +2119,7 @@ static const help_index_t help_index[] = {
   { "select", NULL, 36, help_basic },
   { "set-param", NULL, 13, help_basic },
   { "set-timeout", NULL, 18, help_basic },
+  { "share-lbd", NULL, 163, help_basic },
   { "show-implicant", NULL, 145, help_basic },
   { "show-model", NULL, 9, help_basic },
   { "show-param", NULL, 14, help_basic },
@@ -2063,6 +2130,7 @@ static const help_index_t help_index[] = {
   { "simplex-prop", NULL, 131, help_basic },
   { "syntax", syntax_summary, 0, help_special },
   { "tclause-size", NULL, 120, help_basic },
+  { "tier2-lbd", NULL, 159, help_basic },
   { "true", NULL, 39, help_basic },
   { "tuple", NULL, 28, help_basic },
   { "tuple-update", NULL, 37, help_basic },
@@ -134,6 +134,7 @@
  * - arith_name: arithmetic solver to use (option --arith-solver=xxx)
  * - mode_name:  option --mode=xxx
  *   by default, these are NULL
+ * - portfolio: number of parallel workers for check (option --portfolio=xxx)
  *
  * CONTEXT CONFIGURATION
  * - logic_code = code for the logic_name (default is SMT_UNKNNOW)
@@ -161,6 +162,7 @@ static bool timeout_initialized;
 static char *logic_name;
 static char *arith_name;
 static char *mode_name;
+static uint32_t portfolio;
 
 static smt_logic_t logic_code;
 static arith_code_t arith_code;
@@ -218,6 +220,7 @@ enum {
   logic_option,
   arith_option,
   mode_option,
+  portfolio_option,
   version_flag,
   help_flag,
   verbosity_option,
@@ -229,6 +232,7 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "logic", '\0', MANDATORY_STRING, logic_option },
   { "arith-solver", '\0', MANDATORY_STRING, arith_option },
   { "mode", '\0', MANDATORY_STRING, mode_option },
+  { "portfolio", '\0', MANDATORY_INT, portfolio_option },
   { "version", 'V', FLAG_OPTION, version_flag },
   { "help", 'h', FLAG_OPTION, help_flag },
   { "verbosity", 'v', MANDATORY_INT, verbosity_option },
@@ -266,10 +270,11 @@ static void print_help(char *progname) {
          "                             <name> must be an SMT-LIB logic code (e.g., QF_UFLIA)\n"
          "                                    or 'NONE' for propositional logic\n"
          "  --arith-solver=<solver>   Select the arithmetic solver\n"
-         "                             <solver> may be either 'simplex' or 'floyd-warshall' or 'auto'\n"
+         "                             <solver> may be 'simplex', 'floyd-warshall', 'sparse-idl', or 'auto'\n"
          "  --mode=<mode>             Select the usage mode\n"
          "                             <mode> maybe 'one-shot' or 'multi-checks' or 'interactive'\n"
 	 "                                    or 'push-pop' or 'ef'\n"
+         "  --portfolio=<workers>     Run check with several parallel workers (default = 1)\n"
 	 "\n"
 	 "The mode are as follows:\n"
 	 "\n"
@@ -361,6 +366,7 @@ static void process_command_line(int argc, char *argv[]) {
   logic_code = SMT_UNKNOWN;
   arith_code = ARITH_SIMPLEX;
   mode_code = -1; // means not set
+  portfolio = 1;
   efmode = false;
 
   init_cmdline_parser(&parser, options, NUM_OPTIONS, argv, argc);
@@ -424,6 +430,15 @@ static void process_command_line(int argc, char *argv[]) {
         }
         break;
 
+      case portfolio_option:
+	v = elem.i_value;
+	if (v <= 0 || v > MAX_PORTFOLIO_SIZE) {
+	  fprintf(stderr, "%s: the number of workers must be between 1 and %d\n", parser.command_name, MAX_PORTFOLIO_SIZE);
+	  goto bad_usage;
+	}
+	portfolio = v;
+	break;
+
       case version_flag:
         print_version(stdout);
         goto quick_exit;
@@ -464,6 +479,10 @@ static void process_command_line(int argc, char *argv[]) {
       fprintf(stderr, "%s: please specify the logic (either QF_IDL or QF_RDL)\n", parser.command_name);
       goto bad_usage;
     }
+    if (arith_code == ARITH_SPARSE_IDL) {
+      fprintf(stderr, "%s: please specify the logic (QF_IDL)\n", parser.command_name);
+      goto bad_usage;
+    }
     // use default settings
     arch = CTX_ARCH_EGFUNSPLXBV;
     iflag = true;
@@ -475,6 +494,8 @@ static void process_command_line(int argc, char *argv[]) {
       arch = CTX_ARCH_SPLX;
     } else if (arith_code == ARITH_FLOYD_WARSHALL) {
       arch = CTX_ARCH_IFW;
+    } else if (arith_code == ARITH_SPARSE_IDL) {
+      arch = CTX_ARCH_ISDL;
     } else {
       arch = CTX_ARCH_AUTO_IDL;
     }
@@ -487,6 +508,9 @@ static void process_command_line(int argc, char *argv[]) {
       arch = CTX_ARCH_SPLX;
     } else if (arith_code == ARITH_FLOYD_WARSHALL) {
       arch = CTX_ARCH_RFW;
+    } else if (arith_code == ARITH_SPARSE_IDL) {
+      fprintf(stderr, "%s: the sparse-idl solver requires logic QF_IDL\n", parser.command_name);
+      goto bad_usage;
     } else {
       arch = CTX_ARCH_AUTO_RDL;
     }
@@ -522,9 +546,9 @@ static void process_command_line(int argc, char *argv[]) {
    */
   if (mode_code < 0) {
     if (arch == CTX_ARCH_MCSAT) {
-      // PROVISIONAL: MCSAT DOES NOT SUPPORT PUSH-POP YET
-      mode = CTX_MODE_ONECHECK;
-    } else if ((logic_code == QF_IDL || logic_code == QF_RDL) && arch != CTX_ARCH_SPLX) {
+      // MCSAT supports push/pop but not clean interrupts
+      mode = CTX_MODE_PUSHPOP;
+    } else if ((logic_code == QF_IDL || logic_code == QF_RDL) && arch != CTX_ARCH_SPLX && arch != CTX_ARCH_ISDL) {
       // Floyd-Warshall or 'Auto' --> mode must be one-shot
       mode = CTX_MODE_ONECHECK;
     } else if (input_filename != NULL) {
@@ -542,15 +566,14 @@ static void process_command_line(int argc, char *argv[]) {
   } else {
     assert(CTX_MODE_ONECHECK <= mode_code && mode_code <= CTX_MODE_INTERACTIVE);
     mode = (context_mode_t) mode_code;
-    if ((logic_code == QF_IDL || logic_code == QF_RDL) && arch != CTX_ARCH_SPLX) {
+    if ((logic_code == QF_IDL || logic_code == QF_RDL) && arch != CTX_ARCH_SPLX && arch != CTX_ARCH_ISDL) {
       if (mode != CTX_MODE_ONECHECK) {
         fprintf(stderr, "%s: the Floyd-Warshall solvers support only mode='one-shot'\n", parser.command_name);
         goto bad_usage;
       }
     }
-    if (arch == CTX_ARCH_MCSAT && mode_code != CTX_MODE_ONECHECK) {
-      // PROVISIONAL: MCSAT DOESN'T HAVE PUSH-POP YET
-      fprintf(stderr, "%s: the nonlinear solver supports only mode='one-shot'\n", parser.command_name);
+    if (arch == CTX_ARCH_MCSAT && mode_code == CTX_MODE_INTERACTIVE) {
+      fprintf(stderr, "%s: the nonlinear solver does not support mode='interactive'\n", parser.command_name);
       goto bad_usage;
     }
   }
@@ -905,6 +928,7 @@ static void init_ctx(smt_logic_t logic, context_arch_t arch, context_mode_t mode
   context = yices_create_context(logic, arch, mode, iflag, qflag);
   yices_default_params_for_context(context, &parameters);
   save_ctx_params(&ctx_parameters, context);
+  context_set_portfolio_size(context, portfolio);
   if (tracer != NULL) {
     context_set_trace(context, tracer);
   }
@@ -1070,6 +1094,14 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.tclause_size, n);
     break;
 
+  case PARAM_KEEP_LBD:
+    show_pos32_param(param2string[p], parameters.keep_lbd, n);
+    break;
+
+  case PARAM_TIER2_LBD:
+    show_pos32_param(param2string[p], parameters.tier2_lbd, n);
+    break;
+
   case PARAM_DYN_ACK:
     show_bool_param(param2string[p], parameters.use_dyn_ack, n);
     break;
@@ -1146,6 +1178,22 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.max_extensionality, n);
     break;
 
+  case PARAM_BV_LAZY_BLASTING:
+    show_bool_param(param2string[p], parameters.bv_lazy_blasting, n);
+    break;
+
+  case PARAM_BV_SIMULATION:
+    show_pos32_param(param2string[p], parameters.bv_simulation, n);
+    break;
+
+  case PARAM_CUBE_DEPTH:
+    show_pos32_param(param2string[p], parameters.cube_depth, n);
+    break;
+
+  case PARAM_SHARE_LBD:
+    show_pos32_param(param2string[p], parameters.share_lbd, n);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     show_bool_param(param2string[p], ef_client_globals.ef_parameters.flatten_iff, n);
     break;
@@ -1422,6 +1470,20 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_KEEP_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.keep_lbd = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_TIER2_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.tier2_lbd = n;
+      print_ok();
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       parameters.use_dyn_ack = tt;
@@ -1569,6 +1631,34 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_BV_LAZY_BLASTING:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.bv_lazy_blasting = tt;
+      print_ok();
+    }
+    break;
+
+  case PARAM_BV_SIMULATION:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.bv_simulation = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CUBE_DEPTH:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.cube_depth = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_SHARE_LBD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.share_lbd = n;
+      print_ok();
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_client_globals.ef_parameters.flatten_iff = tt;
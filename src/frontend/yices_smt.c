@@ -172,6 +172,7 @@ typedef enum {
   ARITH_SOLVER_AUTOMATIC,
   ARITH_SOLVER_FLOYD_WARSHALL,
   ARITH_SOLVER_SIMPLEX,
+  ARITH_SOLVER_SPARSE_IDL,
 } arith_solver_t;
 
 static arith_solver_t arith_solver;
@@ -262,6 +263,7 @@ typedef enum optid {
   // Arithmetic
   use_floyd_warshall,         // IDL or RDL solver
   use_simplex,                // Simplex solver
+  use_sparse_idl,             // sparse IDL solver
   simplex_eager_lemmas,       // generate simple lemmas eagerly
   simplex_prop_enabled,       // enable row-based propagation
   simplex_prop_threshold,     // max size of rows in propagation table
@@ -333,6 +335,7 @@ static option_desc_t options[NUM_OPTIONS] = {
 
   { "floyd-warshall", '\0', FLAG_OPTION, use_floyd_warshall },
   { "simplex", '\0', FLAG_OPTION, use_simplex },
+  { "sparse-idl", '\0', FLAG_OPTION, use_sparse_idl },
   { "eager-lemmas", '\0', FLAG_OPTION, simplex_eager_lemmas },
   { "simplex-prop", '\0', FLAG_OPTION, simplex_prop_enabled },
   { "prop-threshold", '\0', MANDATORY_INT, simplex_prop_threshold },
@@ -432,6 +435,7 @@ static void yices_help(char *progname) {
          "  Arithmetic:\n"
          "   --floyd-warshall\n"
          "   --simplex\n"
+         "   --sparse-idl\n"
          "   --eager-lemmas\n"
          "   --simplex-prop\n"
          "   --prop-threshold\n"
@@ -541,6 +545,13 @@ static void check_parameters(char *progname) {
   if (opt_set[use_simplex]) {
     arith_solver = ARITH_SOLVER_SIMPLEX;
   }
+  if (opt_set[use_sparse_idl]) {
+    if (arith_solver != ARITH_SOLVER_AUTOMATIC) {
+      fprintf(stderr, "%s: can't use %s with another arithmetic solver\n", progname, opt_name(use_sparse_idl));
+      goto error;
+    }
+    arith_solver = ARITH_SOLVER_SPARSE_IDL;
+  }
 
   // simplex-specific options
   eager_lemmas = opt_set[simplex_eager_lemmas];
@@ -989,6 +1000,7 @@ static void parse_command_line(int argc, char *argv[]) {
       case dyn_boolack_opt:
       case use_floyd_warshall:
       case use_simplex:
+      case use_sparse_idl:
       case simplex_eager_lemmas:
       case simplex_prop_enabled:
       case simplex_adjust_model:
@@ -1288,6 +1300,8 @@ static void print_presearch_stats(void) {
     printf("arithmetic solver       : Simplex\n");
   } else if (context_has_idl_solver(&context)) {
     printf("arithmetic solver       : IDL Floyd-Warshall\n");
+  } else if (context_has_sidl_solver(&context)) {
+    printf("arithmetic solver       : IDL sparse\n");
   } else if (context_has_rdl_solver(&context)) {
     printf("arithmetic solver       : RDL Floyd-Warshall\n");
   }
@@ -1352,6 +1366,8 @@ static void print_options(FILE *f, context_t *ctx) {
       fprintf(f, " --icheck-period=%"PRId32, params.integer_check_period);
     } else if (context_has_rdl_solver(ctx) || context_has_idl_solver(ctx)) {
       fprintf(f, " --floyd-warshall");
+    } else if (context_has_sidl_solver(ctx)) {
+      fprintf(f, " --sparse-idl");
     }
     fprintf(f, "\n");
   }
@@ -1840,6 +1856,9 @@ static int process_benchmark(char *filename) {
       case ARITH_SOLVER_FLOYD_WARSHALL:
         arch = CTX_ARCH_IFW;
         break;
+      case ARITH_SOLVER_SPARSE_IDL:
+        arch = CTX_ARCH_ISDL;
+        break;
       }
       break;
 
@@ -1858,6 +1877,11 @@ static int process_benchmark(char *filename) {
       case ARITH_SOLVER_FLOYD_WARSHALL:
         arch = CTX_ARCH_RFW;
         break;
+      case ARITH_SOLVER_SPARSE_IDL:
+        // the sparse solver is for integer difference logic only
+        // (internalization will fail with FORMULA_NOT_IDL)
+        arch = CTX_ARCH_ISDL;
+        break;
       }
       break;
 
@@ -1898,6 +1922,9 @@ static int process_benchmark(char *filename) {
       case ARITH_SOLVER_FLOYD_WARSHALL:
         arch = CTX_ARCH_IFW;
         break;
+      case ARITH_SOLVER_SPARSE_IDL:
+        arch = CTX_ARCH_ISDL;
+        break;
       }
       break;
 
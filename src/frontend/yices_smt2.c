@@ -36,9 +36,11 @@
 // EXPERIMENT
 #include <locale.h>
 
+#include "api/context_config.h"
 #include "frontend/smt2/smt2_commands.h"
 #include "frontend/smt2/smt2_lexer.h"
 #include "frontend/smt2/smt2_parser.h"
+#include "frontend/smt2/smt2_pipeline.h"
 #include "frontend/smt2/smt2_term_stack.h"
 #include "utils/command_line.h"
 
@@ -57,6 +59,9 @@
  * - interactive: if this flag is true, print a prompt before
  *   parsing commands. Also set the option :print-success to true.
  * - timeout: command-line option
+ * - portfolio: number of parallel workers for check-sat
+ * - sat_backend: use the stand-alone sat solver for bit-blasted problems
+ * - pipeline: lex the input file in a separate thread
  *
  * - filename = name of the input file (NULL means read stdin)
  */
@@ -69,6 +74,9 @@ static bool interactive;
 static bool show_stats;
 static int32_t verbosity;
 static uint32_t timeout;
+static uint32_t portfolio;
+static bool sat_backend;
+static bool pipeline;
 static char *filename;
 
 // mcsat options
@@ -91,6 +99,9 @@ typedef enum optid {
   incremental_opt,        // enable incremental mode
   interactive_opt,        // enable interactive mode
   timeout_opt,            // give a timeout
+  portfolio_opt,          // number of parallel workers
+  sat_backend_opt,        // use the stand-alone sat solver
+  pipeline_opt,           // pipelined lexing
   mcsat_opt,              // enable mcsat
   mcsat_nra_mgcd_opt,     // use the mgcd instead psc in projection
   mcsat_nra_nlsat_opt,    // use the nlsat projection instead of brown single-cell
@@ -108,6 +119,9 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "stats", 's', FLAG_OPTION, show_stats_opt },
   { "verbosity", 'v', MANDATORY_INT, verbosity_opt },
   { "timeout", 't', MANDATORY_INT, timeout_opt },
+  { "portfolio", '\0', MANDATORY_INT, portfolio_opt },
+  { "sat-backend", '\0', FLAG_OPTION, sat_backend_opt },
+  { "pipeline", '\0', FLAG_OPTION, pipeline_opt },
   { "incremental", '\0', FLAG_OPTION, incremental_opt },
   { "interactive", '\0', FLAG_OPTION, interactive_opt },
   { "mcsat", '\0', FLAG_OPTION, mcsat_opt },
@@ -142,6 +156,9 @@ static void print_help(const char *progname) {
 	 "             -v <level>\n"
 	 "    --timeout=<timeout>     Set a timeout in seconds (default = no timeout)\n"
 	 "           -t <timeout>\n"
+	 "    --portfolio=<workers>   Run check-sat with several parallel workers (default = 1)\n"
+	 "    --sat-backend           Use a stand-alone SAT solver for bit-blasted problems\n"
+	 "    --pipeline              Lex the input file in a separate thread\n"
 	 "    --stats, -s             Print statistics once all commands have been processed\n"
 	 "    --incremental           Enable support for push/pop\n"
 	 "    --interactive           Run in interactive mode (ignored if a filename is given)\n"
@@ -180,6 +197,9 @@ static void parse_command_line(int argc, char *argv[]) {
   show_stats = false;
   verbosity = 0;
   timeout = 0;
+  portfolio = 1;
+  sat_backend = false;
+  pipeline = false;
 
   mcsat = false;
   mcsat_nra_mgcd = false;
@@ -245,6 +265,31 @@ static void parse_command_line(int argc, char *argv[]) {
 	timeout = v;
 	break;
 
+      case portfolio_opt:
+	v = elem.i_value;
+	if (v <= 0 || v > MAX_PORTFOLIO_SIZE) {
+	  fprintf(stderr, "%s: the number of workers must be between 1 and %d\n", parser.command_name, MAX_PORTFOLIO_SIZE);
+	  print_usage(parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	portfolio = v;
+	break;
+
+      case sat_backend_opt:
+	sat_backend = true;
+	break;
+
+      case pipeline_opt:
+	if (smt2_pipeline_supported()) {
+	  pipeline = true;
+	} else {
+	  fprintf(stderr, "pipelined parsing is not supported: %s was not compiled with thread-safety enabled\n", parser.command_name);
+	  code = YICES_EXIT_USAGE;
+	  goto exit;
+	}
+	break;
+
       case incremental_opt:
 	incremental = true;
 	break;
@@ -298,13 +343,6 @@ static void parse_command_line(int argc, char *argv[]) {
   }
 
  done:
-  // can't have incremental and mcsat yet
-  if (mcsat && incremental) {
-    fprintf(stderr, "incremental mode is not supported by the mcsat solver\n");
-    code = YICES_EXIT_USAGE;
-    goto exit;
-  }
-
   // force interactive to false if there's a filename
   if (filename != NULL) {
     interactive = false;
@@ -470,7 +508,16 @@ int main(int argc, char *argv[]) {
 
   if (filename != NULL) {
     // read from file
-    if (init_smt2_file_lexer(&lexer, filename) < 0) {
+    if (pipeline) {
+      code = init_smt2_pipelined_lexer(&lexer, filename);
+      if (code == -2) {
+        fprintf(stderr, "failed to start the lexing thread\n");
+        exit(YICES_EXIT_INTERNAL_ERROR);
+      }
+    } else {
+      code = init_smt2_file_lexer(&lexer, filename);
+    }
+    if (code < 0) {
       perror(filename);
       exit(YICES_EXIT_FILE_NOT_FOUND);
     }
@@ -498,6 +545,10 @@ int main(int argc, char *argv[]) {
   }
 
   setup_mcsat();
+  smt2_set_portfolio_size(portfolio);
+  if (sat_backend) {
+    smt2_enable_sat_backend();
+  }
 
   while (smt2_active()) {
     if (interactive) {
@@ -522,7 +573,11 @@ int main(int argc, char *argv[]) {
 
   delete_pvector(&trace_tags);
   delete_parser(&parser);
-  close_lexer(&lexer);
+  if (pipeline) {
+    close_smt2_pipelined_lexer(&lexer);
+  } else {
+    close_lexer(&lexer);
+  }
   delete_tstack(&stack);
   delete_smt2();
   yices_exit();
@@ -486,6 +486,8 @@ static void print_options(FILE *f, context_t *ctx) {
       fprintf(f, " --icheck-period=%"PRId32, params.integer_check_period);
     } else if (context_has_rdl_solver(ctx) || context_has_idl_solver(ctx)) {
       fprintf(f, " --floyd-warshall");
+    } else if (context_has_sidl_solver(ctx)) {
+      fprintf(f, " --sparse-idl");
     }
     fprintf(f, "\n");
   }
@@ -118,6 +118,11 @@ __YICES_DLLSPEC__ extern int32_t yices_has_mcsat(void);
 /*
  * This function must be called before anything else to initialize
  * internal data structures.
+ *
+ * If the library was configured with --enable-thread-safety, then
+ * yices_init must be called once, before any thread uses the API.
+ * After that, the API functions can be called from several threads.
+ * Each thread has its own error report.
  */
 __YICES_DLLSPEC__ extern void yices_init(void);
 
@@ -2585,6 +2590,83 @@ __YICES_DLLSPEC__ extern void yices_garbage_collect(const term_t t[], uint32_t n
                                                     int32_t keep_named);
 
 
+/*
+ * Young collection: cheaper variant of yices_garbage_collect.
+ *
+ * A term or type is young if it was created after the last call to
+ * the garbage collector (either yices_garbage_collect or this function).
+ * All other terms and types are old.
+ *
+ * This function uses the same roots as yices_garbage_collect, but it
+ * deletes only the young terms and types that are not reachable from
+ * the roots. All the old terms and types are preserved. Terms and types
+ * never change after they're created so an old term can't refer to a
+ * young term. The cost of a young collection depends on the number of
+ * young terms and types and on the number of roots, not on the total
+ * number of terms.
+ *
+ * After the call, all the terms and types that remain are old.
+ *
+ * Applications that build many short-lived terms can call this
+ * function often (e.g., after each query) and call yices_garbage_collect
+ * less frequently to delete old terms that are no longer used.
+ */
+__YICES_DLLSPEC__ extern void yices_garbage_collect_young(const term_t t[], uint32_t nt,
+                                                          const type_t tau[], uint32_t ntau,
+                                                          int32_t keep_named);
+
+
+/*
+ * Incremental collection: same result as yices_garbage_collect, but the
+ * work is split into several calls to bound the pause time.
+ *
+ * Each call does a bounded amount of work: it visits about budget terms.
+ * The first call starts a new collection and the call that completes
+ * the collection deletes the dead terms and types. Terms and types can
+ * be created and used normally between two calls.
+ *
+ * The roots are determined as in yices_garbage_collect:
+ * - the roots from contexts, models, and reference counts are
+ *   collected at the start and again at the end of the collection.
+ * - t[0 ... nt-1] and tau[0 ... ntau-1] are added to the roots on every
+ *   call. They must be passed again to the call that completes the
+ *   collection if they must be preserved.
+ * - keep_named is used by the call that completes the collection.
+ *
+ * The call that completes the collection still makes a linear pass over
+ * the term table to delete the dead terms, but it doesn't need to
+ * explore the terms that were already visited.
+ *
+ * A call to yices_garbage_collect completes the incremental collection
+ * in progress (the terms marked so far are preserved). Young collections
+ * can be done while an incremental collection is in progress.
+ *
+ * Return 1 if the collection is complete, 0 if more calls are needed.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_garbage_collect_incremental(const term_t t[], uint32_t nt,
+                                                                   const type_t tau[], uint32_t ntau,
+                                                                   int32_t keep_named, uint32_t budget);
+
+
+/*
+ * Get statistics about the garbage collector
+ * - the statistics are copied into *stats
+ * - see yices_types.h for the meaning of each field
+ */
+__YICES_DLLSPEC__ extern void yices_get_gc_stats(yices_gc_stats_t *stats);
+
+
+/*
+ * Print a report on the memory used by the terms to stream f
+ * - the report shows the number of terms of each kind and the
+ *   memory used by their descriptors, then the size of the term
+ *   table and of its hash table.
+ * - the sizes are in bytes. They are approximate: they don't
+ *   include large rational coefficients or the overhead of malloc.
+ */
+__YICES_DLLSPEC__ extern void yices_print_term_memory(FILE *f);
+
+
 
 
 /****************************
@@ -2602,9 +2684,9 @@ __YICES_DLLSPEC__ extern void yices_garbage_collect(const term_t t[], uint32_t n
  * - mcsat: solver based on the Model-Constructing Satisfiability Calculus
  *
  * The "mcsat" solver is required for formulas that use non-linear
- * arithmetic. Currently the mcsat solver does not support push and
- * pop. If you select "mcsat" as the solver type, no other
- * configuration is necessary.
+ * arithmetic. The mcsat solver supports push and pop, but not the
+ * "interactive" mode. If you select "mcsat" as the solver type, no
+ * other configuration is necessary.
  *
  * If you select "dpllt" as the solver type, then you can define the
  * combination of theory solvers you want to include.
@@ -2663,6 +2745,8 @@ __YICES_DLLSPEC__ extern void yices_garbage_collect(const term_t t[], uint32_t n
  * - array-solver: either NONE, DEFAULT
  * - arith-solver: either NONE, DEFAULT, IFW, RFW, SIMPLEX
  * - mode: either ONE-SHOT, MULTI-CHECKS, PUSH-POP, INTERACTIVE
+ * - portfolio: number of parallel workers used by yices_check_context
+ * - sat-backend: whether to use a stand-alone SAT solver for bit-blasted problems
  *
  * This is done as follows:
  * 1) allocate a configuration descriptor via yices_new_config
@@ -2723,6 +2807,10 @@ __YICES_DLLSPEC__ extern void yices_free_config(ctx_config_t *config);
  *                    |                     |
  *                    | "rfw"               |  solver for RDL, based on Floyd-Warshall
  *                    |                     |
+ *                    | "sparse-idl"        |  solver for IDL, based on incremental
+ *                    |                     |  negative-cycle detection on a sparse graph
+ *                    |                     |  (supports push/pop)
+ *                    |                     |
  *                    | "simplex"           |  solver for linear arithmetic, based on Simplex
  *                    |                     |
  *                    | "default"           |  same as "simplex"
@@ -2739,6 +2827,18 @@ __YICES_DLLSPEC__ extern void yices_free_config(ctx_config_t *config);
  *                    | "LIA"               |  linear integer arithmetic
  *                    | "LRA"               |  linear real arithmetic
  *                    | "LIRA"              |  mixed linear arithmetic (real + integer variables)
+ *   ----------------------------------------------------------------------------------------
+ *    "portfolio"     | "1" to "256"        |  number of parallel searches. If more than one,
+ *                    |                     |  each check runs that many worker processes with
+ *                    |                     |  different search parameters and keeps the first
+ *                    |                     |  definitive answer (default: "1").
+ *                    |                     |  This is ignored by MCSat, on Windows, and in
+ *                    |                     |  the thread-safe build.
+ *   ----------------------------------------------------------------------------------------
+ *    "sat-backend"   | "true" or "false"   |  If true, problems that are purely propositional
+ *                    |                     |  after bit-blasting are solved by a stand-alone
+ *                    |                     |  SAT solver with preprocessing (default: "false").
+ *                    |                     |  This is used only for checks without assumptions.
  *
  *
  *
@@ -3084,6 +3184,54 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_formulas(context_t *ctx, uint32_t
 __YICES_DLLSPEC__ extern smt_status_t yices_check_context(context_t *ctx, const param_t *params);
 
 
+/*
+ * Check satisfiability under assumptions: check whether the assertions
+ * stored in ctx conjoined with the n formulas t[0 ... n-1] are satisfiable.
+ * - params is an optional structure to store heuristic parameters
+ *   (as in yices_check_context)
+ * - all t[i]'s must be valid boolean terms
+ *
+ * The assumptions are not asserted: they are used only for this call.
+ * Unlike push/assert/check/pop, this keeps the learned clauses and the
+ * internalization of the assertions from one call to the next.
+ *
+ * The function returns the same codes as yices_check_context. If it
+ * returns STATUS_UNSAT, then an unsat core can be obtained by calling
+ * yices_get_unsat_core. If the assertions alone are satisfiable, then
+ * the status is reset by the next call to yices_assert_formula,
+ * yices_check_context, yices_push, or yices_pop.
+ *
+ * Error report:
+ * - if one t[i] is invalid or not boolean, or can't be processed by the
+ *   context, the error codes are the same as for yices_assert_formula
+ * - if ctx's status is SEARCHING or INTERRUPTED, or if ctx uses MCSAT
+ *   code = CTX_INVALID_OPERATION or CTX_OPERATION_NOT_SUPPORTED
+ *
+ * In case of error, the function returns STATUS_ERROR.
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_with_assumptions(context_t *ctx, const param_t *params,
+                                                                           uint32_t n, const term_t t[]);
+
+
+/*
+ * Unsat core: after a call to yices_check_context_with_assumptions
+ * that returned STATUS_UNSAT, this computes a subset of the assumptions
+ * that's inconsistent with the assertions in ctx.
+ * - v must be initialized by calling yices_init_term_vector
+ * - the core is returned in v (as a subset of the assumptions)
+ * - if the assertions are unsat by themselves, the core is empty
+ *
+ * Return code: 0 if the core was computed, -1 if there's an error.
+ *
+ * Error report:
+ * - if ctx's status is not STATUS_UNSAT
+ *   code = CTX_INVALID_OPERATION
+ * - if ctx uses MCSAT
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_unsat_core(context_t *ctx, term_vector_t *v);
+
+
 /*
  * Add a blocking clause: this is intended to help enumerate different models
  * for a set of assertions.
@@ -3488,6 +3636,79 @@ __YICES_DLLSPEC__ extern void yices_reset_yval_vector(yval_vector_t *v);
 __YICES_DLLSPEC__ extern int32_t yices_get_value(model_t *mdl, term_t t, yval_t *val);
 
 
+/*
+ * Values of terms a[0 ... n-1] as node descriptors.
+ * - a must be an array of n terms
+ * - val must be large enough to store n node descriptors
+ *
+ * If there's no error, the function returns 0 and stores the value of
+ * a[i] in val[i]. Otherwise, it returns -1 and sets the error report.
+ * The error codes are the same as for yices_get_value.
+ *
+ * The values of shared subterms are computed once. This is much faster
+ * than calling yices_get_value n times on large terms.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_value_array(model_t *mdl, uint32_t n, const term_t a[], yval_t val[]);
+
+
+
+/*
+ * BULK EXPORT
+ */
+
+/*
+ * The following functions evaluate n terms a[0 ... n-1] of the same kind
+ * in one call and store the values in flat arrays provided by the caller.
+ * They return -1 if a term is invalid, has the wrong type, or if its
+ * evaluation fails. The error report is as in yices_get_value, with
+ * the following additional error codes:
+ *
+ * If a[i] does not have the expected type:
+ *   code = TYPE_MISMATCH (Boolean terms)
+ *          ARITHTERM_REQUIRED (arithmetic terms)
+ *          BITVECTOR_REQUIRED (bitvector terms)
+ *   term1 = a[i]
+ */
+
+/*
+ * Values of Boolean terms as a bitmap:
+ * - bitmap must be an array of at least ceil(n/8) bytes
+ * - the value of a[i] is bit (i % 8) of bitmap[i/8] (1 means true)
+ * - returns 0 if there's no error
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], uint8_t bitmap[]);
+
+/*
+ * Values of arithmetic terms as 64bit rationals:
+ * - num and den must be arrays of size n
+ * - the value of a[i] is num[i]/den[i]
+ * - if the value of a[i] doesn't fit (or if it's an irrational
+ *   algebraic number), num[i] and den[i] are both set to 0. The value
+ *   can then be obtained using yices_get_mpq_value or yices_get_value.
+ * - returns the number of values that don't fit if there's no error
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_rational64_value_array(model_t *mdl, uint32_t n, const term_t a[],
+                                                                  int64_t num[], uint64_t den[]);
+
+/*
+ * Values of bitvector terms as packed 32bit words:
+ * - all terms in a must have the same type (bitvectors of k bits)
+ * - words must be an array of n * w words where w = ceil(k/32)
+ * - the value of a[i] is stored in words[i * w ... i * w + w - 1],
+ *   least significant word first (the unused high-order bits of the
+ *   last word are 0)
+ * - returns 0 if there's no error
+ *
+ * If the terms don't all have the same type:
+ *   code = INCOMPATIBLE_TYPES
+ *   term1 = a[0]
+ *   type1 = type of a[0]
+ *   term2 = a[i]
+ *   type2 = type of a[i]
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_bv_value_array(model_t *mdl, uint32_t n, const term_t a[], uint32_t words[]);
+
+
 /*
  * Queries on the value of a rational node:
  * - if v->node_tag is YVAL_RATIONAL, the functions below check whether v's value
@@ -283,6 +283,40 @@ typedef enum yices_gen_mode {
 
 
 
+/**************************
+ *  GARBAGE COLLECTION    *
+ *************************/
+
+/*
+ * Statistics on the garbage collector (cf. yices_get_gc_stats)
+ * - full_collections = number of calls to yices_garbage_collect
+ * - young_collections = number of calls to yices_garbage_collect_young
+ * - incremental_collections = number of incremental collections completed
+ * - incremental_steps = number of calls to yices_garbage_collect_incremental
+ * - terms_collected/types_collected = total number of terms and types
+ *   deleted by all collections
+ * - young_terms/young_types = number of terms and types created since
+ *   the last collection
+ * - total_time = total CPU time spent in the collector (in seconds)
+ * - max_pause = CPU time of the longest collection or incremental step (in seconds)
+ * - last_pause = CPU time of the most recent collection or incremental step (in seconds)
+ */
+typedef struct yices_gc_stats_s {
+  uint32_t full_collections;
+  uint32_t young_collections;
+  uint32_t incremental_collections;
+  uint32_t incremental_steps;
+  uint64_t terms_collected;
+  uint64_t types_collected;
+  uint32_t young_terms;
+  uint32_t young_types;
+  double total_time;
+  double max_pause;
+  double last_pause;
+} yices_gc_stats_t;
+
+
+
 /*****************
  *  ERROR CODES  *
  ****************/
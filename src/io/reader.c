@@ -29,7 +29,16 @@
 #include <stdbool.h>
 #include <assert.h>
 
+#if !defined(MINGW)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "io/reader.h"
+#include "utils/memalloc.h"
 
 
 
@@ -74,6 +83,65 @@ static int file_reader_next_char(reader_t *reader) {
 
 
 
+#if !defined(MINGW)
+
+/*
+ * Read the next block from a buffered reader
+ * - return false if the end of the file is reached or on error
+ */
+static bool refill_block(reader_t *reader) {
+  ssize_t n;
+
+  assert(reader->mode == READER_MODE_BUFFERED && reader->next == reader->end);
+
+  do {
+    n = read(reader->input.fd, reader->block, reader->block_size);
+  } while (n < 0 && errno == EINTR);
+
+  if (n <= 0) {
+    return false;
+  }
+
+  reader->next = reader->block;
+  reader->end = reader->block + n;
+  return true;
+}
+
+
+/*
+ * Read and return the next char from a buffered or mapped reader
+ * - update pos, line, column
+ * - reader_next_char handles the common case. This is called
+ *   when current is '\n' or when the block is exhausted.
+ */
+static int block_reader_next_char(reader_t *reader) {
+  assert(reader->is_stream);
+
+  if (reader->current == EOF) {
+    return EOF;
+  }
+
+  if (reader->current == '\n') {
+    reader->line ++;
+    reader->column = 0;
+  }
+
+  if (reader->next < reader->end ||
+      (reader->mode == READER_MODE_BUFFERED && refill_block(reader))) {
+    reader->current = *reader->next;
+    reader->next ++;
+  } else {
+    reader->current = EOF;
+  }
+  reader->pos ++;
+  reader->column ++;
+
+  return reader->current;
+}
+
+#endif
+
+
 /*
  * Read and return the next char from a string reader
  * - update pos, line, column
@@ -108,24 +176,32 @@ static int string_reader_next_char(reader_t *reader) {
 
 
 /*
- * Initialize reader for file of the given name
- * - return -1 if the file could not be open
- *   or 0 otherwise
- * - if the file can't be opened, current is set to EOF,
- *   any subsequent attempt to read will return EOF
- * - if the file can be opened, current is set to '\n'
+ * Common initialization: all fields except read, input, and current
  */
-int32_t init_file_reader(reader_t *reader, const char *filename) {
+static void init_reader_fields(reader_t *reader, const char *name, bool is_stream, reader_mode_t mode) {
+  reader->pos = 0;
+  reader->line = 0;
+  reader->column = 1;
+  reader->is_stream = is_stream;
+  reader->name = name;
+  reader->mode = mode;
+  reader->next = NULL;
+  reader->end = NULL;
+  reader->block = NULL;
+  reader->block_size = 0;
+}
+
+
+/*
+ * Stream reader for a file
+ */
+static int32_t init_stream_file_reader(reader_t *reader, const char *filename) {
   FILE *f;
 
   f = fopen(filename, "r");
+  init_reader_fields(reader, filename, true, READER_MODE_STREAM);
   reader->input.stream = f; // keep it NULL if there's an error
-  reader->pos = 0;
-  reader->line = 0;
-  reader->column = 1;
-  reader->is_stream = true;
   reader->read = file_reader_next_char;
-  reader->name = filename;
 
   if (f == NULL) {
     reader->current = EOF;
@@ -136,19 +212,107 @@ int32_t init_file_reader(reader_t *reader, const char *filename) {
   return 0;
 }
 
+
+#if !defined(MINGW)
+
+/*
+ * Try to map file fd in memory
+ * - return false if that fails (e.g., if fd is not a regular file)
+ */
+static bool map_file(reader_t *reader, int fd) {
+  struct stat st;
+  void *map;
+
+  if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+      (uint64_t) st.st_size > (uint64_t) SIZE_MAX) {
+    return false;
+  }
+
+  map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+#if defined(MADV_SEQUENTIAL)
+  (void) madvise(map, (size_t) st.st_size, MADV_SEQUENTIAL);
+#endif
+
+  reader->block = (unsigned char *) map;
+  reader->block_size = (size_t) st.st_size;
+  reader->next = reader->block;
+  reader->end = reader->block + reader->block_size;
+  return true;
+}
+
+
+/*
+ * Buffered or mapped reader
+ */
+static int32_t init_block_file_reader(reader_t *reader, const char *filename, reader_mode_t mode) {
+  int fd;
+
+  init_reader_fields(reader, filename, true, mode);
+  reader->read = block_reader_next_char;
+
+  do {
+    fd = open(filename, O_RDONLY);
+  } while (fd < 0 && errno == EINTR);
+
+  reader->input.fd = fd;
+  if (fd < 0) {
+    reader->mode = READER_MODE_BUFFERED; // nothing to unmap
+    reader->current = EOF;
+    return -1;
+  }
+
+  if (mode != READER_MODE_MAPPED || !map_file(reader, fd)) {
+    // empty block: the first read will fill it
+    reader->mode = READER_MODE_BUFFERED;
+    reader->block = (unsigned char *) safe_malloc(READER_BLOCK_SIZE);
+    reader->block_size = READER_BLOCK_SIZE;
+    reader->next = reader->block;
+    reader->end = reader->block;
+  }
+
+  reader->current = '\n';
+  return 0;
+}
+
+#endif
+
+
+/*
+ * Initialize reader for file of the given name
+ * - return -1 if the file could not be open
+ *   or 0 otherwise
+ * - if the file can't be opened, current is set to EOF,
+ *   any subsequent attempt to read will return EOF
+ * - if the file can be opened, current is set to '\n'
+ */
+int32_t init_file_reader_mode(reader_t *reader, const char *filename, reader_mode_t mode) {
+#if defined(MINGW)
+  return init_stream_file_reader(reader, filename);
+#else
+  if (mode == READER_MODE_STREAM) {
+    return init_stream_file_reader(reader, filename);
+  }
+  return init_block_file_reader(reader, filename, mode);
+#endif
+}
+
+int32_t init_file_reader(reader_t *reader, const char *filename) {
+  return init_file_reader_mode(reader, filename, READER_MODE_MAPPED);
+}
+
 /*
  * Initialize reader for an already opened stream
  * - set filename to name
  */
 void init_stream_reader(reader_t *reader, FILE *f, const char *name) {
+  init_reader_fields(reader, name, true, READER_MODE_STREAM);
   reader->current = '\n';
   reader->input.stream = f;
-  reader->pos = 0;
-  reader->line = 0;
-  reader->column = 1;
-  reader->is_stream = true;
   reader->read = file_reader_next_char;
-  reader->name = name;
 }
 
 
@@ -156,14 +320,10 @@ void init_stream_reader(reader_t *reader, FILE *f, const char *name) {
  * Initialize reader for string data
  */
 void init_string_reader(reader_t *reader, const char *data, const char *name) {
+  init_reader_fields(reader, name, false, READER_MODE_STREAM);
   reader->current = '\n';
   reader->input.data = data;
-  reader->pos = 0;
-  reader->line = 0;
-  reader->column = 1;
-  reader->is_stream = false;
   reader->read = string_reader_next_char;
-  reader->name = name;
 }
 
 
@@ -183,15 +343,47 @@ void reset_string_reader(reader_t *reader, const char *data) {
 
 
 
+#if !defined(MINGW)
+
+/*
+ * Close a buffered or mapped reader
+ */
+static int close_block_reader(reader_t *reader) {
+  int code;
+
+  code = 0;
+  if (reader->mode == READER_MODE_MAPPED) {
+    if (munmap(reader->block, reader->block_size) < 0) code = EOF;
+  } else {
+    safe_free(reader->block);
+  }
+  reader->block = NULL;
+  reader->next = NULL;
+  reader->end = NULL;
+  if (reader->input.fd >= 0 && close(reader->input.fd) < 0) {
+    code = EOF;
+  }
+  return code;
+}
+
+#endif
+
+
 /*
  * Close reader: return EOF on error, 0 otherwise
  */
 int close_reader(reader_t *reader) {
-  if (reader->is_stream) {
-    return fclose(reader->input.stream);
-  } else {
+  if (! reader->is_stream) {
     return 0;
   }
+
+#if !defined(MINGW)
+  if (reader->mode != READER_MODE_STREAM) {
+    return close_block_reader(reader);
+  }
+#endif
+
+  return fclose(reader->input.stream);
 }
 
 
@@ -19,23 +19,56 @@
 /*
  * File reader: keeps track of filename, position, and current character.
  * String reader: same thing but reads from a null-terminated string.
+ *
+ * File readers (created by init_file_reader) don't use stdio. The file
+ * is mapped in memory if possible, otherwise it's read in large blocks.
+ * Stream readers (e.g., for stdin) use getc so they can be used
+ * interactively.
  */
 
 #ifndef __READER_H
 #define __READER_H
 
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
 
+/*
+ * Input modes for file readers:
+ * - READER_MODE_STREAM: use stdio (getc)
+ * - READER_MODE_BUFFERED: read blocks of READER_BLOCK_SIZE bytes
+ * - READER_MODE_MAPPED: map the whole file in memory (mmap)
+ * READER_MODE_MAPPED falls back to READER_MODE_BUFFERED if the file
+ * can't be mapped (e.g., if it's a pipe). On Windows, all modes are
+ * implemented as READER_MODE_STREAM.
+ */
+typedef enum reader_mode {
+  READER_MODE_STREAM,
+  READER_MODE_BUFFERED,
+  READER_MODE_MAPPED,
+} reader_mode_t;
+
+#define READER_BLOCK_SIZE 65536
+
+
 /*
  * - current = current character
  * - pos, line, column = position in input stream
- * - for file reader, stream = input
+ * - for stream reader, stream = input
  *   for string reader, data = null terminated string.
+ *   for buffered or mapped readers, fd = file descriptor
  * - name = filename or whatever else is given at initialization.
  * - read = read function: get next character
  *   return EOF on last character
+ *
+ * Buffered and mapped readers store the input in a block:
+ * - block = start of the block and block_size = its size
+ *   (for a mapped reader, block_size is the file size)
+ * - the characters that follow current are in next[0 ... end - next - 1]
+ * For the other readers, block, next, and end are NULL.
  */
 typedef struct reader_s reader_t;
 
@@ -51,8 +84,14 @@ struct reader_s {
   union {
     FILE *stream;
     const char *data;
+    int fd;
   } input;
   const char *name;
+  reader_mode_t mode;
+  const unsigned char *next;
+  const unsigned char *end;
+  unsigned char *block;
+  size_t block_size;
 };
 
 
@@ -82,6 +121,12 @@ struct reader_s {
  */
 extern int32_t init_file_reader(reader_t *reader, const char *filename);
 
+/*
+ * Variant: select the input mode explicitly
+ * - init_file_reader is the same as mode = READER_MODE_MAPPED
+ */
+extern int32_t init_file_reader_mode(reader_t *reader, const char *filename, reader_mode_t mode);
+
 /*
  * Initialize reader for an already opened stream
  * - set filename to whatever is given as name
@@ -155,10 +200,57 @@ static inline uint64_t reader_position(reader_t *reader) {
 /*
  * Read one character, update position data and return the new
  * character.
+ * - for buffered and mapped readers, the common case (next character
+ *   already in the block, current character not '\n') is inlined.
  */
 static inline int reader_next_char(reader_t *reader) {
+  int c;
+
+  if (reader->next < reader->end && reader->current != '\n') {
+    c = *reader->next;
+    reader->next ++;
+    reader->current = c;
+    reader->pos ++;
+    reader->column ++;
+    return c;
+  }
   return reader->read(reader);
 }
 
 
+/*
+ * Direct access to the block for lexers:
+ * - reader_lookahead returns a pointer to the characters that follow
+ *   the current character and are already in the block
+ * - reader_lookahead_size returns the number of such characters
+ *   (it's 0 for stream and string readers, and when the block is
+ *   exhausted)
+ */
+static inline const char *reader_lookahead(reader_t *reader) {
+  return (const char *) reader->next;
+}
+
+static inline size_t reader_lookahead_size(reader_t *reader) {
+  return reader->end - reader->next;
+}
+
+
+/*
+ * Skip n characters of the lookahead block and return the new current
+ * character (i.e., the n-th character of the lookahead block).
+ * - n must be positive and no more than reader_lookahead_size(reader)
+ * - the current character and the first n-1 characters of the lookahead
+ *   must not be '\n' (so that line and column remain correct).
+ */
+static inline int reader_skip(reader_t *reader, size_t n) {
+  assert(0 < n && n <= reader_lookahead_size(reader) && reader->current != '\n');
+
+  reader->next += n;
+  reader->current = reader->next[-1];
+  reader->pos += n;
+  reader->column += n;
+  return reader->current;
+}
+
+
 #endif /* __READER_H */
@@ -1372,6 +1372,31 @@ static void print_named_bvpoly64(FILE *f, term_table_t *tbl, bvpoly64_t *p) {
 
 
 
+/*
+ * Memory report
+ */
+void print_term_table_memory(FILE *f, term_table_t *tbl) {
+  term_table_memory_t m;
+  uint64_t total;
+  uint32_t k;
+
+  term_table_memory_usage(tbl, &m);
+
+  fprintf(f, "%-18s %10s %12s\n", "kind", "terms", "bytes");
+  total = 0;
+  for (k=0; k<NUM_TERM_KINDS; k++) {
+    if (m.count[k] > 0) {
+      fprintf(f, "%-18s %10"PRIu32" %12"PRIu64"\n", tag2string[k], m.count[k], m.bytes[k]);
+      total += m.bytes[k];
+    }
+  }
+  fprintf(f, "%-18s %10"PRIu32" %12"PRIu64"\n", "descriptors", tbl->live_terms, total);
+  fprintf(f, "%-18s %10s %12"PRIu64"\n", "descriptor stores", "", m.store_bytes);
+  fprintf(f, "%-18s %10"PRIu32" %12"PRIu64"\n", "term table", tbl->size, m.table_bytes);
+  fprintf(f, "%-18s %10"PRIu32" %12"PRIu64"\n", "hash table", tbl->htbl.size, m.htbl_bytes);
+}
+
+
 /*
  * Print all terms in tbl
  */
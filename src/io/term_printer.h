@@ -88,6 +88,13 @@ extern void print_term_desc(FILE *f, term_table_t *tbl, term_t t);
 extern void print_term_table(FILE *f, term_table_t *tbl);
 
 
+/*
+ * Print the memory used by tbl: one line per term kind
+ * (cf. term_table_memory_usage)
+ */
+extern void print_term_table_memory(FILE *f, term_table_t *tbl);
+
+
 /*
  * Pretty printing:
  * - term expression
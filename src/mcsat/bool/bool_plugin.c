@@ -56,6 +56,12 @@ typedef struct {
   /** Clauses to re-check for propagations. */
   ivector_t clauses_to_repropagate;
 
+  /**
+   * Unit clauses attached above the root level. Their propagation is undone
+   * by a user pop, so we re-attach them after each pop.
+   */
+  ivector_t units;
+
   /** The watch manager for BCP */
   bcp_watch_manager_t wlm;
 
@@ -139,6 +145,7 @@ void bool_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
   init_ivector(&bp->clauses, 0);
   init_ivector(&bp->lemmas, 0);
   init_ivector(&bp->clauses_to_repropagate, 0);
+  init_ivector(&bp->units, 0);
   bcp_watch_manager_construct(&bp->wlm);
   init_ivector(&bp->reason, 0);
   init_ivector(&bp->propagated, 0);
@@ -170,6 +177,7 @@ void bool_plugin_destruct(plugin_t* plugin) {
   delete_ivector(&bp->clauses_to_add);
   delete_ivector(&bp->clauses);
   delete_ivector(&bp->lemmas);
+  delete_ivector(&bp->units);
   bcp_watch_manager_destruct(&bp->wlm);
   delete_ivector(&bp->reason);
   delete_ivector(&bp->propagated);
@@ -286,6 +294,9 @@ bool bool_plugin_trail_literal_compare(void *data, mcsat_literal_t l1, mcsat_lit
   }
 }
 
+static inline
+void bool_plugin_report_conflict(bool_plugin_t* bp, trail_token_t* prop, clause_ref_t c);
+
 /**
  * Add a new clause, normalize and attach to any internal structures. Returns
  * -1 if the clause does not propagate, otherwise returns the level at which
@@ -314,11 +325,13 @@ int bool_plugin_attach_clause(bool_plugin_t* bp, clause_ref_t c_ref, trail_token
     ctx_trace_printf(bp->ctx, "\n");
   }
 
-  // Reduce the size of the clause by removing base level false literals.
-  // These literals are at the end (see trail_compare in the sort)
+  // Reduce the size of the clause by removing root level false literals.
+  // These literals are at the end (see trail_compare in the sort). Literals
+  // that are false at a base level above the root are kept, they become
+  // unassigned again when the user scope is popped.
   i = c->size - 1;
   while (i >= 0) {
-    if (literal_has_value_at_base(c->literals[i], bp->ctx->trail) && literal_is_false(c->literals[i], bp->ctx->trail)) {
+    if (literal_has_value_at_root(c->literals[i], bp->ctx->trail) && literal_is_false(c->literals[i], bp->ctx->trail)) {
       c->size --;
       i --;
     } else {
@@ -332,18 +345,34 @@ int bool_plugin_attach_clause(bool_plugin_t* bp, clause_ref_t c_ref, trail_token
     return -1;
   }
 
-  // If the first literal at base, it must be true at base making the clause
+  // If the first literal at root, it must be true at root making the clause
   // irellevant
-  if (literal_has_value_at_base(c->literals[0], bp->ctx->trail)) {
+  if (literal_has_value_at_root(c->literals[0], bp->ctx->trail)) {
     assert(literal_is_true(c->literals[0], bp->ctx->trail));
     return -1;
   }
 
+  // Units above the root must be re-attached when the user scope is popped
+  if (c->size == 1 && bp->ctx->trail->decision_level_base > 0) {
+    ivector_push(&bp->units, c_ref);
+  }
+
   // If it propagates, add it to the delayed propagation list (even empty clauses)
-  if (c->size == 1) {
+  if (literal_has_value_at_base(c->literals[0], bp->ctx->trail)) {
+    // Value at a base level above the root: the clause is satisfied, or all
+    // the literals are false at base. In both cases, we keep it watched for
+    // after the pop.
+    if (literal_is_false(c->literals[0], bp->ctx->trail)) {
+      bool_plugin_report_conflict(bp, prop, c_ref);
+    }
+    propagation_level = -1;
+  } else if (c->size == 1) {
     propagation_level = bp->ctx->trail->decision_level_base;
   } else if (literal_is_false(c->literals[1], bp->ctx->trail)) {
     propagation_level = trail_get_level(bp->ctx->trail, literal_get_variable(c->literals[1]));
+    if (propagation_level < bp->ctx->trail->decision_level_base) {
+      propagation_level = bp->ctx->trail->decision_level_base;
+    }
   } else {
     propagation_level = -1;
   }
@@ -623,7 +652,7 @@ void bool_plugin_propagate(plugin_t* plugin, trail_token_t* prop) {
             break;
           } else {
             // Literal is false, see if at level 0, to push to back
-            if (literal_get_level(clause->literals[k], trail) == trail->decision_level_base) {
+            if (literal_has_value_at_root(clause->literals[k], trail)) {
               clause->size --;
               clause_swap_literals(clause, k, clause->size);
               -- k;
@@ -823,6 +852,11 @@ void bool_plugin_gc_mark(plugin_t* plugin, gc_info_t* gc_vars) {
       gc_info_mark(&bp->gc_clauses, clause_ref);
     }
 
+    // Units above the root are needed after a pop
+    for (i = 0; i < bp->units.size; ++ i) {
+      gc_info_mark(&bp->gc_clauses, bp->units.data[i]);
+    }
+
     // We also keep the clauses of any propagated literals
     for (i = 0; i < bp->propagated.size; ++ i) {
       var = bp->propagated.data[i];
@@ -858,11 +892,13 @@ void bool_plugin_gc_sweep(plugin_t* plugin, const gc_info_t* gc_vars) {
   gc_info_sweep_ivector(&bp->gc_clauses, &bp->clauses);
   gc_info_sweep_ivector(&bp->gc_clauses, &bp->lemmas);
   gc_info_sweep_ivector(&bp->gc_clauses, &bp->clauses_to_repropagate);
+  gc_info_sweep_ivector(&bp->gc_clauses, &bp->units);
 
   assert(clause_db_is_clause_vector(&bp->clause_db, &bp->clauses_to_add, true));
   assert(clause_db_is_clause_vector(&bp->clause_db, &bp->clauses, true));
   assert(clause_db_is_clause_vector(&bp->clause_db, &bp->lemmas, true));
   assert(clause_db_is_clause_vector(&bp->clause_db, &bp->clauses_to_repropagate, true));
+  assert(clause_db_is_clause_vector(&bp->clause_db, &bp->units, true));
 
   // Watch manager
   bcp_watch_manager_sweep(&bp->wlm, &bp->gc_clauses, gc_vars);
@@ -914,6 +950,11 @@ void bool_plugin_event_notify(plugin_t* plugin, plugin_notify_kind_t kind) {
     // Decay the scores each conflict
     bool_plugin_decay_clause_scores(bp);
     break;
+  case MCSAT_SOLVER_POP:
+    // Re-attach the units, they propagate again at the new base level
+    ivector_add(&bp->clauses_to_add, bp->units.data, bp->units.size);
+    ivector_reset(&bp->units);
+    break;
   default:
     assert(false);
   }
@@ -97,6 +97,12 @@ bool literal_has_value_at_base(mcsat_literal_t l, const mcsat_trail_t* trail) {
   return trail_has_value_at_base(trail, literal_get_variable(l));
 }
 
+/** Return true if the literal has a value in the trail at level 0 */
+static inline
+bool literal_has_value_at_root(mcsat_literal_t l, const mcsat_trail_t* trail) {
+  return trail_has_value_at_root(trail, literal_get_variable(l));
+}
+
 /** Return the value of the literal (must have value != NONE) */
 static inline
 bool literal_get_value(mcsat_literal_t l, const mcsat_trail_t* trail) {
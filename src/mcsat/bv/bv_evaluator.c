@@ -0,0 +1,429 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mcsat/bv/bv_evaluator.h"
+
+#include "terms/terms.h"
+#include "utils/int_hash_sets.h"
+#include "utils/memalloc.h"
+
+void bv_evaluator_construct(bv_evaluator_t* eval, term_table_t* terms, const variable_db_t* var_db, const mcsat_trail_t* trail) {
+  eval->terms = terms;
+  eval->var_db = var_db;
+  eval->trail = trail;
+  init_int_hmap(&eval->cache, 0);
+  eval->values = NULL;
+  eval->size = 0;
+  eval->capacity = 0;
+  eval->override_var = variable_null;
+  eval->override_value = NULL;
+}
+
+void bv_evaluator_destruct(bv_evaluator_t* eval) {
+  uint32_t i;
+  for (i = 0; i < eval->capacity; ++ i) {
+    delete_bvconstant(eval->values + i);
+  }
+  safe_free(eval->values);
+  delete_int_hmap(&eval->cache);
+}
+
+void bv_evaluator_reset(bv_evaluator_t* eval) {
+  int_hmap_reset(&eval->cache);
+  eval->size = 0;
+}
+
+void bv_evaluator_set_override(bv_evaluator_t* eval, variable_t x, const bvconstant_t* v) {
+  eval->override_var = x;
+  eval->override_value = v;
+  bv_evaluator_reset(eval);
+}
+
+/** Get a new value slot (this can move the values around) */
+static
+uint32_t bv_evaluator_new_slot(bv_evaluator_t* eval) {
+  uint32_t i, n;
+
+  if (eval->size == eval->capacity) {
+    n = eval->capacity + eval->capacity / 2 + 8;
+    eval->values = (bvconstant_t*) safe_realloc(eval->values, n * sizeof(bvconstant_t));
+    for (i = eval->capacity; i < n; ++ i) {
+      init_bvconstant(eval->values + i);
+    }
+    eval->capacity = n;
+  }
+
+  return eval->size ++;
+}
+
+bool bv_term_is_interpreted(term_table_t* terms, term_t t) {
+  switch (term_kind(terms, t)) {
+  case BV64_CONSTANT:
+  case BV_CONSTANT:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV64_POLY:
+  case BV_POLY:
+    return true;
+  case POWER_PRODUCT:
+    return is_bitvector_term(terms, t);
+  default:
+    return false;
+  }
+}
+
+bool bv_term_is_atom(term_table_t* terms, term_t t) {
+  switch (term_kind(terms, t)) {
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+  case BIT_TERM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void bv_term_get_leaves(term_table_t* terms, term_t t, ivector_t* leaves) {
+  uint32_t i, n;
+  int_hset_t visited;
+  ivector_t todo;
+
+  init_int_hset(&visited, 0);
+  init_ivector(&todo, 0);
+
+  assert(is_pos_term(t));
+  ivector_push(&todo, t);
+  int_hset_add(&visited, t);
+
+  while (todo.size > 0) {
+    term_t current = ivector_pop2(&todo);
+
+    // Collect the children to visit
+    ivector_t children;
+    init_ivector(&children, 0);
+
+    switch (term_kind(terms, current)) {
+    case BV64_CONSTANT:
+    case BV_CONSTANT:
+      break;
+    case BV_ARRAY:
+    case BV_DIV:
+    case BV_REM:
+    case BV_SDIV:
+    case BV_SREM:
+    case BV_SMOD:
+    case BV_SHL:
+    case BV_LSHR:
+    case BV_ASHR:
+    case BV_EQ_ATOM:
+    case BV_GE_ATOM:
+    case BV_SGE_ATOM: {
+      composite_term_t* desc = composite_term_desc(terms, current);
+      for (i = 0; i < desc->arity; ++ i) {
+        ivector_push(&children, desc->arg[i]);
+      }
+      break;
+    }
+    case BIT_TERM:
+      ivector_push(&children, bit_term_desc(terms, current)->arg);
+      break;
+    case BV64_POLY: {
+      bvpoly64_t* p = bvpoly64_term_desc(terms, current);
+      for (i = 0; i < p->nterms; ++ i) {
+        if (p->mono[i].var != const_idx) {
+          ivector_push(&children, p->mono[i].var);
+        }
+      }
+      break;
+    }
+    case BV_POLY: {
+      bvpoly_t* p = bvpoly_term_desc(terms, current);
+      for (i = 0; i < p->nterms; ++ i) {
+        if (p->mono[i].var != const_idx) {
+          ivector_push(&children, p->mono[i].var);
+        }
+      }
+      break;
+    }
+    case POWER_PRODUCT: {
+      pprod_t* pp = pprod_term_desc(terms, current);
+      assert(is_bitvector_term(terms, current));
+      for (i = 0; i < pp->len; ++ i) {
+        ivector_push(&children, pp->prod[i].var);
+      }
+      break;
+    }
+    default:
+      // A leaf (Boolean constants are not leaves)
+      if (current != bool2term(true)) {
+        ivector_push(leaves, current);
+      }
+      break;
+    }
+
+    // Visit the children (Boolean children of bit arrays can be negated)
+    n = children.size;
+    for (i = 0; i < n; ++ i) {
+      term_t child = unsigned_term(children.data[i]);
+      if (int_hset_add(&visited, child)) {
+        ivector_push(&todo, child);
+      }
+    }
+
+    delete_ivector(&children);
+  }
+
+  delete_ivector(&todo);
+  delete_int_hset(&visited);
+}
+
+/** Get the trail value of a leaf variable */
+static
+const mcsat_value_t* bv_evaluator_get_leaf_value(bv_evaluator_t* eval, term_t t) {
+  variable_t x = variable_db_get_variable_if_exists((variable_db_t*) eval->var_db, t);
+  assert(x != variable_null);
+  assert(x != eval->override_var);
+  assert(trail_has_value(eval->trail, x));
+  return trail_get_value(eval->trail, x);
+}
+
+static
+uint32_t bv_evaluator_eval_term(bv_evaluator_t* eval, term_t t);
+
+/** Value of a constant of at most 64 bits */
+static inline
+uint64_t bv_evaluator_get64(const bvconstant_t* c) {
+  assert(c->bitsize <= 64);
+  return c->bitsize > 32 ? bvconst_get64(c->data) : (uint64_t) c->data[0];
+}
+
+/** Evaluate the two arguments of a binary operator */
+static inline
+void bv_evaluator_eval_binary(bv_evaluator_t* eval, composite_term_t* desc, uint32_t* a1, uint32_t* a2) {
+  assert(desc->arity == 2);
+  *a1 = bv_evaluator_eval_term(eval, desc->arg[0]);
+  *a2 = bv_evaluator_eval_term(eval, desc->arg[1]);
+}
+
+/**
+ * Evaluate the term and return the index of the value. All evaluation of
+ * children is done before the result slot is used, since new slots can move
+ * the value array.
+ */
+static
+uint32_t bv_evaluator_eval_term(bv_evaluator_t* eval, term_t t) {
+  term_table_t* terms = eval->terms;
+  int_hmap_pair_t* find;
+  uint32_t i, n, r, a1, a2;
+  bvconstant_t* v;
+
+  assert(is_pos_term(t));
+  assert(is_bitvector_term(terms, t));
+
+  find = int_hmap_find(&eval->cache, t);
+  if (find != NULL) {
+    return find->val;
+  }
+
+  n = term_bitsize(terms, t);
+
+  switch (term_kind(terms, t)) {
+  case BV64_CONSTANT: {
+    bvconst64_term_t* c = bvconst64_term_desc(terms, t);
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_copy64(eval->values + r, c->bitsize, c->value);
+    break;
+  }
+  case BV_CONSTANT: {
+    bvconst_term_t* c = bvconst_term_desc(terms, t);
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_copy(eval->values + r, c->bitsize, c->data);
+    break;
+  }
+  case BV_ARRAY: {
+    composite_term_t* desc = bvarray_term_desc(terms, t);
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_set_all_zero(eval->values + r, n);
+    for (i = 0; i < desc->arity; ++ i) {
+      if (bv_evaluator_eval_bool(eval, desc->arg[i])) {
+        bvconst_set_bit(eval->values[r].data, i);
+      }
+    }
+    break;
+  }
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR: {
+    term_kind_t kind = term_kind(terms, t);
+    bv_evaluator_eval_binary(eval, composite_term_desc(terms, t), &a1, &a2);
+    r = bv_evaluator_new_slot(eval);
+    v = eval->values + r;
+    bvconstant_set_bitsize(v, n);
+    switch (kind) {
+    case BV_DIV:
+      bvconst_udiv2z(v->data, n, eval->values[a1].data, eval->values[a2].data);
+      break;
+    case BV_REM:
+      bvconst_urem2z(v->data, n, eval->values[a1].data, eval->values[a2].data);
+      break;
+    case BV_SDIV:
+      bvconst_sdiv2z(v->data, n, eval->values[a1].data, eval->values[a2].data);
+      break;
+    case BV_SREM:
+      bvconst_srem2z(v->data, n, eval->values[a1].data, eval->values[a2].data);
+      break;
+    case BV_SMOD:
+      bvconst_smod2z(v->data, n, eval->values[a1].data, eval->values[a2].data);
+      break;
+    case BV_SHL:
+      bvconst_lshl(v->data, eval->values[a1].data, eval->values[a2].data, n);
+      break;
+    case BV_LSHR:
+      bvconst_lshr(v->data, eval->values[a1].data, eval->values[a2].data, n);
+      break;
+    default:
+      assert(kind == BV_ASHR);
+      bvconst_ashr(v->data, eval->values[a1].data, eval->values[a2].data, n);
+      break;
+    }
+    bvconstant_normalize(v);
+    break;
+  }
+  case BV64_POLY: {
+    bvpoly64_t* p = bvpoly64_term_desc(terms, t);
+    uint64_t sum = 0;
+    for (i = 0; i < p->nterms; ++ i) {
+      if (p->mono[i].var == const_idx) {
+        sum += p->mono[i].coeff;
+      } else {
+        a1 = bv_evaluator_eval_term(eval, p->mono[i].var);
+        sum += p->mono[i].coeff * bv_evaluator_get64(eval->values + a1);
+      }
+    }
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_copy64(eval->values + r, n, sum);
+    break;
+  }
+  case BV_POLY: {
+    bvpoly_t* p = bvpoly_term_desc(terms, t);
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_set_all_zero(eval->values + r, n);
+    for (i = 0; i < p->nterms; ++ i) {
+      if (p->mono[i].var == const_idx) {
+        bvconst_add(eval->values[r].data, p->width, p->mono[i].coeff);
+      } else {
+        a1 = bv_evaluator_eval_term(eval, p->mono[i].var);
+        bvconst_addmul(eval->values[r].data, p->width, p->mono[i].coeff, eval->values[a1].data);
+      }
+    }
+    bvconstant_normalize(eval->values + r);
+    break;
+  }
+  case POWER_PRODUCT: {
+    pprod_t* pp = pprod_term_desc(terms, t);
+    r = bv_evaluator_new_slot(eval);
+    bvconstant_set_bitsize(eval->values + r, n);
+    bvconst_set_one(eval->values[r].data, eval->values[r].width);
+    for (i = 0; i < pp->len; ++ i) {
+      a1 = bv_evaluator_eval_term(eval, pp->prod[i].var);
+      bvconst_mulpower(eval->values[r].data, eval->values[r].width, eval->values[a1].data, pp->prod[i].exp);
+    }
+    bvconstant_normalize(eval->values + r);
+    break;
+  }
+  default: {
+    // Leaf: take the value from the trail
+    variable_t x = variable_db_get_variable_if_exists((variable_db_t*) eval->var_db, t);
+    r = bv_evaluator_new_slot(eval);
+    if (x != variable_null && x == eval->override_var) {
+      bvconstant_copy(eval->values + r, n, eval->override_value->data);
+    } else {
+      const mcsat_value_t* x_value = bv_evaluator_get_leaf_value(eval, t);
+      assert(x_value->type == VALUE_BV);
+      bvconstant_copy(eval->values + r, n, x_value->bv_value.data);
+    }
+    break;
+  }
+  }
+
+  assert(eval->values[r].bitsize == n);
+  int_hmap_add(&eval->cache, t, r);
+
+  return r;
+}
+
+const bvconstant_t* bv_evaluator_eval(bv_evaluator_t* eval, term_t t) {
+  uint32_t r = bv_evaluator_eval_term(eval, t);
+  return eval->values + r;
+}
+
+bool bv_evaluator_eval_bool(bv_evaluator_t* eval, term_t t) {
+  term_table_t* terms = eval->terms;
+  term_t atom = unsigned_term(t);
+  uint32_t a1, a2, n;
+  bool value;
+
+  if (atom == bool2term(true)) {
+    value = true;
+  } else {
+    switch (term_kind(terms, atom)) {
+    case BV_EQ_ATOM:
+      bv_evaluator_eval_binary(eval, bveq_atom_desc(terms, atom), &a1, &a2);
+      value = bvconst_eq(eval->values[a1].data, eval->values[a2].data, eval->values[a1].width);
+      break;
+    case BV_GE_ATOM:
+      bv_evaluator_eval_binary(eval, bvge_atom_desc(terms, atom), &a1, &a2);
+      n = eval->values[a1].bitsize;
+      value = bvconst_ge(eval->values[a1].data, eval->values[a2].data, n);
+      break;
+    case BV_SGE_ATOM:
+      bv_evaluator_eval_binary(eval, bvsge_atom_desc(terms, atom), &a1, &a2);
+      n = eval->values[a1].bitsize;
+      value = bvconst_sge(eval->values[a1].data, eval->values[a2].data, n);
+      break;
+    case BIT_TERM: {
+      select_term_t* desc = bit_term_desc(terms, atom);
+      a1 = bv_evaluator_eval_term(eval, desc->arg);
+      value = bvconst_tst_bit(eval->values[a1].data, desc->idx);
+      break;
+    }
+    default: {
+      // Boolean leaf
+      const mcsat_value_t* atom_value = bv_evaluator_get_leaf_value(eval, atom);
+      assert(atom_value->type == VALUE_BOOLEAN);
+      value = atom_value->b;
+      break;
+    }
+    }
+  }
+
+  return is_neg_term(t) ? !value : value;
+}
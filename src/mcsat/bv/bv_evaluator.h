@@ -0,0 +1,104 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BV_EVALUATOR_H_
+#define BV_EVALUATOR_H_
+
+#include "mcsat/variable_db.h"
+#include "mcsat/trail.h"
+
+#include "terms/bv_constants.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+
+/**
+ * Evaluator of bit-vector terms in the current trail. Bit-vector terms are
+ * evaluated bottom-up until reaching the leaves (terms that are not
+ * interpreted by the bit-vector theory, such as variables, function
+ * applications and if-then-else terms, and Boolean terms in bit arrays).
+ * The leaves must all have a variable and a value in the trail.
+ *
+ * Values are cached until the next reset, so the evaluator must be reset
+ * whenever the trail changes.
+ */
+typedef struct {
+
+  /** The term table */
+  term_table_t* terms;
+
+  /** The variable database */
+  const variable_db_t* var_db;
+
+  /** The trail */
+  const mcsat_trail_t* trail;
+
+  /** Map from terms to the index of their value */
+  int_hmap_t cache;
+
+  /** The values */
+  bvconstant_t* values;
+
+  /** Number of values in use */
+  uint32_t size;
+
+  /** Number of allocated values */
+  uint32_t capacity;
+
+  /** Variable to use a different value for (or variable_null) */
+  variable_t override_var;
+
+  /** The value for the override variable */
+  const bvconstant_t* override_value;
+
+} bv_evaluator_t;
+
+/** Construct the evaluator */
+void bv_evaluator_construct(bv_evaluator_t* eval, term_table_t* terms, const variable_db_t* var_db, const mcsat_trail_t* trail);
+
+/** Destruct the evaluator */
+void bv_evaluator_destruct(bv_evaluator_t* eval);
+
+/** Clear the cache */
+void bv_evaluator_reset(bv_evaluator_t* eval);
+
+/**
+ * Evaluate as if variable x had value v (the trail value of x is ignored).
+ * Passing variable_null removes the override. This resets the cache.
+ */
+void bv_evaluator_set_override(bv_evaluator_t* eval, variable_t x, const bvconstant_t* v);
+
+/** Evaluate the bit-vector term t. The returned value is valid until the next reset. */
+const bvconstant_t* bv_evaluator_eval(bv_evaluator_t* eval, term_t t);
+
+/** Evaluate the Boolean term t (an atom, a leaf, or a negation of those). */
+bool bv_evaluator_eval_bool(bv_evaluator_t* eval, term_t t);
+
+/** Returns true if t is a bit-vector term interpreted by the evaluator (i.e. not a leaf) */
+bool bv_term_is_interpreted(term_table_t* terms, term_t t);
+
+/** Returns true if t is a (positive) atom interpreted by the evaluator */
+bool bv_term_is_atom(term_table_t* terms, term_t t);
+
+/**
+ * Collect the leaves of the term t (an interpreted bit-vector term or atom)
+ * into leaves. Leaves are positive terms, and each one is added only once.
+ * Constants are not leaves.
+ */
+void bv_term_get_leaves(term_table_t* terms, term_t t, ivector_t* leaves);
+
+#endif /* BV_EVALUATOR_H_ */
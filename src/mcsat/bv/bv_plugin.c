@@ -0,0 +1,921 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(CYGWIN) || defined(MINGW)
+#ifndef __YICES_DLLSPEC__
+#define __YICES_DLLSPEC__ __declspec(dllexport)
+#endif
+#endif
+
+#include <inttypes.h>
+
+#include "bv_plugin.h"
+#include "bv_evaluator.h"
+
+#include "mcsat/trail.h"
+#include "mcsat/tracing.h"
+#include "mcsat/watch_list_manager.h"
+#include "mcsat/utils/scope_holder.h"
+#include "mcsat/value.h"
+
+#include "utils/int_array_sort2.h"
+
+#include "context/context_types.h"
+#include "terms/terms.h"
+#include "terms/term_manager.h"
+
+/*
+ * The BV plugin assigns values to bit-vector variables directly, without
+ * bit-blasting. Bit-vector atoms (bveq, bvge, bvsge, and bit-select) are
+ * constraints over their leaves: the maximal sub-terms that are not
+ * interpreted by the bit-vector theory (variables, function applications,
+ * if-then-else terms, and Boolean terms in bit-arrays). Interpreted terms
+ * such as bvmul or bvudiv never get a value of their own, they are only
+ * evaluated from the values of the leaves.
+ *
+ * Once all the leaves of an atom have a value, the atom is evaluated and
+ * propagated. If it already has a different value, the conflict is explained
+ * with the word-level lemma
+ *
+ *   (x1 = v1) and ... and (xn = vn) => atom = value
+ *
+ * over the leaves x1, ..., xn and their values v1, ..., vn. When deciding
+ * a value for a variable, the plugin looks for a value that satisfies all
+ * the atoms where the variable is the only unassigned leaf.
+ */
+
+typedef struct {
+
+  /** The plugin interface */
+  plugin_t plugin_interface;
+
+  /** The plugin context */
+  plugin_context_t* ctx;
+
+  /** Watch list manager for the atoms (over the atom and its leaves) */
+  watch_list_manager_t wlm;
+
+  /** Next index of the trail to process */
+  uint32_t trail_i;
+
+  /** Scope holder for the int variables */
+  scope_holder_t scope;
+
+  /** Conflict  */
+  ivector_t conflict;
+
+  /** All bit-vector variables (uninterpreted terms), kept for the model */
+  ivector_t all_vars;
+
+  /** The evaluator */
+  bv_evaluator_t evaluator;
+
+  /** The term manager (no ITE simplification) */
+  term_manager_t tm;
+
+  /** Exception handler */
+  jmp_buf* exception;
+
+  struct {
+    uint32_t* propagations;
+    uint32_t* conflicts;
+    uint32_t* atoms;
+  } stats;
+
+} bv_plugin_t;
+
+static
+void bv_plugin_stats_init(bv_plugin_t* bv) {
+  bv->stats.propagations = statistics_new_uint32(bv->ctx->stats, "mcsat::bv::propagations");
+  bv->stats.conflicts = statistics_new_uint32(bv->ctx->stats, "mcsat::bv::conflicts");
+  bv->stats.atoms = statistics_new_uint32(bv->ctx->stats, "mcsat::bv::atoms");
+}
+
+static
+void bv_plugin_construct(plugin_t* plugin, plugin_context_t* ctx) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  bv->ctx = ctx;
+
+  watch_list_manager_construct(&bv->wlm, bv->ctx->var_db);
+  scope_holder_construct(&bv->scope);
+  init_ivector(&bv->conflict, 0);
+  init_ivector(&bv->all_vars, 0);
+  bv_evaluator_construct(&bv->evaluator, ctx->terms, ctx->var_db, ctx->trail);
+
+  bv->trail_i = 0;
+
+  // Atoms
+  ctx->request_term_notification_by_kind(ctx, BV_EQ_ATOM);
+  ctx->request_term_notification_by_kind(ctx, BV_GE_ATOM);
+  ctx->request_term_notification_by_kind(ctx, BV_SGE_ATOM);
+  ctx->request_term_notification_by_kind(ctx, BIT_TERM);
+
+  // Types
+  ctx->request_term_notification_by_type(ctx, BITVECTOR_TYPE);
+
+  // Decisions
+  ctx->request_decision_calls(ctx, BITVECTOR_TYPE);
+
+  // Term manager
+  init_term_manager(&bv->tm, bv->ctx->terms);
+  bv->tm.simplify_ite = false;
+
+  bv_plugin_stats_init(bv);
+}
+
+static
+void bv_plugin_destruct(plugin_t* plugin) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  watch_list_manager_destruct(&bv->wlm);
+  scope_holder_destruct(&bv->scope);
+  delete_ivector(&bv->conflict);
+  delete_ivector(&bv->all_vars);
+  bv_evaluator_destruct(&bv->evaluator);
+  delete_term_manager(&bv->tm);
+}
+
+static
+bool bv_plugin_trail_variable_compare(void *data, variable_t t1, variable_t t2) {
+  const mcsat_trail_t* trail;
+  bool t1_has_value, t2_has_value;
+  uint32_t t1_level, t2_level;
+
+  trail = data;
+
+  // We compare variables based on the trail level, unassigned to the front,
+  // then assigned ones by decreasing level
+
+  // Literals with no value
+  t1_has_value = trail_has_value(trail, t1);
+  t2_has_value = trail_has_value(trail, t2);
+  if (!t1_has_value && !t2_has_value) {
+    // Both have no value, just order by variable
+    return t1 < t2;
+  }
+
+  // At least one has a value
+  if (!t1_has_value) {
+    // t1 < t2, goes to front
+    return true;
+  }
+  if (!t2_has_value) {
+    // t2 < t1, goes to front
+    return false;
+  }
+
+  // Both literals have a value, sort by decreasing level
+  t1_level = trail_get_level(trail, t1);
+  t2_level = trail_get_level(trail, t2);
+  if (t1_level != t2_level) {
+    // t1 > t2 goes to front
+    return t1_level > t2_level;
+  } else {
+    return t1 < t2;
+  }
+}
+
+/** Evaluate the atom in the current trail */
+static
+bool bv_plugin_eval_atom(bv_plugin_t* bv, variable_t atom_var) {
+  term_t atom = variable_db_get_term(bv->ctx->var_db, atom_var);
+  bv_evaluator_reset(&bv->evaluator);
+  return bv_evaluator_eval_bool(&bv->evaluator, atom);
+}
+
+/**
+ * Propagate the value of the atom, given that all the leaves are assigned.
+ * The propagation is done at the highest level of the leaves (but not lower
+ * than the base level).
+ */
+static
+void bv_plugin_propagate_atom(bv_plugin_t* bv, variable_t atom_var, const variable_t* leaves, uint32_t n, trail_token_t* prop) {
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  uint32_t i, level, leaf_level;
+  bool value;
+
+  assert(!trail_has_value(trail, atom_var));
+
+  level = trail->decision_level_base;
+  for (i = 0; i < n; ++ i) {
+    assert(trail_has_value(trail, leaves[i]));
+    leaf_level = trail_get_level(trail, leaves[i]);
+    if (leaf_level > level) {
+      level = leaf_level;
+    }
+  }
+
+  value = bv_plugin_eval_atom(bv, atom_var);
+  if (ctx_trace_enabled(bv->ctx, "bv_plugin")) {
+    ctx_trace_printf(bv->ctx, "bv_plugin: propagating %s at level %"PRIu32" ", value ? "true" : "false", level);
+    ctx_trace_term(bv->ctx, variable_db_get_term(bv->ctx->var_db, atom_var));
+  }
+  prop->add_at_level(prop, atom_var, value ? &mcsat_value_true : &mcsat_value_false, level);
+  (*bv->stats.propagations) ++;
+}
+
+/**
+ * Get the conflict for an atom that evaluates to the opposite of its value.
+ * The conflict consists of the atom literal (true in the trail) and the
+ * equalities between the leaves and their values.
+ */
+static
+void bv_plugin_get_atom_conflict(bv_plugin_t* bv, variable_t atom_var) {
+  term_table_t* terms = bv->ctx->terms;
+  variable_db_t* var_db = bv->ctx->var_db;
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  uint32_t i;
+
+  ivector_reset(&bv->conflict);
+
+  term_t atom = variable_db_get_term(var_db, atom_var);
+  if (trail_get_boolean_value(trail, atom_var)) {
+    ivector_push(&bv->conflict, atom);
+  } else {
+    ivector_push(&bv->conflict, opposite_term(atom));
+  }
+
+  ivector_t leaves;
+  init_ivector(&leaves, 0);
+  bv_term_get_leaves(terms, atom, &leaves);
+  for (i = 0; i < leaves.size; ++ i) {
+    term_t leaf = leaves.data[i];
+    variable_t leaf_var = variable_db_get_variable_if_exists(var_db, leaf);
+    assert(leaf_var != variable_null);
+    if (is_boolean_term(terms, leaf)) {
+      if (trail_get_boolean_value(trail, leaf_var)) {
+        ivector_push(&bv->conflict, leaf);
+      } else {
+        ivector_push(&bv->conflict, opposite_term(leaf));
+      }
+    } else {
+      // Have to cast, the term manager doesn't take const constants
+      mcsat_value_t* leaf_value = (mcsat_value_t*) trail_get_value(trail, leaf_var);
+      assert(leaf_value->type == VALUE_BV);
+      term_t c = mk_bv_constant(&bv->tm, &leaf_value->bv_value);
+      // Build the atom directly, mk_bveq could rewrite it into something
+      // that doesn't evaluate to true
+      term_t eq = leaf < c ? bveq_atom(terms, leaf, c) : bveq_atom(terms, c, leaf);
+      ivector_push(&bv->conflict, eq);
+    }
+  }
+  delete_ivector(&leaves);
+
+  if (ctx_trace_enabled(bv->ctx, "bv_plugin::conflict")) {
+    ctx_trace_printf(bv->ctx, "bv_plugin: conflict\n");
+    for (i = 0; i < bv->conflict.size; ++ i) {
+      ctx_trace_term(bv->ctx, bv->conflict.data[i]);
+    }
+  }
+}
+
+static
+void bv_plugin_new_atom(bv_plugin_t* bv, term_t atom, trail_token_t* prop) {
+  variable_db_t* var_db = bv->ctx->var_db;
+  term_table_t* terms = bv->ctx->terms;
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  uint32_t i;
+
+  variable_t atom_var = variable_db_get_variable(var_db, atom);
+
+  // The variables: the atom itself and the leaves
+  ivector_t leaves;
+  init_ivector(&leaves, 0);
+  bv_term_get_leaves(terms, atom, &leaves);
+  ivector_t vars;
+  init_ivector(&vars, leaves.size + 1);
+  ivector_push(&vars, atom_var);
+  for (i = 0; i < leaves.size; ++ i) {
+    ivector_push(&vars, variable_db_get_variable(var_db, leaves.data[i]));
+  }
+
+  // Sort variables by trail index
+  int_array_sort2(vars.data, vars.size, (void*) trail, bv_plugin_trail_variable_compare);
+
+  // Make the variable list and watch the first two
+  variable_list_ref_t var_list = watch_list_manager_new_list(&bv->wlm, vars.data, vars.size, atom_var);
+  watch_list_manager_add_to_watch(&bv->wlm, var_list, vars.data[0]);
+  if (vars.size > 1) {
+    watch_list_manager_add_to_watch(&bv->wlm, var_list, vars.data[1]);
+  }
+
+  // If only the atom is unassigned, propagate it
+  if (vars.data[0] == atom_var && (vars.size == 1 || trail_has_value(trail, vars.data[1]))) {
+    assert(!trail_has_value(trail, atom_var));
+    bv_plugin_propagate_atom(bv, atom_var, vars.data + 1, vars.size - 1, prop);
+  }
+
+  (*bv->stats.atoms) ++;
+
+  delete_ivector(&vars);
+  delete_ivector(&leaves);
+}
+
+static
+void bv_plugin_new_term_notify(plugin_t* plugin, term_t t, trail_token_t* prop) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  term_table_t* terms = bv->ctx->terms;
+
+  if (ctx_trace_enabled(bv->ctx, "mcsat::new_term")) {
+    ctx_trace_printf(bv->ctx, "bv_plugin_new_term_notify: ");
+    ctx_trace_term(bv->ctx, t);
+  }
+
+  assert(is_pos_term(t));
+
+  if (bv_term_is_atom(terms, t)) {
+    bv_plugin_new_atom(bv, t, prop);
+  } else if (is_bitvector_term(terms, t)) {
+    if (bv_term_is_interpreted(terms, t)) {
+      // Interpreted terms are evaluated, they should never become variables
+      longjmp(*bv->exception, MCSAT_EXCEPTION_UNSUPPORTED_THEORY);
+    }
+    if (term_kind(terms, t) == UNINTERPRETED_TERM) {
+      ivector_push(&bv->all_vars, variable_db_get_variable(bv->ctx->var_db, t));
+    }
+  }
+}
+
+static
+void bv_plugin_propagate_var(bv_plugin_t* bv, variable_t var, trail_token_t* prop) {
+  const mcsat_trail_t* trail = bv->ctx->trail;
+
+  // Go through all the variable lists (constraints) where we're watching var
+  remove_iterator_t it;
+  variable_list_ref_t var_list_ref;
+  variable_t* var_list;
+  variable_t* var_list_it;
+  bool new_watch;
+
+  // Get the watch-list and process
+  remove_iterator_construct(&it, &bv->wlm, var);
+  while (trail_is_consistent(trail) && !remove_iterator_done(&it)) {
+
+    // Get the current list where var appears
+    var_list_ref = remove_iterator_get_list_ref(&it);
+    var_list = watch_list_manager_get_list(&bv->wlm, var_list_ref);
+
+    // The atom
+    variable_t atom_var = watch_list_manager_get_constraint(&bv->wlm, var_list_ref);
+
+    new_watch = false;
+    if (var_list[1] != variable_null) {
+      // Put the variable to [1] so that [0] is the unit one
+      if (var_list[0] == var) {
+        var_list[0] = var_list[1];
+        var_list[1] = var;
+      }
+      // Find a new watch (start from [2])
+      for (var_list_it = var_list + 2; *var_list_it != variable_null; ++var_list_it) {
+        if (!trail_has_value(trail, *var_list_it)) {
+          // Swap with var_list[1]
+          var_list[1] = *var_list_it;
+          *var_list_it = var;
+          // Add to new watch
+          watch_list_manager_add_to_watch(&bv->wlm, var_list_ref, var_list[1]);
+          // Don't watch this one
+          remove_iterator_next_and_remove(&it);
+          new_watch = true;
+          break;
+        }
+      }
+    }
+
+    if (!new_watch) {
+      // We did not find a new watch so vars[1], ..., vars[n] are assigned.
+      if (!trail_has_value(trail, var_list[0])) {
+        // If the atom is the only one left, we propagate it, otherwise
+        // it's unit in a leaf and it's taken care of in decisions
+        if (var_list[0] == atom_var) {
+          uint32_t size = 1;
+          while (var_list[size] != variable_null) { size ++; }
+          bv_plugin_propagate_atom(bv, atom_var, var_list + 1, size - 1, prop);
+        }
+      } else {
+        // Everything is assigned, check the value
+        bool atom_value = trail_get_boolean_value(trail, atom_var);
+        if (atom_value != bv_plugin_eval_atom(bv, atom_var)) {
+          bv_plugin_get_atom_conflict(bv, atom_var);
+          prop->conflict(prop);
+          (*bv->stats.conflicts) ++;
+        }
+      }
+      // Keep the watch, and continue
+      remove_iterator_next_and_keep(&it);
+    }
+  }
+
+  // Done, destruct the iterator
+  remove_iterator_destruct(&it);
+}
+
+static
+void bv_plugin_propagate(plugin_t* plugin, trail_token_t* prop) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  if (ctx_trace_enabled(bv->ctx, "bv_plugin")) {
+    ctx_trace_printf(bv->ctx, "bv_plugin_propagate()\n");
+  }
+
+  // If we're not watching anything, we just ignore
+  if (watch_list_manager_size(&bv->wlm) == 0) {
+    return;
+  }
+
+  // Propagate
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  for(; trail_is_consistent(trail) && bv->trail_i < trail_size(trail); ++ bv->trail_i) {
+    bv_plugin_propagate_var(bv, trail_at(trail, bv->trail_i), prop);
+  }
+}
+
+static
+void bv_plugin_push(plugin_t* plugin) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  scope_holder_push(&bv->scope,
+      &bv->trail_i,
+      NULL);
+}
+
+static
+void bv_plugin_pop(plugin_t* plugin) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  scope_holder_pop(&bv->scope,
+      &bv->trail_i,
+      NULL);
+}
+
+static
+void bv_plugin_event_notify(plugin_t* plugin, plugin_notify_kind_t kind) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  switch (kind) {
+  case MCSAT_SOLVER_START:
+  case MCSAT_SOLVER_RESTART:
+  case MCSAT_SOLVER_CONFLICT:
+    break;
+  case MCSAT_SOLVER_POP:
+    // Propagations at the popped base level are gone, so we re-check the
+    // whole trail
+    bv->trail_i = 0;
+    break;
+  default:
+    assert(false);
+  }
+}
+
+/**
+ * Collect the atoms where x is the only unassigned variable.
+ */
+static
+void bv_plugin_get_unit_atoms(bv_plugin_t* bv, variable_t x, ivector_t* units) {
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  remove_iterator_t it;
+  const variable_t* var_list;
+
+  remove_iterator_construct(&it, &bv->wlm, x);
+  while (!remove_iterator_done(&it)) {
+    var_list = remove_iterator_get_list(&it);
+    for (; *var_list != variable_null; ++ var_list) {
+      if (*var_list != x && !trail_has_value(trail, *var_list)) {
+        break;
+      }
+    }
+    if (*var_list == variable_null) {
+      ivector_push(units, remove_iterator_get_constraint(&it));
+    }
+    remove_iterator_next_and_keep(&it);
+  }
+  remove_iterator_destruct(&it);
+}
+
+/**
+ * Check if assigning x to v satisfies all the unit atoms.
+ */
+static
+bool bv_plugin_check_value(bv_plugin_t* bv, variable_t x, const ivector_t* units, const bvconstant_t* v) {
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  variable_db_t* var_db = bv->ctx->var_db;
+  uint32_t i;
+  bool ok;
+
+  ok = true;
+  bv_evaluator_set_override(&bv->evaluator, x, v);
+  for (i = 0; ok && i < units->size; ++ i) {
+    variable_t atom_var = units->data[i];
+    term_t atom = variable_db_get_term(var_db, atom_var);
+    ok = bv_evaluator_eval_bool(&bv->evaluator, atom) == trail_get_boolean_value(trail, atom_var);
+  }
+  bv_evaluator_set_override(&bv->evaluator, variable_null, NULL);
+
+  return ok;
+}
+
+/**
+ * Get the value suggested by the unit atom for x, if any. These are the
+ * atoms of the form (x op t) where t is a constant or an assigned leaf.
+ */
+static
+bool bv_plugin_get_suggested_value(bv_plugin_t* bv, term_t x, variable_t atom_var, bvconstant_t* v) {
+  term_table_t* terms = bv->ctx->terms;
+  variable_db_t* var_db = bv->ctx->var_db;
+  term_t atom, other;
+  composite_term_t* desc;
+
+  atom = variable_db_get_term(var_db, atom_var);
+  switch (term_kind(terms, atom)) {
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    desc = composite_term_desc(terms, atom);
+    if (desc->arg[0] == x) {
+      other = desc->arg[1];
+    } else if (desc->arg[1] == x) {
+      other = desc->arg[0];
+    } else {
+      return false;
+    }
+    break;
+  default:
+    return false;
+  }
+
+  // Other side is a constant or a leaf (so it doesn't depend on x)
+  if (!bv_term_is_interpreted(terms, other)) {
+    // A leaf, assigned since x is the only unassigned variable
+  } else if (term_kind(terms, other) != BV64_CONSTANT && term_kind(terms, other) != BV_CONSTANT) {
+    return false;
+  }
+
+  bv_evaluator_reset(&bv->evaluator);
+  const bvconstant_t* other_value = bv_evaluator_eval(&bv->evaluator, other);
+  bvconstant_copy(v, other_value->bitsize, other_value->data);
+
+  return true;
+}
+
+/**
+ * Evaluate (lhs - rhs) with x set to v, result in diff.
+ */
+static
+void bv_plugin_eval_diff(bv_plugin_t* bv, variable_t x, term_t lhs, term_t rhs, const bvconstant_t* v, bvconstant_t* diff) {
+  const bvconstant_t* value;
+  uint32_t n;
+
+  n = v->bitsize;
+  bv_evaluator_set_override(&bv->evaluator, x, v);
+  value = bv_evaluator_eval(&bv->evaluator, lhs);
+  bvconstant_copy(diff, n, value->data);
+  value = bv_evaluator_eval(&bv->evaluator, rhs);
+  bvconst_sub(diff->data, diff->width, value->data);
+  bvconstant_normalize(diff);
+  bv_evaluator_set_override(&bv->evaluator, variable_null, NULL);
+}
+
+/**
+ * Number of trailing zeros in c (c must be non-zero).
+ */
+static
+uint32_t bv_plugin_trailing_zeros(const bvconstant_t* c) {
+  uint32_t i;
+  for (i = 0; i < c->bitsize; ++ i) {
+    if (bvconst_tst_bit(c->data, i)) {
+      break;
+    }
+  }
+  return i;
+}
+
+/**
+ * Try to solve the unit equality atom for x, assuming that the difference of
+ * the two sides is affine in x (i.e., a*x + b). We sample the difference at
+ * x = 0, 1, 2 to get a and b, and if a*x = -b has a solution we return it in
+ * v. This is only a heuristic to get a candidate value, it's checked later.
+ */
+static
+bool bv_plugin_solve_linear(bv_plugin_t* bv, variable_t x, variable_t atom_var, bvconstant_t* v) {
+  term_table_t* terms = bv->ctx->terms;
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  term_t atom;
+  composite_term_t* eq;
+  uint32_t n, w, t, k;
+  bvconstant_t d0, d1, d2, a, b, inv, tmp;
+  bool solved;
+
+  atom = variable_db_get_term(bv->ctx->var_db, atom_var);
+  if (term_kind(terms, atom) != BV_EQ_ATOM || !trail_get_boolean_value(trail, atom_var)) {
+    return false;
+  }
+  eq = bveq_atom_desc(terms, atom);
+  n = term_bitsize(terms, variable_db_get_term(bv->ctx->var_db, x));
+  if (term_bitsize(terms, eq->arg[0]) != n) {
+    // x is not at the top level of the equality (e.g., in a bit-array)
+    return false;
+  }
+
+  init_bvconstant(&d0);
+  init_bvconstant(&d1);
+  init_bvconstant(&d2);
+  init_bvconstant(&a);
+  init_bvconstant(&b);
+  init_bvconstant(&inv);
+  init_bvconstant(&tmp);
+
+  // Sample at 0, 1, 2
+  bvconstant_set_all_zero(&tmp, n);
+  bv_plugin_eval_diff(bv, x, eq->arg[0], eq->arg[1], &tmp, &d0);
+  bvconstant_add_one(&tmp);
+  bvconstant_normalize(&tmp);
+  bv_plugin_eval_diff(bv, x, eq->arg[0], eq->arg[1], &tmp, &d1);
+  bvconstant_add_one(&tmp);
+  bvconstant_normalize(&tmp);
+  bv_plugin_eval_diff(bv, x, eq->arg[0], eq->arg[1], &tmp, &d2);
+
+  w = d0.width;
+  solved = false;
+
+  // a = d1 - d0 must be the same as d2 - d1
+  bvconstant_copy(&a, n, d1.data);
+  bvconst_sub(a.data, w, d0.data);
+  bvconstant_normalize(&a);
+  bvconstant_copy(&tmp, n, d2.data);
+  bvconst_sub(tmp.data, w, d1.data);
+  bvconstant_normalize(&tmp);
+
+  if (!bvconstant_is_zero(&a) && bvconst_eq(a.data, tmp.data, w)) {
+    // Solve a*x = b with b = -d0
+    bvconstant_copy(&b, n, d0.data);
+    bvconstant_negate(&b);
+    bvconstant_normalize(&b);
+    t = bv_plugin_trailing_zeros(&a);
+    if (bvconstant_is_zero(&b) || bv_plugin_trailing_zeros(&b) >= t) {
+      // Divide by 2^t, a is now odd
+      bvconst_shift_right(a.data, n, t, false);
+      bvconst_shift_right(b.data, n, t, false);
+      // Inverse of a by Newton iteration: inv = inv * (2 - a * inv), each
+      // step doubles the number of correct bits (a*a = 1 mod 8 for odd a)
+      bvconstant_copy(&inv, n, a.data);
+      for (k = 3; k < n; k *= 2) {
+        bvconstant_set_all_zero(&tmp, n);
+        bvconst_set32(tmp.data, w, 2);
+        bvconst_submul(tmp.data, w, a.data, inv.data);
+        bvconst_mul(inv.data, w, tmp.data);
+        bvconstant_normalize(&inv);
+      }
+      // x = b * inv
+      bvconstant_set_all_zero(v, n);
+      bvconst_addmul(v->data, w, b.data, inv.data);
+      bvconstant_normalize(v);
+      solved = true;
+    }
+  }
+
+  delete_bvconstant(&tmp);
+  delete_bvconstant(&inv);
+  delete_bvconstant(&b);
+  delete_bvconstant(&a);
+  delete_bvconstant(&d2);
+  delete_bvconstant(&d1);
+  delete_bvconstant(&d0);
+
+  return solved;
+}
+
+static
+void bv_plugin_decide(plugin_t* plugin, variable_t x, trail_token_t* decide, bool must) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  term_table_t* terms = bv->ctx->terms;
+  variable_db_t* var_db = bv->ctx->var_db;
+  uint32_t i, n;
+  bool found;
+
+  term_t x_term = variable_db_get_term(var_db, x);
+  n = term_bitsize(terms, x_term);
+
+  if (ctx_trace_enabled(bv->ctx, "bv_plugin")) {
+    ctx_trace_printf(bv->ctx, "bv_plugin_decide: ");
+    ctx_trace_term(bv->ctx, x_term);
+  }
+
+  ivector_t units;
+  init_ivector(&units, 0);
+  bv_plugin_get_unit_atoms(bv, x, &units);
+
+  bvconstant_t value;
+  init_bvconstant(&value);
+  found = false;
+
+  // Try the values that the unit atoms are suggesting, and their neighbors
+  for (i = 0; !found && i < units.size; ++ i) {
+    if (bv_plugin_get_suggested_value(bv, x_term, units.data[i], &value)) {
+      found = bv_plugin_check_value(bv, x, &units, &value);
+      if (!found) {
+        bvconstant_add_one(&value);
+        bvconstant_normalize(&value);
+        found = bv_plugin_check_value(bv, x, &units, &value);
+      }
+      if (!found) {
+        bvconstant_sub_one(&value);
+        bvconstant_sub_one(&value);
+        bvconstant_normalize(&value);
+        found = bv_plugin_check_value(bv, x, &units, &value);
+      }
+    }
+  }
+
+  // Try to solve the equalities
+  for (i = 0; !found && i < units.size; ++ i) {
+    if (bv_plugin_solve_linear(bv, x, units.data[i], &value)) {
+      found = bv_plugin_check_value(bv, x, &units, &value);
+    }
+  }
+
+  // Try some default values
+  if (!found) {
+    bvconstant_set_all_zero(&value, n);
+    found = bv_plugin_check_value(bv, x, &units, &value);
+  }
+  if (!found) {
+    bvconstant_set_all_zero(&value, n);
+    bvconst_set_one(value.data, value.width);
+    found = bv_plugin_check_value(bv, x, &units, &value);
+  }
+  if (!found) {
+    bvconstant_set_all_one(&value, n);
+    found = bv_plugin_check_value(bv, x, &units, &value);
+  }
+  if (!found) {
+    bvconstant_set_bitsize(&value, n);
+    bvconst_set_min_signed(value.data, n);
+    found = bv_plugin_check_value(bv, x, &units, &value);
+  }
+  if (!found) {
+    bvconstant_set_bitsize(&value, n);
+    bvconst_set_max_signed(value.data, n);
+    found = bv_plugin_check_value(bv, x, &units, &value);
+  }
+
+  // If nothing works, we go with 0 and the conflict will exclude it
+  if (!found) {
+    bvconstant_set_all_zero(&value, n);
+  }
+
+  mcsat_value_t mcsat_value;
+  mcsat_value_construct_bv_value(&mcsat_value, &value);
+  decide->add(decide, x, &mcsat_value);
+  mcsat_value_destruct(&mcsat_value);
+
+  delete_bvconstant(&value);
+  delete_ivector(&units);
+}
+
+static
+void bv_plugin_get_conflict(plugin_t* plugin, ivector_t* conflict) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  ivector_swap(conflict, &bv->conflict);
+  ivector_reset(&bv->conflict);
+}
+
+static
+term_t bv_plugin_explain_propagation(plugin_t* plugin, variable_t var, ivector_t* reasons) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  // We only propagate atoms by evaluation, so the reason is the literal itself
+
+  term_t atom = variable_db_get_term(bv->ctx->var_db, var);
+  assert(term_type_kind(bv->ctx->terms, atom) == BOOL_TYPE);
+
+  if (trail_get_boolean_value(bv->ctx->trail, var)) {
+    // atom => atom = true
+    ivector_push(reasons, atom);
+    return bool2term(true);
+  } else {
+    // neg atom => atom = false
+    ivector_push(reasons, opposite_term(atom));
+    return bool2term(false);
+  }
+}
+
+static
+bool bv_plugin_explain_evaluation(plugin_t* plugin, term_t t, int_mset_t* vars, mcsat_value_t* value) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  term_table_t* terms = bv->ctx->terms;
+  variable_db_t* var_db = bv->ctx->var_db;
+  const mcsat_trail_t* trail = bv->ctx->trail;
+  uint32_t i;
+  bool evaluates;
+
+  term_t atom = unsigned_term(t);
+  if (!bv_term_is_atom(terms, atom)) {
+    return false;
+  }
+
+  // All the leaves must be assigned
+  ivector_t leaves;
+  init_ivector(&leaves, 0);
+  bv_term_get_leaves(terms, atom, &leaves);
+  evaluates = true;
+  for (i = 0; evaluates && i < leaves.size; ++ i) {
+    variable_t leaf_var = variable_db_get_variable_if_exists(var_db, leaves.data[i]);
+    if (leaf_var == variable_null || !trail_has_value(trail, leaf_var)) {
+      evaluates = false;
+    } else {
+      int_mset_add(vars, leaf_var);
+    }
+  }
+  delete_ivector(&leaves);
+
+  if (evaluates && value != NULL) {
+    bv_evaluator_reset(&bv->evaluator);
+    mcsat_value_construct_bool(value, bv_evaluator_eval_bool(&bv->evaluator, t));
+  }
+
+  return evaluates;
+}
+
+static
+void bv_plugin_gc_mark(plugin_t* plugin, gc_info_t* gc_vars) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  term_table_t* terms = bv->ctx->terms;
+  variable_db_t* var_db = bv->ctx->var_db;
+  uint32_t i, j;
+
+  if (gc_vars->level == 0) {
+    // Keep all the variables for the model
+    for (i = 0; i < bv->all_vars.size; ++ i) {
+      gc_info_mark(gc_vars, bv->all_vars.data[i]);
+    }
+  }
+
+  // Mark the leaves of the atoms that are kept
+  ivector_t leaves;
+  init_ivector(&leaves, 0);
+  for (i = gc_vars->marked_first; i < gc_vars->marked.size; ++ i) {
+    term_t atom = variable_db_get_term(var_db, gc_vars->marked.data[i]);
+    if (bv_term_is_atom(terms, atom)) {
+      ivector_reset(&leaves);
+      bv_term_get_leaves(terms, atom, &leaves);
+      for (j = 0; j < leaves.size; ++ j) {
+        variable_t leaf_var = variable_db_get_variable_if_exists(var_db, leaves.data[j]);
+        assert(leaf_var != variable_null);
+        gc_info_mark(gc_vars, leaf_var);
+      }
+    }
+  }
+  delete_ivector(&leaves);
+}
+
+static
+void bv_plugin_gc_sweep(plugin_t* plugin, const gc_info_t* gc_vars) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+
+  // Watch list manager
+  watch_list_manager_gc_sweep_lists(&bv->wlm, gc_vars);
+}
+
+static
+void bv_plugin_set_exception_handler(plugin_t* plugin, jmp_buf* handler) {
+  bv_plugin_t* bv = (bv_plugin_t*) plugin;
+  bv->exception = handler;
+}
+
+plugin_t* bv_plugin_allocator(void) {
+  bv_plugin_t* plugin = safe_malloc(sizeof(bv_plugin_t));
+  plugin_construct((plugin_t*) plugin);
+  plugin->plugin_interface.construct             = bv_plugin_construct;
+  plugin->plugin_interface.destruct              = bv_plugin_destruct;
+  plugin->plugin_interface.new_term_notify       = bv_plugin_new_term_notify;
+  plugin->plugin_interface.new_lemma_notify      = NULL;
+  plugin->plugin_interface.event_notify          = bv_plugin_event_notify;
+  plugin->plugin_interface.propagate             = bv_plugin_propagate;
+  plugin->plugin_interface.decide                = bv_plugin_decide;
+  plugin->plugin_interface.get_conflict          = bv_plugin_get_conflict;
+  plugin->plugin_interface.explain_propagation   = bv_plugin_explain_propagation;
+  plugin->plugin_interface.explain_evaluation    = bv_plugin_explain_evaluation;
+  plugin->plugin_interface.push                  = bv_plugin_push;
+  plugin->plugin_interface.pop                   = bv_plugin_pop;
+  plugin->plugin_interface.build_model           = NULL;
+  plugin->plugin_interface.gc_mark               = bv_plugin_gc_mark;
+  plugin->plugin_interface.gc_sweep              = bv_plugin_gc_sweep;
+  plugin->plugin_interface.set_exception_handler = bv_plugin_set_exception_handler;
+
+  return (plugin_t*) plugin;
+}
@@ -50,6 +50,16 @@ void ite_plugin_destruct(plugin_t* plugin) {
   delete_term_manager(&ite->tm);
 }
 
+/** Make the equality atom (t1 == t2) without simplification */
+static
+term_t ite_plugin_mk_eq(term_table_t* terms, term_t t1, term_t t2) {
+  if (is_bitvector_term(terms, t1)) {
+    return t1 < t2 ? bveq_atom(terms, t1, t2) : bveq_atom(terms, t2, t1);
+  } else {
+    return arith_bineq_atom(terms, t1, t2);
+  }
+}
+
 void ite_plugin_new_term_notify(plugin_t* plugin, term_t term, trail_token_t* prop) {
   ite_plugin_t* ite_plugin = (ite_plugin_t*) plugin;
 
@@ -73,8 +83,8 @@ void ite_plugin_new_term_notify(plugin_t* plugin, term_t term, trail_token_t* pr
 
   // Make the lemmas
   term_manager_t* tm = &ite_plugin->tm;
-  term_t eq_true = arith_bineq_atom(ite_plugin->ctx->terms, term, t_true);
-  term_t eq_false = arith_bineq_atom(ite_plugin->ctx->terms, term, t_false);
+  term_t eq_true = ite_plugin_mk_eq(ite_plugin->ctx->terms, term, t_true);
+  term_t eq_false = ite_plugin_mk_eq(ite_plugin->ctx->terms, term, t_false);
   term_t imp1 = mk_implies(tm, c, eq_true);
   term_t imp2 = mk_implies(tm, opposite_term(c), eq_false);
   term_t disj = mk_binary_or(tm, eq_true, eq_false);
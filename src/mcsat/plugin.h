@@ -40,7 +40,9 @@ typedef enum {
   /** Each time a restart is initiated */
   MCSAT_SOLVER_RESTART,
   /** Eech time a conflict is encountered */
-  MCSAT_SOLVER_CONFLICT
+  MCSAT_SOLVER_CONFLICT,
+  /** Each time a user scope is popped (after the trail is popped) */
+  MCSAT_SOLVER_POP
 } plugin_notify_kind_t;
 
 /**
@@ -28,6 +28,9 @@ void preprocessor_construct(preprocessor_t* pre, term_table_t* terms, jmp_buf* h
   init_term_manager(&pre->tm, terms);
   init_int_hmap(&pre->preprocess_map, 0);
   init_int_hmap(&pre->purification_map, 0);
+  init_ivector(&pre->preprocess_map_list, 0);
+  init_ivector(&pre->purification_map_list, 0);
+  scope_holder_construct(&pre->scope);
   pre->tracer = NULL;
   pre->exception = handler;
 }
@@ -37,6 +40,9 @@ void preprocessor_set_tracer(preprocessor_t* pre, tracer_t* tracer) {
 }
 
 void preprocessor_destruct(preprocessor_t* pre) {
+  scope_holder_destruct(&pre->scope);
+  delete_ivector(&pre->purification_map_list);
+  delete_ivector(&pre->preprocess_map_list);
   delete_int_hmap(&pre->purification_map);
   delete_int_hmap(&pre->preprocess_map);
   delete_term_manager(&pre->tm);
@@ -56,6 +62,7 @@ static
 void preprocessor_set(preprocessor_t* pre, term_t t, term_t t_pre) {
   assert(preprocessor_get(pre, t) == NULL_TERM);
   int_hmap_add(&pre->preprocess_map, t, t_pre);
+  ivector_push(&pre->preprocess_map_list, t);
 }
 
 static
@@ -86,6 +93,30 @@ composite_term_t* get_composite(term_table_t* terms, term_kind_t kind, term_t t)
     return arith_mod_term_desc(terms, t);
   case DISTINCT_TERM:
     return distinct_term_desc(terms, t);
+  case BV_ARRAY:
+    return bvarray_term_desc(terms, t);
+  case BV_DIV:
+    return bvdiv_term_desc(terms, t);
+  case BV_REM:
+    return bvrem_term_desc(terms, t);
+  case BV_SDIV:
+    return bvsdiv_term_desc(terms, t);
+  case BV_SREM:
+    return bvsrem_term_desc(terms, t);
+  case BV_SMOD:
+    return bvsmod_term_desc(terms, t);
+  case BV_SHL:
+    return bvshl_term_desc(terms, t);
+  case BV_LSHR:
+    return bvlshr_term_desc(terms, t);
+  case BV_ASHR:
+    return bvashr_term_desc(terms, t);
+  case BV_EQ_ATOM:
+    return bveq_atom_desc(terms, t);
+  case BV_GE_ATOM:
+    return bvge_atom_desc(terms, t);
+  case BV_SGE_ATOM:
+    return bvsge_atom_desc(terms, t);
   default:
     assert(false);
     return NULL;
@@ -129,6 +160,41 @@ term_t mk_composite(preprocessor_t* pre, term_kind_t kind, uint32_t n, term_t* c
   case ARITH_MOD:          // remainder: (mod x y) is y - x * (div x y)
     assert(n == 2);
     return mk_arith_mod(tm, children[0], children[1]);
+  case BV_ARRAY:
+    return mk_bvarray(tm, n, children);
+  case BV_DIV:
+    assert(n == 2);
+    return mk_bvdiv(tm, children[0], children[1]);
+  case BV_REM:
+    assert(n == 2);
+    return mk_bvrem(tm, children[0], children[1]);
+  case BV_SDIV:
+    assert(n == 2);
+    return mk_bvsdiv(tm, children[0], children[1]);
+  case BV_SREM:
+    assert(n == 2);
+    return mk_bvsrem(tm, children[0], children[1]);
+  case BV_SMOD:
+    assert(n == 2);
+    return mk_bvsmod(tm, children[0], children[1]);
+  case BV_SHL:
+    assert(n == 2);
+    return mk_bvshl(tm, children[0], children[1]);
+  case BV_LSHR:
+    assert(n == 2);
+    return mk_bvlshr(tm, children[0], children[1]);
+  case BV_ASHR:
+    assert(n == 2);
+    return mk_bvashr(tm, children[0], children[1]);
+  case BV_EQ_ATOM:
+    assert(n == 2);
+    return mk_bveq(tm, children[0], children[1]);
+  case BV_GE_ATOM:
+    assert(n == 2);
+    return mk_bvge(tm, children[0], children[1]);
+  case BV_SGE_ATOM:
+    assert(n == 2);
+    return mk_bvsge(tm, children[0], children[1]);
   default:
     assert(false);
     return NULL_TERM;
@@ -165,6 +231,7 @@ term_t preprocessor_purify(preprocessor_t* pre, term_t t, ivector_t* out) {
     term_t x = new_uninterpreted_term(terms, t_type);
     // Remember for later
     int_hmap_add(&pre->purification_map, t, x);
+    ivector_push(&pre->purification_map_list, t);
     // Add equality to output
     term_t eq = mk_eq(&pre->tm, x, t);
     ivector_push(out, eq);
@@ -237,6 +304,7 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
     case REAL_TYPE:
     case UNINTERPRETED_TYPE:
     case FUNCTION_TYPE:
+    case BITVECTOR_TYPE:
       break;
     default:
       longjmp(*pre->exception, MCSAT_EXCEPTION_UNSUPPORTED_THEORY);
@@ -248,6 +316,8 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
     switch(current_kind) {
     case CONSTANT_TERM:    // constant of uninterpreted/scalar/boolean types
     case ARITH_CONSTANT:   // rational constant
+    case BV64_CONSTANT:    // compact bitvector constant (64 bits at most)
+    case BV_CONSTANT:      // generic bitvector constant (more than 64 bits)
     case UNINTERPRETED_TERM:  // (i.e., global variables, can't be bound).
       current_pre = current;
       break;
@@ -282,6 +352,18 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
     case OR_TERM:            // n-ary OR
     case XOR_TERM:           // n-ary XOR
     case ARITH_BINEQ_ATOM:   // equality: (t1 == t2)  (between two arithmetic terms)
+    case BV_ARRAY:           // array of boolean terms
+    case BV_DIV:             // unsigned division
+    case BV_REM:             // unsigned remainder
+    case BV_SDIV:            // signed division
+    case BV_SREM:            // remainder in signed division (rounding to 0)
+    case BV_SMOD:            // remainder in signed division (rounding to -infinity)
+    case BV_SHL:             // shift left (padding with 0)
+    case BV_LSHR:            // logical shift right (padding with 0)
+    case BV_ASHR:            // arithmetic shift right (padding with sign bit)
+    case BV_EQ_ATOM:         // equality: (t1 == t2)
+    case BV_GE_ATOM:         // unsigned comparison: (t1 >= t2)
+    case BV_SGE_ATOM:        // signed comparison (t1 >= t2)
     {
       composite_term_t* desc = get_composite(terms, current_kind, current);
       bool children_done = true;
@@ -355,7 +437,16 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
           current_pre = current;
         } else {
           // NOTE: it doens't change pp, it just uses it as a frame
-          current_pre = mk_arith_pprod(tm, pp, n, children.data);
+          if (type == BITVECTOR_TYPE) {
+            uint32_t nbits = term_bitsize(terms, current);
+            if (nbits <= 64) {
+              current_pre = mk_bvarith64_pprod(tm, pp, n, children.data, nbits);
+            } else {
+              current_pre = mk_bvarith_pprod(tm, pp, n, children.data, nbits);
+            }
+          } else {
+            current_pre = mk_arith_pprod(tm, pp, n, children.data);
+          }
         }
       }
 
@@ -405,6 +496,107 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
       break;
     }
 
+    case BV64_POLY:        // polynomial with 64bit coefficients
+    {
+      bvpoly64_t* p = bvpoly64_term_desc(terms, current);
+
+      bool children_done = true;
+      bool children_same = true;
+
+      n = p->nterms;
+
+      ivector_t children;
+      init_ivector(&children, n);
+
+      for (i = 0; i < n; ++ i) {
+        term_t x = p->mono[i].var;
+        term_t x_pre = (x == const_idx ? const_idx : preprocessor_get(pre, x));
+
+        if (x_pre != const_idx) {
+          if (x_pre == NULL_TERM) {
+            children_done = false;
+            ivector_push(&pre_stack, x);
+          } else if (x_pre != x) {
+            children_same = false;
+          }
+        }
+
+        if (children_done) { ivector_push(&children, x_pre); }
+      }
+
+      if (children_done) {
+        if (children_same) {
+          current_pre = current;
+        } else {
+          current_pre = mk_bvarith64_poly(tm, p, n, children.data);
+        }
+      }
+
+      delete_ivector(&children);
+
+      break;
+    }
+
+    case BV_POLY:          // polynomial with generic bitvector coefficients
+    {
+      bvpoly_t* p = bvpoly_term_desc(terms, current);
+
+      bool children_done = true;
+      bool children_same = true;
+
+      n = p->nterms;
+
+      ivector_t children;
+      init_ivector(&children, n);
+
+      for (i = 0; i < n; ++ i) {
+        term_t x = p->mono[i].var;
+        term_t x_pre = (x == const_idx ? const_idx : preprocessor_get(pre, x));
+
+        if (x_pre != const_idx) {
+          if (x_pre == NULL_TERM) {
+            children_done = false;
+            ivector_push(&pre_stack, x);
+          } else if (x_pre != x) {
+            children_same = false;
+          }
+        }
+
+        if (children_done) { ivector_push(&children, x_pre); }
+      }
+
+      if (children_done) {
+        if (children_same) {
+          current_pre = current;
+        } else {
+          current_pre = mk_bvarith_poly(tm, p, n, children.data);
+        }
+      }
+
+      delete_ivector(&children);
+
+      break;
+    }
+
+    case BIT_TERM:         // bit-select current = child[i]
+    {
+      uint32_t index = bit_term_index(terms, current);
+      term_t child = bit_term_arg(terms, current);
+      term_t child_pre = preprocessor_get(pre, child);
+
+      if (child_pre != NULL_TERM) {
+        if (child_pre != child) {
+          current_pre = mk_bitextract(tm, child_pre, index);
+        } else {
+          current_pre = current;
+        }
+      } else {
+        ivector_push(&pre_stack, child);
+      }
+
+      break;
+    }
+
     // FOLLOWING ARE UNINTEPRETED, SO WE PURIFY THE ARGUMENTS
 
     case APP_TERM:           // application of an uninterpreted function
@@ -565,6 +757,41 @@ term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out) {
   return t_pre;
 }
 
+void preprocessor_push(preprocessor_t* pre) {
+  scope_holder_push(&pre->scope,
+      &pre->preprocess_map_list.size,
+      &pre->purification_map_list.size,
+      NULL);
+}
+
+/** Remove the keys in list from index size on from the map */
+static
+void preprocessor_undo_map(int_hmap_t* map, ivector_t* list, uint32_t size) {
+  int_hmap_pair_t* find;
+  term_t t;
+
+  while (list->size > size) {
+    t = ivector_pop2(list);
+    find = int_hmap_find(map, t);
+    assert(find != NULL);
+    int_hmap_erase(map, find);
+  }
+}
+
+void preprocessor_pop(preprocessor_t* pre) {
+  uint32_t preprocess_map_size, purification_map_size;
+
+  // Terms preprocessed in the scope might rely on assertions that are gone
+  // (e.g. purification equalities), so we forget them
+  scope_holder_pop(&pre->scope,
+      &preprocess_map_size,
+      &purification_map_size,
+      NULL);
+
+  preprocessor_undo_map(&pre->preprocess_map, &pre->preprocess_map_list, preprocess_map_size);
+  preprocessor_undo_map(&pre->purification_map, &pre->purification_map_list, purification_map_size);
+}
+
 void preprocessor_set_exception_handler(preprocessor_t* pre, jmp_buf* handler) {
   pre->exception = handler;
 }
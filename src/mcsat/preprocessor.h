@@ -21,6 +21,7 @@
 #include "utils/int_vectors.h"
 #include "utils/int_hash_map.h"
 #include "io/tracer.h"
+#include "mcsat/utils/scope_holder.h"
 
 #include <setjmp.h>
 
@@ -41,6 +42,15 @@ typedef struct {
   /** Purification map, term to its variable */
   int_hmap_t purification_map;
 
+  /** Keys added to the preprocess map, in order (for pop) */
+  ivector_t preprocess_map_list;
+
+  /** Keys added to the purification map, in order (for pop) */
+  ivector_t purification_map_list;
+
+  /** Scope holder for the lists */
+  scope_holder_t scope;
+
   /** Tracer */
   tracer_t* tracer;
 
@@ -58,6 +68,12 @@ void preprocessor_destruct(preprocessor_t* pre);
 /** Preprocess the term, add any additional assertions to output vector. */
 term_t preprocessor_apply(preprocessor_t* pre, term_t t, ivector_t* out);
 
+/** Push the preprocessor state */
+void preprocessor_push(preprocessor_t* pre);
+
+/** Pop the preprocessor state (forget terms preprocessed since push) */
+void preprocessor_pop(preprocessor_t* pre);
+
 /** Set tracer */
 void preprocessor_set_tracer(preprocessor_t* pre, tracer_t* tracer);
 
@@ -34,6 +34,7 @@
 #include "utils/bitvectors.h"
 
 #include "mcsat/bool/bool_plugin.h"
+#include "mcsat/bv/bv_plugin.h"
 #include "mcsat/ite/ite_plugin.h"
 #include "mcsat/nra/nra_plugin.h"
 #include "mcsat/uf/uf_plugin.h"
@@ -41,6 +42,7 @@
 #include "mcsat/preprocessor.h"
 
 #include "mcsat/utils/statistics.h"
+#include "mcsat/utils/scope_holder.h"
 
 #include "utils/dprng.h"
 
@@ -134,6 +136,9 @@ struct mcsat_solver_s {
   /** List of assertions (positive variables). */
   ivector_t assertion_vars;
 
+  /** Scope holder for user push/pop (size of assertion_vars) */
+  scope_holder_t scope;
+
   /** The trail */
   mcsat_trail_t* trail;
 
@@ -590,6 +595,7 @@ void mcsat_add_plugins(mcsat_solver_t* mcsat) {
   mcsat_add_plugin(mcsat, uf_plugin_allocator, "uf_plugin");
   mcsat_add_plugin(mcsat, ite_plugin_allocator, "ite_plugin");
   mcsat_add_plugin(mcsat, nra_plugin_allocator, "nra_plugin");
+  mcsat_add_plugin(mcsat, bv_plugin_allocator, "bv_plugin");
 }
 
 static
@@ -619,6 +625,7 @@ void mcsat_construct(mcsat_solver_t* mcsat, context_t* ctx) {
 
   // List of assertions
   init_ivector(&mcsat->assertion_vars, 0);
+  scope_holder_construct(&mcsat->scope);
 
   // The trail
   mcsat->trail = safe_malloc(sizeof(mcsat_trail_t));
@@ -690,6 +697,7 @@ void mcsat_destruct(mcsat_solver_t* mcsat) {
   delete_int_queue(&mcsat->registration_queue);
   delete_int_hset(&mcsat->registration_cache);
   delete_ivector(&mcsat->assertion_vars);
+  scope_holder_destruct(&mcsat->scope);
   trail_destruct(mcsat->trail);
   safe_free(mcsat->trail);
   variable_db_destruct(mcsat->var_db);
@@ -728,10 +736,6 @@ void mcsat_push_internal(mcsat_solver_t* mcsat) {
   }
 }
 
-void mcsat_push(mcsat_solver_t* mcsat) {
-  assert(false);
-}
-
 static
 void mcsat_pop_internal(mcsat_solver_t* mcsat) {
   uint32_t i;
@@ -754,10 +758,6 @@ void mcsat_pop_internal(mcsat_solver_t* mcsat) {
   ivector_reset(unassigned);
 }
 
-void mcsat_pop(mcsat_solver_t* mcsat) {
-  assert(false);
-}
-
 /**
  * Get the indices of the plugins that claim to own the term t by type.
  */
@@ -995,6 +995,56 @@ void mcsat_process_requests(mcsat_solver_t* mcsat) {
   }
 }
 
+void mcsat_clear(mcsat_solver_t* mcsat) {
+  assert(mcsat->status == STATUS_SAT || mcsat->status == STATUS_UNKNOWN);
+  mcsat_backtrack_to(mcsat, mcsat->trail->decision_level_base);
+  mcsat->status = STATUS_IDLE;
+}
+
+void mcsat_push(mcsat_solver_t* mcsat) {
+  assert(mcsat->status == STATUS_IDLE);
+  assert(trail_is_at_base_level(mcsat->trail));
+  assert(trail_is_consistent(mcsat->trail));
+
+  // Remember the assertions
+  scope_holder_push(&mcsat->scope,
+      &mcsat->assertion_vars.size,
+      NULL);
+
+  // New base level for the trail and the plugins
+  mcsat_push_internal(mcsat);
+  trail_new_base_level(mcsat->trail);
+
+  // Preprocessing is redone for new assertions
+  preprocessor_push(&mcsat->preprocessor);
+}
+
+void mcsat_pop(mcsat_solver_t* mcsat) {
+  uint32_t assertion_vars_size;
+
+  // Search might have stopped above the base level (or in conflict)
+  mcsat_backtrack_to(mcsat, mcsat->trail->decision_level_base);
+
+  // Pop the base level of the trail and the plugins
+  trail_pop_base_level(mcsat->trail);
+  mcsat_pop_internal(mcsat);
+
+  // Forget the assertions of the scope. The variables, the registered terms
+  // and the lemmas are kept (they are valid in all scopes), gc will remove
+  // the unused ones.
+  scope_holder_pop(&mcsat->scope,
+      &assertion_vars_size,
+      NULL);
+  ivector_shrink(&mcsat->assertion_vars, assertion_vars_size);
+
+  preprocessor_pop(&mcsat->preprocessor);
+
+  // Let the plugins re-propagate whatever was undone at base
+  mcsat_notify_plugins(mcsat, MCSAT_SOLVER_POP);
+
+  mcsat->status = STATUS_IDLE;
+}
+
 /**
  * Perform propagation by running all plugins in sequence. Stop if a conflict
  * is encountered.
@@ -1197,6 +1247,11 @@ void mcsat_add_lemma(mcsat_solver_t* mcsat, ivector_t* lemma) {
   assert(unassigned.size > 0);
   assert(top_level <= mcsat->trail->decision_level);
 
+  // We never backtrack below the base level
+  if (top_level < mcsat->trail->decision_level_base) {
+    top_level = mcsat->trail->decision_level_base;
+  }
+
   // Backtrack to the appropriate level and do some progress
   if (unassigned.size == 1) {
     // UIP
@@ -1276,7 +1331,7 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
   uint32_t plugin_i;
   tracer_t* trace;
 
-  uint32_t conflict_level;
+  uint32_t conflict_level, base_level;
   variable_t var;
 
   ivector_t reason;
@@ -1307,14 +1362,19 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
     conflict_print(&conflict, trace->file);
   }
 
-  // Get the level of the conflict and backtrack to it
+  // Get the level of the conflict and backtrack to it (conflicts below the
+  // base level are conflicts at base level)
+  base_level = mcsat->trail->decision_level_base;
   conflict_level = conflict_get_level(&conflict);
+  if (conflict_level < base_level) {
+    conflict_level = base_level;
+  }
   mcsat_backtrack_to(mcsat, conflict_level);
 
   // Analyze while at least one variable at conflict level
   while (true) {
 
-    if (conflict_level == 0) {
+    if (conflict_level == base_level) {
       // Resolved all the way
       break;
     }
@@ -1366,6 +1426,9 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
       // We have resolved the conflict even lower
       conflict_recompute_level_info(&conflict);
       conflict_level = conflict_get_level(&conflict);
+      if (conflict_level < base_level) {
+        conflict_level = base_level;
+      }
       mcsat_backtrack_to(mcsat, conflict_level);
     }
   }
@@ -1376,9 +1439,9 @@ void mcsat_analyze_conflicts(mcsat_solver_t* mcsat, uint32_t* restart_resource)
   }
 
   // UIP conflict resolution
-  assert(conflict_level == 0 || conflict_get_top_level_vars_count(&conflict) == 1);
+  assert(conflict_level == base_level || conflict_get_top_level_vars_count(&conflict) == 1);
 
-  if (conflict_level == 0) {
+  if (conflict_level == base_level) {
     mcsat->status = STATUS_UNSAT;
   } else {
     // We should still be in conflict, so back out
@@ -1680,7 +1743,12 @@ int32_t mcsat_assert_formulas(mcsat_solver_t* mcsat, uint32_t n, const term_t *f
   // Delete the temp
   delete_ivector(&assertions);
 
-  return CTX_NO_ERROR;
+  // Conflict at base level
+  if (!trail_is_consistent(mcsat->trail)) {
+    mcsat->status = STATUS_UNSAT;
+  }
+
+  return mcsat->status == STATUS_UNSAT ? TRIVIALLY_UNSAT : CTX_NO_ERROR;
 }
 
 void mcsat_show_stats(mcsat_solver_t* mcsat, FILE* out) {
@@ -48,6 +48,12 @@ smt_status_t mcsat_status(const mcsat_solver_t* mcsat);
  */
 void mcsat_reset(mcsat_solver_t* mcsat);
 
+/*
+ * Clear the model after a check (status must be SAT or UNKNOWN): backtrack
+ * to the base level and reset the status to IDLE.
+ */
+void mcsat_clear(mcsat_solver_t* mcsat);
+
 /*
  * Push the user context.
  */
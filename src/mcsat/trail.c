@@ -151,6 +151,18 @@ void trail_add_decision(mcsat_trail_t* trail, variable_t x, const mcsat_value_t*
   ivector_push(&trail->elements, x);
 }
 
+/** Put back the propagations from lower levels that were popped */
+static
+void trail_repropagate(mcsat_trail_t* trail) {
+  variable_t x;
+  while (trail->to_repropagate.size > 0) {
+    x = ivector_last(&trail->to_repropagate);
+    ivector_pop(&trail->to_repropagate);
+    trail->index.data[x] = trail->elements.size;
+    ivector_push(&trail->elements, x);
+  }
+}
+
 void trail_pop_decision(mcsat_trail_t* trail) {
   variable_t x;
   // Undo the value with the addition of decision unmark
@@ -162,12 +174,7 @@ void trail_pop_decision(mcsat_trail_t* trail) {
   // Also, we're back into consistent
   trail->inconsistent = false;
   // Repropagate
-  while (trail->to_repropagate.size > 0) {
-    x = ivector_last(&trail->to_repropagate);
-    ivector_pop(&trail->to_repropagate);
-    trail->index.data[x] = trail->elements.size;
-    ivector_push(&trail->elements, x);
-  }
+  trail_repropagate(trail);
 }
 
 void trail_add_propagation(mcsat_trail_t* trail, variable_t x, const mcsat_value_t* value, uint32_t id, uint32_t level) {
@@ -205,6 +212,31 @@ void trail_pop(mcsat_trail_t* trail) {
   trail_pop_decision(trail);
 }
 
+void trail_new_base_level(mcsat_trail_t* trail) {
+  assert(trail_is_at_base_level(trail));
+  trail_new_decision(trail);
+  trail->decision_level_base ++;
+}
+
+void trail_pop_base_level(mcsat_trail_t* trail) {
+  uint32_t size;
+
+  assert(trail_is_at_base_level(trail));
+  assert(trail->decision_level_base > 0);
+
+  // Pop all the propagations at this level (there is no decision)
+  size = ivector_last(&trail->level_sizes);
+  while (trail->elements.size > size) {
+    trail_pop_propagation(trail);
+  }
+  trail_undo_decision(trail);
+  trail->decision_level_base --;
+  // We're back into consistent
+  trail->inconsistent = false;
+  // Repropagate
+  trail_repropagate(trail);
+}
+
 void trail_gc_mark(mcsat_trail_t* trail, gc_info_t* gc_vars) {
 
   uint32_t i;
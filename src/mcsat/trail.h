@@ -151,6 +151,16 @@ bool trail_has_value_at_base(const mcsat_trail_t* trail, variable_t var) {
   return trail->level.data[var] >= 0 && trail->level.data[var] <= trail->decision_level_base;
 }
 
+/**
+ * Returns true if the value of var is set at level 0. Unlike values at base
+ * level, these can never be undone (not even by popping a user scope).
+ */
+static inline
+bool trail_has_value_at_root(const mcsat_trail_t* trail, variable_t var) {
+  assert(var < trail->level.size);
+  return trail->level.data[var] == 0;
+}
+
 /** REturns true if the trail is at base level */
 static inline
 bool trail_is_at_base_level(const mcsat_trail_t* trail) {
@@ -224,6 +234,20 @@ void trail_pop_decision(mcsat_trail_t* trail);
 /** Pop all until (and including) the last decision */
 void trail_pop(mcsat_trail_t* trail);
 
+/**
+ * Start a new base level (user push). The trail must be at base level. The
+ * new level has no decision, it only holds the propagations done at the new
+ * base level.
+ */
+void trail_new_base_level(mcsat_trail_t* trail);
+
+/**
+ * Pop the base level (user pop). The trail must be at base level (> 0). All
+ * the values assigned at this level are removed and the base level is
+ * decreased.
+ */
+void trail_pop_base_level(mcsat_trail_t* trail);
+
 /** Get the log of unassigned variables (which you can/should clear) */
 static inline
 ivector_t* trail_get_unassigned(mcsat_trail_t* trail) {
@@ -467,7 +467,7 @@ void uf_feasible_set_db_get_conflict(uf_feasible_set_db_t* db, variable_t x, ive
 
 void uf_feasible_set_db_gc_mark(uf_feasible_set_db_t* db, gc_info_t* gc_vars) {
 
-  assert(db->trail->decision_level == 0);
+  assert(trail_is_at_base_level(db->trail));
 
   if (gc_vars->level == 0) {
     // We keep all the reasons (start from 1, 0 is not used)
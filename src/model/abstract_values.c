@@ -44,6 +44,7 @@
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
 #include "utils/prng.h"
+#include "utils/thread_local.h"
 
 
 
@@ -290,13 +291,13 @@ static particle_t build_tuple_particle(tuple_hobj_t *o) {
 /*
  * Hash consing objects
  */
-static label_hobj_t label_hobj = {
+static YICES_THREAD_LOCAL label_hobj_t label_hobj = {
   { (hobj_hash_t) hash_label, (hobj_eq_t) equal_label_particle, (hobj_build_t) build_label_particle },
   NULL,
   0,
 };
 
-static tuple_hobj_t tuple_hobj = {
+static YICES_THREAD_LOCAL tuple_hobj_t tuple_hobj = {
   { (hobj_hash_t) hash_tuple, (hobj_eq_t) equal_tuple_particle, (hobj_build_t) build_tuple_particle },
   NULL,
   0,
@@ -28,6 +28,7 @@
 #include "utils/hash_functions.h"
 #include "utils/int_array_sort.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 #ifdef HAVE_MCSAT
 #include <poly/algebraic_number.h>
@@ -1735,52 +1736,52 @@ static value_t build_update_value(update_hobj_t *o) {
 /*
  * Hash-consing objects for int_htbl
  */
-static rational_hobj_t rational_hobj = {
+static YICES_THREAD_LOCAL rational_hobj_t rational_hobj = {
   { (hobj_hash_t) hash_rational_value, (hobj_eq_t) equal_rational_value, (hobj_build_t) build_rational_value },
   NULL,
   NULL,
 };
 
-static algebraic_hobj_t algebraic_hobj = {
+static YICES_THREAD_LOCAL algebraic_hobj_t algebraic_hobj = {
   { (hobj_hash_t) hash_algebraic_value, (hobj_eq_t) equal_algebraic_value, (hobj_build_t) build_algebraic_value },
   NULL,
   NULL,
 };
 
-static const_hobj_t const_hobj = {
+static YICES_THREAD_LOCAL const_hobj_t const_hobj = {
   { (hobj_hash_t) hash_const_value, (hobj_eq_t) equal_const_value, (hobj_build_t) build_const_value },
   NULL,
   0,
   0,
 };
 
-static bv_hobj_t bv_hobj = {
+static YICES_THREAD_LOCAL bv_hobj_t bv_hobj = {
   { (hobj_hash_t) hash_bv_value, (hobj_eq_t) equal_bv_value, (hobj_build_t) build_bv_value },
   NULL,
   0, NULL,
 };
 
-static tuple_hobj_t tuple_hobj = {
+static YICES_THREAD_LOCAL tuple_hobj_t tuple_hobj = {
   { (hobj_hash_t) hash_tuple_value, (hobj_eq_t) equal_tuple_value, (hobj_build_t) build_tuple_value },
   NULL,
   0, NULL,
 };
 
-static map_hobj_t map_hobj = {
+static YICES_THREAD_LOCAL map_hobj_t map_hobj = {
   { (hobj_hash_t) hash_map_value, (hobj_eq_t) equal_map_value, (hobj_build_t) build_map_value },
   NULL,
   0, NULL, 0,
 };
 
 
-static fun_hobj_t fun_hobj = {
+static YICES_THREAD_LOCAL fun_hobj_t fun_hobj = {
   { (hobj_hash_t) hash_fun_value, (hobj_eq_t) equal_fun_value, (hobj_build_t) build_fun_value },
   NULL,
   0, 0, 0, 0, NULL,
 };
 
 
-static update_hobj_t update_hobj = {
+static YICES_THREAD_LOCAL update_hobj_t update_hobj = {
   { (hobj_hash_t) hash_update_value, (hobj_eq_t) equal_update_value, (hobj_build_t) build_update_value },
   NULL,
   0, 0, 0, 0, 0, 0, NULL,
@@ -25,6 +25,23 @@
 #include "utils/memalloc.h"
 
 
+/*
+ * Get the model's evaluator (create it if needed)
+ */
+static evaluator_t *model_get_evaluator(model_t *mdl) {
+  evaluator_t *eval;
+
+  eval = mdl->eval;
+  if (eval == NULL) {
+    eval = (evaluator_t *) safe_malloc(sizeof(evaluator_t));
+    init_evaluator(eval, mdl);
+    mdl->eval = eval;
+  }
+
+  return eval;
+}
+
+
 /*
  * Get the value of t in mdl
  * - this function first tries a simple lookup in mdl. If that fails,
@@ -38,14 +55,11 @@
  * Returns an index in mdl->vtbl otherwise (concrete value).
  */
 value_t model_get_term_value(model_t *mdl, term_t t) {
-  evaluator_t evaluator;
   value_t v;
 
   v = model_find_term_value(mdl, t);
   if (v == null_value) {
-    init_evaluator(&evaluator, mdl);
-    v = eval_in_model(&evaluator, t);
-    delete_evaluator(&evaluator);
+    v = eval_in_model(model_get_evaluator(mdl), t);
   }
 
   return v;
@@ -85,42 +99,23 @@ bool formula_holds_in_model(model_t *mdl, term_t f, int32_t *code) {
  * - return 0 otherwise.
  */
 int32_t evaluate_term_array(model_t *mdl, uint32_t n, const term_t a[], value_t b[]) {
-  evaluator_t evaluator;
-  uint32_t i, k;
+  evaluator_t *eval;
+  uint32_t i;
   value_t v;
 
+  eval = model_get_evaluator(mdl);
+  eval_terms_in_model(eval, a, n);
+
   /*
-   * First pass: simple eval of all terms.
-   * - k = number of terms, for which this fails
-   * - if simple eval fails for a[i], we have b[i] = null_value
+   * All values are now in the cache (unless there was an error)
    */
-  k = 0;
   for (i=0; i<n; i++) {
     v = model_find_term_value(mdl, a[i]);
-    b[i] = v;
-    if (v < 0) {
-      assert(v == null_value);
-      k ++;
-    }
-  }
-
-  /*
-   * Second pass: if k > 0, use the evaluator to complete array b
-   * Stop on the first error if any
-   */
-  if (k > 0) {
-    init_evaluator(&evaluator, mdl);
-    for (i=0; i<n; i++) {
-      if (b[i] < 0) {
-	v = eval_in_model(&evaluator, a[i]);
-	b[i] = v;
-	if (v < 0) break;
-      }
-    }
-    delete_evaluator(&evaluator);
-    if (v < 0) {
-      return v;
+    if (v == null_value) {
+      v = eval_in_model(eval, a[i]);
+      if (v < 0) return v;
     }
+    b[i] = v;
   }
 
   return 0;
@@ -134,7 +129,7 @@ int32_t evaluate_term_array(model_t *mdl, uint32_t n, const term_t a[], value_t
  *   the corresponding error code in *code
  */
 bool formulas_hold_in_model(model_t *mdl, uint32_t n, const term_t a[], int32_t *code) {
-  evaluator_t evaluator;
+  evaluator_t *eval;
   value_table_t *vtbl;
   uint32_t i;
   value_t v;
@@ -144,10 +139,10 @@ bool formulas_hold_in_model(model_t *mdl, uint32_t n, const term_t a[], int32_t
   *code = 0;
 
   vtbl = model_get_vtbl(mdl);
-  init_evaluator(&evaluator, mdl);
+  eval = model_get_evaluator(mdl);
   for (i=0; i<n; i++) {
     assert(is_boolean_term(mdl->terms, a[i]));
-    v = eval_in_model(&evaluator, a[i]);
+    v = eval_in_model(eval, a[i]);
     if (v < 0) {
       answer = false;
       *code = v;
@@ -158,7 +153,6 @@ bool formulas_hold_in_model(model_t *mdl, uint32_t n, const term_t a[], int32_t
       break;
     }
   }
-  delete_evaluator(&evaluator);
 
   return answer;    
 }
@@ -24,6 +24,7 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include "model/model_eval.h"
 #include "model/models.h"
 #include "utils/memalloc.h"
 
@@ -61,14 +62,29 @@ void init_model(model_t *model, term_table_t *terms, bool keep_subst) {
   model->alias_map = NULL;
   model->terms = terms;
   model->has_alias = keep_subst;
+  model->eval = NULL;
 
 }
 
 
+/*
+ * Delete the evaluator and its cache
+ * - the values computed by the evaluator stay in model->vtbl
+ */
+static void model_delete_evaluator(model_t *model) {
+  if (model->eval != NULL) {
+    delete_evaluator(model->eval);
+    safe_free(model->eval);
+    model->eval = NULL;
+  }
+}
+
+
 /*
  * Delete model: free all memory
  */
 void delete_model(model_t *model) {
+  model_delete_evaluator(model);
   delete_value_table(&model->vtbl);
   delete_int_hmap(&model->map);
   if (model->alias_map != NULL) {
@@ -139,6 +155,8 @@ void model_map_term(model_t *model, term_t t, value_t v) {
 
   assert(good_term(model->terms, t));
 
+  model_delete_evaluator(model);
+
   r = int_hmap_get(&model->map, t);
   assert(r->val < 0);
   r->val = v;
@@ -170,6 +188,8 @@ void model_add_substitution(model_t *model, term_t t, term_t u) {
          good_term(model->terms, u) && t != u && model->has_alias &&
          int_hmap_find(&model->map, t) == NULL);
 
+  model_delete_evaluator(model);
+
   alias = model->alias_map;
   if (alias == NULL) {
     alias = (int_hmap_t *) safe_malloc(sizeof(int_hmap_t));
@@ -284,6 +304,9 @@ static void mdl_mark_alias(void *aux, const int_hmap_pair_t *r) {
  *   to term_table_gc
  */
 void model_gc_mark(model_t *model) {
+  // the evaluator's cache may refer to terms that will be deleted
+  model_delete_evaluator(model);
+
   int_hmap_iterate(&model->map, model->terms, mdl_mark_map);
   if (model->alias_map != NULL) {
     int_hmap_iterate(model->alias_map, model->terms, mdl_mark_alias);
@@ -57,6 +57,10 @@
  * - has_alias: flag true if the model is intended to support
  *   the internal substitution table (alias_map). (NOTE: has_alias
  *   is set at construction time and it may be true even if alias_map is NULL).
+ * - eval = evaluator used by the queries in model_queries.h (allocated
+ *   on demand). Its cache is kept between queries so that shared subterms
+ *   are evaluated once. It's deleted when the model changes (new term
+ *   mapping or substitution) and before garbage collection.
  */
 struct model_s {
   value_table_t vtbl;
@@ -64,6 +68,7 @@ struct model_s {
   int_hmap_t *alias_map;
   term_table_t *terms;
   bool has_alias;
+  struct evaluator_s *eval;
 };
 
 
@@ -160,6 +165,7 @@ extern void model_collect_terms(model_t *model, bool all, void *aux, model_filte
  * Prepare for garbage collection: mark all the terms present in model
  * - all marked terms will be considered as roots on the next call
  *   to term_table_gc
+ * - the evaluator cache is deleted
  */
 extern void model_gc_mark(model_t *model);
 
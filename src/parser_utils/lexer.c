@@ -40,6 +40,7 @@ static void init_lexer(lexer_t *lex) {
   lex->tk_line = 0;
   lex->tk_column = 0;
   lex->next = NULL;
+  lex->pipe = NULL;
 
   lex->buffer = (string_buffer_t *) safe_malloc(sizeof(string_buffer_t));
   init_string_buffer(lex->buffer, 128);
@@ -57,9 +58,13 @@ static void init_lexer(lexer_t *lex) {
  * - token is set to -1
  */
 int32_t init_file_lexer(lexer_t *lex, const char *filename) {
+  return init_file_lexer_mode(lex, filename, READER_MODE_MAPPED);
+}
+
+int32_t init_file_lexer_mode(lexer_t *lex, const char *filename, reader_mode_t mode) {
   int32_t code;
 
-  code = init_file_reader(&lex->reader, filename);
+  code = init_file_reader_mode(&lex->reader, filename, mode);
   if (code >= 0) {
     init_lexer(lex);
   }
@@ -135,6 +140,7 @@ int32_t init_nested_lexer(lexer_t *lex, const char *filename, lexer_t *parent) {
   lex->tk_pos = 0;
   lex->tk_line = 0;
   lex->tk_column = 0;
+  lex->pipe = NULL;
 
   code = init_file_reader(&lex->reader, filename);
   if (code < 0) {
@@ -158,6 +164,7 @@ void init_nested_string_lexer(lexer_t *lex, const char *data, const char *name,
   lex->tk_pos = 0;
   lex->tk_line = 0;
   lex->tk_column = 0;
+  lex->pipe = NULL;
 
   init_string_reader(&lex->reader, data, name);
   lex->buffer = parent->buffer;
@@ -52,8 +52,12 @@ typedef int32_t token_t;
  * String buffer is shared by all lexers in the stack.
  * Keywords is a hash table for storing the keywords. (Removed,
  * we now use a perfect hash function, generated using gperf).
+ *
+ * If pipe is non-NULL, the tokens are produced by another thread
+ * and read from pipe (cf. frontend/smt2/smt2_pipeline.h).
  */
 typedef struct lexer_s lexer_t;
+typedef struct token_pipe_s token_pipe_t;
 
 struct lexer_s {
   token_t token;
@@ -62,6 +66,7 @@ struct lexer_s {
   reader_t reader;
   string_buffer_t *buffer;
   lexer_t *next;  // next in list = predecessor on lexer stack
+  token_pipe_t *pipe;
 };
 
 
@@ -88,6 +93,12 @@ typedef struct keyword_s {
  */
 extern int32_t init_file_lexer(lexer_t *lex, const char *filename);
 
+/*
+ * Variant: select the reader's input mode (cf. reader.h)
+ * - init_file_lexer uses READER_MODE_MAPPED
+ */
+extern int32_t init_file_lexer_mode(lexer_t *lex, const char *filename, reader_mode_t mode);
+
 /*
  * Variant: initialize from an open stream
  */
@@ -2930,16 +2930,39 @@ static void bit_blaster_partial_product(bit_blaster_t *s, literal_t *sum, litera
 }
 
 
+/*
+ * Number of bits of a that are not false_literal
+ * - a must be an array of n literals
+ */
+static uint32_t bit_blaster_count_nonzero(literal_t *a, uint32_t n) {
+  uint32_t i, k;
+
+  k = 0;
+  for (i=0; i<n; i++) {
+    k += (a[i] != false_literal);
+  }
+  return k;
+}
+
 /*
  * Assert u = (bvmul a b)
  * - a and b must be arrays of n literals
  * - u must be an array of n non-null pseudo literals
+ *
+ * We build one partial product per non-zero bit of b so we
+ * iterate over the operand that has fewer non-zero bits. If one
+ * operand is a constant, this turns the multiplication into a
+ * sequence of shift-and-add (one per '1' bit in the constant).
  */
 void bit_blaster_make_bvmul(bit_blaster_t *s, literal_t *a, literal_t *b, literal_t *u, uint32_t n) {
   ivector_t *v;
   literal_t *aux;
   uint32_t i;
 
+  if (bit_blaster_count_nonzero(b, n) > bit_blaster_count_nonzero(a, n)) {
+    aux = a; a = b; b = aux;
+  }
+
   v = &s->aux_vector2;
   resize_ivector(v, n);
   ivector_reset(v);
@@ -2967,6 +2990,36 @@ void bit_blaster_make_bvmul(bit_blaster_t *s, literal_t *a, literal_t *b, litera
 
 
 
+/*
+ * Assert (p == l) where p is a pseudo literal
+ */
+static void bit_blaster_pseudo_eq(bit_blaster_t *s, literal_t p, literal_t l) {
+  remap_table_t *rmap;
+  literal_t f;
+
+  rmap = s->remap;
+  f = remap_table_find(rmap, p);
+  if (f == null_literal) {
+    remap_table_assign(rmap, p, l); // p := l
+  } else {
+    bit_blaster_eq(s, f, l);
+  }
+}
+
+
+/*
+ * Assert (a == u) where a is an array of n literals
+ * and u is an array of n pseudo literals.
+ */
+static void bit_blaster_pseudo_bveq(bit_blaster_t *s, literal_t *u, literal_t *a, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    bit_blaster_pseudo_eq(s, u[i], a[i]);
+  }
+}
+
+
 /***************
  *  DIVISION   *
  **************/
@@ -3021,15 +3074,22 @@ static void bit_blaster_submul(bit_blaster_t *s, literal_t *a, literal_t *b, lit
 
 
 /*
- * Unsigned division:
- * - a and b must be literal arrays of size n
- * - q = either NULL or an array of n pseudo literals
- * - r = either NULL of an array of n pseudo literals
- *
- * Assert q = (bvudiv a b) and r = (bvurem a b)
+ * Number of significant bits in a: a[i] is false_literal for i >= k
+ * - a must be an array of n literals
  */
-void bit_blaster_make_udivision(bit_blaster_t *s, literal_t *a, literal_t *b,
-                                literal_t *q, literal_t *r, uint32_t n) {
+static uint32_t bit_blaster_active_width(literal_t *a, uint32_t n) {
+  while (n > 0 && a[n-1] == false_literal) {
+    n --;
+  }
+  return n;
+}
+
+
+/*
+ * Unsigned division on n bits: same spec as bit_blaster_make_udivision
+ */
+static void bit_blaster_udivision_core(bit_blaster_t *s, literal_t *a, literal_t *b,
+                                       literal_t *q, literal_t *r, uint32_t n) {
   remap_table_t *rmap;
   ivector_t *v;
   literal_t *aux;
@@ -3078,6 +3138,48 @@ void bit_blaster_make_udivision(bit_blaster_t *s, literal_t *a, literal_t *b,
 }
 
 
+/*
+ * Unsigned division:
+ * - a and b must be literal arrays of size n
+ * - q = either NULL or an array of n pseudo literals
+ * - r = either NULL of an array of n pseudo literals
+ *
+ * Assert q = (bvudiv a b) and r = (bvurem a b)
+ *
+ * If the high-order bits of a and b are all false (e.g., a and b
+ * are zero-extended), then the division is done on the low-order
+ * k bits only. The high-order bits of r are false and the
+ * high-order bits of q are all equal to (b == 0), since
+ * (bvudiv a 0) is 0b111...1.
+ */
+void bit_blaster_make_udivision(bit_blaster_t *s, literal_t *a, literal_t *b,
+                                literal_t *q, literal_t *r, uint32_t n) {
+  uint32_t i, k;
+  literal_t z;
+
+  k = bit_blaster_active_width(a, n);
+  i = bit_blaster_active_width(b, n);
+  if (k < i) k = i;
+  if (k == 0) k = 1;
+
+  bit_blaster_udivision_core(s, a, b, q, r, k);
+
+  if (k < n) {
+    if (q != NULL) {
+      z = not(bit_blaster_make_or(s, k, b)); // z := (b == 0)
+      for (i=k; i<n; i++) {
+        bit_blaster_pseudo_eq(s, q[i], z);
+      }
+    }
+    if (r != NULL) {
+      for (i=k; i<n; i++) {
+        bit_blaster_pseudo_eq(s, r[i], false_literal);
+      }
+    }
+  }
+}
+
+
 /*
  * SIGNED DIVISION
  */
@@ -3162,36 +3264,6 @@ static void bvneg_litarray(bit_blaster_t *s, literal_t *a, literal_t *b, uint32_
  }
 
 
-/*
- * Assert (p == l) where p is a pseudo literal
- */
-static void bit_blaster_pseudo_eq(bit_blaster_t *s, literal_t p, literal_t l) {
-  remap_table_t *rmap;
-  literal_t f;
-
-  rmap = s->remap;
-  f = remap_table_find(rmap, p);
-  if (f == null_literal) {
-    remap_table_assign(rmap, p, l); // p := l
-  } else {
-    bit_blaster_eq(s, f, l);
-  }
-}
-
-
-/*
- * Assert (a == u) where a is an array of n literals
- * and u is an array of n pseudo literals.
- */
-static void bit_blaster_pseudo_bveq(bit_blaster_t *s, literal_t *u, literal_t *a, uint32_t n) {
-  uint32_t i;
-
-  for (i=0; i<n; i++) {
-    bit_blaster_pseudo_eq(s, u[i], a[i]);
-  }
-}
-
-
 /*
  * Assert u == (if c then a else (bv-neg a))
  * - u is an array of n pseudo literals
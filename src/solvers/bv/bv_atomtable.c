@@ -23,6 +23,7 @@
 #include "solvers/bv/bv_atomtable.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 /*
@@ -165,7 +166,7 @@ static int32_t build_bvatm_hobj(bvatm_hobj_t *p) {
 }
 
 
-static bvatm_hobj_t bvatm_hobj = {
+static YICES_THREAD_LOCAL bvatm_hobj_t bvatm_hobj = {
   { (hobj_hash_t) hash_bvatm_hobj, (hobj_eq_t) eq_bvatm_hobj, (hobj_build_t) build_bvatm_hobj },
   NULL,
   0, 0, 0,
@@ -25,6 +25,7 @@
 #include "terms/bv_constants.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 /*
@@ -974,119 +975,119 @@ static thvar_t build_bvneg_hobj(bvop_hobj_t *p) {
 /*
  * Hash objects
  */
-static bvconst64_hobj_t bvconst64_hobj = {
+static YICES_THREAD_LOCAL bvconst64_hobj_t bvconst64_hobj = {
   { (hobj_hash_t) hash_bvconst64_hobj, (hobj_eq_t) eq_bvconst64_hobj, (hobj_build_t) build_bvconst64_hobj },
   NULL,
   0, 0,
 };
 
-static bvconst_hobj_t bvconst_hobj = {
+static YICES_THREAD_LOCAL bvconst_hobj_t bvconst_hobj = {
   { (hobj_hash_t) hash_bvconst_hobj, (hobj_eq_t) eq_bvconst_hobj, (hobj_build_t) build_bvconst_hobj },
   NULL,
   NULL, 0,
 };
 
-static bvpoly_hobj_t bvpoly64_hobj = {
+static YICES_THREAD_LOCAL bvpoly_hobj_t bvpoly64_hobj = {
   { (hobj_hash_t) hash_bvpoly64_hobj, (hobj_eq_t) eq_bvpoly64_hobj, (hobj_build_t) build_bvpoly64_hobj },
   NULL,
   NULL,
 };
 
-static bvpoly_hobj_t bvpoly_hobj = {
+static YICES_THREAD_LOCAL bvpoly_hobj_t bvpoly_hobj = {
   { (hobj_hash_t) hash_bvpoly_hobj, (hobj_eq_t) eq_bvpoly_hobj, (hobj_build_t) build_bvpoly_hobj },
   NULL,
   NULL,
 };
 
-static bvpprod_hobj_t bvpprod_hobj = {
+static YICES_THREAD_LOCAL bvpprod_hobj_t bvpprod_hobj = {
   { (hobj_hash_t) hash_bvpprod_hobj, (hobj_eq_t) eq_bvpprod_hobj, (hobj_build_t) build_bvpprod_hobj },
   NULL,
   NULL, 0,
 };
 
-static bvarray_hobj_t bvarray_hobj = {
+static YICES_THREAD_LOCAL bvarray_hobj_t bvarray_hobj = {
   { (hobj_hash_t) hash_bvarray_hobj, (hobj_eq_t) eq_bvarray_hobj, (hobj_build_t) build_bvarray_hobj },
   NULL,
   NULL, 0.
 };
 
-static bvite_hobj_t bvite_hobj = {
+static YICES_THREAD_LOCAL bvite_hobj_t bvite_hobj = {
   { (hobj_hash_t) hash_bvite_hobj, (hobj_eq_t) eq_bvite_hobj, (hobj_build_t) build_bvite_hobj },
   NULL,
   0, 0, 0, 0,
 };
 
-static bvop_hobj_t bvdiv_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvdiv_hobj = {
   { (hobj_hash_t) hash_bvdiv_hobj, (hobj_eq_t) eq_bvdiv_hobj, (hobj_build_t) build_bvdiv_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvrem_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvrem_hobj = {
   { (hobj_hash_t) hash_bvrem_hobj, (hobj_eq_t) eq_bvrem_hobj, (hobj_build_t) build_bvrem_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvsdiv_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvsdiv_hobj = {
   { (hobj_hash_t) hash_bvsdiv_hobj, (hobj_eq_t) eq_bvsdiv_hobj, (hobj_build_t) build_bvsdiv_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvsrem_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvsrem_hobj = {
   { (hobj_hash_t) hash_bvsrem_hobj, (hobj_eq_t) eq_bvsrem_hobj, (hobj_build_t) build_bvsrem_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvsmod_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvsmod_hobj = {
   { (hobj_hash_t) hash_bvsmod_hobj, (hobj_eq_t) eq_bvsmod_hobj, (hobj_build_t) build_bvsmod_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvshl_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvshl_hobj = {
   { (hobj_hash_t) hash_bvshl_hobj, (hobj_eq_t) eq_bvshl_hobj, (hobj_build_t) build_bvshl_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvlshr_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvlshr_hobj = {
   { (hobj_hash_t) hash_bvlshr_hobj, (hobj_eq_t) eq_bvlshr_hobj, (hobj_build_t) build_bvlshr_hobj },
   NULL,
   0, 0, 0,
 };
 
-static bvop_hobj_t bvashr_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvashr_hobj = {
   { (hobj_hash_t) hash_bvashr_hobj, (hobj_eq_t) eq_bvashr_hobj, (hobj_build_t) build_bvashr_hobj },
   NULL,
   0, 0, 0,
 };
 
 
-static bvop_hobj_t bvadd_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvadd_hobj = {
   { (hobj_hash_t) hash_bvadd_hobj, (hobj_eq_t) eq_bvadd_hobj, (hobj_build_t) build_bvadd_hobj },
   NULL,
   0, 0, 0,
 };
 
 
-static bvop_hobj_t bvsub_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvsub_hobj = {
   { (hobj_hash_t) hash_bvsub_hobj, (hobj_eq_t) eq_bvsub_hobj, (hobj_build_t) build_bvsub_hobj },
   NULL,
   0, 0, 0,
 };
 
 
-static bvop_hobj_t bvmul_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvmul_hobj = {
   { (hobj_hash_t) hash_bvmul_hobj, (hobj_eq_t) eq_bvmul_hobj, (hobj_build_t) build_bvmul_hobj },
   NULL,
   0, 0, 0,
 };
 
 
-static bvop_hobj_t bvneg_hobj = {
+static YICES_THREAD_LOCAL bvop_hobj_t bvneg_hobj = {
   { (hobj_hash_t) hash_bvneg_hobj, (hobj_eq_t) eq_bvneg_hobj, (hobj_build_t) build_bvneg_hobj },
   NULL,
   0, 0, 0,
@@ -30,6 +30,7 @@
 #include "utils/int_array_sort.h"
 #include "utils/int_array_sort2.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 
@@ -1304,61 +1305,61 @@ static bvnode_t build_bvc_sum_hobj(bvc_sum_hobj_t *p) {
 /*
  * Hash-consing objects
  */
-static bvc_leaf_hobj_t bvc_leaf_hobj = {
+static YICES_THREAD_LOCAL bvc_leaf_hobj_t bvc_leaf_hobj = {
   { (hobj_hash_t) hash_bvc_leaf_hobj, (hobj_eq_t) eq_bvc_leaf_hobj,
     (hobj_build_t) build_bvc_leaf_hobj },
   NULL, 0, 0
 };
 
-static bvc_zero_hobj_t bvc_zero_hobj = {
+static YICES_THREAD_LOCAL bvc_zero_hobj_t bvc_zero_hobj = {
   { (hobj_hash_t) hash_bvc_zero_hobj, (hobj_eq_t) eq_bvc_zero_hobj,
     (hobj_build_t) build_bvc_zero_hobj },
   NULL, 0
 };
 
-static bvc_const64_hobj_t bvc_const64_hobj = {
+static YICES_THREAD_LOCAL bvc_const64_hobj_t bvc_const64_hobj = {
   { (hobj_hash_t) hash_bvc_const64_hobj, (hobj_eq_t) eq_bvc_const64_hobj,
     (hobj_build_t) build_bvc_const64_hobj },
   NULL, 0, 0
 };
 
-static bvc_const_hobj_t bvc_const_hobj = {
+static YICES_THREAD_LOCAL bvc_const_hobj_t bvc_const_hobj = {
   { (hobj_hash_t) hash_bvc_const_hobj, (hobj_eq_t) eq_bvc_const_hobj,
     (hobj_build_t) build_bvc_const_hobj },
   NULL, NULL, 0
 };
 
-static bvc64_hobj_t bvc_offset64_hobj = {
+static YICES_THREAD_LOCAL bvc64_hobj_t bvc_offset64_hobj = {
   { (hobj_hash_t) hash_bvc_offset64_hobj, (hobj_eq_t) eq_bvc_offset64_hobj,
     (hobj_build_t) build_bvc_offset64_hobj },
   NULL, 0, 0, 0
 };
 
-static bvc_hobj_t bvc_offset_hobj = {
+static YICES_THREAD_LOCAL bvc_hobj_t bvc_offset_hobj = {
   { (hobj_hash_t) hash_bvc_offset_hobj, (hobj_eq_t) eq_bvc_offset_hobj,
     (hobj_build_t) build_bvc_offset_hobj },
   NULL, NULL, 0, 0
 };
 
-static bvc64_hobj_t bvc_mono64_hobj = {
+static YICES_THREAD_LOCAL bvc64_hobj_t bvc_mono64_hobj = {
   { (hobj_hash_t) hash_bvc_mono64_hobj, (hobj_eq_t) eq_bvc_mono64_hobj,
     (hobj_build_t) build_bvc_mono64_hobj },
   NULL, 0, 0, 0
 };
 
-static bvc_hobj_t bvc_mono_hobj = {
+static YICES_THREAD_LOCAL bvc_hobj_t bvc_mono_hobj = {
   { (hobj_hash_t) hash_bvc_mono_hobj, (hobj_eq_t) eq_bvc_mono_hobj,
     (hobj_build_t) build_bvc_mono_hobj },
   NULL, NULL, 0, 0
 };
 
-static bvc_prod_hobj_t bvc_prod_hobj = {
+static YICES_THREAD_LOCAL bvc_prod_hobj_t bvc_prod_hobj = {
   { (hobj_hash_t) hash_bvc_prod_hobj, (hobj_eq_t) eq_bvc_prod_hobj,
     (hobj_build_t) build_bvc_prod_hobj },
   NULL, NULL, 0, 0,
 };
 
-static bvc_sum_hobj_t bvc_sum_hobj = {
+static YICES_THREAD_LOCAL bvc_sum_hobj_t bvc_sum_hobj = {
   { (hobj_hash_t) hash_bvc_sum_hobj, (hobj_eq_t) eq_bvc_sum_hobj,
     (hobj_build_t) build_bvc_sum_hobj },
   NULL, NULL, 0, 0,
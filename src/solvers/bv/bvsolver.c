@@ -437,9 +437,12 @@ static void init_bv_trail(bv_trail_stack_t *stack) {
  * - ndm = number of delayed mapped variables
  * - ndb = number of delayed blasted variables
  * - bb = bitblast pointer
+ * - nl = size of the lazy queue
+ * - nu = size of the lazy undo vector
  */
 static void bv_trail_save(bv_trail_stack_t *stack, uint32_t nv, uint32_t na, uint32_t nb,
-                          uint32_t ns, uint32_t ndm, uint32_t ndb, uint32_t bb) {
+                          uint32_t ns, uint32_t ndm, uint32_t ndb, uint32_t bb,
+                          uint32_t nl, uint32_t nu) {
   uint32_t i, n;
 
   i = stack->top;
@@ -466,6 +469,8 @@ static void bv_trail_save(bv_trail_stack_t *stack, uint32_t nv, uint32_t na, uin
   stack->data[i].ndelayed_mapped = ndm;
   stack->data[i].ndelayed_blasted = ndb;
   stack->data[i].nbblasted = bb;
+  stack->data[i].nlazy = nl;
+  stack->data[i].nlazy_undo = nu;
 
   stack->top = i+1;
 }
@@ -523,6 +528,9 @@ static void init_bv_stats(bv_stats_t *s) {
   s->equiv_conflicts = 0;
   s->half_equiv_lemmas = 0;
   s->interface_lemmas = 0;
+  s->lazy_vars = 0;
+  s->lazy_expansions = 0;
+  s->narrowed_ops = 0;
 }
 
 static inline void reset_bv_stats(bv_stats_t *s) {
@@ -1374,6 +1382,149 @@ static void bit_blaster_make_bvop(bit_blaster_t *blaster, bvvar_tag_t op, litera
 }
 
 
+/*
+ * WORD-LEVEL BOUNDS
+ *
+ * For x = (bvadd a b) or x = (bvmul a b), we compute an upper bound
+ * on the unsigned value of x from the bounds on a and b. If this bound
+ * is less than 2^k for some k < n, then the n-k high-order bits of x
+ * are false. The k low-order bits of (bvadd a b) and (bvmul a b) depend
+ * only on the k low-order bits of a and b, so we build the circuit on
+ * k bits and skip the rest.
+ *
+ * The bounds on a and b are obtained from their literals. Since the
+ * operands are bit-blasted first, the high-order bits of a narrowed
+ * adder or multiplier are false and the bounds propagate through
+ * chains of additions and multiplications.
+ */
+static void bitarray_bounds_unsigned64(literal_t *a, uint32_t n, bv64_interval_t *intv);
+
+/*
+ * Number of bits required to represent x
+ */
+static uint32_t uint64_width(uint64_t x) {
+  uint32_t k;
+
+  k = 0;
+  while (x != 0) {
+    x >>= 1;
+    k ++;
+  }
+  return k;
+}
+
+/*
+ * Number of bits of a, not counting the high-order bits that are false
+ * - n = size of a
+ */
+static uint32_t bitarray_unsigned_width(literal_t *a, uint32_t n) {
+  while (n > 0 && a[n-1] == false_literal) {
+    n --;
+  }
+  return n;
+}
+
+/*
+ * Upper bound on the number of significant bits of (op a b)
+ * - op must be BVTAG_ADD or BVTAG_MUL
+ * - a and b must be arrays of n literals
+ * - the result is between 0 and n
+ */
+static uint32_t bvop_result_width(bvvar_tag_t op, literal_t *a, literal_t *b, uint32_t n) {
+  bv64_interval_t ia, ib;
+  uint32_t ka, kb, k;
+
+  assert(op == BVTAG_ADD || op == BVTAG_MUL);
+
+  if (n <= 64) {
+    bitarray_bounds_unsigned64(a, n, &ia);
+    bitarray_bounds_unsigned64(b, n, &ib);
+    if (op == BVTAG_ADD) {
+      bv64_interval_add_u(&ia, &ib);
+      return uint64_width(ia.high);
+    }
+    if (ia.high != 0 && ib.high > mask64(n)/ia.high) {
+      return n; // the product may overflow
+    }
+    return uint64_width(ia.high * ib.high);
+  }
+
+  ka = bitarray_unsigned_width(a, n);
+  kb = bitarray_unsigned_width(b, n);
+  if (op == BVTAG_ADD) {
+    k = (ka > kb ? ka : kb) + 1;
+  } else {
+    k = (ka == 0 || kb == 0) ? 0 : ka + kb;
+  }
+
+  return k < n ? k : n;
+}
+
+
+/*
+ * Upper bound on the number of significant bits of (bvurem a b)
+ * - if b is known to be non-zero then (bvurem a b) < b
+ * - otherwise (bvurem a b) <= a
+ */
+static uint32_t bvurem_result_width(literal_t *a, literal_t *b, uint32_t n) {
+  uint32_t i, ka, kb;
+
+  ka = bitarray_unsigned_width(a, n);
+  kb = bitarray_unsigned_width(b, n);
+  for (i=0; i<kb; i++) {
+    if (b[i] == true_literal) {
+      return ka < kb ? ka : kb;
+    }
+  }
+  return ka;
+}
+
+
+/*
+ * Assert that the pseudo literals u[k ... n-1] are false
+ */
+static void bv_solver_clear_high_bits(bv_solver_t *solver, literal_t *u, uint32_t k, uint32_t n) {
+  remap_table_t *rmap;
+  uint32_t i;
+  literal_t l;
+
+  rmap = solver->remap;
+  for (i=k; i<n; i++) {
+    l = remap_table_find(rmap, u[i]);
+    if (l == null_literal) {
+      remap_table_assign(rmap, u[i], false_literal);
+    } else {
+      bit_blaster_eq(solver->blaster, l, false_literal);
+    }
+  }
+}
+
+
+/*
+ * Assert (u == (op a b)) for one of the binary operators op
+ * - build the circuit on fewer bits if the high-order bits of
+ *   (bvadd a b) or (bvmul a b) are known to be zero
+ */
+static void bv_solver_make_bvop(bv_solver_t *solver, bvvar_tag_t op, literal_t *a, literal_t *b,
+                                literal_t *u, uint32_t n) {
+  uint32_t k;
+
+  if (op == BVTAG_ADD || op == BVTAG_MUL) {
+    k = bvop_result_width(op, a, b, n);
+    if (k < n) {
+      if (k > 0) {
+        bit_blaster_make_bvop(solver->blaster, op, a, b, u, k);
+      }
+      bv_solver_clear_high_bits(solver, u, k, n);
+      solver->stats.narrowed_ops ++;
+      return;
+    }
+  }
+
+  bit_blaster_make_bvop(solver->blaster, op, a, b, u, n);
+}
+
+
 /*
  * Assert (u == (op a b)) for a division/remainder term (op x y)
  * - a and b must be arrays of n literals
@@ -1461,6 +1612,60 @@ static void collect_bvvar_literals(bv_solver_t *solver, thvar_t x, ivector_t *v)
 
 
 
+/*
+ * Check whether x = (op y z) can be bit-blasted lazily
+ * - this is done for division and remainder, and for
+ *   multiplication if neither y nor z is a constant.
+ */
+static bool bvvar_is_lazy_op(bv_solver_t *solver, bvvar_tag_t op, thvar_t y, thvar_t z) {
+  bv_vartable_t *vtbl;
+
+  if (! solver->lazy_blasting) return false;
+
+  vtbl = &solver->vtbl;
+
+  switch (op) {
+  case BVTAG_UDIV:
+  case BVTAG_UREM:
+  case BVTAG_SDIV:
+  case BVTAG_SREM:
+  case BVTAG_SMOD:
+    return true;
+
+  case BVTAG_MUL:
+    return !bvvar_is_const64(vtbl, y) && !bvvar_is_const64(vtbl, z) &&
+      !bvvar_is_const(vtbl, y) && !bvvar_is_const(vtbl, z);
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Lazy bit-blasting of x:
+ * - complete the pseudo map u of x with fresh literals
+ * - add x to the lazy queue
+ * - n = number of bits in x
+ */
+static void bv_solver_defer_bitblasting(bv_solver_t *solver, thvar_t x, literal_t *u, uint32_t n) {
+  remap_table_t *rmap;
+  uint32_t i;
+  literal_t l;
+
+  rmap = solver->remap;
+  for (i=0; i<n; i++) {
+    l = remap_table_find(rmap, u[i]);
+    if (l == null_literal) {
+      l = bit_blaster_fresh_literal(solver->blaster);
+      remap_table_assign(rmap, u[i], l);
+    }
+  }
+  bv_queue_push(&solver->lazy_queue, x);
+  solver->stats.lazy_vars ++;
+}
+
+
 /*
  * Recursive bit-blasting:
  * - if x is bitblasted already: do nothing
@@ -1571,11 +1776,20 @@ static void bv_solver_bitblast_variable(bv_solver_t *solver, thvar_t x) {
         z = vtbl->def[x].op[1];
         bv_solver_bitblast_variable(solver, y);
         bv_solver_bitblast_variable(solver, z);
+        if (bvvar_is_lazy_op(solver, op, y, z)) {
+          bv_solver_defer_bitblasting(solver, x, u, n);
+          break;
+        }
         a = &solver->a_vector;
         b = &solver->b_vector;
         collect_bvvar_literals(solver, y, a);
         collect_bvvar_literals(solver, z, b);
         assert(a->size == n && b->size == n);
+        if (op == BVTAG_UREM) {
+          // the divider circuit implies that these bits are false:
+          // fix them first so that the operations that use x see them
+          bv_solver_clear_high_bits(solver, u, bvurem_result_width(a->data, b->data, n), n);
+        }
         bit_blaster_make_bvdivop(solver, op, y, z, a->data, b->data, u, n);
         break;
 
@@ -1590,12 +1804,16 @@ static void bv_solver_bitblast_variable(bv_solver_t *solver, thvar_t x) {
         z = vtbl->def[x].op[1];
         bv_solver_bitblast_variable(solver, y);
         bv_solver_bitblast_variable(solver, z);
+        if (bvvar_is_lazy_op(solver, op, y, z)) {
+          bv_solver_defer_bitblasting(solver, x, u, n);
+          break;
+        }
         a = &solver->a_vector;
         b = &solver->b_vector;
         collect_bvvar_literals(solver, y, a);
         collect_bvvar_literals(solver, z, b);
         assert(a->size == n && b->size == n);
-        bit_blaster_make_bvop(solver->blaster, op, a->data, b->data, u, n);
+        bv_solver_make_bvop(solver, op, a->data, b->data, u, n);
         break;
 
       case BVTAG_NEG:
@@ -6892,6 +7110,123 @@ thvar_t bv_solver_create_on_the_fly_var(bv_solver_t *solver, uint32_t n) {
 
 
 
+/***********************
+ *  LAZY BIT-BLASTING  *
+ **********************/
+
+/*
+ * Forward declarations: defined in the model construction section
+ */
+static bool get_bitblasted_var_value(bv_solver_t *solver, thvar_t x, uint32_t *c);
+static void eval_bvop(bvvar_tag_t op, uint32_t *c, uint32_t n, uint32_t *a1, uint32_t *a2);
+
+
+/*
+ * Build the circuit for x = (op y z) that was deferred in bv_solver_defer_bitblasting
+ * - y and z are bit-blasted already
+ * - x is mapped to an array of pseudo literals with a literal assigned to each
+ */
+static void bv_solver_expand_lazy_var(bv_solver_t *solver, thvar_t x) {
+  bv_vartable_t *vtbl;
+  ivector_t *a, *b;
+  literal_t *u;
+  uint32_t n;
+  bvvar_tag_t op;
+  thvar_t y, z;
+
+  vtbl = &solver->vtbl;
+
+  assert(bvvar_is_bitblasted(vtbl, x));
+
+  op = bvvar_tag(vtbl, x);
+  n = bvvar_bitsize(vtbl, x);
+  u = bvvar_get_map(vtbl, x);
+  y = vtbl->def[x].op[0];
+  z = vtbl->def[x].op[1];
+
+  a = &solver->a_vector;
+  b = &solver->b_vector;
+  collect_bvvar_literals(solver, y, a);
+  collect_bvvar_literals(solver, z, b);
+  assert(a->size == n && b->size == n);
+
+  switch (op) {
+  case BVTAG_UDIV:
+    bit_blaster_make_udivision(solver->blaster, a->data, b->data, u, NULL, n);
+    break;
+
+  case BVTAG_UREM:
+    bit_blaster_make_udivision(solver->blaster, a->data, b->data, NULL, u, n);
+    break;
+
+  case BVTAG_SDIV:
+    bit_blaster_make_sdivision(solver->blaster, a->data, b->data, u, NULL, n);
+    break;
+
+  case BVTAG_SREM:
+    bit_blaster_make_sdivision(solver->blaster, a->data, b->data, NULL, u, n);
+    break;
+
+  default:
+    bv_solver_make_bvop(solver, op, a->data, b->data, u, n);
+    break;
+  }
+}
+
+
+/*
+ * Check all the deferred variables in the lazy queue.
+ * - for each x = (op y z) in the queue, compare the value of x in
+ *   the current assignment with (op val(y) val(z)).
+ * - if they differ, build the circuit for x and remove x from the queue
+ * - return the number of circuits built
+ */
+static uint32_t bv_solver_check_lazy_vars(bv_solver_t *solver) {
+  bv_vartable_t *vtbl;
+  bv_queue_t *queue;
+  bvconstant_t *c1, *c2, *c3;
+  uint32_t i, n, k, count;
+  thvar_t x;
+
+  vtbl = &solver->vtbl;
+  queue = &solver->lazy_queue;
+  c1 = &solver->aux1;
+  c2 = &solver->aux2;
+  c3 = &solver->aux3;
+
+  count = 0;
+  for (i=0; i<queue->top; i++) {
+    x = queue->data[i];
+    if (x == null_thvar) continue;
+
+    n = bvvar_bitsize(vtbl, x);
+    k = (n + 31) >> 5;
+    bvconstant_set_bitsize(c1, n);
+    bvconstant_set_bitsize(c2, n);
+    bvconstant_set_bitsize(c3, n);
+
+    // c3 := (op val(y) val(z)) then c1 := val(x)
+    if (get_bitblasted_var_value(solver, vtbl->def[x].op[0], c1->data) &&
+        get_bitblasted_var_value(solver, vtbl->def[x].op[1], c2->data)) {
+      eval_bvop(bvvar_tag(vtbl, x), c3->data, n, c1->data, c2->data);
+      if (get_bitblasted_var_value(solver, x, c1->data) &&
+          bvconst_eq(c1->data, c3->data, k)) continue;
+    }
+
+    bv_solver_expand_lazy_var(solver, x);
+    queue->data[i] = null_thvar;
+    ivector_push(&solver->lazy_undo, i);
+    ivector_push(&solver->lazy_undo, x);
+    count ++;
+  }
+
+  solver->stats.lazy_expansions += count;
+
+  return count;
+}
+
+
+
 /**********************
  *  SOLVER INTERFACE  *
  *********************/
@@ -6944,9 +7279,13 @@ bool bv_solver_propagate(bv_solver_t *solver) {
 }
 
 /*
- * Final check: nothing to do
+ * Final check: build the circuits of deferred variables whose
+ * value is not consistent with the current assignment.
  */
 fcheck_code_t bv_solver_final_check(bv_solver_t *solver) {
+  if (solver->lazy_queue.top > 0 && bv_solver_check_lazy_vars(solver) > 0) {
+    return FCHECK_CONTINUE;
+  }
   return FCHECK_SAT;
 }
 
@@ -7021,6 +7360,9 @@ void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egraph) {
   solver->decision_level = 0;
   solver->bitblasted = false;
   solver->bbptr = 0;
+  solver->lazy_blasting = false;
+  init_bv_queue(&solver->lazy_queue);
+  init_ivector(&solver->lazy_undo, 0);
 
   init_bv_vartable(&solver->vtbl);
   init_bv_atomtable(&solver->atbl);
@@ -7068,6 +7410,14 @@ void bv_solver_init_jmpbuf(bv_solver_t *solver, jmp_buf *buffer) {
 }
 
 
+/*
+ * Enable/disable lazy bit-blasting
+ */
+void bv_solver_set_lazy_blasting(bv_solver_t *solver, bool flag) {
+  solver->lazy_blasting = flag;
+}
+
+
 /*
  * Delete solver
  */
@@ -7112,6 +7462,8 @@ void delete_bv_solver(bv_solver_t *solver) {
   delete_bv_queue(&solver->select_queue);
   delete_bv_queue(&solver->delayed_mapped);
   delete_bv_queue(&solver->delayed_blasted);
+  delete_bv_queue(&solver->lazy_queue);
+  delete_ivector(&solver->lazy_undo);
   delete_bv_trail(&solver->trail_stack);
 
   delete_bvpoly_buffer(&solver->buffer);
@@ -7141,7 +7493,7 @@ void delete_bv_solver(bv_solver_t *solver) {
  * Start a new base level
  */
 void bv_solver_push(bv_solver_t *solver) {
-  uint32_t na, nv, nb, ns, ndm, ndb, bb;
+  uint32_t na, nv, nb, ns, ndm, ndb, bb, nl, nu;
 
   assert(solver->decision_level == solver->base_level &&
          all_bvvars_unmarked(solver));
@@ -7153,8 +7505,10 @@ void bv_solver_push(bv_solver_t *solver) {
   ndm = solver->delayed_mapped.top;
   ndb = solver->delayed_blasted.top;
   bb = solver->bbptr;
+  nl = solver->lazy_queue.top;
+  nu = solver->lazy_undo.size;
 
-  bv_trail_save(&solver->trail_stack, nv, na, nb, ns, ndm, ndb, bb);
+  bv_trail_save(&solver->trail_stack, nv, na, nb, ns, ndm, ndb, bb, nl, nu);
 
   mtbl_push(&solver->mtbl);
 
@@ -7240,6 +7594,29 @@ static void bv_solver_clean_delayed_blasted_vars(bv_solver_t *solver, uint32_t n
 
 
 
+/*
+ * Restore the entries of the lazy queue that were removed since the
+ * corresponding push
+ * - n = size of the lazy_undo vector at that push
+ */
+static void bv_solver_restore_lazy_queue(bv_solver_t *solver, uint32_t n) {
+  ivector_t *v;
+  uint32_t i, k;
+
+  v = &solver->lazy_undo;
+  i = v->size;
+  assert(n <= i && ((i - n) & 1) == 0);
+
+  while (i > n) {
+    i -= 2;
+    k = v->data[i];
+    assert(k < solver->lazy_queue.top && solver->lazy_queue.data[k] == null_thvar);
+    solver->lazy_queue.data[k] = v->data[i+1];
+  }
+  ivector_shrink(v, n);
+}
+
+
 /*
  * Remove the map of variables that will be removed from the select queue
  * - n = number of variables that will remain in the select_queue
@@ -7307,6 +7684,12 @@ void bv_solver_pop(bv_solver_t *solver) {
   bv_solver_clean_delayed_blasted_vars(solver, top->ndelayed_blasted);
   solver->delayed_blasted.top = top->ndelayed_blasted;
 
+  /*
+   * Restore the lazy queue
+   */
+  bv_solver_restore_lazy_queue(solver, top->nlazy_undo);
+  solver->lazy_queue.top = top->nlazy;
+
   /*
    * remove vars in the select queue
    */
@@ -7383,6 +7766,8 @@ void bv_solver_reset(bv_solver_t *solver) {
   reset_bv_queue(&solver->select_queue);
   reset_bv_queue(&solver->delayed_mapped);
   reset_bv_queue(&solver->delayed_blasted);
+  reset_bv_queue(&solver->lazy_queue);
+  ivector_reset(&solver->lazy_undo);
   reset_bv_trail(&solver->trail_stack);
 
   reset_bvpoly_buffer(&solver->buffer, 32);
@@ -8155,6 +8540,69 @@ static bool bv_solver_neg_value(bv_solver_t *solver, thvar_t x, uint32_t n, uint
 }
 
 
+/*
+ * Compute (op a1 a2) for a binary operator op
+ * - store the result in c
+ * - n = number of bits in a1, a2, and c
+ */
+static void eval_bvop(bvvar_tag_t op, uint32_t *c, uint32_t n, uint32_t *a1, uint32_t *a2) {
+  uint32_t k;
+
+  k = (n + 31) >> 5;
+  switch (op) {
+  case BVTAG_UDIV:
+    bvconst_udiv2z(c, n, a1, a2);
+    break;
+
+  case BVTAG_UREM:
+    bvconst_urem2z(c, n, a1, a2);
+    break;
+
+  case BVTAG_SDIV:
+    bvconst_sdiv2z(c, n, a1, a2);
+    break;
+
+  case BVTAG_SREM:
+    bvconst_srem2z(c, n, a1, a2);
+    break;
+
+  case BVTAG_SMOD:
+    bvconst_smod2z(c, n, a1, a2);
+    break;
+
+  case BVTAG_SHL:
+    bvconst_lshl(c, a1, a2, n);
+    break;
+
+  case BVTAG_LSHR:
+    bvconst_lshr(c, a1, a2, n);
+    break;
+
+  case BVTAG_ASHR:
+    bvconst_ashr(c, a1, a2, n);
+    break;
+
+  case BVTAG_ADD:
+    bvconst_add2(c, k, a1, a2);
+    break;
+
+  case BVTAG_SUB:
+    bvconst_sub2(c, k, a1, a2);
+    break;
+
+  case BVTAG_MUL:
+    bvconst_mul2(c, k, a1, a2);
+    break;
+
+  default:
+    assert(false);
+    break;
+  }
+
+  bvconst_normalize(c, n);
+}
+
+
 /*
  * Get the values of x[0] and x[1] the apply op to this pair of values
  * - store the result in c
@@ -8180,57 +8628,7 @@ static bool bv_solver_binop_value(bv_solver_t *solver, bvvar_tag_t op, thvar_t x
     && bv_solver_get_variable_value(solver, x[1], a2);
 
   if (found) {
-    switch (op) {
-    case BVTAG_UDIV:
-      bvconst_udiv2z(c, n, a1, a2);
-      break;
-
-    case BVTAG_UREM:
-      bvconst_urem2z(c, n, a1, a2);
-      break;
-
-    case BVTAG_SDIV:
-      bvconst_sdiv2z(c, n, a1, a2);
-      break;
-
-    case BVTAG_SREM:
-      bvconst_srem2z(c, n, a1, a2);
-      break;
-
-    case BVTAG_SMOD:
-      bvconst_smod2z(c, n, a1, a2);
-      break;
-
-    case BVTAG_SHL:
-      bvconst_lshl(c, a1, a2, n);
-      break;
-
-    case BVTAG_LSHR:
-      bvconst_lshr(c, a1, a2, n);
-      break;
-
-    case BVTAG_ASHR:
-      bvconst_ashr(c, a1, a2, n);
-      break;
-
-    case BVTAG_ADD:
-      bvconst_add2(c, k, a1, a2);
-      break;
-
-    case BVTAG_SUB:
-      bvconst_sub2(c, k, a1, a2);
-      break;
-
-    case BVTAG_MUL:
-      bvconst_mul2(c, k, a1, a2);
-      break;
-
-    default:
-      assert(false);
-      break;
-    }
-
-    bvconst_normalize(c, n);
+    eval_bvop(op, c, n, a1, a2);
   }
 
 
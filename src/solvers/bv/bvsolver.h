@@ -43,6 +43,13 @@ extern void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egra
 extern void bv_solver_init_jmpbuf(bv_solver_t *solver, jmp_buf *buffer);
 
 
+/*
+ * Enable/disable lazy bit-blasting of multiplication, division,
+ * and remainder (disabled by default)
+ */
+extern void bv_solver_set_lazy_blasting(bv_solver_t *solver, bool flag);
+
+
 /*
  * Delete solver
  */
@@ -252,6 +259,26 @@ static inline uint32_t bv_solver_num_sge_atoms(bv_solver_t *solver) {
 }
 
 
+/*
+ * Lazy bit-blasting statistics
+ */
+static inline uint32_t bv_solver_lazy_vars(bv_solver_t *solver) {
+  return solver->stats.lazy_vars; // operators whose bit-blasting was deferred
+}
+
+static inline uint32_t bv_solver_lazy_expansions(bv_solver_t *solver) {
+  return solver->stats.lazy_expansions; // deferred operators bit-blasted in final check
+}
+
+/*
+ * Number of adders and multipliers whose high-order bits were known
+ * to be zero (and were not bit-blasted)
+ */
+static inline uint32_t bv_solver_narrowed_ops(bv_solver_t *solver) {
+  return solver->stats.narrowed_ops;
+}
+
+
 /*
  * Search statistics: these counters are all zero unless the solver
  * is attached to the egraph
@@ -269,6 +296,14 @@ static inline uint32_t bv_solver_interface_lemmas(bv_solver_t *solver) {
 }
 
 
+/*
+ * Gates built by the bit-blaster (NULL if nothing has been bit-blasted yet)
+ */
+static inline gate_table_t *bv_solver_gate_table(bv_solver_t *solver) {
+  return solver->blaster != NULL ? &solver->blaster->htbl : NULL;
+}
+
+
 
 /************************
  *  MODEL CONSTRUCTION  *
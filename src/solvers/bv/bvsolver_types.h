@@ -210,6 +210,8 @@ typedef struct bv_trail_s {
   uint32_t ndelayed_mapped;
   uint32_t ndelayed_blasted;
   uint32_t nbblasted;
+  uint32_t nlazy;
+  uint32_t nlazy_undo;
 } bv_trail_t;
 
 typedef struct bv_trail_stack_s {
@@ -272,6 +274,9 @@ typedef struct bv_stats_s {
   uint32_t equiv_conflicts;
   uint32_t half_equiv_lemmas;
   uint32_t interface_lemmas;
+  uint32_t lazy_vars;          // number of operators not bit-blasted eagerly
+  uint32_t lazy_expansions;    // number of those bit-blasted in final check
+  uint32_t narrowed_ops;       // number of add/mul circuits built on fewer bits
 } bv_stats_t;
 
 
@@ -300,6 +305,21 @@ typedef struct bv_solver_s {
   bool bitblasted;
   uint32_t bbptr;
 
+  /*
+   * Lazy bit-blasting: if lazy_blasting is true, then the circuits
+   * for multiplication, division, and remainder are not built when
+   * a variable x = (op y z) is bit-blasted. Instead, x is mapped to
+   * fresh literals and added to lazy_queue. In final_check, we
+   * compare the value of x with (op y z) in the current assignment
+   * and build the circuit for x only if they disagree.
+   * - once x's circuit is built, its entry in lazy_queue is replaced
+   *   by null_thvar and the pair [index, x] is pushed into lazy_undo
+   *   so that the entry can be restored on pop.
+   */
+  bool lazy_blasting;
+  bv_queue_t lazy_queue;
+  ivector_t lazy_undo;
+
   /*
    * Variable + atom tables
    */
@@ -0,0 +1,315 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CLAUSE EXCHANGE BETWEEN PORTFOLIO WORKERS
+ */
+
+#include <assert.h>
+
+#if !defined(MINGW)
+#include <sys/mman.h>
+#endif
+
+#include "solvers/cdcl/clause_exchange.h"
+#include "utils/memalloc.h"
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+
+/*
+ * Header word of a clause of n literals with the given lbd
+ */
+static inline int32_t cx_header(uint32_t n, uint32_t lbd) {
+  assert(n <= CX_MAX_CLAUSE_SIZE && lbd <= n);
+  return (int32_t) (n | (lbd << 16));
+}
+
+static inline uint32_t cx_header_size(int32_t h) {
+  return ((uint32_t) h) & 0xFFFF;
+}
+
+static inline uint32_t cx_header_lbd(int32_t h) {
+  return ((uint32_t) h) >> 16;
+}
+
+
+/*
+ * Initialization
+ */
+bool init_clause_exchange(clause_exchange_t *cx, uint32_t n, uint32_t nvars, uint32_t max_lbd) {
+#if !defined(MINGW) && defined(MAP_ANONYMOUS)
+  void *p;
+  size_t size;
+
+  assert(max_lbd > 0);
+
+  size = sizeof(cx_shared_t) + n * sizeof(cx_ring_t) + nvars;
+  p = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) {
+    return false;
+  }
+
+  // mmap returns zeroed memory: all rings are empty
+  cx->nworkers = n;
+  cx->nvars = nvars;
+  cx->max_lbd = max_lbd;
+  cx->id = 0;
+  cx->shared = (cx_shared_t *) p;
+  cx->size = size;
+  cx->model = ((uint8_t *) p) + sizeof(cx_shared_t) + n * sizeof(cx_ring_t);
+  cx->tail = NULL;
+  cx->exported = 0;
+  cx->imported = 0;
+  cx->shared->model_owner = -1;
+  cx->shared->model_ready = false;
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Deletion
+ */
+void delete_clause_exchange(clause_exchange_t *cx) {
+#if !defined(MINGW) && defined(MAP_ANONYMOUS)
+  munmap(cx->shared, cx->size);
+#endif
+  safe_free(cx->tail);
+  cx->shared = NULL;
+  cx->model = NULL;
+  cx->tail = NULL;
+}
+
+
+/*
+ * Attach worker i
+ */
+void clause_exchange_attach(clause_exchange_t *cx, smt_core_t *core, uint32_t i) {
+  uint32_t j, n;
+
+  assert(i < cx->nworkers && cx->tail == NULL);
+
+  n = cx->nworkers;
+  cx->id = i;
+  cx->tail = (uint64_t *) safe_malloc(n * sizeof(uint64_t));
+  for (j=0; j<n; j++) {
+    cx->tail[j] = 0;
+  }
+
+  ivector_reset(&core->exported);
+  smt_core_enable_clause_export(core, CX_MAX_CLAUSE_SIZE, cx->max_lbd, cx->nvars);
+}
+
+
+/*
+ * Append the clauses of v to ring r (r is owned by the current worker)
+ * - v contains a sequence of clauses, each stored as: size, lbd, literals
+ */
+static void cx_write(cx_ring_t *r, ivector_t *v) {
+  uint64_t head;
+  uint32_t i, j, n, m;
+  int32_t *a;
+
+  head = r->head;  // only we modify it
+  a = v->data;
+  m = v->size;
+  i = 0;
+  while (i < m) {
+    n = a[i];
+    assert(n <= CX_MAX_CLAUSE_SIZE && i + n + 2 <= m);
+
+    // announce that we're going to overwrite head ... head+n
+    __atomic_store_n(&r->reserved, head + n + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    r->data[head & (CX_RING_WORDS - 1)] = cx_header(n, a[i+1]);
+    for (j=0; j<n; j++) {
+      r->data[(head + 1 + j) & (CX_RING_WORDS - 1)] = a[i + 2 + j];
+    }
+    head += n + 1;
+    __atomic_store_n(&r->head, head, __ATOMIC_RELEASE);
+
+    i += n + 2;
+  }
+}
+
+
+/*
+ * Import the new clauses of ring r into core
+ * - *tail = our read position in r
+ */
+static uint32_t cx_read(cx_ring_t *r, uint64_t *tail, smt_core_t *core) {
+  literal_t buffer[CX_MAX_CLAUSE_SIZE];
+  uint64_t head, pos, reserved;
+  uint32_t i, n, lbd, count;
+  int32_t h;
+
+  count = 0;
+  pos = *tail;
+  head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+  if (head - pos > CX_RING_WORDS) {
+    // we're too late: skip everything
+    pos = head;
+  }
+
+  while (pos < head) {
+    h = r->data[pos & (CX_RING_WORDS - 1)];
+    n = cx_header_size(h);
+    lbd = cx_header_lbd(h);
+    if (n > CX_MAX_CLAUSE_SIZE) break; // overwritten
+    for (i=0; i<n; i++) {
+      buffer[i] = r->data[(pos + 1 + i) & (CX_RING_WORDS - 1)];
+    }
+
+    // check that nothing was overwritten while we read it
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    reserved = __atomic_load_n(&r->reserved, __ATOMIC_RELAXED);
+    if (reserved - pos > CX_RING_WORDS) break;
+
+    import_learned_clause(core, n, buffer, lbd);
+    count ++;
+    pos += n + 1;
+  }
+
+  // if we stopped early, the rest is lost
+  *tail = head;
+
+  return count;
+}
+
+
+/*
+ * Export then import
+ */
+void clause_exchange_sync(clause_exchange_t *cx, smt_core_t *core) {
+  cx_ring_t *ring;
+  uint32_t i, n;
+
+  assert(cx->tail != NULL);
+
+  ring = cx->shared->ring;
+  n = cx->nworkers;
+
+  if (core->exported.size > 0) {
+    cx_write(ring + cx->id, &core->exported);
+    cx->exported += core->exported.size;
+    ivector_reset(&core->exported);
+  }
+
+  for (i=0; i<n; i++) {
+    if (i != cx->id && smt_status(core) == STATUS_SEARCHING) {
+      cx->imported += cx_read(ring + i, cx->tail + i, core);
+    }
+  }
+}
+
+
+/*
+ * Model
+ */
+bool clause_exchange_save_model(clause_exchange_t *cx, smt_core_t *core) {
+  cx_shared_t *s;
+  int32_t none;
+  uint32_t x, n;
+
+  assert(smt_status(core) == STATUS_SAT && cx->nvars <= core->nvars);
+
+  s = cx->shared;
+  none = -1;
+  if (__atomic_compare_exchange_n(&s->model_owner, &none, (int32_t) cx->id, false,
+                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    n = cx->nvars;
+    for (x=0; x<n; x++) {
+      cx->model[x] = bvar_value(core, x) == VAL_TRUE;
+    }
+    __atomic_store_n(&s->model_ready, true, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  return false;
+}
+
+bool clause_exchange_load_model(clause_exchange_t *cx, smt_core_t *core) {
+  uint32_t x, n;
+
+  assert(cx->nvars <= core->nvars);
+
+  if (! __atomic_load_n(&cx->shared->model_ready, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  n = cx->nvars;
+  for (x=0; x<n; x++) {
+    if (bvar_is_unassigned(core, x)) {
+      set_bvar_preferred_value(core, x, cx->model[x]);
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Unsat core: the variables of the core are marked in the model array
+ */
+bool clause_exchange_save_core(clause_exchange_t *cx, const ivector_t *v) {
+  cx_shared_t *s;
+  int32_t none;
+  uint32_t i;
+  bvar_t x;
+
+  s = cx->shared;
+  none = -1;
+  if (__atomic_compare_exchange_n(&s->model_owner, &none, (int32_t) cx->id, false,
+                                  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    for (i=0; i<v->size; i++) {
+      x = var_of(v->data[i]);
+      assert(0 <= x && (uint32_t) x < cx->nvars);
+      cx->model[x] = true;
+    }
+    __atomic_store_n(&s->model_ready, true, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  return false;
+}
+
+bool clause_exchange_load_core(clause_exchange_t *cx, uint32_t n, const literal_t *a, ivector_t *v) {
+  uint32_t i;
+  bvar_t x;
+
+  if (! __atomic_load_n(&cx->shared->model_ready, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+
+  ivector_reset(v);
+  for (i=0; i<n; i++) {
+    x = var_of(a[i]);
+    if ((uint32_t) x < cx->nvars && cx->model[x]) {
+      ivector_push(v, not(a[i]));
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,187 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CLAUSE EXCHANGE BETWEEN PORTFOLIO WORKERS
+ */
+
+/*
+ * The portfolio workers are processes forked from the same parent
+ * after the search has started. So the boolean variables 0 ... nvars-1
+ * that exist at that point mean the same thing in all workers. Short
+ * learned clauses over these variables are exchanged through memory
+ * shared by all the workers:
+ * - each worker has its own ring buffer where it appends the clauses
+ *   it exports (single writer)
+ * - each worker reads the rings of the other workers (many readers)
+ *   and keeps its own read position in each ring
+ * - no locks: the writer publishes the end of the data it has written,
+ *   and it announces the region it's about to overwrite before doing so.
+ *   A reader that falls too far behind loses clauses: it detects
+ *   that the data it read may have been overwritten, and skips it.
+ *
+ * The shared memory also stores a model: the first worker that finds
+ * the problem satisfiable copies the value of variables 0 ... nvars-1
+ * there, so that the parent can use it. If the problem is unsat under
+ * assumptions, the same array is used to mark the variables of an
+ * unsat core instead.
+ */
+
+#ifndef __CLAUSE_EXCHANGE_H
+#define __CLAUSE_EXCHANGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "solvers/cdcl/smt_core.h"
+
+
+/*
+ * Bounds on the exported clauses
+ * - CX_MAX_CLAUSE_SIZE = maximal number of literals
+ * - CX_RING_WORDS = size of each ring buffer (in 32bit words)
+ *   this must be a power of two
+ */
+#define CX_MAX_CLAUSE_SIZE 8
+#define CX_RING_WORDS      (1<<15)
+
+
+/*
+ * Ring buffer: a clause is stored as a header word (size | lbd << 16)
+ * followed by its literals. Positions are counters that are never
+ * reset; the data is at index (position mod CX_RING_WORDS).
+ * - head = end of the published data
+ * - reserved = end of the region the writer may be modifying
+ */
+typedef struct cx_ring_s {
+  uint64_t head;
+  uint64_t reserved;
+  uint64_t padding[6];  // keep data on a different cache line
+  int32_t data[CX_RING_WORDS];
+} cx_ring_t;
+
+
+/*
+ * Shared block: rings + model
+ * - model_owner = index of the worker that writes the model (-1 if none)
+ * - model_ready = set to true when that worker is done writing it
+ * - model[x] = value of variable x (for x < nvars)
+ */
+typedef struct cx_shared_s {
+  int32_t model_owner;
+  uint32_t model_ready;
+  uint64_t padding[7];
+  cx_ring_t ring[0];
+} cx_shared_t;
+
+
+/*
+ * Exchange descriptor:
+ * - nworkers = number of workers
+ * - nvars = number of shared variables
+ * - max_lbd = bound on the LBD of exported clauses
+ * - id = index of the current worker (set in each worker after fork)
+ * - shared = block of shared memory
+ * - size = size of this block
+ * - model = pointer to the model array in the block
+ * - tail[i] = read position in ring i (private to each worker)
+ * - exported/imported = statistics (private to each worker)
+ */
+typedef struct clause_exchange_s {
+  uint32_t nworkers;
+  uint32_t nvars;
+  uint32_t max_lbd;
+  uint32_t id;
+  cx_shared_t *shared;
+  size_t size;
+  uint8_t *model;
+  uint64_t *tail;
+  uint32_t exported;
+  uint32_t imported;
+} clause_exchange_t;
+
+
+/*
+ * Initialize cx for n workers
+ * - nvars = number of variables that can be shared
+ * - max_lbd = LBD bound (must be positive)
+ * - n may be 0: then there are no rings and cx is used only to pass
+ *   a model or an unsat core to the parent
+ * - this allocates the shared memory block: it must be called before fork
+ * - return false if the memory can't be allocated (or if the platform
+ *   does not support shared memory)
+ */
+extern bool init_clause_exchange(clause_exchange_t *cx, uint32_t n, uint32_t nvars, uint32_t max_lbd);
+
+/*
+ * Delete: free the memory (must be called in the parent after all
+ * the workers are done)
+ */
+extern void delete_clause_exchange(clause_exchange_t *cx);
+
+/*
+ * Attach worker i to cx and enable export of learned clauses in core
+ * - this must be called in the worker after fork
+ */
+extern void clause_exchange_attach(clause_exchange_t *cx, smt_core_t *core, uint32_t i);
+
+/*
+ * Exchange clauses:
+ * - append all the clauses exported by core since the previous call
+ *   to this worker's ring
+ * - import the new clauses written by the other workers into core
+ * - core must be at its base level, with status SEARCHING
+ */
+extern void clause_exchange_sync(clause_exchange_t *cx, smt_core_t *core);
+
+/*
+ * Copy the model found by core into the shared block
+ * - core->status must be SAT
+ * - return true if the model was copied, false if another worker
+ *   got there first (then there's nothing to do)
+ */
+extern bool clause_exchange_save_model(clause_exchange_t *cx, smt_core_t *core);
+
+/*
+ * Use the shared model (if any) to set core's preferred polarities
+ * - called by the parent, after all workers are done
+ * - return true if there was a model, false otherwise
+ */
+extern bool clause_exchange_load_model(clause_exchange_t *cx, smt_core_t *core);
+
+/*
+ * Copy an unsat core into the shared block
+ * - v = subset of the assumptions that's inconsistent (as built
+ *   by build_unsat_core)
+ * - same rule as save_model: return false if another worker got
+ *   there first
+ */
+extern bool clause_exchange_save_core(clause_exchange_t *cx, const ivector_t *v);
+
+/*
+ * Get the shared unsat core (if any)
+ * - a[0 ... n-1] = the assumptions used by the workers
+ * - the negations of the assumptions in the core are stored in v
+ *   (this gives a clause implied by the problem)
+ * - return false if there's no core
+ */
+extern bool clause_exchange_load_core(clause_exchange_t *cx, uint32_t n, const literal_t *a, ivector_t *v);
+
+
+#endif /* __CLAUSE_EXCHANGE_H */
@@ -0,0 +1,395 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * WORD-PARALLEL RANDOM SIMULATION OF BOOLEAN GATES
+ */
+
+#include <assert.h>
+
+#include "solvers/cdcl/gate_simulator.h"
+#include "utils/bit_tricks.h"
+#include "utils/memalloc.h"
+#include "utils/ptr_array_sort2.h"
+
+
+/*
+ * Initialization
+ */
+void init_gate_simulator(gate_simulator_t *sim, smt_core_t *core, uint32_t seed) {
+  sim->core = core;
+  init_pvector(&sim->gates, 0);
+  sim->nvars = 0;
+  sim->val = NULL;
+  sim->nfalse = NULL;
+  sim->best = NULL;
+  sim->best_false = UINT32_MAX;
+  sim->npatterns = 0;
+  sim->prng = ((uint64_t) seed << 32) | 0x9e3779b9; // must not be zero
+}
+
+
+/*
+ * Deletion
+ */
+void delete_gate_simulator(gate_simulator_t *sim) {
+  delete_pvector(&sim->gates);
+  safe_free(sim->val);
+  safe_free(sim->nfalse);
+  safe_free(sim->best);
+  sim->val = NULL;
+  sim->nfalse = NULL;
+  sim->best = NULL;
+}
+
+
+/*
+ * Random 64bit word (xorshift64*)
+ */
+static uint64_t gsim_random(gate_simulator_t *sim) {
+  uint64_t x;
+
+  x = sim->prng;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  sim->prng = x;
+
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+
+/*
+ * Collect the gates of tbl
+ */
+void gate_simulator_add_table(gate_simulator_t *sim, gate_table_t *tbl) {
+  boolgate_t **data;
+  boolgate_t *g;
+  uint32_t i, n;
+
+  data = tbl->htbl.data;
+  n = tbl->htbl.size;
+  for (i=0; i<n; i++) {
+    g = data[i];
+    if (g != NULL && g != DELETED_GATE) {
+      pvector_push(&sim->gates, g);
+    }
+  }
+}
+
+
+/*
+ * First output variable of gate g
+ */
+static bvar_t gate_output_var(boolgate_t *g) {
+  literal_t l;
+
+  l = g->lit[tag_indegree(g->tag)];
+  return l < 0 ? null_bvar : var_of(l);
+}
+
+/*
+ * Ordering for sorting the gates: by increasing output variable.
+ * Gate inputs exist before the gate is created so this is a
+ * topological order (except for gates whose output is not fresh,
+ * which can only make the simulation less precise).
+ */
+static bool gate_precedes(void *data, void *g1, void *g2) {
+  return gate_output_var(g1) < gate_output_var(g2);
+}
+
+
+
+/*
+ * VALUES OF VARIABLES AND LITERALS
+ */
+
+/*
+ * Word j of literal l
+ */
+static inline uint64_t lit_word(gate_simulator_t *sim, literal_t l, uint32_t j) {
+  uint64_t mask;
+
+  assert(var_of(l) < sim->nvars && j < GSIM_WORDS);
+  mask = - (uint64_t) sign_of_lit(l); // all ones if l is negative
+  return sim->val[var_of(l) * GSIM_WORDS + j] ^ mask;
+}
+
+/*
+ * Set word j of literal l to w
+ * - no change if l's variable is assigned at the base level
+ */
+static inline void set_lit_word(gate_simulator_t *sim, literal_t l, uint32_t j, uint64_t w) {
+  uint64_t mask;
+  bvar_t x;
+
+  x = var_of(l);
+  assert(x < sim->nvars && j < GSIM_WORDS);
+  if (bvar_is_unassigned(sim->core, x)) {
+    mask = - (uint64_t) sign_of_lit(l);
+    sim->val[x * GSIM_WORDS + j] = w ^ mask;
+  }
+}
+
+
+/*
+ * Initial values: fixed for assigned variables, random for the others
+ */
+static void gsim_assign_inputs(gate_simulator_t *sim) {
+  smt_core_t *core;
+  uint64_t w;
+  uint32_t x, j, n;
+
+  core = sim->core;
+  n = sim->nvars;
+  for (x=0; x<n; x++) {
+    if (bvar_is_assigned(core, x)) {
+      w = (bvar_value(core, x) == VAL_TRUE) ? ~((uint64_t) 0) : 0;
+      for (j=0; j<GSIM_WORDS; j++) {
+        sim->val[x * GSIM_WORDS + j] = w;
+      }
+    } else {
+      for (j=0; j<GSIM_WORDS; j++) {
+        sim->val[x * GSIM_WORDS + j] = gsim_random(sim);
+      }
+    }
+  }
+}
+
+
+/*
+ * Evaluate gate g
+ */
+static void gsim_eval_gate(gate_simulator_t *sim, boolgate_t *g) {
+  literal_t *a;
+  uint64_t w, a0, a1, a2;
+  uint32_t i, j, n;
+
+  n = tag_indegree(g->tag);
+  a = g->lit;
+  for (i=0; i<tag_outdegree(g->tag); i++) {
+    if (a[n+i] < 0) return; // output not set yet
+  }
+
+  for (j=0; j<GSIM_WORDS; j++) {
+    switch (tag_combinator(g->tag)) {
+    case XOR_GATE:
+      w = 0;
+      for (i=0; i<n; i++) {
+        w ^= lit_word(sim, a[i], j);
+      }
+      set_lit_word(sim, a[n], j, w);
+      break;
+
+    case OR_GATE:
+      w = 0;
+      for (i=0; i<n; i++) {
+        w |= lit_word(sim, a[i], j);
+      }
+      set_lit_word(sim, a[n], j, w);
+      break;
+
+    case ITE_GATE:
+      a0 = lit_word(sim, a[0], j);
+      a1 = lit_word(sim, a[1], j);
+      a2 = lit_word(sim, a[2], j);
+      set_lit_word(sim, a[3], j, (a0 & a1) | (~a0 & a2));
+      break;
+
+    case CMP_GATE:
+      // (a1 > a2) or (a1 == a2 and c)
+      a0 = lit_word(sim, a[0], j);
+      a1 = lit_word(sim, a[1], j);
+      a2 = lit_word(sim, a[2], j);
+      set_lit_word(sim, a[3], j, (a0 & ~a1) | (~(a0 ^ a1) & a2));
+      break;
+
+    case HALFADD_GATE:
+      a0 = lit_word(sim, a[0], j);
+      a1 = lit_word(sim, a[1], j);
+      set_lit_word(sim, a[2], j, a0 ^ a1);
+      set_lit_word(sim, a[3], j, a0 & a1);
+      break;
+
+    case FULLADD_GATE:
+      a0 = lit_word(sim, a[0], j);
+      a1 = lit_word(sim, a[1], j);
+      a2 = lit_word(sim, a[2], j);
+      set_lit_word(sim, a[3], j, a0 ^ a1 ^ a2);
+      set_lit_word(sim, a[4], j, (a0 & a1) | (a0 & a2) | (a1 & a2));
+      break;
+    }
+  }
+}
+
+
+
+/*
+ * CLAUSE EVALUATION
+ */
+
+/*
+ * Update the nfalse counters for a clause whose value in the
+ * patterns of word j is w
+ */
+static inline void gsim_count_false(gate_simulator_t *sim, uint32_t j, uint64_t w) {
+  uint64_t f;
+
+  f = ~w;
+  while (f != 0) {
+    sim->nfalse[j * 64 + ctz64(f)] ++;
+    f &= f - 1;
+  }
+}
+
+/*
+ * Evaluate all problem clauses and binary clauses of the core
+ * - unit clauses are true in all patterns
+ * - return the index of a pattern with the fewest false clauses
+ */
+static uint32_t gsim_eval_clauses(gate_simulator_t *sim) {
+  smt_core_t *core;
+  clause_t **cv;
+  literal_t *bin, *cl;
+  literal_t l1, l2;
+  int32_t nlits;
+  uint64_t w;
+  uint32_t i, j, k, n;
+
+  core = sim->core;
+  for (k=0; k<GSIM_PATTERNS; k++) {
+    sim->nfalse[k] = 0;
+  }
+
+  nlits = 2 * sim->nvars;
+  for (l1=0; l1<nlits; l1++) {
+    bin = core->bin[l1];
+    if (bin != NULL) {
+      for (;;) {
+        l2 = *bin ++;
+        if (l2 < 0) break;
+        if (l1 <= l2) {
+          for (j=0; j<GSIM_WORDS; j++) {
+            w = lit_word(sim, l1, j) | lit_word(sim, l2, j);
+            gsim_count_false(sim, j, w);
+          }
+        }
+      }
+    }
+  }
+
+  cv = core->problem_clauses;
+  n = get_cv_size(cv);
+  for (i=0; i<n; i++) {
+    cl = cv[i]->cl;
+    for (j=0; j<GSIM_WORDS; j++) {
+      w = 0;
+      for (k=0; cl[k] >= 0; k++) {
+        w |= lit_word(sim, cl[k], j);
+      }
+      gsim_count_false(sim, j, w);
+    }
+  }
+
+  k = 0;
+  for (i=1; i<GSIM_PATTERNS; i++) {
+    if (sim->nfalse[i] < sim->nfalse[k]) {
+      k = i;
+    }
+  }
+
+  return k;
+}
+
+
+/*
+ * Store pattern k as the best pattern
+ */
+static void gsim_save_pattern(gate_simulator_t *sim, uint32_t k) {
+  uint32_t x, n, j, b;
+
+  assert(k < GSIM_PATTERNS);
+
+  j = k / 64;
+  b = k % 64;
+  n = sim->nvars;
+  for (x=0; x<n; x++) {
+    sim->best[x] = (sim->val[x * GSIM_WORDS + j] >> b) & 1;
+  }
+  sim->best_false = sim->nfalse[k];
+}
+
+
+
+/*
+ * SIMULATION
+ */
+uint32_t gate_simulator_run(gate_simulator_t *sim, uint32_t n) {
+  smt_core_t *core;
+  pvector_t *v;
+  uint32_t i, r, k, nv;
+
+  core = sim->core;
+  assert(core->decision_level == core->base_level);
+
+  if (sim->val == NULL) {
+    nv = core->nvars;
+    sim->nvars = nv;
+    sim->val = (uint64_t *) safe_malloc(nv * GSIM_WORDS * sizeof(uint64_t));
+    sim->nfalse = (uint32_t *) safe_malloc(GSIM_PATTERNS * sizeof(uint32_t));
+    sim->best = (uint8_t *) safe_malloc(nv * sizeof(uint8_t));
+
+    v = &sim->gates;
+    ptr_array_sort2(v->data, v->size, NULL, gate_precedes);
+  }
+  assert(sim->nvars == core->nvars);
+
+  v = &sim->gates;
+  for (r=0; r<n && sim->best_false > 0; r++) {
+    gsim_assign_inputs(sim);
+    for (i=0; i<v->size; i++) {
+      gsim_eval_gate(sim, v->data[i]);
+    }
+    k = gsim_eval_clauses(sim);
+    if (sim->nfalse[k] < sim->best_false) {
+      gsim_save_pattern(sim, k);
+    }
+    sim->npatterns += GSIM_PATTERNS;
+  }
+
+  return sim->best_false;
+}
+
+
+/*
+ * Copy the best pattern into the core's preferred values
+ */
+void gate_simulator_set_phases(gate_simulator_t *sim) {
+  smt_core_t *core;
+  uint32_t x, n;
+
+  assert(sim->best_false < UINT32_MAX);
+
+  core = sim->core;
+  n = sim->nvars;
+  for (x=0; x<n; x++) {
+    if (bvar_is_unassigned(core, x)) {
+      set_bvar_preferred_value(core, x, sim->best[x]);
+    }
+  }
+}
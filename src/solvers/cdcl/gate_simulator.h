@@ -0,0 +1,115 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * WORD-PARALLEL RANDOM SIMULATION OF BOOLEAN GATES
+ */
+
+/*
+ * The simulator evaluates the gates stored in one or more gate tables
+ * (i.e., the gate manager's and the bit-blaster's) on many random
+ * input vectors at once. Each variable is mapped to GSIM_WORDS 64bit
+ * words: bit k of the block is the variable's value in pattern k.
+ * - variables assigned at the base level keep their value in all patterns
+ * - other variables that are not gate outputs get random values
+ * - gate outputs are computed from the gate inputs using bitwise operations
+ *
+ * After each round, all the problem clauses of the core are evaluated
+ * on all patterns and the pattern that falsifies the fewest clauses
+ * is kept. If a pattern falsifies no clause, it's a model of the clauses.
+ * The best pattern can then be used to set the core's preferred values.
+ */
+
+#ifndef __GATE_SIMULATOR_H
+#define __GATE_SIMULATOR_H
+
+#include <stdint.h>
+
+#include "solvers/cdcl/gates_hash_table.h"
+#include "solvers/cdcl/smt_core.h"
+#include "utils/ptr_vectors.h"
+
+
+/*
+ * Number of 64bit words per variable and number of patterns per round
+ */
+#define GSIM_WORDS 4
+#define GSIM_PATTERNS (64 * GSIM_WORDS)
+
+
+/*
+ * Simulator:
+ * - core = attached smt_core
+ * - gates = the gates to simulate
+ * - nvars = number of variables in the core when the simulation starts
+ * - val = array of nvars * GSIM_WORDS words (values of all variables)
+ * - nfalse[k] = number of clauses false in pattern k (for the current round)
+ * - best[x] = value of x in the best pattern found so far
+ * - best_false = number of clauses false in that pattern
+ *   (UINT32_MAX if no round has been done)
+ * - npatterns = number of patterns simulated
+ * - prng = state of the pseudo-random number generator
+ */
+typedef struct gate_simulator_s {
+  smt_core_t *core;
+  pvector_t gates;
+  uint32_t nvars;
+  uint64_t *val;
+  uint32_t *nfalse;
+  uint8_t *best;
+  uint32_t best_false;
+  uint32_t npatterns;
+  uint64_t prng;
+} gate_simulator_t;
+
+
+/*
+ * Initialize sim for the given core
+ * - seed = seed for the random number generator
+ */
+extern void init_gate_simulator(gate_simulator_t *sim, smt_core_t *core, uint32_t seed);
+
+/*
+ * Delete sim: free all memory
+ */
+extern void delete_gate_simulator(gate_simulator_t *sim);
+
+/*
+ * Add all the gates of tbl to the set of gates to simulate
+ * - tbl must not be modified until the simulation is done
+ */
+extern void gate_simulator_add_table(gate_simulator_t *sim, gate_table_t *tbl);
+
+/*
+ * Run at most n rounds of simulation (GSIM_PATTERNS patterns per round)
+ * - the core must be at its base level
+ * - stop as soon as a pattern satisfies all the problem clauses
+ * - return the number of clauses false in the best pattern
+ *   (0 means that a model was found)
+ */
+extern uint32_t gate_simulator_run(gate_simulator_t *sim, uint32_t n);
+
+/*
+ * Set the core's preferred value of every unassigned variable to
+ * its value in the best pattern
+ * - gate_simulator_run must be called first
+ */
+extern void gate_simulator_set_phases(gate_simulator_t *sim);
+
+
+#endif /* __GATE_SIMULATOR_H */
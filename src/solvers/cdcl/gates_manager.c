@@ -35,6 +35,7 @@ void init_gate_manager(gate_manager_t *m, smt_core_t *core) {
   m->core = core;
   init_gate_table(&m->htbl);
   init_ivector(&m->buffer, 0);
+  init_pvector(&m->def, 0);
 }
 
 
@@ -45,6 +46,32 @@ void delete_gate_manager(gate_manager_t *m) {
   m->core = NULL;
   delete_gate_table(&m->htbl);
   delete_ivector(&m->buffer);
+  delete_pvector(&m->def);
+}
+
+
+/*
+ * Pop: the gates created at the current level are removed from htbl.
+ * Their output variables were created at the same level so they've been
+ * removed from the core already: we just remove their definitions.
+ */
+void gate_manager_pop(gate_manager_t *m) {
+  uint32_t n;
+
+  gate_table_pop(&m->htbl);
+  n = num_vars(m->core);
+  if (m->def.size > n) {
+    pvector_shrink(&m->def, n);
+  }
+}
+
+
+/*
+ * Reset: empty the table and remove all definitions
+ */
+void reset_gate_manager(gate_manager_t *m) {
+  reset_gate_table(&m->htbl);
+  pvector_reset(&m->def);
 }
 
 
@@ -72,48 +99,244 @@ static void assert_ordef_clauses(smt_core_t *s, literal_t l, ivector_t *v) {
 
 
 /*
- * Construct OR based on the content of vector v
- * - v should not contain false literals (or true literals)
- * - tbl = gate table
- * - s = smt core
+ * OR-GATE DEFINITIONS
+ */
+
+/*
+ * Record that x is the output of the or-gate g
+ */
+static void set_or_definition(gate_manager_t *m, bvar_t x, boolgate_t *g) {
+  pvector_t *v;
+
+  v = &m->def;
+  while (v->size <= x) {
+    pvector_push(v, NULL);
+  }
+  assert(v->data[x] == NULL);
+  v->data[x] = g;
+}
+
+/*
+ * Definition of var_of(l) or NULL
+ */
+static boolgate_t *or_definition(gate_manager_t *m, literal_t l) {
+  bvar_t x;
+
+  x = var_of(l);
+  return x < m->def.size ? m->def.data[x] : NULL;
+}
+
+/*
+ * Output of the existing gate (OR l1 l2) or null_literal
+ */
+static literal_t find_or2(gate_manager_t *m, literal_t l1, literal_t l2) {
+  boolgate_t *g;
+  literal_t aux;
+
+  if (l1 > l2) {
+    aux = l1; l1 = l2; l2 = aux;
+  }
+  g = gate_table_find2(&m->htbl, orgate_tag(2), l1, l2);
+  return g != NULL ? g->lit[2] : null_literal;
+}
+
+
+/*
+ * Search for l in a[0 ... n-1]
+ * - a must be sorted in increasing order
+ * - return i such that a[i] = l or -1 if l does not occur in a
+ */
+static int32_t sorted_index(literal_t *a, uint32_t n, literal_t l) {
+  uint32_t lo, hi, mid;
+
+  lo = 0;
+  hi = n;
+  while (lo < hi) {
+    mid = (lo + hi)/2;
+    if (a[mid] == l) return mid;
+    if (a[mid] < l) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return -1;
+}
+
+
+/*
+ * Sort v and remove duplicates
+ * - return false if v contains complementary literals
  */
-static literal_t aux_or_constructor(gate_table_t *tbl, smt_core_t *s, ivector_t *v) {
+static bool normalize_or_args(ivector_t *v) {
   uint32_t i, n, p;
   literal_t aux, l;
   literal_t *a;
-  boolgate_t *g;
 
   n = v->size;
   a = v->data;
+  assert(n > 0);
 
-  if (n == 0) return false_literal;
-
-  /*
-   * Sort, remove duplicates, check for complementary literals
-   */
   int_array_sort(a, n);
   l = a[0];
   p = 1;
   for (i=1; i<n; i++) {
     aux = a[i];
     if (aux != l) {
-      if (aux == not(l)) return true_literal; // (or .. l not(l) ..)
+      if (aux == not(l)) return false; // (or .. l not(l) ..)
       a[p++] = aux;
       l = aux;
     }
   }
+  ivector_shrink(v, p);
+
+  return true;
+}
+
+
+/*
+ * TWO-LEVEL REWRITING
+ *
+ * Let v = (OR a[0] ... a[n-1]), where some a[i] is (the negation of) the
+ * output of an or-gate. We use the following rules:
+ * - tautology:    a[i] = (OR ... c ...) and not(c) in v ==> true
+ * - subsumption:  a[i] = (OR ... c ...) and c in v ==> remove c
+ * - absorption:   a[i] = (AND ... not(c) ...) and not(c) in v ==> remove a[i]
+ * - substitution: a[i] = (AND not(c) not(d)) and c in v ==> replace a[i] by not(d)
+ * - resolution:   a[i] = (AND not(c) not(d)) and a[j] = (AND c not(d))
+ *                 ==> replace a[i] and a[j] by not(d)
+ * where (AND not(c) not(d)) is not(OR c d).
+ *
+ * Each step either shrinks v or replaces a gate output by one of the
+ * gate's inputs. Inputs are created before outputs, so the largest
+ * variable decreases: rewriting terminates.
+ */
+typedef enum or_rewrite {
+  OR_REWRITE_NONE,   // no rule applies
+  OR_REWRITE_DONE,   // v was modified (must be normalized again)
+  OR_REWRITE_TRUE,   // v is true
+} or_rewrite_t;
+
+/*
+ * Apply one rewrite step to v
+ * - v must be normalized and contain at least two literals
+ */
+static or_rewrite_t or_rewrite_step(gate_manager_t *m, ivector_t *v) {
+  boolgate_t *g;
+  literal_t *a;
+  literal_t x, y, c, d;
+  uint32_t i, j, k, n;
+  int32_t h;
+
+  n = v->size;
+  a = v->data;
+  assert(n >= 2);
 
+  for (i=0; i<n; i++) {
+    x = a[i];
+    g = or_definition(m, x);
+    if (g == NULL) continue;
+
+    k = tag_indegree(g->tag);
+    if (x == g->lit[k]) {
+      // x = (OR c_0 ... c_k-1)
+      for (j=0; j<k; j++) {
+        c = g->lit[j];
+        if (sorted_index(a, n, not(c)) >= 0) {
+          return OR_REWRITE_TRUE;
+        }
+        h = sorted_index(a, n, c);
+        if (h >= 0) {
+          // replace c by x: the duplicate is removed by normalization
+          a[h] = x;
+          return OR_REWRITE_DONE;
+        }
+      }
+
+    } else {
+      // x = (AND not(c_0) ... not(c_k-1))
+      assert(x == not(g->lit[k]));
+      for (j=0; j<k; j++) {
+        c = g->lit[j];
+        if (sorted_index(a, n, not(c)) >= 0) {
+          a[i] = not(c);
+          return OR_REWRITE_DONE;
+        }
+      }
+
+      if (k == 2) {
+        c = g->lit[0];
+        d = g->lit[1];
+        if (sorted_index(a, n, c) >= 0) {
+          a[i] = not(d);
+          return OR_REWRITE_DONE;
+        }
+        if (sorted_index(a, n, d) >= 0) {
+          a[i] = not(c);
+          return OR_REWRITE_DONE;
+        }
+        // check whether (AND c not(d)) or (AND not(c) d) is in v
+        y = find_or2(m, not(c), d);
+        h = (y != null_literal) ? sorted_index(a, n, not(y)) : -1;
+        if (h >= 0) {
+          a[i] = not(d);
+          a[h] = not(d);
+          return OR_REWRITE_DONE;
+        }
+        y = find_or2(m, c, not(d));
+        h = (y != null_literal) ? sorted_index(a, n, not(y)) : -1;
+        if (h >= 0) {
+          a[i] = not(c);
+          a[h] = not(c);
+          return OR_REWRITE_DONE;
+        }
+      }
+    }
+  }
+
+  return OR_REWRITE_NONE;
+}
+
+
+/*
+ * Construct OR based on the content of vector v
+ * - v should not contain false literals (or true literals)
+ */
+static literal_t aux_or_constructor(gate_manager_t *m, ivector_t *v) {
+  smt_core_t *s;
+  uint32_t p;
+  literal_t l;
+  literal_t *a;
+  boolgate_t *g;
+  or_rewrite_t r;
+
+  if (v->size == 0) return false_literal;
+
+  /*
+   * Sort, remove duplicates, check for complementary literals,
+   * then apply two-level rewriting
+   */
+  if (! normalize_or_args(v)) return true_literal;
+  while (v->size > 1) {
+    r = or_rewrite_step(m, v);
+    if (r == OR_REWRITE_NONE) break;
+    if (r == OR_REWRITE_TRUE || ! normalize_or_args(v)) return true_literal;
+  }
+
+  s = m->core;
+  p = v->size;
+  a = v->data;
   if (p == 1) return a[0];
-  ivector_shrink(v, p);
 
   if (p <= MAX_HASHCONS_SIZE) {
     // hash-consing
-    g = gate_table_get(tbl, orgate_tag(p), a);
+    g = gate_table_get(&m->htbl, orgate_tag(p), a);
     l = g->lit[p];  // output literal for an or-gate
     if (l == null_literal) {
       // new gate: create a fresh literal l
       l = pos_lit(create_boolean_variable(s));
       g->lit[p] = l;
+      set_or_definition(m, var_of(l), g);
       assert_ordef_clauses(s, l, v);
     }
 
@@ -158,7 +381,7 @@ literal_t mk_or_gate(gate_manager_t *m, uint32_t n, literal_t *a) {
     }
   }
 
-  return aux_or_constructor(&m->htbl, s, v);
+  return aux_or_constructor(m, v);
 }
 
 literal_t mk_or_gate2(gate_manager_t *m, literal_t l1, literal_t l2) {
@@ -213,7 +436,7 @@ literal_t mk_and_gate(gate_manager_t *m, uint32_t n, literal_t *a) {
     }
   }
 
-  return not(aux_or_constructor(&m->htbl, s, v));
+  return not(aux_or_constructor(m, v));
 }
 
 
@@ -35,15 +35,26 @@
 #include "solvers/cdcl/gates_hash_table.h"
 #include "solvers/cdcl/smt_core.h"
 #include "utils/int_vectors.h"
+#include "utils/ptr_vectors.h"
 
 
 /*
  * Manager = smt_core + hash table + an internal literal buffer
+ *
+ * To catch redundancies that hash consing alone misses, the manager
+ * also keeps the definition of every hash-consed OR gate:
+ * - def.data[x] = the descriptor of gate (OR a[0] ... a[n-1]) if
+ *   variable x was created as the output of that gate
+ * - def.data[x] = NULL otherwise (or x >= def.size)
+ * Before building (OR l_1 ... l_n), the manager looks one level down
+ * into the l_i's definitions and applies two-level rewriting
+ * (tautology, subsumption, absorption, substitution, resolution).
  */
 typedef struct gate_manager_s {
   smt_core_t *core;
   gate_table_t htbl;
   ivector_t buffer;
+  pvector_t def;
 } gate_manager_t;
 
 
@@ -74,19 +85,17 @@ extern void delete_gate_manager(gate_manager_t *m);
 
 
 /*
- * Push/pop/reset just apply to the internal gate table
+ * Push/pop/reset apply to the internal gate table and definitions
+ * - pop must be called after the core's pop: the definitions of
+ *   variables that no longer exist in the core are removed.
  */
 static inline void gate_manager_push(gate_manager_t *m) {
   gate_table_push(&m->htbl);
 }
 
-static inline void gate_manager_pop(gate_manager_t *m) {
-  gate_table_pop(&m->htbl);
-}
+extern void gate_manager_pop(gate_manager_t *m);
 
-static inline void reset_gate_manager(gate_manager_t *m) {
-  reset_gate_table(&m->htbl);
-}
+extern void reset_gate_manager(gate_manager_t *m);
 
 
 
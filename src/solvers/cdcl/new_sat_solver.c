@@ -2208,6 +2208,7 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
   solver->decision_level = 0;
   solver->backtrack_level = 0;
   solver->preprocess = pp;
+  solver->interrupted = false;
 
   solver->verbosity = 0;
   solver->reports = 0;
@@ -2346,6 +2347,7 @@ void delete_nsat_solver(sat_solver_t *solver) {
  */
 void reset_nsat_solver(sat_solver_t *solver) {
   solver->status = STAT_UNKNOWN;
+  solver->interrupted = false;
   solver->decision_level = 0;
   solver->backtrack_level = 0;
   solver->nvars = 1;
@@ -7670,7 +7672,7 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
   while (! solver->has_empty_clause) {
     solver->stats.starts ++;
     sat_search(solver);
-    if (solver->status != STAT_UNKNOWN) break;
+    if (solver->status != STAT_UNKNOWN || solver->interrupted) break;
 
     if (need_simplify(solver)) {
       full_restart(solver);
@@ -7684,7 +7686,7 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
   }
 
  done:
-  assert(solver->status == STAT_UNSAT || solver->status == STAT_SAT);
+  assert(solver->status == STAT_UNSAT || solver->status == STAT_SAT || solver->interrupted);
 
   report(solver, "end");
 
@@ -7698,6 +7700,14 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
 }
 
 
+/*
+ * Interrupt the search
+ */
+void nsat_stop_search(sat_solver_t *solver) {
+  solver->interrupted = true;
+}
+
+
 /************
  *  MODELS  *
  ***********/
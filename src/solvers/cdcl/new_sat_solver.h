@@ -762,6 +762,7 @@ typedef struct sat_solver_s {
   uint32_t decision_level;
   uint32_t backtrack_level;
   bool preprocess;             // True if preprocessing is enabled
+  volatile bool interrupted;   // Set by nsat_stop_search
 
   uint32_t verbosity;          // Verbosity level: 0 means quiet
   uint32_t reports;            // Counter
@@ -1089,9 +1090,18 @@ extern void nsat_solver_simplify_and_add_clause(sat_solver_t *solver, uint32_t n
 /*
  * Check satisfiability of the set of clauses
  * - result = either STAT_SAT or STAT_UNSAT
+ * - if the search is interrupted (by nsat_stop_search), the
+ *   result is STAT_UNKNOWN.
  */
 extern solver_status_t nsat_solve(sat_solver_t *solver);
 
+/*
+ * Interrupt the search:
+ * - the solver stops at the next restart and nsat_solve returns STAT_UNKNOWN
+ * - this can be called from a signal handler
+ */
+extern void nsat_stop_search(sat_solver_t *solver);
+
 
 /*
  * Read the status
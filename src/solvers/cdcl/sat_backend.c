@@ -0,0 +1,110 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SAT BACKEND: WRAPPER FOR NEW_SAT_SOLVER
+ */
+
+#include <assert.h>
+
+#include "solvers/cdcl/new_sat_solver.h"
+#include "solvers/cdcl/sat_backend.h"
+#include "utils/memalloc.h"
+
+
+struct sat_backend_s {
+  sat_solver_t solver;
+};
+
+
+/*
+ * Allocation/deletion
+ */
+sat_backend_t *new_sat_backend(uint32_t n, bool pp) {
+  sat_backend_t *b;
+
+  assert(n > 0);
+
+  b = (sat_backend_t *) safe_malloc(sizeof(sat_backend_t));
+  init_nsat_solver(&b->solver, n, pp);
+  nsat_solver_add_vars(&b->solver, n - 1);
+
+  return b;
+}
+
+void free_sat_backend(sat_backend_t *b) {
+  delete_nsat_solver(&b->solver);
+  safe_free(b);
+}
+
+
+/*
+ * Parameters
+ */
+void sat_backend_set_verbosity(sat_backend_t *b, uint32_t level) {
+  nsat_set_verbosity(&b->solver, level);
+}
+
+void sat_backend_set_random_seed(sat_backend_t *b, uint32_t seed) {
+  nsat_set_random_seed(&b->solver, seed);
+}
+
+
+/*
+ * Add a clause: the literal encodings are the same so we can just cast.
+ */
+void sat_backend_add_clause(sat_backend_t *b, uint32_t n, int32_t *a) {
+#ifndef NDEBUG
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    assert(0 <= a[i] && (uint32_t) a[i] < b->solver.nliterals);
+  }
+#endif
+  nsat_solver_simplify_and_add_clause(&b->solver, n, (literal_t *) a);
+}
+
+
+/*
+ * Solve
+ */
+smt_status_t sat_backend_solve(sat_backend_t *b) {
+  switch (nsat_solve(&b->solver)) {
+  case STAT_SAT:
+    return STATUS_SAT;
+
+  case STAT_UNSAT:
+    return STATUS_UNSAT;
+
+  default:
+    return STATUS_INTERRUPTED;
+  }
+}
+
+void sat_backend_stop(sat_backend_t *b) {
+  nsat_stop_search(&b->solver);
+}
+
+
+/*
+ * Model
+ */
+bool sat_backend_var_is_true(sat_backend_t *b, int32_t x) {
+  assert(0 <= x && (uint32_t) x < b->solver.nvars);
+  return var_is_true(&b->solver, x);
+}
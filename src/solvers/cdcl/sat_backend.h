@@ -0,0 +1,94 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SAT BACKEND FOR PURELY PROPOSITIONAL PROBLEMS
+ *
+ * This is a thin wrapper around the stand-alone sat solver (new_sat_solver).
+ * When all the constraints of a context have been converted to clauses
+ * (e.g., after bit-blasting), the clauses can be copied into a backend and
+ * solved there. The backend's model is then used to guide the smt_core.
+ *
+ * The wrapper is needed because new_sat_solver.h and smt_core.h use
+ * incompatible definitions of bvar_t and literal_t. Both use the same
+ * encoding: variable 0 is reserved for true, the positive literal of
+ * variable x is 2x, and the negative literal is 2x+1. So literals of the
+ * smt_core can be passed unchanged to the backend.
+ */
+
+#ifndef __SAT_BACKEND_H
+#define __SAT_BACKEND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "yices_types.h"
+
+
+typedef struct sat_backend_s sat_backend_t;
+
+
+/*
+ * Allocate and initialize a backend with n variables
+ * - variable 0 is the reserved true variable (so n must be positive)
+ * - pp = whether to use preprocessing
+ */
+extern sat_backend_t *new_sat_backend(uint32_t n, bool pp);
+
+/*
+ * Delete the backend and free memory
+ */
+extern void free_sat_backend(sat_backend_t *b);
+
+/*
+ * Set the verbosity level (0 means quiet)
+ */
+extern void sat_backend_set_verbosity(sat_backend_t *b, uint32_t level);
+
+/*
+ * Set the seed of the backend's pseudo random number generator
+ */
+extern void sat_backend_set_random_seed(sat_backend_t *b, uint32_t seed);
+
+/*
+ * Add clause a[0 ... n-1]
+ * - every literal must be between 0 and 2n-1 where n = number of variables
+ * - the array is modified
+ */
+extern void sat_backend_add_clause(sat_backend_t *b, uint32_t n, int32_t *a);
+
+/*
+ * Check satisfiability:
+ * - return STATUS_SAT, STATUS_UNSAT, or STATUS_INTERRUPTED
+ */
+extern smt_status_t sat_backend_solve(sat_backend_t *b);
+
+/*
+ * Interrupt the search
+ * - this can be called from a signal handler
+ */
+extern void sat_backend_stop(sat_backend_t *b);
+
+/*
+ * Value of variable x in the backend's model
+ * - the last call to sat_backend_solve must have returned STATUS_SAT
+ */
+extern bool sat_backend_var_is_true(sat_backend_t *b, int32_t x);
+
+
+#endif /* __SAT_BACKEND_H */
@@ -23,6 +23,7 @@
 #include <assert.h>
 #include <stddef.h>
 #include <float.h>
+#include <string.h>
 
 #include "solvers/cdcl/smt_core.h"
 #include "utils/gcd.h"
@@ -156,6 +157,33 @@ static inline void multiply_activity(clause_t *cl, float scale) {
   learned(cl)->activity *= scale;
 }
 
+/*
+ * LBD of a learned clause
+ */
+static inline uint32_t get_lbd(const clause_t *cl) {
+  return learned(cl)->lbd;
+}
+
+static inline void set_lbd(clause_t *cl, uint32_t lbd) {
+  assert(lbd <= MAX_CLAUSE_LBD);
+  learned(cl)->lbd = lbd;
+}
+
+/*
+ * Flag set when a learned clause is used in conflict resolution
+ */
+static inline bool clause_is_used(const clause_t *cl) {
+  return learned(cl)->used != 0;
+}
+
+static inline void set_clause_used(clause_t *cl) {
+  learned(cl)->used = 1;
+}
+
+static inline void clear_clause_used(clause_t *cl) {
+  learned(cl)->used = 0;
+}
+
 /*
  * Mark a clause cl for removal
  */
@@ -224,10 +252,11 @@ static inline void delete_clause(clause_t *cl) {
  * Allocate and initialize a new learned clause
  * \param len = number of literals
  * \param lit = array of len literals
+ * \param lbd = literal block distance
  * The watched pointers are not initialized.
- * The activity is initialized to 0.0
+ * The activity is initialized to 0.0 and the used flag is cleared.
  */
-static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
+static clause_t *new_learned_clause(uint32_t len, literal_t *lit, uint32_t lbd) {
   learned_clause_t *tmp;
   clause_t *result;
   uint32_t i;
@@ -235,6 +264,8 @@ static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
   tmp = (learned_clause_t *) safe_malloc(sizeof(learned_clause_t) + sizeof(literal_t) +
                                          len * sizeof(literal_t));
   tmp->activity = 0.0;
+  tmp->lbd = (lbd < MAX_CLAUSE_LBD) ? lbd : MAX_CLAUSE_LBD;
+  tmp->used = 0;
   result = &(tmp->clause);
 
   for (i=0; i<len; i++) {
@@ -411,6 +442,103 @@ static inline literal_t last_lv_elem(literal_t *v) {
 #endif
 
 
+/********************
+ *  WATCH VECTORS   *
+ *******************/
+
+/*
+ * Watch vectors are initially NULL. Memory is allocated
+ * on the first addition.
+ */
+
+/*
+ * Make room in vector *v for at least one more element
+ * - allocate a fresh vector if *v == NULL
+ * - resize *v if *v is full.
+ */
+static void extend_watch_vector(watch_elem_t **v) {
+  watch_vector_t *vector;
+  watch_elem_t *d;
+  uint32_t n;
+
+  d = *v;
+  if (d == NULL) {
+    n = DEF_WATCH_VECTOR_SIZE;
+    vector = (watch_vector_t *)
+      safe_malloc(sizeof(watch_vector_t) + n * sizeof(watch_elem_t));
+    vector->capacity = n;
+    vector->size = 0;
+    *v = vector->data;
+  } else {
+    vector = wv_header(d);
+    n = vector->capacity + 1;
+    n += n>>1; // new cap = 50% more than old capacity
+    if (n > MAX_WATCH_VECTOR_SIZE) {
+      out_of_memory();
+    }
+    vector = (watch_vector_t *)
+      safe_realloc(vector, sizeof(watch_vector_t) + n * sizeof(watch_elem_t));
+    vector->capacity = n;
+    *v = vector->data;
+  }
+}
+
+/*
+ * Add the pair <cl, blocker> at the end of vector *v
+ */
+static inline void add_watch_to_vector(watch_elem_t **v, clause_t *cl, literal_t blocker) {
+  watch_vector_t *vector;
+  uint32_t i;
+
+  if (*v == NULL || get_wv_size(*v) == get_wv_capacity(*v)) {
+    extend_watch_vector(v);
+  }
+
+  vector = wv_header(*v);
+  i = vector->size;
+  assert(i < vector->capacity);
+  vector->data[i].clause = cl;
+  vector->data[i].blocker = blocker;
+  vector->size = i+1;
+}
+
+
+/*
+ * Delete watch vector v
+ */
+static void delete_watch_vector(watch_elem_t *v) {
+  if (v != NULL) {
+    safe_free(wv_header(v));
+  }
+}
+
+
+/*
+ * Empty watch vector v (keep the memory)
+ */
+static inline void reset_watch_vector(watch_elem_t *v) {
+  if (v != NULL) {
+    set_wv_size(v, 0);
+  }
+}
+
+
+/*
+ * Add cl to the watch vectors of its two watched literals
+ * - cl->cl[0] and cl->cl[1] must be the watched literals
+ * - each literal is used as the initial blocker for the other one
+ */
+static void add_clause_to_watch_vectors(smt_core_t *s, clause_t *cl) {
+  literal_t l0, l1;
+
+  l0 = cl->cl[0];
+  l1 = cl->cl[1];
+  add_watch_to_vector(s->watch + l0, cl, l1);
+  add_watch_to_vector(s->watch + l1, cl, l0);
+}
+
+
+
 /***********
  *  STACK  *
  **********/
@@ -1287,6 +1415,11 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->bin_clauses_deleted = 0;
   stat->literals_before_simpl = 0;
   stat->subsumed_literals = 0;
+  stat->inprocess_calls = 0;
+  stat->eliminated_vars = 0;
+  stat->subsumed_clauses = 0;
+  stat->strengthened_clauses = 0;
+  stat->vivified_clauses = 0;
 }
 
 
@@ -1504,6 +1637,9 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->aux_literals = 0;
   s->aux_clauses = 0;
 
+  s->inprocess_next = 0;
+  s->inprocess_interval = INPROCESS_INTERVAL;
+
   s->decision_level = 0;
   s->base_level = 0;
 
@@ -1513,6 +1649,13 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->prng = CORE_PRNG_SEED;
   s->scaled_random = (uint32_t) (VAR_RANDOM_FACTOR * VAR_RANDOM_SCALE);
 
+  // learned-clause tiers
+  s->keep_lbd = DEFAULT_KEEP_LBD;
+  s->tier2_lbd = DEFAULT_TIER2_LBD;
+  s->level_stamp = NULL;
+  s->level_stamp_size = 0;
+  s->lbd_counter = 0;
+
   // theory caching: disabled initially
   s->th_cache_enabled = false;
   s->th_cache_cl_size = 0;
@@ -1545,6 +1688,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->antecedent = (antecedent_t *) safe_malloc(n * sizeof(antecedent_t));
   s->level = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t)) + 1;
   s->mark = allocate_bitvector(n);
+  s->elim = allocate_bitvector(n);
   s->level[-1] = UINT32_MAX;
   s->value[-1] = VAL_UNDEF_FALSE;
 
@@ -1552,7 +1696,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
    * Literal-indexed arrays
    */
   s->bin = (literal_t **) safe_malloc(lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_malloc(lsize * sizeof(link_t));
+  s->watch = (watch_elem_t **) safe_malloc(lsize * sizeof(watch_elem_t *));
 
   /*
    * Initialize data structures for true_literal and false_literal
@@ -1561,13 +1705,14 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->level[const_bvar] = 0;
   s->value[const_bvar] = VAL_TRUE;
   set_bit(s->mark, const_bvar);
+  clr_bit(s->elim, const_bvar);
   assert(literal_value(s, true_literal) == VAL_TRUE &&
 	 literal_value(s, false_literal) == VAL_FALSE);
 
   s->bin[true_literal] = NULL;
   s->bin[false_literal] = NULL;
-  s->watch[true_literal] = NULL_LINK;
-  s->watch[false_literal] = NULL_LINK;
+  s->watch[true_literal] = NULL;
+  s->watch[false_literal] = NULL;
 
   init_stack(&s->stack, n);
   init_heap(&s->heap, n);
@@ -1578,6 +1723,21 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   init_checkpoint_stack(&s->checkpoints);
   s->cp_flag = false;
 
+  s->has_assumptions = false;
+  s->num_assumptions = 0;
+  s->assumption_index = 0;
+  s->assumptions = NULL;
+  s->bad_assumption = null_literal;
+
+  s->var_elim = false;
+  s->nb_elim_vars = 0;
+  init_ivector(&s->elim_stack, 0);
+
+  s->export_lbd = 0;
+  s->export_size = 0;
+  s->export_nvars = 0;
+  init_ivector(&s->exported, 0);
+
   s->etable = NULL;
   s->trace = NULL;
 }
@@ -1606,6 +1766,8 @@ void delete_smt_core(smt_core_t *s) {
   delete_ivector(&s->buffer);
   delete_ivector(&s->buffer2);
   delete_ivector(&s->explanation);
+  safe_free(s->level_stamp);
+  s->level_stamp = NULL;
 
   // Delete all the clauses
   cl = s->problem_clauses;
@@ -1629,11 +1791,15 @@ void delete_smt_core(smt_core_t *s) {
   safe_free(s->antecedent);
   safe_free(s->level - 1);
   delete_bitvector(s->mark);
+  delete_bitvector(s->elim);
+  delete_ivector(&s->elim_stack);
+  delete_ivector(&s->exported);
 
   // literal-indexed arrays
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch[i]);
   }
   safe_free(s->bin);
   safe_free(s->watch);
@@ -1678,10 +1844,13 @@ void reset_smt_core(smt_core_t *s) {
 
   ivector_reset(&s->binary_clauses);
 
-  // delete binary-watched literal vectors
+  // delete binary-watched literal vectors and watch vectors
   n = s->nlits;
   for (i=0; i<n; i++) {
     delete_literal_vector(s->bin[i]);
+    delete_watch_vector(s->watch[i]);
+    s->bin[i] = NULL;
+    s->watch[i] = NULL;
   }
 
   reset_stack(&s->stack);
@@ -1693,6 +1862,18 @@ void reset_smt_core(smt_core_t *s) {
   reset_checkpoint_stack(&s->checkpoints);
   s->cp_flag = false;
 
+  s->has_assumptions = false;
+  s->num_assumptions = 0;
+  s->assumption_index = 0;
+  s->assumptions = NULL;
+  s->bad_assumption = null_literal;
+
+  s->nb_elim_vars = 0;
+  ivector_reset(&s->elim_stack);
+
+  s->export_lbd = 0;
+  ivector_reset(&s->exported);
+
   // reset all counters
   s->nvars = 1;
   s->nlits = 2;
@@ -1703,6 +1884,8 @@ void reset_smt_core(smt_core_t *s) {
   s->simplify_bottom = 0;
   s->simplify_props = 0;
   s->simplify_threshold = 0;
+  s->inprocess_next = 0;
+  s->inprocess_interval = INPROCESS_INTERVAL;
   s->decision_level = 0;
   s->base_level = 0;
 
@@ -1748,9 +1931,10 @@ static void extend_smt_core(smt_core_t *s, uint32_t n) {
   s->antecedent = (antecedent_t *) safe_realloc(s->antecedent, n * sizeof(antecedent_t));
   s->level = (uint32_t *) safe_realloc(s->level - 1, (n + 1) * sizeof(uint32_t)) + 1;
   s->mark = extend_bitvector(s->mark, n);
+  s->elim = extend_bitvector(s->elim, n);
 
   s->bin = (literal_t **) safe_realloc(s->bin, lsize * sizeof(literal_t *));
-  s->watch = (link_t *) safe_realloc(s->watch, lsize * sizeof(link_t));
+  s->watch = (watch_elem_t **) safe_realloc(s->watch, lsize * sizeof(watch_elem_t *));
 
   extend_heap(&s->heap, n);
   extend_stack(&s->stack, n);
@@ -1820,6 +2004,7 @@ static void init_variable(smt_core_t *s, bvar_t x) {
   literal_t l0, l1;
 
   clr_bit(s->mark, x);
+  clr_bit(s->elim, x);
   s->value[x] = VAL_UNDEF_FALSE;
   s->antecedent[x] = mk_literal_antecedent(null_literal);
   s->level[x] = UINT32_MAX;
@@ -1840,8 +2025,8 @@ static void init_variable(smt_core_t *s, bvar_t x) {
   l1 = neg_lit(x);
   s->bin[l0] = NULL;
   s->bin[l1] = NULL;
-  s->watch[l0] = NULL_LINK;
-  s->watch[l1] = NULL_LINK;
+  s->watch[l0] = NULL;
+  s->watch[l1] = NULL;
 }
 
 /*
@@ -2131,7 +2316,7 @@ literal_t select_unassigned_literal(smt_core_t *s) {
     if (rnd < s->scaled_random) {
       x = random_uint(s, s->nvars);
       assert(0 <= x && x < s->nvars);
-      if (bval_is_undef(v[x])) {
+      if (bval_is_undef(v[x]) && ! tst_bit(s->elim, x)) {
 #if TRACE
 	printf("---> DPLL:   Random selection: variable ");
 	print_bvar(stdout, x);
@@ -2292,6 +2477,100 @@ static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
 
 
 
+/**********************************
+ *  LITERAL BLOCK DISTANCE (LBD)  *
+ *********************************/
+
+/*
+ * Make sure the level_stamp array is large enough for all levels
+ * up to s->decision_level.
+ */
+static void resize_level_stamp(smt_core_t *s) {
+  uint32_t i, n;
+
+  n = s->level_stamp_size;
+  if (n <= s->decision_level) {
+    n += n >> 1;
+    if (n <= s->decision_level) {
+      n = s->decision_level + 1;
+    }
+    s->level_stamp = (uint32_t *) safe_realloc(s->level_stamp, n * sizeof(uint32_t));
+    for (i=s->level_stamp_size; i<n; i++) {
+      s->level_stamp[i] = 0;
+    }
+    s->level_stamp_size = n;
+  }
+}
+
+
+/*
+ * Compute the LBD of a[0 ... n-1] = number of distinct decision levels
+ * among the assigned literals of a.
+ */
+static uint32_t compute_lbd(smt_core_t *s, uint32_t n, const literal_t *a) {
+  uint32_t i, k, lbd, stamp;
+  bvar_t x;
+
+  resize_level_stamp(s);
+
+  stamp = s->lbd_counter + 1;
+  if (stamp == 0) {
+    // wrap around: clear all stamps
+    for (i=0; i<s->level_stamp_size; i++) {
+      s->level_stamp[i] = 0;
+    }
+    stamp = 1;
+  }
+  s->lbd_counter = stamp;
+
+  lbd = 0;
+  for (i=0; i<n; i++) {
+    x = var_of(a[i]);
+    if (bval_is_def(s->value[x])) {
+      k = s->level[x];
+      assert(k <= s->decision_level);
+      if (s->level_stamp[k] != stamp) {
+        s->level_stamp[k] = stamp;
+        lbd ++;
+      }
+    }
+  }
+
+  return lbd;
+}
+
+
+/*
+ * Same thing for a learned clause cl
+ */
+static uint32_t clause_lbd(smt_core_t *s, clause_t *cl) {
+  return compute_lbd(s, clause_length(cl), cl->cl);
+}
+
+
+/*
+ * Learned clause cl is involved in conflict resolution:
+ * - increase its activity and mark it as used
+ * - recompute its LBD if it may move to a better tier (i.e., if it's not
+ *   already in the core tier). This may promote the clause.
+ */
+static void bump_learned_clause(smt_core_t *s, clause_t *cl) {
+  uint32_t old_lbd, lbd;
+
+  increase_clause_activity(s, cl);
+  set_clause_used(cl);
+
+  old_lbd = get_lbd(cl);
+  if (old_lbd > s->keep_lbd) {
+    lbd = clause_lbd(s, cl);
+    if (lbd < old_lbd) {
+      set_lbd(cl, lbd);
+    }
+  }
+}
+
+
+
 
 /*******************
  *  BACKTRACKING   *
@@ -2340,6 +2619,9 @@ static void backtrack(smt_core_t *s, uint32_t back_level) {
   s->stack.theory_ptr = i;
   s->decision_level = back_level;
 
+  // assumptions must be checked again
+  s->assumption_index = 0;
+
   // Update the cp_flag: the deletion of atoms is enabled if there's a checkpoint
   // and if the top checkpoint has level >= the new decision level
   s->cp_flag = non_empty_checkpoint_stack(&s->checkpoints) &&
@@ -2547,90 +2829,119 @@ static bool propagation_via_bin_vector(smt_core_t *s, uint8_t *val, literal_t l0
 
 
 /*
- * Propagation via the watched lists of a literal l0.
+ * Propagation via the watch vector of a literal l0.
  * - val = literal value array (must be s->value)
+ * - l0 must be false in the current assignment
+ *
+ * For each element <cl, blocker> of watch[l0]:
+ * - if blocker is true, cl is skipped without being read
+ * - otherwise, we look for a new watched literal in cl, or
+ *   cl is either a unit clause or a conflict.
+ *
+ * The vector is scanned from the end so that the most recently
+ * added clauses are visited first. The elements that are kept are
+ * compacted at the end of the vector then moved back to the front.
  *
  * Return true if there's no conflict, false otherwise
  */
-static bool propagation_via_watched_list(smt_core_t *s, uint8_t *val, literal_t l0) {
+static bool propagation_via_watch_vector(smt_core_t *s, uint8_t *val, literal_t l0) {
+  watch_elem_t *w;
   clause_t *cl;
-  link_t *list;
-  link_t link;
   bval_t v1;
-  uint32_t k, i;
+  uint32_t i, j, k, n;
   literal_t l1, l, *b;
 
-  assert(s->value == val);
+  assert(s->value == val && literal_value(s, l0) == VAL_FALSE);
 
-  list = &s->watch[l0];
-  link = *list;
-  while (link != NULL_LINK) {
-    cl = clause_of(link);
-    i = idx_of(link);
-    l1 = get_other_watch(cl, i);
-    v1 = lit_val(val, l1);
+  w = s->watch[l0];
+  if (w == NULL) return true;
+
+  n = get_wv_size(w);
+  i = n;
+  j = n;
+  while (i > 0) {
+    i --;
+    if (lit_val(val, w[i].blocker) == VAL_TRUE) {
+      // Skip: the clause is already true
+      j --;
+      w[j] = w[i];
+      continue;
+    }
 
-    assert(next_of(link) == cl->link[i]);
-    assert(cdr_ptr(link) == cl->link + i);
+    /*
+     * Get the other watched literal of cl.
+     * k = index of l0 in cl (0 or 1)
+     */
+    cl = w[i].clause;
+    b = cl->cl;
+    k = (b[1] == l0);
+    assert(b[k] == l0);
+    l1 = b[k ^ 1];
+    v1 = lit_val(val, l1);
 
     if (v1 == VAL_TRUE) {
+      // Skip cl and use l1 as the new blocker
+      j --;
+      w[j].clause = cl;
+      w[j].blocker = l1;
+      continue;
+    }
+
+    /*
+     * Search for a new watched literal in cl.
+     * The loop terminates since cl->cl terminates with an end marked
+     * and val[end_marker] == VAL_UNDEF.
+     */
+    k = 1;
+    do {
+      k ++;
+      l = b[k];
+    } while (lit_val(val, l) == VAL_FALSE);
+
+    if (l >= 0) {
       /*
-       * Skip clause cl: it's already true
+       * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
+       * make l a new watched literal
+       * - swap l0 and b[k]
+       * - move cl to l's watch vector (l != l0 so w is not modified)
        */
-      *list = link;
-      list = cl->link + i;
-      link = cl->link[i];
+      b[k] = l0;
+      if (b[0] == l0) {
+        b[0] = l;
+      } else {
+        b[1] = l;
+      }
+      add_watch_to_vector(s->watch + l, cl, l1);
 
     } else {
       /*
-       * Search for a new watched literal in cl.
-       * The loop terminates since cl->cl terminates with an end marked
-       * and val[end_marker] == VAL_UNDEF.
+       * All literals of cl, except possibly l1, are false
        */
-      k = 1;
-      b = cl->cl;
-      do {
-        k ++;
-        l = b[k];
-      } while (lit_val(val, l) == VAL_FALSE);
-
-      if (l >= 0) {
-        /*
-         * l occurs in b[k] = cl->cl[k] and is either TRUE or UNDEF
-         * make l a new watched literal
-         * - swap b[i] and b[k]
-         * - insert cl into l's watched list (link[i])
-         */
-        b[k] = b[i];
-        b[i] = l;
-
-        // insert cl in watch[l] list and move to the next clause
-        link = cl->link[i];
-        s->watch[l] = cons(i, cl, s->watch[l]);
-      } else {
-        /*
-         * All literals of cl, except possibly l1, are false
-         */
-	if (bval_is_undef(v1)) {
-          // l1 is implied
-          implied_literal(s, l1, mk_clause_antecedent(cl, i^1));
+      j --;
+      w[j].clause = cl;
+      w[j].blocker = l1;
 
-          // move to the next clause
-          *list = link;
-          list = cl->link + i;
-          link = cl->link[i];
+      if (bval_is_undef(v1)) {
+        // l1 is implied
+        implied_literal(s, l1, mk_clause_antecedent(cl, b[1] == l1));
 
-        } else {
-          // v1 == VAL_FALSE: conflict found
-          record_clause_conflict(s, cl);
-          *list = link;
-          return false;
+      } else {
+        // v1 == VAL_FALSE: conflict found
+        // w[0 ... i-1] have not been visited: keep them in place
+        if (i < j) {
+          memmove(w + i, w + j, (n - j) * sizeof(watch_elem_t));
         }
+        set_wv_size(w, i + (n - j));
+        record_clause_conflict(s, cl);
+        return false;
       }
     }
   }
 
-  *list = NULL_LINK;
+  if (j > 0) {
+    memmove(w, w + j, (n - j) * sizeof(watch_elem_t));
+  }
+  set_wv_size(w, n - j);
 
   return true;
 }
@@ -2658,7 +2969,7 @@ static bool boolean_propagation(smt_core_t *s) {
       return false;
     }
 
-    if (! propagation_via_watched_list(s, val, l)) {
+    if (! propagation_via_watch_vector(s, val, l)) {
       return false;
     }
   }
@@ -2843,6 +3154,29 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
 }
 
 
+/*
+ * Copy learned clause a[0 ... n-1] into the export vector if it's short,
+ * has a small LBD, and contains only exported variables
+ * - this must be called before backtracking (to compute the LBD)
+ */
+static void export_learned_clause(smt_core_t *s, uint32_t n, const literal_t *a) {
+  ivector_t *v;
+  uint32_t i, lbd;
+
+  if (n > s->export_size) return;
+  for (i=0; i<n; i++) {
+    if (var_of(a[i]) >= s->export_nvars) return;
+  }
+  lbd = (n <= 2) ? n : compute_lbd(s, n, a);
+  if (lbd > s->export_lbd) return;
+
+  v = &s->exported;
+  ivector_push(v, n);
+  ivector_push(v, lbd);
+  ivector_add(v, a, n);
+}
+
+
 /*
  * Add an array of literals a as a new learned clause, after conflict resolution.
  * - n must be at least 1
@@ -2867,6 +3201,10 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   fflush(stdout);
 #endif
 
+  if (s->export_lbd > 0) {
+    export_learned_clause(s, n, a);
+  }
+
   l0 = a[0];
 
   if (n == 1) {
@@ -2921,13 +3259,12 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     l1 = a[j]; a[j] = a[1]; a[1] = l1;
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(n, a, compute_lbd(s, n, a));
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
 
-    // add cl at the start of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add cl to watch[l0] and watch[l1]
+    add_clause_to_watch_vectors(s, cl);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
@@ -3014,13 +3351,12 @@ static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 #endif
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(n, a, compute_lbd(s, n, a));
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
 
-    // insert cl at the head of watch[l0] and watch[l1]
-    s->watch[l0] = cons(0, cl, s->watch[l0]);
-    s->watch[l1] = cons(1, cl, s->watch[l1]);
+    // add cl to watch[l0] and watch[l1]
+    add_clause_to_watch_vectors(s, cl);
 
     s->nb_clauses ++;
     s->stats.learned_literals += n;
@@ -3483,7 +3819,7 @@ static void resolve_conflict(smt_core_t *s) {
    * If the conflict is a learned clause, increase its activity
    */
   if (l == end_learned) {
-    increase_clause_activity(s, s->false_clause);
+    bump_learned_clause(s, s->false_clause);
   }
 
   assert(unresolved > 0);
@@ -3532,7 +3868,7 @@ static void resolve_conflict(smt_core_t *s) {
             l = *c;
           }
           if (l == end_learned) {
-            increase_clause_activity(s, cl);
+            bump_learned_clause(s, cl);
           }
           break;
 
@@ -3652,7 +3988,6 @@ static void resolve_conflict(smt_core_t *s) {
  */
 static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   clause_t *cl;
-  literal_t l;
 
 #if TRACE
   uint32_t i;
@@ -3668,12 +4003,8 @@ static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   cl = new_clause(n, a);
   add_clause_to_vector(&s->problem_clauses, cl);
 
-  // add cl at the start of watch lists
-  l = a[0];
-  s->watch[l] = cons(0, cl, s->watch[l]);
-
-  l = a[1];
-  s->watch[l] = cons(1, cl, s->watch[l]);
+  // add cl to the watch vectors of a[0] and a[1]
+  add_clause_to_watch_vectors(s, cl);
 
   s->nb_prob_clauses ++;
   s->nb_clauses ++;
@@ -4108,6 +4439,58 @@ void add_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 }
 
 
+/*
+ * Import a learned clause from another solver
+ * - s must be at the base level so all assigned literals are
+ *   assigned at the base level
+ */
+void import_learned_clause(smt_core_t *s, uint32_t n, const literal_t *a, uint32_t lbd) {
+  ivector_t *v;
+  clause_t *cl;
+  uint32_t i;
+  literal_t l;
+
+  assert(s->decision_level == s->base_level);
+
+  // the search may have been interrupted asynchronously
+  if (s->inconsistent || s->status != STATUS_SEARCHING) return;
+
+  v = &s->buffer2;
+  assert(v->size == 0);
+
+  for (i=0; i<n; i++) {
+    l = a[i];
+    assert(0 <= l && l < s->nlits);
+    if (tst_bit(s->elim, var_of(l)) || literal_value(s, l) == VAL_TRUE) {
+      goto done;
+    }
+    if (literal_value(s, l) != VAL_FALSE) {
+      ivector_push(v, l);
+    }
+  }
+
+  n = v->size;
+  if (n > 2) {
+    cl = new_learned_clause(n, v->data, (lbd < n) ? lbd : n);
+    add_clause_to_vector(&s->learned_clauses, cl);
+    increase_clause_activity(s, cl);
+    add_clause_to_watch_vectors(s, cl);
+    s->nb_clauses ++;
+    s->stats.learned_literals += n;
+  } else if (n == 2) {
+    direct_binary_clause(s, v->data[0], v->data[1]);
+  } else if (n == 1) {
+    assign_literal(s, v->data[0]);
+    s->nb_unit_clauses ++;
+  } else {
+    record_empty_conflict(s);
+  }
+
+ done:
+  ivector_reset(v);
+}
+
+
 /*
  * Short cuts
  */
@@ -4221,16 +4604,29 @@ static void add_all_lemmas(smt_core_t *s) {
  *  DELETION OF LEARNED CLAUSES  *
  ********************************/
 
+/*
+ * Ordering used by reduce_clause_database: c1 is worse than c2 if
+ * it has a larger lbd, or the same lbd and a lower activity.
+ */
+static inline bool worse_clause(clause_t *c1, clause_t *c2) {
+  uint32_t lbd1, lbd2;
+
+  lbd1 = get_lbd(c1);
+  lbd2 = get_lbd(c2);
+  return lbd1 > lbd2 || (lbd1 == lbd2 && get_activity(c1) < get_activity(c2));
+}
+
+
 /*
  * Reorder an array  a[low ... high-1] of learned clauses so that
  * the clauses are divided in two half arrays:
- * - the clauses of highest activities are all stored in a[low...half - 1]
- * - the clauses of lowest activities are in a[half ... high-1],
+ * - the worst clauses (cf. worse_clause) are all stored in a[low...half - 1]
+ * - the best clauses are in a[half ... high-1],
  * where half = (low + high) / 2.
  */
 static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   uint32_t i, j, half;
-  float pivot;
+  clause_t *pivot;
   clause_t *aux;
 
   if (high <= low + 1) return;
@@ -4240,31 +4636,31 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   do {
     i = low;
     j = high;
-    pivot = get_activity(a[i]);
+    pivot = a[i];
 
-    do { j --; } while (get_activity(a[j]) < pivot);
-    do { i ++; } while (i <= j && get_activity(a[i]) > pivot);
+    do { j --; } while (worse_clause(pivot, a[j]));
+    do { i ++; } while (i <= j && worse_clause(a[i], pivot));
 
     while (i < j) {
-      // a[i].act <= pivot and a[j].act >= pivot: swap a[i] and a[j]
+      // a[i] is no worse than pivot and pivot is no worse than a[j]: swap a[i] and a[j]
       aux = a[i];
       a[i] = a[j];
       a[j] = aux;
 
-      do { j--; } while (get_activity(a[j]) < pivot);
-      do { i++; } while (get_activity(a[i]) > pivot);
+      do { j--; } while (worse_clause(pivot, a[j]));
+      do { i++; } while (worse_clause(a[i], pivot));
     }
 
-    // a[j].act >= pivot, a[low].act = pivot: swap a[low] and a[i]
+    // pivot is no worse than a[j], a[low] = pivot: swap a[low] and a[j]
     aux = a[low];
     a[low] = a[j];
     a[j] = aux;
 
     /*
      * at this point:
-     * - all clauses in a[low,.., j - 1] have activity >= pivot
-     * - activity of a[j] == pivot
-     * - all clauses in a[j+1,..., high-1] have activity <= pivot
+     * - all clauses in a[low,.., j - 1] are no better than pivot
+     * - a[j] == pivot
+     * - all clauses in a[j+1,..., high-1] are no worse than pivot
      * reapply the procedure to whichever of the two subarrays
      * contains the half point
      */
@@ -4276,34 +4672,25 @@ static void quick_split(clause_t **a, uint32_t low, uint32_t high) {
   } while (j != half);
 }
 
-
-/*
- * Apply this to a vector v of learned_clauses
- */
-static void reorder_clause_vector(clause_t **v) {
-  quick_split(v, 0, get_cv_size(v));
-}
-
-
 /*
- * Auxiliary function: follow clause list of l0
+ * Auxiliary function: scan the watch vector of l0
  * Remove all clauses marked for removal
  */
 static void cleanup_watch_list(smt_core_t *s, literal_t l0) {
-  link_t lnk;
-  clause_t *cl;
-  link_t *list;
+  watch_elem_t *w;
+  uint32_t i, j, n;
 
-  list = s->watch + l0;
-  for (lnk = *list; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    cl = clause_of(lnk);
-    if (! is_clause_to_be_removed(cl)) {
-      *list = lnk;
-      list = cdr_ptr(lnk);
+  w = s->watch[l0];
+  if (w != NULL) {
+    n = get_wv_size(w);
+    j = 0;
+    for (i=0; i<n; i++) {
+      if (! is_clause_to_be_removed(w[i].clause)) {
+        w[j ++] = w[i];
+      }
     }
+    set_wv_size(w, j);
   }
-
-  *list = NULL_LINK; // end of list
 }
 
 
@@ -4350,6 +4737,7 @@ static void delete_learned_clauses(smt_core_t *s) {
   // do the real deletion
   s->stats.learned_literals = 0;
 
+
   j = 0;
   for (i = 0; i<n; i++) {
     if (is_clause_to_be_removed(v[i])) {
@@ -4370,36 +4758,43 @@ static void delete_learned_clauses(smt_core_t *s) {
 
 
 /*
- * Delete half the learned clauses, minus the locked ones (Minisat style).
+ * Reduce the learned clause database (tiered, LBD-based):
+ * - clauses that are locked, or have lbd <= keep_lbd (core tier), are kept
+ * - clauses that have lbd <= tier2_lbd and have been used since the
+ *   previous reduction are kept
+ * - the used flag of all clauses is cleared
+ * - the remaining clauses are candidates for deletion: we delete
+ *   the worse half (larger lbd first, then lower activity).
  * This is expensive: the function scans and reconstructs the
  * watched lists.
  */
 void reduce_clause_database(smt_core_t *s) {
-  uint32_t i, n;
+  uint32_t i, j, n;
   clause_t **v;
-  float act_threshold;
+  clause_t *cl;
 
   v = s->learned_clauses;
   n = get_cv_size(v);
   if (n == 0) return;
 
-  // put the clauses with lowest activity in the upper
-  // half of the learned clause vector.
-  reorder_clause_vector(v);
-
-  act_threshold = s->cla_inc/n;
-
-  // prepare for deletion: all non-locked clauses, with activity less
-  // than activity_threshold are marked for deletion.
-  for (i=0; i<n/2; i++) {
-    if (get_activity(v[i]) <= act_threshold && ! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
+  // move all the deletion candidates to v[0 ... j-1]
+  j = 0;
+  for (i=0; i<n; i++) {
+    cl = v[i];
+    if (get_lbd(cl) > s->keep_lbd &&
+        (get_lbd(cl) > s->tier2_lbd || !clause_is_used(cl)) &&
+        ! clause_is_locked(s, cl)) {
+      v[i] = v[j];
+      v[j] = cl;
+      j ++;
     }
+    clear_clause_used(cl);
   }
-  for (i = n/2; i<n; i++) {
-    if (! clause_is_locked(s, v[i])) {
-      mark_for_removal(v[i]);
-    }
+
+  // put the worst candidates in v[0 ... j/2 - 1] and delete them
+  quick_split(v, 0, j);
+  for (i=0; i<j/2; i++) {
+    mark_for_removal(v[i]);
   }
 
   delete_learned_clauses(s);
@@ -4409,7 +4804,6 @@ void reduce_clause_database(smt_core_t *s) {
 
 
 
-
 /*******************************************************
  *  ZCHAFF-STYLE CLAUSE DELETION (AS IN YICES 1.0.XX)  *
  ******************************************************/
@@ -4455,7 +4849,7 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
 
   for (i=0; i<n; i++) {
     cl = v[i];
-    if (! clause_is_locked(s, cl)) {
+    if (get_lbd(cl) > s->keep_lbd && ! clause_is_locked(s, cl)) {
       relevance = i < p ? HEAD_RELEVANCE : TAIL_RELEVANCE;
       if (get_activity(cl) < HEAD_ACTIVITY - coeff * i &&
           unassigned_literals(s, cl) > relevance) {
@@ -4801,25 +5195,868 @@ static void simplify_clause_database(smt_core_t *s) {
 
 
 
+/******************
+ *  INPROCESSING  *
+ *****************/
 
-/**************
- *  PUSH/POP  *
- *************/
+/*
+ * Inprocessing is applied periodically at decision level 0 (so only
+ * when base_level is 0). It simplifies the clause database using:
+ * - subsumption and self-subsuming resolution on the problem clauses
+ *   (binary clauses are also used as subsuming clauses)
+ * - bounded variable elimination, if s->var_elim is true: a variable x
+ *   that's not attached to an atom is eliminated if the clauses that
+ *   contain x or not(x) can be replaced by no more resolvents. The removed
+ *   clauses are saved in s->elim_stack and used to assign x in final_check.
+ * - vivification of the most recent learned clauses.
+ *
+ * Clauses removed during a round are marked for removal then deleted
+ * at the end of the round. New clauses are added at the end of
+ * s->problem_clauses (and attached to the watch vectors as usual).
+ */
 
 /*
- * Push:
- * - clear current assignment and reset status to IDLE if necessary
- * - save current base-level state
- * - notify the theory solver
- * - increase base level
+ * Signature of a literal: bit (var mod 32)
  */
-void smt_push(smt_core_t *s) {
-  uint32_t k;
+static inline uint32_t lit_signature(literal_t l) {
+  return ((uint32_t) 1) << (var_of(l) & 31);
+}
 
-  /*
-   * Abort if push_pop is not enabled
-   */
-  assert((s->option_flag & PUSH_POP_MASK) != 0);
+/*
+ * Number of clauses in occurrence list occ[l]
+ */
+static inline uint32_t occ_size(inprocessor_t *p, literal_t l) {
+  return p->occ[l] == NULL ? 0 : get_lv_size(p->occ[l]);
+}
+
+
+/*
+ * Add problem clause cl of index i to the occurrence lists
+ * - i must be equal to the size of p->sig
+ */
+static void inprocessor_add_clause(inprocessor_t *p, clause_t *cl, uint32_t i) {
+  uint32_t j, sig;
+  literal_t l;
+
+  assert(p->sig.size == i);
+
+  sig = 0;
+  j = 0;
+  l = cl->cl[0];
+  while (l >= 0) {
+    add_literal_to_vector(p->occ + l, i);
+    sig |= lit_signature(l);
+    j ++;
+    l = cl->cl[j];
+  }
+  ivector_push(&p->sig, (int32_t) sig);
+}
+
+
+/*
+ * Initialize p for an inprocessing round
+ * - the locked problem clauses are ignored: all their literals are
+ *   assigned at level 0 so they don't matter for inprocessing.
+ */
+static void init_inprocessor(smt_core_t *s, inprocessor_t *p) {
+  clause_t **v;
+  uint32_t i, n;
+
+  n = s->nlits;
+  p->occ = (literal_t **) safe_malloc(n * sizeof(literal_t *));
+  for (i=0; i<n; i++) {
+    p->occ[i] = NULL;
+  }
+  p->lit_mark = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  memset(p->lit_mark, 0, n * sizeof(uint8_t));
+
+  init_ivector(&p->sig, get_cv_size(s->problem_clauses));
+  init_ivector(&p->pos, DEF_LBUFFER_SIZE);
+  init_ivector(&p->neg, DEF_LBUFFER_SIZE);
+  init_ivector(&p->refs, DEF_LBUFFER_SIZE);
+  p->budget = INPROCESS_BUDGET;
+
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    if (is_clause_to_be_removed(v[i]) || clause_is_locked(s, v[i])) {
+      ivector_push(&p->sig, 0);
+    } else {
+      inprocessor_add_clause(p, v[i], i);
+    }
+  }
+}
+
+
+/*
+ * Free memory used by p
+ */
+static void delete_inprocessor(smt_core_t *s, inprocessor_t *p) {
+  uint32_t i, n;
+
+  n = s->nlits;
+  for (i=0; i<n; i++) {
+    delete_literal_vector(p->occ[i]);
+  }
+  safe_free(p->occ);
+  safe_free(p->lit_mark);
+  delete_ivector(&p->sig);
+  delete_ivector(&p->pos);
+  delete_ivector(&p->neg);
+  delete_ivector(&p->refs);
+  p->occ = NULL;
+  p->lit_mark = NULL;
+}
+
+
+/*
+ * Add clause a[0 ... n-1] obtained by inprocessing
+ * - the literals must be distinct and not assigned at level 0
+ *   unless a unit clause has been derived in the same round
+ *   (the unit literal is then in the propagation queue).
+ */
+static void inprocess_add_clause(smt_core_t *s, inprocessor_t *p, uint32_t n, literal_t *a) {
+  clause_t *cl;
+
+  if (n >= 3) {
+    cl = new_problem_clause(s, n, a);
+    inprocessor_add_clause(p, cl, get_cv_size(s->problem_clauses) - 1);
+  } else if (n == 2) {
+    direct_binary_clause(s, a[0], a[1]);
+  } else {
+    assert(n == 1);
+    add_unit_clause(s, a[0]);
+  }
+}
+
+
+/*
+ * Remove problem clause cl: mark it for deletion
+ */
+static void inprocess_remove_clause(smt_core_t *s, clause_t *cl) {
+  assert(! is_clause_to_be_removed(cl));
+  s->stats.prob_literals -= clause_length(cl);
+  s->nb_prob_clauses --;
+  mark_for_removal(cl);
+}
+
+
+/*
+ * Self-subsuming resolution: remove literal l from problem clause i
+ * - the clause is removed and replaced by a new clause
+ * - problem clauses may have two literals (cf. simplify_clause) so
+ *   the new clause may be a unit clause: it's assigned at level 0
+ *   and propagated after inprocessing
+ */
+static void strengthen_problem_clause(smt_core_t *s, inprocessor_t *p, uint32_t i, literal_t l) {
+  clause_t *cl;
+  ivector_t *b;
+  literal_t l0;
+  uint32_t j;
+
+  cl = s->problem_clauses[i];
+  b = &s->buffer;
+  ivector_reset(b);
+  j = 0;
+  l0 = cl->cl[0];
+  while (l0 >= 0) {
+    if (l0 != l) ivector_push(b, l0);
+    j ++;
+    l0 = cl->cl[j];
+  }
+  assert(b->size >= 1);
+
+  inprocess_remove_clause(s, cl);
+  inprocess_add_clause(s, p, b->size, b->data);
+  ivector_reset(b);
+  s->stats.strengthened_clauses ++;
+}
+
+
+/*
+ * Use clause c[0 ... n-1] to remove the problem clauses it subsumes
+ * and to strengthen the problem clauses D such that D contains
+ * c[0 ... n-1] except for one literal c[i], and not(c[i]) is in D.
+ * - k = index of c in problem_clauses or -1 if c is a binary clause
+ * - any such clause D contains c[i] or not(c[i]) for all i, so
+ *   we just visit the occurrence lists of the rarest literal of c
+ *   and of its negation.
+ */
+static void backward_subsume(smt_core_t *s, inprocessor_t *p, literal_t *c, uint32_t n, int32_t k) {
+  clause_t *cl;
+  literal_t *d, l, r, best;
+  uint32_t i, j, occ, best_occ, sig, matches, flips, pass;
+  int32_t idx;
+
+  sig = 0;
+  best = c[0];
+  best_occ = UINT32_MAX;
+  for (i=0; i<n; i++) {
+    l = c[i];
+    p->lit_mark[l] = 1;
+    sig |= lit_signature(l);
+    occ = occ_size(p, l) + occ_size(p, not(l));
+    if (occ < best_occ) {
+      best = l;
+      best_occ = occ;
+    }
+  }
+
+  if (best_occ <= SUBSUME_MAX_OCC) {
+    for (pass=0; pass<2; pass++) {
+      l = (pass == 0) ? best : not(best);
+      // occ[l] may be reallocated in the loop
+      for (j=0; j<occ_size(p, l); j++) {
+        idx = p->occ[l][j];
+        if (idx == k || (sig & ~((uint32_t) p->sig.data[idx])) != 0) continue;
+        cl = s->problem_clauses[idx];
+        if (is_clause_to_be_removed(cl)) continue;
+
+        matches = 0;
+        flips = 0;
+        r = null_literal;
+        d = cl->cl;
+        for (i=0; d[i] >= 0; i++) {
+          if (p->lit_mark[d[i]]) {
+            matches ++;
+          } else if (p->lit_mark[not(d[i])]) {
+            flips ++;
+            r = d[i];
+          }
+        }
+        p->budget -= i;
+
+        if (matches + flips == n) {
+          if (flips == 0) {
+            inprocess_remove_clause(s, cl);
+            s->stats.subsumed_clauses ++;
+          } else if (flips == 1) {
+            strengthen_problem_clause(s, p, idx, r);
+          }
+        }
+      }
+    }
+  }
+
+  for (i=0; i<n; i++) {
+    p->lit_mark[c[i]] = 0;
+  }
+}
+
+
+/*
+ * Subsumption/strengthening using all binary clauses then all problem clauses
+ */
+static void subsume_problem_clauses(smt_core_t *s, inprocessor_t *p) {
+  clause_t *cl;
+  literal_t c[2];
+  literal_t *v;
+  uint32_t i, j, n;
+  literal_t l0, l1;
+
+  n = s->nlits;
+  for (l0=0; l0<n; l0++) {
+    // s->bin[l0] may be reallocated in the loop
+    for (j=0; (v = s->bin[l0]) != NULL && v[j] >= 0; j++) {
+      l1 = v[j];
+      if (l0 < l1) {
+        c[0] = l0;
+        c[1] = l1;
+        backward_subsume(s, p, c, 2, -1);
+      }
+    }
+    if (p->budget <= 0 || s->inconsistent) return;
+  }
+
+  for (i=0; i<get_cv_size(s->problem_clauses); i++) {
+    cl = s->problem_clauses[i];
+    if (p->sig.data[i] != 0 && ! is_clause_to_be_removed(cl)) {
+      n = clause_length(cl);
+      if (n <= SUBSUME_MAX_SIZE) {
+        backward_subsume(s, p, cl->cl, n, i);
+      }
+    }
+    if (p->budget <= 0 || s->inconsistent) return;
+  }
+}
+
+
+/*
+ * Collect the clauses that contain literal l into vector v
+ * - each clause is stored without l and terminated by -1
+ * - the indices of the problem clauses are added to p->refs
+ * - return the number of clauses
+ */
+static uint32_t collect_occurrences(smt_core_t *s, inprocessor_t *p, literal_t l, ivector_t *v) {
+  clause_t *cl;
+  literal_t *b;
+  uint32_t i, j, n;
+
+  n = 0;
+  b = s->bin[l];
+  if (b != NULL) {
+    for (i=0; b[i] >= 0; i++) {
+      ivector_push(v, b[i]);
+      ivector_push(v, null_literal);
+      n ++;
+    }
+  }
+
+  b = p->occ[l];
+  if (b != NULL) {
+    for (i=0; b[i] >= 0; i++) {
+      cl = s->problem_clauses[b[i]];
+      if (! is_clause_to_be_removed(cl)) {
+        for (j=0; cl->cl[j] >= 0; j++) {
+          if (cl->cl[j] != l) ivector_push(v, cl->cl[j]);
+        }
+        ivector_push(v, null_literal);
+        ivector_push(&p->refs, b[i]);
+        n ++;
+        p->budget -= j;
+      }
+    }
+  }
+
+  return n;
+}
+
+
+/*
+ * Resolve the clause a (its literals must be marked in p->lit_mark)
+ * with the clause that starts at b[0] and is terminated by -1.
+ * - return the number of literals of b not in a if the resolvent is
+ *   not a tautology, or -1 if it is.
+ * - if out is non-NULL, the literals of b not in a are added to out
+ */
+static int32_t resolve_with_marked_clause(inprocessor_t *p, literal_t *b, ivector_t *out) {
+  uint32_t i, n;
+  literal_t l;
+
+  n = 0;
+  for (i=0; b[i] >= 0; i++) {
+    l = b[i];
+    if (p->lit_mark[not(l)]) return -1;
+    if (! p->lit_mark[l]) {
+      if (out != NULL) ivector_push(out, l);
+      n ++;
+    }
+  }
+  p->budget -= i;
+
+  return n;
+}
+
+
+/*
+ * Resolve all clauses in p->pos with all clauses in p->neg
+ * - if add is false, check whether elimination is cheap enough:
+ *   return false if there are more than max non-tautological resolvents
+ *   or if a resolvent has more than ELIM_MAX_RESOLVENT literals.
+ * - if add is true, add all the resolvents to s
+ */
+static bool resolve_occurrences(smt_core_t *s, inprocessor_t *p, uint32_t max, bool add) {
+  ivector_t *out;
+  literal_t *a, *b;
+  uint32_t i, j, k, len, count;
+  int32_t m;
+  bool ok;
+
+  out = &s->buffer;
+  ivector_reset(out);
+
+  ok = true;
+  count = 0;
+  a = p->pos.data;
+  b = p->neg.data;
+  i = 0;
+  while (ok && i < p->pos.size) {
+    // mark clause a[i ...]
+    len = 0;
+    while (a[i + len] >= 0) {
+      p->lit_mark[a[i + len]] = 1;
+      len ++;
+    }
+
+    j = 0;
+    while (j < p->neg.size) {
+      if (add) {
+        ivector_copy(out, a + i, len);
+        m = resolve_with_marked_clause(p, b + j, out);
+        if (m >= 0) {
+          inprocess_add_clause(s, p, out->size, out->data);
+        }
+        ivector_reset(out);
+      } else {
+        m = resolve_with_marked_clause(p, b + j, NULL);
+        if (m >= 0) {
+          count ++;
+          if (count > max || len + m > ELIM_MAX_RESOLVENT) {
+            ok = false;
+            break;
+          }
+        }
+      }
+      // skip clause b[j ...]
+      while (b[j] >= 0) j ++;
+      j ++;
+    }
+
+    for (k=0; k<len; k++) {
+      p->lit_mark[a[i + k]] = 0;
+    }
+    i += len + 1;
+  }
+
+  return ok;
+}
+
+
+/*
+ * Save the clauses in v on the elimination stack
+ * - l = pivot literal (stored first in each clause)
+ * - each clause is followed by its length
+ */
+static void save_eliminated_clauses(smt_core_t *s, ivector_t *v, literal_t l) {
+  literal_t *a;
+  uint32_t i, n;
+
+  a = v->data;
+  i = 0;
+  while (i < v->size) {
+    ivector_push(&s->elim_stack, l);
+    n = 1;
+    while (a[i] >= 0) {
+      ivector_push(&s->elim_stack, a[i]);
+      i ++;
+      n ++;
+    }
+    ivector_push(&s->elim_stack, n);
+    i ++;
+  }
+}
+
+
+/*
+ * Remove literal l0 from the binary-clause vector bin[l]
+ */
+static void remove_binary_partner(smt_core_t *s, literal_t l, literal_t l0) {
+  literal_t *v;
+  uint32_t i, n;
+
+  v = s->bin[l];
+  assert(v != NULL);
+  n = get_lv_size(v);
+  for (i=0; i<n; i++) {
+    if (v[i] == l0) break;
+  }
+  assert(i < n);
+  v[i] = v[n-1];
+  literal_vector_pop(v);
+}
+
+
+/*
+ * Remove all binary clauses that contain l
+ */
+static void remove_binary_clauses_of_literal(smt_core_t *s, literal_t l) {
+  literal_t *v;
+  uint32_t i, n;
+
+  v = s->bin[l];
+  if (v != NULL) {
+    n = get_lv_size(v);
+    for (i=0; i<n; i++) {
+      remove_binary_partner(s, v[i], l);
+    }
+    delete_literal_vector(v);
+    s->bin[l] = NULL;
+    s->nb_bin_clauses -= n;
+    s->stats.bin_clauses_deleted += n;
+  }
+}
+
+
+/*
+ * Eliminate variable x:
+ * - p->pos and p->neg contain the np + nn clauses of x and not(x)
+ * - p->refs contain the indices of the problem clauses among them
+ * The elimination stack gets the clauses then np + nn then x.
+ */
+static void eliminate_variable(smt_core_t *s, inprocessor_t *p, bvar_t x, uint32_t np, uint32_t nn) {
+  uint32_t i;
+
+  save_eliminated_clauses(s, &p->pos, pos_lit(x));
+  save_eliminated_clauses(s, &p->neg, neg_lit(x));
+  ivector_push(&s->elim_stack, np + nn);
+  ivector_push(&s->elim_stack, x);
+
+  for (i=0; i<p->refs.size; i++) {
+    inprocess_remove_clause(s, s->problem_clauses[p->refs.data[i]]);
+  }
+  remove_binary_clauses_of_literal(s, pos_lit(x));
+  remove_binary_clauses_of_literal(s, neg_lit(x));
+
+  (void) resolve_occurrences(s, p, 0, true);
+
+  set_bit(s->elim, x);
+  heap_remove(&s->heap, x);
+  s->nb_elim_vars ++;
+  s->stats.eliminated_vars ++;
+}
+
+
+/*
+ * Try to eliminate all variables not attached to an atom
+ * - stop if a unit clause or a conflict is found or if the budget is exhausted
+ * - return true if some variables were eliminated
+ */
+static bool eliminate_variables(smt_core_t *s, inprocessor_t *p) {
+  uint32_t np, nn, n;
+  bvar_t x;
+  bool elim;
+
+  elim = false;
+  n = s->nvars;
+  for (x=1; x<n; x++) {
+    if (s->inconsistent || s->stack.prop_ptr < s->stack.top || p->budget <= 0) break;
+    if (bvar_is_assigned(s, x) || bvar_has_atom(s, x) || tst_bit(s->elim, x)) continue;
+
+    ivector_reset(&p->pos);
+    ivector_reset(&p->neg);
+    ivector_reset(&p->refs);
+    np = collect_occurrences(s, p, pos_lit(x), &p->pos);
+    if (np > ELIM_MAX_OCC) continue;
+    nn = collect_occurrences(s, p, neg_lit(x), &p->neg);
+    if (nn > ELIM_MAX_OCC || np + nn == 0) continue;
+
+    if (resolve_occurrences(s, p, np + nn, false)) {
+      eliminate_variable(s, p, x, np, nn);
+      elim = true;
+    }
+  }
+
+  return elim;
+}
+
+
+/*
+ * Mark the learned clauses that contain an eliminated variable for removal
+ */
+static void mark_learned_clauses_with_eliminated_vars(smt_core_t *s) {
+  clause_t **v, *cl;
+  uint32_t i, j, n;
+
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    cl = v[i];
+    if (! is_clause_to_be_removed(cl) && ! clause_is_locked(s, cl)) {
+      for (j=0; cl->cl[j] >= 0; j++) {
+        if (tst_bit(s->elim, var_of(cl->cl[j]))) {
+          mark_for_removal(cl);
+          break;
+        }
+      }
+    }
+  }
+}
+
+
+/*
+ * Delete all the clauses marked for removal
+ */
+static void delete_removed_clauses(smt_core_t *s) {
+  clause_t **v;
+  uint32_t i, j, n;
+
+  // this cleans up the watch vectors too
+  delete_learned_clauses(s);
+
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (is_clause_to_be_removed(v[i])) {
+      delete_clause(v[i]);
+    } else {
+      v[j] = v[i];
+      j ++;
+    }
+  }
+  set_cv_size(v, j);
+  s->nb_clauses -= n - j;
+  s->stats.prob_clauses_deleted += n - j;
+}
+
+
+/*
+ * Decision for vivification: like decide_literal, but the theory solver
+ * is not notified (only boolean propagation is used).
+ */
+static void vivify_decide(smt_core_t *s, literal_t l) {
+  uint32_t k;
+  bvar_t v;
+
+  assert(literal_is_unassigned(s, l));
+
+  k = s->decision_level + 1;
+  s->decision_level = k;
+  if (s->stack.nlevels <= k) {
+    increase_stack_levels(&s->stack);
+  }
+  s->stack.level_index[k] = s->stack.top;
+
+  push_literal(&s->stack, l);
+
+  v = var_of(l);
+  s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
+  s->level[v] = k;
+  s->antecedent[v] = mk_literal_antecedent(null_literal);
+}
+
+
+/*
+ * Vivify learned clause cl = (l_1 \/ ... \/ l_n):
+ * - assign not(l_1), not(l_2), ... and propagate after each decision
+ * - if propagation after not(l_1) ... not(l_k) causes a conflict,
+ *   then cl can be replaced by (l_1 \/ ... \/ l_k)
+ * - if l_j is false before it's decided, it can be removed from cl
+ * - if l_j is true before it's decided, cl can be replaced by
+ *   (l_1 \/ ... \/ l_k \/ l_j)
+ * The shortened clause is stored in v, followed by -1.
+ * Return true if cl can be shortened.
+ */
+static bool vivify_clause(smt_core_t *s, clause_t *cl, ivector_t *v) {
+  ivector_t *lits;
+  uint32_t i, n, k;
+  literal_t l;
+
+  // copy cl: propagation may reorder its literals
+  lits = &s->buffer;
+  ivector_reset(lits);
+  for (i=0; cl->cl[i] >= 0; i++) {
+    ivector_push(lits, cl->cl[i]);
+  }
+  n = lits->size;
+
+  k = v->size;
+  for (i=0; i<n; i++) {
+    l = lits->data[i];
+    switch (literal_value(s, l)) {
+    case VAL_FALSE:
+      break;
+
+    case VAL_TRUE:
+      ivector_push(v, l);
+      goto done;
+
+    default:
+      ivector_push(v, l);
+      vivify_decide(s, not(l));
+      if (! boolean_propagation(s)) goto done;
+      break;
+    }
+  }
+
+ done:
+  if (s->decision_level > 0) {
+    backtrack(s, 0);
+  }
+  s->inconsistent = false;
+  ivector_reset(lits);
+
+  if (v->size - k < n) {
+    ivector_push(v, null_literal);
+    return true;
+  }
+  v->size = k;
+  return false;
+}
+
+
+/*
+ * Vivify the most recent learned clauses
+ * - the shortened clauses are added after all clauses have been visited
+ */
+static void vivify_learned_clauses(smt_core_t *s, inprocessor_t *p) {
+  clause_t **v, *cl, *old;
+  literal_t *a;
+  uint32_t i, k, n, len, lbd;
+
+  assert(s->decision_level == 0 && s->stack.prop_ptr == s->stack.top);
+
+  ivector_reset(&p->pos);
+  ivector_reset(&p->refs);
+
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  k = (n > VIVIFY_MAX_CLAUSES) ? n - VIVIFY_MAX_CLAUSES : 0;
+  i = n;
+  while (i > k) {
+    i --;
+    cl = v[i];
+    if (! clause_is_locked(s, cl) && vivify_clause(s, cl, &p->pos)) {
+      ivector_push(&p->refs, i);
+    }
+  }
+
+  if (p->refs.size == 0) return;
+
+  a = p->pos.data;
+  for (i=0; i<p->refs.size; i++) {
+    len = 0;
+    while (a[len] >= 0) len ++;
+
+    if (len >= 3) {
+      old = s->learned_clauses[p->refs.data[i]];
+      lbd = get_lbd(old);
+      cl = new_learned_clause(len, a, (lbd < len) ? lbd : len);
+      learned(cl)->activity = get_activity(old);
+      add_clause_to_vector(&s->learned_clauses, cl);
+      add_clause_to_watch_vectors(s, cl);
+      s->nb_clauses ++;
+    } else if (len == 2) {
+      direct_binary_clause(s, a[0], a[1]);
+    } else {
+      assert(len == 1);
+      add_unit_clause(s, a[0]);
+    }
+    mark_for_removal(s->learned_clauses[p->refs.data[i]]);
+    s->stats.vivified_clauses ++;
+    a += len + 1;
+  }
+
+  delete_learned_clauses(s);
+}
+
+
+/*
+ * Inprocessing round
+ * - must be called at decision level 0, when base_level is 0, after
+ *   propagation, with no conflict and an empty lemma queue.
+ * - new unit clauses may be added to the propagation queue
+ */
+static void inprocess_clause_database(smt_core_t *s) {
+  inprocessor_t p;
+  bool elim;
+
+  assert(s->base_level == 0 && s->decision_level == 0 && !s->inconsistent &&
+         s->stack.top == s->stack.prop_ptr);
+
+  // after this, the unlocked clauses contain no assigned literals
+  simplify_clause_database(s);
+
+  init_inprocessor(s, &p);
+  subsume_problem_clauses(s, &p);
+
+  /*
+   * Strengthening may have added unit clauses. Variable elimination
+   * requires that no clause contains an assigned literal so we skip
+   * it until these units are propagated.
+   */
+  elim = false;
+  if (s->var_elim && !s->has_assumptions && !s->inconsistent &&
+      s->stack.prop_ptr == s->stack.top) {
+    elim = eliminate_variables(s, &p);
+  }
+  if (elim) {
+    mark_learned_clauses_with_eliminated_vars(s);
+  }
+  delete_removed_clauses(s);
+
+  if (! s->inconsistent && s->stack.prop_ptr == s->stack.top) {
+    vivify_learned_clauses(s, &p);
+  }
+  delete_inprocessor(s, &p);
+
+  s->stats.inprocess_calls ++;
+  s->inprocess_next = s->stats.conflicts + s->inprocess_interval;
+  s->inprocess_interval += s->inprocess_interval >> 1;
+}
+
+
+/*
+ * Check whether inprocessing should be called
+ */
+static inline bool need_inprocessing(smt_core_t *s) {
+  return s->decision_level == 0 && s->base_level == 0 &&
+    s->stats.conflicts >= s->inprocess_next;
+}
+
+
+/*
+ * Assign the eliminated variables (at the current decision level)
+ * - all other variables must be assigned
+ * - variables already assigned by a previous call are skipped
+ * - the elimination stack is processed in reverse order: for each
+ *   variable x, x is set to false unless one of the clauses removed
+ *   when x was eliminated requires x to be true.
+ */
+static void extend_assignment(smt_core_t *s) {
+  int32_t *a;
+  uint32_t i, j, k, n;
+  literal_t l;
+  bvar_t x;
+  bool sat;
+
+  a = s->elim_stack.data;
+  i = s->elim_stack.size;
+  while (i > 0) {
+    assert(i >= 2);
+    x = a[i-1];
+    k = a[i-2];
+    i -= 2;
+    assert(tst_bit(s->elim, x));
+
+    l = neg_lit(x);
+    while (k > 0) {
+      k --;
+      n = a[i-1];
+      i -= n + 1;
+      // the clause is a[i ... i+n-1] and a[i] is the pivot
+      sat = (a[i] == l);
+      for (j=1; j<n && !sat; j++) {
+        sat = (literal_value(s, a[i+j]) == VAL_TRUE);
+      }
+      if (! sat) {
+        l = a[i];
+      }
+    }
+
+    if (bvar_is_unassigned(s, x)) {
+      push_literal(&s->stack, l);
+      s->value[x] = (VAL_TRUE ^ sign_of_lit(l));
+      s->level[x] = s->decision_level;
+      s->antecedent[x] = mk_literal_antecedent(null_literal);
+      if (s->decision_level == s->base_level) {
+        set_bit(s->mark, x);
+      }
+    }
+  }
+}
+
+
+
+
+/**************
+ *  PUSH/POP  *
+ *************/
+
+/*
+ * Push:
+ * - clear current assignment and reset status to IDLE if necessary
+ * - save current base-level state
+ * - notify the theory solver
+ * - increase base level
+ */
+void smt_push(smt_core_t *s) {
+  uint32_t k;
+
+  /*
+   * Abort if push_pop is not enabled
+   */
+  assert((s->option_flag & PUSH_POP_MASK) != 0);
 
   /*
    * Reset assignment and status
@@ -4899,14 +6136,14 @@ static void remove_problem_clauses(smt_core_t *s, uint32_t n) {
 
 
 /*
- * Reset the watch lists (to empty lists)
+ * Reset the watch lists (to empty vectors)
  */
 static void reset_watch_lists(smt_core_t *s) {
   uint32_t i, n;
 
   n = s->nlits;
   for (i=0; i<n; i++) {
-    s->watch[i] = NULL_LINK;
+    reset_watch_vector(s->watch[i]);
   }
 }
 
@@ -4920,7 +6157,6 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
   uint32_t i, m, nlits;
   clause_t **v;
   clause_t *cl;
-  literal_t l;
 
   // mark clauses for removal
   remove_all_learned_clauses(s);
@@ -4957,12 +6193,8 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
     }
     nlits += clause_length(cl);
 
-    // add cl at the start of its watch lists
-    l = cl->cl[0];
-    s->watch[l] = cons(0, cl, s->watch[l]);
-
-    l = cl->cl[1];
-    s->watch[l] = cons(1, cl, s->watch[l]);
+    // add cl to its watch vectors
+    add_clause_to_watch_vectors(s, cl);
   }
 
 
@@ -5029,8 +6261,10 @@ static void restore_variables(smt_core_t *s, uint32_t n) {
     delete_literal_vector(s->bin[l1]);
     s->bin[l0] = NULL;
     s->bin[l1] = NULL;
-    s->watch[l0] = NULL_LINK;
-    s->watch[l1] = NULL_LINK;
+    delete_watch_vector(s->watch[l0]);
+    delete_watch_vector(s->watch[l1]);
+    s->watch[l0] = NULL;
+    s->watch[l1] = NULL;
   }
 
   s->nvars = n;
@@ -5117,7 +6351,8 @@ void smt_cleanup(smt_core_t *s) {
  * Clear the current boolean assignment and reset status to IDLE
  */
 void smt_clear(smt_core_t *s) {
-  assert(s->status == STATUS_SAT || s->status == STATUS_UNKNOWN);
+  assert(s->status == STATUS_SAT || s->status == STATUS_UNKNOWN ||
+         smt_unsat_with_assumptions(s));
 
   // Give a chance to the theory solver to cleanup its own state
   s->th_ctrl.clear(s->th_solver);
@@ -5134,6 +6369,9 @@ void smt_clear(smt_core_t *s) {
     backtrack_to_base_level(s);
     s->status = STATUS_IDLE;
   }
+
+  s->has_assumptions = false;
+  s->bad_assumption = null_literal;
 }
 
 
@@ -5294,8 +6532,9 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
       delete_literal_vector(v0);
       s->bin[l0] = NULL;
       s->aux_literals += n;
-      s->watch[l0] = NULL_LINK; // not strictly necessary
     }
+    delete_watch_vector(s->watch[l0]);
+    s->watch[l0] = NULL;
   }
 
   // update the statistics
@@ -5545,8 +6784,9 @@ bool base_propagate(smt_core_t *s) {
  * - set status to searching
  * - if clean_interrupt is enabled, save the current state to
  *   enable cleanup after interrupt (this uses push)
+ * - a[0 ... n-1] = assumptions (they are decided first)
  */
-void start_search(smt_core_t *s) {
+void start_search(smt_core_t *s, uint32_t n, const literal_t *a) {
   assert(s->status == STATUS_IDLE && s->decision_level == s->base_level);
 
 #if TRACE
@@ -5578,6 +6818,12 @@ void start_search(smt_core_t *s) {
   s->simplify_props = 0;
   s->simplify_threshold = 0;
 
+  s->has_assumptions = n > 0;
+  s->num_assumptions = n;
+  s->assumption_index = 0;
+  s->assumptions = a;
+  s->bad_assumption = null_literal;
+
   /*
    * Allow theory solver to do whatever initializations it needs
    */
@@ -5603,6 +6849,137 @@ void stop_search(smt_core_t *s) {
 }
 
 
+
+/*
+ * Get the next assumption to decide:
+ * - all assumptions before s->assumption_index are known to be true
+ * - return null_literal if all assumptions are true
+ * - if an assumption is false, store it in s->bad_assumption, set
+ *   status to UNSAT, and return null_literal
+ */
+literal_t get_next_assumption(smt_core_t *s) {
+  uint32_t i, n;
+  literal_t l;
+
+  assert(s->has_assumptions && s->status == STATUS_SEARCHING);
+
+  n = s->num_assumptions;
+  for (i=s->assumption_index; i<n; i++) {
+    l = s->assumptions[i];
+    switch (literal_value(s, l)) {
+    case VAL_TRUE:
+      break;
+
+    case VAL_FALSE:
+      s->assumption_index = i;
+      s->bad_assumption = l;
+      s->status = STATUS_UNSAT;
+      return null_literal;
+
+    default:
+      s->assumption_index = i;
+      return l;
+    }
+  }
+
+  s->assumption_index = n;
+  return null_literal;
+}
+
+
+/*
+ * Mark variable of literal l for build_unsat_core
+ * - literals assigned at the base level are skipped
+ */
+static inline void mark_core_literal(smt_core_t *s, literal_t l) {
+  bvar_t x;
+
+  x = var_of(l);
+  if (s->level[x] > s->base_level) {
+    set_var_mark(s, x);
+  }
+}
+
+
+/*
+ * Final-conflict analysis (cf. Minisat's analyzeFinal):
+ * - s->bad_assumption is false in the current assignment
+ * - all decisions on the stack are assumptions
+ * - we collect the decision literals that imply (not bad_assumption)
+ *   by following the antecedents from the top of the stack
+ */
+void build_unsat_core(smt_core_t *s, ivector_t *v) {
+  uint32_t i, j, k;
+  literal_t l, b;
+  literal_t *c;
+  antecedent_t a;
+  bvar_t x;
+
+  assert(s->status == STATUS_UNSAT);
+
+  ivector_reset(v);
+  l = s->bad_assumption;
+  if (l == null_literal) {
+    // the clauses are unsat: empty core
+    return;
+  }
+
+  assert(literal_value(s, l) == VAL_FALSE);
+  ivector_push(v, l);
+  if (s->level[var_of(l)] <= s->base_level) {
+    return;
+  }
+
+  set_var_mark(s, var_of(l));
+  k = s->stack.level_index[s->base_level + 1];
+  j = s->stack.top;
+  while (j > k) {
+    j --;
+    b = s->stack.lit[j];
+    x = var_of(b);
+    if (is_lit_marked(s, b)) {
+      clr_var_mark(s, x);
+      a = s->antecedent[x];
+      switch (antecedent_tag(a)) {
+      case clause0_tag:
+      case clause1_tag:
+        c = clause_antecedent(a)->cl;
+        i = 0;
+        l = c[i];
+        while (l >= 0) {
+          if (l != b) mark_core_literal(s, l);
+          i ++;
+          l = c[i];
+        }
+        break;
+
+      case literal_tag:
+        l = literal_antecedent(a);
+        if (l == null_literal) {
+          // decision literal: this is an assumption
+          ivector_push(v, b);
+        } else {
+          mark_core_literal(s, l);
+        }
+        break;
+
+      case generic_tag:
+        explain_antecedent(s, b, a);
+        c = s->explanation.data;
+        for (i=0; i<s->explanation.size; i++) {
+          mark_core_literal(s, c[i]);
+        }
+        break;
+      }
+    }
+  }
+
+#if DEBUG
+  check_marks(s);
+#endif
+}
+
+
 /*
  * Core solving function.
  *
@@ -5647,9 +7024,13 @@ static bool smt_core_process(smt_core_t *s, uint64_t max_conflicts) {
     } else {
       /*
        * propagation can create a conflict or add lemmas.
-       * if it doesn't we're done.
+       * if it doesn't we're done, unless inprocessing is due
+       * (it may add unit clauses or detect a conflict).
        */
-      if (smt_propagation(s) && empty_lemma_queue(&s->lemmas)) break;
+      if (smt_propagation(s) && empty_lemma_queue(&s->lemmas)) {
+        if (! need_inprocessing(s)) break;
+        inprocess_clause_database(s);
+      }
     }
   }
 
@@ -5695,6 +7076,9 @@ void smt_final_check(smt_core_t *s) {
   assert(s->status == STATUS_SEARCHING || s->status == STATUS_INTERRUPTED);
 
   if (s->status == STATUS_SEARCHING) {
+    if (s->nb_elim_vars > 0) {
+      extend_assignment(s);
+    }
     switch (s->th_ctrl.final_check(s->th_solver)) {
     case FCHECK_CONTINUE:
       /*
@@ -5718,6 +7102,30 @@ void smt_final_check(smt_core_t *s) {
 
 
 
+/*
+ * Install the assignment given by the preferred values
+ */
+void smt_install_preferred_assignment(smt_core_t *s) {
+  uint64_t conflicts;
+  bvar_t x;
+
+  assert(s->status == STATUS_SEARCHING && !s->inconsistent);
+
+  conflicts = num_conflicts(s);
+  // s->nvars may increase if the theory solver creates atoms
+  for (x=0; x<s->nvars; x++) {
+    if (bvar_is_unassigned(s, x) && !tst_bit(s->elim, x)) {
+      decide_literal(s, mk_signed_lit(x, s->value[x] & 1));
+      smt_process(s);
+      if (s->status != STATUS_SEARCHING || num_conflicts(s) > conflicts) return;
+    }
+  }
+
+  smt_final_check(s);
+}
+
+
+
 /***************
  *  RESTARTS   *
  **************/
@@ -6179,7 +7587,7 @@ static void check_heap_content(smt_core_t *s) {
   }
 
   for (x=0; x<s->nvars; x++) {
-    if (bval_is_undef(s->value[x]) && s->heap.heap_index[x] < 0) {
+    if (bval_is_undef(s->value[x]) && ! tst_bit(s->elim, x) && s->heap.heap_index[x] < 0) {
       printf("ERROR: incorrect heap: unassigned variable %"PRIu32" is not in the heap\n", x);
       fflush(stdout);
     }
@@ -6245,15 +7653,20 @@ static inline int32_t indicator(bval_t v, bval_t c) {
 }
 
 static void check_watch_list(smt_core_t *s, literal_t l, clause_t *cl) {
-  link_t lnk;
+  watch_elem_t *w;
+  uint32_t i, n;
 
-  for (lnk = s->watch[l]; lnk != NULL_LINK; lnk = next_of(lnk)) {
-    if (clause_of(lnk) == cl) {
-      return;
+  w = s->watch[l];
+  if (w != NULL) {
+    n = get_wv_size(w);
+    for (i=0; i<n; i++) {
+      if (w[i].clause == cl) {
+        return;
+      }
     }
   }
 
-  printf("ERROR: missing watch, literal = %"PRId32", clause = %p\n", l, clause_of(lnk));
+  printf("ERROR: missing watch, literal = %"PRId32", clause = %p\n", l, cl);
 }
 
 
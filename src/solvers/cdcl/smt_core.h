@@ -71,21 +71,25 @@
 
 /*
  * Clauses structure
- * - two pointers to form lists of clauses for the watched literals
  * - a clause is an array of literals terminated by an end marker
  *   (a negative number).
  * - the first two literals stored in cl[0] and cl[1]
  *   are the watched literals.
  * Learned clauses have the same components as a clause
  * and an activity, i.e., a float used by the clause-deletion
- * heuristic. (Because of alignment and padding, this wastes 32bits
- * on a 64bit machine....)
+ * heuristic. They also store their LBD (literal block distance
+ * or glue = number of distinct decision levels in the clause when
+ * it was learned or last used) and a flag that's set when the clause
+ * is used in conflict resolution. The LBD determines the clause's tier:
+ * - core tier: lbd <= keep_lbd. These clauses are never deleted by
+ *   reduce_clause_database.
+ * - tier 2: keep_lbd < lbd <= tier2_lbd. These clauses are kept by
+ *   reduce_clause_database if they were used since the previous
+ *   reduction.
+ * - local tier: lbd > tier2_lbd. Ranked by lbd and activity.
  *
- * Linked lists:
- * - a link lnk is a pointer to a clause cl
- *   the low-order bits of lnk encode whether the next link is
- *   in cl->link[0] or cl->link[1]
- * - this is compatible with the tagged pointers used as antecedents.
+ * The watch lists are stored separately, in watch vectors
+ * (see below), so a clause is just its array of literals.
  *
  * SPECIAL CODING: to distinguish between learned clauses and problem
  * clauses, the end marker is different.
@@ -108,65 +112,19 @@ enum {
 
 typedef struct clause_s clause_t;
 
-typedef uintptr_t link_t;
-
 struct clause_s {
-  link_t link[2];
   literal_t cl[0];
 };
 
 typedef struct learned_clause_s {
   float activity;
+  uint16_t lbd;
+  uint16_t used;
   clause_t clause;
 } learned_clause_t;
 
-
-/*
- * Tagging/untagging of link pointers
- */
-#define LINK_TAG ((uintptr_t) 0x1)
-#define NULL_LINK ((link_t) 0)
-
-static inline link_t mk_link(clause_t *c, uint32_t i) {
-  assert((i & ~LINK_TAG) == 0 && (((uintptr_t) c) & LINK_TAG) == 0);
-  return (link_t)(((uintptr_t) c) | ((uintptr_t) i));
-}
-
-static inline clause_t *clause_of(link_t lnk) {
-  return (clause_t *)(lnk & ~LINK_TAG);
-}
-
-static inline uint32_t idx_of(link_t lnk) {
-  return (uint32_t)(lnk & LINK_TAG);
-}
-
-static inline link_t next_of(link_t lnk) {
-  return clause_of(lnk)->link[idx_of(lnk)];
-}
-
-
-/*
- * return a new link lnk0 such that
- * - clause_of(lnk0) = c
- * - idx_of(lnk0) = i
- * - next_of(lnk0) = lnk
- */
-static inline link_t cons(uint32_t i, clause_t *c, link_t lnk) {
-  assert(i <= 1);
-  c->link[i] = lnk;
-  return mk_link(c, i);
-}
-
-/*
- * If lnk points to a clause cl, then return
- * a pointer to either cl->link[0] or cl->link[1], depending on
- * the lower order bit of lnk.
- */
-static inline link_t *cdr_ptr(link_t lnk) {
-  return clause_of(lnk)->link + idx_of(lnk);
-}
-
-
+// bound on the stored lbd
+#define MAX_CLAUSE_LBD UINT16_MAX
 
 
 
@@ -234,6 +192,49 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
 
 
 
+/*
+ * Watch vectors: for a literal l, watch[l] stores all the clauses
+ * in which l is a watched literal. Each element is a pair
+ * <clause, blocker> where blocker is another literal of the clause
+ * (initially the other watched literal). If the blocker is true,
+ * the clause is satisfied and boolean propagation can skip it
+ * without reading the clause itself.
+ *
+ * Watch vectors use the same hidden-header layout as literal vectors.
+ * They are NULL until the first element is added.
+ */
+typedef struct watch_elem_s {
+  clause_t *clause;
+  literal_t blocker;
+} watch_elem_t;
+
+typedef struct watch_vector_s {
+  uint32_t capacity;
+  uint32_t size;
+  watch_elem_t data[0];
+} watch_vector_t;
+
+
+/*
+ * Header, size and capacity of a watch vector v
+ */
+static inline watch_vector_t *wv_header(watch_elem_t *v) {
+  return (watch_vector_t *)(((char *) v) - offsetof(watch_vector_t, data));
+}
+
+static inline uint32_t get_wv_size(watch_elem_t *v) {
+  return wv_header(v)->size;
+}
+
+static inline void set_wv_size(watch_elem_t *v, uint32_t sz) {
+  wv_header(v)->size = sz;
+}
+
+static inline uint32_t get_wv_capacity(watch_elem_t *v) {
+  return wv_header(v)->capacity;
+}
+
+
 /*
  * Default sizes and max sizes of vectors
  */
@@ -244,6 +245,9 @@ static inline uint32_t get_lv_capacity(literal_t *v) {
 #define DEF_LITERAL_BUFFER_SIZE 100
 #define MAX_LITERAL_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(literal_vector_t)))/4)
 
+#define DEF_WATCH_VECTOR_SIZE 6
+#define MAX_WATCH_VECTOR_SIZE (((uint32_t)(UINT32_MAX-sizeof(watch_vector_t)))/sizeof(watch_elem_t))
+
 
 
 /**********************************
@@ -799,10 +803,44 @@ typedef struct dpll_stats_s {
 
   uint64_t literals_before_simpl;
   uint64_t subsumed_literals;
+
+  uint32_t inprocess_calls;          // number of calls to inprocess_clause_database
+  uint32_t eliminated_vars;          // number of variables removed by variable elimination
+  uint64_t subsumed_clauses;         // problem clauses removed by subsumption
+  uint64_t strengthened_clauses;     // problem clauses strengthened by self-subsumption
+  uint64_t vivified_clauses;         // learned clauses shortened by vivification
 } dpll_stats_t;
 
 
 
+/**********************************
+ *  INPROCESSING DATA STRUCTURE  *
+ *********************************/
+
+/*
+ * Auxiliary structure used during an inprocessing round:
+ * - occ[l] = indices (in problem_clauses) of the clauses that contain l
+ *   (stored as a literal vector terminated by -1)
+ * - lit_mark[l] = 1 if l occurs in the current clause
+ * - sig[i] = signature of problem clause i (bitmask of its variables mod 32)
+ *   or 0 if clause i is ignored
+ * - pos, neg: clauses that contain x and not(x) (without the pivot),
+ *   each terminated by -1, for the variable x being eliminated
+ * - refs: indices of the problem clauses that contain x or not(x)
+ * - budget: remaining work allowed in this round
+ */
+typedef struct inprocessor_s {
+  literal_t **occ;
+  uint8_t *lit_mark;
+  ivector_t sig;
+  ivector_t pos;
+  ivector_t neg;
+  ivector_t refs;
+  int64_t budget;
+} inprocessor_t;
+
+
+
 /*********************
  *  SMT SOLVER CORE  *
  ********************/
@@ -875,10 +913,8 @@ typedef enum smt_mode {
  *
  * Propagation structures: for every literal l
  * - bin[l] = literal vector for binary clauses
- * - watch[l] = list of clauses where l is a watched literal
+ * - watch[l] = watch vector for clauses where l is a watched literal
  *   (i.e., clauses where l occurs in position 0 or 1)
- * - optional: end_watch[l] = pointer to the last element in the watch list of l
- *   end_watch is used if USE_END_WATCH is set a compilation time
  *
  * For every variable x between 0 and nb_vars - 1
  * - antecedent[x]: antecedent type and value
@@ -955,6 +991,10 @@ typedef struct smt_core_s {
   uint64_t aux_literals;        // temporary counter used by simplify_clause
   uint32_t aux_clauses;         // temporary counter used by simplify_clause
 
+  /* Counters for inprocessing */
+  uint64_t inprocess_next;      // number of conflicts before the next inprocessing round
+  uint32_t inprocess_interval;  // increment for inprocess_next
+
   /* Current decision level */
   uint32_t decision_level;
   uint32_t base_level;          // Incremented on push/decremented on pop
@@ -963,6 +1003,15 @@ typedef struct smt_core_s {
   float cla_inc;             // Clause activity increment
   float inv_cla_decay;       // Inverse of clause decay (e.g., 1/0.999)
 
+  /* Tiers for learned clauses */
+  uint32_t keep_lbd;         // clauses with lbd <= keep_lbd are never deleted
+  uint32_t tier2_lbd;        // clauses with lbd <= tier2_lbd are kept if used
+
+  /* Buffer for computing the lbd: one stamp per decision level */
+  uint32_t *level_stamp;
+  uint32_t level_stamp_size;
+  uint32_t lbd_counter;
+
   /* Randomness parameter */
   uint32_t prng;             // state of the pseudo random number generator
   uint32_t scaled_random;    // 0x1000000 * random_factor
@@ -997,10 +1046,11 @@ typedef struct smt_core_s {
   antecedent_t *antecedent;
   uint32_t *level;
   byte_t *mark;        // bitvector: for conflict resolution
+  byte_t *elim;        // bitvector: eliminated variables
 
   /* Literal-indexed arrays (of size lsize) */
   literal_t **bin;   // array of literal vectors
-  link_t *watch;     // array of watch lists
+  watch_elem_t **watch;  // array of watch vectors
 
   /* Stack/propagation queue */
   prop_stack_t stack;
@@ -1024,6 +1074,41 @@ typedef struct smt_core_s {
   checkpoint_stack_t checkpoints;
   bool cp_flag;  // set true when backtracking. false when checkpoints are added
 
+  /*
+   * Assumptions (for check with assumptions)
+   * - assumptions[0 ... num_assumptions-1] = literals to decide first
+   * - assumption_index: all assumptions before that index are true
+   *   (it's reset to 0 on backtracking)
+   * - bad_assumption = an assumption found false during the search
+   *   (or null_literal)
+   */
+  bool has_assumptions;
+  uint32_t num_assumptions;
+  uint32_t assumption_index;
+  const literal_t *assumptions;
+  literal_t bad_assumption;
+
+  /*
+   * Variable elimination (disabled by default)
+   * - elim_stack stores the clauses removed by elimination
+   *   (cf. inprocess_clause_database in smt_core.c)
+   */
+  bool var_elim;
+  uint32_t nb_elim_vars;
+  ivector_t elim_stack;
+
+  /*
+   * Export of learned clauses (for clause sharing, disabled by default)
+   * - if export_lbd > 0, the learned clauses of at most export_size literals,
+   *   with LBD at most export_lbd, and whose variables are all smaller
+   *   than export_nvars are copied into the exported vector
+   * - each clause is stored as: size, lbd, literals
+   */
+  uint32_t export_lbd;
+  uint32_t export_size;
+  uint32_t export_nvars;
+  ivector_t exported;
+
   /* EXPERIMENTAL (default to NULL) */
   booleq_table_t *etable;
 
@@ -1058,6 +1143,13 @@ typedef struct smt_core_s {
 #define INIT_CLAUSE_ACTIVITY_INCREMENT (1.0F)
 
 
+/*
+ * Default LBD thresholds for the learned-clause tiers
+ */
+#define DEFAULT_KEEP_LBD  2
+#define DEFAULT_TIER2_LBD 6
+
+
 /*
  * Parameters for removing irrelevant learned clauses
  * (zchaff-style).
@@ -1084,6 +1176,30 @@ typedef struct smt_core_s {
 #define VAR_RANDOM_SCALE (VAR_RANDOM_MASK+1)
 
 
+/*
+ * Inprocessing parameters
+ * - INPROCESS_INTERVAL: initial number of conflicts between two
+ *   inprocessing rounds (the interval increases by 50% after each round)
+ * - INPROCESS_BUDGET: bound on the number of literals visited in a round
+ * - SUBSUME_MAX_OCC: a clause is not used for subsumption if its rarest
+ *   literal occurs in more than SUBSUME_MAX_OCC clauses
+ * - SUBSUME_MAX_SIZE: max size of the clauses used for subsumption
+ * - ELIM_MAX_OCC: a variable x is not eliminated if x or not(x) occurs
+ *   in more than ELIM_MAX_OCC clauses
+ * - ELIM_MAX_RESOLVENT: max size of the resolvents created by variable
+ *   elimination
+ * - VIVIFY_MAX_CLAUSES: max number of learned clauses visited by
+ *   vivification in a round
+ */
+#define INPROCESS_INTERVAL 5000
+#define INPROCESS_BUDGET   20000000
+#define SUBSUME_MAX_OCC    1000
+#define SUBSUME_MAX_SIZE   100
+#define ELIM_MAX_OCC       10
+#define ELIM_MAX_RESOLVENT 20
+#define VIVIFY_MAX_CLAUSES 1000
+
+
 
 
 /************************
@@ -1115,6 +1231,35 @@ static inline void smt_core_set_bool_only(smt_core_t *s) {
   s->bool_only = true;
 }
 
+/*
+ * Enable variable elimination during inprocessing
+ * - variables that are not attached to an atom can then be eliminated
+ * - this is sound only if no clause is added after the search starts
+ *   and the theory solver never refers to a variable without an atom
+ *   (e.g., a pure bitvector problem solved in one-check mode)
+ */
+static inline void smt_core_enable_var_elim(smt_core_t *s) {
+  s->var_elim = true;
+}
+
+static inline void smt_core_disable_var_elim(smt_core_t *s) {
+  s->var_elim = false;
+}
+
+/*
+ * Enable the export of learned clauses (cf. export_lbd above)
+ * - max_size = maximal clause size
+ * - max_lbd = maximal LBD (must be positive)
+ * - nvars = bound on the variables
+ * The caller must read and reset s->exported periodically.
+ */
+static inline void smt_core_enable_clause_export(smt_core_t *s, uint32_t max_size, uint32_t max_lbd, uint32_t nvars) {
+  assert(max_lbd > 0);
+  s->export_size = max_size;
+  s->export_lbd = max_lbd;
+  s->export_nvars = nvars;
+}
+
 /*
  * Replace the theory solver and interface descriptors
  * - this can used provided no atom/clause has been added yet
@@ -1188,6 +1333,21 @@ extern void smt_pop(smt_core_t *s);
 extern void set_var_decay_factor(smt_core_t *s, double factor);
 extern void set_clause_decay_factor(smt_core_t *s, float factor);
 
+/*
+ * Set the LBD thresholds for the learned-clause tiers
+ * - learned clauses with lbd <= keep_lbd are never deleted
+ * - learned clauses with lbd <= tier2_lbd are deleted only if they
+ *   were not used in conflict resolution since the previous reduction
+ * - tier2_lbd should be at least equal to keep_lbd
+ */
+static inline void set_keep_lbd(smt_core_t *s, uint32_t keep_lbd) {
+  s->keep_lbd = keep_lbd;
+}
+
+static inline void set_tier2_lbd(smt_core_t *s, uint32_t tier2_lbd) {
+  s->tier2_lbd = tier2_lbd;
+}
+
 /*
  * Set the randomness parameter used by the default variable
  * selection heuristic: random_factor must be a floating point
@@ -1506,6 +1666,15 @@ static inline uint32_t bvar_polarity(const smt_core_t *s, bvar_t x) {
   return (uint32_t) (s->value[x] & 1);
 }
 
+/*
+ * Set the preferred value of an unassigned variable x
+ * - if tt is true, x is set to true when it's picked as a decision variable
+ */
+static inline void set_bvar_preferred_value(smt_core_t *s, bvar_t x, bool tt) {
+  assert(0 <= x && x < s->nvars && bval_is_undef(s->value[x]));
+  s->value[x] = tt ? VAL_UNDEF_TRUE : VAL_UNDEF_FALSE;
+}
+
 
 /*
  * Read the value assigned to literal l at the current decision level
@@ -1611,9 +1780,11 @@ extern bool base_propagate(smt_core_t *s);
  * - reset the search statistics counters
  * - if clean_interrupt is enabled, save the current state to
  *   enable cleanup after interrupt (this uses push)
+ * - store the assumptions a[0 ... n-1] (n may be 0). No copy is made
+ *   so array a must not be modified until the search is done.
  * The current status must be IDLE.
  */
-extern void start_search(smt_core_t *s);
+extern void start_search(smt_core_t *s, uint32_t n, const literal_t *a);
 
 
 /*
@@ -1627,6 +1798,38 @@ extern void start_search(smt_core_t *s);
 extern void stop_search(smt_core_t *s);
 
 
+/*
+ * Get the next assumption to decide
+ * - this skips all assumptions that are already true
+ * - return null_literal if all assumptions are true
+ * - if an assumption is false, the search is done: the status is set
+ *   to UNSAT, the assumption is stored in s->bad_assumption,
+ *   and the function returns null_literal.
+ * - s->has_assumptions must be true and s->status must be SEARCHING
+ */
+extern literal_t get_next_assumption(smt_core_t *s);
+
+
+/*
+ * Check whether the search returned UNSAT because an assumption
+ * is false (rather than because the clauses are unsat)
+ */
+static inline bool smt_unsat_with_assumptions(smt_core_t *s) {
+  return s->status == STATUS_UNSAT && s->bad_assumption != null_literal;
+}
+
+
+/*
+ * Build an unsat core: s->status must be UNSAT.
+ * - if the status is UNSAT because of an assumption, then this
+ *   computes a subset of the assumptions that's inconsistent
+ *   with the clauses (final-conflict analysis)
+ * - otherwise, the clauses are unsat and the core is empty
+ * - the core literals are added to v (v is reset first)
+ */
+extern void build_unsat_core(smt_core_t *s, ivector_t *v);
+
+
 /*
  * Perform a (branching) decision: assign l to true
  * - s->status must be SEARCHING
@@ -1637,6 +1840,22 @@ extern void stop_search(smt_core_t *s);
 extern void decide_literal(smt_core_t *s, literal_t l);
 
 
+/*
+ * Add a clause learned by another solver (clause sharing)
+ * - a[0 ... n-1] must be implied by the clauses of s and all its
+ *   variables must exist in s
+ * - lbd = the clause's LBD in the other solver
+ * - s must be at its base level (nothing is done if s->status is not
+ *   SEARCHING)
+ * - the clause is ignored if it's true at the base level or if
+ *   it contains an eliminated variable
+ * - otherwise, literals false at the base level are removed and
+ *   the result is added as a learned clause (or as a unit or
+ *   binary clause). If the result is empty, s becomes inconsistent.
+ */
+extern void import_learned_clause(smt_core_t *s, uint32_t n, const literal_t *a, uint32_t lbd);
+
+
 /*
  * Cause a restart: backtrack to the base_level
  * - s->status must be SEARCHING
@@ -1662,15 +1881,20 @@ extern void smt_partial_restart_var(smt_core_t *s);
 
 
 /*
- * Reduce the clause database by removing half the learned clauses
- * (the ones with lowest activities)
+ * Reduce the clause database:
+ * - the core-tier clauses, the locked clauses, and the tier-2 clauses
+ *   used since the previous reduction are kept. The used flags are
+ *   then cleared.
+ * - half of the remaining clauses are deleted, starting with the
+ *   ones of highest lbd (and lowest activity for equal lbds)
  */
 extern void reduce_clause_database(smt_core_t *s);
 
 
 /*
  * Reduce the clause database by remove large clauses with low activity
- * (complicated Zchaff/Berkmin-style heuristic)
+ * (complicated Zchaff/Berkmin-style heuristic). Core-tier clauses
+ * (lbd <= keep_lbd) are kept.
  */
 extern void remove_irrelevant_learned_clauses(smt_core_t *s);
 
@@ -1754,6 +1978,23 @@ extern bool smt_bounded_process(smt_core_t *s, uint64_t max_conflicts);
 extern void smt_final_check(smt_core_t *s);
 
 
+/*
+ * Install a complete assignment given by the preferred values:
+ * - this is used when a model was found outside the core (by the sat
+ *   backend or a portfolio worker) and copied into the preferred values
+ * - every unassigned variable that's not eliminated is assigned to its
+ *   preferred value (as a decision) followed by propagation, then
+ *   smt_final_check is called
+ * - if the model satisfies all the clauses and the theory solver
+ *   accepts it, the status is SAT on return
+ * - the function returns as soon as a conflict is found. The status
+ *   is then UNSAT or SEARCHING, and in the latter case the caller must
+ *   complete the search as usual.
+ * - the core must be searching, with no pending conflict
+ */
+extern void smt_install_preferred_assignment(smt_core_t *s);
+
+
 
 /*
  * Propagation function for the theory solver
@@ -1810,7 +2051,8 @@ extern void smt_cleanup(smt_core_t *s);
 
 /*
  * Clear assignment and enable addition of new clauses after a search.
- * - this can be called if s->status is UNKNOWN or SAT
+ * - this can be called if s->status is UNKNOWN or SAT, or if it's UNSAT
+ *   because of an assumption (cf. smt_unsat_with_assumptions)
  * - s->status is reset to STATUS_IDLE and the current boolean
  *   assignment is cleared (i.e., we backtrack to the current base_level)
  */
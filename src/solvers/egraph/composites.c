@@ -22,6 +22,7 @@
 #include <stddef.h>
 
 #include "solvers/egraph/composites.h"
+#include "utils/hash_groups.h"
 #include "utils/int_array_sort.h"
 #include "utils/memalloc.h"
 
@@ -1175,6 +1176,9 @@ void init_congruence_table(congruence_table_t *tbl, uint32_t n) {
   if (n == 0) {
     n = DEFAULT_CONGRUENCE_TBL_SIZE;
   }
+  if (n < HGROUP_SIZE) {
+    n = HGROUP_SIZE;
+  }
 
   if (n >= MAX_CONGRUENCE_TBL_SIZE) {
     out_of_memory();
@@ -1188,6 +1192,7 @@ void init_congruence_table(congruence_table_t *tbl, uint32_t n) {
   }
 
   tbl->data = tmp;
+  tbl->ctrl = alloc_hctrl(n);
   tbl->size = n;
   tbl->nelems = 0;
   tbl->ndeleted = 0;
@@ -1209,6 +1214,7 @@ void reset_congruence_table(congruence_table_t *tbl) {
   for (i=0; i<n; i++) {
     tbl->data[i] = NULL_COMPOSITE;
   }
+  clear_hctrl(tbl->ctrl, n);
 
   tbl->nelems = 0;
   tbl->ndeleted = 0;
@@ -1220,61 +1226,88 @@ void reset_congruence_table(congruence_table_t *tbl) {
  */
 void delete_congruence_table(congruence_table_t *tbl) {
   safe_free(tbl->data);
+  safe_free(tbl->ctrl);
   tbl->data = NULL;
+  tbl->ctrl = NULL;
   delete_sign_buffer(&tbl->buffer);
 }
 
 
+/*
+ * Store d in slot j of tbl/remove the element in slot j
+ */
+static inline void congruence_table_set(congruence_table_t *tbl, uint32_t j, composite_t *d) {
+  tbl->data[j] = d;
+  hctrl_set(tbl->ctrl, tbl->size, j, hctrl_tag(d->hash));
+}
+
+static inline void congruence_table_delete_slot(congruence_table_t *tbl, uint32_t j) {
+  tbl->data[j] = DELETED_COMPOSITE;
+  hctrl_set(tbl->ctrl, tbl->size, j, HCTRL_DELETED);
+  tbl->nelems --;
+  tbl->ndeleted ++;
+}
+
+
 /*
  * Store composite d in a clean data array
- * - mask = size of data - 1
+ * - n = size of data, ctrl = control bytes
  * - d->hash is the hash code of d
  * data must not contain any deleted eterms and must have at least one empty slot
  */
-static void congruence_table_clean_copy(composite_t **data, composite_t *d, uint32_t mask) {
-  uint32_t j;
+static void congruence_table_clean_copy(composite_t **data, uint8_t *ctrl, uint32_t n, composite_t *d) {
+  uint32_t j, m, mask;
 
+  mask = n - 1;
   j = d->hash & mask;
-  while (data[j] != NULL_COMPOSITE) {
-    j ++;
+  for (;;) {
+    m = hgroup_match_empty(ctrl + j);
+    if (m != 0) break;
+    j += HGROUP_SIZE;
     j &= mask;
   }
-  data[j] = d;
-}
 
-
-/*
- * Check whether a pointer is non-deleted and non-null
- */
-static inline bool live_ptr(composite_t *d) {
-  return (((uintptr_t) d) & ~((uintptr_t) 1)) != 0;
+  j = (j + hgroup_first(m)) & mask;
+  data[j] = d;
+  hctrl_set(ctrl, n, j, hctrl_tag(d->hash));
 }
 
 
 /*
- * Remove deleted elements
+ * Copy all composites into new arrays of size n
  */
-static void congruence_table_cleanup(congruence_table_t *tbl) {
-  composite_t **tmp, *d;
-  uint32_t j, n, mask;
+static void congruence_table_rehash(congruence_table_t *tbl, uint32_t n) {
+  composite_t **tmp;
+  uint8_t *ctrl;
+  uint32_t j, old_n;
 
-  n = tbl->size;
   tmp = (composite_t **) safe_malloc(n * sizeof(composite_t *));
   for (j=0; j<n; j++) {
     tmp[j] = NULL_COMPOSITE;
   }
+  ctrl = alloc_hctrl(n);
 
-  mask = n - 1;
-  for (j=0; j<n; j++) {
-    d = tbl->data[j];
-    if (live_ptr(d)) {
-      congruence_table_clean_copy(tmp, d, mask);
+  old_n = tbl->size;
+  for (j=0; j<old_n; j++) {
+    if (hctrl_is_full(tbl->ctrl[j])) {
+      congruence_table_clean_copy(tmp, ctrl, n, tbl->data[j]);
     }
   }
 
   safe_free(tbl->data);
+  safe_free(tbl->ctrl);
   tbl->data = tmp;
+  tbl->ctrl = ctrl;
   tbl->ndeleted = 0;
+  tbl->size = n;
+}
+
+
+/*
+ * Remove deleted elements
+ */
+static void congruence_table_cleanup(congruence_table_t *tbl) {
+  congruence_table_rehash(tbl, tbl->size);
 }
 
 
@@ -1282,33 +1315,14 @@ static void congruence_table_cleanup(congruence_table_t *tbl) {
  * Remove deleted elements and make the table twice as large
  */
 static void congruence_table_extend(congruence_table_t *tbl) {
-  composite_t **tmp;
-  uint32_t n, n2, j, mask;
-  composite_t *d;
+  uint32_t n2;
 
-  n = tbl->size;
-  n2 = n<<1;
+  n2 = tbl->size << 1;
   if (n2 >= MAX_CONGRUENCE_TBL_SIZE) {
     out_of_memory();
   }
 
-  tmp = (composite_t **) safe_malloc(n2 * sizeof(composite_t *));
-  for (j=0; j<n2; j++) {
-    tmp[j] = NULL_COMPOSITE;
-  }
-
-  mask = n2 - 1;
-  for (j=0; j<n; j++) {
-    d = tbl->data[j];
-    if (live_ptr(d)) {
-      congruence_table_clean_copy(tmp, d, mask);
-    }
-  }
-
-  safe_free(tbl->data);
-  tbl->data = tmp;
-  tbl->ndeleted = 0;
-  tbl->size = n2;
+  congruence_table_rehash(tbl, n2);
 
   tbl->resize_threshold = (uint32_t)(n2 * CONGRUENCE_TBL_RESIZE_RATIO);
   tbl->cleanup_threshold = (uint32_t)(n2 * CONGRUENCE_TBL_CLEANUP_RATIO);
@@ -1316,23 +1330,42 @@ static void congruence_table_extend(congruence_table_t *tbl) {
 
 
 /*
- * Remove c from the congruence table.
- * - c must be in the table otherwise the function loops
+ * Search for c in the slots reachable from hash code h
+ * - return its index or -1 if c is not present
+ * - c->hash may be different from h so we compare c with all
+ *   the full slots (this compares pointers only)
  */
-void congruence_table_remove(congruence_table_t *tbl, composite_t *c) {
-  uint32_t mask, j;
+static int32_t congruence_table_locate(congruence_table_t *tbl, composite_t *c, uint32_t h) {
+  uint32_t mask, j, i, m;
+
+  assert(tbl->size > tbl->ndeleted + tbl->nelems);
 
   mask = tbl->size - 1;
-  j = c->hash & mask;
-  while (tbl->data[j] != c) {
-    j ++;
+  j = h & mask;
+  for (;;) {
+    m = ~hgroup_match_free(tbl->ctrl + j) & ((1 << HGROUP_SIZE) - 1);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      if (tbl->data[i] == c) return i;
+      m &= m - 1;
+    }
+    if (hgroup_match_empty(tbl->ctrl + j) != 0) return -1;
+    j += HGROUP_SIZE;
     j &= mask;
   }
+}
 
-  assert(tbl->data[j] == c);
-  tbl->data[j] = DELETED_COMPOSITE;
-  tbl->nelems --;
-  tbl->ndeleted ++;
+
+/*
+ * Remove c from the congruence table.
+ * - c must be in the table
+ */
+void congruence_table_remove(congruence_table_t *tbl, composite_t *c) {
+  int32_t j;
+
+  j = congruence_table_locate(tbl, c, c->hash);
+  assert(j >= 0 && tbl->data[j] == c);
+  congruence_table_delete_slot(tbl, j);
   if (tbl->ndeleted > tbl->cleanup_threshold) {
     congruence_table_cleanup(tbl);
   }
@@ -1346,25 +1379,13 @@ void congruence_table_remove(congruence_table_t *tbl, composite_t *c) {
  * - return false if c was not present
  */
 bool congruence_table_remove_if_present(congruence_table_t *tbl, composite_t *c) {
-  uint32_t mask, j;
-  composite_t *aux;
+  int32_t j;
 
-  assert(tbl->size > tbl->ndeleted + tbl->nelems);
-
-  mask = tbl->size - 1;
-  j = c->hash & mask;
-  for (;;) {
-    aux = tbl->data[j];
-    if (aux == c) break;
-    if (aux == NULL_COMPOSITE) return false; // c not in the table
-    j ++;
-    j &= mask;
-  }
+  j = congruence_table_locate(tbl, c, c->hash);
+  if (j < 0) return false; // c not in the table
 
   assert(tbl->data[j] == c);
-  tbl->data[j] = DELETED_COMPOSITE;
-  tbl->nelems --;
-  tbl->ndeleted ++;
+  congruence_table_delete_slot(tbl, j);
   if (tbl->ndeleted > tbl->cleanup_threshold) {
     congruence_table_cleanup(tbl);
   }
@@ -1380,18 +1401,24 @@ bool congruence_table_remove_if_present(congruence_table_t *tbl, composite_t *c)
  * - use only if it is known that no term is congruent to c
  */
 void congruence_table_add(congruence_table_t *tbl, composite_t *c) {
-  uint32_t mask, j;
+  uint32_t mask, j, m;
 
   assert(tbl->size > tbl->ndeleted + tbl->nelems);
 
   mask = tbl->size - 1;
   j = c->hash & mask;
-  while (live_ptr(tbl->data[j])) {
-    j ++;
+  for (;;) {
+    m = hgroup_match_free(tbl->ctrl + j);
+    if (m != 0) break;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 
-  tbl->data[j] = c;
+  j = (j + hgroup_first(m)) & mask;
+  if (tbl->ctrl[j] == HCTRL_DELETED) {
+    tbl->ndeleted --;
+  }
+  congruence_table_set(tbl, j, c);
   tbl->nelems ++;
   if (tbl->nelems + tbl->ndeleted > tbl->resize_threshold) {
     congruence_table_extend(tbl);
@@ -1405,19 +1432,28 @@ void congruence_table_add(congruence_table_t *tbl, composite_t *c) {
  * - the table must not be full
  */
 composite_t  *congruence_table_find(congruence_table_t *tbl, signature_t *s, elabel_t *label) {
-  uint32_t mask, j, h;
+  uint32_t mask, j, i, m, h;
+  uint8_t tag;
   composite_t *c;
 
   mask = tbl->size - 1;
   h = hash_signature(s);
+  tag = hctrl_tag(h);
   j = h & mask;
   for (;;) {
-    c = tbl->data[j];
-    if (c == NULL_COMPOSITE ||
-        (c != DELETED_COMPOSITE && c->hash == h && signature_matches(c, s, &tbl->buffer, label))) {
-      return c;
+    m = hgroup_match(tbl->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      c = tbl->data[i];
+      if (c->hash == h && signature_matches(c, s, &tbl->buffer, label)) {
+        return c;
+      }
+      m &= m - 1;
+    }
+    if (hgroup_match_empty(tbl->ctrl + j) != 0) {
+      return NULL_COMPOSITE;
     }
-    j ++;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 }
@@ -1447,7 +1483,8 @@ static inline bool matches_sigma_eq(composite_t *c, elabel_t *sigma, elabel_t *l
  * - return NULL_COMPOSITE if there's none
  */
 composite_t *congruence_table_find_eq(congruence_table_t *tbl, occ_t t1, occ_t t2, elabel_t *label) {
-  uint32_t mask, j, h;
+  uint32_t mask, j, i, m, h;
+  uint8_t tag;
   composite_t *c;
   elabel_t s[2];
 
@@ -1457,18 +1494,24 @@ composite_t *congruence_table_find_eq(congruence_table_t *tbl, occ_t t1, occ_t t
   h = hash_sigma_eq(s);
 
   mask = tbl->size - 1;
+  tag = hctrl_tag(h);
   j = h & mask;
   for (;;) {
-    c = tbl->data[j];
-    if (c == NULL_COMPOSITE ||
-        (c != DELETED_COMPOSITE &&
-         c->tag == mk_eq_tag() && c->hash == h && matches_sigma_eq(c, s, label))) {
-      return c;
+    m = hgroup_match(tbl->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      c = tbl->data[i];
+      if (c->tag == mk_eq_tag() && c->hash == h && matches_sigma_eq(c, s, label)) {
+        return c;
+      }
+      m &= m - 1;
     }
-    j ++;
+    if (hgroup_match_empty(tbl->ctrl + j) != 0) {
+      return NULL_COMPOSITE;
+    }
+    j += HGROUP_SIZE;
     j &= mask;
   }
-
 }
 
 
@@ -1477,7 +1520,8 @@ composite_t *congruence_table_find_eq(congruence_table_t *tbl, occ_t t1, occ_t t
  * If there is none, insert c in tbl.
  */
 composite_t  *congruence_table_get(congruence_table_t *tbl, composite_t *c, signature_t *s, elabel_t *label) {
-  uint32_t mask, j, k, h;
+  uint32_t mask, j, i, m, k, h;
+  uint8_t tag;
   composite_t *aux;
 
   assert(tbl->size > tbl->ndeleted + tbl->nelems);
@@ -1485,42 +1529,41 @@ composite_t  *congruence_table_get(congruence_table_t *tbl, composite_t *c, sign
   mask = tbl->size - 1;
   h = hash_signature(s);
   c->hash = h;
+  tag = hctrl_tag(h);
   j = h & mask;
 
+  // k is where addition will happen if necessary
+  k = UINT32_MAX;
   for (;;) {
-    aux = tbl->data[j];
-    if (aux == NULL_COMPOSITE) goto add;
-    if (aux == DELETED_COMPOSITE) break;
-    if (aux->hash == h && signature_matches(aux, s, &tbl->buffer, label)) goto found;
-    j ++;
+    m = hgroup_match(tbl->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      aux = tbl->data[i];
+      if (aux->hash == h && signature_matches(aux, s, &tbl->buffer, label)) {
+        return aux;
+      }
+      m &= m - 1;
+    }
+    if (k == UINT32_MAX) {
+      m = hgroup_match_free(tbl->ctrl + j);
+      if (m != 0) {
+        k = (j + hgroup_first(m)) & mask;
+      }
+    }
+    if (hgroup_match_empty(tbl->ctrl + j) != 0) break;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 
-  // j is where addition will happen if necessary
-  k = j;
-  for (;;) {
-    k++;
-    k &= mask;
-    aux = tbl->data[k];
-    if (aux == NULL_COMPOSITE) {
-      tbl->ndeleted --;
-      goto add;
-    }
-    if (aux != DELETED_COMPOSITE &&
-        aux->hash == h && signature_matches(aux, s, &tbl->buffer, label)) goto found;
+  if (tbl->ctrl[k] == HCTRL_DELETED) {
+    tbl->ndeleted --;
   }
-
- add:
-  tbl->data[j] = c;
+  congruence_table_set(tbl, k, c);
   tbl->nelems ++;
   if (tbl->nelems + tbl->ndeleted > tbl->resize_threshold) {
     congruence_table_extend(tbl);
   }
   return c;
-
-
- found:
-  return aux;
 }
 
 
@@ -1532,24 +1575,12 @@ composite_t  *congruence_table_get(congruence_table_t *tbl, composite_t *c, sign
  * - no change to c->hash
  */
 bool congruence_table_is_root(congruence_table_t *tbl, composite_t *c, elabel_t *label) {
-  uint32_t mask, j;
   signature_t *s;
-  composite_t *aux;
-
-  assert(tbl->size > tbl->ndeleted + tbl->nelems);
 
   s = &tbl->buffer;
   signature_composite(c, label, s);
 
-  mask = tbl->size - 1;
-  j = hash_signature(s) & mask;
-  for (;;) {
-    aux = tbl->data[j];
-    if (aux == c) return true;
-    if (aux == NULL_COMPOSITE) return false;
-    j ++;
-    j &= mask;
-  }
+  return congruence_table_locate(tbl, c, hash_signature(s)) >= 0;
 }
 
 
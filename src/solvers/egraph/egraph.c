@@ -36,6 +36,7 @@
 #include "utils/index_vectors.h"
 #include "utils/memalloc.h"
 #include "utils/ptr_partitions.h"
+#include "utils/thread_local.h"
 
 
 #define TRACE 0
@@ -1374,50 +1375,50 @@ static eterm_t build_lambda_obj(lambda_hobj_t *p) {
  * Interface objects:
  * type coercion are necessary to stop GCC warnings
  */
-static apply_hobj_t apply_hobj = {
+static YICES_THREAD_LOCAL apply_hobj_t apply_hobj = {
   { (hobj_hash_t) hash_apply_obj, (hobj_eq_t) equal_apply_obj, (hobj_build_t) build_apply_obj },
   NULL,
   0, 0, NULL,
 };
 
-static update_hobj_t update_hobj = {
+static YICES_THREAD_LOCAL update_hobj_t update_hobj = {
   { (hobj_hash_t) hash_update_obj, (hobj_eq_t) equal_update_obj, (hobj_build_t) build_update_obj },
   NULL,
   0, 0, NULL, 0,
 };
 
-static composite_hobj_t tuple_hobj = {
+static YICES_THREAD_LOCAL composite_hobj_t tuple_hobj = {
   { (hobj_hash_t) hash_tuple_obj, (hobj_eq_t) equal_tuple_obj, (hobj_build_t) build_tuple_obj },
   NULL,
   0, NULL,
 };
 
-static eq_hobj_t eq_hobj = {
+static YICES_THREAD_LOCAL eq_hobj_t eq_hobj = {
   { (hobj_hash_t) hash_eq_obj, (hobj_eq_t) equal_eq_obj, (hobj_build_t) build_eq_obj },
   NULL,
   0, 0,
 };
 
 
-static ite_hobj_t ite_hobj = {
+static YICES_THREAD_LOCAL ite_hobj_t ite_hobj = {
   { (hobj_hash_t) hash_ite_obj, (hobj_eq_t) equal_ite_obj, (hobj_build_t) build_ite_obj },
   NULL,
   0, 0, 0,
 };
 
-static composite_hobj_t distinct_hobj = {
+static YICES_THREAD_LOCAL composite_hobj_t distinct_hobj = {
   { (hobj_hash_t) hash_distinct_obj, (hobj_eq_t) equal_distinct_obj, (hobj_build_t) build_distinct_obj },
   NULL,
   0, NULL,
 };
 
-static composite_hobj_t or_hobj = {
+static YICES_THREAD_LOCAL composite_hobj_t or_hobj = {
   { (hobj_hash_t) hash_or_obj, (hobj_eq_t) equal_or_obj, (hobj_build_t) build_or_obj },
   NULL,
   0, NULL,
 };
 
-static lambda_hobj_t lambda_hobj = {
+static YICES_THREAD_LOCAL lambda_hobj_t lambda_hobj = {
   { (hobj_hash_t) hash_lambda_obj, (hobj_eq_t) equal_lambda_obj, (hobj_build_t) build_lambda_obj },
   NULL,
   0, 0,
@@ -1648,7 +1649,7 @@ static eterm_t build_const_hobj(const_hobj_t *p) {
 }
 
 
-static const_hobj_t const_hobj = {
+static YICES_THREAD_LOCAL const_hobj_t const_hobj = {
   { (hobj_hash_t) hash_const_hobj, (hobj_eq_t) equal_const_hobj, (hobj_build_t) build_const_hobj },
   NULL,
   0, 0,
@@ -3382,7 +3383,7 @@ static eterm_t build_aux_eq_obj(eq_hobj_t *p) {
 /*
  * Hash-consing object
  */
-static eq_hobj_t aux_eq_hobj = {
+static YICES_THREAD_LOCAL eq_hobj_t aux_eq_hobj = {
   { (hobj_hash_t) hash_eq_obj, (hobj_eq_t) equal_eq_obj, (hobj_build_t) build_aux_eq_obj },
   NULL,
   0, 0,
@@ -682,9 +682,11 @@ typedef struct signature_s {
 /*
  * Hash-table of composites: stores a unique representative
  * (congruence root) per signature. It's similar to int_hash_table.
+ * The control bytes are used for probing (see utils/hash_groups.h).
  */
 typedef struct congruence_table_s {
   composite_t **data;  // the hash table proper
+  uint8_t *ctrl;       // control bytes: one per element of data + HGROUP_SIZE - 1
   uint32_t size;       // its size (must be a power of 2)
   uint32_t nelems;     // number of elements
   uint32_t ndeleted;   // deleted elements
@@ -37,6 +37,7 @@
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 #define TRACE 0
@@ -1216,7 +1217,7 @@ static int32_t build_atom(idlatom_hobj_t *p) {
 /*
  * Hobject
  */
-static idlatom_hobj_t atom_hobj = {
+static YICES_THREAD_LOCAL idlatom_hobj_t atom_hobj = {
   { (hobj_hash_t) hash_atom, (hobj_eq_t) equal_atom, (hobj_build_t) build_atom },
   NULL,
   0, 0, 0,
@@ -28,6 +28,7 @@
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 #ifndef NDEBUG
@@ -1460,7 +1461,7 @@ static int32_t build_atom(rdlatom_hobj_t *p) {
 /*
  * Hobject
  */
-static rdlatom_hobj_t atom_hobj = {
+static YICES_THREAD_LOCAL rdlatom_hobj_t atom_hobj = {
   { (hobj_hash_t) hash_atom, (hobj_eq_t) equal_atom, (hobj_build_t) build_atom },
   NULL,
   0, 0, 0,
@@ -36,6 +36,7 @@
 
 #include "solvers/simplex/arith_atomtable.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 /*
@@ -284,7 +285,7 @@ static int32_t build_arith_atm_hobj(arith_atom_hobj_t *o) {
 /*
  * Global hash-consing object
  */
-static arith_atom_hobj_t arith_atom_hobj = {
+static YICES_THREAD_LOCAL arith_atom_hobj_t arith_atom_hobj = {
   { (hobj_hash_t) hash_arith_atm_hobj, (hobj_eq_t) eq_arith_atm_hobj, (hobj_build_t) build_arith_atm_hobj },
   NULL,
   NULL,
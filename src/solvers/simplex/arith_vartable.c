@@ -38,6 +38,7 @@
 #include "solvers/simplex/arith_vartable.h"
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
+#include "utils/thread_local.h"
 
 
 
@@ -517,7 +518,7 @@ static thvar_t build_rational_hobj(rational_hobj_t *o) {
 /*
  * Hash consing object
  */
-static rational_hobj_t rational_hobj = {
+static YICES_THREAD_LOCAL rational_hobj_t rational_hobj = {
   { (hobj_hash_t) hash_rational_hobj, (hobj_eq_t) eq_rational_hobj, (hobj_build_t) build_rational_hobj },
   NULL,
   NULL,
@@ -637,7 +638,7 @@ static thvar_t build_pprod_hobj(pprod_hobj_t *o) {
 /*
  * Hash consing object
  */
-static pprod_hobj_t pprod_hobj = {
+static YICES_THREAD_LOCAL pprod_hobj_t pprod_hobj = {
   { (hobj_hash_t) hash_pprod_hobj, (hobj_eq_t) eq_pprod_hobj, (hobj_build_t) build_pprod_hobj },
   NULL,
   NULL,
@@ -769,7 +770,7 @@ static thvar_t build_poly_hobj(poly_hobj_t *o) {
 /*
  * Hash-object for polynomials
  */
-static poly_hobj_t poly_hobj = {
+static YICES_THREAD_LOCAL poly_hobj_t poly_hobj = {
   { (hobj_hash_t) hash_poly_hobj, (hobj_eq_t) eq_poly_hobj, (hobj_build_t) build_poly_hobj },
   NULL,
   NULL,
@@ -326,6 +326,12 @@ void init_matrix(matrix_t *matrix, uint32_t n, uint32_t m) {
 
   q_init(&matrix->factor);
 
+  matrix->pivot.n = 0;
+  matrix->pivot.size = 0;
+  matrix->pivot.all_int = true;
+  matrix->pivot.idx = NULL;
+  matrix->pivot.coeff = NULL;
+
   // marks: one bit per row
   matrix->marks = allocate_bitvector(n);
 
@@ -357,6 +363,8 @@ void delete_matrix(matrix_t *matrix) {
   safe_free(matrix->base_var);
   safe_free(matrix->base_row);
   delete_bitvector(matrix->marks);
+  safe_free(matrix->pivot.idx);
+  safe_free(matrix->pivot.coeff);
 
   q_clear(&matrix->factor);
 
@@ -1696,23 +1704,74 @@ void matrix_scale_row(row_t *r, uint32_t k) {
 
 
 /*
- * Auxiliary function for variable elimination. This is the common
- * part of Gaussian elimination and pivoting.
- *
- * Input:
- * - r = index of the row where variable elimination is done
- * - k = index in that row of an element a.x where x is the variable to eliminate
- *       (i.e., matrix->row[r]->data[k] is (x, .., a) and a is non-zero
- * - row0 = a row where x has coefficient 1 (it must be distinct from row[r])
- *
- * The function subtract a * row0 from row[r] to eliminate x.
+ * PIVOT ROW
  */
-void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
+
+/*
+ * Make the pivot-row buffer large enough for n elements
+ */
+static void resize_pivot_row(pivot_row_t *p, uint32_t n) {
+  uint32_t size;
+
+  assert(n <= MAX_MATRIX_ROW_SIZE);
+
+  size = p->size;
+  if (size < n) {
+    size += size >> 1;
+    if (size < n) size = n;
+    safe_free(p->idx);
+    safe_free(p->coeff);
+    p->idx = (int32_t *) safe_malloc(size * sizeof(int32_t));
+    p->coeff = (rational_t *) safe_malloc(size * sizeof(rational_t));
+    p->size = size;
+  }
+}
+
+/*
+ * Copy the live elements of row0 into the pivot-row buffer
+ * - the coefficients are shallow copies so row0 must not be
+ *   modified while the pivot row is in use
+ */
+static void matrix_load_pivot_row(matrix_t *matrix, row_t *row0) {
+  pivot_row_t *p;
+  row_elem_t *e;
+  uint32_t i, j, n;
+  bool all_int;
+
+  p = &matrix->pivot;
+  resize_pivot_row(p, row0->nelems);
+
+  all_int = true;
+  e = row0->data;
+  n = row0->size;
+  j = 0;
+  for (i=0; i<n; i++) {
+    if (e[i].c_idx >= 0) {
+      p->idx[j] = e[i].c_idx;
+      p->coeff[j] = e[i].coeff;
+      all_int &= q_is_smallint(&e[i].coeff);
+      j ++;
+    }
+  }
+
+  assert(j == row0->nelems);
+  p->n = j;
+  p->all_int = all_int;
+}
+
+
+/*
+ * Subtract a * pivot row from row[r] where a = coefficient of
+ * row[r]->data[k]. The pivot row must be loaded and distinct from row[r].
+ */
+static void matrix_submul_pivot_row(matrix_t *matrix, uint32_t r, uint32_t k) {
+  pivot_row_t *p;
   row_t *row;
   row_elem_t *e;
-  int32_t *index;
+  rational_t *coeff, *q;
+  int32_t *index, *idx;
   uint32_t i, n;
-  int32_t j, x;
+  int32_t j, x, b;
   rational_t *a;
 
   assert(r < matrix->nrows);
@@ -1732,47 +1791,72 @@ void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
   q_set(a, &row->data[k].coeff);
 
   // update the coefficients in row r
-  n = row0->size;
-  e = row0->data;
-  if (q_is_one(a)) {
+  p = &matrix->pivot;
+  n = p->n;
+  idx = p->idx;
+  coeff = p->coeff;
+  if (p->all_int && q_is_smallint(a)) {
     /*
-     * special case a=1: subtract row0 from row
+     * fast path: a and all coefficients of the pivot row are small integers
      */
+    b = q_get_smallint(a);
     for (i=0; i<n; i++) {
-      x = e[i].c_idx;
-      if (x >= 0) {
-        j = index[x];
-        if (j < 0) {
-          // x does not occur in row r: create a new element
-          j = alloc_row_elem(&row);
-          row->data[j].c_idx = x;
-          row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
-          q_set_neg(&row->data[j].coeff, &row0->data[i].coeff);
-        } else {
-          // x occurs in row
-          q_sub(&row->data[j].coeff, &row0->data[i].coeff);
+      x = idx[i];
+      j = index[x];
+      if (j < 0) {
+        // x does not occur in row r: create a new element
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q = &row->data[j].coeff;
+        q_clear(q);
+        if (! q_smallint_submul(q, b, q_get_smallint(coeff + i))) {
+          q_set64(q, - ((int64_t) b) * q_get_smallint(coeff + i));
+        }
+      } else {
+        // x occurs in element j of row r
+        q = &row->data[j].coeff;
+        if (! q_is_smallint(q) || ! q_smallint_submul(q, b, q_get_smallint(coeff + i))) {
+          q_submul(q, a, coeff + i);
         }
       }
     }
 
+  } else if (q_is_one(a)) {
+    /*
+     * special case a=1: subtract row0 from row
+     */
+    for (i=0; i<n; i++) {
+      x = idx[i];
+      j = index[x];
+      if (j < 0) {
+        // x does not occur in row r: create a new element
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set_neg(&row->data[j].coeff, coeff + i);
+      } else {
+        // x occurs in row
+        q_sub(&row->data[j].coeff, coeff + i);
+      }
+    }
+
   } else if (q_is_minus_one(a)) {
     /*
      * special case a=-1: add row0 to row
      */
     for (i=0; i<n; i++) {
-      x = e[i].c_idx;
-      if (x >= 0) {
-        j = index[x];
-        if (j < 0) {
-          // x does not occur in row r
-          j = alloc_row_elem(&row);
-          row->data[j].c_idx = x;
-          row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
-          q_set(&row->data[j].coeff, &row0->data[i].coeff);
-        } else {
-          // x occurs in row
-          q_add(&row->data[j].coeff, &row0->data[i].coeff);
-        }
+      x = idx[i];
+      j = index[x];
+      if (j < 0) {
+        // x does not occur in row r
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set(&row->data[j].coeff, coeff + i);
+      } else {
+        // x occurs in row
+        q_add(&row->data[j].coeff, coeff + i);
       }
     }
 
@@ -1781,20 +1865,18 @@ void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
      * general case: subtract a * row0 from row
      */
     for (i=0; i<n; i++) {
-      x = e[i].c_idx;
-      if (x >= 0) {
-        j = index[x];
-        if (j < 0) {
-          // x does not occur in row r: create a new element
-          j = alloc_row_elem(&row);
-          row->data[j].c_idx = x;
-          row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
-          q_set_neg(&row->data[j].coeff, a);
-          q_mul(&row->data[j].coeff, &row0->data[i].coeff);
-        } else {
-          // x occurs in element j of row r
-          q_submul(&row->data[j].coeff, a, &row0->data[i].coeff);
-        }
+      x = idx[i];
+      j = index[x];
+      if (j < 0) {
+        // x does not occur in row r: create a new element
+        j = alloc_row_elem(&row);
+        row->data[j].c_idx = x;
+        row->data[j].c_ptr = add_column_elem(matrix, x, r, j);
+        q_set_neg(&row->data[j].coeff, a);
+        q_mul(&row->data[j].coeff, coeff + i);
+      } else {
+        // x occurs in element j of row r
+        q_submul(&row->data[j].coeff, a, coeff + i);
       }
     }
   }
@@ -1826,7 +1908,24 @@ void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
   if (row->nelems * 2 < row->size) {
     matrix_compact_row(matrix, r);
   }
+}
+
 
+/*
+ * Auxiliary function for variable elimination. This is the common
+ * part of Gaussian elimination and pivoting.
+ *
+ * Input:
+ * - r = index of the row where variable elimination is done
+ * - k = index in that row of an element a.x where x is the variable to eliminate
+ *       (i.e., matrix->row[r]->data[k] is (x, .., a) and a is non-zero
+ * - row0 = a row where x has coefficient 1 (it must be distinct from row[r])
+ *
+ * The function subtract a * row0 from row[r] to eliminate x.
+ */
+void matrix_submul_row(matrix_t *matrix, uint32_t r, uint32_t k, row_t *row0) {
+  matrix_load_pivot_row(matrix, row0);
+  matrix_submul_pivot_row(matrix, r, k);
 }
 
 
@@ -1854,13 +1953,14 @@ void matrix_pivot(matrix_t *matrix, uint32_t r0, uint32_t k) {
   matrix_scale_row(row0, k);
 
   // eliminate x from the other rows
+  matrix_load_pivot_row(matrix, row0);
   col = matrix->column[x];
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_submul_pivot_row(matrix, r, j);
       assert(matrix->column[x] == col); // column[x] should not change
     }
   }
@@ -2046,13 +2146,14 @@ static void matrix_pivot_and_update(matrix_t *matrix, markowitz_t *d, uint32_t r
   matrix_scale_row(row0, k);
 
   // eliminate x from the other rows
+  matrix_load_pivot_row(matrix, row0);
   col = matrix->column[x];
   n = col->size;
   for (i=0; i<n; i++) {
     r = col->data[i].r_idx;
     if (r >= 0 && r != r0) {
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_submul_pivot_row(matrix, r, j);
       assert(matrix->column[x] == col); // column[x] should not change
 
       // update the heap for row r
@@ -2462,6 +2563,7 @@ static void gauss_elim_row(matrix_t *matrix, markowitz_t *d, byte_t *i_flag,
   matrix_detach_row(matrix, row0);
 
   // eliminate x from the other rows
+  matrix_load_pivot_row(matrix, row0);
   col = matrix->column[x];
   n = col->size;
   for (i=0; i<n; i++) {
@@ -2469,7 +2571,7 @@ static void gauss_elim_row(matrix_t *matrix, markowitz_t *d, byte_t *i_flag,
     if (r >= 0) {
       assert(r != r0);
       j = col->data[i].r_ptr;
-      matrix_submul_row(matrix, r, j, row0);
+      matrix_submul_pivot_row(matrix, r, j);
       markowitz_update(d, matrix, r);
     }
   }
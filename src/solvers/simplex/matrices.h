@@ -126,6 +126,26 @@ typedef struct column_s {
 
 
 
+/*
+ * Pivot row: compact copy of the row used to eliminate a variable
+ * from the other rows during pivoting.
+ * - the live elements are stored in two separate arrays:
+ *   idx[i] = column index, coeff[i] = coefficient, for i in 0 ... n-1
+ * - the coefficients are shallow copies of the row's coefficients
+ *   (they're valid as long as the row is not modified)
+ * - size = capacity of the arrays
+ * - all_int is true if all coefficients are small integers
+ *   (then row operations can use 64bit integer arithmetic)
+ */
+typedef struct pivot_row_s {
+  uint32_t n;
+  uint32_t size;
+  bool all_int;
+  int32_t *idx;
+  rational_t *coeff;
+} pivot_row_t;
+
+
 /*
  * Matrix
  * - two arrays: one for rows, one for columns
@@ -163,6 +183,7 @@ typedef struct matrix_s {
   // auxiliary data structures
   int32_t *index;
   rational_t factor;    // pivot coefficient
+  pivot_row_t pivot;    // copy of the pivot row
 
   // marks
   byte_t *marks;
@@ -0,0 +1,2017 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SPARSE SOLVER FOR INTEGER DIFFERENCE LOGIC
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "solvers/sparse_dl/sparse_idl.h"
+#include "utils/hash_functions.h"
+#include "utils/memalloc.h"
+#include "utils/thread_local.h"
+
+
+#define TRACE 0
+
+#if TRACE || !defined(NDEBUG)
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#endif
+
+
+
+/****************
+ *  EDGE STACK  *
+ ***************/
+
+/*
+ * Initialize the stack
+ * - n = initial size
+ */
+static void init_sidl_edge_stack(sidl_edge_stack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_EDGE_STACK_SIZE);
+
+  stack->data = (sidl_edge_t *) safe_malloc(n * sizeof(sidl_edge_t));
+  stack->lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  stack->size = n;
+  stack->top = 0;
+}
+
+
+/*
+ * Make the stack 50% larger
+ */
+static void extend_sidl_edge_stack(sidl_edge_stack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_EDGE_STACK_SIZE) {
+    out_of_memory();
+  }
+
+  stack->data = (sidl_edge_t *) safe_realloc(stack->data, n * sizeof(sidl_edge_t));
+  stack->lit = (literal_t *) safe_realloc(stack->lit, n * sizeof(literal_t));
+  stack->size = n;
+}
+
+
+/*
+ * Empty the stack
+ */
+static inline void reset_sidl_edge_stack(sidl_edge_stack_t *stack) {
+  stack->top = 0;
+}
+
+
+/*
+ * Delete the stack
+ */
+static inline void delete_sidl_edge_stack(sidl_edge_stack_t *stack) {
+  safe_free(stack->data);
+  safe_free(stack->lit);
+  stack->data = NULL;
+  stack->lit = NULL;
+}
+
+
+
+/******************
+ *  VERTEX TABLE  *
+ *****************/
+
+static void init_sidl_vtbl(sidl_vtbl_t *table, uint32_t n) {
+  assert(n < MAX_SIDL_VTBL_SIZE);
+
+  table->size = n;
+  table->nvertices = 0;
+  table->data = (sidl_vertex_t *) safe_malloc(n * sizeof(sidl_vertex_t));
+}
+
+static void extend_sidl_vtbl(sidl_vtbl_t *table) {
+  uint32_t n;
+
+  n = table->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_VTBL_SIZE) {
+    out_of_memory();
+  }
+
+  table->data = (sidl_vertex_t *) safe_realloc(table->data, n * sizeof(sidl_vertex_t));
+  table->size = n;
+}
+
+static inline void reset_sidl_vtbl(sidl_vtbl_t *table) {
+  table->nvertices = 0;
+}
+
+static inline void delete_sidl_vtbl(sidl_vtbl_t *table) {
+  safe_free(table->data);
+  table->data = NULL;
+}
+
+
+
+/*******************
+ *  PRIORITY QUEUE  *
+ ******************/
+
+static void init_sidl_heap(sidl_heap_t *heap, uint32_t n) {
+  assert(n < MAX_SIDL_HEAP_SIZE);
+
+  heap->size = n;
+  heap->nelems = 0;
+  heap->data = (sidl_heap_elem_t *) safe_malloc(n * sizeof(sidl_heap_elem_t));
+}
+
+static void extend_sidl_heap(sidl_heap_t *heap) {
+  uint32_t n;
+
+  n = heap->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_HEAP_SIZE) {
+    out_of_memory();
+  }
+
+  heap->data = (sidl_heap_elem_t *) safe_realloc(heap->data, n * sizeof(sidl_heap_elem_t));
+  heap->size = n;
+}
+
+static inline void reset_sidl_heap(sidl_heap_t *heap) {
+  heap->nelems = 0;
+}
+
+static inline void delete_sidl_heap(sidl_heap_t *heap) {
+  safe_free(heap->data);
+  heap->data = NULL;
+}
+
+static inline bool sidl_heap_is_empty(sidl_heap_t *heap) {
+  return heap->nelems == 0;
+}
+
+
+/*
+ * Add pair (k, x) to the heap
+ */
+static void sidl_heap_push(sidl_heap_t *heap, int64_t k, int32_t x) {
+  sidl_heap_elem_t *d;
+  uint32_t i, j;
+
+  i = heap->nelems;
+  if (i == heap->size) {
+    extend_sidl_heap(heap);
+  }
+  heap->nelems = i+1;
+
+  // move the hole up
+  d = heap->data;
+  while (i > 0) {
+    j = (i - 1) >> 1;
+    if (d[j].key <= k) break;
+    d[i] = d[j];
+    i = j;
+  }
+  d[i].key = k;
+  d[i].vertex = x;
+}
+
+
+/*
+ * Remove the smallest element and store it in *e
+ * - the heap must not be empty
+ */
+static void sidl_heap_pop(sidl_heap_t *heap, sidl_heap_elem_t *e) {
+  sidl_heap_elem_t *d, last;
+  uint32_t i, j, n;
+
+  assert(heap->nelems > 0);
+
+  d = heap->data;
+  *e = d[0];
+  n = heap->nelems - 1;
+  heap->nelems = n;
+  if (n == 0) return;
+
+  // move last element down from the root
+  last = d[n];
+  i = 0;
+  for (;;) {
+    j = 2 * i + 1;
+    if (j >= n) break;
+    if (j + 1 < n && d[j+1].key < d[j].key) j ++;
+    if (last.key <= d[j].key) break;
+    d[i] = d[j];
+    i = j;
+  }
+  d[i] = last;
+}
+
+
+
+/****************
+ *  ATOM TABLE  *
+ ***************/
+
+static void init_sidl_atbl(sidl_atbl_t *table, uint32_t n) {
+  assert(n < MAX_SIDL_ATBL_SIZE);
+
+  table->size = n;
+  table->natoms = 0;
+  table->atoms = (sidl_atom_t *) safe_malloc(n * sizeof(sidl_atom_t));
+  table->mark = allocate_bitvector(n);
+}
+
+static void extend_sidl_atbl(sidl_atbl_t *table) {
+  uint32_t n;
+
+  n = table->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_ATBL_SIZE) {
+    out_of_memory();
+  }
+
+  table->size = n;
+  table->atoms = (sidl_atom_t *) safe_realloc(table->atoms, n * sizeof(sidl_atom_t));
+  table->mark = extend_bitvector(table->mark, n);
+}
+
+static inline void reset_sidl_atbl(sidl_atbl_t *table) {
+  table->natoms = 0;
+}
+
+static inline void delete_sidl_atbl(sidl_atbl_t *table) {
+  safe_free(table->atoms);
+  delete_bitvector(table->mark);
+  table->atoms = NULL;
+  table->mark = NULL;
+}
+
+static inline sidl_atom_t *get_sidl_atom(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms);
+  return table->atoms + i;
+}
+
+static inline bool sidl_atom_is_assigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms);
+  return tst_bit(table->mark, i);
+}
+
+static inline void mark_sidl_atom_assigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms && ! tst_bit(table->mark, i));
+  set_bit(table->mark, i);
+}
+
+static inline void mark_sidl_atom_unassigned(sidl_atbl_t *table, int32_t i) {
+  assert(0 <= i && i < table->natoms && tst_bit(table->mark, i));
+  clr_bit(table->mark, i);
+}
+
+
+
+/**********************************
+ *  ATOM STACK/PROPAGATION QUEUE  *
+ *********************************/
+
+static void init_sidl_astack(sidl_astack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_ASTACK_SIZE);
+  stack->size = n;
+  stack->top = 0;
+  stack->prop_ptr = 0;
+  stack->data = (int32_t *) safe_malloc(n * sizeof(int32_t));
+}
+
+static void extend_sidl_astack(sidl_astack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_ASTACK_SIZE) {
+    out_of_memory();
+  }
+
+  stack->data = (int32_t *) safe_realloc(stack->data, n * sizeof(int32_t));
+  stack->size = n;
+}
+
+static inline void reset_sidl_astack(sidl_astack_t *stack) {
+  stack->top = 0;
+  stack->prop_ptr = 0;
+}
+
+static inline void delete_sidl_astack(sidl_astack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+/*
+ * Atom id + sign bit packed into a 32 bit integer (as in the
+ * Floyd-Warshall solvers).
+ */
+static inline int32_t pos_index(int32_t id) {
+  return id << 1;
+}
+
+static inline int32_t neg_index(int32_t id) {
+  return (id<<1) | 1;
+}
+
+static inline int32_t mk_index(int32_t id, uint32_t sign) {
+  assert(sign == 0 || sign == 1);
+  return (id<<1) | sign;
+}
+
+static inline int32_t atom_of_index(int32_t idx) {
+  return idx>>1;
+}
+
+static inline bool is_pos_index(int32_t idx) {
+  return (((uint32_t) idx) & 1) == 0;
+}
+
+static void push_atom_index(sidl_astack_t *stack, int32_t k) {
+  uint32_t i;
+
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_astack(stack);
+  }
+  assert(i < stack->size);
+  stack->data[i] = k;
+  stack->top = i+1;
+}
+
+
+
+/****************
+ *  UNDO STACK  *
+ ***************/
+
+static void init_sidl_undo_stack(sidl_undo_stack_t *stack, uint32_t n) {
+  assert(n < MAX_SIDL_UNDO_STACK_SIZE);
+
+  stack->size = n;
+  stack->top = 0;
+  stack->data = (sidl_undo_record_t *) safe_malloc(n * sizeof(sidl_undo_record_t));
+}
+
+static void extend_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  uint32_t n;
+
+  n = stack->size + 1;
+  n += n>>1;
+  if (n >= MAX_SIDL_UNDO_STACK_SIZE) {
+    out_of_memory();
+  }
+
+  stack->data = (sidl_undo_record_t *) safe_realloc(stack->data, n * sizeof(sidl_undo_record_t));
+  stack->size = n;
+}
+
+static void push_sidl_undo_record(sidl_undo_stack_t *stack, uint32_t e, uint32_t a) {
+  uint32_t i;
+
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_undo_stack(stack);
+  }
+  assert(i < stack->size);
+  stack->data[i].nedges = e;
+  stack->data[i].natoms = a;
+  stack->top = i+1;
+}
+
+static inline void reset_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  stack->top = 0;
+}
+
+static inline void delete_sidl_undo_stack(sidl_undo_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+/********************
+ *  PUSH/POP STACK  *
+ *******************/
+
+static void init_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  stack->size = 0;
+  stack->top = 0;
+  stack->data = NULL;
+}
+
+static void sidl_trail_stack_save(sidl_trail_stack_t *stack, uint32_t nv, uint32_t na, bool unsat) {
+  uint32_t i, n;
+
+  i = stack->top;
+  n = stack->size;
+  if (i == n) {
+    if (n == 0) {
+      n = DEFAULT_SIDL_TRAIL_SIZE;
+    } else {
+      n += n;
+      if (n >= MAX_SIDL_TRAIL_SIZE) {
+        out_of_memory();
+      }
+    }
+    stack->data = (sidl_trail_t *) safe_realloc(stack->data, n * sizeof(sidl_trail_t));
+    stack->size = n;
+  }
+  assert(i < stack->size);
+
+  stack->data[i].nvertices = nv;
+  stack->data[i].natoms = na;
+  stack->data[i].unsat = unsat;
+  stack->top = i+1;
+}
+
+static inline sidl_trail_t *sidl_trail_stack_top(sidl_trail_stack_t *stack) {
+  assert(stack->top > 0);
+  return stack->data + (stack->top - 1);
+}
+
+static inline void sidl_trail_stack_pop(sidl_trail_stack_t *stack) {
+  assert(stack->top > 0);
+  stack->top --;
+}
+
+static inline void reset_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  stack->top = 0;
+}
+
+static inline void delete_sidl_trail_stack(sidl_trail_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+
+
+/*********************
+ *  VERTEX CREATION  *
+ ********************/
+
+/*
+ * Create a new vertex and return its index
+ * - the vertex has no edges and potential 0
+ */
+int32_t sidl_new_vertex(sidl_solver_t *solver) {
+  sidl_vtbl_t *table;
+  sidl_vertex_t *v;
+  uint32_t n;
+
+  table = &solver->vertices;
+  n = table->nvertices;
+  if (n >= MAX_SIDL_VERTICES) {
+    return null_sidl_vertex;
+  }
+  if (n == table->size) {
+    extend_sidl_vtbl(table);
+  }
+  assert(n < table->size);
+
+  v = table->data + n;
+  v->first_out = null_sidl_edge;
+  v->first_in = null_sidl_edge;
+  v->first_src_atom = -1;
+  v->first_tgt_atom = -1;
+  v->pot = 0;
+  v->delta = 0;
+  v->fdist = 0;
+  v->bdist = 0;
+  v->fpred = null_sidl_edge;
+  v->bpred = null_sidl_edge;
+  v->ftag = 0;
+  v->btag = 0;
+
+  table->nvertices = n + 1;
+
+  return n;
+}
+
+
+/*
+ * Get the zero vertex (create a new vertex if needed)
+ */
+int32_t sidl_zero_vertex(sidl_solver_t *solver) {
+  int32_t z;
+
+  z = solver->zero_vertex;
+  if (z == null_sidl_vertex) {
+    z = sidl_new_vertex(solver);
+    solver->zero_vertex = z;
+  }
+  return z;
+}
+
+
+
+/***************************
+ *  HASH-CONSING OF ATOMS  *
+ **************************/
+
+/*
+ * Hash code for atom (x - y <= d)
+ */
+static inline uint32_t hash_sidl_atom(int32_t x, int32_t y, int32_t d) {
+  return jenkins_hash_triple(x, y, d, 0x5c1d7a3e);
+}
+
+typedef struct sidlatom_hobj_s {
+  int_hobj_t m;      // methods
+  sidl_solver_t *solver;
+  int32_t source, target, cost;
+} sidlatom_hobj_t;
+
+static uint32_t hash_atom(sidlatom_hobj_t *p) {
+  return hash_sidl_atom(p->source, p->target, p->cost);
+}
+
+static bool equal_atom(sidlatom_hobj_t *p, int32_t id) {
+  sidl_atom_t *atm;
+
+  atm = get_sidl_atom(&p->solver->atoms, id);
+  return atm->source == p->source && atm->target == p->target && atm->cost == p->cost;
+}
+
+
+/*
+ * Create a new atom: (x - y <= c) and add it to the atom lists of x and y
+ */
+static int32_t build_atom(sidlatom_hobj_t *p) {
+  sidl_atbl_t *table;
+  sidl_vertex_t *v;
+  sidl_atom_t *atm;
+  uint32_t i;
+
+  table = &p->solver->atoms;
+  i = table->natoms;
+  if (i == table->size) {
+    extend_sidl_atbl(table);
+  }
+  assert(i < table->size);
+
+  v = p->solver->vertices.data;
+  atm = table->atoms + i;
+  atm->source = p->source;
+  atm->target = p->target;
+  atm->cost = p->cost;
+  atm->boolvar = null_bvar;
+  atm->next_src = v[p->source].first_src_atom;
+  atm->next_tgt = v[p->target].first_tgt_atom;
+  v[p->source].first_src_atom = i;
+  v[p->target].first_tgt_atom = i;
+
+  clr_bit(table->mark, i);
+  table->natoms = i + 1;
+
+  return i;
+}
+
+static YICES_THREAD_LOCAL sidlatom_hobj_t atom_hobj = {
+  { (hobj_hash_t) hash_atom, (hobj_eq_t) equal_atom, (hobj_build_t) build_atom },
+  NULL,
+  0, 0, 0,
+};
+
+
+/*
+ * Atom constructor: use hash consing
+ * - if the atom is new, create a fresh boolean variable v
+ *   and attach the atom index to v in the core
+ */
+static bvar_t bvar_for_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  int32_t id;
+  sidl_atom_t *atm;
+  bvar_t v;
+
+  atom_hobj.solver = solver;
+  atom_hobj.source = x;
+  atom_hobj.target = y;
+  atom_hobj.cost = d;
+  id = int_htbl_get_obj(&solver->htbl, (int_hobj_t *) &atom_hobj);
+  atm = get_sidl_atom(&solver->atoms, id);
+  v = atm->boolvar;
+  if (v == null_bvar) {
+    v = create_boolean_variable(solver->core);
+    atm->boolvar = v;
+    attach_atom_to_bvar(solver->core, v, (void *) ((size_t) id));
+  }
+  return v;
+}
+
+
+/*
+ * Get literal for atom (x - y <= d)
+ */
+literal_t sidl_make_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  assert(0 <= x && x < solver->vertices.nvertices && 0 <= y && y < solver->vertices.nvertices);
+
+  if (x == y) {
+    return (d >= 0) ? true_literal : false_literal;
+  }
+
+  return pos_lit(bvar_for_atom(solver, x, y, d));
+}
+
+
+
+/**********************
+ *  GRAPH OPERATIONS  *
+ *********************/
+
+/*
+ * Add edge x ---> y of cost d and literal l to the graph
+ * - return the edge index
+ */
+static int32_t sidl_push_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d, literal_t l) {
+  sidl_edge_stack_t *stack;
+  sidl_vertex_t *v;
+  sidl_edge_t *e;
+  uint32_t i;
+
+  stack = &solver->edges;
+  i = stack->top;
+  if (i == stack->size) {
+    extend_sidl_edge_stack(stack);
+  }
+  assert(i < stack->size);
+
+  v = solver->vertices.data;
+  e = stack->data + i;
+  e->source = x;
+  e->target = y;
+  e->cost = d;
+  e->next_out = v[x].first_out;
+  e->next_in = v[y].first_in;
+  v[x].first_out = i;
+  v[y].first_in = i;
+  stack->lit[i] = l;
+  stack->top = i+1;
+
+  return i;
+}
+
+
+/*
+ * Remove all edges of index >= n
+ */
+static void sidl_remove_edges(sidl_solver_t *solver, uint32_t n) {
+  sidl_edge_stack_t *stack;
+  sidl_vertex_t *v;
+  sidl_edge_t *e;
+  uint32_t i;
+
+  stack = &solver->edges;
+  v = solver->vertices.data;
+  i = stack->top;
+  assert(n <= i);
+  while (i > n) {
+    i --;
+    e = stack->data + i;
+    assert(v[e->source].first_out == i && v[e->target].first_in == i);
+    v[e->source].first_out = e->next_out;
+    v[e->target].first_in = e->next_in;
+  }
+  stack->top = n;
+}
+
+
+/*
+ * Get a new search tag
+ */
+static uint32_t sidl_new_search_tag(sidl_solver_t *solver) {
+  sidl_vertex_t *v;
+  uint32_t i, n;
+
+  solver->search_tag ++;
+  if (solver->search_tag == 0) {
+    // wrap around: clear all tags
+    v = solver->vertices.data;
+    n = solver->vertices.nvertices;
+    for (i=0; i<n; i++) {
+      v[i].ftag = 0;
+      v[i].btag = 0;
+    }
+    solver->search_tag = 1;
+  }
+  return solver->search_tag;
+}
+
+
+/*
+ * Push literal l into vector buffer unless it's true_literal
+ */
+static inline void sidl_push_lit(ivector_t *buffer, literal_t l) {
+  if (l != true_literal) {
+    ivector_push(buffer, l);
+  }
+}
+
+
+/*
+ * Try to add edge x ---> y of cost d with explanation l
+ * - the edge is added to the graph then we update the potential
+ *   so that it satisfies the new edge
+ * - if that's not possible, the graph has a negative circuit that
+ *   contains the new edge. Then the literals of all the edges on
+ *   that circuit are stored in solver->expl_buffer, the edge is
+ *   removed, and the function returns false.
+ * - return true if the edge does not cause a conflict
+ *
+ * So the potential is always feasible for all the edges in the graph.
+ */
+static bool sidl_add_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d, literal_t l) {
+  sidl_vertex_t *v;
+  sidl_edge_t *edges;
+  sidl_heap_t *heap;
+  ivector_t *touched;
+  sidl_heap_elem_t top;
+  int64_t delta, pot;
+  int32_t e, i, u, w;
+  uint32_t k, n;
+
+  assert(0 <= x && x < solver->vertices.nvertices && 0 <= y && y < solver->vertices.nvertices);
+
+  e = sidl_push_edge(solver, x, y, d, l);
+
+  v = solver->vertices.data;
+  delta = v[x].pot - v[y].pot - d;
+  if (delta <= 0) {
+    return true;
+  }
+
+  /*
+   * pot[x] must be decreased by delta: we propagate to the
+   * predecessors of x, largest decrease first.
+   */
+  edges = solver->edges.data;
+  heap = &solver->heap;
+  touched = &solver->visited;
+  reset_sidl_heap(heap);
+  ivector_reset(touched);
+
+  v[x].delta = delta;
+  v[x].fpred = e;
+  ivector_push(touched, x);
+  sidl_heap_push(heap, - delta, x);
+
+  while (! sidl_heap_is_empty(heap)) {
+    sidl_heap_pop(heap, &top);
+    u = top.vertex;
+    if (- top.key != v[u].delta) continue; // old copy
+
+    if (u == y) {
+      /*
+       * Negative circuit: y ---> ... ---> x ---> y
+       * the edges are given by the fpred of each vertex
+       */
+      solver->stats.conflicts ++;
+      ivector_reset(&solver->expl_buffer);
+      w = y;
+      do {
+        i = v[w].fpred;
+        sidl_push_lit(&solver->expl_buffer, solver->edges.lit[i]);
+        w = edges[i].target;
+      } while (w != y);
+
+      n = touched->size;
+      for (k=0; k<n; k++) {
+        v[touched->data[k]].delta = 0;
+      }
+      sidl_remove_edges(solver, e);
+      return false;
+    }
+
+    pot = v[u].pot - v[u].delta; // new potential for u
+    for (i = v[u].first_in; i >= 0; i = edges[i].next_in) {
+      w = edges[i].source;
+      // constraint: pot[w] - pot[u] <= cost
+      delta = v[w].pot - pot - edges[i].cost;
+      if (delta > v[w].delta) {
+        if (v[w].delta == 0) {
+          ivector_push(touched, w);
+        }
+        v[w].delta = delta;
+        v[w].fpred = i;
+        sidl_heap_push(heap, - delta, w);
+      }
+    }
+  }
+
+  // commit the new potential
+  n = touched->size;
+  for (k=0; k<n; k++) {
+    u = touched->data[k];
+    v[u].pot -= v[u].delta;
+    v[u].delta = 0;
+  }
+
+  return true;
+}
+
+
+
+/****************
+ *  ASSERTIONS  *
+ ***************/
+
+/*
+ * Assert (x - y <= d) as an axiom:
+ * - attach true_literal to the edge
+ */
+void sidl_add_axiom_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  assert(0 <= x && x < solver->vertices.nvertices && 0 <= y && y < solver->vertices.nvertices);
+  assert(solver->decision_level == solver->base_level);
+
+  // do nothing if the solver is already in an inconsistent state
+  if (solver->unsat_before_search) return;
+
+  if (! sidl_add_edge(solver, x, y, d, true_literal)) {
+    solver->unsat_before_search = true;
+  }
+}
+
+
+/*
+ * Assert (x - y == d) as an axiom: (x - y <= d && y - x <= -d)
+ */
+void sidl_add_axiom_eq(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d) {
+  sidl_add_axiom_edge(solver, x, y, d);
+  sidl_add_axiom_edge(solver, y, x, -d);
+}
+
+
+
+/**************************
+ *   THEORY PROPAGATION   *
+ *************************/
+
+/*
+ * Forward search from y: explore at most max_visits vertices reachable from y
+ * - on exit, all vertices z with ftag == tag are reachable from y and
+ *   fdist[z] + pot[y] - pot[z] is the length of a path from y to z.
+ */
+static void sidl_forward_search(sidl_solver_t *solver, int32_t y, uint32_t tag) {
+  sidl_vertex_t *v;
+  sidl_edge_t *edges;
+  sidl_heap_t *heap;
+  sidl_heap_elem_t top;
+  int64_t k;
+  int32_t i, u, w;
+  uint32_t count;
+
+  v = solver->vertices.data;
+  edges = solver->edges.data;
+  heap = &solver->heap;
+  reset_sidl_heap(heap);
+
+  v[y].ftag = tag;
+  v[y].fdist = 0;
+  v[y].fpred = null_sidl_edge;
+  sidl_heap_push(heap, 0, y);
+
+  count = 0;
+  while (! sidl_heap_is_empty(heap) && count < solver->max_visits) {
+    sidl_heap_pop(heap, &top);
+    u = top.vertex;
+    if (top.key != v[u].fdist) continue;
+    count ++;
+
+    for (i = v[u].first_out; i >= 0; i = edges[i].next_out) {
+      w = edges[i].target;
+      // reduced cost of u ---> w is cost - pot[u] + pot[w] >= 0
+      k = top.key + edges[i].cost - v[u].pot + v[w].pot;
+      assert(k >= top.key);
+      if (v[w].ftag != tag || k < v[w].fdist) {
+        v[w].ftag = tag;
+        v[w].fdist = k;
+        v[w].fpred = i;
+        sidl_heap_push(heap, k, w);
+      }
+    }
+  }
+}
+
+
+/*
+ * Backward search to x: explore at most max_visits vertices that reach x
+ * - all the vertices reached are stored in solver->visited
+ * - for each such vertex z, bdist[z] + pot[z] - pot[x] is the length
+ *   of a path from z to x.
+ */
+static void sidl_backward_search(sidl_solver_t *solver, int32_t x, uint32_t tag) {
+  sidl_vertex_t *v;
+  sidl_edge_t *edges;
+  sidl_heap_t *heap;
+  ivector_t *visited;
+  sidl_heap_elem_t top;
+  int64_t k;
+  int32_t i, u, w;
+  uint32_t count;
+
+  v = solver->vertices.data;
+  edges = solver->edges.data;
+  heap = &solver->heap;
+  visited = &solver->visited;
+  reset_sidl_heap(heap);
+  ivector_reset(visited);
+
+  v[x].btag = tag;
+  v[x].bdist = 0;
+  v[x].bpred = null_sidl_edge;
+  ivector_push(visited, x);
+  sidl_heap_push(heap, 0, x);
+
+  count = 0;
+  while (! sidl_heap_is_empty(heap) && count < solver->max_visits) {
+    sidl_heap_pop(heap, &top);
+    u = top.vertex;
+    if (top.key != v[u].bdist) continue;
+    count ++;
+
+    for (i = v[u].first_in; i >= 0; i = edges[i].next_in) {
+      w = edges[i].source;
+      // reduced cost of w ---> u is cost - pot[w] + pot[u] >= 0
+      k = top.key + edges[i].cost - v[w].pot + v[u].pot;
+      assert(k >= top.key);
+      if (v[w].btag != tag) {
+        v[w].btag = tag;
+        ivector_push(visited, w);
+      } else if (k >= v[w].bdist) {
+        continue;
+      }
+      v[w].bdist = k;
+      v[w].bpred = i;
+      sidl_heap_push(heap, k, w);
+    }
+  }
+}
+
+
+/*
+ * Build the antecedent for a path u ---> x ---> y ---> z
+ * where edge e is x ---> y.
+ * - the path from u to x is given by bpred
+ * - the path from y to z is given by fpred
+ * - return a pointer to a literal array, terminated by null_literal
+ */
+static literal_t *gen_sidl_prop_antecedent(sidl_solver_t *solver, int32_t u, int32_t e, int32_t z) {
+  sidl_vertex_t *v;
+  sidl_edge_t *edges;
+  literal_t *lit;
+  ivector_t *buffer;
+  literal_t *expl;
+  int32_t i, x, y;
+  uint32_t k, n;
+
+  v = solver->vertices.data;
+  edges = solver->edges.data;
+  lit = solver->edges.lit;
+  buffer = &solver->expl_buffer;
+  ivector_reset(buffer);
+
+  x = edges[e].source;
+  y = edges[e].target;
+
+  while (u != x) {
+    i = v[u].bpred;
+    sidl_push_lit(buffer, lit[i]);
+    u = edges[i].target;
+  }
+  sidl_push_lit(buffer, lit[e]);
+  while (z != y) {
+    i = v[z].fpred;
+    sidl_push_lit(buffer, lit[i]);
+    z = edges[i].source;
+  }
+
+  // copy + end marker into the arena
+  n = buffer->size;
+  expl = (literal_t *) arena_alloc(&solver->arena, (n + 1) * sizeof(literal_t));
+  for (k=0; k<n; k++) {
+    expl[k] = buffer->data[k];
+  }
+  expl[k] = null_literal;
+
+  return expl;
+}
+
+
+/*
+ * Theory propagation for the new edge e
+ * - if u ---> x ---> y ---> z is a path of length L (where e is x ---> y)
+ *   then (u - z <= c) is implied if L <= c and (z - u <= c) is false if L + c < 0
+ */
+static void sidl_propagate_edge(sidl_solver_t *solver, int32_t e) {
+  sidl_vertex_t *v;
+  sidl_edge_t *edge;
+  sidl_atbl_t *tbl;
+  sidl_atom_t *atm;
+  ivector_t *visited;
+  literal_t *expl;
+  int64_t du, len;
+  int32_t a, u, z, x, y;
+  uint32_t tag, k, n;
+
+  edge = solver->edges.data + e;
+  x = edge->source;
+  y = edge->target;
+
+  tag = sidl_new_search_tag(solver);
+  sidl_forward_search(solver, y, tag);
+  sidl_backward_search(solver, x, tag);
+  solver->stats.prop_searches ++;
+
+  v = solver->vertices.data;
+  tbl = &solver->atoms;
+  visited = &solver->visited;
+  n = visited->size;
+  for (k=0; k<n; k++) {
+    u = visited->data[k];
+    // du = length of the path from u to x + cost of e
+    du = v[u].bdist + v[u].pot - v[x].pot + edge->cost;
+
+    // atoms (u - z <= c)
+    for (a = v[u].first_src_atom; a >= 0; a = atm->next_src) {
+      atm = get_sidl_atom(tbl, a);
+      z = atm->target;
+      if (v[z].ftag == tag && ! sidl_atom_is_assigned(tbl, a)) {
+        len = du + v[z].fdist + v[y].pot - v[z].pot;
+        if (len <= atm->cost) {
+          expl = gen_sidl_prop_antecedent(solver, u, e, z);
+          mark_sidl_atom_assigned(tbl, a);
+          push_atom_index(&solver->astack, pos_index(a));
+          propagate_literal(solver->core, pos_lit(atm->boolvar), expl);
+          solver->stats.propagations ++;
+        }
+      }
+    }
+
+    // atoms (z - u <= c)
+    for (a = v[u].first_tgt_atom; a >= 0; a = atm->next_tgt) {
+      atm = get_sidl_atom(tbl, a);
+      z = atm->source;
+      if (v[z].ftag == tag && ! sidl_atom_is_assigned(tbl, a)) {
+        len = du + v[z].fdist + v[y].pot - v[z].pot;
+        if (len + atm->cost < 0) {
+          expl = gen_sidl_prop_antecedent(solver, u, e, z);
+          mark_sidl_atom_assigned(tbl, a);
+          push_atom_index(&solver->astack, neg_index(a));
+          propagate_literal(solver->core, neg_lit(atm->boolvar), expl);
+          solver->stats.propagations ++;
+        }
+      }
+    }
+  }
+}
+
+
+
+/********************
+ *  SMT OPERATIONS  *
+ *******************/
+
+/*
+ * Start internalization: do nothing
+ */
+static void sidl_start_internalization(sidl_solver_t *solver) {
+}
+
+
+/*
+ * Start search: if unsat flag is true, force a conflict in the core.
+ */
+void sidl_start_search(sidl_solver_t *solver) {
+  if (solver->unsat_before_search) {
+    record_empty_theory_conflict(solver->core);
+  }
+}
+
+
+/*
+ * Start a new decision level
+ */
+void sidl_increase_decision_level(sidl_solver_t *solver) {
+  // the axioms may be inconsistent on a push (decision_level < base_level)
+  // but not during the search
+  assert(! solver->unsat_before_search || solver->decision_level < solver->base_level);
+  assert(solver->astack.top == solver->astack.prop_ptr);
+
+  push_sidl_undo_record(&solver->stack, solver->edges.top, solver->astack.top);
+  solver->decision_level ++;
+
+  // open new scope in the arena (for storing propagation antecedents)
+  arena_push(&solver->arena);
+}
+
+
+/*
+ * Assert atom: push the atom index in the propagation queue
+ */
+bool sidl_assert_atom(sidl_solver_t *solver, void *a, literal_t l) {
+  int32_t k;
+
+  k = (int32_t) ((size_t) a);
+  assert(var_of(l) == get_sidl_atom(&solver->atoms, k)->boolvar);
+
+  if (! sidl_atom_is_assigned(&solver->atoms, k)) {
+    mark_sidl_atom_assigned(&solver->atoms, k);
+    push_atom_index(&solver->astack, mk_index(k, sign_of_lit(l)));
+  }
+
+  return true;
+}
+
+
+/*
+ * Process all asserted atoms then propagate implied atoms to the core
+ */
+bool sidl_propagate(sidl_solver_t *solver) {
+  uint32_t i, n, e0, e;
+  int32_t k, x, y, d;
+  literal_t l;
+  sidl_atom_t *atom;
+  ivector_t *v;
+
+  e0 = solver->edges.top;
+  n = solver->astack.top;
+  for (i=solver->astack.prop_ptr; i<n; i++) {
+    k = solver->astack.data[i];
+    atom = get_sidl_atom(&solver->atoms, atom_of_index(k));
+    // turn atom or its negation into (x - y <= d)
+    if (is_pos_index(k)) {
+      x = atom->source;
+      y = atom->target;
+      d = atom->cost;
+      l = pos_lit(atom->boolvar);
+    } else {
+      x = atom->target;
+      y = atom->source;
+      d = - atom->cost - 1;
+      l = neg_lit(atom->boolvar);
+    }
+
+    if (! sidl_add_edge(solver, x, y, d, l)) {
+      // conflict: the explanation is in expl_buffer
+      v = &solver->expl_buffer;
+      n = v->size;
+      for (i=0; i<n; i++) {
+        v->data[i] = not(v->data[i]);
+      }
+      ivector_push(v, null_literal);
+      record_theory_conflict(solver->core, v->data);
+      return false;
+    }
+  }
+
+  solver->astack.prop_ptr = n;
+
+  // theory propagation: for all the new edges
+  if (solver->max_visits > 0) {
+    n = solver->edges.top;
+    for (e=e0; e<n; e++) {
+      sidl_propagate_edge(solver, e);
+    }
+    // skip the implied atoms in the next call
+    solver->astack.prop_ptr = solver->astack.top;
+  }
+
+  return true;
+}
+
+
+/*
+ * Final check: do nothing and return SAT
+ */
+fcheck_code_t sidl_final_check(sidl_solver_t *solver) {
+  return FCHECK_SAT;
+}
+
+
+/*
+ * Clear: do nothing
+ */
+static void sidl_clear(sidl_solver_t *solver) {
+}
+
+
+/*
+ * Expand explanation for literal l
+ * - expl is a null-terminated array of literals stored in the arena.
+ */
+void sidl_expand_explanation(sidl_solver_t *solver, literal_t l, literal_t *expl, ivector_t *v) {
+  literal_t x;
+
+  for (;;) {
+    x = *expl ++;
+    if (x == null_literal) break;
+    ivector_push(v, x);
+  }
+}
+
+
+/*
+ * Backtrack to back_level
+ */
+void sidl_backtrack(sidl_solver_t *solver, uint32_t back_level) {
+  sidl_undo_record_t *undo;
+  uint32_t i, n;
+
+  assert(solver->base_level <= back_level && back_level < solver->decision_level);
+
+  assert(back_level + 1 < solver->stack.top);
+  undo = solver->stack.data + back_level + 1;
+
+  // remove all edges of level >= back_level + 1
+  sidl_remove_edges(solver, undo->nedges);
+
+  // unassign the atoms
+  n = undo->natoms;
+  i = solver->astack.top;
+  while (i > n) {
+    i --;
+    mark_sidl_atom_unassigned(&solver->atoms, atom_of_index(solver->astack.data[i]));
+  }
+  solver->astack.top = n;
+  solver->astack.prop_ptr = n;
+
+  // delete all temporary data in the arena
+  i = solver->decision_level;
+  do {
+    arena_pop(&solver->arena);
+    i --;
+  } while (i > back_level);
+
+  solver->stack.top = back_level + 1;
+  solver->decision_level = back_level;
+}
+
+
+/*
+ * Push:
+ * - store current number of vertices and atoms on the trail_stack
+ * - increment both decision level and base level
+ */
+void sidl_push(sidl_solver_t *solver) {
+  assert(solver->base_level == solver->decision_level);
+
+  dl_vartable_push(&solver->vtbl);
+  sidl_trail_stack_save(&solver->trail_stack, solver->vertices.nvertices, solver->atoms.natoms,
+                        solver->unsat_before_search);
+  solver->base_level ++;
+  sidl_increase_decision_level(solver);
+  assert(solver->decision_level == solver->base_level);
+}
+
+
+/*
+ * Pop: remove vertices and atoms created at the current base-level
+ */
+void sidl_pop(sidl_solver_t *solver) {
+  sidl_trail_t *top;
+  sidl_vertex_t *v;
+  sidl_atom_t *a;
+  uint32_t i, h, p;
+
+  assert(solver->base_level > 0 && solver->base_level == solver->decision_level);
+  top = sidl_trail_stack_top(&solver->trail_stack);
+
+  // remove variables
+  dl_vartable_pop(&solver->vtbl);
+
+  // decrement base_level and backtrack: this removes all the edges
+  // created since the matching push
+  solver->base_level --;
+  sidl_backtrack(solver, solver->base_level);
+
+  // all the axioms asserted since the matching push are removed
+  // but the axioms asserted before it may be inconsistent
+  solver->unsat_before_search = top->unsat;
+
+  // remove atoms from the hash table and the atom lists (in reverse order)
+  p = top->natoms;
+  i = solver->atoms.natoms;
+  v = solver->vertices.data;
+  while (i > p) {
+    i --;
+    a = get_sidl_atom(&solver->atoms, i);
+    h = hash_sidl_atom(a->source, a->target, a->cost);
+    int_htbl_erase_record(&solver->htbl, h, i);
+    assert(v[a->source].first_src_atom == i && v[a->target].first_tgt_atom == i);
+    v[a->source].first_src_atom = a->next_src;
+    v[a->target].first_tgt_atom = a->next_tgt;
+  }
+  solver->atoms.natoms = p;
+
+  // restore vertex count
+  solver->vertices.nvertices = top->nvertices;
+  if (solver->zero_vertex >= (int32_t) top->nvertices) {
+    solver->zero_vertex = null_sidl_vertex;
+  }
+
+  sidl_trail_stack_pop(&solver->trail_stack);
+}
+
+
+/*
+ * Reset
+ */
+void sidl_reset(sidl_solver_t *solver) {
+  solver->base_level = 0;
+  solver->decision_level = 0;
+  solver->unsat_before_search = false;
+
+  reset_dl_vartable(&solver->vtbl);
+
+  solver->zero_vertex = null_sidl_vertex;
+  reset_sidl_vtbl(&solver->vertices);
+  reset_sidl_edge_stack(&solver->edges);
+
+  reset_sidl_atbl(&solver->atoms);
+  reset_sidl_astack(&solver->astack);
+  reset_sidl_undo_stack(&solver->stack);
+  reset_sidl_trail_stack(&solver->trail_stack);
+
+  reset_sidl_heap(&solver->heap);
+  solver->search_tag = 0;
+  ivector_reset(&solver->visited);
+
+  reset_int_htbl(&solver->htbl);
+  arena_reset(&solver->arena);
+  ivector_reset(&solver->expl_buffer);
+  ivector_reset(&solver->aux_vector);
+
+  solver->triple.target = nil_vertex;
+  solver->triple.source = nil_vertex;
+  q_clear(&solver->triple.constant);
+  reset_poly_buffer(&solver->buffer);
+
+  if (solver->value != NULL) {
+    safe_free(solver->value);
+    solver->value = NULL;
+  }
+
+  // undo record for level 0
+  push_sidl_undo_record(&solver->stack, 0, 0);
+}
+
+
+/*
+ * THEORY-BRANCHING: use the potential as the current assignment.
+ */
+literal_t sidl_select_polarity(sidl_solver_t *solver, void *a, literal_t l) {
+  sidl_atom_t *atom;
+  sidl_vertex_t *v;
+  bvar_t x;
+
+  x = var_of(l);
+  atom = get_sidl_atom(&solver->atoms, (int32_t) ((size_t) a));
+  assert(atom->boolvar == x);
+
+  v = solver->vertices.data;
+  if (v[atom->source].pot - v[atom->target].pot <= atom->cost) {
+    return pos_lit(x);
+  } else {
+    return neg_lit(x);
+  }
+}
+
+
+
+/**********************
+ *  INTERNALIZATION   *
+ *********************/
+
+/*
+ * Raise exception or abort
+ */
+static __attribute__ ((noreturn)) void sidl_exception(sidl_solver_t *solver, int code) {
+  if (solver->env != NULL) {
+    longjmp(*solver->env, code);
+  }
+  abort();
+}
+
+
+/*
+ * Get the variable for triple (x - y + c)
+ * - x = target vertex
+ * - y = source vertex
+ * - c = constant
+ */
+static thvar_t sidl_var_for_triple(sidl_solver_t *solver, int32_t x, int32_t y, int32_t c) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  triple->target = x;
+  triple->source = y;
+  q_set32(&triple->constant, c);
+
+  return get_dl_var(&solver->vtbl, triple);
+}
+
+
+/*
+ * Apply renaming and substitution to polynomial p
+ * - the result is stored into solver->buffer.
+ */
+static void sidl_rename_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  poly_buffer_t *b;
+  monomial_t *mono;
+  uint32_t i, n;
+
+  b = &solver->buffer;
+  reset_poly_buffer(b);
+
+  n = p->nterms;
+  mono = p->mono;
+
+  // deal with p's constant term if any
+  if (map[0] == null_thvar) {
+    assert(mono[0].var == const_idx);
+    poly_buffer_add_const(b, &mono[0].coeff);
+    n --;
+    map ++;
+    mono ++;
+  }
+
+  for (i=0; i<n; i++) {
+    assert(mono[i].var != const_idx);
+    addmul_dl_var_to_buffer(&solver->vtbl, b, map[i], &mono[i].coeff);
+  }
+
+  normalize_poly_buffer(b);
+}
+
+
+/*
+ * Create the zero_vertex but raise an exception if that fails.
+ */
+static int32_t sidl_get_zero_vertex(sidl_solver_t *solver) {
+  int32_t z;
+
+  z = sidl_zero_vertex(solver);
+  if (z < 0) {
+    sidl_exception(solver, TOO_MANY_ARITH_VARS);
+  }
+  return z;
+}
+
+
+/*
+ * Convert the triple d = (x - y + c) to vertices x, y and constant c
+ * - raise an exception if c doesn't fit in 32bits or if it's INT32_MIN
+ *   (we can't represent -c)
+ * - replace nil vertices by the zero vertex
+ */
+static void sidl_triple_get(sidl_solver_t *solver, dl_triple_t *d, int32_t *x, int32_t *y, int32_t *c) {
+  if (! q_get32(&d->constant, c) || *c == INT32_MIN) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  *x = d->target;
+  *y = d->source;
+  if (*x < 0) {
+    *x = sidl_get_zero_vertex(solver);
+  } else if (*y < 0) {
+    *y = sidl_get_zero_vertex(solver);
+  }
+}
+
+
+/*
+ * Create the atom (x - y + c) == 0 for d = (x - y + c)
+ */
+static literal_t sidl_eq_from_triple(sidl_solver_t *solver, dl_triple_t *d) {
+  literal_t l1, l2;
+  int32_t c, x, y;
+
+  if (d->target == d->source) {
+    return q_is_zero(&d->constant) ? true_literal : false_literal;
+  }
+
+  sidl_triple_get(solver, d, &x, &y, &c);
+  l1 = sidl_make_atom(solver, y, x, c);  // atom (y - x <= c)
+  l2 = sidl_make_atom(solver, x, y, -c); // atom (x - y <= -c)
+  return mk_and_gate2(solver->gate_manager, l1, l2);
+}
+
+
+/*
+ * Create the atom (x - y + c) >= 0 for d = (x - y + c)
+ */
+static literal_t sidl_ge_from_triple(sidl_solver_t *solver, dl_triple_t *d) {
+  int32_t c, x, y;
+
+  if (d->target == d->source) {
+    return q_is_nonneg(&d->constant) ? true_literal : false_literal;
+  }
+
+  sidl_triple_get(solver, d, &x, &y, &c);
+  // (x - y + c >= 0) is (y - x <= c)
+  return sidl_make_atom(solver, y, x, c);
+}
+
+
+/*
+ * Assert (x - y + c) == 0 or (x - y + c) != 0, given a triple d = x - y + c
+ */
+static void sidl_assert_triple_eq(sidl_solver_t *solver, dl_triple_t *d, bool tt) {
+  int32_t x, y, c;
+  literal_t l1, l2;
+
+  if (d->target == d->source) {
+    if (q_is_zero(&d->constant) != tt) {
+      solver->unsat_before_search = true;
+    }
+    return;
+  }
+
+  sidl_triple_get(solver, d, &x, &y, &c);
+  if (tt) {
+    // (x - y + c) == 0 is equivalent to y - x == c
+    sidl_add_axiom_eq(solver, y, x, c);
+  } else {
+    // (x - y + c) != 0 is (not (y - x <= c)) or (not (x - y <= -c))
+    l1 = sidl_make_atom(solver, y, x, c);
+    l2 = sidl_make_atom(solver, x, y, -c);
+    add_binary_clause(solver->core, not(l1), not(l2));
+  }
+}
+
+
+/*
+ * Assert (x - y + c) >= 0 or (x - y + c) < 0, given a triple d = x - y + c
+ */
+static void sidl_assert_triple_ge(sidl_solver_t *solver, dl_triple_t *d, bool tt) {
+  int32_t x, y, c;
+
+  if (d->target == d->source) {
+    if (q_is_nonneg(&d->constant) != tt) {
+      solver->unsat_before_search = true;
+    }
+    return;
+  }
+
+  sidl_triple_get(solver, d, &x, &y, &c);
+  if (tt) {
+    // (x - y + c) >= 0 is equivalent to (y - x <= c)
+    sidl_add_axiom_edge(solver, y, x, c);
+  } else {
+    // (x - y + c) < 0 is equivalent to (x - y <= -c-1)
+    sidl_add_axiom_edge(solver, x, y, -c-1);
+  }
+}
+
+
+/*
+ * TERM CONSTRUCTORS
+ */
+thvar_t sidl_create_var(sidl_solver_t *solver, bool is_int) {
+  int32_t v;
+
+  if (! is_int) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  v = sidl_new_vertex(solver);
+  if (v < 0) {
+    sidl_exception(solver, TOO_MANY_ARITH_VARS);
+  }
+
+  return sidl_var_for_triple(solver, v, nil_vertex, 0);
+}
+
+thvar_t sidl_create_const(sidl_solver_t *solver, rational_t *q) {
+  int32_t c;
+
+  if (! q_get32(q, &c)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return sidl_var_for_triple(solver, nil_vertex, nil_vertex, c);
+}
+
+thvar_t sidl_create_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! convert_poly_buffer_to_dl_triple(&solver->buffer, triple) ||
+      ! q_is_int32(&triple->constant)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+
+  return get_dl_var(&solver->vtbl, triple);
+}
+
+thvar_t sidl_create_pprod(sidl_solver_t *solver, pprod_t *p, thvar_t *map) {
+  sidl_exception(solver, FORMULA_NOT_IDL);
+}
+
+
+/*
+ * ATOM CONSTRUCTORS
+ */
+literal_t sidl_create_eq_atom(sidl_solver_t *solver, thvar_t v) {
+  return sidl_eq_from_triple(solver, dl_var_triple(&solver->vtbl, v));
+}
+
+literal_t sidl_create_ge_atom(sidl_solver_t *solver, thvar_t v) {
+  return sidl_ge_from_triple(solver, dl_var_triple(&solver->vtbl, v));
+}
+
+literal_t sidl_create_vareq_atom(sidl_solver_t *solver, thvar_t v, thvar_t w) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  return sidl_eq_from_triple(solver, triple);
+}
+
+/*
+ * Rename p and convert it to a triple
+ */
+static dl_triple_t *sidl_poly_to_triple(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  dl_triple_t *triple;
+
+  sidl_rename_poly(solver, p, map);
+  triple = &solver->triple;
+  if (! rescale_poly_buffer_to_dl_triple(&solver->buffer, triple)) {
+    sidl_exception(solver, ARITHSOLVER_EXCEPTION);
+  }
+  return triple;
+}
+
+literal_t sidl_create_poly_eq_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  return sidl_eq_from_triple(solver, sidl_poly_to_triple(solver, p, map));
+}
+
+literal_t sidl_create_poly_ge_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map) {
+  return sidl_ge_from_triple(solver, sidl_poly_to_triple(solver, p, map));
+}
+
+
+/*
+ * TOP-LEVEL ASSERTIONS
+ */
+void sidl_assert_eq_axiom(sidl_solver_t *solver, thvar_t v, bool tt) {
+  sidl_assert_triple_eq(solver, dl_var_triple(&solver->vtbl, v), tt);
+}
+
+void sidl_assert_ge_axiom(sidl_solver_t *solver, thvar_t v, bool tt) {
+  sidl_assert_triple_ge(solver, dl_var_triple(&solver->vtbl, v), tt);
+}
+
+void sidl_assert_poly_eq_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt) {
+  sidl_assert_triple_eq(solver, sidl_poly_to_triple(solver, p, map), tt);
+}
+
+void sidl_assert_poly_ge_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt) {
+  sidl_assert_triple_ge(solver, sidl_poly_to_triple(solver, p, map), tt);
+}
+
+void sidl_assert_vareq_axiom(sidl_solver_t *solver, thvar_t v, thvar_t w, bool tt) {
+  dl_triple_t *triple;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  sidl_assert_triple_eq(solver, triple, tt);
+}
+
+
+/*
+ * Assert (c[0] \/ .... \/ c[n-1] \/ v == w)
+ */
+void sidl_assert_clause_vareq_axiom(sidl_solver_t *solver, uint32_t n, literal_t *c, thvar_t v, thvar_t w) {
+  dl_triple_t *triple;
+  ivector_t *aux;
+  int32_t x, y, d;
+  literal_t l1, l2;
+
+  triple = &solver->triple;
+  if (! diff_dl_vars(&solver->vtbl, v, w, triple)) {
+    sidl_exception(solver, FORMULA_NOT_IDL);
+  }
+
+  // v == w is equivalent to (x - y + constant) == 0
+  if (triple->target == triple->source) {
+    if (q_is_nonzero(&triple->constant)) {
+      add_clause(solver->core, n, c);
+    }
+    return;
+  }
+
+  sidl_triple_get(solver, triple, &x, &y, &d);
+
+  /*
+   * Assert two clauses:
+   *  c[0] \/ ... \/ c[n-1] \/ (y - x <= d)
+   *  c[0] \/ ... \/ c[n-1] \/ (x - y <= -d)
+   */
+  l1 = sidl_make_atom(solver, y, x, d);
+  l2 = sidl_make_atom(solver, x, y, -d);
+
+  aux = &solver->aux_vector;
+  assert(aux->size == 0);
+  ivector_copy(aux, c, n);
+  ivector_push(aux, l1);
+  add_clause(solver->core, n+1, aux->data);
+
+  aux->data[n] = l2;
+  add_clause(solver->core, n+1, aux->data);
+
+  ivector_reset(aux);
+}
+
+
+/*
+ * Assert (c ==> v == w)
+ */
+void sidl_assert_cond_vareq_axiom(sidl_solver_t *solver, literal_t c, thvar_t v, thvar_t w) {
+  literal_t nc;
+
+  nc = not(c);
+  sidl_assert_clause_vareq_axiom(solver, 1, &nc, v, w);
+}
+
+
+
+/************************
+ *  MODEL CONSTRUCTION  *
+ ***********************/
+
+#ifndef NDEBUG
+
+/*
+ * For debugging: check that the potential satisfies all the edges
+ */
+static bool good_potential(sidl_solver_t *solver) {
+  sidl_vertex_t *v;
+  sidl_edge_t *e;
+  uint32_t i, n;
+
+  v = solver->vertices.data;
+  n = solver->edges.top;
+  for (i=0; i<n; i++) {
+    e = solver->edges.data + i;
+    if (v[e->source].pot - v[e->target].pot > e->cost) {
+      printf("---> BUG: invalid sparse IDL model: edge %"PRIu32"\n", i);
+      fflush(stdout);
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif
+
+
+/*
+ * Build the model: value[x] = pot[x] - pot[zero]
+ */
+void sidl_build_model(sidl_solver_t *solver) {
+  sidl_vertex_t *v;
+  uint32_t i, n;
+  int64_t offset;
+
+  assert(solver->value == NULL);
+  assert(good_potential(solver));
+
+  n = solver->vertices.nvertices;
+  v = solver->vertices.data;
+  solver->value = (int64_t *) safe_malloc(n * sizeof(int64_t));
+
+  offset = 0;
+  if (solver->zero_vertex >= 0) {
+    offset = v[solver->zero_vertex].pot;
+  }
+  for (i=0; i<n; i++) {
+    solver->value[i] = v[i].pot - offset;
+  }
+}
+
+
+/*
+ * Free the model
+ */
+void sidl_free_model(sidl_solver_t *solver) {
+  assert(solver->value != NULL);
+  safe_free(solver->value);
+  solver->value = NULL;
+}
+
+
+/*
+ * Value of variable x in the model
+ */
+bool sidl_value_in_model(sidl_solver_t *solver, thvar_t x, rational_t *v) {
+  dl_triple_t *d;
+  int64_t aux;
+
+  assert(solver->value != NULL && 0 <= x && x < solver->vtbl.nvars);
+  d = dl_var_triple(&solver->vtbl, x);
+
+  // d is of the form (target - source + constant)
+  aux = 0;
+  if (d->target >= 0) {
+    aux = solver->value[d->target];
+  }
+  if (d->source >= 0) {
+    aux -= solver->value[d->source];
+  }
+
+  q_set64(v, aux);
+  q_add(v, &d->constant);
+
+  return true;
+}
+
+
+/*
+ * Interface function: check whether x is an integer variable.
+ */
+static bool sidl_var_is_integer(sidl_solver_t *solver, thvar_t x) {
+  assert(0 <= x && x < solver->vtbl.nvars);
+  return true;
+}
+
+
+
+/***************************
+ *  INTERFACE DESCRIPTORS  *
+ **************************/
+
+static th_ctrl_interface_t sidl_control = {
+  (start_intern_fun_t) sidl_start_internalization,
+  (start_fun_t) sidl_start_search,
+  (propagate_fun_t) sidl_propagate,
+  (final_check_fun_t) sidl_final_check,
+  (increase_level_fun_t) sidl_increase_decision_level,
+  (backtrack_fun_t) sidl_backtrack,
+  (push_fun_t) sidl_push,
+  (pop_fun_t) sidl_pop,
+  (reset_fun_t) sidl_reset,
+  (clear_fun_t) sidl_clear,
+};
+
+static th_smt_interface_t sidl_smt = {
+  (assert_fun_t) sidl_assert_atom,
+  (expand_expl_fun_t) sidl_expand_explanation,
+  (select_pol_fun_t) sidl_select_polarity,
+  NULL,
+  NULL,
+};
+
+static arith_interface_t sidl_intern = {
+  (create_arith_var_fun_t) sidl_create_var,
+  (create_arith_const_fun_t) sidl_create_const,
+  (create_arith_poly_fun_t) sidl_create_poly,
+  (create_arith_pprod_fun_t) sidl_create_pprod,
+
+  (create_arith_atom_fun_t) sidl_create_eq_atom,
+  (create_arith_atom_fun_t) sidl_create_ge_atom,
+  (create_arith_patom_fun_t) sidl_create_poly_eq_atom,
+  (create_arith_patom_fun_t) sidl_create_poly_ge_atom,
+  (create_arith_vareq_atom_fun_t) sidl_create_vareq_atom,
+
+  (assert_arith_axiom_fun_t) sidl_assert_eq_axiom,
+  (assert_arith_axiom_fun_t) sidl_assert_ge_axiom,
+  (assert_arith_paxiom_fun_t) sidl_assert_poly_eq_axiom,
+  (assert_arith_paxiom_fun_t) sidl_assert_poly_ge_axiom,
+  (assert_arith_vareq_axiom_fun_t) sidl_assert_vareq_axiom,
+  (assert_arith_cond_vareq_axiom_fun_t) sidl_assert_cond_vareq_axiom,
+  (assert_arith_clause_vareq_axiom_fun_t) sidl_assert_clause_vareq_axiom,
+
+  NULL, // attach_eterm is not supported
+  NULL, // eterm of var is not supported
+
+  (build_model_fun_t) sidl_build_model,
+  (free_model_fun_t) sidl_free_model,
+  (arith_val_in_model_fun_t) sidl_value_in_model,
+
+  (arith_var_is_int_fun_t) sidl_var_is_integer,
+};
+
+
+
+/*****************
+ *  FULL SOLVER  *
+ ****************/
+
+void init_sidl_solver(sidl_solver_t *solver, smt_core_t *core, gate_manager_t *gates) {
+  solver->core = core;
+  solver->gate_manager = gates;
+  solver->base_level = 0;
+  solver->decision_level = 0;
+  solver->unsat_before_search = false;
+
+  init_dl_vartable(&solver->vtbl);
+
+  solver->zero_vertex = null_sidl_vertex;
+  init_sidl_vtbl(&solver->vertices, DEFAULT_SIDL_VTBL_SIZE);
+  init_sidl_edge_stack(&solver->edges, DEFAULT_SIDL_EDGE_STACK_SIZE);
+
+  init_sidl_atbl(&solver->atoms, DEFAULT_SIDL_ATBL_SIZE);
+  init_sidl_astack(&solver->astack, DEFAULT_SIDL_ASTACK_SIZE);
+  init_sidl_undo_stack(&solver->stack, DEFAULT_SIDL_UNDO_STACK_SIZE);
+  init_sidl_trail_stack(&solver->trail_stack);
+
+  init_sidl_heap(&solver->heap, DEFAULT_SIDL_HEAP_SIZE);
+  solver->search_tag = 0;
+  init_ivector(&solver->visited, DEFAULT_SIDL_BUFFER_SIZE);
+  solver->max_visits = DEFAULT_SIDL_MAX_VISITS;
+
+  solver->stats.conflicts = 0;
+  solver->stats.prop_searches = 0;
+  solver->stats.propagations = 0;
+
+  init_int_htbl(&solver->htbl, 0);
+  init_arena(&solver->arena);
+  init_ivector(&solver->expl_buffer, DEFAULT_SIDL_BUFFER_SIZE);
+  init_ivector(&solver->aux_vector, DEFAULT_SIDL_BUFFER_SIZE);
+
+  solver->triple.target = nil_vertex;
+  solver->triple.source = nil_vertex;
+  q_init(&solver->triple.constant);
+  init_poly_buffer(&solver->buffer);
+
+  solver->value = NULL;
+  solver->env = NULL;
+
+  // undo record for level 0
+  push_sidl_undo_record(&solver->stack, 0, 0);
+}
+
+
+void delete_sidl_solver(sidl_solver_t *solver) {
+  delete_dl_vartable(&solver->vtbl);
+  delete_sidl_vtbl(&solver->vertices);
+  delete_sidl_edge_stack(&solver->edges);
+  delete_sidl_atbl(&solver->atoms);
+  delete_sidl_astack(&solver->astack);
+  delete_sidl_undo_stack(&solver->stack);
+  delete_sidl_trail_stack(&solver->trail_stack);
+  delete_sidl_heap(&solver->heap);
+  delete_ivector(&solver->visited);
+
+  delete_int_htbl(&solver->htbl);
+  delete_arena(&solver->arena);
+  delete_ivector(&solver->expl_buffer);
+  delete_ivector(&solver->aux_vector);
+
+  q_clear(&solver->triple.constant);
+  delete_poly_buffer(&solver->buffer);
+
+  if (solver->value != NULL) {
+    safe_free(solver->value);
+    solver->value = NULL;
+  }
+}
+
+
+void sidl_solver_init_jmpbuf(sidl_solver_t *solver, jmp_buf *buffer) {
+  solver->env = buffer;
+}
+
+th_ctrl_interface_t *sidl_ctrl_interface(sidl_solver_t *solver) {
+  return &sidl_control;
+}
+
+th_smt_interface_t *sidl_smt_interface(sidl_solver_t *solver) {
+  return &sidl_smt;
+}
+
+arith_interface_t *sidl_arith_interface(sidl_solver_t *solver) {
+  return &sidl_intern;
+}
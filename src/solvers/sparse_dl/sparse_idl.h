@@ -0,0 +1,576 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SPARSE SOLVER FOR INTEGER DIFFERENCE LOGIC
+ */
+
+/*
+ * This solver is an alternative to the Floyd-Warshall solver in
+ * idl_floyd_warshall.h. It supports the same internalization
+ * interface, but it does not store a dense distance matrix, so it
+ * can deal with problems that have many variables.
+ *
+ * Like the Floyd-Warshall solver, it's for integer difference logic
+ * only and it cannot be attached to the egraph.
+ *
+ * Graph representation
+ * - edges are stored in a stack (added and removed in FIFO order)
+ * - each edge has source and destination vertices and an integer cost
+ * - an edge from x to y of cost d encodes the assertion (x - y <= d)
+ * - each vertex x has a list of outgoing edges (edges of source x)
+ *   and a list of incoming edges (edges of target x). The lists are
+ *   linked through the edge stack: edges are always added and removed
+ *   at the front of the lists.
+ *
+ * Consistency check
+ * - we maintain a potential function pot such that for every edge
+ *   x ---> y of cost d, we have pot[x] - pot[y] <= d
+ * - when an edge x ---> y is added and violates this constraint, we
+ *   decrease pot[x] then propagate the changes to the predecessors
+ *   of x. This is done using Dijkstra's algorithm on the reduced
+ *   costs (cf. Cotton & Maler, Fast and Flexible Difference
+ *   Constraint Propagation for DPLL(T), SAT 2006).
+ * - if y must be decreased then the graph has a negative circuit.
+ * - the potential is not restored on backtracking: a potential that
+ *   satisfies a set of edges also satisfies any subset.
+ * - the potential gives a model.
+ *
+ * Theory propagation
+ * - after an edge x ---> y is added, we explore a bounded number of
+ *   vertices backward from x and forward from y. If u reaches x and y
+ *   reaches v, we check the atoms (u - v <= c) and (v - u <= c) that
+ *   are not assigned.
+ */
+
+#ifndef __SPARSE_IDL_H
+#define __SPARSE_IDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <setjmp.h>
+
+#include "context/context_types.h"
+#include "solvers/cdcl/smt_core.h"
+#include "solvers/floyd_warshall/dl_vartable.h"
+#include "terms/poly_buffer.h"
+#include "utils/arena.h"
+#include "utils/bitvectors.h"
+#include "utils/int_hash_tables.h"
+#include "utils/int_vectors.h"
+
+
+/***********
+ *  GRAPH  *
+ **********/
+
+/*
+ * Edge and vertex indices = signed 32 bit integers
+ * - null_sidl_edge = -1 is used as end-of-list marker
+ */
+enum {
+  null_sidl_edge = -1,
+  null_sidl_vertex = -1,
+};
+
+
+/*
+ * Edge descriptor
+ * - next_out = next edge in the list of outgoing edges of source
+ * - next_in = next edge in the list of incoming edges of target
+ */
+typedef struct sidl_edge_s {
+  int32_t source;
+  int32_t target;
+  int32_t cost;
+  int32_t next_out;
+  int32_t next_in;
+} sidl_edge_t;
+
+
+/*
+ * Stack of edges + a literal for each edge
+ * - for edge i: lit[i] == true_literal if i was asserted as an axiom
+ * - otherwise lit[i] = a literal l in the smt_core, such that l is true
+ *   and l is attached to an idl atom
+ */
+typedef struct sidl_edge_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_edge_t *data;
+  literal_t *lit;
+} sidl_edge_stack_t;
+
+#define DEFAULT_SIDL_EDGE_STACK_SIZE 100
+#define MAX_SIDL_EDGE_STACK_SIZE (UINT32_MAX/sizeof(sidl_edge_t))
+
+
+/*
+ * Vertex descriptor
+ * - first_out = first outgoing edge
+ * - first_in = first incoming edge
+ * - first_src_atom = first atom whose source is this vertex
+ * - first_tgt_atom = first atom whose target is this vertex
+ * - pot = potential
+ *
+ * The other fields are used by the search procedures:
+ * - delta = how much pot must be decreased (when adding an edge)
+ * - fdist/bdist = reduced distance computed by the forward/backward search
+ * - fpred/bpred = edge used to reach the vertex in that search
+ * - ftag/btag = search identifier: fdist and fpred are valid for the
+ *   current search if ftag == solver->search_tag (same for bdist, bpred)
+ */
+typedef struct sidl_vertex_s {
+  int32_t first_out;
+  int32_t first_in;
+  int32_t first_src_atom;
+  int32_t first_tgt_atom;
+  int64_t pot;
+  int64_t delta;
+  int64_t fdist;
+  int64_t bdist;
+  int32_t fpred;
+  int32_t bpred;
+  uint32_t ftag;
+  uint32_t btag;
+} sidl_vertex_t;
+
+
+/*
+ * Vertex table
+ */
+typedef struct sidl_vtbl_s {
+  uint32_t size;
+  uint32_t nvertices;
+  sidl_vertex_t *data;
+} sidl_vtbl_t;
+
+#define DEFAULT_SIDL_VTBL_SIZE 100
+#define MAX_SIDL_VTBL_SIZE (UINT32_MAX/sizeof(sidl_vertex_t))
+
+
+/*
+ * Priority queue used in the search procedures:
+ * - elements are pairs (key, vertex), the smallest key is at the top
+ * - a vertex may occur several times (old copies are skipped)
+ */
+typedef struct sidl_heap_elem_s {
+  int64_t key;
+  int32_t vertex;
+} sidl_heap_elem_t;
+
+typedef struct sidl_heap_s {
+  uint32_t size;
+  uint32_t nelems;
+  sidl_heap_elem_t *data;
+} sidl_heap_t;
+
+#define DEFAULT_SIDL_HEAP_SIZE 100
+#define MAX_SIDL_HEAP_SIZE (UINT32_MAX/sizeof(sidl_heap_elem_t))
+
+
+
+/***********
+ *  ATOMS  *
+ **********/
+
+/*
+ * Each atom has an index i (in the global atom table)
+ * - the atom includes <source vertex, target vertex, cost, boolean variable>
+ * - if atom->boolvar = v then the atom index is attached to v in the smt_core
+ * - next_src = next atom with the same source vertex
+ * - next_tgt = next atom with the same target vertex
+ */
+typedef struct sidl_atom_s {
+  int32_t source;
+  int32_t target;
+  int32_t cost;
+  bvar_t boolvar;
+  int32_t next_src;
+  int32_t next_tgt;
+} sidl_atom_t;
+
+
+/*
+ * Atom table:
+ * - mark = one bit per atom: 1 means that the atom is assigned
+ */
+typedef struct sidl_atbl_s {
+  uint32_t size;
+  uint32_t natoms;
+  sidl_atom_t *atoms;
+  byte_t *mark;
+} sidl_atbl_t;
+
+/*
+ * Atom stack & propagation queue: same encoding as in the Floyd-Warshall solver
+ * - data[k] = atom index + sign bit (0 means true, 1 means false)
+ * - the propagation queue consists of the atoms in data[prop_ptr ... top-1]
+ */
+typedef struct sidl_astack_s {
+  uint32_t size;
+  uint32_t top;
+  uint32_t prop_ptr;
+  int32_t *data;
+} sidl_astack_t;
+
+
+#define DEFAULT_SIDL_ATBL_SIZE 100
+#define MAX_SIDL_ATBL_SIZE (UINT32_MAX/sizeof(sidl_atom_t))
+
+#define DEFAULT_SIDL_ASTACK_SIZE 100
+#define MAX_SIDL_ASTACK_SIZE (UINT32_MAX/sizeof(int32_t))
+
+
+
+/****************
+ *  UNDO STACK  *
+ ***************/
+
+/*
+ * For backtracking: on entry to each decision level k we store:
+ * - nedges = number of edges in the graph
+ * - natoms = number of atoms in the atom stack
+ */
+typedef struct sidl_undo_record_s {
+  uint32_t nedges;
+  uint32_t natoms;
+} sidl_undo_record_t;
+
+typedef struct sidl_undo_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_undo_record_t *data;
+} sidl_undo_stack_t;
+
+#define DEFAULT_SIDL_UNDO_STACK_SIZE 100
+#define MAX_SIDL_UNDO_STACK_SIZE (UINT32_MAX/sizeof(sidl_undo_record_t))
+
+
+
+/******************
+ * PUSH/POP STACK *
+ *****************/
+
+/*
+ * For each base level, we keep the number of vertices and atoms
+ * on entry to that level, and the unsat_before_search flag.
+ */
+typedef struct sidl_trail_s {
+  uint32_t nvertices;
+  uint32_t natoms;
+  bool unsat;
+} sidl_trail_t;
+
+typedef struct sidl_trail_stack_s {
+  uint32_t size;
+  uint32_t top;
+  sidl_trail_t *data;
+} sidl_trail_stack_t;
+
+#define DEFAULT_SIDL_TRAIL_SIZE  20
+#define MAX_SIDL_TRAIL_SIZE (UINT32_MAX/sizeof(sidl_trail_t))
+
+
+
+/*******************
+ *  SPARSE SOLVER  *
+ ******************/
+
+/*
+ * Statistics
+ */
+typedef struct sidl_stats_s {
+  uint32_t conflicts;      // number of negative circuits found
+  uint32_t prop_searches;  // number of bounded searches for theory propagation
+  uint32_t propagations;   // number of atoms propagated
+} sidl_stats_t;
+
+
+typedef struct sidl_solver_s {
+  /*
+   * Attached smt core + gate manager
+   */
+  smt_core_t *core;
+  gate_manager_t *gate_manager;
+
+  /*
+   * Base level and decision level (same interpretation as in smt_core)
+   */
+  uint32_t base_level;
+  uint32_t decision_level;
+
+  /*
+   * Unsat flag: set to true if the asserted axioms are inconsistent
+   */
+  bool unsat_before_search;
+
+  /*
+   * Variable table: maps variables to triples (x - y + c)
+   */
+  dl_vartable_t vtbl;
+
+  /*
+   * Graph
+   */
+  int32_t zero_vertex;
+  sidl_vtbl_t vertices;
+  sidl_edge_stack_t edges;
+
+  /*
+   * Atom table and stack
+   */
+  sidl_atbl_t atoms;
+  sidl_astack_t astack;
+
+  /*
+   * Backtracking stack and push/pop stack
+   */
+  sidl_undo_stack_t stack;
+  sidl_trail_stack_t trail_stack;
+
+  /*
+   * Search data:
+   * - heap = priority queue
+   * - search_tag = identifier of the current search
+   * - visited = vertices reached by the backward search
+   * - max_visits = bound on the number of vertices explored in each
+   *   direction for theory propagation (0 means no propagation)
+   */
+  sidl_heap_t heap;
+  uint32_t search_tag;
+  ivector_t visited;
+  uint32_t max_visits;
+
+  /*
+   * Statistics
+   */
+  sidl_stats_t stats;
+
+  /*
+   * Auxiliary buffers and data structures
+   */
+  int_htbl_t htbl;        // for hash-consing of atoms
+  arena_t arena;          // for storing explanations of implied atoms
+  ivector_t expl_buffer;  // for constructing explanations
+  ivector_t aux_vector;   // general-purpose vector
+
+  dl_triple_t triple;     // for variable construction
+  poly_buffer_t buffer;   // for internal polynomial operations
+
+  /*
+   * Variable assignment: allocated when needed in build_model
+   */
+  int64_t *value;
+
+  /*
+   * Jump buffer for exception handling during internalization
+   */
+  jmp_buf *env;
+} sidl_solver_t;
+
+
+/*
+ * Maximal number of vertices
+ */
+#define MAX_SIDL_VERTICES MAX_SIDL_VTBL_SIZE
+
+/*
+ * Default bound on the search for theory propagation
+ */
+#define DEFAULT_SIDL_MAX_VISITS 32
+
+#define DEFAULT_SIDL_BUFFER_SIZE 20
+
+
+
+/*********************
+ *  MAIN OPERATIONS  *
+ ********************/
+
+/*
+ * Initialize a sparse idl solver
+ * - core = the attached smt-core object
+ * - gates = the attached gate manager
+ */
+extern void init_sidl_solver(sidl_solver_t *solver, smt_core_t *core, gate_manager_t *gates);
+
+/*
+ * Attach a jump buffer for internalization exception
+ */
+extern void sidl_solver_init_jmpbuf(sidl_solver_t *solver, jmp_buf *buffer);
+
+/*
+ * Delete: free all allocated memory
+ */
+extern void delete_sidl_solver(sidl_solver_t *solver);
+
+/*
+ * Get interface descriptors to attach solver to a core
+ */
+extern th_ctrl_interface_t *sidl_ctrl_interface(sidl_solver_t *solver);
+extern th_smt_interface_t  *sidl_smt_interface(sidl_solver_t *solver);
+
+/*
+ * Get interface descriptor for the internalization functions.
+ */
+extern arith_interface_t *sidl_arith_interface(sidl_solver_t *solver);
+
+
+
+/******************************
+ *  VERTEX AND ATOM CREATION  *
+ *****************************/
+
+/*
+ * Create a new vertex
+ * - return null_sidl_vertex if there are too many vertices
+ */
+extern int32_t sidl_new_vertex(sidl_solver_t *solver);
+
+/*
+ * Return the zero_vertex (create it if needed)
+ * - return null_sidl_vertex if the vertex can't be created
+ */
+extern int32_t sidl_zero_vertex(sidl_solver_t *solver);
+
+/*
+ * Create the atom (x - y <= d) and return the corresponding literal
+ * - x and y must be vertices in the solver
+ */
+extern literal_t sidl_make_atom(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+/*
+ * Assert (x - y <= d) as an axiom
+ * - the solver must be at base level
+ * - if the edge causes a conflict, then solver->unsat_before_search is set to true
+ */
+extern void sidl_add_axiom_edge(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+/*
+ * Assert (x - y == d) as an axiom
+ */
+extern void sidl_add_axiom_eq(sidl_solver_t *solver, int32_t x, int32_t y, int32_t d);
+
+
+
+/*******************************
+ *  INTERNALIZATION FUNCTIONS  *
+ ******************************/
+
+/*
+ * These functions form the arith_interface descriptor. They
+ * have the same specification as the Floyd-Warshall versions.
+ */
+extern thvar_t sidl_create_var(sidl_solver_t *solver, bool is_int);
+extern thvar_t sidl_create_const(sidl_solver_t *solver, rational_t *q);
+extern thvar_t sidl_create_poly(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern thvar_t sidl_create_pprod(sidl_solver_t *solver, pprod_t *p, thvar_t *map);
+
+extern literal_t sidl_create_eq_atom(sidl_solver_t *solver, thvar_t x);
+extern literal_t sidl_create_ge_atom(sidl_solver_t *solver, thvar_t x);
+extern literal_t sidl_create_poly_eq_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern literal_t sidl_create_poly_ge_atom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map);
+extern literal_t sidl_create_vareq_atom(sidl_solver_t *solver, thvar_t x, thvar_t y);
+
+extern void sidl_assert_eq_axiom(sidl_solver_t *solver, thvar_t x, bool tt);
+extern void sidl_assert_ge_axiom(sidl_solver_t *solver, thvar_t x, bool tt);
+extern void sidl_assert_poly_eq_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt);
+extern void sidl_assert_poly_ge_axiom(sidl_solver_t *solver, polynomial_t *p, thvar_t *map, bool tt);
+extern void sidl_assert_vareq_axiom(sidl_solver_t *solver, thvar_t x, thvar_t y, bool tt);
+extern void sidl_assert_cond_vareq_axiom(sidl_solver_t *solver, literal_t c, thvar_t x, thvar_t y);
+extern void sidl_assert_clause_vareq_axiom(sidl_solver_t *solver, uint32_t n, literal_t *c, thvar_t x, thvar_t y);
+
+
+
+/**********************
+ *  SOLVER FUNCTIONS  *
+ *********************/
+
+/*
+ * These functions form the th_ctrl and th_smt interfaces.
+ */
+extern void sidl_start_search(sidl_solver_t *solver);
+extern void sidl_increase_decision_level(sidl_solver_t *solver);
+extern void sidl_backtrack(sidl_solver_t *solver, uint32_t back_level);
+extern void sidl_push(sidl_solver_t *solver);
+extern void sidl_pop(sidl_solver_t *solver);
+extern void sidl_reset(sidl_solver_t *solver);
+
+extern bool sidl_assert_atom(sidl_solver_t *solver, void *atom, literal_t l);
+extern bool sidl_propagate(sidl_solver_t *solver);
+extern literal_t sidl_select_polarity(sidl_solver_t *solver, void *atom, literal_t l);
+extern fcheck_code_t sidl_final_check(sidl_solver_t *solver);
+extern void sidl_expand_explanation(sidl_solver_t *solver, literal_t l, literal_t *expl, ivector_t *v);
+
+
+
+/************************
+ *  MODEL CONSTRUCTION  *
+ ***********************/
+
+/*
+ * Build a model: copy the potential into solver->value
+ * - the zero vertex has value 0 (if it exists)
+ */
+extern void sidl_build_model(sidl_solver_t *solver);
+
+/*
+ * Value of variable v in the model
+ * - copy the value in rational q and return true
+ */
+extern bool sidl_value_in_model(sidl_solver_t *solver, thvar_t v, rational_t *q);
+
+/*
+ * Free the model
+ */
+extern void sidl_free_model(sidl_solver_t *solver);
+
+
+
+/*****************
+ *  STATISTICS   *
+ ****************/
+
+static inline uint32_t sidl_num_vars(sidl_solver_t *solver) {
+  return solver->vtbl.nvars;
+}
+
+static inline uint32_t sidl_num_atoms(sidl_solver_t *solver) {
+  return solver->atoms.natoms;
+}
+
+static inline uint32_t sidl_num_vertices(sidl_solver_t *solver) {
+  return solver->vertices.nvertices;
+}
+
+static inline uint32_t sidl_num_edges(sidl_solver_t *solver) {
+  return solver->edges.top;
+}
+
+static inline uint32_t sidl_num_conflicts(sidl_solver_t *solver) {
+  return solver->stats.conflicts;
+}
+
+static inline uint32_t sidl_num_propagations(sidl_solver_t *solver) {
+  return solver->stats.propagations;
+}
+
+
+#endif /* __SPARSE_IDL_H */
@@ -33,6 +33,7 @@
 #include "utils/hash_functions.h"
 #include "utils/memalloc.h"
 #include "utils/object_stores.h"
+#include "utils/yices_locks.h"
 
 
 
@@ -73,9 +74,10 @@ typedef struct {
 
 
 /*
- * Global allocator
+ * Global allocator + lock for the thread-safe build
  */
 static bvconst_allocator_t allocator;
+static yices_lock_t allocator_lock;
 
 
 /*
@@ -170,6 +172,7 @@ static void delete_allocator(bvconst_allocator_t *s) {
  */
 void init_bvconstants(void) {
   init_allocator(&allocator);
+  create_yices_lock(&allocator_lock);
 }
 
 /*
@@ -177,20 +180,29 @@ void init_bvconstants(void) {
  */
 void cleanup_bvconstants(void) {
   delete_allocator(&allocator);
+  destroy_yices_lock(&allocator_lock);
 }
 
 /*
  * Allocate a vector of k words.
  */
 uint32_t *bvconst_alloc(uint32_t k) {
-  return alloc_vector(&allocator, k);
+  uint32_t *bv;
+
+  get_yices_lock(&allocator_lock);
+  bv = alloc_vector(&allocator, k);
+  release_yices_lock(&allocator_lock);
+
+  return bv;
 }
 
 /*
  * Free vector bv of size k.
  */
 void bvconst_free(uint32_t *bv, uint32_t k) {
+  get_yices_lock(&allocator_lock);
   free_vector(&allocator, bv, k);
+  release_yices_lock(&allocator_lock);
 }
 
 
@@ -1184,6 +1196,111 @@ void bvconst_concat(uint32_t *bv, uint32_t *a, uint32_t n, uint32_t *b, uint32_t
 }
 
 
+/*
+ * FAST PATHS
+ *
+ * If the compiler supports 128bit integers:
+ * - constants of at most 4 words (128 bits) are converted to a single
+ *   unsigned __int128 for multiplication, division, and remainder.
+ * - larger constants are multiplied using 64bit limbs and 128bit products
+ *   (i.e., a quarter of the 32bit multiplications of the generic code).
+ */
+#if defined(__SIZEOF_INT128__)
+
+#define BVCONST_HAS_INT128 1
+
+typedef unsigned __int128 word128_t;
+
+/*
+ * Conversion between a[0 ... k-1] and a 128bit integer (k <= 4)
+ */
+static inline word128_t bvconst_get128(const uint32_t *a, uint32_t k) {
+  uint64_t lo, hi;
+
+  assert(0 < k && k <= 4);
+  lo = a[0];
+  hi = 0;
+  if (k > 1) lo |= ((uint64_t) a[1]) << 32;
+  if (k > 2) hi = a[2];
+  if (k > 3) hi |= ((uint64_t) a[3]) << 32;
+
+  return (((word128_t) hi) << 64) | lo;
+}
+
+static inline void bvconst_set128(uint32_t *a, uint32_t k, word128_t w) {
+  uint64_t lo, hi;
+
+  assert(0 < k && k <= 4);
+  lo = (uint64_t) w;
+  hi = (uint64_t) (w >> 64);
+  a[0] = (uint32_t) lo;
+  if (k > 1) a[1] = (uint32_t) (lo >> 32);
+  if (k > 2) a[2] = (uint32_t) hi;
+  if (k > 3) a[3] = (uint32_t) (hi >> 32);
+}
+
+/*
+ * Conversion between a[0 ... k-1] and 64bit limbs l[0 ... (k+1)/2 - 1]
+ */
+static void bvconst_get_limbs(uint64_t *l, const uint32_t *a, uint32_t k) {
+  uint32_t i;
+
+  for (i=0; i+1<k; i += 2) {
+    *l ++ = ((uint64_t) a[i]) | (((uint64_t) a[i+1]) << 32);
+  }
+  if (i < k) {
+    *l = (uint64_t) a[i];
+  }
+}
+
+static void bvconst_set_limbs(uint32_t *a, uint32_t k, const uint64_t *l) {
+  uint32_t i;
+
+  for (i=0; i+1<k; i += 2) {
+    a[i] = (uint32_t) *l;
+    a[i+1] = (uint32_t) (*l >> 32);
+    l ++;
+  }
+  if (i < k) {
+    a[i] = (uint32_t) *l;
+  }
+}
+
+/*
+ * bv := bv + a1 * a2 using 64bit limbs (modulo 2^(32k))
+ */
+static void bvconst_addmul_limbs(uint32_t *bv, uint32_t k, const uint32_t *a1, const uint32_t *a2) {
+  uint32_t i, j, nl;
+  uint64_t f, carry;
+  word128_t t;
+
+  nl = (k + 1) >> 1;
+
+  uint64_t x[nl]; // Warning: this is a GCC extension of C (as in bvconst_mul)
+  uint64_t y[nl];
+  uint64_t z[nl];
+
+  bvconst_get_limbs(x, a1, k);
+  bvconst_get_limbs(y, a2, k);
+  bvconst_get_limbs(z, bv, k);
+
+  for (i=0; i<nl; i++) {
+    f = x[i];
+    if (f == 0) continue;
+    carry = 0;
+    for (j=0; i+j<nl; j++) {
+      t = ((word128_t) f) * y[j] + z[i+j] + carry;
+      z[i+j] = (uint64_t) t;
+      carry = (uint64_t) (t >> 64);
+    }
+  }
+
+  bvconst_set_limbs(bv, k, z);
+}
+
+#endif
+
+
 /*
  * Arithmetic operations
  */
@@ -1317,6 +1434,19 @@ void bvconst_sub2(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
 
 
 // bv := bv + a1 * a2
+#ifdef BVCONST_HAS_INT128
+
+void bvconst_addmul(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
+  assert (k > 0);
+  if (k <= 4) {
+    bvconst_set128(bv, k, bvconst_get128(bv, k) + bvconst_get128(a1, k) * bvconst_get128(a2, k));
+  } else {
+    bvconst_addmul_limbs(bv, k, a1, a2);
+  }
+}
+
+#else
+
 void bvconst_addmul(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
   uint64_t aux, f;
   uint32_t j;
@@ -1336,6 +1466,8 @@ void bvconst_addmul(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
   } while (k > 0);
 }
 
+#endif
+
 // bv := bv - a1 * a2
 void bvconst_submul(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
   assert (k > 0);
@@ -1358,12 +1490,25 @@ void bvconst_submul(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
 
 // bv := a1 * a2
 void bvconst_mul2(uint32_t *bv, uint32_t k, uint32_t *a1, uint32_t *a2) {
+#ifdef BVCONST_HAS_INT128
+  if (k <= 4) {
+    bvconst_set128(bv, k, bvconst_get128(a1, k) * bvconst_get128(a2, k));
+    return;
+  }
+#endif
   bvconst_clear(bv, k);
   bvconst_addmul(bv, k, a1, a2);
 }
 
 // bv := bv * a
 void bvconst_mul(uint32_t *bv, uint32_t k, uint32_t *a) {
+#ifdef BVCONST_HAS_INT128
+  if (k <= 4) {
+    bvconst_set128(bv, k, bvconst_get128(bv, k) * bvconst_get128(a, k));
+    return;
+  }
+#endif
+
   uint32_t tmp[k]; // Warning: this is a GCC extension of C. Dangerous is k is large
 
   bvconst_set(tmp, k, bv);
@@ -1727,6 +1872,38 @@ static void mpz2bv(uint32_t *a, uint32_t n, mpz_t z) {
 }
 
 
+#ifdef BVCONST_HAS_INT128
+
+/*
+ * Fast path for n <= 128
+ * - mask128(n) = 2^n - 1
+ * - abs128(a, n, &neg) = absolute value of a interpreted as a signed
+ *   n-bit integer; neg is set to true if a is negative
+ * - store128(bv, n, w): bv := w modulo 2^n
+ */
+static inline word128_t bvconst_mask128(uint32_t n) {
+  assert(0 < n && n <= 128);
+  return n == 128 ? ~((word128_t) 0) : (((word128_t) 1) << n) - 1;
+}
+
+static word128_t bvconst_abs128(const uint32_t *a, uint32_t n, bool *neg) {
+  word128_t w;
+
+  w = bvconst_get128(a, (n + 31) >> 5);
+  *neg = bvconst_tst_bit(a, n-1);
+  if (*neg) {
+    w = (- w) & bvconst_mask128(n);
+  }
+  return w;
+}
+
+static inline void bvconst_store128(uint32_t *bv, uint32_t n, word128_t w) {
+  bvconst_set128(bv, (n + 31) >> 5, w & bvconst_mask128(n));
+}
+
+#endif
+
+
 /*
  * Division and remainder
  * - a1 and a2 must be normalized
@@ -1741,6 +1918,10 @@ void bvconst_udiv2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
   assert(n > 0);
   if (n <= 32) {
     *bv = (*a1) / (*a2);
+#ifdef BVCONST_HAS_INT128
+  } else if (n <= 128) {
+    bvconst_store128(bv, n, bvconst_get128(a1, (n + 31) >> 5) / bvconst_get128(a2, (n + 31) >> 5));
+#endif
   } else {
     unsigned_bv2mpz(z1, n, a1);
     unsigned_bv2mpz(z2, n, a2);
@@ -1758,6 +1939,10 @@ void bvconst_urem2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
   assert(n > 0);
   if (n <= 32) {
     *bv = (*a1) % (*a2);
+#ifdef BVCONST_HAS_INT128
+  } else if (n <= 128) {
+    bvconst_store128(bv, n, bvconst_get128(a1, (n + 31) >> 5) % bvconst_get128(a2, (n + 31) >> 5));
+#endif
   } else {
     unsigned_bv2mpz(z1, n, a1);
     unsigned_bv2mpz(z2, n, a2);
@@ -1772,6 +1957,20 @@ void bvconst_urem2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
 void bvconst_sdiv2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
   mpz_t z1, z2;
 
+#ifdef BVCONST_HAS_INT128
+  if (n <= 128) {
+    word128_t w1, w2, q;
+    bool neg1, neg2;
+
+    w1 = bvconst_abs128(a1, n, &neg1);
+    w2 = bvconst_abs128(a2, n, &neg2);
+    q = w1 / w2;
+    if (neg1 != neg2) q = - q;
+    bvconst_store128(bv, n, q);
+    return;
+  }
+#endif
+
   signed_bv2mpz(z1, n, a1);
   signed_bv2mpz(z2, n, a2);
   mpz_tdiv_q(z1, z1, z2); // z1 := z1 div z2, rounding towards 0
@@ -1784,6 +1983,20 @@ void bvconst_sdiv2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
 void bvconst_srem2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
   mpz_t z1, z2;
 
+#ifdef BVCONST_HAS_INT128
+  if (n <= 128) {
+    word128_t w1, w2, r;
+    bool neg1, neg2;
+
+    w1 = bvconst_abs128(a1, n, &neg1);
+    w2 = bvconst_abs128(a2, n, &neg2);
+    r = w1 % w2;
+    if (neg1) r = - r; // same sign as a1
+    bvconst_store128(bv, n, r);
+    return;
+  }
+#endif
+
   signed_bv2mpz(z1, n, a1);
   signed_bv2mpz(z2, n, a2);
   mpz_tdiv_r(z1, z1, z2); // z1 := remainder of z1 div z2, rounding towards 0
@@ -1796,6 +2009,24 @@ void bvconst_srem2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
 void bvconst_smod2(uint32_t *bv, uint32_t n, uint32_t *a1, uint32_t *a2) {
   mpz_t z1, z2;
 
+#ifdef BVCONST_HAS_INT128
+  if (n <= 128) {
+    word128_t w1, w2, r;
+    bool neg1, neg2;
+
+    w1 = bvconst_abs128(a1, n, &neg1);
+    w2 = bvconst_abs128(a2, n, &neg2);
+    r = w1 % w2;
+    if (r != 0) {
+      // same sign as a2
+      if (neg1 != neg2) r = w2 - r;
+      if (neg2) r = - r;
+    }
+    bvconst_store128(bv, n, r);
+    return;
+  }
+#endif
+
   signed_bv2mpz(z1, n, a1);
   signed_bv2mpz(z2, n, a2);
   mpz_fdiv_r(z1, z1, z2); // z1 := remainder of z1 div z2, rounding towards - infinity
@@ -27,12 +27,16 @@
 #include <gmp.h>
 
 #include "terms/mpq_aux.h"
+#include "utils/yices_locks.h"
 
 
 /*
  * Global variable for intermediate computations.
+ * This is used only if longs are 32 bits. It's protected
+ * by z0_lock in the thread-safe build.
  */
 static mpz_t z0;
+static yices_lock_t z0_lock;
 
 
 /*
@@ -75,6 +79,7 @@ void init_mpq_aux(void) {
   }
 
   mpz_init(z0);
+  create_yices_lock(&z0_lock);
 
 #ifdef DEBUG
   mpq_init(check);
@@ -88,6 +93,7 @@ void init_mpq_aux(void) {
  */
 void cleanup_mpq_aux(void) {
   mpz_clear(z0);
+  destroy_yices_lock(&z0_lock);
 
 #ifdef DEBUG
   mpq_clear(check);
@@ -115,6 +121,18 @@ void mpq_init2(mpq_t q, unsigned long n) {
 
 
 
+/*
+ * Add or subtract b * abs_num to a
+ */
+static inline void addmul_si(mpz_t a, const mpz_t b, unsigned long abs_num, bool neg) {
+  if (neg) {
+    mpz_submul_ui(a, b, abs_num);
+  } else {
+    mpz_addmul_ui(a, b, abs_num);
+  }
+}
+
+
 /*
  * Add rational num/den to q.
  * - den must be non zero
@@ -123,7 +141,7 @@ void mpq_init2(mpq_t q, unsigned long n) {
  */
 void mpq_add_si(mpq_t q, long num, unsigned long den) {
   mpz_ptr num_q, den_q;
-  unsigned long gcd;
+  unsigned long gcd, abs_num;
 
 #ifdef DEBUG
   mpq_set_si(aux, num, den);
@@ -132,13 +150,13 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
 
   num_q = mpq_numref(q);
   den_q = mpq_denref(q);
+  abs_num = (num >= 0) ? (unsigned long) num : - (unsigned long) num;
 
   // special cases: den = 1 should be common
   //                num = 0 should be rare
   if (den == 1) {
     // a/b + d --> (a + bd)/b
-    mpz_mul_si(z0, den_q, num);
-    mpz_add(num_q, num_q, z0);
+    addmul_si(num_q, den_q, abs_num, num < 0);
 
     check_result(q);
     return;
@@ -149,9 +167,8 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
 
   if (gcd == 1) {
     // a/b + c/d  --> (a d + b c) / bd
-    mpz_mul_si(z0, den_q, num);
     mpz_mul_ui(num_q, num_q, den);
-    mpz_add(num_q, num_q, z0);
+    addmul_si(num_q, den_q, abs_num, num < 0);
     mpz_mul_ui(den_q, den_q, den);
 
     check_result(q);
@@ -159,10 +176,9 @@ void mpq_add_si(mpq_t q, long num, unsigned long den) {
   }
 
   mpz_divexact_ui(den_q, den_q, gcd); // b0 = b/gcd
-  mpz_mul_si(z0, den_q, num);     // z0 = b0 * num
 
   mpz_mul_ui(num_q, num_q, den/gcd);
-  mpz_add(num_q, num_q, z0);      // num_q := (den_q/gcd) * num + (den/gcd) * num_q
+  addmul_si(num_q, den_q, abs_num, num < 0); // num_q := (den_q/gcd) * num + (den/gcd) * num_q
 
   gcd = mpz_gcd_ui(NULL, num_q, gcd);
   if (gcd == 1) {
@@ -297,6 +313,7 @@ void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
 
   //  printf("- num = %lld, absnum = %llu\n", - num, absnum);
 
+  get_yices_lock(&z0_lock);
   mpz_set_ui(z0, (long) (absnum >> 32)); // high order bits of absnum
   mpz_mul_2exp(z0, z0, 32);
   mpz_add_ui(mpq_numref(q), z0, (unsigned long)(absnum & (~ 0))); // mask high order bits
@@ -308,6 +325,7 @@ void mpq_set_int64(mpq_t q, int64_t num, uint64_t den) {
   mpz_set_ui(z0, (unsigned long) (den >> 32));
   mpz_mul_2exp(z0, z0, 32);
   mpz_add_ui(mpq_denref(q), z0, (unsigned long)(den & (~ 0)));
+  release_yices_lock(&z0_lock);
 }
 
 
@@ -320,6 +338,8 @@ void mpq_get_int64(mpq_t q, int64_t *num, uint64_t *den) {
   unsigned long a, b;
   uint64_t aux;
 
+  get_yices_lock(&z0_lock);
+
   // convert the numerator
   mpz_abs(z0, mpq_numref(q));
   a = mpz_get_ui(z0);            // a = 32 lower order bits
@@ -338,6 +358,8 @@ void mpq_get_int64(mpq_t q, int64_t *num, uint64_t *den) {
   mpz_fdiv_q_2exp(z0, z0, 32);
   b = mpz_get_ui(z0);
   *den = (((uint64_t) b) << 32) | ((uint64_t) a);
+
+  release_yices_lock(&z0_lock);
 }
 
 
@@ -353,13 +375,18 @@ bool mpq_fits_int32(mpq_t q) {
  * Check whether q can be converted into two 64bit integers num/den
  */
 bool mpq_fits_int64(mpq_t q) {
+  bool fits;
+
+  get_yices_lock(&z0_lock);
   mpz_fdiv_q_2exp(z0, mpq_numref(q), 32); // z0 = numerator>>32
-  if (mpz_fits_slong_p(z0)) {
+  fits = mpz_fits_slong_p(z0);
+  if (fits) {
     mpz_fdiv_q_2exp(z0, mpq_denref(q), 32); // denominator >> 32
-    return mpz_fits_ulong_p(z0);
-  } else {
-    return false;
+    fits = mpz_fits_ulong_p(z0);
   }
+  release_yices_lock(&z0_lock);
+
+  return fits;
 }
 
 
@@ -377,12 +404,17 @@ bool mpq_is_int32(mpq_t q) {
  * - i.e., the numerator fits into a 64bit number and the denominator is 1
  */
 bool mpq_is_int64(mpq_t q) {
+  bool is_int;
+
+  is_int = false;
   if (mpz_cmp_ui(mpq_denref(q), 1UL) == 0) {
+    get_yices_lock(&z0_lock);
     mpz_fdiv_q_2exp(z0, mpq_numref(q), 32); // z0 = numerator >> 32
-    return mpz_fits_slong_p(z0);
-  } else {
-    return false;
+    is_int = mpz_fits_slong_p(z0);
+    release_yices_lock(&z0_lock);
   }
+
+  return is_int;
 }
 
 
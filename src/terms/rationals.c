@@ -40,6 +40,7 @@
 #include "terms/rationals.h"
 #include "utils/gcd.h"
 #include "utils/memalloc.h"
+#include "utils/yices_locks.h"
 
 
 
@@ -49,70 +50,63 @@
 
 /*
  * Bank of mpq numbers
- * - bank_q[] = mpq_rationals (all initialized)
+ * - the numbers are stored in blocks of MPQ_BLOCK_SIZE elements
+ *   get_mpq(k) = block k (NULL if block k is not allocated)
  * - bank_free = index of the first unused elements in mpq
  *   (start of free list)
- * - bank_capacity = size of arrays mpq_bank
+ * - bank_capacity = number of elements in all allocated blocks
  * - bank_size = number of rationals currently stored
  *
+ * Blocks are never moved, so get_mpq(i) can be used without
+ * locking in the thread-safe build. Allocation and deletion
+ * are protected by bank_lock.
+ *
  * The free list is encoded via the numerators:
- * succ(i) = mpz_get_si(mpq_numref(bank_q[i]))
+ * succ(i) = mpz_get_si(mpq_numref(get_mpq(i)))
  */
-mpq_t *bank_q = NULL;
+mpq_t *bank_q[MAX_MPQ_BLOCKS];
 
 static int32_t bank_free = -1;
 static uint32_t bank_capacity = 0;
 static uint32_t bank_size = 0;
 
+static yices_lock_t bank_lock;
 
-/*
- * Maximal size.
- */
-#define MAX_BANK_SIZE (UINT32_MAX/sizeof(mpq_t))
 
 /*
- * Initialize bank for initial capacity n.
- * (n must be positive).
+ * Add a new block to the bank
  */
-static void init_bank(uint32_t n) {
-  uint32_t i;
+static void extend_bank(void) {
+  mpq_t *b;
+  uint32_t i, k;
 
-  if (n >= MAX_BANK_SIZE) {
+  k = bank_capacity >> MPQ_BLOCK_BITS;
+  if (k >= MAX_MPQ_BLOCKS) {
     out_of_memory();
   }
 
-  bank_q = (mpq_t *) safe_malloc(n * sizeof(mpq_t));
-  bank_free = -1;
-  bank_capacity = n;
-  bank_size = 0;
+  b = (mpq_t *) safe_malloc(MPQ_BLOCK_SIZE * sizeof(mpq_t));
 
   // initialize all the rationals with room
   // for a 64bit numerator and a 64bit denominator
-  for (i=0; i<n; i++) {
-    mpq_init2(bank_q[i], 64);
+  for (i=0; i<MPQ_BLOCK_SIZE; i++) {
+    mpq_init2(b[i], 64);
   }
+
+  bank_q[k] = b;
+  bank_capacity += MPQ_BLOCK_SIZE;
 }
 
 
 /*
- * Increase bank capacity to n.
+ * Initialize bank: one block
  */
-static void resize_bank(uint32_t n) {
-  uint32_t i, old_n;
-
-  old_n = bank_capacity;
-  if (n > old_n) {
-    if (n >= MAX_BANK_SIZE) {
-      out_of_memory();
-    }
-
-    bank_q = (mpq_t *) safe_realloc(bank_q, n * sizeof(mpq_t));
-    bank_capacity = n;
-
-    for (i=old_n; i<n; i++) {
-      mpq_init2(bank_q[i], 64);
-    }
-  }
+static void init_bank(void) {
+  create_yices_lock(&bank_lock);
+  bank_free = -1;
+  bank_capacity = 0;
+  bank_size = 0;
+  extend_bank();
 }
 
 
@@ -120,14 +114,18 @@ static void resize_bank(uint32_t n) {
  * Free the bank
  */
 static void clear_bank(void) {
-  uint32_t i, n;
+  uint32_t i, k, n;
 
-  n = bank_capacity;
-  for (i=0; i<n; i++) {
-    mpq_clear(bank_q[i]);
+  n = bank_capacity >> MPQ_BLOCK_BITS;
+  for (k=0; k<n; k++) {
+    for (i=0; i<MPQ_BLOCK_SIZE; i++) {
+      mpq_clear(bank_q[k][i]);
+    }
+    safe_free(bank_q[k]);
+    bank_q[k] = NULL;
   }
-
-  free(bank_q);
+  bank_capacity = 0;
+  destroy_yices_lock(&bank_lock);
 }
 
 
@@ -135,7 +133,7 @@ static void clear_bank(void) {
  * Free-list operations
  */
 static inline int32_t free_list_next(int32_t i) {
-  return mpz_get_si(mpq_numref(bank_q[i]));
+  return mpz_get_si(mpq_numref(get_mpq(i)));
 }
 
 /*
@@ -144,17 +142,20 @@ static inline int32_t free_list_next(int32_t i) {
 static int32_t alloc_mpq(void) {
   int32_t n;
 
+  get_yices_lock(&bank_lock);
   n = bank_free;
   if (n >= 0) {
     bank_free = free_list_next(n);
   } else {
     n = bank_size;
     if (n >= bank_capacity) {
-      resize_bank(2 * n);
+      extend_bank();
     }
     bank_size = n + 1;
     assert(-1 <= bank_free && bank_free < (int32_t) bank_capacity);
   }
+  release_yices_lock(&bank_lock);
+
   return n;
 }
 
@@ -164,18 +165,12 @@ static int32_t alloc_mpq(void) {
  * Free allocated mpq number of index i
  */
 void free_mpq(int32_t i) {
+  get_yices_lock(&bank_lock);
   assert(0 <= i && i < bank_capacity);
   assert(-1 <= bank_free && bank_free < (int32_t) bank_capacity);
-  mpz_set_si(mpq_numref(bank_q[i]), bank_free);
+  mpz_set_si(mpq_numref(get_mpq(i)), bank_free);
   bank_free = i;
-}
-
-
-/*
- * Get gmp number of index i
- */
-mpq_ptr get_mpq(int32_t i) {
-  return bank_q[i];
+  release_yices_lock(&bank_lock);
 }
 
 
@@ -186,6 +181,7 @@ mpq_ptr get_mpq(int32_t i) {
 
 /*
  * Global gmp variables used for intermediate computations
+ * (protected by bank_lock in the thread-safe build)
  */
 static mpz_t z0;
 static mpq_t q0;
@@ -197,11 +193,9 @@ static char* string_buffer;
 static uint32_t string_buffer_length;
 
 
-#define INITIAL_BANK_CAPACITY 1024
-
 void init_rationals(void) {
   init_mpq_aux();
-  init_bank(INITIAL_BANK_CAPACITY);
+  init_bank();
   string_buffer = NULL;
   string_buffer_length = 0;
   mpz_init2(z0, 64);
@@ -229,23 +223,9 @@ static void division_by_zero(void) {
  ******************/
 
 /*
- * Bounds on numerator and denominators.
- *
- * a/b can be safely stored as a pair (int32_t/uint32_t)
- * if MIN_NUMERATOR <= a <= MAX_NUMERATOR
- * and 1 <= b <= MAX_DENOMINATOR
- *
- * otherwise a/b must be stored as a gmp rational.
- *
- * The bounds are such that
- * - (a/1)+(b/1), (a/1) - (b/1) can be computed using
- *   32bit arithmetic without overflow.
- * - a/b stored as a pair implies -a/b and b/a can be stored
- *   as pairs too.
+ * Bounds on numerator and denominators: MIN_NUMERATOR, MAX_NUMERATOR,
+ * and MAX_DENOMINATOR are defined in rationals.h.
  */
-#define MAX_NUMERATOR (INT32_MAX>>1)
-#define MIN_NUMERATOR (-MAX_NUMERATOR)
-#define MAX_DENOMINATOR MAX_NUMERATOR
 
 
 
@@ -339,7 +319,7 @@ void q_set_int64(rational_t *r, int64_t a, uint64_t b) {
     } else {
       i = r->num;
     }
-    mpq_set_int64(bank_q[i], a, b);
+    mpq_set_int64(get_mpq(i), a, b);
   }
 }
 
@@ -433,7 +413,7 @@ void q_set_int32(rational_t *r, int32_t a, uint32_t b) {
     } else {
       i = r->num;
     }
-    mpq_set_int32(bank_q[i], a, b);
+    mpq_set_int32(get_mpq(i), a, b);
   }
 }
 
@@ -456,7 +436,7 @@ void q_set64(rational_t *r, int64_t a) {
     } else {
       i = r->num;
     }
-    mpq_set_int64(bank_q[i], a, 1);
+    mpq_set_int64(get_mpq(i), a, 1);
   }
 }
 
@@ -476,7 +456,7 @@ void q_set32(rational_t *r, int32_t a) {
     } else {
       i = r->num;
     }
-    mpq_set_int32(bank_q[i], a, 1);
+    mpq_set_int32(get_mpq(i), a, 1);
   }
 }
 
@@ -492,7 +472,7 @@ static void convert_to_gmp(rational_t *r) {
 
   assert(r->den != 0);
   i = alloc_mpq();
-  mpq_set_int32(bank_q[i], r->num, r->den);
+  mpq_set_int32(get_mpq(i), r->num, r->den);
   r->num = i;
   r->den = 0;
 }
@@ -505,7 +485,7 @@ static void set_to_gmp64(rational_t *r, int64_t a) {
 
   assert(r->den != 0);
   i = alloc_mpq();
-  mpq_set_int64(bank_q[i], a, 1);
+  mpq_set_int64(get_mpq(i), a, 1);
   r->num = i;
   r->den = 0;
 }
@@ -526,7 +506,7 @@ void q_normalize(rational_t *r) {
   long num;
 
   if (r->den == 0) {
-    q = bank_q[r->num];
+    q = get_mpq(r->num);
     if (mpz_fits_ulong_p(mpq_denref(q)) && mpz_fits_slong_p(mpq_numref(q))) {
       num = mpz_get_si(mpq_numref(q));
       den = mpz_get_ui(mpq_denref(q));
@@ -557,7 +537,7 @@ static inline void q_prepare(rational_t *r) {
  */
 void q_set_mpz(rational_t *r, const mpz_t z) {
   q_prepare(r);
-  mpq_set_z(bank_q[r->num], z);
+  mpq_set_z(get_mpq(r->num), z);
   q_normalize(r);
 }
 
@@ -567,7 +547,7 @@ void q_set_mpz(rational_t *r, const mpz_t z) {
  */
 void q_set_mpq(rational_t *r, const mpq_t q) {
   q_prepare(r);
-  mpq_set(bank_q[r->num], q);
+  mpq_set(get_mpq(r->num), q);
   q_normalize(r);
 }
 
@@ -577,9 +557,9 @@ void q_set_mpq(rational_t *r, const mpq_t q) {
  */
 void q_set(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
-    //    q_set_mpq(r1, bank_q[r2->num]); BUG HERE
+    //    q_set_mpq(r1, get_mpq(r2->num)); BUG HERE
     q_prepare(r1);
-    mpq_set(bank_q[r1->num], bank_q[r2->num]);
+    mpq_set(get_mpq(r1->num), get_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->num = r2->num;
@@ -594,7 +574,7 @@ void q_set(rational_t *r1, const rational_t *r2) {
 void q_set_neg(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
     q_prepare(r1);
-    mpq_neg(bank_q[r1->num], bank_q[r2->num]);
+    mpq_neg(get_mpq(r1->num), get_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->num = - r2->num;
@@ -609,7 +589,7 @@ void q_set_neg(rational_t *r1, const rational_t *r2) {
 void q_set_abs(rational_t *r1, const rational_t *r2) {
   if (r2->den == 0) {
     q_prepare(r1);
-    mpq_abs(bank_q[r1->num], bank_q[r2->num]);
+    mpq_abs(get_mpq(r1->num), get_mpq(r2->num));
   } else {
     if (r1->den == 0) free_mpq(r1->num);
     r1->den = r2->den;
@@ -632,7 +612,7 @@ void q_get_num(rational_t *r1, const rational_t *r2) {
   long num;
 
   if (r2->den == 0) {
-    q = bank_q[r2->num];
+    q = get_mpq(r2->num);
     if (mpz_fits_slong_p(mpq_numref(q))) {
       num = mpz_get_si(mpq_numref(q));
       if (MIN_NUMERATOR <= num && num <= MAX_NUMERATOR) {
@@ -644,7 +624,7 @@ void q_get_num(rational_t *r1, const rational_t *r2) {
     }
     // BUG:    q_set_mpz(r1, mpq_numref(q));
     q_prepare(r1);
-    mpq_set_z(bank_q[r1->num], mpq_numref(bank_q[r2->num]));
+    mpq_set_z(get_mpq(r1->num), mpq_numref(get_mpq(r2->num)));
 
   } else {
     if (r1->den == 0) free_mpq(r1->num);
@@ -664,7 +644,7 @@ void q_get_den(rational_t *r1, const rational_t *r2) {
   unsigned long den;
 
   if (r2->den == 0) {
-    q = bank_q[r2->num];
+    q = get_mpq(r2->num);
     if (mpz_fits_ulong_p(mpq_denref(q))) {
       den = mpz_get_ui(mpq_denref(q));
       if (den <= MAX_DENOMINATOR) {
@@ -676,7 +656,7 @@ void q_get_den(rational_t *r1, const rational_t *r2) {
     }
     // BUG    q_set_mpz(r1, mpq_denref(q));
     q_prepare(r1);
-    mpq_set_z(bank_q[r1->num], mpq_denref(bank_q[r2->num]));
+    mpq_set_z(get_mpq(r1->num), mpq_denref(get_mpq(r2->num)));
 
   } else {
     if (r1->den == 0) free_mpq(r1->num);
@@ -748,7 +728,7 @@ static int q_set_q0(rational_t *r) {
   } else {
     i = r->num;
   }
-  mpq_set(bank_q[i], q0);
+  mpq_set(get_mpq(i), q0);
 
   return 0;
 }
@@ -761,7 +741,7 @@ static int q_set_q0(rational_t *r) {
  * - returns -2 and leaves r unchanged if the denominator is zero
  * - returns 0 otherwise
  */
-int q_set_from_string(rational_t *r, const char *s) {
+static int unlocked_q_set_from_string(rational_t *r, const char *s) {
   // GMP rejects an initial '+' so skip it
   if (*s == '+') s ++;
   if (mpq_set_str(q0, s, 10) < 0) return -1;
@@ -770,6 +750,16 @@ int q_set_from_string(rational_t *r, const char *s) {
   return q_set_q0(r);
 }
 
+int q_set_from_string(rational_t *r, const char *s) {
+  int code;
+
+  get_yices_lock(&bank_lock);
+  code = unlocked_q_set_from_string(r, s);
+  release_yices_lock(&bank_lock);
+
+  return code;
+}
+
 /*
  * Conversion from a string using the given base.
  * Base is interpreted as in gmp: either 0 or an integer from 2 to 36.
@@ -778,7 +768,7 @@ int q_set_from_string(rational_t *r, const char *s) {
  * Prefixes  0x or 0b or 0 indicate base 16, 2, or 8,
  * otherwise, the base is 10.
  */
-int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
+static int unlocked_q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
   // GMP rejects an initial '+' so skip it
   if (*s == '+') s ++;
   assert(0 == base || (2 <= base && base <= 36));
@@ -788,6 +778,16 @@ int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
   return q_set_q0(r);
 }
 
+int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
+  int code;
+
+  get_yices_lock(&bank_lock);
+  code = unlocked_q_set_from_string_base(r, s, base);
+  release_yices_lock(&bank_lock);
+
+  return code;
+}
+
 /*
  * Conversion from a string in a floating point format
  * The expected format is one of
@@ -800,7 +800,7 @@ int q_set_from_string_base(rational_t *r, const char *s, int32_t base) {
  * - returns -1 and leaves r unchanged if the string is not in that format
  * - returns 0 otherwise
  */
-int q_set_from_float_string(rational_t *r, const char *s) {
+static int unlocked_q_set_from_float_string(rational_t *r, const char *s) {
   size_t len;
   int frac_len, sign;
   long int exponent;
@@ -882,6 +882,16 @@ int q_set_from_float_string(rational_t *r, const char *s) {
   return q_set_q0(r);
 }
 
+int q_set_from_float_string(rational_t *r, const char *s) {
+  int code;
+
+  get_yices_lock(&bank_lock);
+  code = unlocked_q_set_from_float_string(r, s);
+  release_yices_lock(&bank_lock);
+
+  return code;
+}
+
 
 
 
@@ -910,10 +920,10 @@ void q_add(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1) ;
-    mpq_add(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_add(get_mpq(r1->num), get_mpq(r1->num), get_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_add_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_add_si(get_mpq(r1->num), r2->num, r2->den);
 
   } else {
     den = r1->den * ((uint64_t) r2->den);
@@ -940,10 +950,10 @@ void q_sub(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1) ;
-    mpq_sub(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_sub(get_mpq(r1->num), get_mpq(r1->num), get_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_sub_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_sub_si(get_mpq(r1->num), r2->num, r2->den);
 
   } else {
     den = r1->den * ((uint64_t) r2->den);
@@ -958,7 +968,7 @@ void q_sub(rational_t *r1, const rational_t *r2) {
  */
 void q_neg(rational_t *r) {
   if (r->den == 0) {
-    mpq_neg(bank_q[r->num], bank_q[r->num]);
+    mpq_neg(get_mpq(r->num), get_mpq(r->num));
   } else {
     r->num = - r->num;
   }
@@ -973,7 +983,7 @@ void q_inv(rational_t *r) {
   uint32_t abs_num;
 
   if (r->den == 0) {
-    mpq_inv(bank_q[r->num], bank_q[r->num]);
+    mpq_inv(get_mpq(r->num), get_mpq(r->num));
 
   } else if (r->num < 0) {
     abs_num = (uint32_t) - r->num;
@@ -1010,10 +1020,10 @@ void q_mul(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1);
-    mpq_mul(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_mul(get_mpq(r1->num), get_mpq(r1->num), get_mpq(r2->num));
 
   } else if (r1->den == 0) {
-    mpq_mul_si(bank_q[r1->num], r2->num, r2->den);
+    mpq_mul_si(get_mpq(r1->num), r2->num, r2->den);
 
   } else {
     den = r1->den * ((uint64_t) r2->den);
@@ -1032,13 +1042,13 @@ void q_div(rational_t *r1, const rational_t *r2) {
 
   if (r2->den == 0) {
     if (r1->den != 0) convert_to_gmp(r1);
-    mpq_div(bank_q[r1->num], bank_q[r1->num], bank_q[r2->num]);
+    mpq_div(get_mpq(r1->num), get_mpq(r1->num), get_mpq(r2->num));
 
   } else if (r1->den == 0) {
     if (r2->num == 0) {
       division_by_zero();
     } else {
-      mpq_div_si(bank_q[r1->num], r2->num, r2->den);
+      mpq_div_si(get_mpq(r1->num), r2->num, r2->den);
     }
 
   } else if (r2->num > 0) {
@@ -1116,7 +1126,7 @@ void q_add_one(rational_t *r1) {
   int32_t n;
   if (r1->den == 0) {
     n = r1->num;
-    mpz_add(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
+    mpz_add(mpq_numref(get_mpq(n)), mpq_numref(get_mpq(n)), mpq_denref(get_mpq(n)));
   } else {
     r1->num += r1->den;
     if (r1->num > MAX_NUMERATOR) {
@@ -1132,7 +1142,7 @@ void q_sub_one(rational_t *r1) {
   int32_t n;
   if (r1->den == 0) {
     n = r1->num;
-    mpz_sub(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
+    mpz_sub(mpq_numref(get_mpq(n)), mpq_numref(get_mpq(n)), mpq_denref(get_mpq(n)));
   } else {
     r1->num -= r1->den;
     if (r1->num < MIN_NUMERATOR) {
@@ -1155,8 +1165,8 @@ void q_floor(rational_t *r) {
 
   if (r->den == 0) {
     n = r->num;
-    mpz_fdiv_q(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
-    mpz_set_ui(mpq_denref(bank_q[n]), 1UL);
+    mpz_fdiv_q(mpq_numref(get_mpq(n)), mpq_numref(get_mpq(n)), mpq_denref(get_mpq(n)));
+    mpz_set_ui(mpq_denref(get_mpq(n)), 1UL);
   } else {
     n = r->num / (int32_t) r->den;
     if (r->num < 0) n --;
@@ -1173,8 +1183,8 @@ void q_ceil(rational_t *r) {
 
   if (r->den == 0) {
     n = r->num;
-    mpz_cdiv_q(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_denref(bank_q[n]));
-    mpz_set_ui(mpq_denref(bank_q[n]), 1UL);
+    mpz_cdiv_q(mpq_numref(get_mpq(n)), mpq_numref(get_mpq(n)), mpq_denref(get_mpq(n)));
+    mpz_set_ui(mpq_denref(get_mpq(n)), 1UL);
   } else {
     n = r->num / (int32_t) r->den;
     if (r->num > 0) n ++;
@@ -1262,13 +1272,13 @@ void q_lcm(rational_t *r1, const rational_t *r2) {
     } else {
       // r2 is 32bits, r1 is gmp
       b = abs32(r2->num);
-      mpz_lcm_ui(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), b);
+      mpz_lcm_ui(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)), b);
     }
 
   } else {
     // r2 is a gmp rational
     if (r1->den != 0) convert_to_gmp(r1);
-    mpz_lcm(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r2->num]));
+    mpz_lcm(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r2->num)));
   }
 
 }
@@ -1291,7 +1301,7 @@ void q_gcd(rational_t *r1, const rational_t *r2) {
     } else {
       // r1 is gmp, r2 is a small integer
       b = abs32(r2->num);
-      d = mpz_gcd_ui(NULL, mpq_numref(bank_q[r1->num]), b);
+      d = mpz_gcd_ui(NULL, mpq_numref(get_mpq(r1->num)), b);
       free_mpq(r1->num);
     }
     assert(d <= MAX_NUMERATOR);
@@ -1301,13 +1311,13 @@ void q_gcd(rational_t *r1, const rational_t *r2) {
     if (r1->den != 0) {
       // r1 is a small integer, r2 is a gmp number
       a = abs32(r1->num);
-      d = mpz_gcd_ui(NULL, mpq_numref(bank_q[r2->num]), a);
+      d = mpz_gcd_ui(NULL, mpq_numref(get_mpq(r2->num)), a);
       assert(d <= MAX_NUMERATOR);
       r1->num = d;
       r1->den = 1;
     } else {
       // both are gmp numbers
-      mpz_gcd(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r2->num]));
+      mpz_gcd(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r2->num)));
     }
   }
 }
@@ -1339,11 +1349,11 @@ void q_integer_div(rational_t *r1, rational_t *r2) {
       }
     } else {
       // r1 is gmp, r2 is a small integer
-      mpz_fdiv_q_ui(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]), r2->num);
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_q_ui(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)), r2->num);
+      assert(mpq_is_integer(get_mpq(r1->num)));
     }
   } else {
-    assert(mpq_is_integer(bank_q[r2->num]) && mpq_sgn(bank_q[r2->num]) > 0);
+    assert(mpq_is_integer(get_mpq(r2->num)) && mpq_sgn(get_mpq(r2->num)) > 0);
     if (r1->den != 0) {
       /*
        * r1 is a small integer, r2 is a gmp rational
@@ -1358,9 +1368,9 @@ void q_integer_div(rational_t *r1, rational_t *r2) {
       }
     } else {
       // both r1 and r2 are gmp rationals
-      mpz_fdiv_q(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]),
-                 mpq_numref(bank_q[r2->num]));
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_q(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)),
+                 mpq_numref(get_mpq(r2->num)));
+      assert(mpq_is_integer(get_mpq(r1->num)));
     }
   }
 }
@@ -1390,14 +1400,14 @@ void q_integer_rem(rational_t *r1, rational_t *r2) {
       r1->num = n;
     } else {
       // r1 is gmp, r2 is a small integer
-      n = mpz_fdiv_ui(mpq_numref(bank_q[r1->num]), r2->num);
+      n = mpz_fdiv_ui(mpq_numref(get_mpq(r1->num)), r2->num);
       assert(0 <= n && n <= MAX_NUMERATOR);
       free_mpq(r1->num);
       r1->num = n;
       r1->den = 1;
     }
   } else {
-    assert(mpq_is_integer(bank_q[r2->num]) && mpq_sgn(bank_q[r2->num]) > 0);
+    assert(mpq_is_integer(get_mpq(r2->num)) && mpq_sgn(get_mpq(r2->num)) > 0);
     if (r1->den != 0) {
       /*
        * r1 is a small integer, r2 is a gmp rational
@@ -1408,18 +1418,18 @@ void q_integer_rem(rational_t *r1, rational_t *r2) {
       assert(r1->den == 1);
       if (r1->num < 0) {
         n = alloc_mpq();
-        mpq_set_si(bank_q[n], r1->num, 1UL);
-        mpz_add(mpq_numref(bank_q[n]), mpq_numref(bank_q[n]), mpq_numref(bank_q[r2->num]));
+        mpq_set_si(get_mpq(n), r1->num, 1UL);
+        mpz_add(mpq_numref(get_mpq(n)), mpq_numref(get_mpq(n)), mpq_numref(get_mpq(r2->num)));
         r1->num = n;
         r1->den = 0;
-        assert(mpq_is_integer(bank_q[n]) && mpq_sgn(bank_q[n]) > 0);
+        assert(mpq_is_integer(get_mpq(n)) && mpq_sgn(get_mpq(n)) > 0);
       }
 
     } else {
       // both r1 and r2 are gmp rationals
-      mpz_fdiv_r(mpq_numref(bank_q[r1->num]), mpq_numref(bank_q[r1->num]),
-                 mpq_numref(bank_q[r2->num]));
-      assert(mpq_is_integer(bank_q[r1->num]));
+      mpz_fdiv_r(mpq_numref(get_mpq(r1->num)), mpq_numref(get_mpq(r1->num)),
+                 mpq_numref(get_mpq(r2->num)));
+      assert(mpq_is_integer(get_mpq(r1->num)));
     }
   }
 }
@@ -1437,7 +1447,7 @@ bool q_integer_divides(rational_t *r1, const rational_t *r2) {
 
   if (r1->den == 0) {
     if (r2->den == 0) {
-      return mpz_divisible_p(mpq_numref(bank_q[r2->num]), mpq_numref(bank_q[r1->num]));
+      return mpz_divisible_p(mpq_numref(get_mpq(r2->num)), mpq_numref(get_mpq(r1->num)));
     } else {
       return false;  // abs(r1) > abs(r2) so r1 can't divide r2
     }
@@ -1446,7 +1456,7 @@ bool q_integer_divides(rational_t *r1, const rational_t *r2) {
     assert(r1->den == 1);
     aux = abs32(r1->num);
     if (r2->den == 0) {
-      return mpz_divisible_ui_p(mpq_numref(bank_q[r2->num]), aux);
+      return mpz_divisible_ui_p(mpq_numref(get_mpq(r2->num)), aux);
     } else {
       return abs32(r2->num) % aux == 0;
     }
@@ -1671,13 +1681,13 @@ int q_cmp(const rational_t *r1, const rational_t *r2) {
 
   if (r1->den == 0) {
     if (r2->den == 0) {
-      return mpq_cmp(bank_q[r1->num], bank_q[r2->num]);
+      return mpq_cmp(get_mpq(r1->num), get_mpq(r2->num));
     } else {
-      return mpq_cmp_si(bank_q[r1->num], r2->num, r2->den);
+      return mpq_cmp_si(get_mpq(r1->num), r2->num, r2->den);
     }
   } else {
     if (r2->den == 0) {
-      return - mpq_cmp_si(bank_q[r2->num], r1->num, r1->den);
+      return - mpq_cmp_si(get_mpq(r2->num), r1->num, r1->den);
     } else {
       num = r2->den * ((int64_t) r1->num) - r1->den * ((int64_t) r2->num);
       return (num < 0 ? -1 : (num > 0));
@@ -1693,7 +1703,7 @@ int q_cmp_int32(const rational_t *r1, int32_t num, uint32_t den) {
   int64_t nn;
 
   if (r1->den == 0) {
-    return mpq_cmp_si(bank_q[r1->num], num, den);
+    return mpq_cmp_si(get_mpq(r1->num), num, den);
   } else {
     nn = den * ((int64_t) r1->num) - r1->den * ((int64_t) num);
     return (nn < 0 ? -1 : (nn > 0));
@@ -1701,13 +1711,19 @@ int q_cmp_int32(const rational_t *r1, int32_t num, uint32_t den) {
 }
 
 int q_cmp_int64(const rational_t *r1, int64_t num, uint64_t den) {
+  int cmp;
+
+  get_yices_lock(&bank_lock);
   mpq_set_int64(q0, num, den);
   mpq_canonicalize(q0);
   if (r1->den == 0) {
-    return mpq_cmp(bank_q[r1->num], q0);
+    cmp = mpq_cmp(get_mpq(r1->num), q0);
   } else {
-    return - mpq_cmp_si(q0, r1->num, r1->den);
+    cmp = - mpq_cmp_si(q0, r1->num, r1->den);
   }
+  release_yices_lock(&bank_lock);
+
+  return cmp;
 }
 
 
@@ -1748,8 +1764,8 @@ bool q_get32(rational_t *r, int32_t *v) {
   if (r->den == 1) {
     *v = r->num;
     return true;
-  } else if (r->den == 0 && mpq_fits_int32(bank_q[r->num])) {
-    mpq_get_int32(bank_q[r->num], v, &d);
+  } else if (r->den == 0 && mpq_fits_int32(get_mpq(r->num))) {
+    mpq_get_int32(get_mpq(r->num), v, &d);
     return d == 1;
   } else {
     return false;
@@ -1767,8 +1783,8 @@ bool q_get64(rational_t *r, int64_t *v) {
   if (r->den == 1) {
     *v = r->num;
     return true;
-  } else if (r->den == 0 && mpq_fits_int64(bank_q[r->num])) {
-    mpq_get_int64(bank_q[r->num], v, &d);
+  } else if (r->den == 0 && mpq_fits_int64(get_mpq(r->num))) {
+    mpq_get_int64(get_mpq(r->num), v, &d);
     return d == 1;
   } else {
     return false;
@@ -1785,8 +1801,8 @@ bool q_get_int32(rational_t *r, int32_t *num, uint32_t *den) {
     *num = r->num;
     *den = r->den;
     return true;
-  } else if (mpq_fits_int32(bank_q[r->num])) {
-    mpq_get_int32(bank_q[r->num], num, den);
+  } else if (mpq_fits_int32(get_mpq(r->num))) {
+    mpq_get_int32(get_mpq(r->num), num, den);
     return true;
   } else {
     return false;
@@ -1802,8 +1818,8 @@ bool q_get_int64(rational_t *r, int64_t *num, uint64_t *den) {
     *num = r->num;
     *den = r->den;
     return true;
-  } else if (mpq_fits_int64(bank_q[r->num])) {
-    mpq_get_int64(bank_q[r->num], num, den);
+  } else if (mpq_fits_int64(get_mpq(r->num))) {
+    mpq_get_int64(get_mpq(r->num), num, den);
     return true;
   } else {
     return false;
@@ -1817,19 +1833,19 @@ bool q_get_int64(rational_t *r, int64_t *num, uint64_t *den) {
  * a 64bit integer, or two a pair num/den of 32bit or 64bit integers.
  */
 bool q_is_int32(rational_t *r) {
-  return r->den == 1 || (r->den == 0 && mpq_is_int32(bank_q[r->num]));
+  return r->den == 1 || (r->den == 0 && mpq_is_int32(get_mpq(r->num)));
 }
 
 bool q_is_int64(rational_t *r) {
-  return r->den == 1 || (r->den == 0 && mpq_is_int64(bank_q[r->num]));
+  return r->den == 1 || (r->den == 0 && mpq_is_int64(get_mpq(r->num)));
 }
 
 bool q_fits_int32(rational_t *r) {
-  return r->den != 0 || mpq_fits_int32(bank_q[r->num]);
+  return r->den != 0 || mpq_fits_int32(get_mpq(r->num));
 }
 
 bool q_fits_int64(rational_t *r) {
-  return r->den != 0 || mpq_fits_int64(bank_q[r->num]);
+  return r->den != 0 || mpq_fits_int64(get_mpq(r->num));
 }
 
 
@@ -1844,7 +1860,7 @@ uint32_t q_size(rational_t *r) {
 
   n = 32;
   if (r->den == 0) {
-    n = mpz_size(mpq_numref(bank_q[r->num])) * mp_bits_per_limb;
+    n = mpz_size(mpq_numref(get_mpq(r->num))) * mp_bits_per_limb;
     if (n > (size_t) UINT32_MAX) {
       n = UINT32_MAX;
     }
@@ -1862,8 +1878,8 @@ bool q_get_mpz(rational_t *r, mpz_t z) {
   if (r->den == 1) {
     mpz_set_si(z, r->num);
     return true;
-  } else if (r->den == 0 && mpq_is_integer(bank_q[r->num])) {
-    mpz_set(z, mpq_numref(bank_q[r->num]));
+  } else if (r->den == 0 && mpq_is_integer(get_mpq(r->num))) {
+    mpz_set(z, mpq_numref(get_mpq(r->num)));
     return true;
   } else {
     return false;
@@ -1876,7 +1892,7 @@ bool q_get_mpz(rational_t *r, mpz_t z) {
  */
 void q_get_mpq(rational_t *r, mpq_t q) {
   if (r->den == 0) {
-    mpq_set(q, bank_q[r->num]);
+    mpq_set(q, get_mpq(r->num));
   } else {
     mpq_set_int32(q, r->num, r->den);
   }
@@ -1888,8 +1904,14 @@ void q_get_mpq(rational_t *r, mpq_t q) {
  * Convert to a double
  */
 double q_get_double(rational_t *r) {
+  double d;
+
+  get_yices_lock(&bank_lock);
   q_get_mpq(r, q0);
-  return mpq_get_d(q0);
+  d = mpq_get_d(q0);
+  release_yices_lock(&bank_lock);
+
+  return d;
 }
 
 
@@ -1904,7 +1926,7 @@ double q_get_double(rational_t *r) {
  */
 void q_print(FILE *f, const rational_t *r) {
   if (r->den == 0) {
-    mpq_out_str(f, 10, bank_q[r->num]);
+    mpq_out_str(f, 10, get_mpq(r->num));
   } else if (r->den != 1) {
     fprintf(f, "%" PRId32 "/%" PRIu32, r->num, r->den);
   } else {
@@ -1920,13 +1942,13 @@ void q_print_abs(FILE *f, const rational_t *r) {
   int32_t abs_num;
 
   if (r->den == 0) {
-    q = bank_q[r->num];
+    q = get_mpq(r->num);
     if (mpq_sgn(q) < 0) {
       mpq_neg(q, q);
-      mpq_out_str(f, 10, bank_q[r->num]);
+      mpq_out_str(f, 10, get_mpq(r->num));
       mpq_neg(q, q);
     } else {
-      mpq_out_str(f, 10, bank_q[r->num]);
+      mpq_out_str(f, 10, get_mpq(r->num));
     }
   } else {
     abs_num = r->num;
@@ -1961,7 +1983,7 @@ void q_print_abs(FILE *f, const rational_t *r) {
  */
 uint32_t q_hash_numerator(const rational_t *r) {
   if (r->den == 0) {
-    return (uint32_t) mpz_fdiv_ui(mpq_numref(bank_q[r->num]), HASH_MODULUS);
+    return (uint32_t) mpz_fdiv_ui(mpq_numref(get_mpq(r->num)), HASH_MODULUS);
   } else if (r->num >= 0) {
     return (uint32_t) r->num;
   } else {
@@ -1971,15 +1993,15 @@ uint32_t q_hash_numerator(const rational_t *r) {
 
 uint32_t q_hash_denominator(const rational_t *r) {
   if (r->den == 0) {
-    return (uint32_t) mpz_fdiv_ui(mpq_denref(bank_q[r->num]), HASH_MODULUS);
+    return (uint32_t) mpz_fdiv_ui(mpq_denref(get_mpq(r->num)), HASH_MODULUS);
   }
   return r->den;
 }
 
 void q_hash_decompose(const rational_t *r, uint32_t *h_num, uint32_t *h_den) {
   if (r->den == 0) {
-    *h_num = (uint32_t) mpz_fdiv_ui(mpq_numref(bank_q[r->num]), HASH_MODULUS);
-    *h_den = (uint32_t) mpz_fdiv_ui(mpq_denref(bank_q[r->num]), HASH_MODULUS);
+    *h_num = (uint32_t) mpz_fdiv_ui(mpq_numref(get_mpq(r->num)), HASH_MODULUS);
+    *h_den = (uint32_t) mpz_fdiv_ui(mpq_denref(get_mpq(r->num)), HASH_MODULUS);
   } else if (r->num >= 0) {
     *h_num = (uint32_t) r->num;
     *h_den = r->den;
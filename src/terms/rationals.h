@@ -23,6 +23,7 @@
 #ifndef __RATIONALS_H
 #define __RATIONALS_H
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -46,11 +47,36 @@ typedef struct {
   uint32_t den;
 } rational_t;
 
+/*
+ * Bounds on numerator and denominators.
+ *
+ * a/b can be safely stored as a pair (int32_t/uint32_t)
+ * if MIN_NUMERATOR <= a <= MAX_NUMERATOR
+ * and 1 <= b <= MAX_DENOMINATOR
+ *
+ * otherwise a/b must be stored as a gmp rational.
+ *
+ * The bounds are such that
+ * - (a/1)+(b/1), (a/1) - (b/1) can be computed using
+ *   32bit arithmetic without overflow.
+ * - a/b stored as a pair implies -a/b and b/a can be stored
+ *   as pairs too.
+ */
+#define MAX_NUMERATOR (INT32_MAX>>1)
+#define MIN_NUMERATOR (-MAX_NUMERATOR)
+#define MAX_DENOMINATOR MAX_NUMERATOR
+
 
 /*
- * Global bank of GMP numbers
+ * Global bank of GMP numbers: stored in blocks of MPQ_BLOCK_SIZE
+ * numbers. The bank can store up to 2^27 numbers.
  */
-extern mpq_t *bank_q;
+#define MPQ_BLOCK_BITS 12
+#define MPQ_BLOCK_SIZE (1u << MPQ_BLOCK_BITS)
+#define MPQ_BLOCK_MASK (MPQ_BLOCK_SIZE - 1)
+#define MAX_MPQ_BLOCKS (1u << (27 - MPQ_BLOCK_BITS))
+
+extern mpq_t *bank_q[MAX_MPQ_BLOCKS];
 
 /*
  * Initialization: allocate and initialize
@@ -85,7 +111,9 @@ extern void free_mpq(int32_t i);
 /*
  * Get internal gmp number of index i.
  */
-extern mpq_ptr get_mpq(int32_t i);
+static inline mpq_ptr get_mpq(int32_t i) {
+  return bank_q[i >> MPQ_BLOCK_BITS][i & MPQ_BLOCK_MASK];
+}
 
 /*
  * Set r to 0/1, Must be called before any operation on r.
@@ -346,7 +374,7 @@ extern void q_smt2_mod(rational_t *q, const rational_t *x, const rational_t *y);
  */
 static inline int q_sgn(rational_t *r) {
   if (r->den == 0) {
-    return mpq_sgn(bank_q[r->num]);
+    return mpq_sgn(get_mpq(r->num));
   } else {
     return (r->num < 0 ? -1 : (r->num > 0));
   }
@@ -417,41 +445,41 @@ extern bool q_opposite(const rational_t *r1, const rational_t *r2);
  * Tests on rational r
  */
 static inline bool q_is_zero(const rational_t *r) {
-  return r->den == 0 ? mpq_is_zero(bank_q[r->num]) : r->num == 0;
+  return r->den == 0 ? mpq_is_zero(get_mpq(r->num)) : r->num == 0;
 }
 
 static inline bool q_is_nonzero(const rational_t *r) {
-  return r->den == 0 ? mpq_is_nonzero(bank_q[r->num]) : r->num != 0;
+  return r->den == 0 ? mpq_is_nonzero(get_mpq(r->num)) : r->num != 0;
 }
 
 static inline bool q_is_one(const rational_t *r) {
   return (r->den == 1 && r->num == 1) ||
-    (r->den == 0 && mpq_is_one(bank_q[r->num]));
+    (r->den == 0 && mpq_is_one(get_mpq(r->num)));
 }
 
 static inline bool q_is_minus_one(const rational_t *r) {
   return (r->den == 1 && r->num == -1) ||
-    (r->den == 0 && mpq_is_minus_one(bank_q[r->num]));
+    (r->den == 0 && mpq_is_minus_one(get_mpq(r->num)));
 }
 
 static inline bool q_is_pos(const rational_t *r) {
-  return (r->den > 0 ?  r->num > 0 : mpq_is_pos(bank_q[r->num]));
+  return (r->den > 0 ?  r->num > 0 : mpq_is_pos(get_mpq(r->num)));
 }
 
 static inline bool q_is_nonneg(const rational_t *r) {
-  return (r->den > 0 ?  r->num >= 0 : mpq_is_nonneg(bank_q[r->num]));
+  return (r->den > 0 ?  r->num >= 0 : mpq_is_nonneg(get_mpq(r->num)));
 }
 
 static inline bool q_is_neg(const rational_t *r) {
-  return (r->den > 0 ?  r->num < 0 : mpq_is_neg(bank_q[r->num]));
+  return (r->den > 0 ?  r->num < 0 : mpq_is_neg(get_mpq(r->num)));
 }
 
 static inline bool q_is_nonpos(const rational_t *r) {
-  return (r->den > 0 ?  r->num <= 0 : mpq_is_nonpos(bank_q[r->num]));
+  return (r->den > 0 ?  r->num <= 0 : mpq_is_nonpos(get_mpq(r->num)));
 }
 
 static inline bool q_is_integer(const rational_t *r) {
-  return (r->den == 1) || (r->den == 0 && mpq_is_integer(bank_q[r->num]));
+  return (r->den == 1) || (r->den == 0 && mpq_is_integer(get_mpq(r->num)));
 }
 
 
@@ -506,6 +534,26 @@ static inline int32_t q_get_smallint(rational_t *r) {
   return r->num;
 }
 
+/*
+ * Fast path for row operations on small integers:
+ * - r must be a small integer and a, b must be the values of
+ *   small integers (as returned by q_get_smallint)
+ * - if r - a * b is a small integer, store it in r and return true
+ * - otherwise, return false and leave r unchanged
+ */
+static inline bool q_smallint_submul(rational_t *r, int32_t a, int32_t b) {
+  int64_t num;
+
+  assert(q_is_smallint(r));
+
+  num = r->num - ((int64_t) a) * b;
+  if (MIN_NUMERATOR <= num && num <= MAX_NUMERATOR) {
+    r->num = (int32_t) num;
+    return true;
+  }
+  return false;
+}
+
 
 /*
  * Conversions: all functions attempt to convert r into an integer or
@@ -92,7 +92,9 @@
 
 #include "terms/bv64_constants.h"
 #include "terms/terms.h"
+#include "utils/hash_groups.h"
 #include "utils/hash_functions.h"
+#include "utils/int_array_sort.h"
 #include "utils/memalloc.h"
 #include "utils/refcount_strings.h"
 
@@ -115,6 +117,81 @@ static void default_special_finalizer(special_term_t *s, term_kind_t tag) {
 }
 
 
+/*
+ * DESCRIPTOR STORES
+ */
+
+/*
+ * Index of the store for composite descriptors of arity n
+ */
+static inline uint32_t composite_store_index(uint32_t n) {
+  assert(n <= MAX_STORED_ARITY);
+  return ((n + 2) >> 1) - 1;
+}
+
+/*
+ * Initialize the stores: all banks have 8Kbytes
+ */
+static void init_descriptor_stores(term_table_t *table) {
+  uint32_t k;
+
+  for (k=0; k<NUM_COMPOSITE_STORES; k++) {
+    init_objstore(table->cstore + k, 8 * (k+1), 1024/(k+1));
+  }
+  init_objstore(&table->bv64store, sizeof(bvconst64_term_t), 512);
+}
+
+static void delete_descriptor_stores(term_table_t *table) {
+  uint32_t k;
+
+  for (k=0; k<NUM_COMPOSITE_STORES; k++) {
+    delete_objstore(table->cstore + k);
+  }
+  delete_objstore(&table->bv64store);
+}
+
+static void reset_descriptor_stores(term_table_t *table) {
+  uint32_t k;
+
+  for (k=0; k<NUM_COMPOSITE_STORES; k++) {
+    reset_objstore(table->cstore + k);
+  }
+  reset_objstore(&table->bv64store);
+}
+
+
+/*
+ * Allocate a composite descriptor of arity n
+ * - the arity is set but the arguments are not initialized
+ */
+static composite_term_t *alloc_composite(term_table_t *table, uint32_t n) {
+  composite_term_t *d;
+
+  if (n <= MAX_STORED_ARITY) {
+    d = (composite_term_t *) objstore_alloc(table->cstore + composite_store_index(n));
+  } else {
+    d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + n * sizeof(term_t));
+  }
+  d->arity = n;
+
+  return d;
+}
+
+/*
+ * Free composite descriptor d
+ */
+static void free_composite(term_table_t *table, composite_term_t *d) {
+  uint32_t n;
+
+  n = d->arity;
+  if (n <= MAX_STORED_ARITY) {
+    objstore_free(table->cstore + composite_store_index(n), d);
+  } else {
+    safe_free(d);
+  }
+}
+
+
 /*
  * Initialize table, with initial size n.
  * - ttbl = attached type table.
@@ -136,6 +213,19 @@ static void term_table_init(term_table_t *table, uint32_t n, type_table_t *ttbl,
   table->free_idx = -1; // empty free list
   table->live_terms = 0;
 
+  init_ivector(&table->nursery, 0);
+  table->young = allocate_bitvector(n);
+  table->young_gc = false;
+  init_pvector(&table->young_names, 0);
+  init_ivector(&table->young_named, 0);
+
+  init_ivector(&table->gray, 0);
+  table->gc_cursor = 0;
+  table->gc_work = 0;
+  table->incremental_gc = false;
+
+  init_descriptor_stores(table);
+
   table->types = ttbl;
   table->pprods = ptbl;
   table->finalize = default_special_finalizer;
@@ -173,6 +263,7 @@ static void term_table_extend(term_table_t *table) {
   table->type = (type_t *) safe_realloc(table->type, n * sizeof(type_t));
   table->desc = (term_desc_t *) safe_realloc(table->desc, n * sizeof(term_desc_t));
   table->mark = extend_bitvector(table->mark, n);
+  table->young = extend_bitvector(table->young, n);
   table->size = n;
 }
 
@@ -185,7 +276,8 @@ static void term_table_extend(term_table_t *table) {
 
 /*
  * Allocate a new term id
- * - clear its mark. Nothing else is initialized.
+ * - clear its mark and add it to the nursery.
+ *   Nothing else is initialized.
  */
 static int32_t allocate_term_id(term_table_t *table) {
   int32_t i;
@@ -204,10 +296,45 @@ static int32_t allocate_term_id(term_table_t *table) {
   clr_bit(table->mark, i);
   table->live_terms ++;
 
+  set_bit(table->young, i);
+  ivector_push(&table->nursery, i);
+
   return i;
 }
 
 
+/*
+ * Empty the nursery: all young terms become old
+ * - the names of young terms are forgotten too
+ */
+static void promote_young_terms(term_table_t *table) {
+  uint32_t i, n;
+
+  n = table->nursery.size;
+  for (i=0; i<n; i++) {
+    clr_bit(table->young, table->nursery.data[i]);
+  }
+  ivector_reset(&table->nursery);
+
+  n = table->young_names.size;
+  for (i=0; i<n; i++) {
+    string_decref(table->young_names.data[i]);
+  }
+  pvector_reset(&table->young_names);
+  ivector_reset(&table->young_named);
+}
+
+
+/*
+ * End of an incremental collection (or no collection in progress)
+ */
+static void reset_incremental_gc(term_table_t *table) {
+  ivector_reset(&table->gray);
+  table->gc_cursor = 0;
+  table->incremental_gc = false;
+}
+
+
 
 /*
  * Terms with integer descriptor
@@ -323,14 +450,13 @@ static root_atom_t* new_root_atom(term_table_t *table, uint32_t k, term_t x, ter
  * - n = arity
  * - a[0 ... n-1] = components
  */
-static composite_term_t *new_composite_term(uint32_t n, const term_t *a) {
+static composite_term_t *new_composite_term(term_table_t *table, uint32_t n, const term_t *a) {
   composite_term_t *d;
   uint32_t j;
 
   assert(n <= MAX_COMPOSITE_TERM_ARITY);
 
-  d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + n * sizeof(term_t));
-  d->arity = n;
+  d = alloc_composite(table, n);
   for (j=0; j<n; j++) {
     d->arg[j] = a[j];
   }
@@ -345,14 +471,13 @@ static composite_term_t *new_composite_term(uint32_t n, const term_t *a) {
  * - n = arity
  * - a[0 ... n-1] = arguments to f
  */
-static composite_term_t *new_app_term(term_t f, uint32_t n, const term_t *a) {
+static composite_term_t *new_app_term(term_table_t *table, term_t f, uint32_t n, const term_t *a) {
   composite_term_t *d;
   uint32_t j;
 
   assert(n <= MAX_COMPOSITE_TERM_ARITY - 1);
 
-  d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + (n+1) * sizeof(term_t));
-  d->arity = n+1;
+  d = alloc_composite(table, n+1);
   d->arg[0] = f;
   for (j=0; j<n; j++) {
     d->arg[j + 1] = a[j];
@@ -365,14 +490,13 @@ static composite_term_t *new_app_term(term_t f, uint32_t n, const term_t *a) {
 /*
  * Function update: (update f a[0] ... a[n-1] v)
  */
-static composite_term_t *new_update_term(term_t f, uint32_t n, const term_t *a, term_t v) {
+static composite_term_t *new_update_term(term_table_t *table, term_t f, uint32_t n, const term_t *a, term_t v) {
   composite_term_t *d;
   uint32_t j;
 
   assert(n <= MAX_COMPOSITE_TERM_ARITY - 2);
 
-  d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + (n+2) * sizeof(term_t));
-  d->arity = n+2;
+  d = alloc_composite(table, n+2);
   d->arg[0] = f;
   for (j=0; j<n; j++) {
     d->arg[j + 1] = a[j];
@@ -386,14 +510,13 @@ static composite_term_t *new_update_term(term_t f, uint32_t n, const term_t *a,
 /*
  * Quantified term: (forall v[0] ... v[n-1] p)
  */
-static composite_term_t *new_forall_term(uint32_t n, const term_t *v, term_t p) {
+static composite_term_t *new_forall_term(term_table_t *table, uint32_t n, const term_t *v, term_t p) {
   composite_term_t *d;
   uint32_t j;
 
   assert(n <= MAX_COMPOSITE_TERM_ARITY - 1);
 
-  d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + (n+1) * sizeof(term_t));
-  d->arity = n+1;
+  d = alloc_composite(table, n+1);
   for (j=0; j<n; j++) {
     d->arg[j] = v[j];
   }
@@ -406,14 +529,13 @@ static composite_term_t *new_forall_term(uint32_t n, const term_t *v, term_t p)
 /*
  * Lambda term: (lambda v[0] ... v[n-1] t)
  */
-static composite_term_t *new_lambda_term(uint32_t n, const term_t *v, term_t t) {
+static composite_term_t *new_lambda_term(term_table_t *table, uint32_t n, const term_t *v, term_t t) {
   composite_term_t *d;
   uint32_t j;
 
   assert(n <= MAX_COMPOSITE_TERM_ARITY - 1);
 
-  d = (composite_term_t *) safe_malloc(sizeof(composite_term_t) + (n+1) * sizeof(term_t));
-  d->arity = n+1;
+  d = alloc_composite(table, n+1);
   for (j=0; j<n; j++) {
     d->arg[j] = v[j];
   }
@@ -445,12 +567,12 @@ static bvconst_term_t *new_bvconst_term(uint32_t bitsize, const uint32_t *v) {
 /*
  * Small bitvector constant
  */
-static bvconst64_term_t *new_bvconst64_term(uint32_t bitsize, uint64_t v) {
+static bvconst64_term_t *new_bvconst64_term(term_table_t *table, uint32_t bitsize, uint64_t v) {
   bvconst64_term_t *d;
 
   assert(1 <= bitsize && bitsize <= 64 && v == norm64(v, bitsize));
 
-  d = (bvconst64_term_t *) safe_malloc(sizeof(bvconst64_term_t));
+  d = (bvconst64_term_t *) objstore_alloc(&table->bv64store);
   d->bitsize = bitsize;
   d->value = v;
 
@@ -1141,7 +1263,7 @@ static int32_t build_rational_hobj(rational_term_hobj_t *o) {
 static int32_t build_composite_hobj(composite_term_hobj_t *o) {
   composite_term_t *d;
 
-  d = new_composite_term(o->arity, o->arg);
+  d = new_composite_term(o->tbl, o->arity, o->arg);
   return new_ptr_term(o->tbl, o->tag, o->tau, d);
 }
 
@@ -1155,28 +1277,28 @@ static int32_t build_special_hobj(composite_term_hobj_t *o) {
 static int32_t build_app_hobj(app_term_hobj_t *o) {
   composite_term_t *d;
 
-  d = new_app_term(o->f, o->n, o->arg);
+  d = new_app_term(o->tbl, o->f, o->n, o->arg);
   return new_ptr_term(o->tbl, APP_TERM, o->tau, d);
 }
 
 static int32_t build_update_hobj(update_term_hobj_t *o) {
   composite_term_t *d;
 
-  d = new_update_term(o->f, o->n, o->arg, o->v);
+  d = new_update_term(o->tbl, o->f, o->n, o->arg, o->v);
   return new_ptr_term(o->tbl, UPDATE_TERM, o->tau, d);
 }
 
 static int32_t build_forall_hobj(forall_term_hobj_t *o) {
   composite_term_t *d;
 
-  d = new_forall_term(o->n, o->v, o->p);
+  d = new_forall_term(o->tbl, o->n, o->v, o->p);
   return new_ptr_term(o->tbl, FORALL_TERM, bool_id, d);
 }
 
 static int32_t build_lambda_hobj(lambda_term_hobj_t *o) {
   composite_term_t *d;
 
-  d = new_lambda_term(o->n, o->v, o->t);
+  d = new_lambda_term(o->tbl, o->n, o->v, o->t);
   return new_ptr_term(o->tbl, LAMBDA_TERM, o->tau, d);
 }
 
@@ -1226,7 +1348,7 @@ static int32_t build_bvconst_hobj(bvconst_term_hobj_t *o) {
 static int32_t build_bvconst64_hobj(bvconst64_term_hobj_t *o) {
   bvconst64_term_t *c;
 
-  c = new_bvconst64_term(o->bitsize, o->v);
+  c = new_bvconst64_term(o->tbl, o->bitsize, o->v);
   return new_ptr_term(o->tbl, BV64_CONSTANT, o->tau, c);
 }
 
@@ -1501,6 +1623,13 @@ void set_term_name(term_table_t *table, term_t t, char *name) {
   // add mapping name --> t in the symbol table
   stbl_add(&table->stbl, name, t);
   string_incref(name);
+
+  // remember the mapping if t is young
+  if (tst_bit(table->young, index_of(t))) {
+    pvector_push(&table->young_names, name);
+    ivector_push(&table->young_named, t);
+    string_incref(name);
+  }
 }
 
 
@@ -1670,7 +1799,7 @@ static void delete_term(term_table_t *table, int32_t i) {
     // Generic composite
     d = table->desc[i].ptr;
     h = hash_composite_term(table->kind[i], d->arity, d->arg);
-    safe_free(d);
+    free_composite(table, d);
     break;
 
   case ITE_SPECIAL:
@@ -1687,7 +1816,7 @@ static void delete_term(term_table_t *table, int32_t i) {
     n = d->arity;
     assert(n >= 2);
     h = hash_app_term(d->arg[0], n-1, d->arg + 1);
-    safe_free(d);
+    free_composite(table, d);
     break;
 
   case UPDATE_TERM:
@@ -1695,7 +1824,7 @@ static void delete_term(term_table_t *table, int32_t i) {
     n = d->arity;
     assert(n >= 3);
     h = hash_update_term(d->arg[0], n-2, d->arg + 1, d->arg[n-1]);
-    safe_free(d);
+    free_composite(table, d);
     break;
 
   case FORALL_TERM:
@@ -1703,7 +1832,7 @@ static void delete_term(term_table_t *table, int32_t i) {
     n = d->arity;
     assert(n >= 2);
     h = hash_forall_term(n-1, d->arg, d->arg[n-1]);
-    safe_free(d);
+    free_composite(table, d);
     break;
 
   case LAMBDA_TERM:
@@ -1711,7 +1840,7 @@ static void delete_term(term_table_t *table, int32_t i) {
     n = d->arity;
     assert(n >= 2);
     h = hash_lambda_term(n-1, d->arg, d->arg[n-1]);
-    safe_free(d);
+    free_composite(table, d);
     break;
 
   case SELECT_TERM:
@@ -1747,7 +1876,7 @@ static void delete_term(term_table_t *table, int32_t i) {
   case BV64_CONSTANT:
     c64 = table->desc[i].ptr;
     h = hash_bvconst64_term(c64->bitsize, c64->value);
-    safe_free(c64);
+    objstore_free(&table->bv64store, c64);
     break;
 
   case BV_CONSTANT:
@@ -1896,9 +2025,6 @@ static void delete_term_descriptors(term_table_t *table) {
     case ARITH_IDIV:
     case ARITH_MOD:
     case ARITH_DIVIDES_ATOM:
-    case ARITH_ROOT_ATOM:
-    case BV64_CONSTANT:
-    case BV_CONSTANT:
     case BV_ARRAY:
     case BV_DIV:
     case BV_REM:
@@ -1911,6 +2037,18 @@ static void delete_term_descriptors(term_table_t *table) {
     case BV_EQ_ATOM:
     case BV_GE_ATOM:
     case BV_SGE_ATOM:
+      // large composites only: the others are deleted with the stores
+      if (composite_for_idx(table, i)->arity > MAX_STORED_ARITY) {
+        safe_free(table->desc[i].ptr);
+      }
+      break;
+
+    case BV64_CONSTANT:
+      // in bv64store
+      break;
+
+    case ARITH_ROOT_ATOM:
+    case BV_CONSTANT:
       safe_free(table->desc[i].ptr);
       break;
 
@@ -1962,11 +2100,19 @@ void delete_term_table(term_table_t *table) {
   safe_free(table->type);
   safe_free(table->desc);
   delete_bitvector(table->mark);
+  promote_young_terms(table);
+  delete_ivector(&table->nursery);
+  delete_bitvector(table->young);
+  delete_pvector(&table->young_names);
+  delete_ivector(&table->young_named);
+  delete_ivector(&table->gray);
+  delete_descriptor_stores(table);
 
   table->kind = NULL;
   table->type = NULL;
   table->desc = NULL;
   table->mark = NULL;
+  table->young = NULL;
 }
 
 
@@ -1998,12 +2144,15 @@ static void reset_name_table(ptr_hmap_t *table) {
 void reset_term_table(term_table_t *table) {
   reset_name_table(&table->ntbl);
   delete_term_descriptors(table);
+  reset_descriptor_stores(table);
   int_hmap_reset(&table->utbl);
   reset_int_htbl(&table->htbl);
   reset_stbl(&table->stbl);
 
   ivector_reset(&table->ibuffer);
   pvector_reset(&table->pbuffer);
+  promote_young_terms(table);
+  reset_incremental_gc(table);
 
   table->nelems = 0;
   table->free_idx = -1;
@@ -3341,6 +3490,145 @@ term_t find_constant_term(term_table_t *table, type_t tau, int32_t index) {
 
 
 
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+/*
+ * Size of a composite descriptor of arity n
+ */
+static uint64_t composite_size(uint32_t n) {
+  if (n <= MAX_STORED_ARITY) {
+    return 8 * (composite_store_index(n) + 1);
+  }
+  return sizeof(composite_term_t) + n * sizeof(term_t);
+}
+
+/*
+ * Memory allocated by store s
+ */
+static uint64_t objstore_bytes(const object_store_t *s) {
+  object_bank_t *b;
+  uint64_t n;
+
+  n = 0;
+  for (b = s->bnk; b != NULL; b = b->h.next) {
+    n += sizeof(object_bank_t) + s->blocksize;
+  }
+  return n;
+}
+
+/*
+ * Size of the descriptor of term i
+ */
+static uint64_t term_desc_size(term_table_t *table, int32_t i) {
+  polynomial_t *p;
+  bvpoly_t *q;
+  bvpoly64_t *q64;
+  pprod_t *r;
+  uint32_t n;
+
+  switch (table->kind[i]) {
+  case ITE_TERM:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    return composite_size(composite_for_idx(table, i)->arity);
+
+  case ITE_SPECIAL:
+    n = composite_for_idx(table, i)->arity;
+    return sizeof(special_term_t) + n * sizeof(term_t);
+
+  case ARITH_ROOT_ATOM:
+    return sizeof(root_atom_t);
+
+  case BV64_CONSTANT:
+    return table->bv64store.objsize;
+
+  case BV_CONSTANT:
+    n = bvconst_for_idx(table, i)->bitsize;
+    return sizeof(bvconst_term_t) + ((n + 31) >> 5) * sizeof(uint32_t);
+
+  case POWER_PRODUCT:
+    r = pprod_for_idx(table, i);
+    return sizeof(pprod_t) + r->len * sizeof(varexp_t);
+
+  case ARITH_POLY:
+    p = polynomial_for_idx(table, i);
+    return sizeof(polynomial_t) + (p->nterms + 1) * sizeof(monomial_t);
+
+  case BV64_POLY:
+    q64 = bvpoly64_for_idx(table, i);
+    return sizeof(bvpoly64_t) + (q64->nterms + 1) * sizeof(bvmono64_t);
+
+  case BV_POLY:
+    q = bvpoly_for_idx(table, i);
+    return sizeof(bvpoly_t) + (q->nterms + 1) * sizeof(bvmono_t) +
+      q->nterms * q->width * sizeof(uint32_t);
+
+  default:
+    // no descriptor or the descriptor is stored in table->desc
+    return 0;
+  }
+}
+
+
+/*
+ * Collect the memory statistics
+ */
+void term_table_memory_usage(term_table_t *table, term_table_memory_t *m) {
+  uint32_t i, n, k;
+
+  for (k=0; k<NUM_TERM_KINDS; k++) {
+    m->count[k] = 0;
+    m->bytes[k] = 0;
+  }
+
+  n = table->nelems;
+  for (i=0; i<n; i++) {
+    k = table->kind[i];
+    if (k != UNUSED_TERM) {
+      m->count[k] ++;
+      m->bytes[k] += term_desc_size(table, i);
+    }
+  }
+
+  n = table->size;
+  m->table_bytes = n * (sizeof(uint8_t) + sizeof(type_t) + sizeof(term_desc_t)) + 2 * ((n + 7) >> 3);
+  m->htbl_bytes = table->htbl.size * (sizeof(int_hrec_t) + sizeof(uint8_t)) + HGROUP_SIZE - 1;
+
+  m->store_bytes = objstore_bytes(&table->bv64store);
+  for (k=0; k<NUM_COMPOSITE_STORES; k++) {
+    m->store_bytes += objstore_bytes(table->cstore + k);
+  }
+}
+
+
+
+
 /***********************
  * GARBAGE COLLECTION  *
  **********************/
@@ -3357,13 +3645,24 @@ term_t find_constant_term(term_table_t *table, type_t tau, int32_t index) {
  */
 static void mark_reachable_terms(term_table_t *table, int32_t ptr, int32_t i);
 
-// mark i if it's not already marked then explore its children if i < ptr where i = index_of(t)
+/*
+ * Check whether term index i must be marked and explored
+ * - in a young collection, we skip the old terms: all their
+ *   descendants are old and they are all preserved.
+ */
+static inline bool live_gc_term_idx(const term_table_t *table, int32_t i) {
+  return !table->young_gc || tst_bit(table->young, i);
+}
+
+// mark i if it's not already marked then explore its children if needed where i = index_of(t)
+// (this doesn't use the gray vector: i is explored now if it's below ptr)
 static void mark_and_explore_term(term_table_t *table, int32_t ptr, term_t t) {
   int32_t i;
 
   i = index_of(t);
-  if (! term_idx_is_marked(table, i)) {
-    term_table_set_gc_mark(table, i);
+  if (! term_idx_is_marked(table, i) && live_gc_term_idx(table, i)) {
+    set_bit(table->mark, i);
+    table->gc_work ++;
     if (i < ptr) {
       mark_reachable_terms(table, ptr, i);
     }
@@ -3433,11 +3732,14 @@ static void mark_bvpoly64(term_table_t *table, int32_t ptr, bvpoly64_t *p) {
 
 
 // power product r: we mark it in table->pprods, then we explore all variables of r
+// (the power products are left alone in a young collection)
 static void mark_power_product(term_table_t *table, int32_t ptr, pprod_t *r) {
   uint32_t i, n;
 
   assert(r != empty_pp && r != end_pp && !pp_is_var(r));
-  pprod_table_set_gc_mark(table->pprods, r);
+  if (!table->young_gc) {
+    pprod_table_set_gc_mark(table->pprods, r);
+  }
 
   n = r->len;
   for (i=0; i<n; i++) {
@@ -3548,10 +3850,8 @@ static void mark_reachable_terms(term_table_t *table, int32_t ptr, int32_t i) {
  * - on exit:
  *   every term reachable from a root term is marked
  *   every power product that's live is marked in table->ptbl.
- *   every type that's attached to a live term is marked in table->types
  */
 static void mark_live_terms(term_table_t *table) {
-  type_table_t *types;
   uint32_t i, n;
 
   n = table->nelems;
@@ -3560,10 +3860,19 @@ static void mark_live_terms(term_table_t *table) {
       mark_reachable_terms(table, i, i);
     }
   }
+}
+
+
+/*
+ * Propagate the marks to the types of all live terms
+ */
+static void mark_live_term_types(term_table_t *table) {
+  type_table_t *types;
+  uint32_t i, n;
 
-  // propagate the marks to live types
   // skip the reserved term
   types = table->types;
+  n = table->nelems;
   for (i=1; i<n; i++) {
     if (term_idx_is_marked(table, i) ) {
       type_table_set_gc_mark(types, table->type[i]);
@@ -3572,6 +3881,60 @@ static void mark_live_terms(term_table_t *table) {
 }
 
 
+/*
+ * Explore the gray terms (i.e., terms marked below the cursor
+ * after the cursor moved past them)
+ * - the gray vector may contain young terms that were deleted
+ *   or unmarked by a young collection: they are skipped.
+ */
+static void explore_gray_terms(term_table_t *table) {
+  ivector_t *v;
+  int32_t i;
+
+  v = &table->gray;
+  while (v->size > 0) {
+    i = ivector_pop2(v);
+    if (term_idx_is_marked(table, i)) {
+      mark_reachable_terms(table, table->gc_cursor, i);
+    }
+  }
+}
+
+
+/*
+ * Same thing for a young collection: only the young terms are explored
+ * - the nursery is sorted so that we can use the same ptr trick
+ *   as in mark_live_terms
+ * - on exit, the type of every live young term is marked
+ *   (the types of old terms are old)
+ */
+static void mark_live_young_terms(term_table_t *table) {
+  type_table_t *types;
+  int32_t *a;
+  uint32_t i, n;
+
+  assert(table->young_gc);
+
+  a = table->nursery.data;
+  n = table->nursery.size;
+  int_array_sort(a, n);
+
+  for (i=0; i<n; i++) {
+    if (term_idx_is_marked(table, a[i])) {
+      mark_reachable_terms(table, a[i], a[i]);
+    }
+  }
+
+  // skip the reserved term
+  types = table->types;
+  for (i=0; i<n; i++) {
+    if (a[i] != const_idx && term_idx_is_marked(table, a[i])) {
+      type_table_set_gc_mark(types, table->type[a[i]]);
+    }
+  }
+}
+
+
 /*
  * Iterator to mark the terms accessible from the symbol table
  * - aux must be a pointer to the term table
@@ -3592,31 +3955,82 @@ static bool dead_term_symbol(void *aux, const stbl_rec_t *r) {
   return !term_idx_is_marked(aux, index_of(r->value));
 }
 
-
 /*
- * Garbage collector
- * - the roots are all the marked terms + if keep_named is true,
- *   all the terms accessible from the symbol table (i.e., mapped to some name).
- * - every term, type, and power product reachable from these roots
- *   is preserved
- * - delete everything else
- * - clear all the marks
+ * Mark the primitive terms
+ * - they have no children so they don't need to be explored
+ * - they're created together so they are all young or all old
  */
-void term_table_gc(term_table_t *table, bool keep_named) {
-  uint32_t i, n;
+static void mark_primitive_terms(term_table_t *table) {
+  if (live_gc_term_idx(table, const_idx)) {
+    set_bit(table->mark, const_idx);
+    set_bit(table->mark, bool_const);
+    set_bit(table->mark, zero_const);
+  }
+}
+
 
+/*
+ * Mark the roots that don't depend on the caller: the primitive terms
+ * and the named terms if keep_named is true.
+ */
+static void mark_default_term_roots(term_table_t *table, bool keep_named) {
   // mark the terms present in the symbol table
   if (keep_named) {
     stbl_iterate(&table->stbl, table, mark_symbol);
   }
 
-  // mark the primitive terms
-  set_bit(table->mark, const_idx);
-  set_bit(table->mark, bool_const);
-  set_bit(table->mark, zero_const);
+  mark_primitive_terms(table);
+}
+
+
+/*
+ * Same thing for a young collection: only the names given to young
+ * terms need to be checked.
+ */
+static void mark_default_young_term_roots(term_table_t *table, bool keep_named) {
+  uint32_t i, n;
+  term_t t;
+
+  if (keep_named) {
+    n = table->young_named.size;
+    for (i=0; i<n; i++) {
+      t = table->young_named.data[i];
+      if (stbl_has_mapping(&table->stbl, table->young_names.data[i], t)) {
+        term_table_set_gc_mark(table, index_of(t));
+      }
+    }
+  }
+
+  mark_primitive_terms(table);
+}
 
-  // propagate the marks
-  mark_live_terms(table);
+
+/*
+ * Remove the names of the young terms that are not marked
+ */
+static void remove_dead_young_term_names(term_table_t *table) {
+  uint32_t i, n;
+  term_t t;
+
+  n = table->young_named.size;
+  for (i=0; i<n; i++) {
+    t = table->young_named.data[i];
+    if (! term_idx_is_marked(table, index_of(t))) {
+      stbl_delete_mapping(&table->stbl, table->young_names.data[i], t);
+    }
+  }
+}
+
+
+/*
+ * Second half of a full or incremental collection:
+ * - all live terms are marked
+ * - delete the unmarked terms then clear all the marks
+ */
+static void sweep_terms(term_table_t *table, bool keep_named) {
+  uint32_t i, n;
+
+  mark_live_term_types(table);
 
   // remove the unmarked terms from the symbol table
   if (!keep_named) {
@@ -3637,4 +4051,128 @@ void term_table_gc(term_table_t *table, bool keep_named) {
 
   // clear the marks
   clear_bitvector(table->mark, table->size);
+  promote_young_terms(table);
+  reset_incremental_gc(table);
+}
+
+
+/*
+ * Garbage collector
+ * - the roots are all the marked terms + if keep_named is true,
+ *   all the terms accessible from the symbol table (i.e., mapped to some name).
+ * - every term, type, and power product reachable from these roots
+ *   is preserved
+ * - delete everything else
+ * - clear all the marks
+ * - all surviving terms become old
+ * - if an incremental collection is in progress, it's completed
+ *   (the terms it has marked are kept).
+ */
+void term_table_gc(term_table_t *table, bool keep_named) {
+  mark_default_term_roots(table, keep_named);
+
+  // propagate the marks
+  mark_live_terms(table);
+
+  sweep_terms(table, keep_named);
+}
+
+
+/*
+ * Prepare for a young collection: from now on, only young terms
+ * and types can be marked.
+ */
+void term_table_start_young_gc(term_table_t *table) {
+  table->young_gc = true;
+  type_table_start_young_gc(table->types);
+}
+
+
+/*
+ * Young collection: explore and sweep the nursery only
+ */
+void term_table_young_gc(term_table_t *table, bool keep_named) {
+  int32_t *a;
+  uint32_t i, n;
+
+  assert(table->young_gc);
+
+  mark_default_young_term_roots(table, keep_named);
+  mark_live_young_terms(table);
+
+  if (!keep_named) {
+    remove_dead_young_term_names(table);
+  }
+
+  type_table_young_gc(table->types, keep_named);
+
+  // delete the unmarked young terms and clear the marks
+  a = table->nursery.data;
+  n = table->nursery.size;
+  for (i=0; i<n; i++) {
+    if (! term_idx_is_marked(table, a[i])) {
+      delete_term(table, a[i]);
+    } else {
+      clr_bit(table->mark, a[i]);
+    }
+  }
+
+  table->young_gc = false;
+  promote_young_terms(table);
+}
+
+
+/*
+ * Start an incremental collection
+ * - if one is already in progress, it's restarted (the terms
+ *   marked so far stay marked).
+ */
+void term_table_start_incremental_gc(term_table_t *table) {
+  assert(! table->young_gc);
+  ivector_reset(&table->gray);
+  table->gc_cursor = 0;
+  table->incremental_gc = true;
+}
+
+
+/*
+ * One step: explore the gray terms then the marked terms from gc_cursor
+ * - stop when about budget terms have been visited
+ * - return true if the cursor has reached the end of the table
+ */
+bool term_table_incremental_gc_step(term_table_t *table, uint32_t budget) {
+  int32_t i, n;
+
+  assert(table->incremental_gc && ! table->young_gc);
+
+  table->gc_work = 0;
+  explore_gray_terms(table);
+
+  n = table->nelems;
+  i = table->gc_cursor;
+  while (i < n && table->gc_work < budget) {
+    if (term_idx_is_marked(table, i)) {
+      mark_reachable_terms(table, i, i);
+    }
+    i ++;
+    table->gc_work ++;
+  }
+  table->gc_cursor = i;
+
+  return i == n;
+}
+
+
+/*
+ * End of an incremental collection
+ * - the roots must be marked again before this is called
+ *   (they're in the gray vector if they were not marked)
+ */
+void term_table_finish_incremental_gc(term_table_t *table, bool keep_named) {
+  assert(table->incremental_gc && table->gc_cursor == table->nelems);
+
+  mark_default_term_roots(table, keep_named);
+  explore_gray_terms(table);
+
+  sweep_terms(table, keep_named);
 }
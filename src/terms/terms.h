@@ -192,6 +192,7 @@
 #include "utils/int_hash_map.h"
 #include "utils/int_hash_tables.h"
 #include "utils/int_vectors.h"
+#include "utils/object_stores.h"
 #include "utils/ptr_hash_map.h"
 #include "utils/ptr_vectors.h"
 #include "utils/symbol_tables.h"
@@ -449,6 +450,17 @@ typedef union {
 typedef void (*special_finalizer_t)(special_term_t *spec, term_kind_t tag);
 
 
+/*
+ * Stores for small descriptors
+ * - a composite descriptor of arity n needs 4 + 4n bytes.
+ *   If n <= MAX_STORED_ARITY, it's allocated in store cstore[k]
+ *   where k = (n+2)/2 - 1. The objects in cstore[k] have 8(k+1) bytes.
+ * - larger composites are allocated using safe_malloc.
+ */
+#define MAX_STORED_ARITY 31
+#define NUM_COMPOSITE_STORES 16
+
+
 /*
  * Term table: valid terms have indices between 0 and nelems - 1
  *
@@ -467,6 +479,23 @@ typedef void (*special_finalizer_t)(special_term_t *spec, term_kind_t tag);
  *
  * - live_terms = number of actual terms = nelems - size of the free list
  *
+ * Young generation:
+ * - a term is young if it was created after the last garbage collection
+ * - nursery = vector of all young term indices
+ * - young = bitvector: young[i] = 1 iff i is in the nursery
+ * - young_gc = true during a young collection
+ * - young_names/young_named = names given to young terms:
+ *   young_names[k] is mapped to term young_named[k] in stbl.
+ *   This is used to find the named young terms without scanning
+ *   the whole symbol table.
+ *
+ * Incremental collection:
+ * - incremental_gc = true if an incremental collection is in progress
+ * - gc_cursor = all marked terms of index < gc_cursor have been explored
+ *   except the ones in the gray vector
+ * - gray = marked terms below the cursor that must be explored
+ * - gc_work = number of terms visited in the current step
+ *
  * Symbol table and name table:
  * - stbl is a symbol table that maps names (strings) to term occurrences.
  * - the name table is the reverse. If maps term occurrence to a name.
@@ -474,6 +503,10 @@ typedef void (*special_finalizer_t)(special_term_t *spec, term_kind_t tag);
  * It's used to display t in pretty printing. The symbol table is
  * more important.
  *
+ * Descriptor stores:
+ * - cstore = array of stores for composite descriptors (see above)
+ * - bv64store = store for bvconst64 descriptors
+ *
  * Other components:
  * - types = pointer to an associated type table
  * - pprods = pointer to an associated power product table
@@ -496,6 +529,20 @@ typedef struct term_table_s {
   int32_t free_idx;
   uint32_t live_terms;
 
+  ivector_t nursery;
+  byte_t *young;
+  bool young_gc;
+  pvector_t young_names;
+  ivector_t young_named;
+
+  ivector_t gray;
+  int32_t gc_cursor;
+  uint32_t gc_work;
+  bool incremental_gc;
+
+  object_store_t cstore[NUM_COMPOSITE_STORES];
+  object_store_t bv64store;
+
   type_table_t *types;
   pprod_table_t *pprods;
   special_finalizer_t finalize;
@@ -1652,6 +1699,37 @@ static inline special_term_t *ite_special_desc(const term_table_t *table, term_t
 
 
 
+/*
+ * MEMORY USAGE
+ */
+
+/*
+ * Memory used by the terms:
+ * - count[k] = number of live terms of kind k
+ * - bytes[k] = number of bytes used by the descriptors of these terms
+ *   (this is approximate: it does not include the GMP numbers in
+ *   arithmetic constants and polynomials, or the allocator's overhead)
+ * - table_bytes = size of the arrays kind, type, desc, and the bitvectors
+ * - htbl_bytes = size of the hash-consing table
+ * - store_bytes = memory allocated by the descriptor stores (including
+ *   the free objects)
+ */
+typedef struct term_table_memory_s {
+  uint32_t count[NUM_TERM_KINDS];
+  uint64_t bytes[NUM_TERM_KINDS];
+  uint64_t table_bytes;
+  uint64_t htbl_bytes;
+  uint64_t store_bytes;
+} term_table_memory_t;
+
+/*
+ * Collect the memory statistics of table into *m
+ */
+extern void term_table_memory_usage(term_table_t *table, term_table_memory_t *m);
+
+
+
+
 /*
  * GARBAGE COLLECTION
  */
@@ -1673,6 +1751,34 @@ static inline special_term_t *ite_special_desc(const term_table_t *table, term_t
  *   symbol table.
  * - The type and power-product tables' own garbage collectors are called.
  * - Finally all the marks are cleared.
+ *
+ * Young collections:
+ * - terms are never modified after they're created, so a term can only
+ *   refer to terms (and types) that are older than itself. An old term
+ *   can't refer to a young term and no remembered set is needed.
+ * - term_table_young_gc keeps all the old terms: only the young terms
+ *   are explored and swept, so the cost is proportional to the size of
+ *   the nursery (plus the number of roots).
+ * - the power products are not collected by a young collection.
+ * - every term that survives a collection (young or full) becomes old.
+ * - term_table_start_young_gc must be called before the roots are marked:
+ *   after that, marking an old term has no effect. So only the marks
+ *   of the nursery need to be cleared at the end.
+ *
+ * Incremental collections:
+ * - the marking phase of a full collection is split into steps.
+ * - term_table_start_incremental_gc starts a collection, then the roots
+ *   must be marked.
+ * - each call to term_table_incremental_gc_step explores a bounded number
+ *   of terms in increasing index order (from gc_cursor).
+ * - new terms can be created and new roots can be marked between two steps.
+ *   A root below the cursor is added to the gray vector and explored on the
+ *   next step. Terms never change so a term that's been explored
+ *   stays explored.
+ * - when all terms have been explored, the roots must be marked again then
+ *   term_table_finish_incremental_gc deletes the dead terms and types.
+ * - a young collection can run while an incremental collection is in
+ *   progress. A full collection completes the incremental collection.
  */
 
 /*
@@ -1682,7 +1788,16 @@ static inline special_term_t *ite_special_desc(const term_table_t *table, term_t
  */
 static inline void term_table_set_gc_mark(term_table_t *table, int32_t i) {
   assert(good_term_idx(table, i));
-  set_bit(table->mark, i);
+  if (! tst_bit(table->mark, i)) {
+    if (! table->young_gc) {
+      set_bit(table->mark, i);
+      if (i < table->gc_cursor) {
+        ivector_push(&table->gray, i);
+      }
+    } else if (tst_bit(table->young, i)) {
+      set_bit(table->mark, i);
+    }
+  }
 }
 
 static inline void term_table_clr_gc_mark(term_table_t *table, int32_t i) {
@@ -1713,5 +1828,47 @@ static inline bool term_idx_is_marked(const term_table_t *table, int32_t i) {
  */
 extern void term_table_gc(term_table_t *table, bool keep_named);
 
+/*
+ * Young collection:
+ * - term_table_start_young_gc must be called before the roots are marked
+ *   (it also prepares the type table).
+ * - term_table_young_gc is the same as term_table_gc, except that only the
+ *   young terms that are not reachable from a root are deleted: all old
+ *   terms are preserved.
+ * - calls type_table_young_gc with the same keep_named flag.
+ */
+extern void term_table_start_young_gc(term_table_t *table);
+extern void term_table_young_gc(term_table_t *table, bool keep_named);
+
+/*
+ * Incremental collection:
+ * - term_table_start_incremental_gc: start a new collection.
+ *   The roots must be marked after this call.
+ * - term_table_incremental_gc_step: explore the marked terms.
+ *   The step stops after about budget terms have been visited.
+ *   It returns true if all the terms have been explored.
+ * - term_table_finish_incremental_gc: must be called after a step
+ *   that returned true and after the roots have been marked again.
+ *   This deletes the dead terms, then calls type_table_gc and
+ *   pprod_table_gc (as in term_table_gc).
+ */
+extern void term_table_start_incremental_gc(term_table_t *table);
+extern bool term_table_incremental_gc_step(term_table_t *table, uint32_t budget);
+extern void term_table_finish_incremental_gc(term_table_t *table, bool keep_named);
+
+/*
+ * Check whether an incremental collection is in progress
+ */
+static inline bool term_table_incremental_gc_in_progress(term_table_t *table) {
+  return table->incremental_gc;
+}
+
+/*
+ * Number of terms created since the last collection
+ */
+static inline uint32_t term_table_num_young(term_table_t *table) {
+  return table->nursery.size;
+}
+
 
 #endif /* __TERMS_H */
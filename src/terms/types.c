@@ -25,6 +25,7 @@
 
 #include "terms/types.h"
 #include "utils/hash_functions.h"
+#include "utils/int_array_sort.h"
 #include "utils/memalloc.h"
 #include "utils/refcount_strings.h"
 #include "yices_limits.h"
@@ -269,6 +270,12 @@ static void type_table_init(type_table_t *table, uint32_t n) {
   table->free_idx = NULL_TYPE;
   table->live_types = 0;
 
+  init_ivector(&table->nursery, 0);
+  table->young = allocate_bitvector(n);
+  table->young_gc = false;
+  init_pvector(&table->young_names, 0);
+  init_ivector(&table->young_named, 0);
+
   init_int_htbl(&table->htbl, 0); // use default size
   init_stbl(&table->stbl, 0);     // default size too
 
@@ -308,6 +315,7 @@ static void type_table_extend(type_table_t *table) {
   table->flags = (uint8_t *) safe_realloc(table->flags, n * sizeof(uint8_t));
   table->name = (char **) safe_realloc(table->name, n * sizeof(char *));
   table->depth = (uint32_t *) safe_realloc(table->depth, n * sizeof(uint32_t));
+  table->young = extend_bitvector(table->young, n);
 
   table->size = n;
 }
@@ -315,6 +323,7 @@ static void type_table_extend(type_table_t *table) {
 
 /*
  * Get a free type id and initializes its name to NULL.
+ * The new type is added to the nursery.
  * The other fields are not initialized.
  */
 static type_t allocate_type_id(type_table_t *table) {
@@ -333,10 +342,35 @@ static type_t allocate_type_id(type_table_t *table) {
   table->name[i] = NULL;
   table->live_types ++;
 
+  set_bit(table->young, i);
+  ivector_push(&table->nursery, i);
+
   return i;
 }
 
 
+/*
+ * Empty the nursery: all young types become old
+ * - the names of young types are forgotten too
+ */
+static void promote_young_types(type_table_t *table) {
+  uint32_t i, n;
+
+  n = table->nursery.size;
+  for (i=0; i<n; i++) {
+    clr_bit(table->young, table->nursery.data[i]);
+  }
+  ivector_reset(&table->nursery);
+
+  n = table->young_names.size;
+  for (i=0; i<n; i++) {
+    string_decref(table->young_names.data[i]);
+  }
+  pvector_reset(&table->young_names);
+  ivector_reset(&table->young_named);
+}
+
+
 /*
  * Erase type i: free its descriptor and add i to the free list
  */
@@ -1176,6 +1210,13 @@ void delete_type_table(type_table_t *table) {
   table->name = NULL;
   table->depth = NULL;
 
+  promote_young_types(table);
+  delete_ivector(&table->nursery);
+  delete_bitvector(table->young);
+  table->young = NULL;
+  delete_pvector(&table->young_names);
+  delete_ivector(&table->young_named);
+
   delete_int_htbl(&table->htbl);
   delete_stbl(&table->stbl);
 
@@ -1248,6 +1289,8 @@ void reset_type_table(type_table_t *table) {
     reset_type_mtbl(table->macro_tbl);
   }
 
+  promote_young_types(table);
+
   table->nelems = 0;
   table->free_idx = NULL_TYPE;
   table->live_types = 0;
@@ -2027,6 +2070,13 @@ void set_type_name(type_table_t *table, type_t i, char *name) {
   }
   stbl_add(&table->stbl, name, i);
   string_incref(name);
+
+  // remember the mapping if i is young
+  if (tst_bit(table->young, i)) {
+    pvector_push(&table->young_names, name);
+    ivector_push(&table->young_named, i);
+    string_incref(name);
+  }
 }
 
 /*
@@ -2888,9 +2938,18 @@ static void erase_hcons_type(type_table_t *table, type_t i) {
  */
 static void mark_reachable_types(type_table_t *table, type_t ptr, type_t i);
 
-// mark i if it's not marked already then explore its children if i < ptr
+/*
+ * Check whether i must be marked and explored
+ * - in a young collection, we skip the old types: all their
+ *   descendants are old and they are all preserved.
+ */
+static inline bool live_gc_type(type_table_t *table, type_t i) {
+  return !table->young_gc || tst_bit(table->young, i);
+}
+
+// mark i if it's not marked already then explore its children if needed
 static void mark_and_explore(type_table_t *table, type_t ptr, type_t i) {
-  if (! type_is_marked(table, i)) {
+  if (! type_is_marked(table, i) && live_gc_type(table, i)) {
     type_table_set_gc_mark(table, i);
     if (i < ptr) {
       mark_reachable_types(table, ptr, i);
@@ -2955,6 +3014,30 @@ static void mark_live_types(type_table_t *table) {
 }
 
 
+/*
+ * Same thing for a young collection: propagate the marks
+ * of the young types only.
+ * - the nursery is sorted so that we can use the same ptr
+ *   trick as in mark_live_types.
+ */
+static void mark_live_young_types(type_table_t *table) {
+  type_t *a;
+  uint32_t i, n;
+
+  assert(table->young_gc);
+
+  a = table->nursery.data;
+  n = table->nursery.size;
+  int_array_sort(a, n);
+
+  for (i=0; i<n; i++) {
+    if (type_is_marked(table, a[i])) {
+      mark_reachable_types(table, a[i], a[i]);
+    }
+  }
+}
+
+
 /*
  * Iterator to mark types present in the symbol table
  * - aux must be a pointer to the type table
@@ -2976,6 +3059,7 @@ static bool dead_type_symbol(void *aux, const stbl_rec_t *r) {
   return !type_is_marked(aux, r->value);
 }
 
+
 /*
  * Keep-alive function for the sup/inf caches
  * - record (k0, k1 --> x) is kept in the caches
@@ -3022,17 +3106,35 @@ static bool keep_in_tuple_cache(void *aux, tuple_hmap_rec_t *r) {
 
 
 /*
- * Call the garbage collector:
- * - delete every type not reachable from a root
- * - if keep_named is true, all named types (reachable from the symbol table)
- *   are preserved. Otherwise, all live types are marked and all references
- *   to dead types are remove from the symbol table.
- * - cleanup the caches
- * - then clear all the marks
+ * Remove the references to deleted types from the caches
  */
-void type_table_gc(type_table_t *table, bool keep_named)  {
-  uint32_t i, n;
+static void cleanup_type_caches(type_table_t *table) {
+  // cleanup the inf/sup caches if they exist
+  if (table->sup_tbl != NULL) {
+    int_hmap2_gc(table->sup_tbl, table, keep_in_cache);
+  }
+
+  if (table->inf_tbl != NULL) {
+    int_hmap2_gc(table->inf_tbl, table, keep_in_cache);
+  }
 
+  // cleanup the max cache
+  if (table->max_tbl != NULL) {
+    int_hmap_remove_records(table->max_tbl, table, keep_in_max_table);
+  }
+
+  // cleanup the macro table cache too
+  if (table->macro_tbl != NULL) {
+    tuple_hmap_gc(&table->macro_tbl->cache, table, keep_in_tuple_cache);
+  }
+}
+
+
+/*
+ * Mark the roots that don't depend on the caller:
+ * the predefined types and the named types if keep_named is true
+ */
+static void mark_default_type_roots(type_table_t *table, bool keep_named) {
   // mark every type present in the symbol table
   if (keep_named) {
     stbl_iterate(&table->stbl, table, mark_symbol);
@@ -3042,6 +3144,64 @@ void type_table_gc(type_table_t *table, bool keep_named)  {
   type_table_set_gc_mark(table, bool_id);
   type_table_set_gc_mark(table, int_id);
   type_table_set_gc_mark(table, real_id);
+}
+
+
+/*
+ * Same thing for a young collection: only the names given to young
+ * types need to be checked.
+ */
+static void mark_default_young_type_roots(type_table_t *table, bool keep_named) {
+  uint32_t i, n;
+  type_t tau;
+
+  if (keep_named) {
+    n = table->young_named.size;
+    for (i=0; i<n; i++) {
+      tau = table->young_named.data[i];
+      if (stbl_has_mapping(&table->stbl, table->young_names.data[i], tau)) {
+        type_table_set_gc_mark(table, tau);
+      }
+    }
+  }
+
+  type_table_set_gc_mark(table, bool_id);
+  type_table_set_gc_mark(table, int_id);
+  type_table_set_gc_mark(table, real_id);
+}
+
+
+/*
+ * Remove the names of the young types that are not marked
+ */
+static void remove_dead_young_type_names(type_table_t *table) {
+  uint32_t i, n;
+  type_t tau;
+
+  n = table->young_named.size;
+  for (i=0; i<n; i++) {
+    tau = table->young_named.data[i];
+    if (! type_is_marked(table, tau)) {
+      stbl_delete_mapping(&table->stbl, table->young_names.data[i], tau);
+    }
+  }
+}
+
+
+/*
+ * Call the garbage collector:
+ * - delete every type not reachable from a root
+ * - if keep_named is true, all named types (reachable from the symbol table)
+ *   are preserved. Otherwise, all live types are marked and all references
+ *   to dead types are remove from the symbol table.
+ * - cleanup the caches
+ * - then clear all the marks
+ * - all surviving types become old
+ */
+void type_table_gc(type_table_t *table, bool keep_named)  {
+  uint32_t i, n;
+
+  mark_default_type_roots(table, keep_named);
 
   // propagate the marks
   mark_live_types(table);
@@ -3061,23 +3221,53 @@ void type_table_gc(type_table_t *table, bool keep_named)  {
     type_table_clr_gc_mark(table, i);
   }
 
-  // cleanup the inf/sup caches if they exist
-  if (table->sup_tbl != NULL) {
-    int_hmap2_gc(table->sup_tbl, table, keep_in_cache);
-  }
+  cleanup_type_caches(table);
+  promote_young_types(table);
+}
 
-  if (table->inf_tbl != NULL) {
-    int_hmap2_gc(table->inf_tbl, table, keep_in_cache);
-  }
 
-  // cleanup the max cache
-  if (table->max_tbl != NULL) {
-    int_hmap_remove_records(table->max_tbl, table, keep_in_max_table);
+/*
+ * Prepare for a young collection: only young types can be marked
+ */
+void type_table_start_young_gc(type_table_t *table) {
+  table->young_gc = true;
+}
+
+
+/*
+ * Young collection: only the nursery is explored and swept
+ */
+void type_table_young_gc(type_table_t *table, bool keep_named) {
+  type_t *a;
+  uint32_t i, n;
+  bool deleted;
+
+  assert(table->young_gc);
+
+  mark_default_young_type_roots(table, keep_named);
+  mark_live_young_types(table);
+
+  if (!keep_named) {
+    remove_dead_young_type_names(table);
   }
 
-  // cleanup the macro table cache too
-  if (table->macro_tbl != NULL) {
-    tuple_hmap_gc(&table->macro_tbl->cache, table, keep_in_tuple_cache);
+  // delete the unmarked young types and clear the marks
+  deleted = false;
+  a = table->nursery.data;
+  n = table->nursery.size;
+  for (i=0; i<n; i++) {
+    if (! type_is_marked(table, a[i])) {
+      erase_hcons_type(table, a[i]);
+      erase_type(table, a[i]);
+      deleted = true;
+    } else {
+      type_table_clr_gc_mark(table, a[i]);
+    }
   }
 
+  if (deleted) {
+    cleanup_type_caches(table);
+  }
+  table->young_gc = false;
+  promote_young_types(table);
 }
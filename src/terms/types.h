@@ -64,9 +64,12 @@
 #include <stdbool.h>
 #include <assert.h>
 
+#include "utils/bitvectors.h"
 #include "utils/int_hash_map.h"
 #include "utils/int_hash_map2.h"
 #include "utils/int_hash_tables.h"
+#include "utils/int_vectors.h"
+#include "utils/ptr_vectors.h"
 #include "utils/symbol_tables.h"
 #include "utils/tagged_pointers.h"
 #include "utils/tuple_hash_map.h"
@@ -284,6 +287,15 @@ typedef struct type_mtbl_s {
  *     kind[i] = UNUSED_TYPE
  *     desc[i].next = index of i's successor in the list (or -1).
  * - live_types = number of types = nelems - size of the free_list
+ *
+ * Young generation:
+ * - a type is young if it was created after the last garbage collection
+ * - nursery = vector of all young types
+ * - young = bitvector: young[i] = 1 iff i is in the nursery
+ * - young_gc = true during a young collection
+ * - young_names/young_named = names given to young types:
+ *   young_names[k] is mapped to type young_named[k] in stbl
+ *
  * - htbl = hash table for hash consing
  * - stbl = symbol table for named types
  *   stbl stores a mapping from strings to type ids.
@@ -314,6 +326,12 @@ typedef struct type_table_s {
   int32_t free_idx;
   uint32_t live_types;
 
+  ivector_t nursery;
+  byte_t *young;
+  bool young_gc;
+  pvector_t young_names;
+  ivector_t young_named;
+
   int_htbl_t htbl;
   stbl_t stbl;
   int_hmap2_t *sup_tbl;
@@ -1135,6 +1153,16 @@ extern type_t apply_type_matching(type_matcher_t *matcher, type_t tau);
  * - all types that are explicitly marked as roots (using call to set_gc_mark).
  * - if flag keep_named is true, every type that's present in the symbol table
  * At the end of type_table_gc, all marks are cleared.
+ *
+ * Generational collection:
+ * - types are never modified after they're created, so a type can
+ *   only refer to types that are older than itself.
+ * - every type that survives a collection becomes old. Old types
+ *   are kept by type_table_young_gc: it explores and deletes only
+ *   the types created since the last collection (i.e., the nursery).
+ * - type_table_gc is a full collection: it may delete old types too.
+ * - during a young collection (after type_table_start_young_gc),
+ *   marking an old type has no effect.
  */
 
 /*
@@ -1144,7 +1172,9 @@ extern type_t apply_type_matching(type_matcher_t *matcher, type_t tau);
  */
 static inline void type_table_set_gc_mark(type_table_t *tbl, type_t i) {
   assert(good_type(tbl, i));
-  tbl->flags[i] |= TYPE_GC_MARK;
+  if (! tbl->young_gc || tst_bit(tbl->young, i)) {
+    tbl->flags[i] |= TYPE_GC_MARK;
+  }
 }
 
 /*
@@ -1174,6 +1204,23 @@ static inline bool type_is_marked(type_table_t *tbl, type_t i) {
  */
 extern void type_table_gc(type_table_t *tbl, bool keep_named);
 
+/*
+ * Young collection:
+ * - type_table_start_young_gc must be called before the roots are marked.
+ * - type_table_young_gc is the same as type_table_gc but only the young
+ *   types that are not reachable from a root can be deleted. All old
+ *   types are preserved.
+ */
+extern void type_table_start_young_gc(type_table_t *tbl);
+extern void type_table_young_gc(type_table_t *tbl, bool keep_named);
+
+/*
+ * Number of types created since the last collection
+ */
+static inline uint32_t type_table_num_young(type_table_t *tbl) {
+  return tbl->nursery.size;
+}
+
 
 
 #endif /* __TYPES_H */
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CONTROL BYTES FOR OPEN-ADDRESSING HASH TABLES
+ *
+ * A table of size n (power of 2, n >= HGROUP_SIZE) has an array of
+ * n + HGROUP_SIZE - 1 control bytes, one per slot:
+ * - ctrl[i] = HCTRL_EMPTY if slot i is empty
+ * - ctrl[i] = HCTRL_DELETED if slot i contains a deleted element
+ * - otherwise ctrl[i] = a 7-bit tag derived from the hash code of
+ *   the element stored in slot i
+ * The first HGROUP_SIZE - 1 bytes are copied at the end of the array
+ * so that a group of HGROUP_SIZE bytes can be read from any position
+ * without wrapping around.
+ *
+ * Tables are probed one group at a time: the group that starts at
+ * position (h & mask), then the next group, and so forth. Within a
+ * group, the slots whose tag matches are found with a single vector
+ * comparison (SSE2 or NEON) so that most mismatches are rejected
+ * without reading the table elements. A search can stop at the first
+ * group that contains an empty slot.
+ */
+
+#ifndef __HASH_GROUPS_H
+#define __HASH_GROUPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "utils/memalloc.h"
+
+
+#define HGROUP_SIZE 16
+
+#define HCTRL_EMPTY   ((uint8_t) 0x80)
+#define HCTRL_DELETED ((uint8_t) 0xFE)
+
+
+/*
+ * Tag of hash code h: 7 high-order bits (the low-order bits
+ * give the initial position).
+ */
+static inline uint8_t hctrl_tag(uint32_t h) {
+  return (uint8_t) (h >> 25);
+}
+
+/*
+ * Check whether control byte c is a tag (i.e., the slot is full)
+ */
+static inline bool hctrl_is_full(uint8_t c) {
+  return c < HCTRL_EMPTY;
+}
+
+
+/*
+ * Allocate a control array for a table of size n: all slots empty
+ */
+static inline uint8_t *alloc_hctrl(uint32_t n) {
+  uint8_t *ctrl;
+
+  ctrl = (uint8_t *) safe_malloc(n + HGROUP_SIZE - 1);
+  memset(ctrl, HCTRL_EMPTY, n + HGROUP_SIZE - 1);
+  return ctrl;
+}
+
+/*
+ * Mark all slots as empty
+ */
+static inline void clear_hctrl(uint8_t *ctrl, uint32_t n) {
+  memset(ctrl, HCTRL_EMPTY, n + HGROUP_SIZE - 1);
+}
+
+/*
+ * Set control byte of slot i to c (and its copy if any)
+ */
+static inline void hctrl_set(uint8_t *ctrl, uint32_t n, uint32_t i, uint8_t c) {
+  ctrl[i] = c;
+  if (i < HGROUP_SIZE - 1) {
+    ctrl[n + i] = c;
+  }
+}
+
+
+/*
+ * Group operations: g = pointer to HGROUP_SIZE control bytes
+ * - hgroup_match(g, c): bit i of the result is set if g[i] == c
+ * - hgroup_match_free(g): bit i is set if slot i is empty or deleted
+ */
+#if defined(__SSE2__)
+
+static inline uint32_t hgroup_match(const uint8_t *g, uint8_t c) {
+  __m128i x;
+
+  x = _mm_loadu_si128((const __m128i *) g);
+  return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8((char) c)));
+}
+
+static inline uint32_t hgroup_match_free(const uint8_t *g) {
+  return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) g));
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+/*
+ * NEON has no movemask: x is a vector of 0x00/0xFF bytes and we
+ * keep one bit per byte then add each half.
+ */
+static inline uint32_t hgroup_bitmask(uint8x16_t x) {
+  static const uint8_t weight[HGROUP_SIZE] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128,
+  };
+
+  x = vandq_u8(x, vld1q_u8(weight));
+  return vaddv_u8(vget_low_u8(x)) | (((uint32_t) vaddv_u8(vget_high_u8(x))) << 8);
+}
+
+static inline uint32_t hgroup_match(const uint8_t *g, uint8_t c) {
+  return hgroup_bitmask(vceqq_u8(vld1q_u8(g), vdupq_n_u8(c)));
+}
+
+static inline uint32_t hgroup_match_free(const uint8_t *g) {
+  return hgroup_bitmask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(g))));
+}
+
+#else
+
+static inline uint32_t hgroup_match(const uint8_t *g, uint8_t c) {
+  uint32_t i, m;
+
+  m = 0;
+  for (i=0; i<HGROUP_SIZE; i++) {
+    m |= ((uint32_t) (g[i] == c)) << i;
+  }
+  return m;
+}
+
+static inline uint32_t hgroup_match_free(const uint8_t *g) {
+  uint32_t i, m;
+
+  m = 0;
+  for (i=0; i<HGROUP_SIZE; i++) {
+    m |= ((uint32_t) (g[i] >> 7)) << i;
+  }
+  return m;
+}
+
+#endif
+
+static inline uint32_t hgroup_match_empty(const uint8_t *g) {
+  return hgroup_match(g, HCTRL_EMPTY);
+}
+
+
+/*
+ * Index of the lowest bit set in a non-zero match mask
+ */
+static inline uint32_t hgroup_first(uint32_t m) {
+#ifdef __GNUC__
+  return __builtin_ctz(m);
+#else
+  uint32_t i;
+
+  i = 0;
+  while ((m & 1) == 0) {
+    m >>= 1;
+    i ++;
+  }
+  return i;
+#endif
+}
+
+
+#endif /* __HASH_GROUPS_H */
@@ -24,6 +24,7 @@
 #include <assert.h>
 
 #include "utils/int_hash_tables.h"
+#include "utils/hash_groups.h"
 #include "utils/memalloc.h"
 
 
@@ -43,12 +44,12 @@ static bool is_power_of_two(uint32_t n) {
  * If n = 0 set size = default value
  */
 void init_int_htbl(int_htbl_t *table, uint32_t n) {
-  uint32_t i;
-  int_hrec_t *tmp;
-
   if (n == 0) {
     n = INT_HTBL_DEFAULT_SIZE;
   }
+  if (n < HGROUP_SIZE) {
+    n = HGROUP_SIZE;
+  }
 
   if (n >= MAX_HTBL_SIZE) {
     out_of_memory(); // abort
@@ -56,12 +57,8 @@ void init_int_htbl(int_htbl_t *table, uint32_t n) {
 
   assert(is_power_of_two(n));
 
-  tmp = (int_hrec_t *) safe_malloc(n * sizeof(int_hrec_t));
-  for (i=0; i<n; i++) {
-    tmp[i].value = NULL_VALUE;
-  }
-
-  table->records = tmp;
+  table->records = (int_hrec_t *) safe_malloc(n * sizeof(int_hrec_t));
+  table->ctrl = alloc_hctrl(n);
   table->size = n;
   table->nelems = 0;
   table->ndeleted = 0;
@@ -76,7 +73,9 @@ void init_int_htbl(int_htbl_t *table, uint32_t n) {
  */
 void delete_int_htbl(int_htbl_t *table) {
   safe_free(table->records);
+  safe_free(table->ctrl);
   table->records = NULL;
+  table->ctrl = NULL;
 }
 
 
@@ -84,13 +83,7 @@ void delete_int_htbl(int_htbl_t *table) {
  * Reset table: remove all elements
  */
 void reset_int_htbl(int_htbl_t *table) {
-  uint32_t i, n;
-
-  n = table->size;
-  for (i=0; i<n; i++) {
-    table->records[i].value = NULL_VALUE;
-  }
-
+  clear_hctrl(table->ctrl, table->size);
   table->nelems = 0;
   table->ndeleted = 0;
 }
@@ -99,92 +92,78 @@ void reset_int_htbl(int_htbl_t *table) {
 
 
 /*
- * Copy record <k, v> into a clean record array t.
- * t contains no DELETED_VALUE and must have at least one empty slot
- * <k, v> must not be present in t.
- * mask must be 2^n - 1 and (size of t) = 2^n
+ * Copy record <k, v> into a clean table of size n
+ * - t = record array, ctrl = control bytes
+ * - t contains no deleted records and must have at least one empty slot
+ * - <k, v> must not be present in t.
  */
-static void int_htbl_copy_record(int_hrec_t *t, uint32_t k, int32_t v, uint32_t mask) {
-  uint32_t j;
-  int_hrec_t *r;
+static void int_htbl_copy_record(int_hrec_t *t, uint8_t *ctrl, uint32_t n, uint32_t k, int32_t v) {
+  uint32_t mask, j, m;
 
+  mask = n - 1;
   j = k & mask;
   for (;;) {
-    r = t + j;
-    if (r->value == NULL_VALUE) {
-      r->value = v;
-      r->key = k;
-      return;
-    }
-    j ++;
+    m = hgroup_match_empty(ctrl + j);
+    if (m != 0) break;
+    j += HGROUP_SIZE;
     j &= mask;
   }
+
+  j = (j + hgroup_first(m)) & mask;
+  hctrl_set(ctrl, n, j, hctrl_tag(k));
+  t[j].key = k;
+  t[j].value = v;
 }
 
 
 /*
- * Remove deleted elements
+ * Copy all the live records of table into a new table of size n
  */
-static void int_htbl_cleanup(int_htbl_t *table) {
+static void int_htbl_rehash(int_htbl_t *table, uint32_t n) {
   int_hrec_t *tmp;
-  uint32_t j, n;
-  uint32_t mask;
-  int32_t v;
+  uint8_t *ctrl;
+  uint32_t j, old_n;
 
-  n = table->size;
   tmp = (int_hrec_t *) safe_malloc(n * sizeof(int_hrec_t));
-  for (j=0; j<n; j++) {
-    tmp[j].value = NULL_VALUE;
-  }
+  ctrl = alloc_hctrl(n);
 
-  mask = n - 1;
-  for (j=0; j<n; j++) {
-    v = table->records[j].value;
-    if (v >= 0) {
-      int_htbl_copy_record(tmp, table->records[j].key, v, mask);
+  old_n = table->size;
+  for (j=0; j<old_n; j++) {
+    if (hctrl_is_full(table->ctrl[j])) {
+      int_htbl_copy_record(tmp, ctrl, n, table->records[j].key, table->records[j].value);
     }
   }
 
   safe_free(table->records);
+  safe_free(table->ctrl);
   table->records = tmp;
+  table->ctrl = ctrl;
   table->ndeleted = 0;
+  table->size = n;
 }
 
 
+/*
+ * Remove deleted elements
+ */
+static void int_htbl_cleanup(int_htbl_t *table) {
+  int_htbl_rehash(table, table->size);
+}
+
 
 /*
  * Remove deleted elements and make table twice as large
  */
 static void int_htbl_extend(int_htbl_t *table) {
-  int_hrec_t *tmp;
-  uint32_t j, n, n2;
-  uint32_t mask;
-  int32_t v;
+  uint32_t n2;
 
-  n = table->size;
-  n2 = n<<1;
+  n2 = table->size << 1;
   if (n2 == 0 || n2 >= MAX_HTBL_SIZE) {
     // overflow or too large
     out_of_memory();
   }
 
-  tmp = (int_hrec_t *) safe_malloc(n2 * sizeof(int_hrec_t));
-  for (j=0; j<n2; j++) {
-    tmp[j].value = NULL_VALUE;
-  }
-  mask = n2 - 1;
-
-  for (j=0; j<n; j++) {
-    v = table->records[j].value;
-    if (v >= 0) {
-      int_htbl_copy_record(tmp, table->records[j].key, v, mask);
-    }
-  }
-
-  safe_free(table->records);
-  table->records = tmp;
-  table->ndeleted = 0;
-  table->size = n2;
+  int_htbl_rehash(table, n2);
 
   // keep same fill/cleanup ratios
   table->resize_threshold = (uint32_t) (n2 * RESIZE_RATIO);
@@ -196,26 +175,32 @@ static void int_htbl_extend(int_htbl_t *table) {
  * Erase <k, v>
  */
 void int_htbl_erase_record(int_htbl_t *table, uint32_t k, int32_t v) {
-  uint32_t mask, j;
-  int_hrec_t *r;
+  uint32_t mask, j, i, m;
+  uint8_t tag;
 
   // table must not be full, otherwise the function loops
   assert(table->size > table->nelems + table->ndeleted);
 
   mask = table->size - 1;
+  tag = hctrl_tag(k);
   j = k & mask;
   for (;;) {
-    r = table->records + j;
-    if (r->value == v) break;
-    if (r->value == NULL_VALUE) return;
-    j ++;
+    m = hgroup_match(table->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      if (table->records[i].value == v) goto found;
+      m &= m - 1;
+    }
+    if (hgroup_match_empty(table->ctrl + j) != 0) return;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 
-  assert(r->key == k && r->value == v);
+ found:
+  assert(table->records[i].key == k);
   table->nelems --;
   table->ndeleted ++;
-  r->value = DELETED_VALUE;
+  hctrl_set(table->ctrl, table->size, i, HCTRL_DELETED);
   if (table->ndeleted > table->cleanup_threshold) {
     int_htbl_cleanup(table);
   }
@@ -227,25 +212,25 @@ void int_htbl_erase_record(int_htbl_t *table, uint32_t k, int32_t v) {
  * - the record must not be present in the table
  */
 void int_htbl_add_record(int_htbl_t *table, uint32_t k, int32_t v) {
-  uint32_t mask, j;
-  int_hrec_t *r;
+  uint32_t mask, j, m;
 
   assert(table->size > table->nelems + table->ndeleted);
 
   mask = table->size - 1;
   j = k & mask;
   for (;;) {
-    r = table->records + j;
-    if (r->value == NULL_VALUE) break;
-    assert(r->value != v);
-    j ++;
+    m = hgroup_match_empty(table->ctrl + j);
+    if (m != 0) break;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 
-  // add <k, v> into record r
+  // add <k, v> into the first empty record
+  j = (j + hgroup_first(m)) & mask;
   table->nelems ++;
-  r->key = k;
-  r->value = v;
+  hctrl_set(table->ctrl, table->size, j, hctrl_tag(k));
+  table->records[j].key = k;
+  table->records[j].value = v;
 
   if (table->nelems + table->ndeleted > table->resize_threshold) {
     int_htbl_extend(table);
@@ -257,8 +242,8 @@ void int_htbl_add_record(int_htbl_t *table, uint32_t k, int32_t v) {
  * Find index of object equal to o or return -1 if no such index is in the hash table.
  */
 int32_t int_htbl_find_obj(int_htbl_t *table, int_hobj_t *o) {
-  uint32_t mask, j, k;
-  int32_t v;
+  uint32_t mask, j, k, i, m;
+  uint8_t tag;
   int_hrec_t *r;
 
   // the table must not be full, otherwise, the function loops
@@ -266,14 +251,22 @@ int32_t int_htbl_find_obj(int_htbl_t *table, int_hobj_t *o) {
 
   mask = table->size - 1;
   k = o->hash(o);
+  tag = hctrl_tag(k);
   j = k & mask;
   for (;;) {
-    r = table->records + j;
-    v = r->value;
-    if ((v >= 0 && r->key == k && o->eq(o, v)) || v == NULL_VALUE) {
-      return v;
+    m = hgroup_match(table->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      r = table->records + i;
+      if (r->key == k && o->eq(o, r->value)) {
+        return r->value;
+      }
+      m &= m - 1;
+    }
+    if (hgroup_match_empty(table->ctrl + j) != 0) {
+      return NULL_VALUE;
     }
-    j ++;
+    j += HGROUP_SIZE;
     j &= mask;
   }
 }
@@ -281,18 +274,22 @@ int32_t int_htbl_find_obj(int_htbl_t *table, int_hobj_t *o) {
 
 /*
  * Allocate an index for o (by calling build) then store this index and k in
- * record r. k must be the hash code of o.
+ * record i. k must be the hash code of o.
  */
-static int32_t int_htbl_store_new_obj(int_htbl_t *table, int_hrec_t *r, uint32_t k, int_hobj_t *o) {
+static int32_t int_htbl_store_new_obj(int_htbl_t *table, uint32_t i, uint32_t k, int_hobj_t *o) {
   int32_t v;
 
   v = o->build(o);
 
   // error in build is signaled by returning v < 0
   if (v >= 0) {
+    if (table->ctrl[i] == HCTRL_DELETED) {
+      table->ndeleted --;
+    }
     table->nelems ++;
-    r->key = k;
-    r->value = v;
+    hctrl_set(table->ctrl, table->size, i, hctrl_tag(k));
+    table->records[i].key = k;
+    table->records[i].value = v;
 
     if (table->nelems + table->ndeleted > table->resize_threshold) {
       int_htbl_extend(table);
@@ -309,40 +306,39 @@ static int32_t int_htbl_store_new_obj(int_htbl_t *table, int_hrec_t *r, uint32_t
  * in the table.
  */
 int32_t int_htbl_get_obj(int_htbl_t *table, int_hobj_t *o) {
-  uint32_t mask, j, k;
-  int32_t v;
+  uint32_t mask, j, k, i, m, slot;
+  uint8_t tag;
   int_hrec_t *r;
-  int_hrec_t *aux;
 
   assert(table->size > table->nelems + table->ndeleted);
 
   mask = table->size - 1;
   k = o->hash(o);
+  tag = hctrl_tag(k);
   j = k & mask;
 
+  // slot will be used to store the new index if needed
+  slot = UINT32_MAX;
   for (;;) {
-    r = table->records + j;
-    v = r->value;
-    if (v == NULL_VALUE) return int_htbl_store_new_obj(table, r, k, o);
-    if (v == DELETED_VALUE) break;
-    if (r->key == k && o->eq(o, v)) return v;
-    j ++;
-    j &= mask;
-  }
-
-  // aux will be used to store the new index if needed
-  aux = r;
-  for (;;) {
-    j ++;
-    j &= mask;
-    r = table->records + j;
-    v = r->value;
-    if (v == NULL_VALUE) {
-      table->ndeleted --;
-      return int_htbl_store_new_obj(table, aux, k, o);
+    m = hgroup_match(table->ctrl + j, tag);
+    while (m != 0) {
+      i = (j + hgroup_first(m)) & mask;
+      r = table->records + i;
+      if (r->key == k && o->eq(o, r->value)) {
+        return r->value;
+      }
+      m &= m - 1;
+    }
+    if (slot == UINT32_MAX) {
+      m = hgroup_match_free(table->ctrl + j);
+      if (m != 0) {
+        slot = (j + hgroup_first(m)) & mask;
+      }
+    }
+    if (hgroup_match_empty(table->ctrl + j) != 0) {
+      return int_htbl_store_new_obj(table, slot, k, o);
     }
-    if (v >= 0 && r->key == k && o->eq(o, v)) return v;
+    j += HGROUP_SIZE;
+    j &= mask;
   }
 }
-
-
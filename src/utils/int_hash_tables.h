@@ -35,13 +35,14 @@
 
 
 /*
- * Hash table = array of records
+ * Hash table = array of records + control bytes
  * - each record is a pair <key, value> (key = hash code, value = index)
- * - an empty record has value = NULL_VALUE
- * - a deleted record has value = DELETED_VALUE
- * - other records have a non-negative value
+ * - ctrl[i] gives the status of record i: empty, deleted, or full
+ *   with a 7-bit tag extracted from the key (see hash_groups.h)
+ * - the value of a full record is non-negative. Empty and deleted
+ *   records have unspecified content.
  * Other fields:
- * - size = size of the record array
+ * - size = size of the record array (at least HGROUP_SIZE)
  * - nelems = number of elements actually stored
  * - ndeleted = number of deleted elements
  *
@@ -62,6 +63,7 @@ enum {
 
 typedef struct int_htbl_s {
   int_hrec_t *records;
+  uint8_t *ctrl;
   uint32_t size;
   uint32_t nelems;
   uint32_t ndeleted;
@@ -116,6 +118,7 @@ typedef struct int_hobj_s {
 /*
  * Initialize: empty table of size n (n must be a power of 2)
  * If n = 0, the default initial size is used = 64.
+ * If n is less than HGROUP_SIZE (16), the size is 16.
  */
 extern void init_int_htbl(int_htbl_t *table, uint32_t n);
 
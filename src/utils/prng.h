@@ -29,7 +29,8 @@
  *
  * Note: the state of the PRNG (variable seed) is local.
  * So every file that imports this will have its own copy of the PRNG,
- * and all copies have the same default seed.
+ * and all copies have the same default seed. In the thread-safe
+ * build, each thread also has its own copy.
  */
 
 #ifndef __PRNG_H
@@ -37,12 +38,14 @@
 
 #include <stdint.h>
 
+#include "utils/thread_local.h"
+
 #define PRNG_MULTIPLIER 1664525
 #define PRNG_CONSTANT   1013904223
 
 #define PRNG_DEFAULT_SEED 0xabcdef98
 
-static uint32_t seed = PRNG_DEFAULT_SEED; // default seed
+static YICES_THREAD_LOCAL uint32_t seed = PRNG_DEFAULT_SEED; // default seed
 
 static inline void random_seed(uint32_t s) {
   seed = s;
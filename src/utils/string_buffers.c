@@ -120,6 +120,13 @@ void string_buffer_append_string(string_buffer_t *s, const char *s1) {
   s->index += n;
 }
 
+// append a[0 ... n-1] to s
+void string_buffer_append_chars(string_buffer_t *s, const char *a, uint32_t n) {
+  string_buffer_extend(s, n);
+  memcpy(s->data + s->index, a, n);
+  s->index += n;
+}
+
 void string_buffer_append_buffer(string_buffer_t *s, string_buffer_t *s1) {
   uint32_t n;
 
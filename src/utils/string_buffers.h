@@ -77,6 +77,7 @@ extern void string_buffer_close(string_buffer_t *s);
  */
 extern void string_buffer_append_char(string_buffer_t *s, char c);
 extern void string_buffer_append_string(string_buffer_t *s, const char *s1);
+extern void string_buffer_append_chars(string_buffer_t *s, const char *a, uint32_t n);
 extern void string_buffer_append_buffer(string_buffer_t *s, string_buffer_t *s1);
 extern void string_buffer_append_int32(string_buffer_t *s, int32_t x);
 extern void string_buffer_append_uint32(string_buffer_t *s, uint32_t x);
@@ -365,6 +365,25 @@ void stbl_delete_mapping(stbl_t *sym_table, const char *symbol, int32_t val) {
 }
 
 
+/*
+ * Check whether (symbol, value) is present (hidden or not).
+ */
+bool stbl_has_mapping(stbl_t *sym_table, const char *symbol, int32_t val) {
+  uint32_t h, mask, i;
+  stbl_rec_t *r;
+
+  mask = sym_table->size - 1;
+  h = jenkins_hash_string(symbol);
+  i = h & mask;
+  for (r = sym_table->data[i]; r != NULL; r = r->next) {
+    if (r->hash == h && r->value == val && strcmp(symbol, r->string) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 
 /*
  * Check whether the list sym_table->data[i] has many duplicates
@@ -526,6 +545,7 @@ void stbl_remove_records(stbl_t *sym_table, void *aux, stbl_filter_t f) {
 	// keep r
 	*q = r;
 	q = &r->next;
+	r = p;
       }
     }
     *q = NULL;
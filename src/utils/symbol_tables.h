@@ -173,6 +173,12 @@ extern void stbl_add(stbl_t *sym_table, char *symbol, int32_t val);
  */
 extern void stbl_delete_mapping(stbl_t *sym_table, const char *symbol, int32_t val);
 
+/*
+ * Check whether the mapping symbol --> val is in the table
+ * (it may be hidden by a more recent mapping for symbol).
+ */
+extern bool stbl_has_mapping(stbl_t *sym_table, const char *symbol, int32_t val);
+
 /*
  * Iterator: call f(aux, r) for every live record r in the table
  * - aux is an arbitrary pointer, provided by the caller
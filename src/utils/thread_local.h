@@ -0,0 +1,48 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * THREAD-LOCAL VARIABLES
+ */
+
+/*
+ * If THREAD_SAFE is defined, YICES_THREAD_LOCAL declares a variable
+ * with one copy per thread. It expands to nothing otherwise.
+ *
+ * This is used for static data in the solvers (e.g., hash-consing
+ * descriptors), since contexts can be checked in parallel.
+ */
+
+#ifndef __THREAD_LOCAL_H
+#define __THREAD_LOCAL_H
+
+#ifdef THREAD_SAFE
+
+#ifdef MINGW
+#define YICES_THREAD_LOCAL __declspec(thread)
+#else
+#define YICES_THREAD_LOCAL __thread
+#endif
+
+#else
+
+#define YICES_THREAD_LOCAL
+
+#endif
+
+#endif /* __THREAD_LOCAL_H */
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * LOCKS FOR THE THREAD-SAFE BUILD
+ */
+
+/*
+ * If Yices is configured with --enable-thread-safety, then THREAD_SAFE
+ * is defined and the global data structures (term and type tables, term
+ * manager, bank of GMP rationals, bitvector-constant allocator) are
+ * protected by locks. This module provides a minimal lock abstraction:
+ *
+ * 1) create_yices_lock(lock): initialize a lock (recursive: the
+ *    thread that holds the lock can acquire it again).
+ * 2) destroy_yices_lock(lock): delete it.
+ * 3) get_yices_lock(lock): acquire the lock (blocking).
+ * 4) release_yices_lock(lock): release it.
+ *
+ * The implementation uses pthread mutexes on Unix and critical
+ * sections on Windows.
+ *
+ * If THREAD_SAFE is not defined, the lock operations do nothing.
+ *
+ * YICES_THREAD_LOCAL (cf. thread_local.h) can be used to declare
+ * thread-local variables.
+ */
+
+#ifndef __YICES_LOCKS_H
+#define __YICES_LOCKS_H
+
+#include "utils/thread_local.h"
+
+#ifdef THREAD_SAFE
+
+#ifdef MINGW
+#include <windows.h>
+typedef CRITICAL_SECTION yices_lock_t;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t yices_lock_t;
+#endif
+
+extern void create_yices_lock(yices_lock_t *lock);
+extern void destroy_yices_lock(yices_lock_t *lock);
+extern void get_yices_lock(yices_lock_t *lock);
+extern void release_yices_lock(yices_lock_t *lock);
+
+#else
+
+typedef int yices_lock_t;
+
+static inline void create_yices_lock(yices_lock_t *lock) {}
+static inline void destroy_yices_lock(yices_lock_t *lock) {}
+static inline void get_yices_lock(yices_lock_t *lock) {}
+static inline void release_yices_lock(yices_lock_t *lock) {}
+
+#endif
+
+
+#endif /* __YICES_LOCKS_H */
@@ -0,0 +1,21 @@
+(set-logic QF_BV)
+(set-option :yices-cube-depth 3)
+(declare-fun x () (_ BitVec 24))
+(declare-fun y () (_ BitVec 24))
+(assert (bvult #x000001 x))
+(assert (bvult #x000001 y))
+(assert (bvult x #x001000))
+(assert (bvult y #x001000))
+(push 1)
+(assert (= (bvmul x y) #x3d0925))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvmul x y) #x7f581b))
+(assert (bvule x y))
+(check-sat)
+(get-value (x y))
+(pop 1)
+(assert (= (bvmul x y) #x000000))
+(check-sat)
+(get-option :yices-cube-depth)
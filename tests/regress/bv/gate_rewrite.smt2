@@ -0,0 +1,18 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(define-fun a () (_ BitVec 8) (bvand (bvor x (bvnot y)) (bvor x z)))
+(define-fun b () (_ BitVec 8) (bvor (bvand a (bvnot x)) (bvand a x)))
+(push 1)
+(assert (distinct a (bvand (bvor a (bvand x y)) (bvor a (bvnot z)))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (distinct b (bvor (bvand b y) (bvand b (bvnot y)))))
+(check-sat)
+(pop 1)
+(assert (distinct (bvor (bvand a y) (bvand a (bvnot y))) (bvxor b #x10)))
+(check-sat)
+(assert (= (bvand x y) #xff))
+(check-sat)
@@ -0,0 +1,27 @@
+(set-logic QF_BV)
+(set-option :yices-bv-lazy-blasting true)
+(declare-fun s () (_ BitVec 8))
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 32))
+(assert (bvugt s #x10))
+(assert (= z (ite (= s #x01) (bvudiv x y) (ite (= s #x02) (bvmul x y) (bvadd x y)))))
+(assert (bvult z #x00000010))
+(check-sat)
+(push 1)
+(assert (= (bvmul x y) #x00000007))
+(assert (= (bvurem x #x00000003) #x00000001))
+(assert (bvult x y))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvmul x y) #x0000000d))
+(assert (bvugt x #x00000001))
+(assert (bvugt y #x00000001))
+(assert (bvult x #x00001000))
+(assert (bvult y #x00001000))
+(check-sat)
+(pop 1)
+(assert (= (bvsdiv x #x00000005) #xfffffffe))
+(assert (= (bvsrem x #x00000005) #xfffffffd))
+(check-sat)
@@ -0,0 +1,14 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 32))
+(define-fun X () (_ BitVec 256) ((_ zero_extend 224) x))
+(define-fun Y () (_ BitVec 256) ((_ zero_extend 224) y))
+(define-fun Z () (_ BitVec 256) ((_ zero_extend 224) z))
+(define-fun x96 () (_ BitVec 96) ((_ zero_extend 64) x))
+(define-fun y96 () (_ BitVec 96) ((_ zero_extend 64) y))
+(define-fun z96 () (_ BitVec 96) ((_ zero_extend 64) z))
+(assert (or (not (= (bvadd (bvmul X Y) Z) ((_ zero_extend 160) (bvadd (bvmul x96 y96) z96))))
+            (not (= (bvmul (bvmul X Y) Z) ((_ zero_extend 160) (bvmul (bvmul x96 y96) z96))))
+            (bvuge (bvadd (bvmul X Y) Z) #x0000000000000000000000000000000000000000000000020000000000000000)))
+(check-sat)
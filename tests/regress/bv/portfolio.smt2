@@ -0,0 +1,19 @@
+(set-option :produce-models true)
+(set-logic QF_BV)
+
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+
+(assert (= (bvmul x #x0005) #x00ff))
+(assert (= y (bvadd x #x0001)))
+(check-sat)
+(get-value (x y))
+
+(push 1)
+(assert (bvult y x))
+(check-sat)
+(pop 1)
+
+(assert (bvult x #x1000))
+(check-sat)
+(get-value (x y))
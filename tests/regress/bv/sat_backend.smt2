@@ -0,0 +1,14 @@
+(set-option :produce-models true)
+(set-logic QF_BV)
+
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+
+(assert (= (bvmul x y) #x0f0f))
+(assert (bvult #x0001 x))
+(assert (bvult #x0001 y))
+(assert (bvult x y))
+(assert (= z (bvxor x y)))
+(check-sat)
+(get-value ((bvmul x y) (bvult x y) (= z (bvxor x y))))
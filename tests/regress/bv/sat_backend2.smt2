@@ -0,0 +1,20 @@
+(set-option :produce-models true)
+(set-logic QF_BV)
+
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+
+(assert (= (bvadd x y) #x10))
+(assert (= (bvand x #x0f) #x03))
+
+(push 1)
+(assert (= (bvadd x y) (bvadd y #x0f)))
+(check-sat)
+(pop 1)
+
+(check-sat)
+(get-value ((bvadd x y) (bvand x #x0f)))
+
+(assert (bvult y #x0e))
+(check-sat)
+(get-value (x y))
@@ -0,0 +1,19 @@
+;;
+;; SAT backend: the problem has many models. The model found by the
+;; backend is installed in the core and returned as is.
+;;
+(set-option :produce-models true)
+(set-logic QF_BV)
+
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 32))
+
+(assert (bvult x y))
+(assert (= (bvadd x y z) #xdeadbeef))
+(assert (not (= (bvmul x z) #x00000000)))
+(assert (bvult (bvlshr y #x00000010) (bvand z #x0000ffff)))
+(assert (bvugt (bvmul y z) #x80000000))
+(check-sat)
+(get-value (x y z))
+(get-value ((bvult x y) (bvadd x y z) (bvmul x z)))
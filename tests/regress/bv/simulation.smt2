@@ -0,0 +1,18 @@
+(set-logic QF_BV)
+(set-option :yices-bv-simulation 4)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+(assert (= (bvand (bvor x y) (bvnot z)) (bvxor (bvadd x z) y)))
+(check-sat)
+(push 1)
+(assert (bvult (bvmul x y) z))
+(assert (distinct x #x0000))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvadd x y) (bvadd y x #x0001)))
+(check-sat)
+(pop 1)
+(assert (bvugt z #x00ff))
+(check-sat)
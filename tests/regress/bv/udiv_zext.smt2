@@ -0,0 +1,12 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 12))
+(declare-fun y () (_ BitVec 12))
+(define-fun X () (_ BitVec 64) ((_ zero_extend 52) x))
+(define-fun Y () (_ BitVec 64) ((_ zero_extend 52) y))
+(define-fun y4 () (_ BitVec 4) ((_ extract 3 0) y))
+(assert (or (not (= (bvudiv X Y) (ite (= y #x000) #xffffffffffffffff ((_ zero_extend 52) (bvudiv x y)))))
+            (not (= (bvurem X Y) ((_ zero_extend 52) (bvurem x y))))
+            (not (= (bvudiv X #x0000000000000000) #xffffffffffffffff))
+            (not (= (bvudiv ((_ zero_extend 60) y4) X) (ite (= x #x000) #xffffffffffffffff ((_ zero_extend 52) (bvudiv ((_ zero_extend 8) y4) x)))))
+            (not (= (bvurem X ((_ zero_extend 60) y4)) ((_ zero_extend 52) (bvurem x ((_ zero_extend 8) y4)))))))
+(check-sat)
@@ -0,0 +1,8 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun q () (_ BitVec 256))
+(assert (= q (bvudiv ((_ zero_extend 224) x) ((_ zero_extend 224) y))))
+(assert (= q #x0000000000000000000000000000000000000000000000000000000000000007))
+(assert (bvugt y #x00001000))
+(check-sat)
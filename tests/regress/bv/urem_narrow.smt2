@@ -0,0 +1,7 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 128))
+(declare-fun b () (_ BitVec 128))
+(define-fun r () (_ BitVec 128) (bvurem a #x000000000000000000000000000003e8))
+(define-fun s () (_ BitVec 128) (bvurem b #x00000000000000000000000000000007))
+(assert (= (bvmul r s) #x00000000000000000000000000001b58))
+(check-sat)
@@ -0,0 +1,8 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvmul x y) #x0f))
+(assert (= x #x03))
+(assert (bvult y #x05))
+(check-sat)
+(exit)
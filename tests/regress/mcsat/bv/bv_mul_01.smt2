@@ -0,0 +1,8 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 64))
+(declare-fun b () (_ BitVec 64))
+(assert (= (bvmul a b) #x0000000000000006))
+(assert (bvugt a #x0000000000000001))
+(assert (bvugt b #x0000000000000001))
+(check-sat)
+(exit)
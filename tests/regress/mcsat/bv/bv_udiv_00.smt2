@@ -0,0 +1,9 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvudiv x y) #x07))
+(assert (= (bvurem x y) #x02))
+(assert (= y #x05))
+(assert (not (= x #x25)))
+(check-sat)
+(exit)
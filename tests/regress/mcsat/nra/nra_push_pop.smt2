@@ -0,0 +1,22 @@
+(set-logic QF_NRA)
+(set-info :smt-lib-version 2.0)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (> (* x x) 2))
+(push 1)
+(assert (< (* x x) 1))
+(check-sat)
+(pop 1)
+(check-sat)
+(push 1)
+(assert (= (* x y) 1))
+(assert (= y 0))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (< x 0))
+(assert (< (* x y) 0))
+(check-sat)
+(pop 1)
+(check-sat)
+(exit)
@@ -0,0 +1,25 @@
+(set-option :produce-unsat-cores true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (! (> x 10) :named a1))
+(assert (! (< y 0) :named a2))
+(assert (=> p (< x 5)))
+(assert (=> q (> y 3)))
+(check-sat)
+(check-sat-assuming (p))
+(get-unsat-assumptions)
+(get-unsat-core)
+(check-sat-assuming ((not p) q))
+(get-unsat-assumptions)
+(get-unsat-core)
+(push 1)
+(assert (! (< x 0) :named a3))
+(check-sat)
+(get-unsat-core)
+(pop 1)
+(check-sat)
+(check-sat-assuming ())
+(get-unsat-core)
@@ -0,0 +1,26 @@
+(set-option :produce-models true)
+(set-option :produce-unsat-cores true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (= z (+ (* 3 x) (* 5 y))))
+(assert (and (<= 0 x) (<= x 10) (<= 0 y) (<= y 10)))
+(assert (=> p (= z 13)))
+(assert (=> q (>= x 4)))
+(check-sat-assuming (p))
+(get-value (x y z))
+(check-sat-assuming (p q))
+(check-sat-assuming (q))
+(get-value ((>= x 4)))
+(push 1)
+(assert (! (> x 8) :named c1))
+(assert (! (< y 2) :named c2))
+(assert (! (< x 5) :named c3))
+(check-sat)
+(get-unsat-core)
+(pop 1)
+(assert (= z 7))
+(check-sat)
@@ -0,0 +1,12 @@
+(set-option :produce-unsat-cores true)
+(set-logic QF_UF)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(declare-fun r () Bool)
+(assert (! (or p q) :named c1))
+(assert (! (not p) :named c2))
+(assert (! r :named c3))
+(assert (! (not q) :named c4))
+(check-sat)
+(get-unsat-core)
+(get-option :produce-unsat-cores)
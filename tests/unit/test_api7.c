@@ -220,6 +220,8 @@ static void show_config(ctx_config_t *config) {
   printf("  array solver = %s\n", solver_code2string[config->array_config]);
   printf("  bv solver = %s\n", solver_code2string[config->bv_config]);
   printf("  arith solver = %s\n", solver_code2string[config->arith_config]);
+  printf("  portfolio = %"PRIu32"\n", config->portfolio_size);
+  printf("  sat backend = %s\n", config->sat_backend ? "true" : "false");
   printf("\n");
   fflush(stdout);
 }
@@ -368,6 +370,16 @@ static void test_set_configs(ctx_config_t *config) {
   test_set_config(config, "arith-solver", "rfw", 0, 0);
   test_set_config(config, "arith-solver", "xxxx", -1, CTX_INVALID_PARAMETER_VALUE);
 
+  test_set_config(config, "portfolio", "4", 0, 0);
+  test_set_config(config, "portfolio", "1", 0, 0);
+  test_set_config(config, "portfolio", "0", -1, CTX_INVALID_PARAMETER_VALUE);
+  test_set_config(config, "portfolio", "100000", -1, CTX_INVALID_PARAMETER_VALUE);
+  test_set_config(config, "portfolio", "xxxx", -1, CTX_INVALID_PARAMETER_VALUE);
+
+  test_set_config(config, "sat-backend", "true", 0, 0);
+  test_set_config(config, "sat-backend", "false", 0, 0);
+  test_set_config(config, "sat-backend", "xxxx", -1, CTX_INVALID_PARAMETER_VALUE);
+
   // yices_set_config is not intended to be used for setting the logic
   // so "logic" should not be recognized as a value parameter here.
   test_set_config(config, "logic", "QF_UFLIA", -1, CTX_UNKNOWN_PARAMETER);
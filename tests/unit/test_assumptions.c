@@ -0,0 +1,180 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST CHECK WITH ASSUMPTIONS AND UNSAT CORES
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+/*
+ * Check whether t is in vector v
+ */
+static bool in_vector(term_vector_t *v, term_t t) {
+  uint32_t i;
+
+  for (i=0; i<v->size; i++) {
+    if (v->data[i] == t) return true;
+  }
+  return false;
+}
+
+
+/*
+ * Check that the status is as expected
+ */
+static void check_status(smt_status_t stat, smt_status_t expected, const char *msg) {
+  if (stat != expected) {
+    fprintf(stderr, "%s: status = %d, expected %d\n", msg, (int) stat, (int) expected);
+    yices_print_error(stderr);
+    exit(1);
+  }
+}
+
+
+/*
+ * Basic test: x > 10, and assumptions a => x < 5, b => x > 20, c
+ * - assuming {c, a} is unsat with core {a}
+ * - assuming {b, c} is sat
+ * - we can keep asserting formulas after an unsat check
+ */
+static void test_assumptions(context_t *ctx) {
+  term_vector_t core;
+  term_t x, a, b, c, f, assumptions[3];
+  smt_status_t stat;
+  int32_t code;
+
+  x = yices_new_uninterpreted_term(yices_int_type());
+  a = yices_new_uninterpreted_term(yices_bool_type());
+  b = yices_new_uninterpreted_term(yices_bool_type());
+  c = yices_new_uninterpreted_term(yices_bool_type());
+  yices_set_term_name(a, "a");
+  yices_set_term_name(b, "b");
+  yices_set_term_name(c, "c");
+
+  f = yices_arith_gt_atom(x, yices_int32(10));
+  code = yices_assert_formula(ctx, f);
+  if (code < 0) goto error;
+  f = yices_implies(a, yices_arith_lt_atom(x, yices_int32(5)));
+  code = yices_assert_formula(ctx, f);
+  if (code < 0) goto error;
+  f = yices_implies(b, yices_arith_gt_atom(x, yices_int32(20)));
+  code = yices_assert_formula(ctx, f);
+  if (code < 0) goto error;
+
+  yices_init_term_vector(&core);
+
+  assumptions[0] = c;
+  assumptions[1] = a;
+  stat = yices_check_context_with_assumptions(ctx, NULL, 2, assumptions);
+  check_status(stat, STATUS_UNSAT, "check assuming {c, a}");
+  code = yices_get_unsat_core(ctx, &core);
+  if (code < 0) goto error;
+  if (core.size != 1 || !in_vector(&core, a)) {
+    fprintf(stderr, "bad unsat core: size = %"PRIu32"\n", core.size);
+    exit(1);
+  }
+  printf("unsat core for {c, a}: ok\n");
+
+  assumptions[0] = b;
+  assumptions[1] = c;
+  stat = yices_check_context_with_assumptions(ctx, NULL, 2, assumptions);
+  check_status(stat, STATUS_SAT, "check assuming {b, c}");
+  printf("check assuming {b, c}: ok\n");
+
+  // the context is not unsat
+  code = yices_get_unsat_core(ctx, &core);
+  if (code >= 0) {
+    fprintf(stderr, "get_unsat_core should fail after sat\n");
+    exit(1);
+  }
+
+  // all three assumptions: core must not contain c
+  assumptions[0] = a;
+  assumptions[1] = b;
+  assumptions[2] = c;
+  stat = yices_check_context_with_assumptions(ctx, NULL, 3, assumptions);
+  check_status(stat, STATUS_UNSAT, "check assuming {a, b, c}");
+  code = yices_get_unsat_core(ctx, &core);
+  if (code < 0) goto error;
+  if (core.size == 0 || in_vector(&core, c)) {
+    fprintf(stderr, "bad unsat core for {a, b, c}\n");
+    exit(1);
+  }
+  printf("unsat core for {a, b, c}: ok\n");
+
+  // assert not b then check without assumptions
+  code = yices_assert_formula(ctx, yices_not(b));
+  if (code < 0) goto error;
+  stat = yices_check_context(ctx, NULL);
+  check_status(stat, STATUS_SAT, "check after assert");
+
+  // inconsistent assumptions: b is now false
+  assumptions[0] = b;
+  stat = yices_check_context_with_assumptions(ctx, NULL, 1, assumptions);
+  check_status(stat, STATUS_UNSAT, "check assuming {b}");
+  code = yices_get_unsat_core(ctx, &core);
+  if (code < 0) goto error;
+  if (core.size != 1 || core.data[0] != b) {
+    fprintf(stderr, "bad unsat core for {b}\n");
+    exit(1);
+  }
+  printf("unsat core for {b}: ok\n");
+
+  yices_delete_term_vector(&core);
+  return;
+
+ error:
+  yices_print_error(stderr);
+  exit(1);
+}
+
+
+int main(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  yices_init();
+
+  // default context
+  ctx = yices_new_context(NULL);
+  test_assumptions(ctx);
+  yices_free_context(ctx);
+
+  // push/pop context with clean interrupts
+  config = yices_new_config();
+  yices_set_config(config, "mode", "interactive");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  yices_push(ctx);
+  test_assumptions(ctx);
+  yices_pop(ctx);
+  yices_free_context(ctx);
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test multiplication, division, and remainder of bit-vector constants
+ * against GMP, for sizes that exercise the 128bit and 64bit-limb code.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <gmp.h>
+
+#include "terms/bv_constants.h"
+#include "utils/cputime.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define MAXWORDS 8
+
+static uint32_t a[MAXWORDS], b[MAXWORDS], c[MAXWORDS], d[MAXWORDS];
+static mpz_t za, zb, zc, zr, pow2;
+static uint32_t nerrors;
+
+
+/*
+ * Random n-bit constant: mostly random words, sometimes
+ * a special value (0, 1, -1, min_signed, max_signed)
+ */
+static void random_constant(uint32_t *x, uint32_t n) {
+  uint32_t i, k;
+
+  k = (n + 31) >> 5;
+  switch (random() % 8) {
+  case 0:
+    bvconst_clear(x, k);
+    break;
+  case 1:
+    bvconst_set_one(x, k);
+    break;
+  case 2:
+    bvconst_set_minus_one(x, k);
+    break;
+  case 3:
+    bvconst_set_min_signed(x, n);
+    break;
+  case 4:
+    bvconst_set_max_signed(x, n);
+    break;
+  default:
+    for (i=0; i<k; i++) {
+      x[i] = (((uint32_t) random()) << 16) ^ ((uint32_t) random());
+    }
+    break;
+  }
+  bvconst_normalize(x, n);
+}
+
+
+/*
+ * z := x interpreted as an unsigned or signed n-bit integer
+ */
+static void get_unsigned(mpz_t z, uint32_t *x, uint32_t n) {
+  bvconst_get_mpz(x, (n + 31) >> 5, z);
+}
+
+static void get_signed(mpz_t z, uint32_t *x, uint32_t n) {
+  get_unsigned(z, x, n);
+  if (bvconst_tst_bit(x, n-1)) {
+    mpz_sub(z, z, pow2);
+  }
+}
+
+
+/*
+ * Check that x is equal to z modulo 2^n
+ */
+static void check(const char *op, uint32_t *x, mpz_t z, uint32_t n) {
+  mpz_fdiv_r_2exp(z, z, n);
+  get_unsigned(zr, x, n);
+  if (mpz_cmp(z, zr) != 0 || !bvconst_is_normalized(x, n)) {
+    printf("*** BUG: %s, n = %"PRIu32"\n", op, n);
+    printf("   a = "); bvconst_print(stdout, a, n); printf("\n");
+    printf("   b = "); bvconst_print(stdout, b, n); printf("\n");
+    printf("   got "); bvconst_print(stdout, x, n); printf("\n");
+    nerrors ++;
+  }
+}
+
+
+static void test_ops(uint32_t n) {
+  uint32_t k;
+
+  k = (n + 31) >> 5;
+  mpz_set_ui(pow2, 1);
+  mpz_mul_2exp(pow2, pow2, n);
+
+  random_constant(a, n);
+  random_constant(b, n);
+  random_constant(c, n);
+
+  // mul2, mul, addmul, submul
+  bvconst_mul2(d, k, a, b);
+  bvconst_normalize(d, n);
+  get_unsigned(za, a, n);
+  get_unsigned(zb, b, n);
+  mpz_mul(zc, za, zb);
+  check("mul2", d, zc, n);
+
+  bvconst_set(d, k, a);
+  bvconst_mul(d, k, b);
+  bvconst_normalize(d, n);
+  mpz_mul(zc, za, zb);
+  check("mul", d, zc, n);
+
+  bvconst_set(d, k, c);
+  bvconst_addmul(d, k, a, b);
+  bvconst_normalize(d, n);
+  get_unsigned(zc, c, n);
+  mpz_addmul(zc, za, zb);
+  check("addmul", d, zc, n);
+
+  bvconst_set(d, k, c);
+  bvconst_submul(d, k, a, b);
+  bvconst_normalize(d, n);
+  get_unsigned(zc, c, n);
+  mpz_submul(zc, za, zb);
+  check("submul", d, zc, n);
+
+  if (bvconst_is_zero(b, k)) return;
+
+  // unsigned division
+  bvconst_udiv2(d, n, a, b);
+  mpz_fdiv_q(zc, za, zb);
+  check("udiv", d, zc, n);
+
+  bvconst_urem2(d, n, a, b);
+  mpz_fdiv_r(zc, za, zb);
+  check("urem", d, zc, n);
+
+  // signed division
+  get_signed(za, a, n);
+  get_signed(zb, b, n);
+
+  bvconst_sdiv2(d, n, a, b);
+  mpz_tdiv_q(zc, za, zb);
+  check("sdiv", d, zc, n);
+
+  bvconst_srem2(d, n, a, b);
+  mpz_tdiv_r(zc, za, zb);
+  check("srem", d, zc, n);
+
+  bvconst_smod2(d, n, a, b);
+  mpz_fdiv_r(zc, za, zb);
+  check("smod", d, zc, n);
+}
+
+
+/*
+ * Time n multiplications and divisions of size n
+ */
+static void bench(uint32_t n, uint32_t iters) {
+  double start, mul_time, div_time;
+  uint32_t i, k;
+
+  k = (n + 31) >> 5;
+  random_constant(a, n);
+  random_constant(b, n);
+  bvconst_set_one(c, k);
+  b[0] |= 1;
+
+  start = get_cpu_time();
+  for (i=0; i<iters; i++) {
+    bvconst_mul(c, k, a);
+    bvconst_addmul(c, k, b, a);
+  }
+  mul_time = get_cpu_time() - start;
+
+  start = get_cpu_time();
+  for (i=0; i<iters; i++) {
+    bvconst_urem2(d, n, a, b);
+    bvconst_sdiv2(d, n, a, b);
+  }
+  div_time = get_cpu_time() - start;
+
+  printf("n = %3"PRIu32": %"PRIu32" mul+addmul: %.3f s, %"PRIu32" urem+sdiv: %.3f s\n",
+         n, iters, mul_time, iters, div_time);
+}
+
+
+int main(void) {
+  static const uint32_t sizes[] = { 33, 63, 64, 65, 95, 96, 100, 127, 128, 129, 160, 192, 255, 256 };
+  uint32_t i, j;
+
+  init_bvconstants();
+  mpz_init(za);
+  mpz_init(zb);
+  mpz_init(zc);
+  mpz_init(zr);
+  mpz_init(pow2);
+
+  nerrors = 0;
+  for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    for (j=0; j<20000; j++) {
+      test_ops(sizes[i]);
+    }
+  }
+  printf("%"PRIu32" errors\n", nerrors);
+
+  bench(128, 1000000);
+  bench(256, 1000000);
+
+  mpz_clear(za);
+  mpz_clear(zb);
+  mpz_clear(zc);
+  mpz_clear(zr);
+  mpz_clear(pow2);
+  cleanup_bvconstants();
+
+  return nerrors == 0 ? 0 : 1;
+}
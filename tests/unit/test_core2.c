@@ -235,7 +235,7 @@ static void sat_solve(smt_core_t *core, core_param_t *params, bool verbose) {
   }
 
   // initialize then do a propagation + simplification step.
-  start_search(core);
+  start_search(core, 0, NULL);
   smt_process(core);
   if (verbose) {
     show_progress(core, d_threshold, reduce_threshold, true);
@@ -541,6 +541,9 @@ static void print_results(smt_core_t *core, double construction_time, double sea
   stat = &core->stats;
   show_stats(stat);
   printf("Search time             : %.4f s\n", search_time);
+  if (search_time > 0) {
+    printf("Propagations/s          : %.0f\n", stat->propagations / search_time);
+  }
   mem_used = mem_size() / (1024 * 1024);
   if (mem_used > 0) {
     printf("Memory used             : %.2f MB\n", mem_used);
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST LAZY BIT-BLASTING IN ONE-SHOT CONTEXTS
+ *
+ * In one-shot mode, the core can eliminate variables during
+ * inprocessing. The deferred multiplications and divisions are
+ * expanded in final_check so this must not remove their bits.
+ * Each problem is solved with and without lazy bit-blasting and
+ * the results must agree. Models are checked by evaluation.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+/*
+ * Value of a 32-bit variable in model mdl
+ */
+static uint32_t get_value32(model_t *mdl, term_t x) {
+  int32_t bits[32];
+  uint32_t i, v;
+
+  if (yices_get_bv_value(mdl, x, bits) < 0) {
+    yices_print_error(stderr);
+    exit(1);
+  }
+  v = 0;
+  for (i=0; i<32; i++) {
+    v |= ((uint32_t) bits[i]) << i;
+  }
+  return v;
+}
+
+
+/*
+ * Assert x * y = c, x > 1, y > 1, x and y < 2^16
+ * and x mod d = r (the urem is deferred too).
+ */
+static void assert_problem(context_t *ctx, term_t x, term_t y, uint32_t c, uint32_t d, uint32_t r) {
+  term_t a[6];
+
+  a[0] = yices_bveq_atom(yices_bvmul(x, y), yices_bvconst_uint32(32, c));
+  a[1] = yices_bvgt_atom(x, yices_bvconst_uint32(32, 1));
+  a[2] = yices_bvgt_atom(y, yices_bvconst_uint32(32, 1));
+  a[3] = yices_bvlt_atom(x, yices_bvconst_uint32(32, 0x10000));
+  a[4] = yices_bvlt_atom(y, yices_bvconst_uint32(32, 0x10000));
+  a[5] = yices_bveq_atom(yices_bvrem(x, yices_bvconst_uint32(32, d)), yices_bvconst_uint32(32, r));
+  if (yices_assert_formulas(ctx, 6, a) < 0) {
+    yices_print_error(stderr);
+    exit(1);
+  }
+}
+
+
+/*
+ * Solve the problem in a new one-shot context
+ * - lazy: whether to use lazy bit-blasting
+ * - if the result is sat, check the model
+ */
+static smt_status_t solve(bool lazy, uint32_t c, uint32_t d, uint32_t r) {
+  ctx_config_t *config;
+  param_t *params;
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y;
+  uint32_t vx, vy;
+  smt_status_t stat;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_BV");
+  yices_set_config(config, "mode", "one-shot");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  yices_set_param(params, "bv-lazy-blasting", lazy ? "true" : "false");
+
+  x = yices_new_uninterpreted_term(yices_bv_type(32));
+  y = yices_new_uninterpreted_term(yices_bv_type(32));
+  assert_problem(ctx, x, y, c, d, r);
+
+  stat = yices_check_context(ctx, params);
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    vx = get_value32(mdl, x);
+    vy = get_value32(mdl, y);
+    if (vx * vy != c || vx <= 1 || vy <= 1 || vx >= 0x10000 || vy >= 0x10000 || vx % d != r) {
+      fprintf(stderr, "bad model for %"PRIu32" (mod %"PRIu32" = %"PRIu32"): x = %"PRIu32", y = %"PRIu32" (lazy = %d)\n",
+              c, d, r, vx, vy, (int) lazy);
+      exit(1);
+    }
+    yices_free_model(mdl);
+  } else if (stat != STATUS_UNSAT) {
+    fprintf(stderr, "unexpected status %d for %"PRIu32"\n", (int) stat, c);
+    yices_print_error(stderr);
+    exit(1);
+  }
+
+  yices_free_param_record(params);
+  yices_free_context(ctx);
+
+  return stat;
+}
+
+
+static void test_problem(uint32_t c, uint32_t d, uint32_t r) {
+  smt_status_t s1, s2;
+
+  s1 = solve(false, c, d, r);
+  s2 = solve(true, c, d, r);
+  if (s1 != s2) {
+    fprintf(stderr, "status mismatch for %"PRIu32" (mod %"PRIu32" = %"PRIu32"): eager = %d, lazy = %d\n",
+            c, d, r, (int) s1, (int) s2);
+    exit(1);
+  }
+  printf("x * y = %"PRIu32", x mod %"PRIu32" = %"PRIu32": %s\n", c, d, r, s1 == STATUS_SAT ? "sat" : "unsat");
+}
+
+
+int main(void) {
+  uint32_t i, p, q;
+
+  yices_init();
+
+  // primes: unsat (x = 1 is excluded by x > 1)
+  test_problem(65521, 7, 3);
+  test_problem(65521, 7, 1);
+  test_problem(13, 3, 1);
+  test_problem(2147483647u, 3, 1);
+
+  // small products
+  test_problem(4, 3, 2);
+  test_problem(15, 3, 0);
+
+  // semiprimes: sat or unsat depending on the residue
+  srand(1234);
+  for (i=0; i<10; i++) {
+    p = 257 + 2 * (rand() % 32000);
+    q = 257 + 2 * (rand() % 32000);
+    test_problem(p * q, 3 + (i % 5), rand() % (3 + (i % 5)));
+  }
+
+  yices_exit();
+
+  printf("All tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST REPEATED VALUE QUERIES ON A MODEL
+ *
+ * The model keeps its evaluation cache between queries: check that
+ * the values are correct, that yices_get_value_array agrees with
+ * yices_get_value, and that the cache survives garbage collection.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+#include "utils/cputime.h"
+
+
+#define N 2000
+
+static term_t chain[N];
+static int32_t expected[N];
+static yval_t val[N];
+static uint32_t nerrors;
+
+
+/*
+ * Model: x_i = i for i=0 ... N-1
+ */
+static model_t *build_model(term_t *x) {
+  term_t y[N];
+  type_t bv32;
+  uint32_t i;
+
+  bv32 = yices_bv_type(32);
+  for (i=0; i<N; i++) {
+    x[i] = yices_new_uninterpreted_term(bv32);
+    y[i] = yices_bvconst_uint32(32, i);
+  }
+  return yices_model_from_map(N, x, y);
+}
+
+/*
+ * chain[i] = max(x_0, ..., x_i) built as a DAG of if-then-elses:
+ *   chain[i] = (ite (bvult chain[i-1] x_i) x_i chain[i-1])
+ * or, if flip is true
+ *   chain[i] = (ite (bvuge chain[i-1] x_i) chain[i-1] x_i)
+ * Each chain[i] occurs twice in chain[i+1] so evaluating all the
+ * chain terms without a cache would be quadratic.
+ */
+static void build_chain(term_t *x, bool flip) {
+  term_t t;
+  uint32_t i;
+
+  t = x[0];
+  chain[0] = t;
+  expected[0] = 0;
+  for (i=1; i<N; i++) {
+    if (flip) {
+      t = yices_ite(yices_bvge_atom(t, x[i]), t, x[i]);
+    } else {
+      t = yices_ite(yices_bvlt_atom(t, x[i]), x[i], t);
+    }
+    chain[i] = t;
+    expected[i] = i;
+  }
+}
+
+
+static void check_value(model_t *mdl, uint32_t i, const char *what) {
+  int32_t b[32];
+  int32_t v;
+  uint32_t k;
+
+  if (yices_get_bv_value(mdl, chain[i], b) < 0) {
+    printf("*** BUG: %s: evaluation failed for chain[%"PRIu32"]\n", what, i);
+    nerrors ++;
+    return;
+  }
+  v = 0;
+  for (k=0; k<32; k++) {
+    v |= b[k] << k;
+  }
+  if (v != expected[i]) {
+    printf("*** BUG: %s: wrong value for chain[%"PRIu32"]\n", what, i);
+    nerrors ++;
+  }
+}
+
+
+int main(void) {
+  term_t x[N];
+  model_t *mdl;
+  yval_t v;
+  term_t bad[2];
+  double start;
+  uint32_t i;
+
+  yices_init();
+
+  mdl = build_model(x);
+  build_chain(x, false);
+
+  start = get_cpu_time();
+  for (i=0; i<N; i++) {
+    check_value(mdl, N-1-i, "get_bv_value");
+  }
+  printf("%"PRIu32" queries: %.3f s\n", (uint32_t) N, get_cpu_time() - start);
+
+  start = get_cpu_time();
+  if (yices_get_value_array(mdl, N, chain, val) < 0) {
+    printf("*** BUG: get_value_array failed\n");
+    nerrors ++;
+  }
+  printf("value array: %.3f s\n", get_cpu_time() - start);
+
+  for (i=0; i<N; i++) {
+    if (yices_get_value(mdl, chain[i], &v) < 0 ||
+        v.node_id != val[i].node_id || v.node_tag != val[i].node_tag) {
+      printf("*** BUG: get_value_array disagrees with get_value for chain[%"PRIu32"]\n", i);
+      nerrors ++;
+    }
+  }
+
+  // a term that can't be evaluated
+  bad[0] = chain[0];
+  bad[1] = yices_bvadd(chain[1], yices_new_variable(yices_bv_type(32)));
+  if (yices_get_value_array(mdl, 2, bad, val) >= 0 || yices_error_code() != EVAL_FREEVAR_IN_TERM) {
+    printf("*** BUG: get_value_array should fail with EVAL_FREEVAR_IN_TERM\n");
+    nerrors ++;
+  }
+
+  /*
+   * The chain is not a root: it's deleted by the garbage collector
+   * and the new chain may reuse the same term indices.
+   */
+  yices_garbage_collect(NULL, 0, NULL, 0, true);
+  build_chain(x, true);
+  for (i=0; i<N; i++) {
+    check_value(mdl, i, "after gc");
+  }
+
+  yices_free_model(mdl);
+  yices_exit();
+
+  printf("%"PRIu32" errors\n", nerrors);
+
+  return nerrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST BULK EXPORT OF MODEL VALUES
+ *
+ * Compare yices_get_bool_value_array, yices_get_rational64_value_array,
+ * and yices_get_bv_value_array with the single-term functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gmp.h>
+
+#include "yices.h"
+
+#ifdef MINGW
+static inline long int random(void) {
+  return rand();
+}
+#endif
+
+
+#define N 100
+#define BVSIZE 70
+#define BVWORDS ((BVSIZE + 31)/32)
+
+static term_t vars[3*N];
+static term_t vals[3*N];
+static uint32_t nerrors;
+
+
+static void bug(const char *msg, uint32_t i) {
+  printf("*** BUG: %s (index %"PRIu32")\n", msg, i);
+  nerrors ++;
+}
+
+
+/*
+ * Boolean terms: p_0 ... p_{N-1}
+ */
+static void test_bool(model_t *mdl, term_t *p) {
+  uint8_t bitmap[(N+7)/8];
+  int32_t v;
+  uint32_t i;
+
+  if (yices_get_bool_value_array(mdl, N, p, bitmap) < 0) {
+    bug("bool_value_array failed", 0);
+    return;
+  }
+  for (i=0; i<N; i++) {
+    if (yices_get_bool_value(mdl, p[i], &v) < 0 || v != ((bitmap[i/8] >> (i%8)) & 1)) {
+      bug("wrong boolean value", i);
+    }
+  }
+}
+
+
+/*
+ * Arithmetic terms: x_i + 1/3 (some of them are too large)
+ */
+static void test_arith(model_t *mdl, term_t *x) {
+  term_t a[N];
+  int64_t num[N], n;
+  uint64_t den[N], d;
+  uint32_t i, big;
+  int32_t k;
+
+  for (i=0; i<N; i++) {
+    a[i] = yices_add(x[i], yices_rational32(1, 3));
+  }
+
+  k = yices_get_rational64_value_array(mdl, N, a, num, den);
+  if (k < 0) {
+    bug("rational64_value_array failed", 0);
+    return;
+  }
+
+  big = 0;
+  for (i=0; i<N; i++) {
+    if (yices_get_rational64_value(mdl, a[i], &n, &d) < 0) {
+      big ++;
+      if (yices_error_code() != EVAL_OVERFLOW || num[i] != 0 || den[i] != 0) {
+        bug("value should not fit", i);
+      }
+    } else if (n != num[i] || d != den[i]) {
+      bug("wrong rational value", i);
+    }
+  }
+  if (big != (uint32_t) k) {
+    bug("wrong overflow count", k);
+  }
+}
+
+
+/*
+ * Bitvector terms: (bvnot y_i)
+ */
+static void test_bv(model_t *mdl, term_t *y) {
+  term_t a[N];
+  uint32_t words[N * BVWORDS];
+  int32_t bits[BVSIZE];
+  uint32_t i, j;
+
+  for (i=0; i<N; i++) {
+    a[i] = yices_bvnot(y[i]);
+  }
+
+  if (yices_get_bv_value_array(mdl, N, a, words) < 0) {
+    bug("bv_value_array failed", 0);
+    return;
+  }
+  for (i=0; i<N; i++) {
+    if (yices_get_bv_value(mdl, a[i], bits) < 0) {
+      bug("get_bv_value failed", i);
+      continue;
+    }
+    for (j=0; j<BVSIZE; j++) {
+      if (bits[j] != ((words[i * BVWORDS + j/32] >> (j%32)) & 1)) {
+        bug("wrong bitvector value", i);
+        break;
+      }
+    }
+    if (words[i * BVWORDS + BVWORDS - 1] >> (BVSIZE % 32) != 0) {
+      bug("bitvector not normalized", i);
+    }
+  }
+
+  // type errors
+  a[1] = yices_bvextract(a[1], 0, 7);
+  if (yices_get_bv_value_array(mdl, 2, a, words) >= 0 || yices_error_code() != INCOMPATIBLE_TYPES) {
+    bug("expected INCOMPATIBLE_TYPES", 1);
+  }
+  if (yices_get_bool_value_array(mdl, 1, a, (uint8_t *) words) >= 0 || yices_error_code() != TYPE_MISMATCH) {
+    bug("expected TYPE_MISMATCH", 0);
+  }
+}
+
+
+int main(void) {
+  int32_t bits[BVSIZE];
+  mpz_t z;
+  model_t *mdl;
+  uint32_t i, j;
+
+  yices_init();
+  mpz_init(z);
+
+  for (i=0; i<N; i++) {
+    vars[i] = yices_new_uninterpreted_term(yices_bool_type());
+    vals[i] = (random() & 1) ? yices_true() : yices_false();
+
+    vars[N+i] = yices_new_uninterpreted_term(yices_int_type());
+    mpz_set_si(z, random() - RAND_MAX/2);
+    if (i % 5 == 0) {
+      mpz_mul_2exp(z, z, 64);
+    }
+    vals[N+i] = yices_mpz(z);
+
+    vars[2*N+i] = yices_new_uninterpreted_term(yices_bv_type(BVSIZE));
+    for (j=0; j<BVSIZE; j++) {
+      bits[j] = random() & 1;
+    }
+    vals[2*N+i] = yices_bvconst_from_array(BVSIZE, bits);
+  }
+  mdl = yices_model_from_map(3*N, vars, vals);
+
+  test_bool(mdl, vars);
+  test_arith(mdl, vars + N);
+  test_bv(mdl, vars + 2*N);
+
+  yices_free_model(mdl);
+  mpz_clear(z);
+  yices_exit();
+
+  printf("%"PRIu32" errors\n", nerrors);
+
+  return nerrors == 0 ? 0 : 1;
+}
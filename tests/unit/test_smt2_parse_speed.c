@@ -0,0 +1,149 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PARSE-THROUGHPUT BENCHMARK FOR THE SMT2 LEXER
+ *
+ * Usage: test_smt2_parse_speed <file> [repeat]
+ * - read all the tokens of file using the three reader modes
+ *   (stream, buffered, mapped) and report the throughput of each mode
+ * - check that all modes produce the same token sequence
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "frontend/smt2/smt2_lexer.h"
+#include "include/yices_exit_codes.h"
+#include "utils/cputime.h"
+
+static lexer_t lexer;
+
+static const char * const mode_name[3] = {
+  "stream", "buffered", "mapped",
+};
+
+
+/*
+ * Result of one pass: number of tokens, number of bytes, and a hash
+ * of the tokens (codes, positions, and values)
+ */
+typedef struct lex_stats_s {
+  uint64_t num_tokens;
+  uint64_t num_bytes;
+  uint64_t hash;
+} lex_stats_t;
+
+static inline uint64_t mix(uint64_t h, uint64_t x) {
+  return (h ^ x) * 0x100000001b3ULL;
+}
+
+static uint64_t hash_token(uint64_t h, smt2_token_t tk) {
+  uint32_t i, n;
+  char *s;
+
+  h = mix(h, tk);
+  h = mix(h, lexer.tk_pos);
+  h = mix(h, lexer.tk_line);
+  h = mix(h, lexer.tk_column);
+  if (tk != SMT2_TK_LP && tk != SMT2_TK_RP && tk != SMT2_TK_EOS) {
+    n = current_token_length(&lexer);
+    s = current_token_value(&lexer);
+    for (i=0; i<n; i++) {
+      h = mix(h, (unsigned char) s[i]);
+    }
+  }
+  return h;
+}
+
+
+/*
+ * Read all tokens of filename using the given mode
+ */
+static void lex_file(const char *filename, reader_mode_t mode, lex_stats_t *stats) {
+  smt2_token_t tk;
+  uint64_t n, h;
+
+  if (init_smt2_file_lexer_mode(&lexer, filename, mode) < 0) {
+    perror(filename);
+    exit(YICES_EXIT_FILE_NOT_FOUND);
+  }
+
+  n = 0;
+  h = 0xcbf29ce484222325ULL;
+  do {
+    tk = next_smt2_token(&lexer);
+    h = hash_token(h, tk);
+    n ++;
+  } while (tk != SMT2_TK_EOS);
+
+  stats->num_tokens = n;
+  stats->num_bytes = reader_position(&lexer.reader);
+  stats->hash = h;
+
+  close_lexer(&lexer);
+}
+
+
+int main(int argc, char *argv[]) {
+  lex_stats_t stats[3];
+  double start, time, mb;
+  uint32_t i, j, repeat;
+  bool ok;
+
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "Usage: %s <filename> [repeat]\n", argv[0]);
+    exit(YICES_EXIT_USAGE);
+  }
+
+  repeat = 1;
+  if (argc == 3) {
+    repeat = atoi(argv[2]);
+    if (repeat == 0) repeat = 1;
+  }
+
+  for (i=0; i<3; i++) {
+    start = get_cpu_time();
+    for (j=0; j<repeat; j++) {
+      lex_file(argv[1], (reader_mode_t) i, stats + i);
+    }
+    time = get_cpu_time() - start;
+    mb = ((double) stats[i].num_bytes * repeat)/(1024 * 1024);
+    printf("%-9s: %"PRIu64" tokens, %"PRIu64" bytes, %.3f s", mode_name[i],
+           stats[i].num_tokens, stats[i].num_bytes, time);
+    if (time > 0) {
+      printf(", %.1f MB/s", mb/time);
+    }
+    printf("\n");
+    fflush(stdout);
+  }
+
+  ok = true;
+  for (i=1; i<3; i++) {
+    if (stats[i].num_tokens != stats[0].num_tokens ||
+        stats[i].num_bytes != stats[0].num_bytes ||
+        stats[i].hash != stats[0].hash) {
+      fprintf(stderr, "*** BUG: %s and %s modes produce different tokens ***\n",
+              mode_name[0], mode_name[i]);
+      ok = false;
+    }
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE THREAD-SAFE API
+ *
+ * Several threads build terms in the shared term table, then create
+ * and check their own context, and verify the model. This requires a
+ * build configured with --enable-thread-safety.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#ifdef THREAD_SAFE
+
+#include <pthread.h>
+
+#define NUM_THREADS 8
+#define NUM_ROUNDS  20
+
+
+/*
+ * Each thread repeatedly creates fresh variables x, y, z, and a
+ * function f, and checks
+ *   x * k = c, x + y = 0, big < z < big + 2, f(x) = z
+ * in a new context. The constant big is too large for 32 bits so
+ * this exercises the shared bank of gmp rationals too. The egraph,
+ * simplex, and bitvector solvers all run without the API locks.
+ */
+static void *worker(void *arg) {
+  char name[32];
+  uintptr_t id;
+  uint32_t i;
+  type_t bv32, ftype;
+  term_t x, y, z, k, c, big, fun, f[5];
+  ctx_config_t *config;
+  param_t *params;
+  context_t *ctx;
+  model_t *mdl;
+  term_vector_t v;
+
+  id = (uintptr_t) arg;
+  bv32 = yices_bv_type(32);
+  ftype = yices_function_type1(bv32, yices_int_type());
+  yices_init_term_vector(&v);
+
+  for (i=0; i<NUM_ROUNDS; i++) {
+    snprintf(name, sizeof(name), "x_%"PRIuPTR"_%"PRIu32, id, i);
+    x = yices_new_uninterpreted_term(bv32);
+    yices_set_term_name(x, name);
+    y = yices_new_uninterpreted_term(bv32);
+    z = yices_new_uninterpreted_term(yices_int_type());
+    fun = yices_new_uninterpreted_term(ftype);
+
+    k = yices_bvconst_uint32(32, 2 * (uint32_t) id + 3);  // odd so x is unique
+    c = yices_bvconst_uint32(32, 12345 + i);
+    big = yices_parse_rational("123456789012345678901234567890");
+
+    f[0] = yices_eq(yices_bvmul(x, k), c);
+    f[1] = yices_eq(yices_bvadd(x, y), yices_bvconst_zero(32));
+    f[2] = yices_arith_gt_atom(z, big);
+    f[3] = yices_arith_lt_atom(z, yices_add(big, yices_int32(2)));
+    f[4] = yices_arith_eq_atom(yices_application1(fun, x), z);
+
+    config = yices_new_config();
+    yices_set_config(config, "mode", "push-pop");
+    ctx = yices_new_context(config);
+    yices_free_config(config);
+    params = yices_new_param_record();
+    yices_default_params_for_context(ctx, params);
+    yices_set_param(params, "random-seed", "12345");
+    if (yices_assert_formulas(ctx, 5, f) < 0 || yices_check_context(ctx, params) != STATUS_SAT) {
+      fprintf(stderr, "thread %"PRIuPTR": check failed\n", id);
+      yices_print_error(stderr);
+      exit(1);
+    }
+
+    mdl = yices_get_model(ctx, true);
+    if (yices_formulas_true_in_model(mdl, 5, f) != 1) {
+      fprintf(stderr, "thread %"PRIuPTR": model check failed\n", id);
+      exit(1);
+    }
+    if (yices_get_term_by_name(name) != x) {
+      fprintf(stderr, "thread %"PRIuPTR": wrong term for %s\n", id, name);
+      exit(1);
+    }
+
+    if (yices_implicant_for_formulas(mdl, 5, f, &v) < 0 || v.size == 0) {
+      fprintf(stderr, "thread %"PRIuPTR": implicant failed\n", id);
+      yices_print_error(stderr);
+      exit(1);
+    }
+    yices_reset_term_vector(&v);
+
+    yices_free_model(mdl);
+    yices_free_param_record(params);
+    yices_free_context(ctx);
+  }
+
+  yices_delete_term_vector(&v);
+
+  return NULL;
+}
+
+
+int main(void) {
+  pthread_t thread[NUM_THREADS];
+  uintptr_t i;
+
+  yices_init();
+
+  for (i=0; i<NUM_THREADS; i++) {
+    if (pthread_create(thread + i, NULL, worker, (void *) i) != 0) {
+      perror("pthread_create");
+      exit(1);
+    }
+  }
+  for (i=0; i<NUM_THREADS; i++) {
+    pthread_join(thread[i], NULL);
+  }
+
+  printf("%d threads x %d rounds: ok\n", NUM_THREADS, NUM_ROUNDS);
+
+  yices_exit();
+
+  return 0;
+}
+
+#else
+
+int main(void) {
+  printf("Thread safety is not enabled: configure with --enable-thread-safety\n");
+  return 0;
+}
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST YOUNG COLLECTIONS
+ *
+ * yices_garbage_collect_young must keep all old terms and types,
+ * delete the young terms and types that are not reachable from a
+ * root, and keep everything reachable from a root.
+ *
+ * yices_garbage_collect_incremental must give the same result as
+ * yices_garbage_collect even if terms are created and roots are
+ * added between two steps.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+
+#define N 1000
+
+static term_t x[N];
+static term_t old[N];
+static term_t young[N];
+static uint32_t nerrors;
+
+
+static void bug(const char *msg, uint32_t i) {
+  printf("*** BUG: %s (index %"PRIu32")\n", msg, i);
+  nerrors ++;
+}
+
+static bool live_term(term_t t) {
+  return yices_type_of_term(t) != NULL_TYPE;
+}
+
+static bool live_type(type_t tau) {
+  return yices_bvtype_size(tau) > 0;
+}
+
+
+/*
+ * Terms (ite (bvlt x_{i+1} x_{i+2}) x_i (bvmul x_{i+1} x_{i+2}))
+ * where x_i has k bits
+ */
+static void build_terms(term_t *a, uint32_t k) {
+  type_t tau;
+  uint32_t i;
+
+  tau = yices_bv_type(k);
+  for (i=0; i<N; i++) {
+    x[i] = yices_new_uninterpreted_term(tau);
+  }
+  for (i=0; i<N; i++) {
+    a[i] = yices_ite(yices_bvlt_atom(x[(i+1) % N], x[(i+2) % N]), x[i],
+                     yices_bvmul(x[(i+1) % N], x[(i+2) % N]));
+  }
+}
+
+
+int main(void) {
+  yices_gc_stats_t stats;
+  term_t sub;
+  type_t tau;
+  uint32_t i, k, n;
+
+  yices_init();
+
+  /*
+   * First generation: nothing is a root but everything is named
+   */
+  build_terms(old, 40);
+  for (i=0; i<N; i++) {
+    yices_set_term_name(x[i], "x");
+  }
+  yices_garbage_collect(NULL, 0, NULL, 0, true);
+  yices_get_gc_stats(&stats);
+  if (stats.full_collections != 1 || stats.young_terms != 0 || stats.young_types != 0) {
+    bug("wrong stats after full collection", 0);
+  }
+  // all x_i are named but old[i] are not roots
+  for (i=0; i<N; i++) {
+    if (live_term(old[i])) bug("unreachable term survived full collection", i);
+  }
+
+  /*
+   * Second generation:
+   * - old[i] are roots
+   * - then do a young collection that keeps only young[0 ... N/2-1]
+   */
+  build_terms(old, 50);
+  yices_garbage_collect(old, N, NULL, 0, false);
+
+  build_terms(young, 60);
+  tau = yices_bv_type(60);
+  yices_get_gc_stats(&stats);
+  if (stats.young_terms < 2*N || stats.young_types == 0) {
+    bug("young terms not counted", stats.young_terms);
+  }
+
+  for (i=0; i<N/2; i++) {
+    yices_incref_term(young[i]);
+  }
+  yices_garbage_collect_young(NULL, 0, NULL, 0, false);
+
+  for (i=0; i<N; i++) {
+    if (! live_term(old[i])) bug("young collection deleted an old term", i);
+  }
+  for (i=0; i<N/2; i++) {
+    if (! live_term(young[i])) bug("young collection deleted a root", i);
+    sub = yices_term_child(young[i], 0);
+    if (sub == NULL_TERM || ! live_term(sub)) bug("young collection deleted a live subterm", i);
+  }
+  for (i=N/2; i<N; i++) {
+    if (live_term(young[i])) bug("dead young term survived", i);
+  }
+  if (! live_type(tau)) bug("young collection deleted a live type", 0);
+
+  yices_get_gc_stats(&stats);
+  if (stats.young_collections != 1 || stats.young_terms != 0 || stats.terms_collected == 0 ||
+      stats.max_pause < stats.last_pause || stats.total_time < stats.max_pause) {
+    bug("wrong stats after young collection", 0);
+  }
+
+  /*
+   * Young collection with nothing young: nothing is deleted,
+   * but a full collection deletes the old terms that are not roots.
+   */
+  for (i=0; i<N/2; i++) {
+    yices_decref_term(young[i]);
+  }
+  yices_garbage_collect_young(NULL, 0, NULL, 0, false);
+  for (i=0; i<N/2; i++) {
+    if (! live_term(young[i])) bug("young collection deleted an old term", i);
+  }
+
+  tau = yices_bv_type(70);
+  yices_garbage_collect_young(NULL, 0, NULL, 0, false);
+  if (live_type(tau)) bug("dead young type survived", 0);
+
+  yices_garbage_collect(NULL, 0, NULL, 0, false);
+  for (i=0; i<N; i++) {
+    if (live_term(young[i]) || live_term(old[i])) bug("dead term survived full collection", i);
+  }
+
+  /*
+   * Names with keep_named = false: the name of a root must be kept,
+   * the names of dead terms must be removed.
+   */
+  build_terms(young, 80);
+  yices_incref_term(young[0]);
+  yices_set_term_name(young[0], "y");
+  yices_set_term_name(young[1], "y");
+  yices_set_term_name(young[2], "z");
+  yices_garbage_collect_young(NULL, 0, NULL, 0, false);
+  if (! live_term(young[0])) bug("young collection deleted a named root", 0);
+  if (yices_get_term_by_name("y") != young[0]) bug("young collection removed the name of a root", 0);
+  if (yices_get_term_by_name("z") != NULL_TERM) bug("name of a dead term survived", 2);
+  yices_decref_term(young[0]);
+
+  /*
+   * keep_named = true: a name that was removed doesn't keep a young term
+   */
+  build_terms(young, 90);
+  yices_set_term_name(young[0], "u");
+  yices_set_term_name(young[1], "w");
+  yices_remove_term_name("w");
+  yices_garbage_collect_young(NULL, 0, NULL, 0, true);
+  if (! live_term(young[0])) bug("young collection deleted a named term", 0);
+  if (live_term(young[1])) bug("term with a removed name survived", 1);
+  yices_remove_term_name("u");
+  yices_garbage_collect(NULL, 0, NULL, 0, false);
+
+  /*
+   * Incremental collection:
+   * - all old[i] are old, old[0 ... N/2-1] are roots from the start
+   * - old[N/2] becomes a root and young[0] is created in the middle
+   *   of the collection
+   * - a young collection runs in the middle too
+   */
+  build_terms(old, 100);
+  for (i=0; i<N/2; i++) {
+    yices_incref_term(old[i]);
+  }
+  yices_garbage_collect_young(old, N, NULL, 0, false);
+  yices_get_gc_stats(&stats);
+  n = stats.incremental_steps;
+
+  if (yices_garbage_collect_incremental(NULL, 0, NULL, 0, false, 100) != 0) {
+    bug("incremental collection completed too early", 0);
+  }
+  yices_incref_term(old[N/2]);
+  build_terms(young, 110);
+  yices_incref_term(young[0]);
+  sub = young[1];
+  yices_garbage_collect_young(&sub, 1, NULL, 0, false);
+  if (live_term(young[2])) bug("dead young term survived", 2);
+
+  k = 1;
+  while (yices_garbage_collect_incremental(&sub, 1, NULL, 0, false, 100) == 0) {
+    k ++;
+  }
+  if (k < 10) bug("incremental collection did not run in steps", k);
+
+  for (i=0; i<=N/2; i++) {
+    if (! live_term(old[i])) bug("incremental collection deleted a root", i);
+    if (! live_term(yices_term_child(old[i], 0))) bug("incremental collection deleted a live subterm", i);
+  }
+  for (i=N/2+1; i<N; i++) {
+    if (live_term(old[i])) bug("dead term survived incremental collection", i);
+  }
+  if (! live_term(young[0]) || ! live_term(sub)) bug("incremental collection deleted a new root", 0);
+  for (i=3; i<N; i++) {
+    if (live_term(young[i])) bug("dead new term survived incremental collection", i);
+  }
+
+  yices_get_gc_stats(&stats);
+  if (stats.incremental_collections != 1 || stats.incremental_steps != n + k + 1) {
+    bug("wrong stats after incremental collection", k);
+  }
+
+  yices_get_gc_stats(&stats);
+  printf("%"PRIu32" full, %"PRIu32" young, %"PRIu32" incremental collections: %"PRIu64" terms, %"PRIu64" types collected\n",
+         stats.full_collections, stats.young_collections, stats.incremental_collections,
+         stats.terms_collected, stats.types_collected);
+
+  yices_exit();
+
+  printf("%"PRIu32" errors\n", nerrors);
+
+  return nerrors == 0 ? 0 : 1;
+}
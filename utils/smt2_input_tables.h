@@ -21,7 +21,7 @@
 
 typedef enum state_s {
   c0, c1, c3, c4, c5, c6, c6a, c8, c9, c9a, c9b,
-  c10, c10a, c10b, c11, c11a, c11b, c11d, c11f, c12, c12b, c13, c14, c15,
+  c10, c10a, c10b, c11, c11a, c11b, c11d, c11f, c12, c12b, c13, c14, c15, c16, c16a,
   a0, a1, v0,
   s0, s1, s2, s3, s4, s5, s6, s7, s8, s10,
   t0, t1, t2, t2a, t2b, t2d, t2e, 
@@ -49,9 +49,11 @@ enum actions {
   next_goto_c1,
   empty_command_return,
   check_sat_next_goto_r0,
+  check_sat_assuming_next_goto_c16,
   get_assertions_next_goto_r0,
   get_proof_next_goto_r0,
   get_unsat_core_next_goto_r0,
+  get_unsat_assumptions_next_goto_r0,
   get_assignment_next_goto_r0,
   exit_next_goto_r0,
   push_next_goto_c3,
@@ -97,6 +99,8 @@ enum actions {
   next_push_c12b_goto_t0,
   next_goto_r0,
   push_c12b_goto_t0,
+  next_goto_c16a,
+  push_c16a_goto_t0,
   string_next_goto_r0,
   symbol_next_push_r0_goto_s0,
   symbol_next_push_r0_push_t0_goto_s0,
@@ -210,9 +214,11 @@ static triple_t triples[] = {
   { c0, DEFAULT_TOKEN, "error_lp_expected" },
 
   { c1, SMT2_TK_CHECK_SAT, "check_sat_next_goto_r0" },
+  { c1, SMT2_TK_CHECK_SAT_ASSUMING, "check_sat_assuming_next_goto_c16" },
   { c1, SMT2_TK_GET_ASSERTIONS, "get_assertions_next_goto_r0" },
   { c1, SMT2_TK_GET_PROOF, "get_proof_next_goto_r0" },
   { c1, SMT2_TK_GET_UNSAT_CORE, "get_unsat_core_next_goto_r0" },
+  { c1, SMT2_TK_GET_UNSAT_ASSUMPTIONS, "get_unsat_assumptions_next_goto_r0" },
   { c1, SMT2_TK_GET_ASSIGNMENT, "get_assignment_next_goto_r0" },
   { c1, SMT2_TK_EXIT, "exit_next_goto_r0" },
   { c1, SMT2_TK_PUSH, "push_next_goto_c3" },
@@ -327,6 +333,12 @@ static triple_t triples[] = {
   { c15, SMT2_TK_QSYMBOL, "symbol_next_push_r0_push_t0_goto_s0" },
   { c15, DEFAULT_TOKEN, "error_symbol_expected" },
 
+  { c16, SMT2_TK_LP, "next_goto_c16a" },
+  { c16, DEFAULT_TOKEN, "error_lp_expected" },
+
+  { c16a, SMT2_TK_RP, "next_goto_r0" },
+  { c16a, DEFAULT_TOKEN, "push_c16a_goto_t0" },
+
   { a0, SMT2_TK_NUMERAL, "numeral_next_return" },
   { a0, SMT2_TK_DECIMAL, "decimal_next_return" },
   { a0, SMT2_TK_HEXADECIMAL, "hexadecimal_next_return" },